@@ -0,0 +1,92 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace qtMate::flow
+{
+/**
+ * @Brief Incrementally maintained transitive closure of a directed acyclic graph
+ * @Details Each node has a bitset of all the nodes it can reach, so a reachability query is a single bit test (O(1)).
+ *          Adding an edge ORs the bitset of the destination into the bitsets of the source and its ancestors (O(V*V/64) worst case).
+ *          Removing an edge recomputes the bitsets of the source and its ancestors only, from their successors (O(E*V/64) worst case).
+ *          Edges creating a cycle are refused, so the graph always stays acyclic.
+ */
+class FlowReachability final
+{
+public:
+	using Node = std::uint64_t;
+
+	FlowReachability() noexcept = default;
+
+	/** Adds a node (ignored if it already exists) */
+	void addNode(Node const node) noexcept;
+	/** Removes a node and all its edges */
+	void removeNode(Node const node) noexcept;
+	/** Adds an edge between existing nodes, several edges can be added between the same nodes. Returns false (and ignores the edge) if it would create a cycle */
+	bool addEdge(Node const from, Node const to) noexcept;
+	/** Removes one of the edges between the nodes */
+	void removeEdge(Node const from, Node const to) noexcept;
+	/** Removes all the nodes and edges */
+	void clear() noexcept;
+
+	/** Returns true if there is a path (of at least one edge) from a node to the other one */
+	bool reaches(Node const from, Node const to) const noexcept;
+	/** Returns true if adding an edge between the nodes would create a cycle */
+	bool wouldCreateCycle(Node const from, Node const to) const noexcept;
+
+	std::size_t nodesCount() const noexcept;
+	std::size_t edgesCount() const noexcept;
+
+	// Deleted compiler auto-generated methods
+	FlowReachability(FlowReachability const&) = delete;
+	FlowReachability(FlowReachability&&) = delete;
+	FlowReachability& operator=(FlowReachability const&) = delete;
+	FlowReachability& operator=(FlowReachability&&) = delete;
+
+private:
+	using Word = std::uint64_t;
+	using Successors = std::unordered_map<Node, std::size_t>; // Successor, edges count
+
+	struct NodeInfo
+	{
+		std::size_t index{ 0u }; // Index of the node bit, and of its descendants bitset
+		Successors successors{};
+	};
+
+	Word* descendants(std::size_t const index) noexcept;
+	Word const* descendants(std::size_t const index) const noexcept;
+	bool testBit(std::size_t const index, std::size_t const bit) const noexcept;
+	std::size_t allocateIndex() noexcept;
+	void recomputeDescendants(std::vector<NodeInfo*> const& infos) noexcept;
+
+	std::unordered_map<Node, NodeInfo> _nodes{};
+	std::vector<Word> _descendants{}; // One bitset of _wordsCount words per index
+	std::size_t _wordsCount{ 0u };
+	std::size_t _indexesCount{ 0u }; // Allocated indexes (used and free)
+	std::vector<std::size_t> _freeIndexes{};
+	std::size_t _edgesCount{ 0u };
+};
+
+} // namespace qtMate::flow
@@ -21,6 +21,7 @@
 
 #include <QGraphicsScene>
 #include <QtMate/flow/flowDefs.hpp>
+#include <QtMate/flow/flowReachability.hpp>
 
 namespace qtMate::flow
 {
@@ -68,6 +69,7 @@ private:
 
 	QHash<FlowNodeUid, FlowNode*> _nodes{};
 	QHash<FlowConnectionDescriptor, FlowConnection*> _connections{};
+	FlowReachability _reachability{}; // Paths between the nodes, to refuse connections creating a cycle
 };
 
 } // namespace qtMate::flow
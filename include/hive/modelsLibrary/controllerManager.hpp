@@ -20,13 +20,18 @@
 #pragma once
 
 #include "commandsExecutor.hpp"
+#include "entitySnapshot.hpp"
 #include <la/avdecc/controller/avdeccController.hpp>
 
 #include <memory>
 #include <chrono>
+#include <functional>
 #include <unordered_map>
 #include <cstdint>
 #include <optional>
+#include <vector>
+#include <tuple>
+#include <utility>
 
 #include <QObject>
 
@@ -53,6 +58,67 @@ public:
 
 	using StreamInputErrorCounters = std::unordered_map<la::avdecc::entity::StreamInputCounterValidFlag, la::avdecc::entity::model::DescriptorCounter>;
 	using StatisticsErrorCounters = std::unordered_map<StatisticsErrorCounterFlag, std::uint64_t>;
+	using LoadVirtualEntitiesHandler = std::function<void(la::avdecc::jsonSerializer::DeserializationError const error, std::string const& message)>;
+	using SerializationProgressHandler = std::function<bool(std::size_t const serializedCount, std::size_t const totalCount)>; // Returns false to cancel the serialization
+
+	/** High rate notifications that are coalesced (only the latest value for each entity/descriptor/kind is kept until the next flush) */
+	enum class CoalescedNotificationKind : std::uint8_t
+	{
+		EntityCounters = 0,
+		AvbInterfaceCounters = 1,
+		ClockDomainCounters = 2,
+		StreamInputCounters = 3,
+		StreamOutputCounters = 4,
+		StreamOutputSignalPresence = 5,
+		AecpResponseAverageTime = 6,
+		AemAecpUnsolicitedCounter = 7,
+		MvuAecpUnsolicitedCounter = 8,
+	};
+
+	/** Batch of coalesced notifications, published once per flush */
+	struct CoalescedNotifications
+	{
+		std::vector<std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::EntityCounters>> entityCounters{};
+		std::vector<std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters>> avbInterfaceCounters{};
+		std::vector<std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::ClockDomainCounters>> clockDomainCounters{};
+		std::vector<std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamInputCounters>> streamInputCounters{};
+		std::vector<std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamOutputCounters>> streamOutputCounters{};
+		std::vector<std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::SignalPresenceChannels>> streamOutputSignalPresence{};
+		std::vector<std::pair<la::avdecc::UniqueIdentifier, std::chrono::milliseconds>> aecpResponseAverageTime{};
+		std::vector<std::pair<la::avdecc::UniqueIdentifier, std::uint64_t>> aemAecpUnsolicitedCounter{};
+		std::vector<std::pair<la::avdecc::UniqueIdentifier, std::uint64_t>> mvuAecpUnsolicitedCounter{};
+
+		bool empty() const noexcept
+		{
+			return entityCounters.empty() && avbInterfaceCounters.empty() && clockDomainCounters.empty() && streamInputCounters.empty() && streamOutputCounters.empty() && streamOutputSignalPresence.empty() && aecpResponseAverageTime.empty() && aemAecpUnsolicitedCounter.empty() && mvuAecpUnsolicitedCounter.empty();
+		}
+	};
+
+	struct NotificationsCoalescingStatistics
+	{
+		std::uint64_t receivedCount{ 0u }; // Number of notifications received from the controller
+		std::uint64_t emittedCount{ 0u }; // Number of notifications actually dispatched to the UI thread
+		std::uint64_t flushCount{ 0u }; // Number of flushes
+		std::size_t maxPendingCount{ 0u }; // Highest number of pending notifications (queue depth)
+		std::chrono::microseconds maxLatency{}; // Highest delay between a notification reception and its dispatch
+		std::chrono::microseconds lastLatency{}; // Delay between the oldest notification reception and its dispatch, for the last flush
+	};
+
+	struct EntityModelCacheStatistics
+	{
+		std::size_t storedCount{ 0u }; // Number of entity models in the persistent cache
+		std::uint64_t hitCount{ 0u }; // Number of entities enumerated using an entity model from the persistent cache
+		std::uint64_t missCount{ 0u }; // Number of entities which entity model had to be enumerated
+		std::uint64_t invalidatedCount{ 0u }; // Number of persisted entity models discarded (corrupted or checksum mismatch)
+	};
+
+	struct CountersPollingStatistics
+	{
+		std::size_t polledEntitiesCount{ 0u }; // Number of entities currently polled (entities not supporting unsolicited notifications)
+		std::uint64_t pollsCount{ 0u }; // Number of polls issued
+		std::uint64_t deferredCount{ 0u }; // Number of polls delayed because the network wide budget was exhausted
+		std::uint64_t timeoutsCount{ 0u }; // Number of AECP timeouts that increased the polling interval of an entity
+	};
 
 	enum class AecpCommandType
 	{
@@ -184,15 +250,37 @@ public:
 	/** Gets a ControlledEntity */
 	virtual la::avdecc::controller::ControlledEntityGuard getControlledEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
 
+	/**
+			* @brief Gets the latest snapshot of a ControlledEntity.
+			* @details Snapshots are immutable and published before the corresponding change signal is emitted. Getting one never locks the ControlledEntity, so it can be called from any thread.
+			* @return The snapshot, or nullptr if the entity is not online.
+			*/
+	virtual SharedEntitySnapshot getEntitySnapshot(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+
 	/** Serialize all known ControlledEntities */
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept = 0;
 
+	/**
+			* @brief Serialize all known ControlledEntities, streaming them to the file.
+			* @details Entities are serialized concurrently on worker threads, then written to the file in order as soon as they are available, so the memory used does not depend on the number of entities.
+			*          The resulting file can be loaded by loadVirtualEntitiesFromJsonNetworkState, the same way as one created by serializeAllControlledEntitiesAsJson.
+			*          The progress handler is called from the calling thread (regularly, even if no entity has been written) and can return false to cancel the serialization, in which case the file is removed.
+			*/
+	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJsonStreamed(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource, SerializationProgressHandler const& progressHandler = {}) const noexcept = 0;
+
 	/** Serialize a ControlledEntity */
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeControlledEntityAsJson(la::avdecc::UniqueIdentifier const entityID, QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept = 0;
 
 	/** Deserializes a JSON file representing a full network state, and loads it as virtual ControlledEntities. */
 	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntitiesFromJsonNetworkState(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept = 0;
 
+	/**
+			* @brief Deserializes a JSON file representing a full network state in the background, and loads it as virtual ControlledEntities.
+			* @details The file is parsed and validated on a worker thread. All loaded entities are then registered at once, with a single entitiesOnline signal (instead of one entityOnline signal per entity).
+			*          Must be called from the main thread, the handler is called from the main thread after the entitiesOnline signal has been emitted. Network states are loaded one after the other.
+			*/
+	virtual void loadVirtualEntitiesFromJsonNetworkStateAsync(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, LoadVirtualEntitiesHandler const& handler) noexcept = 0;
+
 	/** Deserializes a JSON file representing an entity, and loads it as a virtual ControlledEntity. */
 	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntityFromJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept = 0;
 
@@ -213,6 +301,8 @@ public:
 	/** Enable/Disable AEM cache */
 	virtual void setEnableAemCache(bool const enable) noexcept = 0;
 	virtual bool isAemCacheEnabled() const noexcept = 0;
+	/** Statistics of the persistent AEM cache (loaded when the controller is created, if the AEM cache is enabled) */
+	virtual EntityModelCacheStatistics getEntityModelCacheStatistics() const noexcept = 0;
 
 	/** Enable/Disable fast enumeration */
 	virtual void setEnableFastEnumeration(bool const enable) noexcept = 0;
@@ -222,9 +312,23 @@ public:
 	virtual void setEnableFullAemEnumeration(bool const enable) noexcept = 0;
 	virtual bool isFullAemEnumerationEnabled() const noexcept = 0;
 
+	/**
+			* @brief Counters polling of the entities not supporting unsolicited notifications.
+			* @details The counters of such entities are periodically queried (GET_COUNTERS of the entity, its AVB interfaces, clock domains and streams) so they stay up-to-date. All polls share a network wide budget,
+			*          entities that recently reported errors (and the focused one, selected in the UI) are polled more often, and entities reporting AECP timeouts less often.
+			*/
+	virtual void setCountersPollingFocus(la::avdecc::UniqueIdentifier const entityID) noexcept = 0; // Entity selected in the UI (invalid UniqueIdentifier for none)
+	virtual CountersPollingStatistics getCountersPollingStatistics() const noexcept = 0;
+
 	/** Identify entity */
 	virtual void identifyEntity(la::avdecc::UniqueIdentifier const targetEntityID, std::chrono::milliseconds const duration, IdentifyEntityHandler const& resultHandler = {}) noexcept = 0;
 
+	/** Notifications coalescing interval. High rate notifications (counters, statistics) are merged and dispatched at most once per interval. An interval of 0 dispatches them as soon as the event loop runs. */
+	static constexpr auto DefaultNotificationsCoalescingInterval = std::chrono::milliseconds{ 50 };
+	virtual void setNotificationsCoalescingInterval(std::chrono::milliseconds const interval) noexcept = 0;
+	virtual std::chrono::milliseconds getNotificationsCoalescingInterval() const noexcept = 0;
+	virtual NotificationsCoalescingStatistics getNotificationsCoalescingStatistics() const noexcept = 0;
+
 	/** Counter error flags */
 	virtual StreamInputErrorCounters getStreamInputErrorCounters(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept = 0;
 	virtual void clearStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag) noexcept = 0;
@@ -339,6 +443,7 @@ public:
 	Q_SIGNAL void entityQueryError(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::Controller::QueryCommandError const error);
 	Q_SIGNAL void entityOnline(la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const enumerationTime);
 	Q_SIGNAL void entityOffline(la::avdecc::UniqueIdentifier const entityID);
+	Q_SIGNAL void entitiesOnline(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs); // Batch of entities going online at once (loaded from a network state), entityOnline is not emitted for them
 	Q_SIGNAL void entityRedundantInterfaceOnline(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::Entity::InterfaceInformation const& interfaceInfo);
 	Q_SIGNAL void entityRedundantInterfaceOffline(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex);
 	Q_SIGNAL void unsolicitedRegistrationChanged(la::avdecc::UniqueIdentifier const entityID, bool const isSubscribed, bool const triggeredByEntity);
@@ -389,6 +494,9 @@ public:
 	Q_SIGNAL void systemUniqueIDChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::UniqueIdentifier const systemUniqueID, QString const& systemName);
 	Q_SIGNAL void mediaClockReferenceInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::MediaClockReferenceInfo const& info);
 
+	/* Coalesced notifications signal (always emitted from the UI thread, once per flush, after the individual signals of the batch) */
+	Q_SIGNAL void coalescedNotificationsFlushed(hive::modelsLibrary::ControllerManager::CoalescedNotifications const& notifications);
+
 	/* Connection changed signals */
 	Q_SIGNAL void streamInputConnectionChanged(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const& info);
 	Q_SIGNAL void streamOutputConnectionsChanged(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& connections);
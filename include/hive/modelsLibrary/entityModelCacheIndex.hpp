@@ -0,0 +1,212 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Index of the persistent entity model cache
+ * @Details Holds one record per EntityModelID: the AEM checksum of the model (and the version of the checksum algorithm), and the size and hash of the
+ *          entity model file stored for it. The index is serialized as a compact versioned binary blob (fixed size little-endian records, followed by a hash of
+ *          the whole content), which is parsed in place from the file content.
+ *          A blob that is truncated, from another format version or which hash does not match is rejected as a whole, and an entity model file which size or hash
+ *          does not match its record must not be used.
+ */
+class EntityModelCacheIndex final
+{
+public:
+	static constexpr auto Magic = std::uint32_t{ 0x4D454148 }; // "HAEM"
+	static constexpr auto FormatVersion = std::uint16_t{ 1u };
+	static constexpr auto MaxChecksumLength = std::size_t{ 64u }; // Hexadecimal SHA-256
+
+	struct Record
+	{
+		std::uint64_t entityModelID{ 0u };
+		std::uint32_t checksumVersion{ 0u };
+		std::string checksum{};
+		std::uint64_t fileSize{ 0u };
+		std::uint64_t fileHash{ 0u };
+
+		bool operator==(Record const& other) const noexcept
+		{
+			return entityModelID == other.entityModelID && checksumVersion == other.checksumVersion && checksum == other.checksum && fileSize == other.fileSize && fileHash == other.fileHash;
+		}
+	};
+
+	EntityModelCacheIndex() noexcept = default;
+
+	/** Hash of a stored file (FNV-1a, 64 bits) */
+	static std::uint64_t computeHash(std::uint8_t const* const data, std::size_t const size) noexcept
+	{
+		auto hash = std::uint64_t{ 0xcbf29ce484222325ull };
+		for (auto i = std::size_t{ 0u }; i < size; ++i)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	/** Parses a serialized index, returns nothing if the blob is corrupted or from another format version */
+	static std::optional<EntityModelCacheIndex> parse(std::uint8_t const* const data, std::size_t const size) noexcept
+	{
+		if (data == nullptr || size < HeaderSize + TrailerSize)
+		{
+			return std::nullopt;
+		}
+		if (read<std::uint32_t>(data) != Magic || read<std::uint16_t>(data + 4) != FormatVersion)
+		{
+			return std::nullopt;
+		}
+		auto const recordsCount = std::size_t{ read<std::uint32_t>(data + 8) };
+		if (size != HeaderSize + recordsCount * RecordSize + TrailerSize)
+		{
+			return std::nullopt;
+		}
+		auto const contentSize = size - TrailerSize;
+		if (read<std::uint64_t>(data + contentSize) != computeHash(data, contentSize))
+		{
+			return std::nullopt;
+		}
+
+		auto index = EntityModelCacheIndex{};
+		for (auto i = std::size_t{ 0u }; i < recordsCount; ++i)
+		{
+			auto const* const recordData = data + HeaderSize + i * RecordSize;
+			auto record = Record{};
+			record.entityModelID = read<std::uint64_t>(recordData);
+			record.checksumVersion = read<std::uint32_t>(recordData + 8);
+			auto const checksumLength = std::size_t{ read<std::uint16_t>(recordData + 12) };
+			record.fileSize = read<std::uint64_t>(recordData + 16);
+			record.fileHash = read<std::uint64_t>(recordData + 24);
+			if (checksumLength > MaxChecksumLength)
+			{
+				return std::nullopt;
+			}
+			record.checksum.assign(reinterpret_cast<char const*>(recordData + 32), checksumLength);
+			index._records[record.entityModelID] = std::move(record);
+		}
+		return index;
+	}
+
+	/** Serializes the index */
+	std::vector<std::uint8_t> serialize() const noexcept
+	{
+		auto data = std::vector<std::uint8_t>(HeaderSize + _records.size() * RecordSize + TrailerSize, std::uint8_t{ 0u });
+		write(data.data(), Magic);
+		write(data.data() + 4, FormatVersion);
+		write(data.data() + 8, static_cast<std::uint32_t>(_records.size()));
+
+		auto* recordData = data.data() + HeaderSize;
+		for (auto const& [entityModelID, record] : _records)
+		{
+			write(recordData, record.entityModelID);
+			write(recordData + 8, record.checksumVersion);
+			write(recordData + 12, static_cast<std::uint16_t>(record.checksum.size()));
+			write(recordData + 16, record.fileSize);
+			write(recordData + 24, record.fileHash);
+			std::copy(record.checksum.begin(), record.checksum.end(), recordData + 32);
+			recordData += RecordSize;
+		}
+
+		auto const contentSize = data.size() - TrailerSize;
+		write(data.data() + contentSize, computeHash(data.data(), contentSize));
+		return data;
+	}
+
+	/** Adds or replaces the record of an EntityModelID, returns false if the checksum is too long to be stored */
+	bool setRecord(Record record) noexcept
+	{
+		if (record.checksum.size() > MaxChecksumLength)
+		{
+			return false;
+		}
+		auto const entityModelID = record.entityModelID;
+		_records[entityModelID] = std::move(record);
+		return true;
+	}
+
+	/** Removes the record of an EntityModelID, returns false if there was none */
+	bool removeRecord(std::uint64_t const entityModelID) noexcept
+	{
+		return _records.erase(entityModelID) != 0u;
+	}
+
+	Record const* getRecord(std::uint64_t const entityModelID) const noexcept
+	{
+		auto const it = _records.find(entityModelID);
+		if (it == _records.end())
+		{
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	std::map<std::uint64_t, Record> const& getRecords() const noexcept
+	{
+		return _records;
+	}
+
+	/** Returns true if the stored file matches its record (same size and hash) */
+	static bool isValidFile(Record const& record, std::uint8_t const* const data, std::size_t const size) noexcept
+	{
+		return data != nullptr && size == record.fileSize && computeHash(data, size) == record.fileHash;
+	}
+
+private:
+	static constexpr auto HeaderSize = std::size_t{ 12u }; // Magic, FormatVersion, Reserved, RecordsCount
+	static constexpr auto RecordSize = std::size_t{ 32u + MaxChecksumLength }; // EntityModelID, ChecksumVersion, ChecksumLength, Reserved, FileSize, FileHash, Checksum
+	static constexpr auto TrailerSize = std::size_t{ 8u }; // Hash of the content
+
+	template<typename T>
+	static T read(std::uint8_t const* const data) noexcept
+	{
+		auto value = T{ 0u };
+		for (auto i = sizeof(T); i > 0u; --i)
+		{
+			value = static_cast<T>((value << 8) | data[i - 1u]);
+		}
+		return value;
+	}
+
+	template<typename T>
+	static void write(std::uint8_t* const data, T const value) noexcept
+	{
+		for (auto i = std::size_t{ 0u }; i < sizeof(T); ++i)
+		{
+			data[i] = static_cast<std::uint8_t>(value >> (8u * i));
+		}
+	}
+
+	std::map<std::uint64_t, Record> _records{};
+};
+
+} // namespace modelsLibrary
+} // namespace hive
@@ -0,0 +1,105 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModel.hpp>
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Immutable copy of the parts of a ControlledEntity Hive reads, for the current configuration
+ * @Details Snapshots are published by the ControllerManager each time one of the copied fields changes, and can be read from any thread without locking the entity.
+ *          Each group of fields is shared between successive snapshots until one of its fields changes, so publishing a new snapshot only copies the changed group.
+ */
+struct EntitySnapshot
+{
+	struct StreamInput
+	{
+		la::avdecc::entity::model::AvdeccFixedString name{};
+		la::avdecc::entity::model::StreamFormat streamFormat{};
+		la::avdecc::entity::model::StreamInputConnectionInfo connectionInfo{};
+	};
+	struct StreamOutput
+	{
+		la::avdecc::entity::model::AvdeccFixedString name{};
+		la::avdecc::entity::model::StreamFormat streamFormat{};
+		la::avdecc::entity::model::StreamConnections connections{};
+	};
+	struct Streams
+	{
+		std::map<la::avdecc::entity::model::StreamIndex, StreamInput> inputs{};
+		std::map<la::avdecc::entity::model::StreamIndex, StreamOutput> outputs{};
+	};
+
+	struct StreamPort
+	{
+		la::avdecc::entity::model::AudioUnitIndex audioUnitIndex{ 0u };
+		la::avdecc::entity::model::ClusterIndex baseCluster{ 0u };
+		std::map<la::avdecc::entity::model::ClusterIndex, std::uint16_t> clusterChannelCounts{}; // Channel count of each cluster of the stream port
+		la::avdecc::entity::model::AudioMappings mappings{};
+	};
+	struct StreamPorts
+	{
+		std::map<la::avdecc::entity::model::StreamPortIndex, StreamPort> inputs{};
+		std::map<la::avdecc::entity::model::StreamPortIndex, StreamPort> outputs{};
+	};
+
+	struct ClockSource
+	{
+		la::avdecc::entity::model::AvdeccFixedString name{};
+		la::avdecc::entity::model::ClockSourceType clockSourceType{ la::avdecc::entity::model::ClockSourceType::Internal };
+		la::avdecc::entity::model::DescriptorType clockSourceLocationType{ la::avdecc::entity::model::DescriptorType::Invalid };
+		la::avdecc::entity::model::DescriptorIndex clockSourceLocationIndex{ 0u };
+	};
+	struct ClockDomain
+	{
+		la::avdecc::entity::model::AvdeccFixedString name{};
+		la::avdecc::entity::model::ClockSourceIndex clockSourceIndex{ 0u };
+	};
+	struct Clocks
+	{
+		std::map<la::avdecc::entity::model::ClockDomainIndex, ClockDomain> clockDomains{};
+		std::map<la::avdecc::entity::model::ClockSourceIndex, ClockSource> clockSources{};
+		std::map<la::avdecc::entity::model::AudioUnitIndex, la::avdecc::entity::model::SamplingRate> samplingRates{}; // Current sampling rate of each audio unit
+	};
+
+	std::uint64_t version{ 0u }; // Strictly increasing each time a snapshot is published (for any entity)
+	la::avdecc::UniqueIdentifier entityID{};
+	bool isAemSupported{ false };
+	bool hasConfiguration{ false }; // If false, all the fields below are empty
+	la::avdecc::entity::model::ConfigurationIndex currentConfiguration{ 0u };
+	la::avdecc::entity::model::AvdeccFixedString entityName{};
+	la::avdecc::entity::model::AvdeccFixedString groupName{};
+	std::shared_ptr<Streams const> streams{ std::make_shared<Streams const>() };
+	std::shared_ptr<StreamPorts const> streamPorts{ std::make_shared<StreamPorts const>() };
+	std::shared_ptr<Clocks const> clocks{ std::make_shared<Clocks const>() };
+};
+
+using SharedEntitySnapshot = std::shared_ptr<EntitySnapshot const>;
+
+} // namespace modelsLibrary
+} // namespace hive
@@ -0,0 +1,247 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Streaming writer for network state dumps
+ * @Details Writes the same bytes than serializing the whole network state object at once (JSON with an indentation of 4, or MessagePack), one entity at a time, so the memory used does not depend on the number of entities.
+ *          Entities are serialized by serializeEntity (which can be called from any thread), then written in order by writeEntity.
+ *          In binary format, the number of entities must be known before the first one is written, so entities are spilled to a temporary file until finish is called.
+ */
+class NetworkStateJsonWriter final
+{
+public:
+	using json = nlohmann::json;
+
+	// Network state dump format, as loaded by la::avdecc::controller::Controller::loadVirtualEntitiesFromJsonNetworkState
+	static constexpr auto DumpVersionKey = "dump_version";
+	static constexpr auto DumpSourceKey = "_dump_source (informative)";
+	static constexpr auto EntitiesKey = "entities";
+	static constexpr auto DumpVersion = std::uint32_t{ 1u };
+
+	/** Serializes an entity object, the way it appears in the network state. Can be called from any thread. Might throw json::exception. */
+	static std::string serializeEntity(json const& entity, bool const binary)
+	{
+		if (binary)
+		{
+			auto const bytes = json::to_msgpack(entity);
+			return std::string{ reinterpret_cast<char const*>(bytes.data()), bytes.size() };
+		}
+
+		// Entities are 2 levels deep in the network state object
+		auto const text = entity.dump(4);
+		auto result = std::string{};
+		result.reserve(text.size() + text.size() / 8u);
+		result.append(EntityIndentation);
+		for (auto const c : text)
+		{
+			result.push_back(c);
+			if (c == '\n')
+			{
+				result.append(EntityIndentation);
+			}
+		}
+		return result;
+	}
+
+	NetworkStateJsonWriter(std::filesystem::path const& filePath, bool const binary, std::string const& dumpSource) noexcept
+		: _filePath{ filePath }
+		, _binary{ binary }
+	{
+		// Serialize the network state object without entities, the entities value being the last one (keys are sorted)
+		auto object = json{};
+		object[DumpVersionKey] = DumpVersion;
+		object[DumpSourceKey] = dumpSource;
+		object[EntitiesKey] = nullptr;
+
+		try
+		{
+			if (_binary)
+			{
+				auto const bytes = json::to_msgpack(object);
+				// Remove the null value
+				_header.assign(reinterpret_cast<char const*>(bytes.data()), bytes.size() - 1u);
+				_spillFilePath = _filePath;
+				_spillFilePath += ".entities";
+				_output.open(_spillFilePath, std::ios::binary | std::ios::out | std::ios::trunc);
+			}
+			else
+			{
+				auto const text = object.dump(4);
+				auto const nullPosition = text.rfind("null");
+				_header = text.substr(0u, nullPosition);
+				_footer = text.substr(nullPosition + 4u) + "\n";
+				_output.open(_filePath, std::ios::binary | std::ios::out | std::ios::trunc);
+				_output.write(_header.data(), _header.size());
+			}
+		}
+		catch (json::exception const&)
+		{
+			_output.setstate(std::ios::failbit);
+		}
+	}
+
+	~NetworkStateJsonWriter() noexcept
+	{
+		if (!_finished)
+		{
+			abort();
+		}
+	}
+
+	/** Returns true if the output file could be created, and no write error occurred */
+	bool isGood() const noexcept
+	{
+		return _output.is_open() && _output.good();
+	}
+
+	std::size_t entitiesCount() const noexcept
+	{
+		return _entitiesCount;
+	}
+
+	/** Writes an entity serialized by serializeEntity */
+	bool writeEntity(std::string const& serializedEntity) noexcept
+	{
+		if (!_binary)
+		{
+			_output << (_entitiesCount == 0u ? "[\n" : ",\n");
+		}
+		_output.write(serializedEntity.data(), serializedEntity.size());
+		++_entitiesCount;
+		return isGood();
+	}
+
+	/** Completes the file, returns false if a write error occurred */
+	bool finish() noexcept
+	{
+		if (!isGood())
+		{
+			abort();
+			return false;
+		}
+		_finished = true;
+
+		if (!_binary)
+		{
+			_output << (_entitiesCount == 0u ? "null" : "\n    ]");
+			_output.write(_footer.data(), _footer.size());
+			_output.close();
+			return !_output.fail();
+		}
+
+		// Write the header, then copy the spilled entities
+		_output.close();
+		auto input = std::ifstream{ _spillFilePath, std::ios::binary | std::ios::in };
+		auto output = std::ofstream{ _filePath, std::ios::binary | std::ios::out | std::ios::trunc };
+		output.write(_header.data(), _header.size());
+		if (_entitiesCount == 0u)
+		{
+			output.put(static_cast<char>(0xc0)); // null
+		}
+		else
+		{
+			auto const arrayHeader = msgpackArrayHeader(_entitiesCount);
+			output.write(arrayHeader.data(), arrayHeader.size());
+			auto buffer = std::array<char, 64 * 1024>{};
+			while (input.read(buffer.data(), buffer.size()) || input.gcount() > 0)
+			{
+				output.write(buffer.data(), input.gcount());
+			}
+		}
+		output.close();
+		input.close();
+
+		auto error = std::error_code{};
+		std::filesystem::remove(_spillFilePath, error);
+
+		return !output.fail();
+	}
+
+	/** Stops writing and removes the output file */
+	void abort() noexcept
+	{
+		_finished = true;
+		_output.close();
+
+		auto error = std::error_code{};
+		std::filesystem::remove(_binary ? _spillFilePath : _filePath, error);
+	}
+
+	// Deleted compiler auto-generated methods
+	NetworkStateJsonWriter(NetworkStateJsonWriter const&) = delete;
+	NetworkStateJsonWriter(NetworkStateJsonWriter&&) = delete;
+	NetworkStateJsonWriter& operator=(NetworkStateJsonWriter const&) = delete;
+	NetworkStateJsonWriter& operator=(NetworkStateJsonWriter&&) = delete;
+
+private:
+	static constexpr auto EntityIndentation = "        ";
+
+	/** Returns the smallest MessagePack array header for the specified count (as the json serializer does) */
+	static std::string msgpackArrayHeader(std::size_t const count) noexcept
+	{
+		auto header = std::string{};
+		if (count <= 15u)
+		{
+			header.push_back(static_cast<char>(0x90u | count));
+		}
+		else if (count <= 0xFFFFu)
+		{
+			header.push_back(static_cast<char>(0xdcu));
+			header.push_back(static_cast<char>((count >> 8) & 0xFFu));
+			header.push_back(static_cast<char>(count & 0xFFu));
+		}
+		else
+		{
+			header.push_back(static_cast<char>(0xddu));
+			for (auto shift = 24; shift >= 0; shift -= 8)
+			{
+				header.push_back(static_cast<char>((count >> shift) & 0xFFu));
+			}
+		}
+		return header;
+	}
+
+	std::filesystem::path _filePath{};
+	std::filesystem::path _spillFilePath{};
+	bool _binary{ false };
+	std::string _header{};
+	std::string _footer{};
+	std::ofstream _output{};
+	std::size_t _entitiesCount{ 0u };
+	bool _finished{ false };
+};
+
+} // namespace modelsLibrary
+} // namespace hive
@@ -0,0 +1,185 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Thread-safe latest-value store
+ * @Details Keeps only the most recent value pushed for each Key (or the values merged by a custom function), until the pending values are drained.
+ *          Values can be pushed from any thread, draining is expected to be done from a single consumer thread (usually the UI thread, on a timer tick).
+ *          Drained entries are returned in the order their key was first pushed since the last drain.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class NotificationCoalescer final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		Key key{};
+		Value value{};
+		Clock::time_point firstPushTime{}; // Time the key was first pushed since last drain
+		std::uint32_t coalescedCount{ 0u }; // Number of values that were replaced by a newer one
+	};
+	using Entries = std::vector<Entry>;
+
+	struct Statistics
+	{
+		std::uint64_t pushedCount{ 0u }; // Total number of values pushed
+		std::uint64_t drainedCount{ 0u }; // Total number of values returned by drain (pushedCount - drainedCount is the number of coalesced or discarded values)
+		std::uint64_t drainCount{ 0u }; // Number of non-empty drains
+		std::size_t maxPendingCount{ 0u }; // Highest number of pending keys observed
+		std::chrono::microseconds maxLatency{}; // Highest time between a key first push and its drain
+		std::chrono::microseconds lastLatency{}; // Time between the oldest key first push and the last drain
+	};
+
+	NotificationCoalescer() noexcept = default;
+
+	/** Pushes a new value for the specified key, replacing the pending one if any. Returns true if there was no pending value before this call (meaning a drain should be scheduled). */
+	bool push(Key const& key, Value value) noexcept
+	{
+		return push(key, std::move(value),
+			[](Value& pendingValue, Value&& newValue)
+			{
+				pendingValue = std::move(newValue);
+			});
+	}
+
+	/** Pushes a new value for the specified key, calling merge(pendingValue, std::move(value)) if there is a pending one (the store being locked during the call). Returns true if there was no pending value before this call (meaning a drain should be scheduled). */
+	template<typename Merge>
+	bool push(Key const& key, Value value, Merge&& merge) noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		auto const wasEmpty = _entries.empty();
+		++_statistics.pushedCount;
+
+		if (auto const it = _positions.find(key); it != std::end(_positions))
+		{
+			auto& entry = _entries[it->second];
+			merge(entry.value, std::move(value));
+			++entry.coalescedCount;
+		}
+		else
+		{
+			_positions.emplace(key, _entries.size());
+			_entries.push_back(Entry{ key, std::move(value), Clock::now(), 0u });
+			_statistics.maxPendingCount = std::max(_statistics.maxPendingCount, _entries.size());
+		}
+
+		return wasEmpty;
+	}
+
+	/** Returns all pending entries, leaving the store empty. */
+	Entries drain() noexcept
+	{
+		auto entries = Entries{};
+		{
+			auto const lg = std::lock_guard{ _lock };
+			entries.swap(_entries);
+			_positions.clear();
+
+			if (!entries.empty())
+			{
+				// Entries are stored in first push order, so the first one is the oldest
+				auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - entries.front().firstPushTime);
+				_statistics.drainedCount += entries.size();
+				++_statistics.drainCount;
+				_statistics.lastLatency = latency;
+				_statistics.maxLatency = std::max(_statistics.maxLatency, latency);
+			}
+		}
+		return entries;
+	}
+
+	/** Removes all pending entries for which the predicate returns true. */
+	void discard(std::function<bool(Key const&)> const& predicate) noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		_entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+										 [&predicate](auto const& entry)
+										 {
+											 return predicate(entry.key);
+										 }),
+			_entries.end());
+
+		// Rebuild positions
+		_positions.clear();
+		for (auto pos = std::size_t{ 0u }; pos < _entries.size(); ++pos)
+		{
+			_positions.emplace(_entries[pos].key, pos);
+		}
+	}
+
+	/** Removes all pending entries. */
+	void clear() noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_entries.clear();
+		_positions.clear();
+	}
+
+	std::size_t pendingCount() const noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		return _entries.size();
+	}
+
+	Statistics getStatistics() const noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		return _statistics;
+	}
+
+	void resetStatistics() noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_statistics = {};
+	}
+
+	// Deleted compiler auto-generated methods
+	NotificationCoalescer(NotificationCoalescer const&) = delete;
+	NotificationCoalescer(NotificationCoalescer&&) = delete;
+	NotificationCoalescer& operator=(NotificationCoalescer const&) = delete;
+	NotificationCoalescer& operator=(NotificationCoalescer&&) = delete;
+
+private:
+	mutable std::mutex _lock{};
+	Entries _entries{};
+	std::unordered_map<Key, std::size_t, Hash> _positions{};
+	Statistics _statistics{};
+};
+
+} // namespace modelsLibrary
+} // namespace hive
@@ -0,0 +1,203 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Runs a task for a list of items on worker threads, delivering the results in order
+ * @Details Results are produced concurrently by the workers, and consumed on the calling thread in item order (so they can be streamed to a file).
+ *          The number of produced but not yet consumed results is bounded, so the memory used does not depend on the number of items.
+ *          A progress handler is called on the calling thread after each consumed result (and regularly while waiting), returning false cancels the remaining items.
+ */
+template<typename Result>
+class OrderedParallelProcessor final
+{
+public:
+	using Producer = std::function<Result(std::size_t const index)>; // Called from a worker thread, must not throw
+	using Consumer = std::function<void(std::size_t const index, Result&& result)>; // Called from the calling thread, in index order
+	using ProgressHandler = std::function<bool(std::size_t const consumedCount, std::size_t const totalCount)>; // Called from the calling thread, returns false to cancel
+
+	static constexpr auto ProgressInterval = std::chrono::milliseconds{ 50 };
+
+	/** Creates a processor with the specified number of workers (0 for the number of hardware threads) and maximum number of pending results (0 for twice the number of workers) */
+	OrderedParallelProcessor(std::size_t const workersCount = 0u, std::size_t const maxPendingResults = 0u) noexcept
+		: _workersCount{ workersCount != 0u ? workersCount : std::max(std::size_t{ 1u }, static_cast<std::size_t>(std::thread::hardware_concurrency())) }
+		, _maxPendingResults{ maxPendingResults != 0u ? maxPendingResults : 2u * _workersCount }
+	{
+	}
+
+	std::size_t workersCount() const noexcept
+	{
+		return _workersCount;
+	}
+
+	std::size_t maxPendingResults() const noexcept
+	{
+		return _maxPendingResults;
+	}
+
+	/** Returns the highest number of pending results observed during the last run */
+	std::size_t maxPendingResultsObserved() const noexcept
+	{
+		return _maxPendingResultsObserved;
+	}
+
+	/** Processes itemsCount items, returns false if the processing was cancelled by the progress handler (some items might not have been consumed) */
+	bool run(std::size_t const itemsCount, Producer const& producer, Consumer const& consumer, ProgressHandler const& progressHandler = {}) noexcept
+	{
+		_nextIndex = 0u;
+		_consumedCount = 0u;
+		_cancelled = false;
+		_results.clear();
+		_maxPendingResultsObserved = 0u;
+
+		auto workers = std::vector<std::thread>{};
+		auto const workersCount = std::min(_workersCount, itemsCount);
+		for (auto worker = std::size_t{ 0u }; worker < workersCount; ++worker)
+		{
+			workers.emplace_back(
+				[this, itemsCount, &producer]()
+				{
+					produce(itemsCount, producer);
+				});
+		}
+
+		auto cancelled = false;
+		auto consumedCount = std::size_t{ 0u };
+		while (consumedCount < itemsCount)
+		{
+			auto result = std::optional<Result>{};
+			{
+				auto lock = std::unique_lock{ _lock };
+				if (_resultAvailable.wait_for(lock, ProgressInterval,
+							[this, consumedCount]()
+							{
+								return _results.count(consumedCount) != 0;
+							}))
+				{
+					auto node = _results.extract(consumedCount);
+					result.emplace(std::move(node.mapped()));
+				}
+			}
+
+			if (result)
+			{
+				consumer(consumedCount, std::move(*result));
+				++consumedCount;
+				{
+					auto const lg = std::lock_guard{ _lock };
+					_consumedCount = consumedCount;
+				}
+				// A slot is available in the pending results window
+				_slotAvailable.notify_all();
+			}
+
+			if (progressHandler && !progressHandler(consumedCount, itemsCount))
+			{
+				cancelled = true;
+				break;
+			}
+		}
+
+		if (cancelled)
+		{
+			{
+				auto const lg = std::lock_guard{ _lock };
+				_cancelled = true;
+			}
+			_slotAvailable.notify_all();
+		}
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+		_results.clear();
+
+		return !cancelled;
+	}
+
+	// Deleted compiler auto-generated methods
+	OrderedParallelProcessor(OrderedParallelProcessor const&) = delete;
+	OrderedParallelProcessor(OrderedParallelProcessor&&) = delete;
+	OrderedParallelProcessor& operator=(OrderedParallelProcessor const&) = delete;
+	OrderedParallelProcessor& operator=(OrderedParallelProcessor&&) = delete;
+
+private:
+	void produce(std::size_t const itemsCount, Producer const& producer) noexcept
+	{
+		while (true)
+		{
+			auto index = std::size_t{ 0u };
+			{
+				auto lock = std::unique_lock{ _lock };
+				// Wait for the next item to be in the pending results window
+				_slotAvailable.wait(lock,
+					[this]()
+					{
+						return _cancelled || _nextIndex < _consumedCount + _maxPendingResults;
+					});
+				if (_cancelled || _nextIndex >= itemsCount)
+				{
+					return;
+				}
+				index = _nextIndex++;
+			}
+
+			auto result = producer(index);
+
+			{
+				auto const lg = std::lock_guard{ _lock };
+				_results.emplace(index, std::move(result));
+				_maxPendingResultsObserved = std::max(_maxPendingResultsObserved, _results.size());
+			}
+			_resultAvailable.notify_one();
+		}
+	}
+
+	std::size_t const _workersCount{ 1u };
+	std::size_t const _maxPendingResults{ 2u };
+	std::mutex _lock{};
+	std::condition_variable _slotAvailable{};
+	std::condition_variable _resultAvailable{};
+	std::size_t _nextIndex{ 0u }; // Next item to produce
+	std::size_t _consumedCount{ 0u };
+	bool _cancelled{ false };
+	std::map<std::size_t, Result> _results{}; // Produced but not yet consumed results
+	std::size_t _maxPendingResultsObserved{ 0u };
+};
+
+} // namespace modelsLibrary
+} // namespace hive
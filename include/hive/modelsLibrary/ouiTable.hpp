@@ -0,0 +1,84 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Compile-time table of OUIs
+ * @Details Sorted OUIs and, at the same position, the index of their vendor name in a separate pool (each vendor name being stored only once).
+ *          Keys and name indexes are stored in separate arrays so the lookup only walks the (small) keys.
+ *          NameIndex is the smallest unsigned type able to index the pool of vendor names.
+ *          Tables are generated by tools/generate_oui.py during the build.
+ */
+template<typename Key, std::size_t Count, typename NameIndex = std::uint8_t>
+struct OuiTable
+{
+	std::array<Key, Count> ouis{}; // Sorted in ascending order
+	std::array<NameIndex, Count> nameIndexes{}; // Index of the vendor name of each OUI
+
+	/** Returns the index of the vendor name of the OUI, using a branchless binary search */
+	constexpr std::optional<NameIndex> find(Key const oui) const noexcept
+	{
+		if constexpr (Count == 0u)
+		{
+			return std::nullopt;
+		}
+		else
+		{
+			// Find the last OUI lower or equal to the searched one, the only branch being the loop (known number of iterations)
+			auto position = std::size_t{ 0u };
+			auto length = Count;
+			while (length > 1u)
+			{
+				auto const half = length / 2u;
+				position += (ouis[position + half] <= oui) ? half : 0u;
+				length -= half;
+			}
+			if (ouis[position] != oui)
+			{
+				return std::nullopt;
+			}
+			return nameIndexes[position];
+		}
+	}
+
+	constexpr bool isSorted() const noexcept
+	{
+		for (auto i = std::size_t{ 1u }; i < Count; ++i)
+		{
+			if (!(ouis[i - 1u] < ouis[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+} // namespace modelsLibrary
+} // namespace hive
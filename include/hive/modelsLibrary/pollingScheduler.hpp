@@ -0,0 +1,347 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Rate limited scheduler for the periodic polling of entities
+ * @Details Each entity is polled at an interval depending on its state: selected in the UI, recently reported errors, or idle (the default).
+ *          All polls (one round of queries to an entity each) share a single token bucket (refilled at Configuration::pollsPerSecond, up to Configuration::burstSize tokens), so the polling cost is bounded whatever the number of entities:
+ *          when more entities are due than tokens available, the ones due for the longest time are polled first and the others are deferred.
+ *          An entity reporting timeouts has its interval multiplied by backoffFactor (up to maxBackoff), the backoff being divided again by backoffFactor on each poll once no timeout was reported for backoffRecoveryTime.
+ *          The scheduler does not poll anything nor use any clock: the caller provides the current time, calls takeDue to get the entities to poll, and uses getNextPollDelay to know when to call it again.
+ */
+template<typename Key, typename KeyHash = std::hash<Key>>
+class PollingScheduler final
+{
+public:
+	using Duration = std::chrono::milliseconds;
+
+	struct Configuration
+	{
+		double pollsPerSecond{ 0.5 }; // Network wide budget
+		double burstSize{ 4.0 }; // Maximum number of polls that can be done at once
+		Duration idleInterval{ std::chrono::seconds{ 60 } };
+		Duration errorInterval{ std::chrono::seconds{ 15 } };
+		Duration selectedInterval{ std::chrono::seconds{ 5 } };
+		Duration errorHoldTime{ std::chrono::minutes{ 5 } }; // Time during which an entity that reported errors uses errorInterval
+		double backoffFactor{ 2.0 };
+		double maxBackoff{ 16.0 };
+		Duration backoffRecoveryTime{ std::chrono::minutes{ 1 } };
+	};
+
+	struct Statistics
+	{
+		std::uint64_t pollsCount{ 0u }; // Total number of polls returned by takeDue
+		std::uint64_t deferredCount{ 0u }; // Number of times a due entity had to wait for a token
+		std::uint64_t timeoutsCount{ 0u }; // Number of timeouts notified
+	};
+
+	PollingScheduler() noexcept = default;
+
+	void setConfiguration(Configuration const& configuration) noexcept
+	{
+		_configuration = configuration;
+		_tokens = std::min(_tokens, _configuration.burstSize);
+	}
+
+	Configuration const& getConfiguration() const noexcept
+	{
+		return _configuration;
+	}
+
+	/** Adds an entity to poll, its first poll being one interval from now (it has just been enumerated). Does nothing if the entity is already known (its state is kept) */
+	void addEntity(Key const& key, Duration const now) noexcept
+	{
+		auto const [it, inserted] = _entities.try_emplace(key);
+		if (inserted)
+		{
+			auto& entity = it->second;
+			entity.lastPollTime = now;
+			schedule(key, entity, now + computeInterval(entity, now));
+		}
+	}
+
+	/** Removes an entity, its pending poll is dropped */
+	void removeEntity(Key const& key) noexcept
+	{
+		_entities.erase(key);
+		// Stale queue entries are skipped when they reach the top
+	}
+
+	bool hasEntity(Key const& key) const noexcept
+	{
+		return _entities.count(key) != 0u;
+	}
+
+	std::size_t getEntitiesCount() const noexcept
+	{
+		return _entities.size();
+	}
+
+	/** Sets the selected state of an entity, a newly selected entity is polled as soon as the selected interval elapsed since its last poll (right away if it was not polled recently) */
+	void setSelected(Key const& key, bool const isSelected, Duration const now) noexcept
+	{
+		if (auto* const entity = findEntity(key))
+		{
+			if (entity->isSelected == isSelected)
+			{
+				return;
+			}
+			entity->isSelected = isSelected;
+			auto const dueTime = entity->lastPollTime + computeInterval(*entity, now);
+			reschedule(key, *entity, isSelected ? std::min(entity->dueTime, dueTime) : dueTime);
+		}
+	}
+
+	/** Notifies that an entity reported errors, it is polled more often during errorHoldTime */
+	void notifyErrors(Key const& key, Duration const now) noexcept
+	{
+		if (auto* const entity = findEntity(key))
+		{
+			entity->lastErrorTime = now;
+			// Only bring the next poll closer, never delay it
+			auto const dueTime = entity->lastPollTime + computeInterval(*entity, now);
+			if (dueTime < entity->dueTime)
+			{
+				reschedule(key, *entity, dueTime);
+			}
+		}
+	}
+
+	/** Notifies that a command to an entity timed out, its polling interval is increased */
+	void notifyTimeout(Key const& key, Duration const now) noexcept
+	{
+		++_statistics.timeoutsCount;
+		if (auto* const entity = findEntity(key))
+		{
+			entity->backoff = std::min(entity->backoff * _configuration.backoffFactor, _configuration.maxBackoff);
+			entity->lastTimeoutTime = now;
+			// Push the next poll back, never bring it closer
+			auto const dueTime = now + computeInterval(*entity, now);
+			if (dueTime > entity->dueTime)
+			{
+				reschedule(key, *entity, dueTime);
+			}
+		}
+	}
+
+	/** Returns the current backoff multiplier of an entity (1 if not backing off or unknown) */
+	double getBackoff(Key const& key) const noexcept
+	{
+		if (auto const it = _entities.find(key); it != _entities.end())
+		{
+			return it->second.backoff;
+		}
+		return 1.0;
+	}
+
+	/** Returns the entities to poll now (within the available tokens), and schedules their next poll */
+	std::vector<Key> takeDue(Duration const now) noexcept
+	{
+		refill(now);
+
+		auto keys = std::vector<Key>{};
+		while (!_queue.empty())
+		{
+			auto const top = _queue.top();
+			auto* const entity = findEntity(top.key);
+			if (!entity || entity->generation != top.generation)
+			{
+				_queue.pop();
+				continue;
+			}
+			if (top.dueTime > now)
+			{
+				break;
+			}
+			if (_tokens < 1.0)
+			{
+				if (!entity->isDeferred)
+				{
+					entity->isDeferred = true;
+					++_statistics.deferredCount;
+				}
+				break;
+			}
+
+			_queue.pop();
+			_tokens -= 1.0;
+			++_statistics.pollsCount;
+
+			entity->isDeferred = false;
+			entity->lastPollTime = now;
+			if (entity->backoff > 1.0 && (!entity->lastTimeoutTime || now - *entity->lastTimeoutTime >= _configuration.backoffRecoveryTime))
+			{
+				entity->backoff = std::max(1.0, entity->backoff / _configuration.backoffFactor);
+			}
+			schedule(top.key, *entity, now + computeInterval(*entity, now));
+			keys.push_back(top.key);
+		}
+		return keys;
+	}
+
+	/** Returns the time to wait before the next call to takeDue, or nothing if there is no entity to poll */
+	std::optional<Duration> getNextPollDelay(Duration const now) noexcept
+	{
+		// Drop stale entries so the top of the queue is a valid one
+		while (!_queue.empty())
+		{
+			auto const& top = _queue.top();
+			auto const* const entity = findEntity(top.key);
+			if (entity && entity->generation == top.generation)
+			{
+				break;
+			}
+			_queue.pop();
+		}
+		if (_queue.empty())
+		{
+			return std::nullopt;
+		}
+
+		refill(now);
+		auto delay = std::max(Duration{ 0 }, _queue.top().dueTime - now);
+		if (_tokens < 1.0 && _configuration.pollsPerSecond > 0.0)
+		{
+			// Round up, so the token is available when woken up
+			auto const tokenDelay = Duration{ static_cast<Duration::rep>((1.0 - _tokens) * 1000.0 / _configuration.pollsPerSecond) + 1 };
+			delay = std::max(delay, tokenDelay);
+		}
+		return delay;
+	}
+
+	Statistics const& getStatistics() const noexcept
+	{
+		return _statistics;
+	}
+
+	/** Removes all entities and refills the token bucket */
+	void clear() noexcept
+	{
+		_entities.clear();
+		_queue = Queue{};
+		_tokens = _configuration.burstSize;
+		_lastRefillTime.reset();
+	}
+
+private:
+	struct Entity
+	{
+		Duration dueTime{};
+		Duration lastPollTime{};
+		std::optional<Duration> lastErrorTime{};
+		std::optional<Duration> lastTimeoutTime{};
+		double backoff{ 1.0 };
+		std::uint64_t generation{ 0u }; // Generation of the valid queue entry of the entity
+		bool isSelected{ false };
+		bool isDeferred{ false }; // Due but waiting for a token (only counted once in the statistics)
+	};
+
+	struct QueueEntry
+	{
+		Duration dueTime{};
+		std::uint64_t generation{ 0u };
+		Key key{};
+
+		bool operator>(QueueEntry const& other) const noexcept
+		{
+			// Same due time: first scheduled first
+			return dueTime != other.dueTime ? dueTime > other.dueTime : generation > other.generation;
+		}
+	};
+	using Queue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+	Entity* findEntity(Key const& key) noexcept
+	{
+		if (auto const it = _entities.find(key); it != _entities.end())
+		{
+			return &it->second;
+		}
+		return nullptr;
+	}
+
+	Duration computeInterval(Entity const& entity, Duration const now) const noexcept
+	{
+		auto interval = _configuration.idleInterval;
+		if (entity.isSelected)
+		{
+			interval = _configuration.selectedInterval;
+		}
+		else if (entity.lastErrorTime && now - *entity.lastErrorTime < _configuration.errorHoldTime)
+		{
+			interval = _configuration.errorInterval;
+		}
+		return Duration{ static_cast<Duration::rep>(static_cast<double>(interval.count()) * entity.backoff) };
+	}
+
+	void schedule(Key const& key, Entity& entity, Duration const dueTime) noexcept
+	{
+		// Each scheduling invalidates the previous queue entry of the entity (lazy deletion)
+		entity.generation = ++_lastGeneration;
+		entity.dueTime = dueTime;
+		_queue.push(QueueEntry{ dueTime, entity.generation, key });
+	}
+
+	void reschedule(Key const& key, Entity& entity, Duration const dueTime) noexcept
+	{
+		if (dueTime != entity.dueTime)
+		{
+			schedule(key, entity, dueTime);
+		}
+	}
+
+	void refill(Duration const now) noexcept
+	{
+		if (_lastRefillTime && now > *_lastRefillTime)
+		{
+			auto const elapsedSeconds = std::chrono::duration<double>(now - *_lastRefillTime).count();
+			_tokens = std::min(_configuration.burstSize, _tokens + elapsedSeconds * _configuration.pollsPerSecond);
+		}
+		if (!_lastRefillTime || now > *_lastRefillTime)
+		{
+			_lastRefillTime = now;
+		}
+	}
+
+	Configuration _configuration{};
+	std::unordered_map<Key, Entity, KeyHash> _entities{};
+	Queue _queue{};
+	std::uint64_t _lastGeneration{ 0u };
+	double _tokens{ Configuration{}.burstSize };
+	std::optional<Duration> _lastRefillTime{};
+	Statistics _statistics{};
+};
+
+} // namespace modelsLibrary
+} // namespace hive
@@ -0,0 +1,204 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hive
+{
+namespace modelsLibrary
+{
+/**
+ * @Brief Read-copy-update store of immutable versioned values
+ * @Details Each Key holds a pointer to an immutable Value, which is replaced (never modified) when a writer publishes or updates it.
+ *          Readers atomically load the current pointer and keep the Value alive for as long as they hold it (the shared pointer being the read-side epoch), so they always see a consistent Value and never block a writer.
+ *          Writers are serialized with each other only, readers never take the writers lock.
+ *          The set of keys is itself copy-on-write: adding or removing a key copies the (small) keys table, updating the Value of an existing key does not.
+ *          Each Key is tagged with an Owner when published, so a late update or removal from a previous owner does not affect the value published by a newer one.
+ *          Value must have a 'std::uint64_t version' member, set by the store to a strictly increasing number each time a Value is published.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class SnapshotStore final
+{
+public:
+	using SharedValue = std::shared_ptr<Value const>;
+	using Owner = void const*;
+
+	SnapshotStore() noexcept = default;
+
+	/** Returns the current Value for the specified key, or nullptr if there is none. Can be called from any thread. */
+	SharedValue get(Key const& key) const noexcept
+	{
+		auto const slots = std::atomic_load(&_slots);
+		if (!slots)
+		{
+			return {};
+		}
+		auto const it = slots->find(key);
+		if (it == std::end(*slots))
+		{
+			return {};
+		}
+		return std::atomic_load(&it->second->value);
+	}
+
+	/** Returns the keys that currently have a Value. Can be called from any thread. */
+	std::vector<Key> keys() const noexcept
+	{
+		auto result = std::vector<Key>{};
+		if (auto const slots = std::atomic_load(&_slots))
+		{
+			result.reserve(slots->size());
+			for (auto const& [key, slot] : *slots)
+			{
+				result.push_back(key);
+			}
+		}
+		return result;
+	}
+
+	/** Returns the version of the latest published Value */
+	std::uint64_t version() const noexcept
+	{
+		auto const lg = std::lock_guard{ _writeLock };
+		return _version;
+	}
+
+	/** Publishes a new Value for the specified key, replacing the current one (if any) and transferring the key to the specified owner */
+	SharedValue publish(Key const& key, Owner const owner, Value value) noexcept
+	{
+		auto const lg = std::lock_guard{ _writeLock };
+
+		value.version = ++_version;
+		auto sharedValue = SharedValue{ std::make_shared<Value const>(std::move(value)) };
+
+		auto const slots = std::atomic_load(&_slots);
+		if (slots)
+		{
+			if (auto const it = slots->find(key); it != std::end(*slots) && it->second->owner == owner)
+			{
+				std::atomic_store(&it->second->value, sharedValue);
+				return sharedValue;
+			}
+		}
+
+		// New key (or new owner): publish a new keys table
+		auto newSlots = slots ? std::make_shared<Slots>(*slots) : std::make_shared<Slots>();
+		(*newSlots)[key] = std::make_shared<Slot>(owner, sharedValue);
+		std::atomic_store(&_slots, SharedSlots{ std::move(newSlots) });
+
+		return sharedValue;
+	}
+
+	/**
+	 * @brief Publishes an updated copy of the current Value for the specified key.
+	 * @details The updater is called (with the writers lock held) with a copy of the current Value it can modify, then the copy is published.
+	 *          Nothing is published if the key has no Value, or if it is owned by another owner.
+	 * @return The published Value, or nullptr if nothing was published.
+	 */
+	template<typename Updater>
+	SharedValue update(Key const& key, Owner const owner, Updater&& updater) noexcept
+	{
+		auto const lg = std::lock_guard{ _writeLock };
+
+		auto const slots = std::atomic_load(&_slots);
+		if (!slots)
+		{
+			return {};
+		}
+		auto const it = slots->find(key);
+		if (it == std::end(*slots) || it->second->owner != owner)
+		{
+			return {};
+		}
+
+		auto value = *std::atomic_load(&it->second->value);
+		updater(value);
+		value.version = ++_version;
+		auto sharedValue = SharedValue{ std::make_shared<Value const>(std::move(value)) };
+		std::atomic_store(&it->second->value, sharedValue);
+
+		return sharedValue;
+	}
+
+	/** Removes the Value for the specified key, if it is owned by the specified owner. Returns true if the key was removed. */
+	bool remove(Key const& key, Owner const owner) noexcept
+	{
+		auto const lg = std::lock_guard{ _writeLock };
+
+		auto const slots = std::atomic_load(&_slots);
+		if (!slots)
+		{
+			return false;
+		}
+		auto const it = slots->find(key);
+		if (it == std::end(*slots) || it->second->owner != owner)
+		{
+			return false;
+		}
+
+		auto newSlots = std::make_shared<Slots>(*slots);
+		newSlots->erase(key);
+		std::atomic_store(&_slots, SharedSlots{ std::move(newSlots) });
+
+		return true;
+	}
+
+	/** Removes all Values */
+	void clear() noexcept
+	{
+		auto const lg = std::lock_guard{ _writeLock };
+		std::atomic_store(&_slots, SharedSlots{});
+	}
+
+	// Deleted compiler auto-generated methods
+	SnapshotStore(SnapshotStore const&) = delete;
+	SnapshotStore(SnapshotStore&&) = delete;
+	SnapshotStore& operator=(SnapshotStore const&) = delete;
+	SnapshotStore& operator=(SnapshotStore&&) = delete;
+
+private:
+	struct Slot
+	{
+		Slot(Owner const o, SharedValue v) noexcept
+			: owner{ o }
+			, value{ std::move(v) }
+		{
+		}
+
+		Owner const owner{ nullptr };
+		SharedValue value{}; // Only accessed through atomic load/store
+	};
+	using Slots = std::unordered_map<Key, std::shared_ptr<Slot>, Hash>;
+	using SharedSlots = std::shared_ptr<Slots const>;
+
+	mutable std::mutex _writeLock{}; // Serializes writers
+	SharedSlots _slots{}; // Only accessed through atomic load/store
+	std::uint64_t _version{ 0u };
+};
+
+} // namespace modelsLibrary
+} // namespace hive
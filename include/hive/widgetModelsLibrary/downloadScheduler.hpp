@@ -0,0 +1,331 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace hive
+{
+namespace widgetModelsLibrary
+{
+/**
+ * @Brief Schedules downloads shared by several requests, with priorities and a limit of downloads in flight
+ * @Details Each request is identified by a RequestKey and asks for a download (identified by a DownloadKey, shared by all the requests of the same content) from a Source.
+ *          Downloads are started in request order, higher priority ones first, with at most maxInFlight downloads at the same time and at most one download per Source.
+ *          A failed download is retried from the Source of another request of the same download, if any.
+ *          Cancelled requests are no longer served (a download in flight still counts until it completes). Not thread safe.
+ */
+template<typename DownloadKey, typename RequestKey, typename Source, typename DownloadKeyHash = std::hash<DownloadKey>, typename RequestKeyHash = std::hash<RequestKey>, typename SourceHash = std::hash<Source>>
+class DownloadScheduler final
+{
+public:
+	enum class Priority
+	{
+		Low,
+		Normal,
+		High,
+	};
+
+	using Requester = std::pair<Source, RequestKey>;
+
+	explicit DownloadScheduler(std::size_t const maxInFlight) noexcept
+		: _maxInFlight{ maxInFlight }
+	{
+	}
+
+	std::size_t inFlightCount() const noexcept
+	{
+		return _inFlightCount;
+	}
+
+	/** Returns true if the request is queued or its download is in flight */
+	bool isRequested(RequestKey const& requestKey) const noexcept
+	{
+		return _requests.count(requestKey) != 0;
+	}
+
+	/** Queues a request (ignored if already requested), or raises the priority of its download */
+	void request(DownloadKey const& downloadKey, Source const& source, RequestKey const& requestKey, Priority const priority) noexcept
+	{
+		auto const [downloadIt, inserted] = _downloads.try_emplace(downloadKey);
+		auto& download = downloadIt->second;
+		if (inserted)
+		{
+			_queue.push_back(downloadKey);
+			download.priority = priority;
+		}
+		else
+		{
+			download.priority = std::max(download.priority, priority);
+		}
+		if (_requests.emplace(requestKey, downloadKey).second)
+		{
+			download.requesters.emplace_back(source, requestKey);
+		}
+	}
+
+	/** Raises the priority of the download of a request, if any */
+	void promote(RequestKey const& requestKey) noexcept
+	{
+		if (auto const requestIt = _requests.find(requestKey); requestIt != _requests.end())
+		{
+			_downloads[requestIt->second].priority = Priority::High;
+		}
+	}
+
+	/** Cancels a request, its download is cancelled if it has no other request and is not in flight */
+	void cancel(RequestKey const& requestKey) noexcept
+	{
+		auto const requestIt = _requests.find(requestKey);
+		if (requestIt == _requests.end())
+		{
+			return;
+		}
+		auto const downloadKey = requestIt->second;
+		_requests.erase(requestIt);
+
+		auto const downloadIt = _downloads.find(downloadKey);
+		auto& requesters = downloadIt->second.requesters;
+		auto const requesterIt = std::find_if(requesters.begin(), requesters.end(),
+			[&requestKey](auto const& requester)
+			{
+				return requester.second == requestKey;
+			});
+		if (requesterIt != requesters.end())
+		{
+			requesters.erase(requesterIt);
+		}
+		removeIfUnused(downloadIt);
+	}
+
+	/** Cancels all the requests from a Source (going away) */
+	void cancelSource(Source const& source) noexcept
+	{
+		auto requestKeys = std::vector<RequestKey>{};
+		for (auto const& [downloadKey, download] : _downloads)
+		{
+			for (auto const& [requesterSource, requestKey] : download.requesters)
+			{
+				if (requesterSource == source)
+				{
+					requestKeys.push_back(requestKey);
+				}
+			}
+		}
+		for (auto const& requestKey : requestKeys)
+		{
+			cancel(requestKey);
+		}
+	}
+
+	/** Cancels all the requests */
+	void cancelAll() noexcept
+	{
+		_requests.clear();
+		_queue.clear();
+		for (auto it = _downloads.begin(); it != _downloads.end();)
+		{
+			it->second.requesters.clear();
+			if (it->second.isInFlight)
+			{
+				++it;
+			}
+			else
+			{
+				it = _downloads.erase(it);
+			}
+		}
+	}
+
+	/**
+	 * @brief Starts queued downloads, up to the maximum number of downloads in flight
+	 * @param[in] start Called as bool(DownloadKey const&, Source const&, RequestKey const&) to start a download from a source. Returns false if the source cannot be used, in which case its request is dropped and the next one is tried.
+	 */
+	template<typename Start>
+	void startDownloads(Start&& start)
+	{
+		while (_inFlightCount < _maxInFlight)
+		{
+			auto const nextIt = nextDownload();
+			if (nextIt == _queue.end())
+			{
+				return;
+			}
+
+			auto const downloadKey = *nextIt;
+			_queue.erase(nextIt);
+
+			auto const downloadIt = _downloads.find(downloadKey);
+			auto& download = downloadIt->second;
+			while (auto const requesterIndex = idleRequester(download))
+			{
+				auto const requester = download.requesters[*requesterIndex];
+				if (start(downloadKey, requester.first, requester.second))
+				{
+					download.isInFlight = true;
+					_busySources.insert(requester.first);
+					++_inFlightCount;
+					break;
+				}
+				_requests.erase(requester.second);
+				download.requesters.erase(download.requesters.begin() + *requesterIndex);
+			}
+
+			// Remaining requesters are all busy downloading something else, try again later
+			if (!download.isInFlight && !download.requesters.empty())
+			{
+				_queue.push_front(downloadKey);
+			}
+			removeIfUnused(downloadIt);
+		}
+	}
+
+	/**
+	 * @brief Completes a download started from a source
+	 * @return The requesters to serve if the download succeeded. Otherwise, the request of the source is dropped and the download is queued again (first) if it has other requests.
+	 */
+	std::vector<Requester> complete(DownloadKey const& downloadKey, Source const& source, bool const succeeded) noexcept
+	{
+		--_inFlightCount;
+		_busySources.erase(source);
+
+		auto result = std::vector<Requester>{};
+		auto const downloadIt = _downloads.find(downloadKey);
+		if (downloadIt == _downloads.end())
+		{
+			return result;
+		}
+
+		auto& download = downloadIt->second;
+		download.isInFlight = false;
+		if (succeeded)
+		{
+			for (auto const& requester : download.requesters)
+			{
+				_requests.erase(requester.second);
+			}
+			result = std::move(download.requesters);
+			_downloads.erase(downloadIt);
+			return result;
+		}
+
+		// Try again from the other sources
+		auto& requesters = download.requesters;
+		for (auto it = requesters.begin(); it != requesters.end();)
+		{
+			if (it->first == source)
+			{
+				_requests.erase(it->second);
+				it = requesters.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		if (!requesters.empty())
+		{
+			_queue.push_front(downloadKey);
+		}
+		removeIfUnused(downloadIt);
+		return result;
+	}
+
+	// Deleted compiler auto-generated methods
+	DownloadScheduler(DownloadScheduler const&) = delete;
+	DownloadScheduler(DownloadScheduler&&) = delete;
+	DownloadScheduler& operator=(DownloadScheduler const&) = delete;
+	DownloadScheduler& operator=(DownloadScheduler&&) = delete;
+
+private:
+	struct Download
+	{
+		std::vector<Requester> requesters{}; // In request order
+		Priority priority{ Priority::Normal };
+		bool isInFlight{ false };
+	};
+	using Downloads = std::unordered_map<DownloadKey, Download, DownloadKeyHash>;
+	using Queue = std::deque<DownloadKey>;
+
+	// Returns the index of the first requester whose source is not already downloading
+	std::optional<std::size_t> idleRequester(Download const& download) const noexcept
+	{
+		for (auto index = std::size_t{ 0u }; index < download.requesters.size(); ++index)
+		{
+			if (_busySources.count(download.requesters[index].first) == 0)
+			{
+				return index;
+			}
+		}
+		return {};
+	}
+
+	// Returns the first queued download that can be started, with the highest priority
+	typename Queue::iterator nextDownload() noexcept
+	{
+		auto nextIt = _queue.end();
+		auto nextPriority = Priority::Low;
+		for (auto it = _queue.begin(); it != _queue.end(); ++it)
+		{
+			auto const& download = _downloads.find(*it)->second;
+			if (!idleRequester(download))
+			{
+				continue;
+			}
+			if (download.priority == Priority::High)
+			{
+				return it;
+			}
+			if (nextIt == _queue.end() || download.priority > nextPriority)
+			{
+				nextIt = it;
+				nextPriority = download.priority;
+			}
+		}
+		return nextIt;
+	}
+
+	void removeIfUnused(typename Downloads::iterator const downloadIt) noexcept
+	{
+		if (downloadIt->second.requesters.empty() && !downloadIt->second.isInFlight)
+		{
+			_queue.erase(std::remove(_queue.begin(), _queue.end(), downloadIt->first), _queue.end());
+			_downloads.erase(downloadIt);
+		}
+	}
+
+	std::size_t const _maxInFlight{ 0u };
+	std::size_t _inFlightCount{ 0u };
+	Downloads _downloads{}; // Queued and in flight downloads
+	Queue _queue{}; // Downloads not started yet, in request order
+	std::unordered_map<RequestKey, DownloadKey, RequestKeyHash> _requests{}; // Download of each request
+	std::unordered_set<Source, SourceHash> _busySources{}; // Sources a download is in flight from
+};
+
+} // namespace widgetModelsLibrary
+} // namespace hive
@@ -23,6 +23,8 @@
 
 #include <QObject>
 #include <QImage>
+#include <QPixmap>
+#include <QSize>
 #include <QHash>
 
 namespace hive
@@ -42,7 +44,11 @@ public:
 
 	static EntityLogoCache& getInstance() noexcept;
 
+	/** Returns the logo from the memory cache. If not in the memory cache, an empty image is returned and the logo is asynchronously loaded from the disk cache (or downloaded if requested and not in the disk cache), imageChanged is emitted when available. Must be called in the GUI thread. */
 	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache = false) noexcept = 0;
+	/** Same as getImage, but returns the logo scaled to fit the specified size (in device pixels, keeping the aspect ratio). Scaled logos are kept in the memory cache so painting does not have to scale them. */
+	virtual QPixmap getPixmap(la::avdecc::UniqueIdentifier const entityID, Type const type, QSize const& size, bool const downloadIfNotInCache = false) noexcept = 0;
+	/** Returns true if the logo is in the disk cache or being downloaded */
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept = 0;
 
 	virtual void clear() noexcept = 0;
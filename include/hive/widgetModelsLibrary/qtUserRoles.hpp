@@ -37,6 +37,7 @@ enum class QtUserRoles : int
 	UnsolSupportedRole, /**< Role used for Supported Unsolicited Notifications representation */
 	IsVirtualRole, /**< Role used for Virtual Entity representation */
 	ActiveRole, /**< Role used for active item representation */
+	EntityLogoRole, /**< Role used for Entity Logo representation (EntityID of the logo, to be retrieved from the EntityLogoCache at the painted size) */
 };
 using RolesList = QVector<int>;
 
@@ -0,0 +1,182 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace hive
+{
+namespace widgetModelsLibrary
+{
+/**
+ * @Brief Least recently used cache bounded by the total cost of its values
+ * @Details Each value is inserted with a cost (usually its size in bytes). When the total cost exceeds the maximum cost,
+ *          the least recently used values are evicted. A value costing more than the maximum cost is not inserted.
+ *          Not thread safe.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class SizeBoundedLruCache final
+{
+public:
+	explicit SizeBoundedLruCache(std::size_t const maxCost) noexcept
+		: _maxCost{ maxCost }
+	{
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _index.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return _index.empty();
+	}
+
+	std::size_t cost() const noexcept
+	{
+		return _cost;
+	}
+
+	std::size_t maxCost() const noexcept
+	{
+		return _maxCost;
+	}
+
+	/** Changes the maximum cost, evicting the least recently used values if needed */
+	void setMaxCost(std::size_t const maxCost) noexcept
+	{
+		_maxCost = maxCost;
+		evict(0u);
+	}
+
+	bool contains(Key const& key) const noexcept
+	{
+		return _index.count(key) != 0;
+	}
+
+	/** Returns the value for the key and marks it as the most recently used one, or nullptr if not in the cache. The pointer is valid until the cache is modified. */
+	Value const* find(Key const& key) noexcept
+	{
+		auto const it = _index.find(key);
+		if (it == _index.end())
+		{
+			return nullptr;
+		}
+		_entries.splice(_entries.begin(), _entries, it->second);
+		return &it->second->value;
+	}
+
+	/** Inserts (or replaces) the value for the key as the most recently used one, returns false if it costs more than the maximum cost */
+	bool insert(Key const& key, Value value, std::size_t const cost) noexcept
+	{
+		remove(key);
+		if (cost > _maxCost)
+		{
+			return false;
+		}
+		evict(cost);
+		_entries.push_front(Entry{ key, std::move(value), cost });
+		_index.emplace(key, _entries.begin());
+		_cost += cost;
+		return true;
+	}
+
+	/** Removes the value for the key, returns false if not in the cache */
+	bool remove(Key const& key) noexcept
+	{
+		auto const it = _index.find(key);
+		if (it == _index.end())
+		{
+			return false;
+		}
+		_cost -= it->second->cost;
+		_entries.erase(it->second);
+		_index.erase(it);
+		return true;
+	}
+
+	/** Removes all the values for which the predicate (called with the key) returns true */
+	template<typename Predicate>
+	void removeIf(Predicate&& predicate) noexcept
+	{
+		for (auto it = _entries.begin(); it != _entries.end();)
+		{
+			if (predicate(static_cast<Key const&>(it->key)))
+			{
+				_cost -= it->cost;
+				_index.erase(it->key);
+				it = _entries.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void clear() noexcept
+	{
+		_entries.clear();
+		_index.clear();
+		_cost = 0u;
+	}
+
+	// Defaulted compiler auto-generated methods
+	SizeBoundedLruCache(SizeBoundedLruCache&&) = default;
+	SizeBoundedLruCache& operator=(SizeBoundedLruCache&&) = default;
+
+	// Deleted compiler auto-generated methods
+	SizeBoundedLruCache(SizeBoundedLruCache const&) = delete;
+	SizeBoundedLruCache& operator=(SizeBoundedLruCache const&) = delete;
+
+private:
+	struct Entry
+	{
+		Key key;
+		Value value;
+		std::size_t cost{ 0u };
+	};
+	using Entries = std::list<Entry>; // Most recently used first
+
+	// Evicts the least recently used values until the specified cost can be added
+	void evict(std::size_t const cost) noexcept
+	{
+		while (!_entries.empty() && _cost + cost > _maxCost)
+		{
+			auto const& entry = _entries.back();
+			_cost -= entry.cost;
+			_index.erase(entry.key);
+			_entries.pop_back();
+		}
+	}
+
+	std::size_t _maxCost{ 0u };
+	std::size_t _cost{ 0u };
+	Entries _entries{};
+	std::unordered_map<Key, typename Entries::iterator, Hash> _index{};
+};
+
+} // namespace widgetModelsLibrary
+} // namespace hive
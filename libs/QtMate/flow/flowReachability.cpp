@@ -0,0 +1,280 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "QtMate/flow/flowReachability.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <utility>
+
+namespace qtMate::flow
+{
+namespace
+{
+constexpr auto BitsPerWord = std::size_t{ 64u };
+
+std::size_t popCount(std::uint64_t const* const words, std::size_t const wordsCount) noexcept
+{
+	auto count = std::size_t{ 0u };
+	for (auto wordIndex = std::size_t{ 0u }; wordIndex < wordsCount; ++wordIndex)
+	{
+		count += std::bitset<BitsPerWord>{ words[wordIndex] }.count();
+	}
+	return count;
+}
+
+} // namespace
+
+void FlowReachability::addNode(Node const node) noexcept
+{
+	if (_nodes.count(node) != 0u)
+	{
+		return;
+	}
+
+	_nodes.emplace(node, NodeInfo{ allocateIndex() });
+}
+
+void FlowReachability::removeNode(Node const node) noexcept
+{
+	auto const nodeIt = _nodes.find(node);
+	if (nodeIt == _nodes.end())
+	{
+		return;
+	}
+
+	auto const index = nodeIt->second.index;
+
+	// Remove the incoming edges, and collect the ancestors which descendants have to be recomputed
+	auto ancestors = std::vector<NodeInfo*>{};
+	for (auto& [ancestor, info] : _nodes)
+	{
+		if (testBit(info.index, index))
+		{
+			if (auto const successorIt = info.successors.find(node); successorIt != info.successors.end())
+			{
+				_edgesCount -= successorIt->second;
+				info.successors.erase(successorIt);
+			}
+			ancestors.push_back(&info);
+		}
+	}
+
+	// Remove the outgoing edges
+	for (auto const& [successor, count] : nodeIt->second.successors)
+	{
+		_edgesCount -= count;
+	}
+
+	// Release the index
+	auto* const words = descendants(index);
+	std::fill(words, words + _wordsCount, Word{ 0u });
+	_freeIndexes.push_back(index);
+	_nodes.erase(nodeIt);
+
+	recomputeDescendants(ancestors);
+}
+
+bool FlowReachability::addEdge(Node const from, Node const to) noexcept
+{
+	auto const fromIt = _nodes.find(from);
+	auto const toIt = _nodes.find(to);
+	if (fromIt == _nodes.end() || toIt == _nodes.end() || wouldCreateCycle(from, to))
+	{
+		return false;
+	}
+
+	++fromIt->second.successors[to];
+	++_edgesCount;
+
+	auto const fromIndex = fromIt->second.index;
+	auto const toIndex = toIt->second.index;
+
+	// Already reachable, nothing new
+	if (testBit(fromIndex, toIndex))
+	{
+		return true;
+	}
+
+	// Everything reachable from the destination (and the destination itself) is now reachable from the source and its ancestors
+	auto const* const toWords = descendants(toIndex);
+	auto const toWord = toIndex / BitsPerWord;
+	auto const toMask = Word{ 1u } << (toIndex % BitsPerWord);
+	for (auto& [node, info] : _nodes)
+	{
+		if (info.index == fromIndex || testBit(info.index, fromIndex))
+		{
+			auto* const words = descendants(info.index);
+			for (auto wordIndex = std::size_t{ 0u }; wordIndex < _wordsCount; ++wordIndex)
+			{
+				words[wordIndex] |= toWords[wordIndex];
+			}
+			words[toWord] |= toMask;
+		}
+	}
+
+	return true;
+}
+
+void FlowReachability::removeEdge(Node const from, Node const to) noexcept
+{
+	auto const fromIt = _nodes.find(from);
+	if (fromIt == _nodes.end())
+	{
+		return;
+	}
+
+	auto& successors = fromIt->second.successors;
+	auto const successorIt = successors.find(to);
+	if (successorIt == successors.end())
+	{
+		return;
+	}
+
+	--_edgesCount;
+	if (--successorIt->second != 0u)
+	{
+		// Another edge still connects the nodes
+		return;
+	}
+	successors.erase(successorIt);
+
+	// The source and its ancestors are the only ones which descendants can change
+	auto const fromIndex = fromIt->second.index;
+	auto affected = std::vector<NodeInfo*>{};
+	for (auto& [node, info] : _nodes)
+	{
+		if (info.index == fromIndex || testBit(info.index, fromIndex))
+		{
+			affected.push_back(&info);
+		}
+	}
+	recomputeDescendants(affected);
+}
+
+void FlowReachability::clear() noexcept
+{
+	_nodes.clear();
+	_descendants.clear();
+	_wordsCount = 0u;
+	_indexesCount = 0u;
+	_freeIndexes.clear();
+	_edgesCount = 0u;
+}
+
+bool FlowReachability::reaches(Node const from, Node const to) const noexcept
+{
+	auto const fromIt = _nodes.find(from);
+	auto const toIt = _nodes.find(to);
+	if (fromIt == _nodes.end() || toIt == _nodes.end())
+	{
+		return false;
+	}
+
+	return testBit(fromIt->second.index, toIt->second.index);
+}
+
+bool FlowReachability::wouldCreateCycle(Node const from, Node const to) const noexcept
+{
+	return from == to || reaches(to, from);
+}
+
+std::size_t FlowReachability::nodesCount() const noexcept
+{
+	return _nodes.size();
+}
+
+std::size_t FlowReachability::edgesCount() const noexcept
+{
+	return _edgesCount;
+}
+
+FlowReachability::Word* FlowReachability::descendants(std::size_t const index) noexcept
+{
+	return _descendants.data() + index * _wordsCount;
+}
+
+FlowReachability::Word const* FlowReachability::descendants(std::size_t const index) const noexcept
+{
+	return _descendants.data() + index * _wordsCount;
+}
+
+bool FlowReachability::testBit(std::size_t const index, std::size_t const bit) const noexcept
+{
+	return (descendants(index)[bit / BitsPerWord] & (Word{ 1u } << (bit % BitsPerWord))) != 0u;
+}
+
+std::size_t FlowReachability::allocateIndex() noexcept
+{
+	if (!_freeIndexes.empty())
+	{
+		auto const index = _freeIndexes.back();
+		_freeIndexes.pop_back();
+		return index;
+	}
+
+	// Grow the bitsets (doubling their size), and the number of bitsets
+	if (_indexesCount == _wordsCount * BitsPerWord)
+	{
+		auto const wordsCount = std::max(std::size_t{ 1u }, _wordsCount * 2u);
+		auto descendants = std::vector<Word>(wordsCount * BitsPerWord * wordsCount, Word{ 0u });
+		for (auto index = std::size_t{ 0u }; index < _indexesCount; ++index)
+		{
+			std::copy_n(_descendants.data() + index * _wordsCount, _wordsCount, descendants.data() + index * wordsCount);
+		}
+		_descendants = std::move(descendants);
+		_wordsCount = wordsCount;
+	}
+
+	return _indexesCount++;
+}
+
+void FlowReachability::recomputeDescendants(std::vector<NodeInfo*> const& infos) noexcept
+{
+	// Ancestors of a node (in a DAG) always reached strictly more nodes than it, process them in that order so the successors are always up-to-date
+	auto sorted = std::vector<std::pair<std::size_t, NodeInfo*>>{};
+	sorted.reserve(infos.size());
+	for (auto* const info : infos)
+	{
+		sorted.emplace_back(popCount(descendants(info->index), _wordsCount), info);
+	}
+	std::sort(sorted.begin(), sorted.end(),
+		[](auto const& lhs, auto const& rhs)
+		{
+			return lhs.first < rhs.first;
+		});
+
+	for (auto const& [count, info] : sorted)
+	{
+		auto* const words = descendants(info->index);
+		std::fill(words, words + _wordsCount, Word{ 0u });
+		for (auto const& [successor, edgesCount] : info->successors)
+		{
+			auto const successorIndex = _nodes.at(successor).index;
+			auto const* const successorWords = descendants(successorIndex);
+			for (auto wordIndex = std::size_t{ 0u }; wordIndex < _wordsCount; ++wordIndex)
+			{
+				words[wordIndex] |= successorWords[wordIndex];
+			}
+			words[successorIndex / BitsPerWord] |= Word{ 1u } << (successorIndex % BitsPerWord);
+		}
+	}
+}
+
+} // namespace qtMate::flow
@@ -27,51 +27,6 @@
 
 namespace qtMate::flow
 {
-namespace
-{
-void ancestors(FlowNode* node, QSet<FlowNode*>& set)
-{
-	for (auto* input : node->inputs())
-	{
-		if (auto* connection = input->connection())
-		{
-			if (connection->output())
-			{
-				auto* parent = connection->output()->node();
-				if (!set.contains(parent))
-				{
-					set.insert(parent);
-					ancestors(parent, set);
-				}
-			}
-		}
-	}
-}
-
-void descendants(FlowNode* node, QSet<FlowNode*>& set)
-{
-	for (auto* output : node->outputs())
-	{
-		if (output->isConnected())
-		{
-			for (auto* connection : output->connections())
-			{
-				if (connection->input())
-				{
-					auto* child = connection->input()->node();
-					if (!set.contains(child))
-					{
-						set.insert(child);
-						descendants(child, set);
-					}
-				}
-			}
-		}
-	}
-}
-
-} // namespace
-
 FlowScene::FlowScene(FlowSceneDelegate* delegate, QObject* parent)
 	: QGraphicsScene{ parent }
 	, _delegate{ delegate }
@@ -90,6 +45,7 @@ FlowNode* FlowScene::createNode(FlowNodeUid const& uid, FlowNodeDescriptor const
 
 	auto* node = new FlowNode{ _delegate, uid, descriptor };
 	_nodes.insert(uid, node);
+	_reachability.addNode(uid);
 
 	addItem(node);
 
@@ -126,6 +82,7 @@ void FlowScene::destroyNode(FlowNodeUid const& uid)
 		removeItem(node);
 
 		_nodes.remove(uid);
+		_reachability.removeNode(uid);
 		delete node;
 
 		emit nodeDestroyed(uid);
@@ -159,6 +116,7 @@ FlowConnection* FlowScene::createConnection(FlowConnectionDescriptor const& desc
 	connection->setInput(sink);
 
 	_connections.insert(descriptor, connection);
+	_reachability.addEdge(descriptor.first.first, descriptor.second.first);
 
 	addItem(connection);
 
@@ -175,6 +133,7 @@ void FlowScene::destroyConnection(FlowConnectionDescriptor const& descriptor)
 		delete connection;
 
 		_connections.remove(descriptor);
+		_reachability.removeEdge(descriptor.first.first, descriptor.second.first);
 
 		emit connectionDestroyed(descriptor);
 	}
@@ -225,21 +184,8 @@ bool FlowScene::canConnect(FlowOutput* output, FlowInput* input) const
 		return false;
 	}
 
-	if (output->node() == input->node())
-	{
-		return false;
-	}
-
-	auto outputHierarchy = QSet<FlowNode*>{};
-	ancestors(output->node(), outputHierarchy);
-	if (outputHierarchy.contains(input->node()))
-	{
-		return false;
-	}
-
-	auto inputHierarchy = QSet<FlowNode*>{};
-	descendants(input->node(), inputHierarchy);
-	if (inputHierarchy.contains(output->node()))
+	// Connecting a node to itself, or to one of its ancestors, would create a cycle
+	if (_reachability.wouldCreateCycle(output->node()->uid(), input->node()->uid()))
 	{
 		return false;
 	}
@@ -20,11 +20,35 @@
 #include "commandsExecutorImpl.hpp"
 #include "virtualController.hpp"
 #include "hive/modelsLibrary/controllerManager.hpp"
-
+#include "hive/modelsLibrary/helper.hpp"
+#include "hive/modelsLibrary/notificationCoalescer.hpp"
+#include "hive/modelsLibrary/snapshotStore.hpp"
+#include "hive/modelsLibrary/orderedParallelProcessor.hpp"
+#include "hive/modelsLibrary/networkStateJsonWriter.hpp"
+#include "hive/modelsLibrary/entityModelCacheIndex.hpp"
+#include "hive/modelsLibrary/pollingScheduler.hpp"
+
+#include <la/avdecc/avdecc.hpp>
 #include <la/avdecc/logger.hpp>
 
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <set>
+#include <vector>
 #include <thread>
+#include <functional>
+#include <cstdio>
+#include <fstream>
 
 #if __cpp_lib_experimental_atomic_smart_pointers
 #	define HAVE_ATOMIC_SMART_POINTERS
@@ -40,6 +64,34 @@ public:
 	using SharedController = std::shared_ptr<la::avdecc::controller::Controller>;
 	using SharedConstController = std::shared_ptr<la::avdecc::controller::Controller const>;
 
+	struct CoalescedNotificationKey
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+		CoalescedNotificationKind kind{ CoalescedNotificationKind::EntityCounters };
+
+		bool operator==(CoalescedNotificationKey const& other) const noexcept
+		{
+			return entityID == other.entityID && descriptorIndex == other.descriptorIndex && kind == other.kind;
+		}
+	};
+	struct CoalescedNotificationKeyHash
+	{
+		std::size_t operator()(CoalescedNotificationKey const& key) const noexcept
+		{
+			return la::avdecc::UniqueIdentifier::hash()(key.entityID) ^ (std::hash<la::avdecc::entity::model::DescriptorIndex>()(key.descriptorIndex) << 8) ^ static_cast<std::size_t>(la::avdecc::utils::to_integral(key.kind));
+		}
+	};
+	// Pending notification, appending its payload to the batch when flushed (always called from the UI thread)
+	using CoalescedNotificationHandler = std::function<void(CoalescedNotifications&, la::avdecc::entity::model::StreamInputCounters const& errorCounters)>;
+	struct CoalescedNotification
+	{
+		CoalescedNotificationHandler handler{};
+		la::avdecc::entity::model::StreamInputCounters errorCounters{}; // Error counters to check for a change, merged from all the coalesced notifications so an error is not hidden by a later notification
+	};
+	using CoalescedNotificationsStore = NotificationCoalescer<CoalescedNotificationKey, CoalescedNotification, CoalescedNotificationKeyHash>;
+	using EntitySnapshotStore = SnapshotStore<la::avdecc::UniqueIdentifier, EntitySnapshot, la::avdecc::UniqueIdentifier::hash>;
+
 	class EntityDataCache
 	{
 		class InitVisitor : public la::avdecc::controller::model::DefaultedEntityModelVisitor
@@ -345,6 +397,21 @@ public:
 		la::avdecc::controller::ControlledEntity::Diagnostics _diagnostics{};
 	};
 
+	struct PendingBulkLoad
+	{
+		std::string filePath{};
+		la::avdecc::entity::model::jsonSerializer::Flags flags{};
+		LoadVirtualEntitiesHandler handler{};
+	};
+
+	// Entities going online while loading a network state, registered all at once when the load completes
+	struct BulkLoad
+	{
+		std::thread::id threadID{}; // Thread loading the network state (entities going online from another thread are not part of the bulk load)
+		std::vector<la::avdecc::UniqueIdentifier> entityIDs{};
+		std::unordered_map<la::avdecc::UniqueIdentifier, EntityDataCache, la::avdecc::UniqueIdentifier::hash> dataCaches{};
+	};
+
 	ControllerManagerImpl() noexcept
 	{
 		qRegisterMetaType<std::uint8_t>("std::uint8_t");
@@ -356,8 +423,10 @@ public:
 		qRegisterMetaType<AcmpCommandType>("hive::modelsLibrary::ControllerManager::AcmpCommandType");
 		qRegisterMetaType<StreamInputErrorCounters>("hive::modelsLibrary::ControllerManager::StreamInputErrorCounters");
 		qRegisterMetaType<StatisticsErrorCounters>("hive::modelsLibrary::ControllerManager::StatisticsErrorCounters");
+		qRegisterMetaType<CoalescedNotifications>("hive::modelsLibrary::ControllerManager::CoalescedNotifications");
 		qRegisterMetaType<la::avdecc::UniqueIdentifier>("la::avdecc::UniqueIdentifier");
 		qRegisterMetaType<std::optional<la::avdecc::UniqueIdentifier>>("std::optional<la::avdecc::UniqueIdentifier>");
+		qRegisterMetaType<std::vector<la::avdecc::UniqueIdentifier>>("std::vector<la::avdecc::UniqueIdentifier>");
 		qRegisterMetaType<la::avdecc::entity::ControllerEntity::AemCommandStatus>("la::avdecc::entity::ControllerEntity::AemCommandStatus");
 		qRegisterMetaType<la::avdecc::entity::ControllerEntity::ControlStatus>("la::avdecc::entity::ControllerEntity::ControlStatus");
 		qRegisterMetaType<la::avdecc::entity::StreamInputCounterValidFlags>("la::avdecc::entity::StreamInputCounterValidFlags");
@@ -420,6 +489,39 @@ public:
 		qRegisterMetaType<la::avdecc::controller::model::MediaClockChain>("la::avdecc::controller::model::MediaClockChain");
 		qRegisterMetaType<la::avdecc::controller::model::ClusterIdentification>("la::avdecc::controller::model::ClusterIdentification");
 		qRegisterMetaType<la::avdecc::controller::model::ChannelIdentification>("la::avdecc::controller::model::ChannelIdentification");
+
+		_coalescingTimer.setSingleShot(true);
+		connect(&_coalescingTimer, &QTimer::timeout, this,
+			[this]()
+			{
+				flushCoalescedNotifications();
+			});
+
+		// Counters polling
+		_countersPollingTimer.setSingleShot(true);
+		connect(&_countersPollingTimer, &QTimer::timeout, this,
+			[this]()
+			{
+				pollCounters();
+			});
+		connect(this, &ControllerManager::streamInputErrorCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorIndex const /*descriptorIndex*/, StreamInputErrorCounters const& errorCounters)
+			{
+				if (!errorCounters.empty())
+				{
+					_countersPolling.notifyErrors(entityID, getCountersPollingTime());
+					scheduleCountersPolling();
+				}
+			});
+		connect(this, &ControllerManager::aecpTimeoutCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				// Counter changes are only notified when it increases (or is reset to 0 when the entity is enumerated again)
+				if (value != 0u)
+				{
+					notifyCountersPollingTimeout(entityID);
+				}
+			});
 	}
 
 	~ControllerManagerImpl() noexcept
@@ -433,6 +535,23 @@ public:
 			}
 		}
 
+		// Wait for a pending bulk load to complete
+		if (_bulkLoadThread.joinable())
+		{
+			_bulkLoadThread.join();
+		}
+
+		// Wait for the pending entity model cache tasks to complete
+		{
+			auto const lg = std::lock_guard{ _entityModelCacheLock };
+			_entityModelCacheShouldTerminate = true;
+		}
+		_entityModelCacheCondition.notify_all();
+		if (_entityModelCacheThread.joinable())
+		{
+			_entityModelCacheThread.join();
+		}
+
 		// The controller should already have been destroyed by now, but just in case, clean it we don't want further notifications
 		if (!AVDECC_ASSERT_WITH_RET(!_controller, "Controller should have been destroyed before the singleton destructor is called"))
 		{
@@ -461,8 +580,24 @@ private:
 		auto const entityID = entity->getEntity().getEntityID();
 		auto tracker = EntityDataCache{ entityID };
 
+		// Publish the snapshot right away (and not in the main thread) so it is available before any change notification for this entity
+		_entitySnapshots.publish(entityID, entity, buildEntitySnapshot(*entity));
+
+		// Entities loaded by a bulk load are registered all at once when the load completes
+		if (addToBulkLoad(entityID, tracker))
+		{
+			return;
+		}
+
+		// Only real AEM entities are considered for the persistent entity model cache
+		auto const& e = entity->getEntity();
+		auto const entityModelID = (!entity->isVirtual() && e.getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported)) ? e.getEntityModelID() : la::avdecc::UniqueIdentifier{};
+
+		// Real AEM entities not notifying their changes have to be polled
+		auto const needsCountersPolling = entityModelID.isValid() && !entity->areUnsolicitedNotificationsSupported();
+
 		QMetaObject::invokeMethod(this,
-			[this, entityID, tracker = std::move(tracker), enumerationTime = entity->getEnumerationTime()]()
+			[this, entityID, tracker = std::move(tracker), enumerationTime = entity->getEnumerationTime(), entityModelID, isUsingCachedEntityModel = entity->isUsingCachedEntityModel(), needsCountersPolling]()
 			{
 				{
 					auto const lg = std::lock_guard{ _lock };
@@ -470,11 +605,31 @@ private:
 					_entityDataCache[entityID] = std::move(tracker);
 				}
 
+				if (_isPersistentEntityModelCacheActive && entityModelID.isValid())
+				{
+					runInEntityModelCacheThread(
+						[this, entityID, entityModelID, isUsingCachedEntityModel]()
+						{
+							updatePersistentEntityModelCache(entityID, entityModelID, isUsingCachedEntityModel);
+						});
+				}
+
+				if (needsCountersPolling)
+				{
+					addCountersPolling(entityID);
+				}
+
 				emit entityOnline(entityID, enumerationTime);
 			});
 	}
 	virtual void onEntityOffline(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
+		// Remove the snapshot right away, only if it was published by this instance of the entity (not by a new one going Online at the same time)
+		_entitySnapshots.remove(entity->getEntity().getEntityID(), entity);
+
+		// Do not register the entity when the bulk load completes, if it is part of it
+		removeFromBulkLoad(entity->getEntity().getEntityID());
+
 		// Invoke all the code manipulating class members to the main thread, as onEntityOnline and onEntityOffline can happen at the same time from different threads (as of current avdecc_controller library)
 		// We don't want a class member to be reset by onEntityOffline while the entity is going Online again at the same time, so invoke in a queued manner in the same (main) thread
 		QMetaObject::invokeMethod(this,
@@ -486,6 +641,15 @@ private:
 					_entityDataCache.erase(entityID);
 				}
 
+				// Pending notifications for this entity are no longer relevant
+				_coalescedNotifications.discard(
+					[entityID](auto const& key)
+					{
+						return key.entityID == entityID;
+					});
+
+				_countersPolling.removeEntity(entityID);
+
 				emit entityOffline(entityID);
 			});
 	}
@@ -535,10 +699,12 @@ private:
 	// Connection notifications (sniffed ACMP)
 	virtual void onStreamInputConnectionChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputConnectionInfo const& info, bool const /*changedByOther*/) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamInputConnectionChanged({ entity->getEntity().getEntityID(), streamIndex }, info);
 	}
 	virtual void onStreamOutputConnectionsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamConnections const& connections) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamOutputConnectionsChanged({ entity->getEntity().getEntityID(), streamIndex }, connections);
 	}
 	virtual void onChannelInputConnectionChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::ClusterIdentification const& clusterIdentification, la::avdecc::controller::model::ChannelIdentification const& channeIdentification) noexcept override
@@ -556,10 +722,12 @@ private:
 	}
 	virtual void onStreamInputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, streamFormat);
 	}
 	virtual void onStreamOutputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, streamFormat);
 	}
 	virtual void onStreamInputDynamicInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info) noexcept override
@@ -572,10 +740,20 @@ private:
 	}
 	virtual void onEntityNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityName) noexcept override
 	{
+		_entitySnapshots.update(entity->getEntity().getEntityID(), entity,
+			[&entityName](auto& snapshot)
+			{
+				snapshot.entityName = entityName;
+			});
 		emit entityNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityName));
 	}
 	virtual void onEntityGroupNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityGroupName) noexcept override
 	{
+		_entitySnapshots.update(entity->getEntity().getEntityID(), entity,
+			[&entityGroupName](auto& snapshot)
+			{
+				snapshot.groupName = entityGroupName;
+			});
 		emit entityGroupNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityGroupName));
 	}
 	virtual void onConfigurationNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvdeccFixedString const& configurationName) noexcept override
@@ -588,10 +766,12 @@ private:
 	}
 	virtual void onStreamInputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, QString::fromStdString(streamName));
 	}
 	virtual void onStreamOutputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
 	{
+		updateStreamsSnapshot(*entity);
 		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, QString::fromStdString(streamName));
 	}
 	virtual void onJackInputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::JackIndex const jackIndex, la::avdecc::entity::model::AvdeccFixedString const& jackName) noexcept override
@@ -608,6 +788,7 @@ private:
 	}
 	virtual void onClockSourceNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, la::avdecc::entity::model::AvdeccFixedString const& clockSourceName) noexcept override
 	{
+		updateClocksSnapshot(*entity);
 		emit clockSourceNameChanged(entity->getEntity().getEntityID(), configurationIndex, clockSourceIndex, QString::fromStdString(clockSourceName));
 	}
 	virtual void onMemoryObjectNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::entity::model::AvdeccFixedString const& memoryObjectName) noexcept override
@@ -624,6 +805,7 @@ private:
 	}
 	virtual void onClockDomainNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::AvdeccFixedString const& clockDomainName) noexcept override
 	{
+		updateClocksSnapshot(*entity);
 		emit clockDomainNameChanged(entity->getEntity().getEntityID(), configurationIndex, clockDomainIndex, QString::fromStdString(clockDomainName));
 	}
 	virtual void onTimingNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::TimingIndex const timingIndex, la::avdecc::entity::model::AvdeccFixedString const& timingName) noexcept override
@@ -644,10 +826,12 @@ private:
 	}
 	virtual void onAudioUnitSamplingRateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate) noexcept override
 	{
+		updateClocksSnapshot(*entity);
 		emit audioUnitSamplingRateChanged(entity->getEntity().getEntityID(), audioUnitIndex, samplingRate);
 	}
 	virtual void onClockSourceChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept override
 	{
+		updateClocksSnapshot(*entity);
 		emit clockSourceChanged(entity->getEntity().getEntityID(), clockDomainIndex, clockSourceIndex);
 	}
 	virtual void onControlValuesChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ControlIndex const controlIndex, la::avdecc::entity::model::ControlValues const& controlValues) noexcept override
@@ -684,15 +868,30 @@ private:
 	}
 	virtual void onEntityCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::EntityCounters const& counters) noexcept override
 	{
-		emit entityCountersChanged(entity->getEntity().getEntityID(), counters);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, la::avdecc::entity::model::DescriptorIndex{ 0u }, CoalescedNotificationKind::EntityCounters },
+			[entityID, counters](CoalescedNotifications& notifications)
+			{
+				notifications.entityCounters.emplace_back(entityID, counters);
+			});
 	}
 	virtual void onAvbInterfaceCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters) noexcept override
 	{
-		emit avbInterfaceCountersChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, counters);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, avbInterfaceIndex, CoalescedNotificationKind::AvbInterfaceCounters },
+			[entityID, avbInterfaceIndex, counters](CoalescedNotifications& notifications)
+			{
+				notifications.avbInterfaceCounters.emplace_back(entityID, avbInterfaceIndex, counters);
+			});
 	}
 	virtual void onClockDomainCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters) noexcept override
 	{
-		emit clockDomainCountersChanged(entity->getEntity().getEntityID(), clockDomainIndex, counters);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, clockDomainIndex, CoalescedNotificationKind::ClockDomainCounters },
+			[entityID, clockDomainIndex, counters](CoalescedNotifications& notifications)
+			{
+				notifications.clockDomainCounters.emplace_back(entityID, clockDomainIndex, counters);
+			});
 	}
 	virtual void onStreamInputCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters) noexcept override
 	{
@@ -744,32 +943,44 @@ private:
 			}
 		}
 
-		QMetaObject::invokeMethod(this,
-			[this, entityID = entity->getEntity().getEntityID(), streamIndex, counters, checkForChange = std::move(checkForChange)]()
-			{
-				if (auto* entityCache = entityCachedData(entityID))
+		// Counters are always growing (or reset), so only processing the latest value of each error counter is enough to detect a change
+		pushCoalescedNotification({ entityID, streamIndex, CoalescedNotificationKind::StreamInputCounters },
+			CoalescedNotification{ [this, entityID, streamIndex, counters](CoalescedNotifications& notifications, la::avdecc::entity::model::StreamInputCounters const& errorCounters)
 				{
-					auto changed = false;
-					for (auto const [flag, counter] : checkForChange)
-					{
-						changed |= entityCache->setStreamInputCounter(streamIndex, flag, counter);
-					}
-					if (changed)
+					if (auto* entityCache = entityCachedData(entityID))
 					{
-						emit streamInputErrorCounterChanged(entityID, streamIndex, entityCache->getStreamInputErrorCounters(streamIndex));
+						auto changed = false;
+						for (auto const [flag, counter] : errorCounters)
+						{
+							changed |= entityCache->setStreamInputCounter(streamIndex, flag, counter);
+						}
+						if (changed)
+						{
+							emit streamInputErrorCounterChanged(entityID, streamIndex, entityCache->getStreamInputErrorCounters(streamIndex));
+						}
 					}
-				}
 
-				emit streamInputCountersChanged(entityID, streamIndex, counters);
-			});
+					notifications.streamInputCounters.emplace_back(entityID, streamIndex, counters);
+				},
+				std::move(checkForChange) });
 	}
 	virtual void onStreamOutputCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters) noexcept override
 	{
-		emit streamOutputCountersChanged(entity->getEntity().getEntityID(), streamIndex, counters);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, streamIndex, CoalescedNotificationKind::StreamOutputCounters },
+			[entityID, streamIndex, counters](CoalescedNotifications& notifications)
+			{
+				notifications.streamOutputCounters.emplace_back(entityID, streamIndex, counters);
+			});
 	}
 	virtual void onStreamOutputSignalPresenceChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::SignalPresenceChannels const& signalPresence) noexcept override
 	{
-		emit streamOutputSignalPresenceChanged(entity->getEntity().getEntityID(), streamIndex, signalPresence);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, streamIndex, CoalescedNotificationKind::StreamOutputSignalPresence },
+			[entityID, streamIndex, signalPresence](CoalescedNotifications& notifications)
+			{
+				notifications.streamOutputSignalPresence.emplace_back(entityID, streamIndex, signalPresence);
+			});
 	}
 	virtual void onMemoryObjectLengthChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length) noexcept override
 	{
@@ -777,10 +988,12 @@ private:
 	}
 	virtual void onStreamPortInputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
 	{
+		updateStreamPortsSnapshot(*entity);
 		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamPortInput, streamPortIndex);
 	}
 	virtual void onStreamPortOutputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
 	{
+		updateStreamPortsSnapshot(*entity);
 		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamPortOutput, streamPortIndex);
 	}
 	virtual void onOperationProgress(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, float const percentComplete) noexcept override
@@ -865,11 +1078,21 @@ private:
 	}
 	virtual void onAecpResponseAverageTimeChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::chrono::milliseconds const& value) noexcept override
 	{
-		emit aecpResponseAverageTimeChanged(entity->getEntity().getEntityID(), value);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, la::avdecc::entity::model::DescriptorIndex{ 0u }, CoalescedNotificationKind::AecpResponseAverageTime },
+			[entityID, value](CoalescedNotifications& notifications)
+			{
+				notifications.aecpResponseAverageTime.emplace_back(entityID, value);
+			});
 	}
 	virtual void onAemAecpUnsolicitedCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
 	{
-		emit aemAecpUnsolicitedCounterChanged(entity->getEntity().getEntityID(), value);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, la::avdecc::entity::model::DescriptorIndex{ 0u }, CoalescedNotificationKind::AemAecpUnsolicitedCounter },
+			[entityID, value](CoalescedNotifications& notifications)
+			{
+				notifications.aemAecpUnsolicitedCounter.emplace_back(entityID, value);
+			});
 	}
 	virtual void onAemAecpUnsolicitedLossCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
 	{
@@ -891,7 +1114,12 @@ private:
 	}
 	virtual void onMvuAecpUnsolicitedCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
 	{
-		emit mvuAecpUnsolicitedCounterChanged(entity->getEntity().getEntityID(), value);
+		auto const entityID = entity->getEntity().getEntityID();
+		pushCoalescedNotification({ entityID, la::avdecc::entity::model::DescriptorIndex{ 0u }, CoalescedNotificationKind::MvuAecpUnsolicitedCounter },
+			[entityID, value](CoalescedNotifications& notifications)
+			{
+				notifications.mvuAecpUnsolicitedCounter.emplace_back(entityID, value);
+			});
 	}
 	virtual void onMvuAecpUnsolicitedLossCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
 	{
@@ -998,6 +1226,22 @@ private:
 		// Create a new controller and store it
 		SharedController controller = la::avdecc::controller::Controller::create(protocolInterfaceType, interfaceName.toStdString(), progID, entityModelID, preferedLocale.toStdString(), entityModel, std::nullopt, &_virtualController);
 
+		// Create the controller entity used to poll counters (the controller does not expose GET_COUNTERS commands), there is nothing to poll on a virtual network
+		if (protocolInterfaceType != la::avdecc::protocol::ProtocolInterface::Type::Virtual)
+		{
+			try
+			{
+				auto endStation = la::avdecc::EndStation::create(protocolInterfaceType, interfaceName.toStdString(), std::nullopt);
+				_countersPollingEntity = endStation->addControllerEntity(static_cast<std::uint16_t>(progID + CountersPollingProgIDOffset), la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), nullptr, nullptr);
+				_countersPollingEndStation = std::move(endStation);
+			}
+			catch (la::avdecc::EndStation::Exception const&)
+			{
+				// Counters of entities not supporting unsolicited notifications won't be polled
+				_countersPollingEntity = nullptr;
+			}
+		}
+
 #if HAVE_ATOMIC_SMART_POINTERS
 		_controller = std::move(controller);
 #else // !HAVE_ATOMIC_SMART_POINTERS
@@ -1008,20 +1252,33 @@ private:
 		auto ctrl = getController();
 		if (ctrl)
 		{
-			emit controllerOnline();
-			ctrl->registerObserver(this);
-
-			ctrl->setAutomaticDiscoveryDelay(_discoveryDelay);
-
+			_isPersistentEntityModelCacheActive = _enableAemCache;
 			if (_enableAemCache)
 			{
 				ctrl->enableEntityModelCache();
+
+				// Wait for the persisted entity models to be loaded before going online, so no entity is reported online (and counted as a miss, then persisted again) before its entity model is in the cache.
+				// Loaded from the entity model cache thread, after the tasks still pending for a previous controller
+				auto loadPromise = std::promise<void>{};
+				auto loadFuture = loadPromise.get_future();
+				runInEntityModelCacheThread(
+					[this, controller = ctrl, &loadPromise]()
+					{
+						loadPersistentEntityModelCache(*controller);
+						loadPromise.set_value();
+					});
+				loadFuture.wait();
 			}
 			else
 			{
 				ctrl->disableEntityModelCache();
 			}
 
+			emit controllerOnline();
+			ctrl->registerObserver(this);
+
+			ctrl->setAutomaticDiscoveryDelay(_discoveryDelay);
+
 			if (_enableFastEnumeration)
 			{
 				ctrl->enableFastEnumeration();
@@ -1062,6 +1319,17 @@ private:
 				_entities.clear();
 				_entityDataCache.clear();
 			}
+			_entitySnapshots.clear();
+
+			// Drop pending notifications
+			_coalescingTimer.stop();
+			_coalescedNotifications.clear();
+
+			// Stop polling
+			_countersPollingTimer.stop();
+			_countersPolling.clear();
+			_countersPollingEntity = nullptr;
+			_countersPollingEndStation.reset();
 
 			// Notify
 			emit controllerOffline();
@@ -1088,6 +1356,11 @@ private:
 		return {};
 	}
 
+	virtual SharedEntitySnapshot getEntitySnapshot(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		return _entitySnapshots.get(entityID);
+	}
+
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
 	{
 		auto controller = getController();
@@ -1098,6 +1371,118 @@ private:
 		return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
 	}
 
+	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJsonStreamed(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource, SerializationProgressHandler const& progressHandler) const noexcept override
+	{
+		auto controller = getController();
+		if (!controller)
+		{
+			return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
+		}
+
+		// Get the online entities
+		auto entityIDs = std::vector<la::avdecc::UniqueIdentifier>{};
+		{
+			auto const lg = std::lock_guard{ _lock };
+			entityIDs.assign(_entities.begin(), _entities.end());
+		}
+
+		// Each entity is first serialized by the controller to its own (text) file in a temporary folder
+		auto const tempDir = QTemporaryDir{};
+		if (!tempDir.isValid())
+		{
+			return { la::avdecc::jsonSerializer::SerializationError::AccessDenied, "Cannot create temporary folder: " + tempDir.errorString().toStdString() };
+		}
+		auto const binary = flags.test(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
+		auto entityFlags = flags;
+		entityFlags.reset(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
+		auto const dumpSourceString = dumpSource.toStdString();
+
+		auto writer = NetworkStateJsonWriter{ filePath.toStdString(), binary, dumpSourceString };
+		if (!writer.isGood())
+		{
+			return { la::avdecc::jsonSerializer::SerializationError::AccessDenied, "Cannot open file for writing: " + filePath.toStdString() };
+		}
+
+		// Serialize entities on worker threads, then write them in order from this thread
+		auto processor = OrderedParallelProcessor<std::optional<std::string>>{};
+		auto missingEntities = std::vector<la::avdecc::UniqueIdentifier>{};
+		auto writeFailed = false;
+		auto const completed = processor.run(
+			entityIDs.size(),
+			[&controller, &entityIDs, &tempDir, entityFlags, &dumpSourceString, binary](std::size_t const index) -> std::optional<std::string>
+			{
+				auto const entityFilePath = tempDir.filePath(QString::number(index)).toStdString();
+				auto const [error, message] = controller->serializeControlledEntityAsJson(entityIDs[index], entityFilePath, entityFlags, dumpSourceString);
+				if (error != la::avdecc::jsonSerializer::SerializationError::NoError)
+				{
+					return std::nullopt;
+				}
+				try
+				{
+					auto object = NetworkStateJsonWriter::json{};
+					{
+						auto input = std::ifstream{ entityFilePath, std::ios::binary | std::ios::in };
+						input >> object;
+					}
+					std::remove(entityFilePath.c_str());
+					// Entities are not individually tagged with the dump source in a network state
+					object.erase(NetworkStateJsonWriter::DumpSourceKey);
+					return NetworkStateJsonWriter::serializeEntity(object, binary);
+				}
+				catch (...)
+				{
+					return std::nullopt;
+				}
+			},
+			[&writer, &entityIDs, &missingEntities, &writeFailed](std::size_t const index, std::optional<std::string>&& serializedEntity)
+			{
+				if (!serializedEntity)
+				{
+					missingEntities.push_back(entityIDs[index]);
+					return;
+				}
+				writeFailed |= !writer.writeEntity(*serializedEntity);
+			},
+			[&progressHandler, &writeFailed](std::size_t const consumedCount, std::size_t const totalCount)
+			{
+				if (writeFailed)
+				{
+					return false;
+				}
+				return !progressHandler || progressHandler(consumedCount, totalCount);
+			});
+
+		if (writeFailed)
+		{
+			writer.abort();
+			return { la::avdecc::jsonSerializer::SerializationError::FileWriteError, "Failed to write to file: " + filePath.toStdString() };
+		}
+		if (!completed)
+		{
+			writer.abort();
+			return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Serialization cancelled" };
+		}
+		if (!writer.finish())
+		{
+			return { la::avdecc::jsonSerializer::SerializationError::FileWriteError, "Failed to write to file: " + filePath.toStdString() };
+		}
+
+		if (!missingEntities.empty())
+		{
+			auto message = std::string{};
+			for (auto const entityID : missingEntities)
+			{
+				if (!message.empty())
+				{
+					message += "\n";
+				}
+				message += helper::uniqueIdentifierToString(entityID).toStdString();
+			}
+			return { la::avdecc::jsonSerializer::SerializationError::Incomplete, message };
+		}
+		return { la::avdecc::jsonSerializer::SerializationError::NoError, "" };
+	}
+
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeControlledEntityAsJson(la::avdecc::UniqueIdentifier const entityID, QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
 	{
 		auto controller = getController();
@@ -1118,6 +1503,16 @@ private:
 		return { la::avdecc::jsonSerializer::DeserializationError::InternalError, "Controller offline" };
 	}
 
+	virtual void loadVirtualEntitiesFromJsonNetworkStateAsync(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, LoadVirtualEntitiesHandler const& handler) noexcept override
+	{
+		// Network states are loaded one after the other
+		_pendingBulkLoads.push_back(PendingBulkLoad{ filePath.toStdString(), flags, handler });
+		if (!_isBulkLoading)
+		{
+			startNextBulkLoad();
+		}
+	}
+
 	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntityFromJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept override
 	{
 		auto controller = getController();
@@ -1173,6 +1568,38 @@ private:
 		return _enableAemCache;
 	}
 
+	virtual EntityModelCacheStatistics getEntityModelCacheStatistics() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _entityModelCacheLock };
+		return _entityModelCacheStatistics;
+	}
+
+	virtual void setCountersPollingFocus(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		if (entityID == _countersPollingFocus)
+		{
+			return;
+		}
+
+		auto const now = getCountersPollingTime();
+		if (_countersPollingFocus.isValid())
+		{
+			_countersPolling.setSelected(_countersPollingFocus, false, now);
+		}
+		_countersPollingFocus = entityID;
+		if (_countersPollingFocus.isValid())
+		{
+			_countersPolling.setSelected(_countersPollingFocus, true, now);
+		}
+		scheduleCountersPolling();
+	}
+
+	virtual CountersPollingStatistics getCountersPollingStatistics() const noexcept override
+	{
+		auto const& stats = _countersPolling.getStatistics();
+		return CountersPollingStatistics{ _countersPolling.getEntitiesCount(), stats.pollsCount, stats.deferredCount, stats.timeoutsCount };
+	}
+
 	virtual void setEnableFastEnumeration(bool const enable) noexcept override
 	{
 		_enableFastEnumeration = enable;
@@ -1214,6 +1641,112 @@ private:
 		}
 	}
 
+	virtual void setNotificationsCoalescingInterval(std::chrono::milliseconds const interval) noexcept override
+	{
+		_coalescingInterval = interval;
+	}
+
+	virtual std::chrono::milliseconds getNotificationsCoalescingInterval() const noexcept override
+	{
+		return _coalescingInterval;
+	}
+
+	virtual NotificationsCoalescingStatistics getNotificationsCoalescingStatistics() const noexcept override
+	{
+		auto const stats = _coalescedNotifications.getStatistics();
+		return NotificationsCoalescingStatistics{ stats.pushedCount, stats.drainedCount, stats.drainCount, stats.maxPendingCount, stats.maxLatency, stats.lastLatency };
+	}
+
+	// Stores a notification until the next flush, replacing any pending one with the same key. Can be called from any thread.
+	void pushCoalescedNotification(CoalescedNotificationKey const& key, std::function<void(CoalescedNotifications&)>&& handler) noexcept
+	{
+		pushCoalescedNotification(key, CoalescedNotification{ [handler = std::move(handler)](CoalescedNotifications& notifications, la::avdecc::entity::model::StreamInputCounters const& /*errorCounters*/)
+			{
+				handler(notifications);
+			} });
+	}
+
+	// Stores a notification until the next flush, replacing the handler of any pending one with the same key but keeping its error counters that are not part of the new notification. Can be called from any thread.
+	void pushCoalescedNotification(CoalescedNotificationKey const& key, CoalescedNotification&& notification) noexcept
+	{
+		auto const mergeNotification = [](CoalescedNotification& pendingNotification, CoalescedNotification&& notification)
+		{
+			pendingNotification.handler = std::move(notification.handler);
+			for (auto const [flag, counter] : notification.errorCounters)
+			{
+				pendingNotification.errorCounters[flag] = counter;
+			}
+		};
+		if (_coalescedNotifications.push(key, std::move(notification), mergeNotification))
+		{
+			// First pending notification since last flush, schedule a flush from the UI thread
+			QMetaObject::invokeMethod(this,
+				[this]()
+				{
+					if (!_coalescingTimer.isActive())
+					{
+						_coalescingTimer.start(_coalescingInterval);
+					}
+				});
+		}
+	}
+
+	void flushCoalescedNotifications() noexcept
+	{
+		auto const entries = _coalescedNotifications.drain();
+		if (entries.empty())
+		{
+			return;
+		}
+
+		auto notifications = CoalescedNotifications{};
+		for (auto const& entry : entries)
+		{
+			la::avdecc::utils::invokeProtectedHandler(entry.value.handler, notifications, entry.value.errorCounters);
+		}
+
+		// First emit individual signals, for listeners only interested in a specific entity/descriptor
+		for (auto const& [entityID, counters] : notifications.entityCounters)
+		{
+			emit entityCountersChanged(entityID, counters);
+		}
+		for (auto const& [entityID, avbInterfaceIndex, counters] : notifications.avbInterfaceCounters)
+		{
+			emit avbInterfaceCountersChanged(entityID, avbInterfaceIndex, counters);
+		}
+		for (auto const& [entityID, clockDomainIndex, counters] : notifications.clockDomainCounters)
+		{
+			emit clockDomainCountersChanged(entityID, clockDomainIndex, counters);
+		}
+		for (auto const& [entityID, streamIndex, counters] : notifications.streamInputCounters)
+		{
+			emit streamInputCountersChanged(entityID, streamIndex, counters);
+		}
+		for (auto const& [entityID, streamIndex, counters] : notifications.streamOutputCounters)
+		{
+			emit streamOutputCountersChanged(entityID, streamIndex, counters);
+		}
+		for (auto const& [entityID, streamIndex, signalPresence] : notifications.streamOutputSignalPresence)
+		{
+			emit streamOutputSignalPresenceChanged(entityID, streamIndex, signalPresence);
+		}
+		for (auto const& [entityID, value] : notifications.aecpResponseAverageTime)
+		{
+			emit aecpResponseAverageTimeChanged(entityID, value);
+		}
+		for (auto const& [entityID, value] : notifications.aemAecpUnsolicitedCounter)
+		{
+			emit aemAecpUnsolicitedCounterChanged(entityID, value);
+		}
+		for (auto const& [entityID, value] : notifications.mvuAecpUnsolicitedCounter)
+		{
+			emit mvuAecpUnsolicitedCounterChanged(entityID, value);
+		}
+
+		// Then the whole batch, for models wanting to process all changes at once
+		emit coalescedNotificationsFlushed(notifications);
+	}
+
 	EntityDataCache const* entityCachedData(la::avdecc::UniqueIdentifier const entityID) const noexcept
 	{
 		auto const lg = std::lock_guard{ _lock };
@@ -2774,6 +3307,709 @@ private:
 	}
 
 	// Private methods
+	// Entity snapshots builders, called from the avdecc thread (in an Observer notification, the ControlledEntity being locked)
+	static std::shared_ptr<EntitySnapshot::Streams const> buildStreamsSnapshot(la::avdecc::controller::model::ConfigurationNode const& configNode) noexcept
+	{
+		auto streams = std::make_shared<EntitySnapshot::Streams>();
+		for (auto const& [streamIndex, streamNode] : configNode.streamInputs)
+		{
+			streams->inputs[streamIndex] = EntitySnapshot::StreamInput{ streamNode.dynamicModel.objectName, streamNode.dynamicModel.streamFormat, streamNode.dynamicModel.connectionInfo };
+		}
+		for (auto const& [streamIndex, streamNode] : configNode.streamOutputs)
+		{
+			streams->outputs[streamIndex] = EntitySnapshot::StreamOutput{ streamNode.dynamicModel.objectName, streamNode.dynamicModel.streamFormat, streamNode.dynamicModel.connections };
+		}
+		return streams;
+	}
+
+	template<typename StreamPortNodes>
+	static void buildStreamPortsSnapshot(la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, StreamPortNodes const& streamPortNodes, std::map<la::avdecc::entity::model::StreamPortIndex, EntitySnapshot::StreamPort>& streamPorts) noexcept
+	{
+		for (auto const& [streamPortIndex, streamPortNode] : streamPortNodes)
+		{
+			auto& streamPort = streamPorts[streamPortIndex];
+			streamPort.audioUnitIndex = audioUnitIndex;
+			streamPort.baseCluster = streamPortNode.staticModel.baseCluster;
+			for (auto const& [clusterIndex, clusterNode] : streamPortNode.audioClusters)
+			{
+				streamPort.clusterChannelCounts[clusterIndex] = clusterNode.staticModel.channelCount;
+			}
+			streamPort.mappings = streamPortNode.dynamicModel.dynamicAudioMap;
+		}
+	}
+
+	static std::shared_ptr<EntitySnapshot::StreamPorts const> buildStreamPortsSnapshot(la::avdecc::controller::model::ConfigurationNode const& configNode) noexcept
+	{
+		auto streamPorts = std::make_shared<EntitySnapshot::StreamPorts>();
+		for (auto const& [audioUnitIndex, audioUnitNode] : configNode.audioUnits)
+		{
+			buildStreamPortsSnapshot(audioUnitIndex, audioUnitNode.streamPortInputs, streamPorts->inputs);
+			buildStreamPortsSnapshot(audioUnitIndex, audioUnitNode.streamPortOutputs, streamPorts->outputs);
+		}
+		return streamPorts;
+	}
+
+	static std::shared_ptr<EntitySnapshot::Clocks const> buildClocksSnapshot(la::avdecc::controller::model::ConfigurationNode const& configNode) noexcept
+	{
+		auto clocks = std::make_shared<EntitySnapshot::Clocks>();
+		for (auto const& [clockDomainIndex, clockDomainNode] : configNode.clockDomains)
+		{
+			clocks->clockDomains[clockDomainIndex] = EntitySnapshot::ClockDomain{ clockDomainNode.dynamicModel.objectName, clockDomainNode.dynamicModel.clockSourceIndex };
+		}
+		for (auto const& [clockSourceIndex, clockSourceNode] : configNode.clockSources)
+		{
+			clocks->clockSources[clockSourceIndex] = EntitySnapshot::ClockSource{ clockSourceNode.dynamicModel.objectName, clockSourceNode.staticModel.clockSourceType, clockSourceNode.staticModel.clockSourceLocationType, clockSourceNode.staticModel.clockSourceLocationIndex };
+		}
+		for (auto const& [audioUnitIndex, audioUnitNode] : configNode.audioUnits)
+		{
+			clocks->samplingRates[audioUnitIndex] = audioUnitNode.dynamicModel.currentSamplingRate;
+		}
+		return clocks;
+	}
+
+	static EntitySnapshot buildEntitySnapshot(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		auto snapshot = EntitySnapshot{};
+		auto const& entity = controlledEntity.getEntity();
+		snapshot.entityID = entity.getEntityID();
+		snapshot.isAemSupported = entity.getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported);
+
+		if (snapshot.isAemSupported && controlledEntity.hasAnyConfiguration())
+		{
+			try
+			{
+				auto const& entityNode = controlledEntity.getEntityNode();
+				snapshot.entityName = entityNode.dynamicModel.entityName;
+				snapshot.groupName = entityNode.dynamicModel.groupName;
+
+				auto const& configNode = controlledEntity.getCurrentConfigurationNode();
+				snapshot.currentConfiguration = configNode.descriptorIndex;
+				snapshot.streams = buildStreamsSnapshot(configNode);
+				snapshot.streamPorts = buildStreamPortsSnapshot(configNode);
+				snapshot.clocks = buildClocksSnapshot(configNode);
+				snapshot.hasConfiguration = true;
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+				// Ignore exception, keep an empty snapshot
+			}
+		}
+
+		return snapshot;
+	}
+
+	// Rebuilds a part of the snapshot of an entity from its current configuration, sharing the other parts with the previous snapshot
+	template<typename Builder>
+	void updateEntitySnapshot(la::avdecc::controller::ControlledEntity const& controlledEntity, Builder&& builder) noexcept
+	{
+		_entitySnapshots.update(controlledEntity.getEntity().getEntityID(), &controlledEntity,
+			[&controlledEntity, &builder](auto& snapshot)
+			{
+				if (snapshot.hasConfiguration)
+				{
+					try
+					{
+						builder(snapshot, controlledEntity.getCurrentConfigurationNode());
+					}
+					catch (la::avdecc::controller::ControlledEntity::Exception const&)
+					{
+						// Ignore exception, keep the previous values
+					}
+				}
+			});
+	}
+
+	void updateStreamsSnapshot(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		updateEntitySnapshot(controlledEntity,
+			[](auto& snapshot, auto const& configNode)
+			{
+				snapshot.streams = buildStreamsSnapshot(configNode);
+			});
+	}
+
+	void updateStreamPortsSnapshot(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		updateEntitySnapshot(controlledEntity,
+			[](auto& snapshot, auto const& configNode)
+			{
+				snapshot.streamPorts = buildStreamPortsSnapshot(configNode);
+			});
+	}
+
+	void updateClocksSnapshot(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		updateEntitySnapshot(controlledEntity,
+			[](auto& snapshot, auto const& configNode)
+			{
+				snapshot.clocks = buildClocksSnapshot(configNode);
+			});
+	}
+
+	// Must be called from the main thread
+	void startNextBulkLoad() noexcept
+	{
+		while (!_pendingBulkLoads.empty())
+		{
+			auto pendingLoad = std::move(_pendingBulkLoads.front());
+			_pendingBulkLoads.pop_front();
+
+			auto controller = getController();
+			if (!controller)
+			{
+				la::avdecc::utils::invokeProtectedHandler(pendingLoad.handler, la::avdecc::jsonSerializer::DeserializationError::InternalError, "Controller offline");
+				continue;
+			}
+
+			// Previous bulk load thread has completed its work
+			if (_bulkLoadThread.joinable())
+			{
+				_bulkLoadThread.join();
+			}
+
+			_isBulkLoading = true;
+			_bulkLoadThread = std::thread{
+				[this, controller = std::move(controller), pendingLoad = std::move(pendingLoad)]()
+				{
+					// Entities loaded from this thread go online from this thread
+					{
+						auto const lg = std::lock_guard{ _bulkLoadLock };
+						_bulkLoad.emplace();
+						_bulkLoad->threadID = std::this_thread::get_id();
+					}
+
+					auto const [error, message] = controller->loadVirtualEntitiesFromJsonNetworkState(pendingLoad.filePath, pendingLoad.flags, true);
+
+					// No more entities are added to the bulk load, but it is kept until it is registered so that entities going offline in the meantime are still removed from it (see onEntityOffline)
+					{
+						auto const lg = std::lock_guard{ _bulkLoadLock };
+						_bulkLoad->threadID = std::thread::id{};
+					}
+
+					// Register all the entities at once, in the main thread (see onEntityOnline)
+					QMetaObject::invokeMethod(this,
+						[this, controller, error = error, message = message, handler = pendingLoad.handler]()
+						{
+							auto bulkLoad = BulkLoad{};
+							{
+								auto const lg = std::lock_guard{ _bulkLoadLock };
+								bulkLoad = std::move(*_bulkLoad);
+								_bulkLoad.reset();
+							}
+
+							// Only if the controller has not been destroyed in the meantime
+							if (getController() == controller && !bulkLoad.entityIDs.empty())
+							{
+								{
+									auto const lg = std::lock_guard{ _lock };
+									for (auto const entityID : bulkLoad.entityIDs)
+									{
+										_entities.insert(entityID);
+										_entityDataCache[entityID] = std::move(bulkLoad.dataCaches[entityID]);
+									}
+								}
+
+								emit entitiesOnline(bulkLoad.entityIDs);
+							}
+
+							la::avdecc::utils::invokeProtectedHandler(handler, error, message);
+
+							_isBulkLoading = false;
+							startNextBulkLoad();
+						});
+				}
+			};
+			return;
+		}
+	}
+
+	// Returns true if the entity is going online from the bulk load thread, in which case it is added to the bulk load
+	bool addToBulkLoad(la::avdecc::UniqueIdentifier const entityID, EntityDataCache& dataCache) noexcept
+	{
+		auto const lg = std::lock_guard{ _bulkLoadLock };
+		if (!_bulkLoad || _bulkLoad->threadID != std::this_thread::get_id())
+		{
+			return false;
+		}
+		_bulkLoad->entityIDs.push_back(entityID);
+		_bulkLoad->dataCaches[entityID] = std::move(dataCache);
+		return true;
+	}
+
+	void removeFromBulkLoad(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto const lg = std::lock_guard{ _bulkLoadLock };
+		if (_bulkLoad)
+		{
+			auto& entityIDs = _bulkLoad->entityIDs;
+			entityIDs.erase(std::remove(entityIDs.begin(), entityIDs.end(), entityID), entityIDs.end());
+			_bulkLoad->dataCaches.erase(entityID);
+		}
+	}
+
+	// Persistent entity model cache (files, index and hashing are only accessed from the entity model cache thread, so they never block the main thread)
+	void runInEntityModelCacheThread(std::function<void()>&& task) noexcept
+	{
+		{
+			auto const lg = std::lock_guard{ _entityModelCacheLock };
+			_entityModelCacheTasks.push_back(std::move(task));
+		}
+		if (!_entityModelCacheThread.joinable())
+		{
+			_entityModelCacheThread = std::thread{
+				[this]()
+				{
+					auto lock = std::unique_lock{ _entityModelCacheLock };
+					while (true)
+					{
+						_entityModelCacheCondition.wait(lock,
+							[this]()
+							{
+								return _entityModelCacheShouldTerminate || !_entityModelCacheTasks.empty();
+							});
+						// Pending tasks are completed before terminating
+						if (_entityModelCacheTasks.empty())
+						{
+							return;
+						}
+						auto const task = std::move(_entityModelCacheTasks.front());
+						_entityModelCacheTasks.pop_front();
+
+						lock.unlock();
+						task();
+						lock.lock();
+					}
+				}
+			};
+		}
+		_entityModelCacheCondition.notify_one();
+	}
+
+	template<typename Updater>
+	void updateEntityModelCacheStatistics(Updater&& updater) noexcept
+	{
+		auto const lg = std::lock_guard{ _entityModelCacheLock };
+		updater(_entityModelCacheStatistics);
+	}
+
+	static QDir getEntityModelCacheFolder() noexcept
+	{
+		return QDir{ QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/EntityModels" };
+	}
+
+	static QString getEntityModelCacheFilePath(QDir const& folder, std::uint64_t const entityModelID) noexcept
+	{
+		return folder.filePath(QString{ "%1.aem" }.arg(static_cast<qulonglong>(entityModelID), 16, 16, QChar{ '0' }));
+	}
+
+	// Calls the handler with the content of the file (nullptr if the file cannot be read)
+	template<typename Handler>
+	static auto withFileContent(QString const& filePath, Handler&& handler) noexcept
+	{
+		auto file = QFile{ filePath };
+		auto content = QByteArray{};
+		if (file.open(QIODevice::ReadOnly))
+		{
+			content = file.readAll();
+		}
+		if (content.isEmpty())
+		{
+			return handler(static_cast<std::uint8_t const*>(nullptr), std::size_t{ 0u });
+		}
+		return handler(reinterpret_cast<std::uint8_t const*>(content.constData()), static_cast<std::size_t>(content.size()));
+	}
+
+	// Feeds the controller's entity model cache with the persisted entity models, discarding the ones that are corrupted
+	void loadPersistentEntityModelCache(la::avdecc::controller::Controller& controller) noexcept
+	{
+		auto const folder = getEntityModelCacheFolder();
+		auto const indexPath = folder.filePath(EntityModelCacheIndexFileName);
+		auto indexOpt = withFileContent(indexPath,
+			[](std::uint8_t const* const data, std::size_t const size)
+			{
+				return EntityModelCacheIndex::parse(data, size);
+			});
+
+		_persistedEntityModels.clear();
+		auto isIndexModified = false;
+
+		if (indexOpt)
+		{
+			_entityModelCacheIndex = std::move(*indexOpt);
+		}
+		else
+		{
+			// Missing, corrupted or from another format version: none of the stored files can be trusted
+			auto const isCorrupted = QFile::exists(indexPath);
+			auto removedCount = std::uint64_t{ 0u };
+			for (auto const& fileName : folder.entryList(QStringList{ "*.aem" }, QDir::Files))
+			{
+				if (QFile::remove(folder.filePath(fileName)) && isCorrupted)
+				{
+					++removedCount;
+				}
+			}
+			updateEntityModelCacheStatistics(
+				[removedCount](auto& statistics)
+				{
+					statistics.invalidatedCount += removedCount;
+				});
+			_entityModelCacheIndex = EntityModelCacheIndex{};
+			isIndexModified = isCorrupted;
+		}
+
+		auto invalidatedEntityModels = std::vector<std::uint64_t>{};
+		for (auto const& [entityModelID, record] : _entityModelCacheIndex.getRecords())
+		{
+			auto const filePath = getEntityModelCacheFilePath(folder, entityModelID);
+			// The file is validated against its record (size and hash) before being parsed by the controller, which only loads from a path. No other thread writes to the cache files
+			auto const isLoaded = withFileContent(filePath,
+				[&controller, &record = record, &filePath](std::uint8_t const* const data, std::size_t const size)
+				{
+					if (!EntityModelCacheIndex::isValidFile(record, data, size))
+					{
+						return false;
+					}
+					auto const [error, message] = controller.loadEntityModelFile(filePath.toStdString());
+					return error == la::avdecc::jsonSerializer::DeserializationError::NoError;
+				});
+			if (isLoaded)
+			{
+				_persistedEntityModels.insert(entityModelID);
+				continue;
+			}
+			QFile::remove(filePath);
+			invalidatedEntityModels.push_back(entityModelID);
+		}
+
+		for (auto const entityModelID : invalidatedEntityModels)
+		{
+			_entityModelCacheIndex.removeRecord(entityModelID);
+			isIndexModified = true;
+		}
+
+		if (isIndexModified)
+		{
+			saveEntityModelCacheIndex();
+		}
+		updateEntityModelCacheStatistics(
+			[this, invalidatedCount = invalidatedEntityModels.size()](auto& statistics)
+			{
+				statistics.invalidatedCount += invalidatedCount;
+				statistics.storedCount = _entityModelCacheIndex.getRecords().size();
+			});
+	}
+
+	void saveEntityModelCacheIndex() noexcept
+	{
+		auto const folder = getEntityModelCacheFolder();
+		auto const data = _entityModelCacheIndex.serialize();
+		// Atomically replace the index, so it is never found partially written
+		auto file = QSaveFile{ folder.filePath(EntityModelCacheIndexFileName) };
+		if (folder.mkpath(".") && file.open(QIODevice::WriteOnly))
+		{
+			file.write(reinterpret_cast<char const*>(data.data()), static_cast<qint64>(data.size()));
+			file.commit();
+		}
+		updateEntityModelCacheStatistics(
+			[storedCount = _entityModelCacheIndex.getRecords().size()](auto& statistics)
+			{
+				statistics.storedCount = storedCount;
+			});
+	}
+
+	// Counts a hit if the entity was enumerated using a persisted entity model, otherwise persists its entity model (if complete)
+	void updatePersistentEntityModelCache(la::avdecc::UniqueIdentifier const entityID, la::avdecc::UniqueIdentifier const entityModelID, bool const isUsingCachedEntityModel) noexcept
+	{
+		auto const modelID = entityModelID.getValue();
+		auto const isHit = isUsingCachedEntityModel && _persistedEntityModels.count(modelID) != 0;
+		updateEntityModelCacheStatistics(
+			[isHit](auto& statistics)
+			{
+				++(isHit ? statistics.hitCount : statistics.missCount);
+			});
+		if (isHit)
+		{
+			return;
+		}
+
+		auto controller = getController();
+		if (!controller)
+		{
+			return;
+		}
+
+		// Only a fully enumerated entity model can be persisted
+		auto const checksum = std::invoke(
+			[&controller, entityID]() -> std::optional<std::string>
+			{
+				auto const entity = controller->getControlledEntityGuard(entityID);
+				if (!entity || !entity->isEntityModelValidForCaching())
+				{
+					return std::nullopt;
+				}
+				return la::avdecc::controller::Controller::computeEntityModelChecksum(*entity, EntityModelCacheChecksumVersion);
+			});
+		if (!checksum)
+		{
+			return;
+		}
+
+		if (auto const* const record = _entityModelCacheIndex.getRecord(modelID))
+		{
+			if (record->checksumVersion == EntityModelCacheChecksumVersion && record->checksum == *checksum)
+			{
+				return;
+			}
+			// Same EntityModelID but a different model (the persisted one no longer matches the device)
+			updateEntityModelCacheStatistics(
+				[](auto& statistics)
+				{
+					++statistics.invalidatedCount;
+				});
+		}
+
+		// Serialize to a temporary file first, so a valid record never points to a partially written file
+		auto const folder = getEntityModelCacheFolder();
+		auto const filePath = getEntityModelCacheFilePath(folder, modelID);
+		auto const tempFilePath = filePath + ".tmp";
+		auto const flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat };
+		if (!folder.mkpath("."))
+		{
+			return;
+		}
+		auto const [error, message] = controller->serializeControlledEntityAsJson(entityID, tempFilePath.toStdString(), flags, "Hive AEM cache");
+		auto record = withFileContent(tempFilePath,
+			[modelID, &checksum](std::uint8_t const* const data, std::size_t const size)
+			{
+				return EntityModelCacheIndex::Record{ modelID, EntityModelCacheChecksumVersion, *checksum, size, EntityModelCacheIndex::computeHash(data, size) };
+			});
+
+		QFile::remove(filePath);
+		if (error != la::avdecc::jsonSerializer::SerializationError::NoError || record.fileSize == 0u || !QFile::rename(tempFilePath, filePath) || !_entityModelCacheIndex.setRecord(std::move(record)))
+		{
+			QFile::remove(tempFilePath);
+			QFile::remove(filePath);
+			if (_entityModelCacheIndex.removeRecord(modelID))
+			{
+				saveEntityModelCacheIndex();
+			}
+			return;
+		}
+		_persistedEntityModels.insert(modelID);
+		saveEntityModelCacheIndex();
+	}
+
+	std::chrono::milliseconds getCountersPollingTime() const noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _countersPollingStartTime);
+	}
+
+	void addCountersPolling(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		if (!_countersPollingEntity)
+		{
+			return;
+		}
+
+		auto const now = getCountersPollingTime();
+		_countersPolling.addEntity(entityID, now);
+		if (entityID == _countersPollingFocus)
+		{
+			_countersPolling.setSelected(entityID, true, now);
+		}
+		scheduleCountersPolling();
+	}
+
+	void notifyCountersPollingTimeout(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		_countersPolling.notifyTimeout(entityID, getCountersPollingTime());
+		scheduleCountersPolling();
+	}
+
+	void pollCounters() noexcept
+	{
+		for (auto const& entityID : _countersPolling.takeDue(getCountersPollingTime()))
+		{
+			queryCounters(entityID);
+		}
+		scheduleCountersPolling();
+	}
+
+	void scheduleCountersPolling() noexcept
+	{
+		if (auto const delay = _countersPolling.getNextPollDelay(getCountersPollingTime()))
+		{
+			_countersPollingTimer.start(*delay);
+		}
+		else
+		{
+			_countersPollingTimer.stop();
+		}
+	}
+
+	// Converts the counters returned by a GET_COUNTERS command, each counter being at the position of its valid flag
+	template<typename Counters, typename ValidFlags>
+	static Counters makeCounters(ValidFlags const& validCounters, la::avdecc::entity::model::DescriptorCounters const& descriptorCounters) noexcept
+	{
+		auto counters = Counters{};
+		for (auto const flag : validCounters)
+		{
+			auto position = std::size_t{ 0u };
+			for (auto value = la::avdecc::utils::to_integral(flag); value > 1u; value >>= 1)
+			{
+				++position;
+			}
+			if (position < descriptorCounters.size())
+			{
+				counters[flag] = descriptorCounters[position];
+			}
+		}
+		return counters;
+	}
+
+	// Forwards polled counters through the same path than the ones notified by the controller
+	template<typename Notifier>
+	void notifyPolledCounters(la::avdecc::UniqueIdentifier const entityID, Notifier&& notifier) noexcept
+	{
+		if (auto const entity = getControlledEntity(entityID))
+		{
+			notifier(&*entity);
+		}
+	}
+
+	// Queries the counters of an entity: the entity first, then the descriptors of its current configuration unless it timed out
+	void queryCounters(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		if (!_countersPollingEntity)
+		{
+			return;
+		}
+
+		auto avbInterfaces = std::vector<la::avdecc::entity::model::AvbInterfaceIndex>{};
+		auto clockDomains = std::vector<la::avdecc::entity::model::ClockDomainIndex>{};
+		auto streamInputs = std::vector<la::avdecc::entity::model::StreamIndex>{};
+		auto streamOutputs = std::vector<la::avdecc::entity::model::StreamIndex>{};
+		{
+			auto const entity = getControlledEntity(entityID);
+			if (!entity)
+			{
+				// Entity no longer known by the controller
+				_countersPolling.removeEntity(entityID);
+				return;
+			}
+			try
+			{
+				auto const& configNode = entity->getCurrentConfigurationNode();
+				for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configNode.avbInterfaces)
+				{
+					avbInterfaces.push_back(avbInterfaceIndex);
+				}
+				for (auto const& [clockDomainIndex, clockDomainNode] : configNode.clockDomains)
+				{
+					clockDomains.push_back(clockDomainIndex);
+				}
+				for (auto const& [streamIndex, streamNode] : configNode.streamInputs)
+				{
+					streamInputs.push_back(streamIndex);
+				}
+				for (auto const& [streamIndex, streamNode] : configNode.streamOutputs)
+				{
+					streamOutputs.push_back(streamIndex);
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+				// No configuration, only query the entity counters
+			}
+		}
+
+		// Handlers are called from the polling controller entity thread
+		_countersPollingEntity->getEntityCounters(entityID,
+			[this, avbInterfaces = std::move(avbInterfaces), clockDomains = std::move(clockDomains), streamInputs = std::move(streamInputs), streamOutputs = std::move(streamOutputs)](la::avdecc::entity::controller::Interface const* const controller, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::LocalEntity::AemCommandStatus const status, la::avdecc::entity::EntityCounterValidFlags const validCounters, la::avdecc::entity::model::DescriptorCounters const& counters)
+			{
+				if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::TimedOut)
+				{
+					// Don't query the descriptors of an entity not responding, and poll it less often
+					QMetaObject::invokeMethod(this,
+						[this, entityID]()
+						{
+							notifyCountersPollingTimeout(entityID);
+						});
+					return;
+				}
+				if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::Success)
+				{
+					notifyPolledCounters(entityID,
+						[this, &validCounters, &counters](la::avdecc::controller::ControlledEntity const* const entity)
+						{
+							onEntityCountersChanged(nullptr, entity, makeCounters<la::avdecc::entity::model::EntityCounters>(validCounters, counters));
+						});
+				}
+
+				for (auto const avbInterfaceIndex : avbInterfaces)
+				{
+					controller->getAvbInterfaceCounters(entityID, avbInterfaceIndex,
+						[this](la::avdecc::entity::controller::Interface const* const /*controller*/, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::LocalEntity::AemCommandStatus const status, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::AvbInterfaceCounterValidFlags const validCounters, la::avdecc::entity::model::DescriptorCounters const& counters)
+						{
+							if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::Success)
+							{
+								notifyPolledCounters(entityID,
+									[this, avbInterfaceIndex, &validCounters, &counters](la::avdecc::controller::ControlledEntity const* const entity)
+									{
+										onAvbInterfaceCountersChanged(nullptr, entity, avbInterfaceIndex, makeCounters<la::avdecc::entity::model::AvbInterfaceCounters>(validCounters, counters));
+									});
+							}
+						});
+				}
+				for (auto const clockDomainIndex : clockDomains)
+				{
+					controller->getClockDomainCounters(entityID, clockDomainIndex,
+						[this](la::avdecc::entity::controller::Interface const* const /*controller*/, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::LocalEntity::AemCommandStatus const status, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::ClockDomainCounterValidFlags const validCounters, la::avdecc::entity::model::DescriptorCounters const& counters)
+						{
+							if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::Success)
+							{
+								notifyPolledCounters(entityID,
+									[this, clockDomainIndex, &validCounters, &counters](la::avdecc::controller::ControlledEntity const* const entity)
+									{
+										onClockDomainCountersChanged(nullptr, entity, clockDomainIndex, makeCounters<la::avdecc::entity::model::ClockDomainCounters>(validCounters, counters));
+									});
+							}
+						});
+				}
+				for (auto const streamIndex : streamInputs)
+				{
+					controller->getStreamInputCounters(entityID, streamIndex,
+						[this](la::avdecc::entity::controller::Interface const* const /*controller*/, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::LocalEntity::AemCommandStatus const status, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlags const validCounters, la::avdecc::entity::model::DescriptorCounters const& counters)
+						{
+							if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::Success)
+							{
+								notifyPolledCounters(entityID,
+									[this, streamIndex, &validCounters, &counters](la::avdecc::controller::ControlledEntity const* const entity)
+									{
+										onStreamInputCountersChanged(nullptr, entity, streamIndex, makeCounters<la::avdecc::entity::model::StreamInputCounters>(validCounters, counters));
+									});
+							}
+						});
+				}
+				for (auto const streamIndex : streamOutputs)
+				{
+					controller->getStreamOutputCounters(entityID, streamIndex,
+						[this](la::avdecc::entity::controller::Interface const* const /*controller*/, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::LocalEntity::AemCommandStatus const status, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamOutputCounterValidFlags const validCounters, la::avdecc::entity::model::DescriptorCounters const& counters)
+						{
+							if (status == la::avdecc::entity::LocalEntity::AemCommandStatus::Success)
+							{
+								notifyPolledCounters(entityID,
+									[this, streamIndex, &validCounters, &counters](la::avdecc::controller::ControlledEntity const* const entity)
+									{
+										onStreamOutputCountersChanged(nullptr, entity, streamIndex, makeCounters<la::avdecc::entity::model::StreamOutputCounters>(validCounters, counters));
+									});
+							}
+						});
+				}
+			});
+	}
+
 	SharedController getController() noexcept
 	{
 #if HAVE_ATOMIC_SMART_POINTERS
@@ -2808,6 +4044,33 @@ private:
 	bool _enableFastEnumeration{ false };
 	bool _fullAemEnumeration{ false };
 	VirtualController _virtualController{ nullptr };
+	CoalescedNotificationsStore _coalescedNotifications{};
+	QTimer _coalescingTimer{};
+	std::chrono::milliseconds _coalescingInterval{ DefaultNotificationsCoalescingInterval };
+	EntitySnapshotStore _entitySnapshots{}; // Latest snapshot of online entities, written from the avdecc thread, read from any thread
+	std::mutex _bulkLoadLock{}; // Bulk load exclusive access
+	std::optional<BulkLoad> _bulkLoad{}; // Pending bulk load, if any
+	std::thread _bulkLoadThread{};
+	std::deque<PendingBulkLoad> _pendingBulkLoads{}; // Only accessed from the main thread
+	bool _isBulkLoading{ false }; // Only accessed from the main thread
+	static constexpr auto EntityModelCacheIndexFileName = "index.bin";
+	static constexpr auto EntityModelCacheChecksumVersion = std::uint32_t{ 5u };
+	bool _isPersistentEntityModelCacheActive{ false }; // Only accessed from the main thread
+	EntityModelCacheIndex _entityModelCacheIndex{}; // Only accessed from the entity model cache thread
+	std::set<std::uint64_t> _persistedEntityModels{}; // EntityModelIDs fed to the controller's entity model cache, only accessed from the entity model cache thread
+	mutable std::mutex _entityModelCacheLock{}; // Entity model cache tasks and statistics exclusive access
+	std::condition_variable _entityModelCacheCondition{};
+	std::deque<std::function<void()>> _entityModelCacheTasks{}; // Executed in order by the entity model cache thread
+	bool _entityModelCacheShouldTerminate{ false };
+	EntityModelCacheStatistics _entityModelCacheStatistics{};
+	std::thread _entityModelCacheThread{};
+	static constexpr auto CountersPollingProgIDOffset = std::uint16_t{ 0x8000 }; // ProgID of the polling controller entity, relative to the controller's one (so their EntityIDs differ)
+	la::avdecc::EndStation::UniquePointer _countersPollingEndStation{ nullptr, nullptr }; // Only accessed from the main thread
+	la::avdecc::entity::ControllerEntity* _countersPollingEntity{ nullptr }; // Owned by _countersPollingEndStation, only accessed from the main thread
+	PollingScheduler<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _countersPolling{}; // Entities not supporting unsolicited notifications, only accessed from the main thread
+	la::avdecc::UniqueIdentifier _countersPollingFocus{}; // Only accessed from the main thread
+	std::chrono::steady_clock::time_point const _countersPollingStartTime{ std::chrono::steady_clock::now() };
+	QTimer _countersPollingTimer{};
 };
 
 QString ControllerManager::typeToString(AecpCommandType const type) noexcept
@@ -27,6 +27,7 @@
 #include <optional>
 #include <unordered_set>
 #include <tuple>
+#include <set>
 
 namespace hive
 {
@@ -44,6 +45,7 @@ public:
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &pImpl::handleControllerOffline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &pImpl::handleEntityOnline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &pImpl::handleEntityOffline);
+		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this, &pImpl::handleEntitiesOnline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityRedundantInterfaceOnline, this, &pImpl::handleEntityRedundantInterfaceOnline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityRedundantInterfaceOffline, this, &pImpl::handleEntityRedundantInterfaceOffline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::unsolicitedRegistrationChanged, this, &pImpl::handleUnsolicitedRegistrationChanged);
@@ -62,7 +64,7 @@ public:
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::statisticsErrorCounterChanged, this, &pImpl::handleStatisticsErrorCounterChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::diagnosticsChanged, this, &pImpl::handleDiagnosticsChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::mediaClockChainChanged, this, &pImpl::handleMediaClockChainChanged);
-		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::clockDomainCountersChanged, this, &pImpl::handleClockDomainCountersChanged);
+		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::coalescedNotificationsFlushed, this, &pImpl::handleCoalescedNotificationsFlushed);
 	}
 
 	std::optional<std::reference_wrapper<Entity const>> entity(std::size_t const index) const noexcept
@@ -418,6 +420,55 @@ private:
 	}
 
 	void handleEntityOnline(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		if (auto discoveredEntity = buildEntity(entityID))
+		{
+			// Insert at the end
+			auto const row = _model->rowCount();
+			emit _model->beginInsertRows({}, row, row);
+
+			_entities.push_back(std::move(*discoveredEntity));
+
+			// Update the cache
+			_entityRowMap[entityID] = static_cast<std::size_t>(row);
+
+			emit _model->endInsertRows();
+		}
+	}
+
+	void handleEntitiesOnline(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+	{
+		auto discoveredEntities = std::vector<Entity>{};
+		discoveredEntities.reserve(entityIDs.size());
+		for (auto const& entityID : entityIDs)
+		{
+			if (auto discoveredEntity = buildEntity(entityID))
+			{
+				discoveredEntities.push_back(std::move(*discoveredEntity));
+			}
+		}
+
+		if (discoveredEntities.empty())
+		{
+			return;
+		}
+
+		// Insert all entities at the end, at once
+		auto const first = _model->rowCount();
+		auto const last = first + static_cast<int>(discoveredEntities.size()) - 1;
+		emit _model->beginInsertRows({}, first, last);
+
+		for (auto& discoveredEntity : discoveredEntities)
+		{
+			_entityRowMap[discoveredEntity.entityID] = _entities.size();
+			_entities.push_back(std::move(discoveredEntity));
+		}
+
+		emit _model->endInsertRows();
+	}
+
+	// Builds a discovered entity, if it is still online
+	std::optional<Entity> buildEntity(la::avdecc::UniqueIdentifier const& entityID) noexcept
 	{
 		try
 		{
@@ -503,16 +554,7 @@ private:
 				auto discoveredEntity = Entity{ entityID, isAemSupported, hasAnyConfiguration, entity.isVirtual(), entity.areUnsolicitedNotificationsSupported(), e.getEntityModelID(), firmwareVersion, firmwareUploadMemoryIndex, entity.getMilanInfo(), std::move(macAddresses), helper::entityName(entity), helper::groupName(entity), entity.isSubscribedToUnsolicitedNotifications(), protocolCompatibility, milanCompatibleVersion, isRedundant, e.getEntityCapabilities(), computeExclusiveInfo(isAemSupported && hasAnyConfiguration, entity.getAcquireState(), entity.getOwningControllerID()), computeExclusiveInfo(isAemSupported && hasAnyConfiguration, entity.getLockState(), entity.getLockingControllerID()), std::move(gptpInfo), e.getAssociationID(), std::move(mediaClockReferences), entity.isIdentifying(),
 					!statisticsCounters.empty(), diagnostics.redundancyWarning, std::move(clockDomainInfo), {}, diagnostics.streamInputOverLatency, diagnostics.controlCurrentValueOutOfBounds, hadCompatibilityChangeEvent };
 
-				// Insert at the end
-				auto const row = _model->rowCount();
-				emit _model->beginInsertRows({}, row, row);
-
-				_entities.push_back(discoveredEntity);
-
-				// Update the cache
-				rebuildEntityRowMap();
-
-				emit _model->endInsertRows();
+				return discoveredEntity;
 			}
 		}
 		catch (...)
@@ -520,6 +562,7 @@ private:
 			// Uncaught exception
 			AVDECC_ASSERT(false, "Uncaught exception");
 		}
+		return std::nullopt;
 	}
 
 	void handleEntityOffline(la::avdecc::UniqueIdentifier const& entityID)
@@ -930,16 +973,30 @@ private:
 		}
 	}
 
-	void handleClockDomainCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::ClockDomainCounters const& counters)
+	void handleCoalescedNotificationsFlushed(hive::modelsLibrary::ControllerManager::CoalescedNotifications const& notifications)
 	{
-		if (auto const index = indexOf(entityID))
+		// Update all entities of the batch first, then notify once per changed entity
+		auto changedIndexes = std::set<std::size_t>{};
+
+		for (auto const& [entityID, clockDomainIndex, counters] : notifications.clockDomainCounters)
 		{
-			auto const idx = *index;
-			auto& data = _entities[idx];
+			if (auto const index = indexOf(entityID))
+			{
+				auto const idx = *index;
+				auto& data = _entities[idx];
 
-			data.clockDomainInfo = computeClockDomainInfo(counters);
+				auto const clockDomainInfo = computeClockDomainInfo(counters);
+				if (data.clockDomainInfo.state != clockDomainInfo.state || data.clockDomainInfo.tooltip != clockDomainInfo.tooltip)
+				{
+					data.clockDomainInfo = clockDomainInfo;
+					changedIndexes.insert(idx);
+				}
+			}
+		}
 
-			la::avdecc::utils::invokeProtectedMethod(&Model::entityInfoChanged, _model, idx, data, Model::ChangedInfoFlags{ Model::ChangedInfoFlag::ClockDomainLockState });
+		for (auto const idx : changedIndexes)
+		{
+			la::avdecc::utils::invokeProtectedMethod(&Model::entityInfoChanged, _model, idx, _entities[idx], Model::ChangedInfoFlags{ Model::ChangedInfoFlag::ClockDomainLockState });
 		}
 	}
 
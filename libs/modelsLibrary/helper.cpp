@@ -19,16 +19,12 @@
 
 
 #include "hive/modelsLibrary/helper.hpp"
+#include "hive/modelsLibrary/ouiData.hpp"
 
 #include <la/avdecc/utils.hpp>
-#include <nlohmann/json.hpp>
-
-#include <QFile>
 
 #include <cctype>
 
-using json = nlohmann::json;
-
 namespace hive
 {
 namespace modelsLibrary
@@ -123,6 +119,23 @@ QString smartEntityName(hive::modelsLibrary::DiscoveredEntitiesModel::Entity con
 	return name;
 }
 
+QString smartEntityName(hive::modelsLibrary::EntitySnapshot const& snapshot) noexcept
+{
+	QString name;
+
+	if (snapshot.isAemSupported)
+	{
+		name = QString::fromStdString(snapshot.entityName);
+	}
+
+	if (name.isEmpty())
+	{
+		name = uniqueIdentifierToString(snapshot.entityID);
+	}
+
+	return name;
+}
+
 QString groupName(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
 {
 	try
@@ -225,58 +238,17 @@ QString toUpperCamelCase(std::string const& text) noexcept
 
 QString getVendorName(la::avdecc::UniqueIdentifier const entityID) noexcept
 {
-	static auto s_fileLoaded = false;
-	static auto s_oui24ToName = std::unordered_map<std::uint32_t, QString>{};
-	static auto s_oui36ToName = std::unordered_map<std::uint64_t, QString>{};
-
-	// If file not loaded, load it
-	if (!s_fileLoaded)
+	// First search in OUI-24, then in OUI-36
+	auto nameIndex = oui::Oui24.find(entityID.getVendorID<std::uint32_t>());
+	if (!nameIndex)
 	{
-		s_fileLoaded = true;
-
-		auto jsonFile = QFile{ ":/oui.json" };
-		if (jsonFile.open(QIODevice::ReadOnly | QIODevice::Text))
-		{
-			// Read file
-			try
-			{
-				auto const jsonContent = json::parse(jsonFile.readAll().toStdString());
-
-				// Read oui_24 key, if present
-				if (auto it = jsonContent.find("oui_24"); it != jsonContent.end())
-				{
-					// Read each entry, converting "key" to hex and "value" to string
-					for (auto const& [key, value] : it->items())
-					{
-						auto const oui24 = la::avdecc::utils::convertFromString<std::uint32_t>(key.c_str());
-						auto const& vendorName = value.get<std::string>();
-						s_oui24ToName.emplace(std::make_pair(oui24, QString::fromStdString(vendorName)));
-					}
-				}
-			}
-			catch (...)
-			{
-				// Ignore exception
-			}
-		}
+		nameIndex = oui::Oui36.find(entityID.getVendorID<std::uint64_t>());
 	}
 
-	// First search in OUI-24
+	if (nameIndex)
 	{
-		auto const nameIt = s_oui24ToName.find(entityID.getVendorID<std::uint32_t>());
-		if (nameIt != s_oui24ToName.end())
-		{
-			return nameIt->second;
-		}
-	}
-
-	// Then search in OUI-36
-	{
-		auto const nameIt = s_oui36ToName.find(entityID.getVendorID<std::uint64_t>());
-		if (nameIt != s_oui36ToName.end())
-		{
-			return nameIt->second;
-		}
+		auto const& vendorName = oui::VendorNames[*nameIndex];
+		return QString::fromUtf8(vendorName.data(), static_cast<int>(vendorName.size()));
 	}
 
 	// If not found, convert to hex string
@@ -19,6 +19,8 @@
 
 #include "hive/widgetModelsLibrary/discoveredEntitiesTableItemDelegate.hpp"
 #include "hive/widgetModelsLibrary/discoveredEntitiesTableModel.hpp"
+#include "hive/widgetModelsLibrary/entityLogoCache.hpp"
+#include "hive/widgetModelsLibrary/painterHelper.hpp"
 #include "hive/widgetModelsLibrary/qtUserRoles.hpp"
 
 #include <QPainter>
@@ -169,6 +171,18 @@ void DiscoveredEntitiesTableItemDelegate::paint(QPainter* painter, QStyleOptionV
 		switch (index.column())
 		{
 			case DiscoveredEntitiesTableModel::EntityDataFlags::getPosition(DiscoveredEntitiesTableModel::EntityDataFlag::EntityLogo):
+			{
+				auto const entityIDData = index.data(la::avdecc::utils::to_integral(QtUserRoles::EntityLogoRole));
+				if (entityIDData.isValid())
+				{
+					// Get the logo already scaled to the painted size, so drawCentered doesn't have to scale it
+					auto const devicePixelRatio = painter->device()->devicePixelRatioF();
+					auto const size = QSize{ static_cast<int>(option.rect.width() * devicePixelRatio), static_cast<int>(option.rect.height() * devicePixelRatio) };
+					auto const entityID = la::avdecc::UniqueIdentifier{ entityIDData.value<la::avdecc::UniqueIdentifier::value_type>() };
+					painterHelper::drawCentered(painter, option.rect, EntityLogoCache::getInstance().getPixmap(entityID, EntityLogoCache::Type::Entity, size, true));
+				}
+				break;
+			}
 			case DiscoveredEntitiesTableModel::EntityDataFlags::getPosition(DiscoveredEntitiesTableModel::EntityDataFlag::Compatibility):
 			case DiscoveredEntitiesTableModel::EntityDataFlags::getPosition(DiscoveredEntitiesTableModel::EntityDataFlag::AcquireState):
 			case DiscoveredEntitiesTableModel::EntityDataFlags::getPosition(DiscoveredEntitiesTableModel::EntityDataFlag::LockState):
@@ -59,6 +59,22 @@ DiscoveredEntitiesTableModel::DiscoveredEntitiesTableModel(EntityDataFlags const
 	: _entityDataFlags{ entityDataFlags }
 	, _count{ static_cast<decltype(_count)>(_entityDataFlags.count()) }
 {
+	// Logos are asynchronously loaded by the cache, refresh them when available
+	if (_entityDataFlags.test(EntityDataFlag::EntityLogo))
+	{
+		connect(&EntityLogoCache::getInstance(), &EntityLogoCache::imageChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, EntityLogoCache::Type const type)
+			{
+				if (type == EntityLogoCache::Type::Entity)
+				{
+					if (auto const idxOpt = _model.indexOf(entityID))
+					{
+						auto const modelIndex = createIndex(static_cast<int>(*idxOpt), static_cast<int>(_entityDataFlags.getBitSetPosition(EntityDataFlag::EntityLogo)));
+						emit dataChanged(modelIndex, modelIndex, { la::avdecc::utils::to_integral(QtUserRoles::EntityLogoRole) });
+					}
+				}
+			});
+	}
 }
 
 // Data getter
@@ -467,7 +483,7 @@ QVariant DiscoveredEntitiesTableModel::data(QModelIndex const& index, int role)
 						}
 						break;
 					}
-					case la::avdecc::utils::to_integral(QtUserRoles::LightImageRole):
+					case la::avdecc::utils::to_integral(QtUserRoles::EntityLogoRole):
 					{
 						switch (entityDataFlag)
 						{
@@ -475,11 +491,19 @@ QVariant DiscoveredEntitiesTableModel::data(QModelIndex const& index, int role)
 							{
 								if (entity.isAemSupported && entity.hasAnyConfigurationTree)
 								{
-									auto& logoCache = EntityLogoCache::getInstance();
-									return logoCache.getImage(entity.entityID, EntityLogoCache::Type::Entity, true);
+									return QVariant::fromValue(entity.entityID.getValue());
 								}
 								break;
 							}
+							default:
+								break;
+						}
+						break;
+					}
+					case la::avdecc::utils::to_integral(QtUserRoles::LightImageRole):
+					{
+						switch (entityDataFlag)
+						{
 							case EntityDataFlag::Compatibility:
 							{
 								auto& compatibilityLogoCache = CompatibilityLogoCache::getInstance();
@@ -530,15 +554,6 @@ QVariant DiscoveredEntitiesTableModel::data(QModelIndex const& index, int role)
 					{
 						switch (entityDataFlag)
 						{
-							case EntityDataFlag::EntityLogo:
-							{
-								if (entity.isAemSupported && entity.hasAnyConfigurationTree)
-								{
-									auto& logoCache = EntityLogoCache::getInstance();
-									return logoCache.getImage(entity.entityID, EntityLogoCache::Type::Entity, true);
-								}
-								break;
-							}
 							case EntityDataFlag::Compatibility:
 							{
 								auto& compatibilityLogoCache = CompatibilityLogoCache::getInstance();
@@ -18,6 +18,8 @@
 */
 
 #include "hive/widgetModelsLibrary/entityLogoCache.hpp"
+#include "hive/widgetModelsLibrary/sizeBoundedLruCache.hpp"
+#include "hive/widgetModelsLibrary/downloadScheduler.hpp"
 
 #include <hive/modelsLibrary/helper.hpp>
 #include <hive/modelsLibrary/controllerManager.hpp>
@@ -29,81 +31,114 @@
 #include <QApplication>
 #include <QtGlobal>
 #include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace hive
 {
 namespace widgetModelsLibrary
 {
-inline auto qHash(EntityLogoCache::Type const type, uint seed = 0)
-{
-	return ::qHash(la::avdecc::utils::to_integral(type), seed);
-}
-
 class EntityLogoCacheImpl : public EntityLogoCache
 {
 public:
 	EntityLogoCacheImpl()
 	{
 		qRegisterMetaType<hive::widgetModelsLibrary::EntityLogoCache::Type>("hive::widgetModelsLibrary::EntityLogoCache::Type");
+
+		// Loading is mostly waiting for the disk, don't use all the cores (the GUI thread should stay responsive)
+		_loadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+
+		// Prefetch the logo of entities as soon as they are enumerated, so it's available when displayed
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOnline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const /*enumerationTime*/)
+			{
+				prefetchLogos(entityID);
+			});
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+			[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+			{
+				for (auto const& entityID : entityIDs)
+				{
+					prefetchLogos(entityID);
+				}
+			});
+
+		// Don't try to read logos from an entity going offline
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				_downloads.cancelSource(entityID);
+			});
+	}
+
+	~EntityLogoCacheImpl()
+	{
+		// Pending loads reference this object
+		_loadPool.clear();
+		_loadPool.waitForDone();
 	}
 
 	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache) noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getImage must be called in the GUI thread.");
 
-		auto const key{ makeKey(entityID) };
+		auto const cacheKey = CacheKey{ makeKey(entityID), type, QSize{} };
 
-		// Check if we have something in the memory cache for this key (entityID-entityModelID)
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
+		// Check if we have the image in the memory cache
+		if (auto const* const logo = _memoryCache.find(cacheKey))
 		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
-			{
-				// Return the cached image (might be an empty QImage if the download is in progress)
-				return imageIt.value();
-			}
+			return logo->image;
 		}
 
-		QImage image;
+		requestLogo(entityID, cacheKey, downloadIfNotInCache);
+
+		return {};
+	}
 
-		// Try to load from the disk
-		QFileInfo fileInfo{ imagePath(entityID, type) };
-		if (fileInfo.exists())
+	virtual QPixmap getPixmap(la::avdecc::UniqueIdentifier const entityID, Type const type, QSize const& size, bool const downloadIfNotInCache) noexcept override
+	{
+		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getPixmap must be called in the GUI thread.");
+
+		if (size.isEmpty())
 		{
-			// Found the image on the disk, add it to the memory cache
-			image = QImage{ fileInfo.filePath() };
-			_cache[key][type] = image;
+			return {};
 		}
-		else if (downloadIfNotInCache)
+
+		auto const cacheKey = CacheKey{ makeKey(entityID), type, size };
+
+		// Check if we have the image scaled to this size in the memory cache
+		if (auto const* const logo = _memoryCache.find(cacheKey))
 		{
-			// Add a temporary empty QImage in the memory cache so we won't start another download while this one is pending
-			_cache[key][type] = image;
-			downloadImage(entityID, type);
+			return logo->pixmap;
 		}
 
-		return image;
+		requestLogo(entityID, cacheKey, downloadIfNotInCache);
+
+		return {};
 	}
 
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "isImageInCache must be called in the GUI thread.");
 
-		auto const key{ makeKey(entityID) };
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
+		auto const logoKey = CacheKey{ makeKey(entityID), type, QSize{} };
+
+		// Being downloaded, or already in the memory cache (which means it's on the disk, or being saved to it)
+		if (_downloads.isRequested(logoKey) || _memoryCache.contains(logoKey))
 		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
-			{
-				// The image has been found in the memory cache (either a real one, or a temporary one)
-				return true;
-			}
+			return true;
 		}
 
-		return false;
+		return QFileInfo::exists(imagePath(logoKey.key, type));
 	}
 
 	virtual void clear() noexcept override
@@ -113,17 +148,77 @@ public:
 		QDir dir(imageDir());
 		dir.removeRecursively();
 
-		auto const keys{ _cache.keys() };
-		_cache.clear();
+		// Discard the result of the pending loads and downloads
+		++_generation;
+		_pendingLoads.clear();
+		_notInDiskCache.clear();
+		_downloads.cancelAll();
+
+		auto entityIDs = std::set<la::avdecc::UniqueIdentifier::value_type>{};
+		_memoryCache.removeIf(
+			[&entityIDs](CacheKey const& cacheKey)
+			{
+				entityIDs.insert(cacheKey.key.first);
+				return true;
+			});
 
-		for (auto const& key : keys)
+		for (auto const entityID : entityIDs)
 		{
-			emit imageChanged(la::avdecc::UniqueIdentifier{ key.first }, Type::Entity);
-			emit imageChanged(la::avdecc::UniqueIdentifier{ key.first }, Type::Manufacturer);
+			emit imageChanged(la::avdecc::UniqueIdentifier{ entityID }, Type::Entity);
+			emit imageChanged(la::avdecc::UniqueIdentifier{ entityID }, Type::Manufacturer);
 		}
 	}
 
 private:
+	using Key = QPair<la::avdecc::UniqueIdentifier::value_type, la::avdecc::UniqueIdentifier::value_type>;
+
+	struct CacheKey
+	{
+		Key key{};
+		Type type{ Type::None };
+		QSize size{}; // Size the logo is scaled to, invalid for the original logo
+
+		bool operator==(CacheKey const& other) const noexcept
+		{
+			return key == other.key && type == other.type && size == other.size;
+		}
+	};
+
+	struct CacheKeyHash
+	{
+		std::size_t operator()(CacheKey const& cacheKey) const noexcept
+		{
+			auto hash = std::hash<std::uint64_t>{}(cacheKey.key.first);
+			hash = hash * 31u + std::hash<std::uint64_t>{}(cacheKey.key.second);
+			hash = hash * 31u + static_cast<std::size_t>(la::avdecc::utils::to_integral(cacheKey.type));
+			hash = hash * 31u + static_cast<std::size_t>(static_cast<std::uint32_t>(cacheKey.size.width()) << 16 ^ static_cast<std::uint32_t>(cacheKey.size.height()));
+			return hash;
+		}
+	};
+
+	/** Either the original image, or a pixmap scaled to the size of the key */
+	struct Logo
+	{
+		QImage image{};
+		QPixmap pixmap{};
+	};
+
+	// Logos of the same EntityModelID are downloaded once (download key), for all the entities (source) requesting them (logo key)
+	using DownloadScheduler = hive::widgetModelsLibrary::DownloadScheduler<CacheKey, CacheKey, la::avdecc::UniqueIdentifier, CacheKeyHash, CacheKeyHash, la::avdecc::UniqueIdentifier::hash>;
+	using DownloadPriority = DownloadScheduler::Priority;
+	static constexpr auto PrefetchEntityPriority = DownloadPriority::Normal; // Entity just enumerated, its logo is displayed in the entities list
+	static constexpr auto PrefetchManufacturerPriority = DownloadPriority::Low; // Entity just enumerated, its manufacturer logo is only displayed in its details
+	static constexpr auto VisiblePriority = DownloadPriority::High; // Logo requested by the UI
+
+	struct MemoryObjectLocation
+	{
+		std::uint64_t address{ 0u };
+		std::uint64_t length{ 0u };
+	};
+
+	static constexpr auto MemoryCacheSize = std::size_t{ 32u * 1024u * 1024u }; // Maximum size of the decoded logos kept in memory
+	static constexpr auto MaxConcurrentDownloads = std::size_t{ 4u }; // Maximum number of logos read at the same time (from different entities)
+
 	QString typeToString(Type const type) const noexcept
 	{
 		switch (type)
@@ -138,8 +233,6 @@ private:
 		}
 	}
 
-	using Key = QPair<la::avdecc::UniqueIdentifier::value_type, la::avdecc::UniqueIdentifier::value_type>;
-
 	Key makeKey(la::avdecc::UniqueIdentifier const entityID) const noexcept
 	{
 		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
@@ -152,9 +245,8 @@ private:
 		return {};
 	}
 
-	QString fileName(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
+	QString fileName(Key const& key, Type const type) const noexcept
 	{
-		auto const key{ makeKey(entityID) };
 		return QString{ typeToString(type) + '-' + hive::modelsLibrary::helper::uniqueIdentifierToString(la::avdecc::UniqueIdentifier{ key.first }) + '-' + hive::modelsLibrary::helper::uniqueIdentifierToString(la::avdecc::UniqueIdentifier{ key.second }) };
 	}
 
@@ -163,19 +255,121 @@ private:
 		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + '/' + QCoreApplication::applicationName();
 	}
 
-	QString imagePath(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
+	QString imagePath(Key const& key, Type const type) const noexcept
+	{
+		return imageDir() + '/' + fileName(key, type) + ".png";
+	}
+
+	void insertLogo(CacheKey const& cacheKey, QImage const& image) noexcept
+	{
+		_memoryCache.insert(cacheKey, Logo{ image, {} }, static_cast<std::size_t>(image.sizeInBytes()));
+	}
+
+	void insertLogo(CacheKey const& cacheKey, QPixmap const& pixmap) noexcept
 	{
-		return imageDir() + '/' + fileName(entityID, type) + ".png";
+		_memoryCache.insert(cacheKey, Logo{ {}, pixmap }, static_cast<std::size_t>(pixmap.width()) * static_cast<std::size_t>(pixmap.height()) * static_cast<std::size_t>(pixmap.depth()) / 8u);
 	}
 
-	void downloadImage(la::avdecc::UniqueIdentifier const entityID, Type const type) noexcept
+	// Asynchronously loads the logo from the disk (or scales the original one if in the memory cache), emitting imageChanged when available
+	void requestLogo(la::avdecc::UniqueIdentifier const entityID, CacheKey const& cacheKey, bool const downloadIfNotInCache) noexcept
+	{
+		auto const logoKey = CacheKey{ cacheKey.key, cacheKey.type, QSize{} };
+
+		// Being downloaded, imageChanged will be emitted when done
+		if (_downloads.isRequested(logoKey))
+		{
+			// Requested by the UI, download it before the prefetched ones
+			if (downloadIfNotInCache)
+			{
+				_downloads.promote(logoKey);
+			}
+			return;
+		}
+
+		// Already known not to be in the disk cache
+		if (_notInDiskCache.count(logoKey) != 0)
+		{
+			if (downloadIfNotInCache)
+			{
+				queueDownload(entityID, logoKey, VisiblePriority);
+			}
+			return;
+		}
+
+		// Already being loaded
+		if (!_pendingLoads.insert(cacheKey).second)
+		{
+			return;
+		}
+
+		// No need to read the disk if the original image is in the memory cache
+		auto image = QImage{};
+		if (cacheKey.size.isValid())
+		{
+			if (auto const* const logo = _memoryCache.find(logoKey))
+			{
+				image = logo->image;
+			}
+		}
+
+		_loadPool.start(
+			[this, generation = _generation, entityID, cacheKey, downloadIfNotInCache, image = std::move(image), path = imagePath(cacheKey.key, cacheKey.type)]() mutable
+			{
+				auto const loadedFromDisk = image.isNull();
+				if (loadedFromDisk)
+				{
+					image = QImage{ path };
+				}
+				auto scaledImage = QImage{};
+				if (!image.isNull() && cacheKey.size.isValid())
+				{
+					scaledImage = image.scaled(cacheKey.size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+				}
+
+				// Back to the UI thread so we don't have to lock the cache (QPixmap can only be created in the GUI thread anyway)
+				QMetaObject::invokeMethod(this,
+					[this, generation, entityID, cacheKey, downloadIfNotInCache, loadedFromDisk, image = std::move(image), scaledImage = std::move(scaledImage)]()
+					{
+						// The cache has been cleared since the load was requested
+						if (generation != _generation)
+						{
+							return;
+						}
+						_pendingLoads.erase(cacheKey);
+
+						auto const logoKey = CacheKey{ cacheKey.key, cacheKey.type, QSize{} };
+						if (image.isNull())
+						{
+							_notInDiskCache.insert(logoKey);
+							if (downloadIfNotInCache)
+							{
+								queueDownload(entityID, logoKey, VisiblePriority);
+							}
+							return;
+						}
+
+						if (loadedFromDisk)
+						{
+							insertLogo(logoKey, image);
+						}
+						if (cacheKey.size.isValid())
+						{
+							insertLogo(cacheKey, QPixmap::fromImage(scaledImage));
+						}
+						emit imageChanged(entityID, cacheKey.type);
+					});
+			});
+	}
+
+	// Returns the location of the logo memory object of an entity, if any
+	std::optional<MemoryObjectLocation> logoMemoryObject(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
 	{
 		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
 		auto controlledEntity = manager.getControlledEntity(entityID);
 
-		if (!controlledEntity)
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) || !controlledEntity->hasAnyConfiguration())
 		{
-			return;
+			return {};
 		}
 
 		try
@@ -196,39 +390,7 @@ private:
 					{
 						length = model.maximumLength;
 					}
-					manager.readDeviceMemory(entityID, model.startAddress, length, nullptr,
-						[this, entityID, type](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
-						{
-							auto image = QImage::fromData(memoryBuffer.data(), static_cast<int>(memoryBuffer.size()));
-
-							// Be sure to run this code in the UI thread so we don't have to lock the cache
-							QMetaObject::invokeMethod(this,
-								[this, entityID, type, status, image = std::move(image)]()
-								{
-									auto const key = makeKey(entityID);
-									if (!!status && !image.isNull())
-									{
-										QFileInfo fileInfo{ imagePath(entityID, type) };
-
-										// Make sure this directory exists & save the image to the disk
-										QDir().mkpath(fileInfo.absoluteDir().absolutePath());
-										image.save(fileInfo.filePath());
-
-										// Save the image to the cache
-										_cache[key][type] = image;
-										emit imageChanged(entityID, type);
-									}
-									else
-									{
-										// Error downloading the image, remove the temporary one from the cache
-										auto imagesIt = _cache.find(key);
-										if (imagesIt != _cache.end())
-										{
-											imagesIt->remove(type);
-										}
-									}
-								});
-						});
+					return MemoryObjectLocation{ model.startAddress, length };
 				}
 			}
 		}
@@ -236,11 +398,141 @@ private:
 		{
 			AVDECC_ASSERT(false, "Failed to find logo descriptor information in AEM");
 		}
+
+		return {};
+	}
+
+	// Queues the download of the logos of a newly enumerated entity, the Entity ones before the Manufacturer ones
+	void prefetchLogos(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		prefetchLogo(entityID, Type::Entity, PrefetchEntityPriority);
+		prefetchLogo(entityID, Type::Manufacturer, PrefetchManufacturerPriority);
+	}
+
+	// Queues the download of a logo of a newly enumerated entity, if it's not in the disk cache
+	void prefetchLogo(la::avdecc::UniqueIdentifier const entityID, Type const type, DownloadPriority const priority) noexcept
+	{
+		if (!logoMemoryObject(entityID, type))
+		{
+			return;
+		}
+
+		auto const logoKey = CacheKey{ makeKey(entityID), type, QSize{} };
+		if (_memoryCache.contains(logoKey) || _downloads.isRequested(logoKey))
+		{
+			return;
+		}
+		if (_notInDiskCache.count(logoKey) != 0)
+		{
+			queueDownload(entityID, logoKey, priority);
+			return;
+		}
+
+		// Check the disk cache in the background
+		_loadPool.start(
+			[this, entityID, logoKey, priority, path = imagePath(logoKey.key, logoKey.type)]()
+			{
+				if (QFileInfo::exists(path))
+				{
+					return;
+				}
+				QMetaObject::invokeMethod(this,
+					[this, entityID, logoKey, priority]()
+					{
+						_notInDiskCache.insert(logoKey);
+						queueDownload(entityID, logoKey, priority);
+					});
+			});
+	}
+
+	// Entities sharing the same EntityModelID have the same logos, only download them once
+	static CacheKey makeDownloadKey(CacheKey const& logoKey) noexcept
+	{
+		if (la::avdecc::UniqueIdentifier{ logoKey.key.second }.isValid())
+		{
+			return CacheKey{ Key{ 0u, logoKey.key.second }, logoKey.type, QSize{} };
+		}
+		return logoKey;
+	}
+
+	void queueDownload(la::avdecc::UniqueIdentifier const entityID, CacheKey const& logoKey, DownloadPriority const priority) noexcept
+	{
+		_downloads.request(makeDownloadKey(logoKey), entityID, logoKey, priority);
+		startDownloads();
+	}
+
+	void startDownloads() noexcept
+	{
+		_downloads.startDownloads(
+			[this](CacheKey const& downloadKey, la::avdecc::UniqueIdentifier const entityID, CacheKey const& logoKey)
+			{
+				// Entity went offline (or its logo is gone), try the next one
+				auto const memoryObject = logoMemoryObject(entityID, logoKey.type);
+				if (!memoryObject)
+				{
+					return false;
+				}
+
+				auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+				manager.readDeviceMemory(entityID, memoryObject->address, memoryObject->length, nullptr,
+					[this, downloadKey, entityID](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
+					{
+						auto image = !!status ? QImage::fromData(memoryBuffer.data(), static_cast<int>(memoryBuffer.size())) : QImage{};
+
+						// Be sure to run this code in the UI thread so we don't have to lock the cache
+						QMetaObject::invokeMethod(this,
+							[this, downloadKey, entityID, image = std::move(image)]()
+							{
+								downloadCompleted(downloadKey, entityID, image);
+							});
+					});
+				return true;
+			});
+	}
+
+	void downloadCompleted(CacheKey const& downloadKey, la::avdecc::UniqueIdentifier const entityID, QImage const& image) noexcept
+	{
+		// On error, the download is tried again from the other entities sharing the same model (if any)
+		for (auto const& [requesterID, logoKey] : _downloads.complete(downloadKey, entityID, !image.isNull()))
+		{
+			saveLogo(requesterID, logoKey, image);
+		}
+
+		startDownloads();
+	}
+
+	void saveLogo(la::avdecc::UniqueIdentifier const entityID, CacheKey const& logoKey, QImage const& image) noexcept
+	{
+		// Save the image to the disk, in the background
+		_loadPool.start(
+			[image, path = imagePath(logoKey.key, logoKey.type)]()
+			{
+				// Make sure this directory exists & save the image to the disk
+				QDir().mkpath(QFileInfo{ path }.absoluteDir().absolutePath());
+				image.save(path);
+			});
+
+		// Replace the previous logo (and its scaled versions) in the memory cache
+		_notInDiskCache.erase(logoKey);
+		_memoryCache.removeIf(
+			[&logoKey](CacheKey const& cacheKey)
+			{
+				return cacheKey.key == logoKey.key && cacheKey.type == logoKey.type;
+			});
+		insertLogo(logoKey, image);
+		emit imageChanged(entityID, logoKey.type);
 	}
 
 private:
-	using CacheData = QHash<Type, QImage>;
-	QHash<Key, CacheData> _cache;
+	using CacheKeys = std::unordered_set<CacheKey, CacheKeyHash>;
+
+	QThreadPool _loadPool{};
+	SizeBoundedLruCache<CacheKey, Logo, CacheKeyHash> _memoryCache{ MemoryCacheSize };
+	CacheKeys _pendingLoads{}; // Loads (from the disk or scaling) in progress
+	CacheKeys _notInDiskCache{}; // Logos (original size key) not found in the disk cache
+	std::uint64_t _generation{ 0u }; // Incremented each time the cache is cleared
+
+	DownloadScheduler _downloads{ MaxConcurrentDownloads };
 };
 
 EntityLogoCache& EntityLogoCache::getInstance() noexcept
@@ -18,6 +18,7 @@
 */
 
 #include "channelConnectionManager.hpp"
+#include "channelConnectionsCache.hpp"
 #include "helper.hpp"
 #include "hiveLogItems.hpp"
 
@@ -27,6 +28,7 @@
 
 #include <set>
 #include <algorithm>
+#include <limits>
 
 namespace avdecc
 {
@@ -36,6 +38,7 @@ private:
 	// Private members
 	std::set<la::avdecc::UniqueIdentifier> _entities{}; // No lock required, only read/write in the UI thread
 	std::map<la::avdecc::UniqueIdentifier, std::shared_ptr<SourceChannelConnections>> _listenerChannelMappings;
+	ChannelConnectionsCache<la::avdecc::UniqueIdentifier, ChannelIdentification, TargetConnectionInformations> _talkerChannelConnections{}; // Cached channel connections of talker channels
 
 public:
 	/**
@@ -47,8 +50,10 @@ public:
 		connect(&manager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &ChannelConnectionManagerImpl::onControllerOffline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &ChannelConnectionManagerImpl::onEntityOnline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &ChannelConnectionManagerImpl::onEntityOffline);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this, &ChannelConnectionManagerImpl::onEntitiesOnline);
 
 		connect(&manager, &hive::modelsLibrary::ControllerManager::streamInputConnectionChanged, this, &ChannelConnectionManagerImpl::onStreamInputConnectionChanged);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::streamOutputConnectionsChanged, this, &ChannelConnectionManagerImpl::onStreamOutputConnectionsChanged);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::streamPortAudioMappingsChanged, this, &ChannelConnectionManagerImpl::onStreamPortAudioMappingsChanged);
 	}
 
@@ -536,12 +541,28 @@ private:
 
 	/**
 	* Gets all connections of a given talker entity's audioCluster to listener side audioClusters.
+	* The result is cached until the mappings or stream connections of the talker or of one of its listeners change.
 	*
 	* @param sourceEntityId					The id of the talker entity to get connection information to listeners for.
 	* @param sourceChannelIdentification	The talker side channel information to get the connections to listeners for.
 	* @return The connection results stored in a struct.
 	*/
-	virtual std::shared_ptr<TargetConnectionInformations> getChannelConnections(la::avdecc::UniqueIdentifier const& sourceEntityId, ChannelIdentification const sourceChannelIdentification) const noexcept
+	virtual std::shared_ptr<TargetConnectionInformations const> getChannelConnections(la::avdecc::UniqueIdentifier const& sourceEntityId, ChannelIdentification const sourceChannelIdentification) noexcept
+	{
+		return _talkerChannelConnections.get(sourceEntityId, sourceChannelIdentification,
+			[this, &sourceEntityId, &sourceChannelIdentification]()
+			{
+				return determineChannelConnections(sourceEntityId, sourceChannelIdentification);
+			});
+	}
+
+	/**
+	* Gets all connections of an output channel, tracing from the talker mappings to the connected listeners mappings.
+	* @param sourceEntityId					The id of the talker entity.
+	* @param sourceChannelIdentification	The channel of the talker entity.
+	* @return The results stored in a struct.
+	*/
+	std::shared_ptr<TargetConnectionInformations> determineChannelConnections(la::avdecc::UniqueIdentifier const& sourceEntityId, ChannelIdentification const& sourceChannelIdentification) const noexcept
 	{
 		auto result = std::make_shared<TargetConnectionInformations>();
 		result->sourceClusterChannelInfo = sourceChannelIdentification;
@@ -798,7 +819,7 @@ private:
 		return result;
 	}
 
-	virtual std::shared_ptr<TargetConnectionInformations> getChannelConnectionsReverse(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification) noexcept
+	virtual std::shared_ptr<TargetConnectionInformations const> getChannelConnectionsReverse(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification) noexcept
 	{
 		bool entityAlreadyInMap = false;
 
@@ -2286,6 +2307,188 @@ private:
 		return result.connectionCheckResult;
 	}
 
+	/**
+	* Plans all the routes at once, on a snapshot of the entities of the routes and of the listeners already connected to their talkers.
+	* Only the primary (or non redundant) AAF streams and the dynamic mappings are part of the snapshot.
+	*/
+	virtual ChannelRoutingPlanner::Plan planChannelRoutes(std::vector<ChannelRoute> const& routes) const noexcept
+	{
+		auto planner = ChannelRoutingPlanner{};
+		auto snapshotEntities = std::set<la::avdecc::UniqueIdentifier>{};
+		auto const addToSnapshot = [this, &planner, &snapshotEntities](la::avdecc::UniqueIdentifier const& entityId)
+		{
+			if (snapshotEntities.insert(entityId).second)
+			{
+				if (auto entity = makeRoutingEntity(entityId))
+				{
+					planner.setEntity(entityId.getValue(), std::move(*entity));
+				}
+			}
+		};
+
+		auto plannerRoutes = std::vector<ChannelRoutingPlanner::Route>{};
+		plannerRoutes.reserve(routes.size());
+		auto talkers = std::set<la::avdecc::UniqueIdentifier>{};
+		for (auto const& route : routes)
+		{
+			addToSnapshot(route.talkerEntityId);
+			addToSnapshot(route.listenerEntityId);
+			talkers.insert(route.talkerEntityId);
+			plannerRoutes.push_back(ChannelRoutingPlanner::Route{ route.talkerEntityId.getValue(), toClusterChannel(route.talkerChannelIdentification), route.listenerEntityId.getValue(), toClusterChannel(route.listenerChannelIdentification) });
+		}
+
+		// listeners of the talkers streams may receive channels newly mapped on these streams, they have to be part of the snapshot
+		for (auto const& talkerEntityId : talkers)
+		{
+			for (auto const& [listenerStream, connectionInfo] : getAllStreamOutputConnections(talkerEntityId))
+			{
+				addToSnapshot(listenerStream.entityID);
+			}
+		}
+
+		return planner.plan(plannerRoutes);
+	}
+
+	/**
+	* Executes a channel routing plan.
+	* The commands are grouped in the same stages than createChannelConnections, but each command is scoped to the entities it touches,
+	* so the stages of different entities are executed in parallel.
+	*/
+	virtual void executeChannelRoutingPlan(ChannelRoutingPlanner::Plan const& plan) noexcept
+	{
+		auto* commandSetTempDisconnectStreams = new commandChain::AsyncParallelCommandSet{};
+		auto* commandSetRemoveMappings = new commandChain::AsyncParallelCommandSet{};
+		auto* commandSetCreateMappings = new commandChain::AsyncParallelCommandSet{};
+		auto* commandSetChangeStreamFormat = new commandChain::AsyncParallelCommandSet{};
+		auto* commandSetCreateStreamConnections = new commandChain::AsyncParallelCommandSet{};
+		auto* commandSetReconnectStreams = new commandChain::AsyncParallelCommandSet{};
+
+		// stop the connections of the talker streams getting new mappings (including their redundant streams), and restart them at the end
+		auto talkerStreams = std::set<ChannelRoutingPlanner::StreamIdentification>{};
+		for (auto const& connection : plan.streamsToReconnect)
+		{
+			talkerStreams.insert(connection.talkerStream);
+		}
+		for (auto const& talkerStream : talkerStreams)
+		{
+			auto const talkerEntityId = la::avdecc::UniqueIdentifier{ talkerStream.entityID };
+			auto talkerStreamIndexes = std::vector<la::avdecc::entity::model::StreamIndex>{};
+			for (auto const& [streamIndex, streamNode] : getRedundantStreamOutputsForPrimary(talkerEntityId, talkerStream.streamIndex))
+			{
+				talkerStreamIndexes.push_back(streamIndex);
+			}
+			if (talkerStreamIndexes.empty())
+			{
+				talkerStreamIndexes.push_back(talkerStream.streamIndex);
+			}
+
+			for (auto const talkerStreamIndex : talkerStreamIndexes)
+			{
+				for (auto const& [listenerStream, connectionInfo] : getAllStreamOutputConnections(talkerEntityId, talkerStreamIndex))
+				{
+					auto const scope = commandChain::AsyncParallelCommandSet::CommandScope{ listenerStream.entityID, connectionInfo.talkerStream.entityID };
+					commandSetTempDisconnectStreams->append(makeStreamConnectionCommand(connectionInfo.talkerStream, listenerStream, false), scope);
+					commandSetReconnectStreams->append(makeStreamConnectionCommand(connectionInfo.talkerStream, listenerStream, true), scope);
+				}
+			}
+		}
+
+		// mappings changes, a single command per stream port
+		for (auto const& change : plan.mappingsToRemove)
+		{
+			commandSetRemoveMappings->append(makeAudioMappingsCommand(change, false), commandChain::AsyncParallelCommandSet::CommandScope{ la::avdecc::UniqueIdentifier{ change.entityID } });
+		}
+		for (auto const& change : plan.mappingsToAdd)
+		{
+			commandSetCreateMappings->append(makeAudioMappingsCommand(change, true), commandChain::AsyncParallelCommandSet::CommandScope{ la::avdecc::UniqueIdentifier{ change.entityID } });
+		}
+
+		// stream formats with enough channels
+		for (auto const& change : plan.streamFormatChanges)
+		{
+			auto const entityId = la::avdecc::UniqueIdentifier{ change.entityID };
+			if (auto const streamFormat = findStreamFormat(entityId, change.isInput, change.streamIndex, change.channelsCount))
+			{
+				commandSetChangeStreamFormat->append(
+					[entityId, isInput = change.isInput, streamIndex = change.streamIndex, streamFormat = *streamFormat](commandChain::AsyncParallelCommandSet* const parentCommandSet, std::uint32_t const commandIndex) -> bool
+					{
+						auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+						auto responseHandler = [parentCommandSet, commandIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+						{
+							// notify SequentialAsyncCommandExecuter that the command completed.
+							auto error = commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+							if (error != commandChain::CommandExecutionError::NoError)
+							{
+								parentCommandSet->addErrorInfo(entityID, error, hive::modelsLibrary::ControllerManager::AecpCommandType::SetStreamFormat);
+							}
+							parentCommandSet->invokeCommandCompleted(commandIndex, error != commandChain::CommandExecutionError::NoError);
+						};
+						if (isInput)
+						{
+							manager.setStreamInputFormat(entityId, streamIndex, streamFormat, nullptr, responseHandler);
+						}
+						else
+						{
+							manager.setStreamOutputFormat(entityId, streamIndex, streamFormat, nullptr, responseHandler);
+						}
+						return true;
+					},
+					commandChain::AsyncParallelCommandSet::CommandScope{ entityId });
+			}
+			else
+			{
+				// the entity changed since the plan was made, report the stream format change as failed
+				commandSetChangeStreamFormat->append(
+					[entityId](commandChain::AsyncParallelCommandSet* const parentCommandSet, std::uint32_t const commandIndex) -> bool
+					{
+						parentCommandSet->addErrorInfo(entityId, commandChain::CommandExecutionError::NotSupported, hive::modelsLibrary::ControllerManager::AecpCommandType::SetStreamFormat);
+						parentCommandSet->invokeCommandCompleted(commandIndex, true);
+						return true;
+					},
+					commandChain::AsyncParallelCommandSet::CommandScope{ entityId });
+			}
+		}
+
+		// new stream connections, connecting the redundant stream pairs as well
+		for (auto const& connection : plan.streamsToConnect)
+		{
+			auto const talkerEntityId = la::avdecc::UniqueIdentifier{ connection.talkerStream.entityID };
+			auto const listenerEntityId = la::avdecc::UniqueIdentifier{ connection.listenerStream.entityID };
+			auto const scope = commandChain::AsyncParallelCommandSet::CommandScope{ listenerEntityId, talkerEntityId };
+			auto const& redundantOutputStreams = getRedundantStreamOutputsForPrimary(talkerEntityId, connection.talkerStream.streamIndex);
+			auto const& redundantInputStreams = getRedundantStreamInputsForPrimary(listenerEntityId, connection.listenerStream.streamIndex);
+			if (redundantOutputStreams.empty() || redundantInputStreams.empty())
+			{
+				commandSetCreateStreamConnections->append(makeStreamConnectionCommand({ talkerEntityId, connection.talkerStream.streamIndex }, { listenerEntityId, connection.listenerStream.streamIndex }, true), scope);
+				continue;
+			}
+			auto redundantOutputStreamsIterator = redundantOutputStreams.begin();
+			auto redundantInputStreamsIterator = redundantInputStreams.begin();
+			while (redundantOutputStreamsIterator != redundantOutputStreams.end() && redundantInputStreamsIterator != redundantInputStreams.end())
+			{
+				commandSetCreateStreamConnections->append(makeStreamConnectionCommand({ talkerEntityId, redundantOutputStreamsIterator->first }, { listenerEntityId, redundantInputStreamsIterator->first }, true), scope);
+				redundantOutputStreamsIterator++;
+				redundantInputStreamsIterator++;
+			}
+		}
+
+		// create chain
+		auto commands = std::vector<commandChain::AsyncParallelCommandSet*>{ commandSetTempDisconnectStreams, commandSetRemoveMappings, commandSetCreateMappings, commandSetChangeStreamFormat, commandSetCreateStreamConnections, commandSetReconnectStreams };
+
+		// execute the command chain
+		auto* sequentialAcmpCommandExecuter = new commandChain::SequentialAsyncCommandExecuter(this);
+		connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, this,
+			[this](commandChain::CommandExecutionErrors const errors)
+			{
+				CreateConnectionsInfo info;
+				info.connectionCreationErrors = errors;
+				emit createChannelConnectionsFinished(info);
+			});
+		connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::deleteLater);
+		sequentialAcmpCommandExecuter->setCommandChain(commands);
+		sequentialAcmpCommandExecuter->start();
+	}
+
 	/**
 	* Removes a channel connection if it exists.
 	*
@@ -3033,6 +3236,267 @@ private:
 		return result;
 	}
 
+	/**
+	* Converts a channel identification to a cluster channel relative to its stream port, as used in the audio mappings.
+	*/
+	static ChannelRoutingPlanner::ClusterChannel toClusterChannel(ChannelIdentification const& channelIdentification) noexcept
+	{
+		auto const streamPortIndex = channelIdentification.streamPortIndex.value_or(0u);
+		auto const clusterOffset = static_cast<ChannelRoutingPlanner::ClusterOffset>(channelIdentification.clusterIndex - channelIdentification.baseCluster.value_or(0u));
+		return ChannelRoutingPlanner::ClusterChannel{ streamPortIndex, clusterOffset, channelIdentification.clusterChannel };
+	}
+
+	/**
+	* Creates the snapshot of an entity used by the ChannelRoutingPlanner.
+	*/
+	std::optional<ChannelRoutingPlanner::Entity> makeRoutingEntity(la::avdecc::UniqueIdentifier const& entityId) const noexcept
+	{
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) || !controlledEntity->hasAnyConfiguration())
+		{
+			return std::nullopt;
+		}
+
+		try
+		{
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+			auto entity = ChannelRoutingPlanner::Entity{};
+
+			for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+			{
+				if (supportsStreamFormat(streamOutputNode.staticModel.formats, la::avdecc::entity::model::StreamFormatInfo::Type::AAF) && isOutputStreamPrimaryOrNonRedundant(la::avdecc::entity::model::StreamIdentification{ entityId, streamIndex }))
+				{
+					auto& stream = entity.streamOutputs[streamIndex];
+					stream.channelsCount = la::avdecc::entity::model::StreamFormatInfo::create(streamOutputNode.dynamicModel.streamFormat)->getChannelsCount();
+					stream.maxChannelsCount = getMaxChannelsCount(streamOutputNode.staticModel.formats, streamOutputNode.dynamicModel.streamFormat);
+				}
+			}
+
+			for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+			{
+				if (supportsStreamFormat(streamInputNode.staticModel.formats, la::avdecc::entity::model::StreamFormatInfo::Type::AAF) && isInputStreamPrimaryOrNonRedundant(la::avdecc::entity::model::StreamIdentification{ entityId, streamIndex }))
+				{
+					auto& stream = entity.streamInputs[streamIndex];
+					stream.channelsCount = la::avdecc::entity::model::StreamFormatInfo::create(streamInputNode.dynamicModel.streamFormat)->getChannelsCount();
+					stream.maxChannelsCount = getMaxChannelsCount(streamInputNode.staticModel.formats, streamInputNode.dynamicModel.streamFormat);
+					auto const& connectionInfo = streamInputNode.dynamicModel.connectionInfo;
+					if (connectionInfo.state != la::avdecc::entity::model::StreamInputConnectionInfo::State::NotConnected)
+					{
+						stream.talkerStream = ChannelRoutingPlanner::StreamIdentification{ connectionInfo.talkerStream.entityID.getValue(), connectionInfo.talkerStream.streamIndex };
+					}
+				}
+			}
+
+			auto const toPlannerMappings = [](la::avdecc::entity::model::AudioMappings const& audioMappings)
+			{
+				auto mappings = ChannelRoutingPlanner::Mappings{};
+				for (auto const& mapping : audioMappings)
+				{
+					mappings.push_back(ChannelRoutingPlanner::Mapping{ mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel });
+				}
+				return mappings;
+			};
+			for (auto const& [audioUnitIndex, audioUnitNode] : configurationNode.audioUnits)
+			{
+				for (auto const& [streamPortIndex, streamPortNode] : audioUnitNode.streamPortOutputs)
+				{
+					entity.streamPortOutputMappings[streamPortIndex] = toPlannerMappings(streamPortNode.dynamicModel.dynamicAudioMap);
+				}
+				for (auto const& [streamPortIndex, streamPortNode] : audioUnitNode.streamPortInputs)
+				{
+					entity.streamPortInputMappings[streamPortIndex] = toPlannerMappings(streamPortNode.dynamicModel.dynamicAudioMap);
+				}
+			}
+
+			return entity;
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+			return std::nullopt;
+		}
+	}
+
+	/**
+	* Gets the highest number of channels of the AAF stream formats with the sampling rate of the current stream format (the ones findStreamFormat can switch to).
+	*/
+	std::uint16_t getMaxChannelsCount(la::avdecc::entity::model::StreamFormats const& streamFormats, la::avdecc::entity::model::StreamFormat const currentStreamFormat) const noexcept
+	{
+		auto const samplingRate = la::avdecc::entity::model::StreamFormatInfo::create(currentStreamFormat)->getSamplingRate();
+		auto maxChannelsCount = std::uint16_t{ 0u };
+		for (auto const& streamFormat : streamFormats)
+		{
+			auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+			if (streamFormatInfo->getType() == la::avdecc::entity::model::StreamFormatInfo::Type::AAF && streamFormatInfo->getSamplingRate() == samplingRate)
+			{
+				maxChannelsCount = std::max(maxChannelsCount, streamFormatInfo->getChannelsCount());
+			}
+		}
+		return maxChannelsCount;
+	}
+
+	/**
+	* Finds the AAF stream format with the fewest channels (at least channelsCount), keeping the sampling rate of the current stream format.
+	*/
+	std::optional<la::avdecc::entity::model::StreamFormat> findStreamFormat(la::avdecc::UniqueIdentifier const& entityId, bool const isInput, la::avdecc::entity::model::StreamIndex const streamIndex, std::uint16_t const channelsCount) const noexcept
+	{
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) || !controlledEntity->hasAnyConfiguration())
+		{
+			return std::nullopt;
+		}
+
+		auto currentStreamFormat = la::avdecc::entity::model::StreamFormat{};
+		auto streamFormats = la::avdecc::entity::model::StreamFormats{};
+		try
+		{
+			auto const configurationIndex = controlledEntity->getCurrentConfigurationNode().descriptorIndex;
+			if (isInput)
+			{
+				auto const& streamNode = controlledEntity->getStreamInputNode(configurationIndex, streamIndex);
+				currentStreamFormat = streamNode.dynamicModel.streamFormat;
+				streamFormats = streamNode.staticModel.formats;
+			}
+			else
+			{
+				auto const& streamNode = controlledEntity->getStreamOutputNode(configurationIndex, streamIndex);
+				currentStreamFormat = streamNode.dynamicModel.streamFormat;
+				streamFormats = streamNode.staticModel.formats;
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+			return std::nullopt;
+		}
+
+		auto const samplingRate = la::avdecc::entity::model::StreamFormatInfo::create(currentStreamFormat)->getSamplingRate();
+		auto result = std::optional<la::avdecc::entity::model::StreamFormat>{ std::nullopt };
+		auto resultChannelsCount = std::numeric_limits<std::uint16_t>::max();
+		for (auto const& streamFormat : streamFormats)
+		{
+			auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+			auto const streamFormatChannelsCount = streamFormatInfo->getChannelsCount();
+			if (streamFormatInfo->getType() != la::avdecc::entity::model::StreamFormatInfo::Type::AAF || streamFormatInfo->getSamplingRate() != samplingRate || streamFormatChannelsCount < channelsCount)
+			{
+				continue;
+			}
+			if (streamFormatInfo->isUpToChannelsCount())
+			{
+				// exactly the requested number of channels
+				return streamFormatInfo->getAdaptedStreamFormat(channelsCount);
+			}
+			if (streamFormatChannelsCount < resultChannelsCount)
+			{
+				result = streamFormat;
+				resultChannelsCount = streamFormatChannelsCount;
+			}
+		}
+		return result;
+	}
+
+	/**
+	* Creates the command connecting (or disconnecting) a stream, to be used in a command chain.
+	*/
+	static commandChain::AsyncParallelCommandSet::AsyncCommand makeStreamConnectionCommand(la::avdecc::entity::model::StreamIdentification const& talkerStream, la::avdecc::entity::model::StreamIdentification const& listenerStream, bool const isConnect) noexcept
+	{
+		return [talkerStream, listenerStream, isConnect](commandChain::AsyncParallelCommandSet* const parentCommandSet, std::uint32_t const commandIndex) -> bool
+		{
+			auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+			auto const commandType = isConnect ? hive::modelsLibrary::ControllerManager::AcmpCommandType::ConnectStream : hive::modelsLibrary::ControllerManager::AcmpCommandType::DisconnectStream;
+			auto responseHandler = [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const /*listenerStreamIndex*/, la::avdecc::entity::ControllerEntity::ControlStatus const status)
+			{
+				// notify SequentialAsyncCommandExecuter that the command completed.
+				auto error = commandChain::AsyncParallelCommandSet::controlStatusToCommandError(status);
+				if (error != commandChain::CommandExecutionError::NoError)
+				{
+					switch (status)
+					{
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerMisbehaving:
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerUnknownID:
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerDestMacFail:
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerNoBandwidth:
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerNoStreamIndex:
+						case la::avdecc::entity::LocalEntity::ControlStatus::TalkerExclusive:
+							parentCommandSet->addErrorInfo(talkerEntityID, error, commandType);
+							break;
+						case la::avdecc::entity::LocalEntity::ControlStatus::ListenerMisbehaving:
+						case la::avdecc::entity::LocalEntity::ControlStatus::ListenerUnknownID:
+						case la::avdecc::entity::LocalEntity::ControlStatus::ListenerExclusive:
+							parentCommandSet->addErrorInfo(listenerEntityID, error, commandType);
+							break;
+						default:
+							parentCommandSet->addErrorInfo(talkerEntityID, error, commandType);
+							parentCommandSet->addErrorInfo(listenerEntityID, error, commandType);
+							break;
+					}
+				}
+				parentCommandSet->invokeCommandCompleted(commandIndex, error != commandChain::CommandExecutionError::NoError);
+			};
+			if (isConnect)
+			{
+				manager.connectStream(talkerStream.entityID, talkerStream.streamIndex, listenerStream.entityID, listenerStream.streamIndex, responseHandler);
+			}
+			else
+			{
+				manager.disconnectStream(talkerStream.entityID, talkerStream.streamIndex, listenerStream.entityID, listenerStream.streamIndex, responseHandler);
+			}
+			return true;
+		};
+	}
+
+	/**
+	* Creates the command adding (or removing) all the mappings of a stream port at once, to be used in a command chain.
+	*/
+	static commandChain::AsyncParallelCommandSet::AsyncCommand makeAudioMappingsCommand(ChannelRoutingPlanner::MappingsChange const& change, bool const isAdd) noexcept
+	{
+		auto const entityId = la::avdecc::UniqueIdentifier{ change.entityID };
+		auto mappings = la::avdecc::entity::model::AudioMappings{};
+		for (auto const& mapping : change.mappings)
+		{
+			mappings.push_back(la::avdecc::entity::model::AudioMapping{ mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel });
+		}
+
+		return [entityId, isInput = change.isInput, streamPortIndex = change.streamPortIndex, mappings = std::move(mappings), isAdd](commandChain::AsyncParallelCommandSet* const parentCommandSet, std::uint32_t const commandIndex) -> bool
+		{
+			auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+			auto const commandType = isAdd ? hive::modelsLibrary::ControllerManager::AecpCommandType::AddStreamPortAudioMappings : hive::modelsLibrary::ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings;
+			auto responseHandler = [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+			{
+				// notify SequentialAsyncCommandExecuter that the command completed.
+				auto error = commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+				if (error != commandChain::CommandExecutionError::NoError)
+				{
+					parentCommandSet->addErrorInfo(entityID, error, commandType);
+				}
+				parentCommandSet->invokeCommandCompleted(commandIndex, error != commandChain::CommandExecutionError::NoError);
+			};
+			if (isInput)
+			{
+				if (isAdd)
+				{
+					manager.addStreamPortInputAudioMappings(entityId, streamPortIndex, mappings, nullptr, responseHandler);
+				}
+				else
+				{
+					manager.removeStreamPortInputAudioMappings(entityId, streamPortIndex, mappings, nullptr, responseHandler);
+				}
+			}
+			else
+			{
+				if (isAdd)
+				{
+					manager.addStreamPortOutputAudioMappings(entityId, streamPortIndex, mappings, nullptr, responseHandler);
+				}
+				else
+				{
+					manager.removeStreamPortOutputAudioMappings(entityId, streamPortIndex, mappings, nullptr, responseHandler);
+				}
+			}
+			return true;
+		};
+	}
+
 	/**
 	* Checks if the given list of stream formats contains a format with the given type.
 	*/
@@ -3377,6 +3841,38 @@ private:
 		return sfi->getChannelsCount();
 	}
 
+	/**
+	* Gets the talkers the stream inputs of a listener are currently connected to.
+	* @param listenerEntityId	The id of the listener entity.
+	*/
+	std::set<la::avdecc::UniqueIdentifier> getConnectedTalkers(la::avdecc::UniqueIdentifier const& listenerEntityId) const noexcept
+	{
+		auto talkers = std::set<la::avdecc::UniqueIdentifier>{};
+
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		if (auto const controlledEntity = manager.getControlledEntity(listenerEntityId))
+		{
+			if (controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) && controlledEntity->hasAnyConfiguration())
+			{
+				try
+				{
+					for (auto const& [streamIndex, streamInputNode] : controlledEntity->getCurrentConfigurationNode().streamInputs)
+					{
+						auto const& connectionInfo = streamInputNode.dynamicModel.connectionInfo;
+						if (connectionInfo.state != la::avdecc::entity::model::StreamInputConnectionInfo::State::NotConnected)
+						{
+							talkers.insert(connectionInfo.talkerStream.entityID);
+						}
+					}
+				}
+				catch (la::avdecc::controller::ControlledEntity::Exception const&)
+				{
+				}
+			}
+		}
+
+		return talkers;
+	}
 
 	// Slots
 	/**
@@ -3385,6 +3881,7 @@ private:
 	void onControllerOffline()
 	{
 		_entities.clear();
+		_talkerChannelConnections.clear();
 	}
 
 	/**
@@ -3394,6 +3891,20 @@ private:
 	{
 		// add entity to the set
 		_entities.insert(entityId);
+		// the talkers it is connected to have new channel connections
+		_talkerChannelConnections.invalidateEntity(entityId, getConnectedTalkers(entityId));
+	}
+
+	/**
+	* Adds a batch of entities to the internal list.
+	*/
+	void onEntitiesOnline(std::vector<la::avdecc::UniqueIdentifier> const& entityIds)
+	{
+		_entities.insert(entityIds.begin(), entityIds.end());
+		for (auto const& entityId : entityIds)
+		{
+			_talkerChannelConnections.invalidateEntity(entityId, getConnectedTalkers(entityId));
+		}
 	}
 
 	/**
@@ -3403,8 +3914,9 @@ private:
 	{
 		// remove entity from the set
 		_entities.erase(entityId);
-		// also remove the cached connections for this entity
+		// also remove the cached connections for this entity, and the ones targeting it
 		_listenerChannelMappings.erase(entityId);
+		_talkerChannelConnections.invalidateEntity(entityId);
 	}
 
 	/**
@@ -3412,6 +3924,10 @@ private:
 	*/
 	void onStreamInputConnectionChanged(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const& info)
 	{
+		// the channel connections of the previous and new talkers of the stream changed
+		_talkerChannelConnections.invalidateListener(stream.entityID, getConnectedTalkers(stream.entityID));
+		_talkerChannelConnections.invalidateTalker(info.talkerStream.entityID);
+
 		auto listenerChannelMappingIt = _listenerChannelMappings.find(stream.entityID);
 
 		if (listenerChannelMappingIt != _listenerChannelMappings.end())
@@ -3575,6 +4091,14 @@ private:
 		}
 	}
 
+	/**
+	* Invalidates the cached talker channel connections (the listener side is handled by onStreamInputConnectionChanged).
+	*/
+	void onStreamOutputConnectionsChanged(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& /*connections*/)
+	{
+		_talkerChannelConnections.invalidateTalker(stream.entityID);
+	}
+
 	/**
 	* Update the cached connection info if it's already in the map.
 	*/
@@ -3585,6 +4109,8 @@ private:
 
 		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
 		{
+			_talkerChannelConnections.invalidateListener(entityId, getConnectedTalkers(entityId));
+
 			if (_listenerChannelMappings.find(entityId) != _listenerChannelMappings.end())
 			{
 				auto const& listenerMappings = _listenerChannelMappings.at(entityId)->channelMappings;
@@ -3601,6 +4127,8 @@ private:
 		}
 		else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
 		{
+			_talkerChannelConnections.invalidateTalkerStreamPort(entityId, streamPortIndex);
+
 			try
 			{
 				auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
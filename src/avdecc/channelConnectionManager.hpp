@@ -26,6 +26,7 @@
 #include <QObject>
 
 #include "mcDomainManager.hpp"
+#include "channelRoutingPlanner.hpp"
 
 namespace avdecc
 {
@@ -108,7 +109,7 @@ struct TargetConnectionInformation
 	bool isTargetRedundant{ false }; // could be removed and only use virtual index != nullopt instead.
 	bool isSourceRedundant{ false };
 
-	inline bool isEqualTo(TargetConnectionInformation const& other)
+	inline bool isEqualTo(TargetConnectionInformation const& other) const
 	{
 		if (isSourceRedundant == other.isSourceRedundant && isTargetRedundant == other.isTargetRedundant && sourceStreamIndex == other.sourceStreamIndex && streamChannel == other.streamChannel && targetAudioUnitIndex == other.targetAudioUnitIndex && targetBaseCluster == other.targetBaseCluster && targetEntityId == other.targetEntityId && targetStreamIndex == other.targetStreamIndex && targetStreamPortIndex == other.targetStreamPortIndex && targetClusterChannels == other.targetClusterChannels)
 		{
@@ -122,9 +123,9 @@ struct TargetConnectionInformations
 {
 	la::avdecc::UniqueIdentifier sourceEntityId{ la::avdecc::UniqueIdentifier::getUninitializedUniqueIdentifier() };
 	std::optional<avdecc::ChannelIdentification> sourceClusterChannelInfo{ std::nullopt };
-	std::vector<std::shared_ptr<TargetConnectionInformation>> targets;
+	std::vector<std::shared_ptr<TargetConnectionInformation const>> targets;
 
-	inline bool isEqualTo(TargetConnectionInformations const& other)
+	inline bool isEqualTo(TargetConnectionInformations const& other) const
 	{
 		if (sourceEntityId == other.sourceEntityId && sourceClusterChannelInfo == other.sourceClusterChannelInfo && targets.size() == other.targets.size())
 		{
@@ -148,7 +149,7 @@ struct TargetConnectionInformations
 
 struct SourceChannelConnections
 {
-	std::map<ChannelIdentification, std::shared_ptr<TargetConnectionInformations>> channelMappings;
+	std::map<ChannelIdentification, std::shared_ptr<TargetConnectionInformations const>> channelMappings;
 };
 
 struct CreateConnectionsInfo
@@ -156,6 +157,14 @@ struct CreateConnectionsInfo
 	commandChain::CommandExecutionErrors connectionCreationErrors;
 };
 
+struct ChannelRoute
+{
+	la::avdecc::UniqueIdentifier talkerEntityId;
+	ChannelIdentification talkerChannelIdentification;
+	la::avdecc::UniqueIdentifier listenerEntityId;
+	ChannelIdentification listenerChannelIdentification;
+};
+
 // **************************************************************
 // class ChannelConnectionManager
 // **************************************************************
@@ -192,9 +201,10 @@ public:
 	/* channel connection management helper functions */
 	virtual std::shared_ptr<TargetConnectionInformations> getAllChannelConnectionsBetweenDevices(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::UniqueIdentifier const& targetEntityId) const noexcept = 0;
 
-	virtual std::shared_ptr<TargetConnectionInformations> getChannelConnections(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const sourceChannelIdentification) const noexcept = 0;
+	/* Channel connections are cached and kept up-to-date when mappings and stream connections change, the same immutable object is returned as long as the connections of the channel did not change */
+	virtual std::shared_ptr<TargetConnectionInformations const> getChannelConnections(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const sourceChannelIdentification) noexcept = 0;
 
-	virtual std::shared_ptr<TargetConnectionInformations> getChannelConnectionsReverse(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification) noexcept = 0;
+	virtual std::shared_ptr<TargetConnectionInformations const> getChannelConnectionsReverse(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification) noexcept = 0;
 
 	virtual std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> getRedundantStreamOutputsForPrimary(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::StreamIndex const primaryStreamIndex) const noexcept = 0;
 
@@ -204,6 +214,12 @@ public:
 
 	virtual ChannelConnectResult createChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges = false, bool const allowRemovalOfUnusedAudioMappings = false) noexcept = 0;
 
+	/* Plans the stream connections, stream format changes and audio mappings needed for all the routes at once, without sending any command (dry-run) */
+	virtual ChannelRoutingPlanner::Plan planChannelRoutes(std::vector<ChannelRoute> const& routes) const noexcept = 0;
+
+	/* Executes a plan returned by planChannelRoutes, commands of different entities are executed in parallel. createChannelConnectionsFinished is emitted once completed */
+	virtual void executeChannelRoutingPlan(ChannelRoutingPlanner::Plan const& plan) noexcept = 0;
+
 	virtual ChannelDisconnectResult removeChannelConnection(
 		la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::entity::model::AudioUnitIndex const talkerAudioUnitIndex, la::avdecc::entity::model::StreamPortIndex const talkerStreamPortIndex, la::avdecc::entity::model::ClusterIndex const talkerClusterIndex, la::avdecc::entity::model::ClusterIndex const talkerBaseCluster, std::uint16_t const talkerClusterChannel, la::avdecc::UniqueIdentifier const& listenerEntityId, la::avdecc::entity::model::AudioUnitIndex const listenerAudioUnitIndex, la::avdecc::entity::model::StreamPortIndex const listenerStreamPortIndex, la::avdecc::entity::model::ClusterIndex const listenerClusterIndex, la::avdecc::entity::model::ClusterIndex const listenerBaseCluster, std::uint16_t const listenerClusterChannel) noexcept = 0;
 
@@ -214,7 +230,7 @@ public:
 	// SIGNALS:
 	Q_SIGNAL void listenerChannelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>> const& channels);
 
-	/* Invoked after createChannelConnection or createChannelConnections are completed */
+	/* Invoked after createChannelConnection, createChannelConnections or executeChannelRoutingPlan are completed */
 	Q_SIGNAL void createChannelConnectionsFinished(CreateConnectionsInfo const& info);
 };
 
@@ -0,0 +1,145 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+
+namespace avdecc
+{
+/**
+ * @Brief Cache of the channel connections of talker channels
+ * @Details A result is determined on first request and kept until the topology it depends on changes: the mappings and stream connections of its talker,
+ *          and the mappings and stream connections of the listeners it targets or that are connected to its talker.
+ *          Results are indexed by the listeners they target, so a listener change only invalidates the talkers concerned.
+ *          Connections must have a 'targets' container of pointers to objects with a 'targetEntityId', and Channel an optional 'streamPortIndex'. Not thread safe.
+ */
+template<typename EntityID, typename Channel, typename Connections>
+class ChannelConnectionsCache final
+{
+public:
+	using ConnectionsPointer = std::shared_ptr<Connections const>;
+
+	ChannelConnectionsCache() noexcept = default;
+
+	/**
+	 * @brief Returns the cached connections of a talker channel, determining them if needed
+	 * @param[in] determine Called as std::shared_ptr<Connections const>() to determine the connections.
+	 */
+	template<typename Determine>
+	ConnectionsPointer get(EntityID const& talkerEntityId, Channel const& channel, Determine&& determine)
+	{
+		auto& connections = _talkerChannelConnections[talkerEntityId][channel];
+		if (!connections)
+		{
+			connections = determine();
+			for (auto const& target : connections->targets)
+			{
+				_talkersByListener[target->targetEntityId].insert(talkerEntityId);
+			}
+		}
+		return connections;
+	}
+
+	/** Returns true if the connections of a talker channel are cached */
+	bool isCached(EntityID const& talkerEntityId, Channel const& channel) const noexcept
+	{
+		auto const talkerIt = _talkerChannelConnections.find(talkerEntityId);
+		return talkerIt != _talkerChannelConnections.end() && talkerIt->second.count(channel) != 0;
+	}
+
+	/** Removes all the cached connections */
+	void clear() noexcept
+	{
+		_talkerChannelConnections.clear();
+		_talkersByListener.clear();
+	}
+
+	/** Removes the cached connections of a talker (its stream connections changed) */
+	void invalidateTalker(EntityID const& talkerEntityId) noexcept
+	{
+		_talkerChannelConnections.erase(talkerEntityId);
+	}
+
+	/** Removes the cached connections of the channels of a talker stream port output (its mappings changed) */
+	template<typename StreamPortIndex>
+	void invalidateTalkerStreamPort(EntityID const& talkerEntityId, StreamPortIndex const& streamPortIndex) noexcept
+	{
+		auto const talkerIt = _talkerChannelConnections.find(talkerEntityId);
+		if (talkerIt == _talkerChannelConnections.end())
+		{
+			return;
+		}
+
+		auto& channelConnections = talkerIt->second;
+		for (auto it = channelConnections.begin(); it != channelConnections.end();)
+		{
+			if (it->first.streamPortIndex == streamPortIndex)
+			{
+				it = channelConnections.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	/**
+	 * @brief Removes the cached connections of all the talkers which channels are (or may become) connected to a listener (its mappings or stream connections changed, or it went online or offline)
+	 * @param[in] connectedTalkers The talkers the stream inputs of the listener are currently connected to (new channel connections may appear).
+	 */
+	void invalidateListener(EntityID const& listenerEntityId, std::set<EntityID> const& connectedTalkers) noexcept
+	{
+		auto talkers = connectedTalkers;
+
+		if (auto const talkersIt = _talkersByListener.find(listenerEntityId); talkersIt != _talkersByListener.end())
+		{
+			talkers.merge(talkersIt->second);
+			_talkersByListener.erase(talkersIt);
+		}
+
+		for (auto const& talkerEntityId : talkers)
+		{
+			invalidateTalker(talkerEntityId);
+		}
+	}
+
+	/** Removes the cached connections of an entity going online or offline, as a talker and as a listener */
+	void invalidateEntity(EntityID const& entityId, std::set<EntityID> const& connectedTalkers = {}) noexcept
+	{
+		invalidateTalker(entityId);
+		invalidateListener(entityId, connectedTalkers);
+	}
+
+	// Deleted compiler auto-generated methods
+	ChannelConnectionsCache(ChannelConnectionsCache const&) = delete;
+	ChannelConnectionsCache(ChannelConnectionsCache&&) = delete;
+	ChannelConnectionsCache& operator=(ChannelConnectionsCache const&) = delete;
+	ChannelConnectionsCache& operator=(ChannelConnectionsCache&&) = delete;
+
+private:
+	std::map<EntityID, std::map<Channel, ConnectionsPointer>> _talkerChannelConnections{};
+	std::map<EntityID, std::set<EntityID>> _talkersByListener{}; // Talkers which cached connections target a listener
+};
+
+} // namespace avdecc
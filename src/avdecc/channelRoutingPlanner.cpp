@@ -0,0 +1,633 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "channelRoutingPlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace avdecc
+{
+namespace
+{
+using Planner = ChannelRoutingPlanner;
+using EntityID = Planner::EntityID;
+using StreamIndex = Planner::StreamIndex;
+using StreamPortIndex = Planner::StreamPortIndex;
+using Channel = Planner::Channel;
+using ClusterChannel = Planner::ClusterChannel;
+using Mapping = Planner::Mapping;
+using Mappings = Planner::Mappings;
+using StreamIdentification = Planner::StreamIdentification;
+using StreamConnection = Planner::StreamConnection;
+using Entity = Planner::Entity;
+using Route = Planner::Route;
+using Network = std::map<EntityID, Entity>;
+using MappingsKey = std::tuple<EntityID, bool, StreamPortIndex>; // Entity, isInput, stream port
+
+Entity const* findEntity(Network const& network, EntityID const entityID) noexcept
+{
+	auto const it = network.find(entityID);
+	if (it == network.end())
+	{
+		return nullptr;
+	}
+	return &it->second;
+}
+
+std::map<StreamPortIndex, Mappings> const& getStreamPortMappings(Entity const& entity, bool const isInput) noexcept
+{
+	return isInput ? entity.streamPortInputMappings : entity.streamPortOutputMappings;
+}
+
+/** Mappings of the cluster channel */
+Mappings findMappings(Entity const& entity, bool const isInput, ClusterChannel const& channel) noexcept
+{
+	auto result = Mappings{};
+	auto const& streamPortMappings = getStreamPortMappings(entity, isInput);
+	if (auto const it = streamPortMappings.find(channel.streamPortIndex); it != streamPortMappings.end())
+	{
+		for (auto const& mapping : it->second)
+		{
+			if (mapping.clusterOffset == channel.clusterOffset && mapping.clusterChannel == channel.clusterChannel)
+			{
+				result.push_back(mapping);
+			}
+		}
+	}
+	return result;
+}
+
+/** Number of mappings of each channel of a stream */
+std::vector<std::size_t> getStreamChannelsUsage(Entity const& entity, bool const isInput, StreamIndex const streamIndex, Channel const channelsCount) noexcept
+{
+	auto usage = std::vector<std::size_t>(channelsCount, 0u);
+	for (auto const& [streamPortIndex, mappings] : getStreamPortMappings(entity, isInput))
+	{
+		for (auto const& mapping : mappings)
+		{
+			if (mapping.streamIndex == streamIndex && mapping.streamChannel < channelsCount)
+			{
+				++usage[mapping.streamChannel];
+			}
+		}
+	}
+	return usage;
+}
+
+Channel getMaxChannelsCount(Entity const& talker, StreamIndex const streamIndex) noexcept
+{
+	if (auto const it = talker.streamOutputs.find(streamIndex); it != talker.streamOutputs.end())
+	{
+		return it->second.maxChannelsCount;
+	}
+	return 0u;
+}
+
+/** Highest mapped channel (plus one) of a stream */
+Channel getStreamChannelsUsed(Entity const& entity, bool const isInput, StreamIndex const streamIndex) noexcept
+{
+	auto used = Channel{ 0u };
+	for (auto const& [streamPortIndex, mappings] : getStreamPortMappings(entity, isInput))
+	{
+		for (auto const& mapping : mappings)
+		{
+			if (mapping.streamIndex == streamIndex)
+			{
+				used = std::max(used, static_cast<Channel>(mapping.streamChannel + 1u));
+			}
+		}
+	}
+	return used;
+}
+
+bool isRouted(Network const& network, Route const& route) noexcept
+{
+	auto const* const talker = findEntity(network, route.talkerEntityID);
+	auto const* const listener = findEntity(network, route.listenerEntityID);
+	if (!talker || !listener)
+	{
+		return false;
+	}
+
+	auto const talkerMappings = findMappings(*talker, false, route.talkerChannel);
+	for (auto const& listenerMapping : findMappings(*listener, true, route.listenerChannel))
+	{
+		auto const inputIt = listener->streamInputs.find(listenerMapping.streamIndex);
+		if (inputIt == listener->streamInputs.end() || !inputIt->second.talkerStream || inputIt->second.talkerStream->entityID != route.talkerEntityID)
+		{
+			continue;
+		}
+		auto const talkerStreamIndex = inputIt->second.talkerStream->streamIndex;
+		for (auto const& talkerMapping : talkerMappings)
+		{
+			if (talkerMapping.streamIndex == talkerStreamIndex && talkerMapping.streamChannel == listenerMapping.streamChannel)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/** Listener streams connected to each talker stream */
+std::map<StreamIdentification, std::set<StreamIdentification>> getStreamConnections(Network const& network) noexcept
+{
+	auto connections = std::map<StreamIdentification, std::set<StreamIdentification>>{};
+	for (auto const& [entityID, entity] : network)
+	{
+		for (auto const& [streamIndex, input] : entity.streamInputs)
+		{
+			if (input.talkerStream)
+			{
+				connections[*input.talkerStream].insert(StreamIdentification{ entityID, streamIndex });
+			}
+		}
+	}
+	return connections;
+}
+
+/**
+ * Plans routes one after the other on a working copy of the network, so each route benefits from the changes planned for the previous ones.
+ * Changes cancelling each other (a mapping added then removed) are not part of the plan.
+ */
+class PlanBuilder final
+{
+public:
+	PlanBuilder(Network const& network) noexcept
+		: _network{ network }
+		, _originalConnections{ getStreamConnections(network) }
+		, _connections{ _originalConnections }
+	{
+	}
+
+	void route(Route const& route) noexcept
+	{
+		auto const talkerIt = _network.find(route.talkerEntityID);
+		auto const listenerIt = _network.find(route.listenerEntityID);
+		if (talkerIt == _network.end() || listenerIt == _network.end())
+		{
+			_plan.impossibleRoutes.push_back(route);
+			return;
+		}
+
+		if (isRouted(_network, route))
+		{
+			++_plan.alreadyRoutedCount;
+			return;
+		}
+
+		auto const option = findBestOption(route, talkerIt->second, listenerIt->second);
+		if (!option)
+		{
+			_plan.impossibleRoutes.push_back(route);
+			return;
+		}
+
+		auto const talkerStream = StreamIdentification{ route.talkerEntityID, option->talkerStreamIndex };
+		auto const listenerStream = StreamIdentification{ route.listenerEntityID, option->listenerStreamIndex };
+
+		// The listener channel only receives the routed channel
+		for (auto const& mapping : findMappings(listenerIt->second, true, route.listenerChannel))
+		{
+			removeMapping(route.listenerEntityID, true, route.listenerChannel.streamPortIndex, mapping);
+		}
+
+		if (option->addTalkerMapping)
+		{
+			addMapping(route.talkerEntityID, false, route.talkerChannel.streamPortIndex, Mapping{ option->talkerStreamIndex, option->streamChannel, route.talkerChannel.clusterOffset, route.talkerChannel.clusterChannel });
+
+			// Some devices do not accept mappings changes of a running stream
+			if (auto const it = _originalConnections.find(talkerStream); it != _originalConnections.end())
+			{
+				for (auto const& connectedStream : it->second)
+				{
+					_reconnections.insert(StreamConnection{ talkerStream, connectedStream });
+				}
+			}
+
+			// Listeners already mapping this stream channel would receive the routed channel
+			for (auto const& connectedStream : _connections[talkerStream])
+			{
+				removeStreamChannelMappings(connectedStream, option->streamChannel);
+			}
+		}
+
+		if (option->connectStream)
+		{
+			// Mappings of the listener stream would receive the other channels of the talker stream
+			auto const talkerUsage = getStreamChannelsUsage(talkerIt->second, false, option->talkerStreamIndex, getMaxChannelsCount(talkerIt->second, option->talkerStreamIndex));
+			// Copy the mappings, they are modified while iterating
+			auto const streamPortMappings = listenerIt->second.streamPortInputMappings;
+			for (auto const& [streamPortIndex, mappings] : streamPortMappings)
+			{
+				for (auto const& mapping : mappings)
+				{
+					if (mapping.streamIndex == option->listenerStreamIndex && mapping.streamChannel < talkerUsage.size() && talkerUsage[mapping.streamChannel] != 0u)
+					{
+						removeMapping(route.listenerEntityID, true, streamPortIndex, mapping);
+					}
+				}
+			}
+
+			listenerIt->second.streamInputs.at(option->listenerStreamIndex).talkerStream = talkerStream;
+			_connections[talkerStream].insert(listenerStream);
+			_newConnections.push_back(StreamConnection{ talkerStream, listenerStream });
+		}
+
+		addMapping(route.listenerEntityID, true, route.listenerChannel.streamPortIndex, Mapping{ option->listenerStreamIndex, option->streamChannel, route.listenerChannel.clusterOffset, route.listenerChannel.clusterChannel });
+		_changedTalkerStreams.insert(talkerStream);
+	}
+
+	Planner::Plan finalize() noexcept
+	{
+		computeStreamFormatChanges();
+
+		for (auto const& connection : _reconnections)
+		{
+			_plan.streamsToReconnect.push_back(connection);
+		}
+		_plan.streamsToConnect = std::move(_newConnections);
+
+		auto const toMappingsChanges = [](std::map<MappingsKey, std::set<Mapping>> const& changes)
+		{
+			auto result = std::vector<Planner::MappingsChange>{};
+			for (auto const& [key, mappings] : changes)
+			{
+				if (!mappings.empty())
+				{
+					auto const& [entityID, isInput, streamPortIndex] = key;
+					result.push_back(Planner::MappingsChange{ entityID, isInput, streamPortIndex, Mappings{ mappings.begin(), mappings.end() } });
+				}
+			}
+			return result;
+		};
+		_plan.mappingsToRemove = toMappingsChanges(_removedMappings);
+		_plan.mappingsToAdd = toMappingsChanges(_addedMappings);
+
+		return std::move(_plan);
+	}
+
+private:
+	struct Option
+	{
+		std::size_t cost{ 0u }; // Estimated number of commands
+		StreamIndex talkerStreamIndex{ 0u };
+		Channel streamChannel{ 0u };
+		StreamIndex listenerStreamIndex{ 0u };
+		bool addTalkerMapping{ false };
+		bool connectStream{ false };
+	};
+
+	std::optional<Option> findBestOption(Route const& route, Entity const& talker, Entity const& listener) noexcept
+	{
+		auto best = std::optional<Option>{};
+		auto const consider = [&best](Option const& option)
+		{
+			if (!best || option.cost < best->cost)
+			{
+				best = option;
+			}
+		};
+
+		// Number of listener mappings which would have to be removed when connecting a listener stream to a talker stream
+		auto const unwantedMappingsCount = [&listener](StreamIndex const listenerStreamIndex, std::vector<std::size_t> const& talkerUsage)
+		{
+			auto count = std::size_t{ 0u };
+			for (auto const& [streamPortIndex, mappings] : listener.streamPortInputMappings)
+			{
+				for (auto const& mapping : mappings)
+				{
+					if (mapping.streamIndex == listenerStreamIndex && mapping.streamChannel < talkerUsage.size() && talkerUsage[mapping.streamChannel] != 0u)
+					{
+						++count;
+					}
+				}
+			}
+			return count;
+		};
+
+		// Reuse a talker mapping of the channel, through a connected listener stream or a free one
+		for (auto const& talkerMapping : findMappings(talker, false, route.talkerChannel))
+		{
+			auto const talkerStream = StreamIdentification{ route.talkerEntityID, talkerMapping.streamIndex };
+			auto const talkerUsage = getStreamChannelsUsage(talker, false, talkerMapping.streamIndex, getMaxChannelsCount(talker, talkerMapping.streamIndex));
+			for (auto const& [listenerStreamIndex, input] : listener.streamInputs)
+			{
+				if (talkerMapping.streamChannel >= input.maxChannelsCount)
+				{
+					continue;
+				}
+				if (input.talkerStream == talkerStream)
+				{
+					consider(Option{ 1u, talkerMapping.streamIndex, talkerMapping.streamChannel, listenerStreamIndex, false, false });
+				}
+				else if (!input.talkerStream)
+				{
+					consider(Option{ 2u + unwantedMappingsCount(listenerStreamIndex, talkerUsage), talkerMapping.streamIndex, talkerMapping.streamChannel, listenerStreamIndex, false, true });
+				}
+			}
+		}
+		if (best && best->cost == 1u)
+		{
+			return best;
+		}
+
+		// Map the channel on a free channel of a talker stream
+		for (auto const& [talkerStreamIndex, output] : talker.streamOutputs)
+		{
+			auto const talkerStream = StreamIdentification{ route.talkerEntityID, talkerStreamIndex };
+			auto const& connectedStreams = _connections[talkerStream];
+
+			// All the listener streams receive the same stream format
+			auto maxChannelsCount = output.maxChannelsCount;
+			for (auto const& connectedStream : connectedStreams)
+			{
+				maxChannelsCount = std::min(maxChannelsCount, _network.at(connectedStream.entityID).streamInputs.at(connectedStream.streamIndex).maxChannelsCount);
+			}
+			auto const talkerUsage = getStreamChannelsUsage(talker, false, talkerStreamIndex, output.maxChannelsCount);
+
+			// Listener mappings of the stream channels, for all the connected listener streams
+			auto connectedUsage = std::vector<std::size_t>(maxChannelsCount, 0u);
+			for (auto const& connectedStream : connectedStreams)
+			{
+				auto const usage = getStreamChannelsUsage(_network.at(connectedStream.entityID), true, connectedStream.streamIndex, maxChannelsCount);
+				std::transform(connectedUsage.begin(), connectedUsage.end(), usage.begin(), connectedUsage.begin(), std::plus<>{});
+			}
+
+			// Stopping and restarting the existing connections
+			auto reconnectionsCost = std::size_t{ 0u };
+			if (auto const it = _originalConnections.find(talkerStream); it != _originalConnections.end())
+			{
+				for (auto const& connectedStream : it->second)
+				{
+					reconnectionsCost += 2u * (_reconnections.count(StreamConnection{ talkerStream, connectedStream }) == 0u);
+				}
+			}
+
+			for (auto const& [listenerStreamIndex, input] : listener.streamInputs)
+			{
+				auto const isConnected = input.talkerStream == talkerStream;
+				if (!isConnected && input.talkerStream)
+				{
+					continue;
+				}
+
+				// Find the free stream channel requiring the less listener mappings removal
+				auto const channelsCount = std::min(maxChannelsCount, input.maxChannelsCount);
+				auto const listenerUsage = isConnected ? std::vector<std::size_t>(channelsCount, 0u) : getStreamChannelsUsage(listener, true, listenerStreamIndex, channelsCount);
+				auto channel = std::optional<Channel>{};
+				auto channelCost = std::numeric_limits<std::size_t>::max();
+				for (auto streamChannel = Channel{ 0u }; streamChannel < channelsCount && channelCost != 0u; ++streamChannel)
+				{
+					if (talkerUsage[streamChannel] == 0u && connectedUsage[streamChannel] + listenerUsage[streamChannel] < channelCost)
+					{
+						channel = streamChannel;
+						channelCost = connectedUsage[streamChannel] + listenerUsage[streamChannel];
+					}
+				}
+				if (!channel)
+				{
+					continue;
+				}
+
+				auto cost = 2u + reconnectionsCost + channelCost;
+				if (!isConnected)
+				{
+					cost += 1u + unwantedMappingsCount(listenerStreamIndex, talkerUsage);
+				}
+				consider(Option{ cost, talkerStreamIndex, *channel, listenerStreamIndex, true, !isConnected });
+			}
+		}
+
+		return best;
+	}
+
+	void addMapping(EntityID const entityID, bool const isInput, StreamPortIndex const streamPortIndex, Mapping const& mapping) noexcept
+	{
+		auto& entity = _network.at(entityID);
+		(isInput ? entity.streamPortInputMappings : entity.streamPortOutputMappings)[streamPortIndex].push_back(mapping);
+
+		auto const key = MappingsKey{ entityID, isInput, streamPortIndex };
+		if (_removedMappings[key].erase(mapping) == 0u)
+		{
+			_addedMappings[key].insert(mapping);
+		}
+	}
+
+	void removeMapping(EntityID const entityID, bool const isInput, StreamPortIndex const streamPortIndex, Mapping const& mapping) noexcept
+	{
+		auto& entity = _network.at(entityID);
+		auto& mappings = (isInput ? entity.streamPortInputMappings : entity.streamPortOutputMappings)[streamPortIndex];
+		mappings.erase(std::remove(mappings.begin(), mappings.end(), mapping), mappings.end());
+
+		auto const key = MappingsKey{ entityID, isInput, streamPortIndex };
+		if (_addedMappings[key].erase(mapping) == 0u)
+		{
+			_removedMappings[key].insert(mapping);
+		}
+	}
+
+	void removeStreamChannelMappings(StreamIdentification const& listenerStream, Channel const streamChannel) noexcept
+	{
+		// Copy the mappings, they are modified while iterating
+		auto const streamPortMappings = _network.at(listenerStream.entityID).streamPortInputMappings;
+		for (auto const& [streamPortIndex, mappings] : streamPortMappings)
+		{
+			for (auto const& mapping : mappings)
+			{
+				if (mapping.streamIndex == listenerStream.streamIndex && mapping.streamChannel == streamChannel)
+				{
+					removeMapping(listenerStream.entityID, true, streamPortIndex, mapping);
+				}
+			}
+		}
+	}
+
+	void computeStreamFormatChanges() noexcept
+	{
+		for (auto const& talkerStream : _changedTalkerStreams)
+		{
+			auto const& talker = _network.at(talkerStream.entityID);
+			auto const& output = talker.streamOutputs.at(talkerStream.streamIndex);
+			auto const& connectedStreams = _connections[talkerStream];
+			auto const& originalConnectedStreams = _originalConnections[talkerStream];
+
+			// Enough channels for the talker and all its listeners mappings
+			auto channelsCount = std::max(output.channelsCount, getStreamChannelsUsed(talker, false, talkerStream.streamIndex));
+			for (auto const& connectedStream : connectedStreams)
+			{
+				channelsCount = std::max(channelsCount, getStreamChannelsUsed(_network.at(connectedStream.entityID), true, connectedStream.streamIndex));
+			}
+			channelsCount = std::min(channelsCount, output.maxChannelsCount);
+
+			if (channelsCount != output.channelsCount)
+			{
+				_plan.streamFormatChanges.push_back(Planner::StreamFormatChange{ talkerStream.entityID, false, talkerStream.streamIndex, channelsCount });
+			}
+
+			// Listener streams have to match the talker stream format (existing connections are only adjusted if the talker stream format changes)
+			for (auto const& connectedStream : connectedStreams)
+			{
+				auto const& input = _network.at(connectedStream.entityID).streamInputs.at(connectedStream.streamIndex);
+				auto const isNewConnection = originalConnectedStreams.count(connectedStream) == 0u;
+				if ((isNewConnection || channelsCount != output.channelsCount) && input.channelsCount != channelsCount && channelsCount <= input.maxChannelsCount)
+				{
+					_plan.streamFormatChanges.push_back(Planner::StreamFormatChange{ connectedStream.entityID, true, connectedStream.streamIndex, channelsCount });
+				}
+			}
+		}
+	}
+
+	Network _network{};
+	std::map<StreamIdentification, std::set<StreamIdentification>> _originalConnections{};
+	std::map<StreamIdentification, std::set<StreamIdentification>> _connections{};
+	std::vector<StreamConnection> _newConnections{};
+	std::set<StreamConnection> _reconnections{};
+	std::map<MappingsKey, std::set<Mapping>> _addedMappings{};
+	std::map<MappingsKey, std::set<Mapping>> _removedMappings{};
+	std::set<StreamIdentification> _changedTalkerStreams{};
+	Planner::Plan _plan{};
+};
+
+} // namespace
+
+bool ChannelRoutingPlanner::Plan::isEmpty() const noexcept
+{
+	return commandsCount() == 0u;
+}
+
+std::size_t ChannelRoutingPlanner::Plan::commandsCount() const noexcept
+{
+	return 2u * streamsToReconnect.size() + mappingsToRemove.size() + mappingsToAdd.size() + streamFormatChanges.size() + streamsToConnect.size();
+}
+
+std::set<ChannelRoutingPlanner::EntityID> ChannelRoutingPlanner::Plan::entities() const noexcept
+{
+	auto entities = std::set<EntityID>{};
+	for (auto const* const connections : { &streamsToReconnect, &streamsToConnect })
+	{
+		for (auto const& connection : *connections)
+		{
+			entities.insert(connection.talkerStream.entityID);
+			entities.insert(connection.listenerStream.entityID);
+		}
+	}
+	for (auto const* const changes : { &mappingsToRemove, &mappingsToAdd })
+	{
+		for (auto const& change : *changes)
+		{
+			entities.insert(change.entityID);
+		}
+	}
+	for (auto const& change : streamFormatChanges)
+	{
+		entities.insert(change.entityID);
+	}
+	return entities;
+}
+
+void ChannelRoutingPlanner::setEntity(EntityID const entityID, Entity entity) noexcept
+{
+	_entities[entityID] = std::move(entity);
+}
+
+void ChannelRoutingPlanner::removeEntity(EntityID const entityID) noexcept
+{
+	_entities.erase(entityID);
+}
+
+void ChannelRoutingPlanner::clear() noexcept
+{
+	_entities.clear();
+}
+
+ChannelRoutingPlanner::Entity const* ChannelRoutingPlanner::getEntity(EntityID const entityID) const noexcept
+{
+	return findEntity(_entities, entityID);
+}
+
+ChannelRoutingPlanner::Plan ChannelRoutingPlanner::plan(std::vector<Route> const& routes) const noexcept
+{
+	auto builder = PlanBuilder{ _entities };
+	for (auto const& route : routes)
+	{
+		builder.route(route);
+	}
+	return builder.finalize();
+}
+
+void ChannelRoutingPlanner::apply(Plan const& plan) noexcept
+{
+	for (auto const& change : plan.mappingsToRemove)
+	{
+		if (auto const it = _entities.find(change.entityID); it != _entities.end())
+		{
+			auto& mappings = (change.isInput ? it->second.streamPortInputMappings : it->second.streamPortOutputMappings)[change.streamPortIndex];
+			for (auto const& mapping : change.mappings)
+			{
+				mappings.erase(std::remove(mappings.begin(), mappings.end(), mapping), mappings.end());
+			}
+		}
+	}
+	for (auto const& change : plan.mappingsToAdd)
+	{
+		if (auto const it = _entities.find(change.entityID); it != _entities.end())
+		{
+			auto& mappings = (change.isInput ? it->second.streamPortInputMappings : it->second.streamPortOutputMappings)[change.streamPortIndex];
+			mappings.insert(mappings.end(), change.mappings.begin(), change.mappings.end());
+		}
+	}
+	for (auto const& change : plan.streamFormatChanges)
+	{
+		if (auto const it = _entities.find(change.entityID); it != _entities.end())
+		{
+			if (change.isInput)
+			{
+				if (auto const streamIt = it->second.streamInputs.find(change.streamIndex); streamIt != it->second.streamInputs.end())
+				{
+					streamIt->second.channelsCount = change.channelsCount;
+				}
+			}
+			else if (auto const streamIt = it->second.streamOutputs.find(change.streamIndex); streamIt != it->second.streamOutputs.end())
+			{
+				streamIt->second.channelsCount = change.channelsCount;
+			}
+		}
+	}
+	for (auto const& connection : plan.streamsToConnect)
+	{
+		if (auto const it = _entities.find(connection.listenerStream.entityID); it != _entities.end())
+		{
+			if (auto const streamIt = it->second.streamInputs.find(connection.listenerStream.streamIndex); streamIt != it->second.streamInputs.end())
+			{
+				streamIt->second.talkerStream = connection.talkerStream;
+			}
+		}
+	}
+}
+
+bool ChannelRoutingPlanner::isRouted(Route const& route) const noexcept
+{
+	return avdecc::isRouted(_entities, route);
+}
+
+} // namespace avdecc
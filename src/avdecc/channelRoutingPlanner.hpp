@@ -0,0 +1,197 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace avdecc
+{
+/**
+ * @Brief Plans the stream connections, stream format changes and audio mappings required to route a whole set of channels at once
+ * @Details Works on a snapshot of the network (streams, audio mappings and stream connections of each entity), using plain integer types
+ *          so it is independent of the controller model. All the routes are planned in one pass on a working copy of the snapshot,
+ *          reusing the mappings and stream connections already existing (or already planned for a previous route) whenever possible,
+ *          so routing many channels between the same entities only creates the stream connections actually needed.
+ *          The resulting plan groups the mappings changes per entity and stream port (one command each) and can be inspected (dry-run)
+ *          before being executed. Redundant streams are not part of the snapshot, only primary (or non-redundant) streams are.
+ */
+class ChannelRoutingPlanner final
+{
+public:
+	using EntityID = std::uint64_t; // Value of the la::avdecc::UniqueIdentifier
+	using StreamIndex = std::uint16_t;
+	using StreamPortIndex = std::uint16_t;
+	using ClusterOffset = std::uint16_t; // Offset of the cluster from the base cluster of the stream port
+	using Channel = std::uint16_t;
+
+	struct ClusterChannel
+	{
+		StreamPortIndex streamPortIndex{ 0u };
+		ClusterOffset clusterOffset{ 0u };
+		Channel clusterChannel{ 0u };
+
+		bool operator<(ClusterChannel const& other) const noexcept
+		{
+			return std::tie(streamPortIndex, clusterOffset, clusterChannel) < std::tie(other.streamPortIndex, other.clusterOffset, other.clusterChannel);
+		}
+		bool operator==(ClusterChannel const& other) const noexcept
+		{
+			return std::tie(streamPortIndex, clusterOffset, clusterChannel) == std::tie(other.streamPortIndex, other.clusterOffset, other.clusterChannel);
+		}
+	};
+
+	/** Same as la::avdecc::entity::model::AudioMapping */
+	struct Mapping
+	{
+		StreamIndex streamIndex{ 0u };
+		Channel streamChannel{ 0u };
+		ClusterOffset clusterOffset{ 0u };
+		Channel clusterChannel{ 0u };
+
+		bool operator<(Mapping const& other) const noexcept
+		{
+			return std::tie(streamIndex, streamChannel, clusterOffset, clusterChannel) < std::tie(other.streamIndex, other.streamChannel, other.clusterOffset, other.clusterChannel);
+		}
+		bool operator==(Mapping const& other) const noexcept
+		{
+			return std::tie(streamIndex, streamChannel, clusterOffset, clusterChannel) == std::tie(other.streamIndex, other.streamChannel, other.clusterOffset, other.clusterChannel);
+		}
+	};
+	using Mappings = std::vector<Mapping>;
+
+	struct StreamIdentification
+	{
+		EntityID entityID{ 0u };
+		StreamIndex streamIndex{ 0u };
+
+		bool operator<(StreamIdentification const& other) const noexcept
+		{
+			return std::tie(entityID, streamIndex) < std::tie(other.entityID, other.streamIndex);
+		}
+		bool operator==(StreamIdentification const& other) const noexcept
+		{
+			return std::tie(entityID, streamIndex) == std::tie(other.entityID, other.streamIndex);
+		}
+	};
+
+	struct Stream
+	{
+		Channel channelsCount{ 0u }; // Channels of the current stream format
+		Channel maxChannelsCount{ 0u }; // Channels of the largest supported stream format
+	};
+
+	struct StreamInput : Stream
+	{
+		std::optional<StreamIdentification> talkerStream{ std::nullopt }; // Talker stream this input is connected to
+	};
+
+	struct Entity
+	{
+		std::map<StreamIndex, Stream> streamOutputs{};
+		std::map<StreamIndex, StreamInput> streamInputs{};
+		std::map<StreamPortIndex, Mappings> streamPortOutputMappings{};
+		std::map<StreamPortIndex, Mappings> streamPortInputMappings{};
+	};
+
+	struct Route
+	{
+		EntityID talkerEntityID{ 0u };
+		ClusterChannel talkerChannel{};
+		EntityID listenerEntityID{ 0u };
+		ClusterChannel listenerChannel{};
+	};
+
+	struct StreamConnection
+	{
+		StreamIdentification talkerStream{};
+		StreamIdentification listenerStream{};
+
+		bool operator<(StreamConnection const& other) const noexcept
+		{
+			return std::tie(talkerStream, listenerStream) < std::tie(other.talkerStream, other.listenerStream);
+		}
+		bool operator==(StreamConnection const& other) const noexcept
+		{
+			return std::tie(talkerStream, listenerStream) == std::tie(other.talkerStream, other.listenerStream);
+		}
+	};
+
+	struct StreamFormatChange
+	{
+		EntityID entityID{ 0u };
+		bool isInput{ false };
+		StreamIndex streamIndex{ 0u };
+		Channel channelsCount{ 0u }; // Minimum number of channels of the new stream format
+	};
+
+	struct MappingsChange
+	{
+		EntityID entityID{ 0u };
+		bool isInput{ false };
+		StreamPortIndex streamPortIndex{ 0u };
+		Mappings mappings{};
+	};
+
+	struct Plan
+	{
+		std::vector<StreamConnection> streamsToReconnect{}; // Existing connections of talker streams getting new mappings, stopped while the mappings change
+		std::vector<MappingsChange> mappingsToRemove{};
+		std::vector<MappingsChange> mappingsToAdd{};
+		std::vector<StreamFormatChange> streamFormatChanges{};
+		std::vector<StreamConnection> streamsToConnect{};
+		std::vector<Route> impossibleRoutes{};
+		std::size_t alreadyRoutedCount{ 0u };
+
+		/** Returns true if the plan has nothing to execute */
+		bool isEmpty() const noexcept;
+		/** Returns the number of commands executing the plan (one per mappings change, two per reconnected stream) */
+		std::size_t commandsCount() const noexcept;
+		/** Returns all the entities the plan sends a command to */
+		std::set<EntityID> entities() const noexcept;
+	};
+
+	ChannelRoutingPlanner() noexcept = default;
+
+	/** Sets (or replaces) the snapshot of an entity */
+	void setEntity(EntityID const entityID, Entity entity) noexcept;
+	void removeEntity(EntityID const entityID) noexcept;
+	void clear() noexcept;
+	Entity const* getEntity(EntityID const entityID) const noexcept;
+
+	/** Plans all the routes at once. Routes which cannot be created (unknown entities, no stream or stream channel available) are listed in the plan */
+	Plan plan(std::vector<Route> const& routes) const noexcept;
+	/** Updates the snapshot with the result of an executed plan */
+	void apply(Plan const& plan) noexcept;
+	/** Returns true if the talker channel is currently routed to the listener channel */
+	bool isRouted(Route const& route) const noexcept;
+
+private:
+	using Network = std::map<EntityID, Entity>;
+
+	Network _entities{};
+};
+
+} // namespace avdecc
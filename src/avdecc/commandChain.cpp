@@ -24,6 +24,7 @@
 #include <hive/modelsLibrary/controllerManager.hpp>
 
 #include <atomic>
+#include <mutex>
 #include <optional>
 #include <unordered_set>
 #include <math.h>
@@ -115,7 +116,7 @@ AsyncParallelCommandSet::AsyncParallelCommandSet() noexcept {}
 		*/
 AsyncParallelCommandSet::AsyncParallelCommandSet(AsyncCommand const& command) noexcept
 {
-	_commands.push_back(command);
+	append(command);
 }
 
 /**
@@ -123,7 +124,15 @@ AsyncParallelCommandSet::AsyncParallelCommandSet(AsyncCommand const& command) no
 		*/
 AsyncParallelCommandSet::AsyncParallelCommandSet(std::vector<AsyncCommand> const& commands) noexcept
 {
-	_commands.insert(std::end(_commands), std::begin(commands), std::end(commands));
+	append(commands);
+}
+
+/**
+		* Constructor taking multiple command functions, all touching the specified scope.
+		*/
+AsyncParallelCommandSet::AsyncParallelCommandSet(std::vector<AsyncCommand> const& commands, CommandScope const& scope) noexcept
+{
+	append(commands, scope);
 }
 
 /**
@@ -131,15 +140,33 @@ AsyncParallelCommandSet::AsyncParallelCommandSet(std::vector<AsyncCommand> const
 		*/
 void AsyncParallelCommandSet::append(AsyncCommand const& command) noexcept
 {
-	_commands.push_back(command);
+	append(command, {});
 }
 
 /**
 		* Appends a command function to the internal list.
 		*/
 void AsyncParallelCommandSet::append(std::vector<AsyncCommand> const& commands) noexcept
+{
+	append(commands, {});
+}
+
+/**
+		* Appends a command function touching the specified scope to the internal list.
+		*/
+void AsyncParallelCommandSet::append(AsyncCommand const& command, CommandScope const& scope) noexcept
+{
+	_commands.push_back(command);
+	_scopes.push_back(scope);
+}
+
+/**
+		* Appends command functions, all touching the specified scope, to the internal list.
+		*/
+void AsyncParallelCommandSet::append(std::vector<AsyncCommand> const& commands, CommandScope const& scope) noexcept
 {
 	_commands.insert(std::end(_commands), std::begin(commands), std::end(commands));
+	_scopes.insert(std::end(_scopes), commands.size(), scope);
 }
 
 /**
@@ -149,6 +176,7 @@ void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const en
 {
 	CommandErrorInfo info{ error };
 	info.commandTypeAcmp = commandType;
+	auto const lg = std::lock_guard{ _errorsLock };
 	_errors.emplace(entityId, info);
 }
 
@@ -159,6 +187,7 @@ void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const en
 {
 	CommandErrorInfo info{ error };
 	info.commandTypeAecp = commandType;
+	auto const lg = std::lock_guard{ _errorsLock };
 	_errors.emplace(entityId, info);
 }
 
@@ -168,6 +197,7 @@ void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const en
 void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error) noexcept
 {
 	CommandErrorInfo info{ error };
+	auto const lg = std::lock_guard{ _errorsLock };
 	_errors.emplace(entityId, info);
 }
 
@@ -179,6 +209,23 @@ size_t AsyncParallelCommandSet::parallelCommandCount() const noexcept
 	return _commands.size();
 }
 
+/**
+		* Gets the scope of a command.
+		*/
+AsyncParallelCommandSet::CommandScope const& AsyncParallelCommandSet::commandScope(uint32_t const commandIndex) const noexcept
+{
+	return _scopes.at(commandIndex);
+}
+
+/**
+		* Gets a copy of the errors reported so far (commands might still be running).
+		*/
+CommandExecutionErrors AsyncParallelCommandSet::errors() const noexcept
+{
+	auto const lg = std::lock_guard{ _errorsLock };
+	return _errors;
+}
+
 /**
 		* Executes all commands. Eventually emits commandSetCompleted if none of the commands has anything to do.
 		*/
@@ -189,35 +236,43 @@ void AsyncParallelCommandSet::exec() noexcept
 		invokeCommandCompleted(0, false);
 		return;
 	}
-	auto index = uint32_t{ 0 };
-	for (auto const& command : _commands)
+	for (auto index = uint32_t{ 0 }; index < static_cast<uint32_t>(_commands.size()); ++index)
 	{
-		if (!command(this, index))
+		if (!execCommand(index))
 		{
 			invokeCommandCompleted(index, false);
 		}
-		index++;
 	}
 }
 
+/**
+		* Executes a single command. Returns false if the command has nothing to do (invokeCommandCompleted will not be called).
+		*/
+bool AsyncParallelCommandSet::execCommand(uint32_t const commandIndex) noexcept
+{
+	return _commands.at(commandIndex)(this, commandIndex);
+}
+
 /**
 		* After a command was executed, this is called.
 		*/
-void AsyncParallelCommandSet::invokeCommandCompleted(uint32_t const /*commandIndex*/, bool const error) noexcept
+void AsyncParallelCommandSet::invokeCommandCompleted(uint32_t const commandIndex, bool const error) noexcept
 {
 	if (error)
 	{
 		_errorOccured = true;
-		_commandCompletionCounter++;
 	}
-	else
+	auto const completedCount = ++_commandCompletionCounter;
+
+	if (commandIndex < _commands.size())
 	{
-		_commandCompletionCounter++;
+		emit commandCompleted(commandIndex, error);
 	}
 
-	if (_commandCompletionCounter >= static_cast<decltype(_commandCompletionCounter)>(_commands.size()))
+	// Only the last completed command emits the signal, even if the commands complete from different threads
+	if (completedCount == static_cast<uint32_t>(_commands.size()))
 	{
-		emit commandSetCompleted(_errors);
+		emit commandSetCompleted(errors());
 	}
 }
 
@@ -241,53 +296,150 @@ SequentialAsyncCommandExecuter::~SequentialAsyncCommandExecuter()
 }
 
 /**
-		* Sets the commands to be executed.
+		* Sets the commands to be executed. Each command set is a stage, see class description.
 		*/
 void SequentialAsyncCommandExecuter::setCommandChain(std::vector<AsyncParallelCommandSet*> const& commands) noexcept
 {
-	auto totalCommandCount = size_t{ 0 };
 	_commands = commands;
-	for (auto* command : _commands)
+	_scheduler.clear();
+	_scheduler.setMaxInFlightPerChain(_maxInFlightCommandsPerEntity);
+	_commandLocations.clear();
+	_running = false;
+
+	for (auto stage = size_t{ 0 }; stage < _commands.size(); ++stage)
 	{
-		command->setParent(this);
-		totalCommandCount += command->parallelCommandCount();
+		auto* const commandSet = _commands[stage];
+		commandSet->setParent(this);
+
+		auto const firstCommandID = _commandLocations.size();
+		for (auto commandIndex = uint32_t{ 0 }; commandIndex < static_cast<uint32_t>(commandSet->parallelCommandCount()); ++commandIndex)
+		{
+			_scheduler.add(stage, commandSet->commandScope(commandIndex));
+			_commandLocations.push_back(CommandLocation{ commandSet, commandIndex });
+		}
+
+		// Completion might be notified from any thread
+		connect(commandSet, &AsyncParallelCommandSet::commandCompleted, this,
+			[this, firstCommandID](uint32_t const commandIndex, bool const /*error*/)
+			{
+				onCommandCompleted(firstCommandID + commandIndex);
+			});
 	}
-	_totalCommandCount = totalCommandCount;
-	_completedCommandCount = 0;
-	_currentCommandSet = 0;
 }
 
 /**
-		* Starts or continues the sequence of commands that was set via setCommandChain.
+		* Sets the maximum number of commands addressed to the same entity that can be in flight at the same time (0 for no limit). Applied on next setCommandChain call.
+		*/
+void SequentialAsyncCommandExecuter::setMaxInFlightCommandsPerEntity(size_t const maxInFlightCommands) noexcept
+{
+	_maxInFlightCommandsPerEntity = maxInFlightCommands;
+}
+
+size_t SequentialAsyncCommandExecuter::getMaxInFlightCommandsPerEntity() const noexcept
+{
+	return _maxInFlightCommandsPerEntity;
+}
+
+/**
+		* Starts the commands that were set via setCommandChain.
 		*/
 void SequentialAsyncCommandExecuter::start() noexcept
 {
-	if (_currentCommandSet < _commands.size())
+	_running = true;
+	dispatch();
+}
+
+/**
+		* Executes all commands that are ready (all dependencies completed and entity window not full).
+		*/
+void SequentialAsyncCommandExecuter::dispatch() noexcept
+{
+	// Commands with nothing to do complete synchronously, the outer call will process the newly ready ones
+	if (_dispatching)
 	{
-		connect(_commands.at(_currentCommandSet), &AsyncParallelCommandSet::commandSetCompleted, this,
-			[this](CommandExecutionErrors errors)
+		return;
+	}
+	_dispatching = true;
+
+	auto readyCommands = _scheduler.takeReady();
+	while (!readyCommands.empty())
+	{
+		for (auto const commandID : readyCommands)
+		{
+			auto const location = _commandLocations[commandID];
+			if (!location.commandSet->execCommand(location.commandIndex))
 			{
-				_errors.insert(errors.begin(), errors.end());
-				_completedCommandCount += _commands.at(_currentCommandSet)->parallelCommandCount();
-				emit progressUpdate(_completedCommandCount, _totalCommandCount);
+				location.commandSet->invokeCommandCompleted(location.commandIndex, false);
+			}
+		}
+		readyCommands = _scheduler.takeReady();
+	}
 
-				// start next set
-				_currentCommandSet++;
-				start();
-			});
+	_dispatching = false;
+
+	if (_running && _scheduler.isFinished())
+	{
+		finish();
+	}
+}
 
-		_commands.at(_currentCommandSet)->exec();
+/**
+		* Called when a command completed, reports progress and starts the commands depending on it.
+		*/
+void SequentialAsyncCommandExecuter::onCommandCompleted(Scheduler::CommandID const commandID) noexcept
+{
+	if (!_running || !_scheduler.complete(commandID))
+	{
+		return;
 	}
-	else
+
+	emit progressUpdate(_scheduler.completedCount(), _scheduler.commandCount());
+
+	// Progress of the chain of the entity the command is addressed to
+	auto const& scope = _scheduler.scope(commandID);
+	if (!scope.empty())
 	{
-		// clear the command list once completed.
-		qDeleteAll(_commands);
-		_commands.clear();
+		auto const entityID = scope.front();
+		auto const progress = _scheduler.chainProgress(entityID);
+		emit chainProgressUpdate(entityID, progress.completedCommands, progress.totalCommands);
+
+		if (progress.completedCommands == progress.totalCommands)
+		{
+			auto errors = CommandExecutionErrors{};
+			for (auto const* const commandSet : _commands)
+			{
+				auto const setErrors = commandSet->errors();
+				auto const [begin, end] = setErrors.equal_range(entityID);
+				errors.insert(begin, end);
+			}
+			emit chainCompleted(entityID, errors);
+		}
+	}
 
-		emit completed(_errors);
+	dispatch();
+}
 
-		_errors.clear();
+/**
+		* Called once all commands completed.
+		*/
+void SequentialAsyncCommandExecuter::finish() noexcept
+{
+	_running = false;
+
+	auto errors = CommandExecutionErrors{};
+	for (auto const* const commandSet : _commands)
+	{
+		auto const setErrors = commandSet->errors();
+		errors.insert(setErrors.begin(), setErrors.end());
 	}
+
+	// clear the command list once completed.
+	qDeleteAll(_commands);
+	_commands.clear();
+	_commandLocations.clear();
+	_scheduler.clear();
+
+	emit completed(errors);
 }
 
 } // namespace commandChain
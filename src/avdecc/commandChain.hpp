@@ -20,13 +20,17 @@
 #pragma once
 
 #include <la/avdecc/controller/avdeccController.hpp>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <QObject>
 #include <QMap>
 
 #include <hive/modelsLibrary/controllerManager.hpp>
 
+#include "avdecc/commandScheduler.hpp"
+
 namespace avdecc
 {
 namespace commandChain
@@ -69,6 +73,7 @@ class AsyncParallelCommandSet : public QObject
 
 public:
 	using AsyncCommand = std::function<bool(AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex)>;
+	using CommandScope = std::vector<la::avdecc::UniqueIdentifier>; /** Entities a command touches, the first one being the entity the command is addressed to. An empty scope means the command might touch any entity. */
 
 	static CommandExecutionError controlStatusToCommandError(la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept;
 	static CommandExecutionError aemCommandStatusToCommandError(la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept;
@@ -77,27 +82,36 @@ public:
 	AsyncParallelCommandSet() noexcept;
 	AsyncParallelCommandSet(AsyncCommand const& command) noexcept;
 	AsyncParallelCommandSet(std::vector<AsyncCommand> const& commands) noexcept;
+	AsyncParallelCommandSet(std::vector<AsyncCommand> const& commands, CommandScope const& scope) noexcept;
 
 	void append(AsyncCommand const& command) noexcept;
 	void append(std::vector<AsyncCommand> const& commands) noexcept;
+	void append(AsyncCommand const& command, CommandScope const& scope) noexcept;
+	void append(std::vector<AsyncCommand> const& commands, CommandScope const& scope) noexcept;
 
 	void addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, hive::modelsLibrary::ControllerManager::AcmpCommandType const commandType) noexcept;
 	void addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, hive::modelsLibrary::ControllerManager::AecpCommandType const commandType) noexcept;
 	void addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error) noexcept;
 
 	size_t parallelCommandCount() const noexcept;
+	CommandScope const& commandScope(uint32_t const commandIndex) const noexcept;
+	CommandExecutionErrors errors() const noexcept;
 	void exec() noexcept;
+	bool execCommand(uint32_t const commandIndex) noexcept;
 
 	void invokeCommandCompleted(uint32_t const commandIndex, bool const error) noexcept;
 
 	// Signals
+	Q_SIGNAL void commandCompleted(uint32_t const commandIndex, bool const error); // emitted after each command of this command set was executed.
 	Q_SIGNAL void commandSetCompleted(CommandExecutionErrors errors); // emitted after all commands in this command set were executed.
 
 private:
+	mutable std::mutex _errorsLock{};
 	CommandExecutionErrors _errors;
 	std::vector<AsyncCommand> _commands;
-	uint32_t _commandCompletionCounter{ 0 };
-	bool _errorOccured{ false };
+	std::vector<CommandScope> _scopes; // Scope of each command
+	std::atomic<uint32_t> _commandCompletionCounter{ 0 }; // Commands complete from the avdecc threads
+	std::atomic_bool _errorOccured{ false };
 };
 
 // **************************************************************
@@ -106,10 +120,12 @@ private:
 /**
 * @brief    Executes a list of commands that is set by calling setCommandChain().
 *			The command chain can be started with the start() method.
-*			The commands in that list are executed sequentially.
-*			All commands inside a AsyncParallelCommandSet container are executed simultaneously.
+*			The AsyncParallelCommandSet containers in that list are stages executed in order, all commands inside a container can be executed simultaneously.
+*			Commands declaring their scope (see AsyncParallelCommandSet::CommandScope) only wait for the commands of previous stages touching the same entities,
+*			so independent per-entity chains run concurrently (with at most getMaxInFlightCommandsPerEntity() commands in flight for each entity).
+*			Commands without scope wait for all commands of previous stages (and all following commands wait for them).
+*			Each time all commands addressed to an entity completed, the chainCompleted signal is invoked with the errors reported for this entity.
 *			Once all commands were executed the completed signal is invoked.
-*			The error parameter is true if at least one of the commands in the chain failed to be executed.
 *
 *			!!! This solution will be replaced by a more general and extensive state machine implementation in the future. !!!
 * [@author  Marius Erlen]
@@ -122,20 +138,38 @@ public:
 	SequentialAsyncCommandExecuter(QObject* parent = nullptr) noexcept;
 	~SequentialAsyncCommandExecuter();
 
+	static constexpr size_t DefaultMaxInFlightCommandsPerEntity = 4;
+
 	void setCommandChain(std::vector<AsyncParallelCommandSet*> const& commands) noexcept;
+	void setMaxInFlightCommandsPerEntity(size_t const maxInFlightCommands) noexcept;
+	size_t getMaxInFlightCommandsPerEntity() const noexcept;
 
 	void start() noexcept;
 
 	// Signals
 	Q_SIGNAL void progressUpdate(size_t const completedCommands, size_t const totalCommands);
+	Q_SIGNAL void chainProgressUpdate(la::avdecc::UniqueIdentifier const entityID, size_t const completedCommands, size_t const totalCommands);
+	Q_SIGNAL void chainCompleted(la::avdecc::UniqueIdentifier const entityID, CommandExecutionErrors const errors);
 	Q_SIGNAL void completed(CommandExecutionErrors const errors);
 
 private:
-	CommandExecutionErrors _errors;
+	using Scheduler = CommandScheduler<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>;
+	struct CommandLocation
+	{
+		AsyncParallelCommandSet* commandSet{ nullptr };
+		uint32_t commandIndex{ 0u };
+	};
+
+	void onCommandCompleted(Scheduler::CommandID const commandID) noexcept;
+	void dispatch() noexcept;
+	void finish() noexcept;
+
 	std::vector<AsyncParallelCommandSet*> _commands;
-	size_t _currentCommandSet{ 0 };
-	size_t _totalCommandCount{ 0 }; // includes parallel sub commands
-	size_t _completedCommandCount{ 0 }; // includes parallel sub commands
+	Scheduler _scheduler{};
+	std::vector<CommandLocation> _commandLocations{}; // Indexed by Scheduler::CommandID
+	size_t _maxInFlightCommandsPerEntity{ DefaultMaxInFlightCommandsPerEntity };
+	bool _running{ false };
+	bool _dispatching{ false };
 };
 
 } // namespace commandChain
@@ -0,0 +1,300 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+namespace avdecc
+{
+namespace commandChain
+{
+/**
+ * @Brief Dependency aware scheduler for staged commands
+ * @Details Commands are added to increasing stages, each command declaring the scope (the Keys, usually entities) it touches.
+ *          A command only depends on the commands of the previous stage touching one of its keys, so independent chains (one per key) progress concurrently.
+ *          A command with an empty scope is a barrier: it depends on all commands of previous stages, and all commands of following stages depend on it (this is the behavior of a plain sequential execution).
+ *          The first key of a scope is the chain of the command (the entity the command is addressed to), the number of commands in flight for a chain can be limited.
+ *          The scheduler does not execute anything: takeReady returns the commands to start, complete must be called when a command finished.
+ */
+template<typename Key, typename KeyHash = std::hash<Key>>
+class CommandScheduler final
+{
+public:
+	using CommandID = std::size_t;
+	using Scope = std::vector<Key>;
+
+	struct ChainProgress
+	{
+		std::size_t completedCommands{ 0u };
+		std::size_t totalCommands{ 0u };
+	};
+
+	CommandScheduler() noexcept = default;
+
+	/** Sets the maximum number of commands in flight for each chain (0 for no limit) */
+	void setMaxInFlightPerChain(std::size_t const maxInFlight) noexcept
+	{
+		_maxInFlightPerChain = maxInFlight;
+	}
+
+	/** Adds a command to the specified stage (stages must be added in increasing order), returns its ID */
+	CommandID add(std::size_t const stage, Scope const& scope) noexcept
+	{
+		if (_commands.empty() || stage != _currentStage)
+		{
+			startStage(stage);
+		}
+
+		auto const commandID = static_cast<CommandID>(_commands.size());
+		auto dependencies = std::vector<CommandID>{};
+
+		if (scope.empty())
+		{
+			// Barrier: depends on everything that is not already depended upon by a previous barrier
+			dependencies = _sinceBarrier;
+			_currentStageBarriers.push_back(commandID);
+		}
+		else
+		{
+			dependencies = _barriers;
+			for (auto const& key : scope)
+			{
+				auto& keyState = _keyStates[key];
+				if (keyState.stage != stage || keyState.current.empty())
+				{
+					keyState.previous = std::move(keyState.current);
+					keyState.current.clear();
+					keyState.stage = stage;
+				}
+				dependencies.insert(std::end(dependencies), std::begin(keyState.previous), std::end(keyState.previous));
+				keyState.current.push_back(commandID);
+			}
+			std::sort(std::begin(dependencies), std::end(dependencies));
+			dependencies.erase(std::unique(std::begin(dependencies), std::end(dependencies)), std::end(dependencies));
+
+			++_chainProgress[scope.front()].totalCommands;
+		}
+
+		auto command = Command{};
+		command.scope = scope;
+		for (auto const dependency : dependencies)
+		{
+			auto& dependencyCommand = _commands[dependency];
+			if (dependencyCommand.state != State::Completed)
+			{
+				dependencyCommand.dependents.push_back(commandID);
+				++command.remainingDependencies;
+			}
+		}
+		_commands.push_back(std::move(command));
+		_currentStageCommands.push_back(commandID);
+
+		if (_commands.back().remainingDependencies == 0u)
+		{
+			_ready.push_back(commandID);
+		}
+
+		return commandID;
+	}
+
+	/** Returns the commands that can be started now (all dependencies completed, and chain window not full), marking them as in flight */
+	std::vector<CommandID> takeReady() noexcept
+	{
+		auto started = std::vector<CommandID>{};
+		while (!_ready.empty())
+		{
+			auto const commandID = _ready.front();
+			_ready.pop_front();
+
+			auto& command = _commands[commandID];
+			if (!command.scope.empty() && _maxInFlightPerChain != 0u)
+			{
+				auto& chain = _chainStates[command.scope.front()];
+				if (chain.inFlight >= _maxInFlightPerChain)
+				{
+					// Wait for a command of the same chain to complete
+					chain.waiting.push_back(commandID);
+					continue;
+				}
+				++chain.inFlight;
+			}
+			command.state = State::InFlight;
+			started.push_back(commandID);
+		}
+		return started;
+	}
+
+	/** Marks an in flight command as completed, returns false if the command was not in flight */
+	bool complete(CommandID const commandID) noexcept
+	{
+		if (commandID >= _commands.size() || _commands[commandID].state != State::InFlight)
+		{
+			return false;
+		}
+
+		auto& command = _commands[commandID];
+		command.state = State::Completed;
+		++_completedCount;
+
+		if (!command.scope.empty())
+		{
+			auto const& chainKey = command.scope.front();
+			++_chainProgress[chainKey].completedCommands;
+			if (_maxInFlightPerChain != 0u)
+			{
+				auto& chain = _chainStates[chainKey];
+				--chain.inFlight;
+				if (!chain.waiting.empty())
+				{
+					_ready.push_front(chain.waiting.front());
+					chain.waiting.pop_front();
+				}
+			}
+		}
+
+		for (auto const dependent : command.dependents)
+		{
+			if (--_commands[dependent].remainingDependencies == 0u)
+			{
+				_ready.push_back(dependent);
+			}
+		}
+
+		return true;
+	}
+
+	std::size_t commandCount() const noexcept
+	{
+		return _commands.size();
+	}
+
+	std::size_t completedCount() const noexcept
+	{
+		return _completedCount;
+	}
+
+	bool isFinished() const noexcept
+	{
+		return _completedCount == _commands.size();
+	}
+
+	/** Returns the scope of the specified command */
+	Scope const& scope(CommandID const commandID) const noexcept
+	{
+		return _commands[commandID].scope;
+	}
+
+	/** Returns the progress of the chain for the specified key (commands which scope starts with that key) */
+	ChainProgress chainProgress(Key const& key) const noexcept
+	{
+		auto const it = _chainProgress.find(key);
+		if (it == std::end(_chainProgress))
+		{
+			return {};
+		}
+		return it->second;
+	}
+
+	void clear() noexcept
+	{
+		_commands.clear();
+		_keyStates.clear();
+		_chainStates.clear();
+		_chainProgress.clear();
+		_ready.clear();
+		_barriers.clear();
+		_sinceBarrier.clear();
+		_currentStageBarriers.clear();
+		_currentStageCommands.clear();
+		_currentStage = 0u;
+		_completedCount = 0u;
+	}
+
+	// Deleted compiler auto-generated methods
+	CommandScheduler(CommandScheduler const&) = delete;
+	CommandScheduler(CommandScheduler&&) = delete;
+	CommandScheduler& operator=(CommandScheduler const&) = delete;
+	CommandScheduler& operator=(CommandScheduler&&) = delete;
+
+private:
+	enum class State
+	{
+		Pending,
+		InFlight,
+		Completed,
+	};
+	struct Command
+	{
+		Scope scope{};
+		std::vector<CommandID> dependents{};
+		std::size_t remainingDependencies{ 0u };
+		State state{ State::Pending };
+	};
+	struct KeyState
+	{
+		std::size_t stage{ 0u };
+		std::vector<CommandID> previous{}; // Commands of the latest stage before 'stage' touching the key
+		std::vector<CommandID> current{}; // Commands of 'stage' touching the key
+	};
+	struct ChainState
+	{
+		std::size_t inFlight{ 0u };
+		std::deque<CommandID> waiting{};
+	};
+
+	void startStage(std::size_t const stage) noexcept
+	{
+		if (!_currentStageBarriers.empty())
+		{
+			// Previous stage contained barriers, everything before it is now covered by them
+			_barriers = std::move(_currentStageBarriers);
+			_currentStageBarriers.clear();
+			_sinceBarrier = std::move(_currentStageCommands);
+		}
+		else
+		{
+			_sinceBarrier.insert(std::end(_sinceBarrier), std::begin(_currentStageCommands), std::end(_currentStageCommands));
+		}
+		_currentStageCommands.clear();
+		_currentStage = stage;
+	}
+
+	std::vector<Command> _commands{};
+	std::unordered_map<Key, KeyState, KeyHash> _keyStates{};
+	std::unordered_map<Key, ChainState, KeyHash> _chainStates{};
+	std::unordered_map<Key, ChainProgress, KeyHash> _chainProgress{};
+	std::deque<CommandID> _ready{};
+	std::vector<CommandID> _barriers{}; // Barriers of the latest stage containing some
+	std::vector<CommandID> _sinceBarrier{}; // Commands of previous stages, since (and including) the latest stage containing barriers
+	std::vector<CommandID> _currentStageBarriers{};
+	std::vector<CommandID> _currentStageCommands{};
+	std::size_t _currentStage{ 0u };
+	std::size_t _completedCount{ 0u };
+	std::size_t _maxInFlightPerChain{ 0u };
+};
+
+} // namespace commandChain
+} // namespace avdecc
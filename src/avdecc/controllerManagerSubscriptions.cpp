@@ -0,0 +1,201 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "controllerManagerSubscriptions.hpp"
+
+#include <chrono>
+
+namespace avdecc
+{
+namespace
+{
+using ControllerManager = hive::modelsLibrary::ControllerManager;
+using DescriptorType = la::avdecc::entity::model::DescriptorType;
+using DescriptorIndex = la::avdecc::entity::model::DescriptorIndex;
+using ConfigurationIndex = la::avdecc::entity::model::ConfigurationIndex;
+
+static constexpr auto StatisticsInterval = std::chrono::seconds{ 1 };
+
+/** Key extractor for signals about the entity itself */
+template<typename... Args>
+DescriptorKey entityKey(la::avdecc::UniqueIdentifier const entityID, Args const&...) noexcept
+{
+	return DescriptorKey{ entityID, DescriptorType::Entity, DescriptorIndex{ 0u } };
+}
+
+/** Key extractor for signals with a (entityID, descriptorIndex, ...) signature */
+template<DescriptorType Type>
+struct IndexedKey
+{
+	template<typename Index, typename... Args>
+	DescriptorKey operator()(la::avdecc::UniqueIdentifier const entityID, Index const descriptorIndex, Args const&...) const noexcept
+	{
+		return DescriptorKey{ entityID, Type, DescriptorIndex{ descriptorIndex } };
+	}
+};
+
+/** Key extractor for signals with a (entityID, configurationIndex, descriptorIndex, ...) signature */
+template<DescriptorType Type>
+struct ConfigurationIndexedKey
+{
+	template<typename Index, typename... Args>
+	DescriptorKey operator()(la::avdecc::UniqueIdentifier const entityID, ConfigurationIndex const /*configurationIndex*/, Index const descriptorIndex, Args const&...) const noexcept
+	{
+		return DescriptorKey{ entityID, Type, DescriptorIndex{ descriptorIndex } };
+	}
+};
+
+/** Key extractor for signals with a (entityID, descriptorType, descriptorIndex, ...) signature */
+struct TypedKey
+{
+	template<typename Index, typename... Args>
+	DescriptorKey operator()(la::avdecc::UniqueIdentifier const entityID, DescriptorType const descriptorType, Index const descriptorIndex, Args const&...) const noexcept
+	{
+		return DescriptorKey{ entityID, descriptorType, DescriptorIndex{ descriptorIndex } };
+	}
+};
+
+/** Key extractor for signals with a (entityID, configurationIndex, descriptorType, descriptorIndex, ...) signature */
+struct ConfigurationTypedKey
+{
+	template<typename Index, typename... Args>
+	DescriptorKey operator()(la::avdecc::UniqueIdentifier const entityID, ConfigurationIndex const /*configurationIndex*/, DescriptorType const descriptorType, Index const descriptorIndex, Args const&...) const noexcept
+	{
+		return DescriptorKey{ entityID, descriptorType, DescriptorIndex{ descriptorIndex } };
+	}
+};
+
+} // namespace
+
+template<typename... Args, typename KeyExtractor>
+void ControllerManagerSubscriptions::route(void (ControllerManager::*signal)(Args...), KeyExtractor&& keyExtractor) noexcept
+{
+	auto signalRegistry = std::make_unique<SignalRegistry<Args...>>();
+	auto& registry = signalRegistry->registry;
+	_registries.emplace(getSignalIndex(signal), std::move(signalRegistry));
+
+	connect(&ControllerManager::getInstance(), signal, this,
+		[&registry, keyExtractor = std::forward<KeyExtractor>(keyExtractor)](Args... args)
+		{
+			registry.notify(keyExtractor(args...), args...);
+		});
+}
+
+ControllerManagerSubscriptions::ControllerManagerSubscriptions() noexcept
+{
+	auto const entity = [](la::avdecc::UniqueIdentifier const entityID, auto const&... args)
+	{
+		return entityKey(entityID, args...);
+	};
+
+	// Entity
+	route(&ControllerManager::entityNameChanged, entity);
+	route(&ControllerManager::entityGroupNameChanged, entity);
+	route(&ControllerManager::associationIDChanged, entity);
+	route(&ControllerManager::compatibilityChanged, entity);
+	route(&ControllerManager::unsolicitedRegistrationChanged, entity);
+	route(&ControllerManager::acquireStateChanged, entity);
+	route(&ControllerManager::lockStateChanged, entity);
+	route(&ControllerManager::systemUniqueIDChanged, entity);
+
+	// Descriptor names
+	route(&ControllerManager::configurationNameChanged,
+		[](la::avdecc::UniqueIdentifier const entityID, ConfigurationIndex const configurationIndex, QString const&)
+		{
+			return DescriptorKey{ entityID, DescriptorType::Configuration, DescriptorIndex{ configurationIndex } };
+		});
+	route(&ControllerManager::audioUnitNameChanged, ConfigurationIndexedKey<DescriptorType::AudioUnit>{});
+	route(&ControllerManager::streamNameChanged, ConfigurationTypedKey{});
+	route(&ControllerManager::jackNameChanged, ConfigurationTypedKey{});
+	route(&ControllerManager::avbInterfaceNameChanged, ConfigurationIndexedKey<DescriptorType::AvbInterface>{});
+	route(&ControllerManager::clockSourceNameChanged, ConfigurationIndexedKey<DescriptorType::ClockSource>{});
+	route(&ControllerManager::memoryObjectNameChanged, ConfigurationIndexedKey<DescriptorType::MemoryObject>{});
+	route(&ControllerManager::audioClusterNameChanged, ConfigurationIndexedKey<DescriptorType::AudioCluster>{});
+	route(&ControllerManager::controlNameChanged, ConfigurationIndexedKey<DescriptorType::Control>{});
+	route(&ControllerManager::clockDomainNameChanged, ConfigurationIndexedKey<DescriptorType::ClockDomain>{});
+	route(&ControllerManager::timingNameChanged, ConfigurationIndexedKey<DescriptorType::Timing>{});
+	route(&ControllerManager::ptpInstanceNameChanged, ConfigurationIndexedKey<DescriptorType::PtpInstance>{});
+	route(&ControllerManager::ptpPortNameChanged, ConfigurationIndexedKey<DescriptorType::PtpPort>{});
+
+	// Descriptor states
+	route(&ControllerManager::audioUnitSamplingRateChanged, IndexedKey<DescriptorType::AudioUnit>{});
+	route(&ControllerManager::clockSourceChanged, IndexedKey<DescriptorType::ClockDomain>{});
+	route(&ControllerManager::mediaClockReferenceInfoChanged, IndexedKey<DescriptorType::ClockDomain>{});
+	route(&ControllerManager::controlValuesChanged, IndexedKey<DescriptorType::Control>{});
+	route(&ControllerManager::streamFormatChanged, TypedKey{});
+	route(&ControllerManager::streamRunningChanged, TypedKey{});
+	route(&ControllerManager::streamDynamicInfoChanged, TypedKey{});
+	route(&ControllerManager::streamPortAudioMappingsChanged, TypedKey{});
+	route(&ControllerManager::maxTransitTimeChanged, IndexedKey<DescriptorType::StreamOutput>{});
+	route(&ControllerManager::streamOutputConnectionsChanged,
+		[](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const&)
+		{
+			return DescriptorKey{ stream.entityID, DescriptorType::StreamOutput, DescriptorIndex{ stream.streamIndex } };
+		});
+	route(&ControllerManager::streamInputConnectionChanged,
+		[](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const&)
+		{
+			return DescriptorKey{ stream.entityID, DescriptorType::StreamInput, DescriptorIndex{ stream.streamIndex } };
+		});
+	route(&ControllerManager::gptpChanged, IndexedKey<DescriptorType::AvbInterface>{});
+	route(&ControllerManager::avbInterfaceInfoChanged, IndexedKey<DescriptorType::AvbInterface>{});
+	route(&ControllerManager::avbInterfaceLinkStatusChanged, IndexedKey<DescriptorType::AvbInterface>{});
+	route(&ControllerManager::asPathChanged, IndexedKey<DescriptorType::AvbInterface>{});
+	route(&ControllerManager::memoryObjectLengthChanged, ConfigurationIndexedKey<DescriptorType::MemoryObject>{});
+
+	connect(&_statisticsTimer, &QTimer::timeout, this, &ControllerManagerSubscriptions::updateStatistics);
+	_statisticsTimer.start(StatisticsInterval);
+}
+
+ControllerManagerSubscriptions& ControllerManagerSubscriptions::getInstance() noexcept
+{
+	static ControllerManagerSubscriptions s_subscriptions{};
+
+	return s_subscriptions;
+}
+
+std::size_t ControllerManagerSubscriptions::getSubscriptionsCount() const noexcept
+{
+	auto count = std::size_t{ 0u };
+	for (auto const& [signalIndex, registry] : _registries)
+	{
+		count += registry->subscriptionsCount();
+	}
+	return count;
+}
+
+void ControllerManagerSubscriptions::updateStatistics() noexcept
+{
+	auto invokedCount = std::uint64_t{ 0u };
+	auto avoidedCount = std::uint64_t{ 0u };
+	for (auto const& [signalIndex, registry] : _registries)
+	{
+		invokedCount += registry->invokedCount();
+		avoidedCount += registry->avoidedCount();
+	}
+
+	auto const invokedPerSecond = invokedCount - _lastInvokedCount;
+	auto const avoidedPerSecond = avoidedCount - _lastAvoidedCount;
+	_lastInvokedCount = invokedCount;
+	_lastAvoidedCount = avoidedCount;
+
+	emit statisticsUpdated(invokedPerSecond, avoidedPerSecond);
+}
+
+} // namespace avdecc
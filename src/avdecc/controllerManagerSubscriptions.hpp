@@ -0,0 +1,155 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/subscriptionRegistry.hpp"
+
+#include <hive/modelsLibrary/controllerManager.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include <QObject>
+#include <QMetaMethod>
+#include <QTimer>
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace avdecc
+{
+/** Descriptor a ControllerManager notification is about */
+struct DescriptorKey
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Entity };
+	la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+
+	bool operator==(DescriptorKey const& other) const noexcept
+	{
+		return std::tie(entityID, descriptorType, descriptorIndex) == std::tie(other.entityID, other.descriptorType, other.descriptorIndex);
+	}
+
+	struct hash
+	{
+		std::size_t operator()(DescriptorKey const& key) const noexcept
+		{
+			auto const descriptor = (std::uint64_t{ la::avdecc::utils::to_integral(key.descriptorType) } << 16) | key.descriptorIndex;
+			return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ std::hash<std::uint64_t>{}(descriptor * 0x9E3779B97F4A7C15ull);
+		}
+	};
+};
+
+// **************************************************************
+// class ControllerManagerSubscriptions
+// **************************************************************
+/**
+	* @brief    Dispatches the ControllerManager notifications to the handlers subscribed to the descriptor they are about.
+	* @details  Each routed signal is connected once, the notification is then only forwarded to the handlers subscribed to the same
+	*			(entityID, descriptorType, descriptorIndex), instead of every handler connected to the signal checking the entityID itself.
+	*			A subscription is automatically removed when its context object is destroyed.
+	*/
+class ControllerManagerSubscriptions final : public QObject
+{
+	Q_OBJECT
+public:
+	static ControllerManagerSubscriptions& getInstance() noexcept;
+
+	/** Subscribes the handler (called with all the arguments of the signal) to the notifications about the descriptor. The subscription lasts as long as the context object */
+	template<typename... Args, typename Handler>
+	void subscribe(void (hive::modelsLibrary::ControllerManager::*signal)(Args...), DescriptorKey const& key, QObject* const context, Handler&& handler) noexcept
+	{
+		auto const registryIt = _registries.find(getSignalIndex(signal));
+		if (registryIt == _registries.end())
+		{
+			AVDECC_ASSERT(false, "Signal is not routed by ControllerManagerSubscriptions");
+			return;
+		}
+
+		auto& registry = static_cast<SignalRegistry<Args...>&>(*registryIt->second).registry;
+		auto const subscriptionID = registry.subscribe(key, std::forward<Handler>(handler));
+		connect(context, &QObject::destroyed, this,
+			[&registry, subscriptionID]()
+			{
+				registry.unsubscribe(subscriptionID);
+			});
+	}
+
+	std::size_t getSubscriptionsCount() const noexcept;
+
+	/* Emitted every second with the number of handlers invoked during the last second, and the number of invocations avoided compared to connecting every handler to the signal */
+	Q_SIGNAL void statisticsUpdated(std::uint64_t const invokedPerSecond, std::uint64_t const avoidedPerSecond);
+
+	// Deleted compiler auto-generated methods
+	ControllerManagerSubscriptions(ControllerManagerSubscriptions const&) = delete;
+	ControllerManagerSubscriptions(ControllerManagerSubscriptions&&) = delete;
+	ControllerManagerSubscriptions& operator=(ControllerManagerSubscriptions const&) = delete;
+	ControllerManagerSubscriptions& operator=(ControllerManagerSubscriptions&&) = delete;
+
+private:
+	struct Registry
+	{
+		virtual ~Registry() noexcept = default;
+		virtual std::size_t subscriptionsCount() const noexcept = 0;
+		virtual std::uint64_t invokedCount() const noexcept = 0;
+		virtual std::uint64_t avoidedCount() const noexcept = 0;
+	};
+
+	template<typename... Args>
+	struct SignalRegistry final : Registry
+	{
+		virtual std::size_t subscriptionsCount() const noexcept override
+		{
+			return registry.subscriptionsCount();
+		}
+		virtual std::uint64_t invokedCount() const noexcept override
+		{
+			return registry.invokedCount();
+		}
+		virtual std::uint64_t avoidedCount() const noexcept override
+		{
+			return registry.avoidedCount();
+		}
+
+		SubscriptionRegistry<DescriptorKey, void(Args...), DescriptorKey::hash> registry{};
+	};
+
+	ControllerManagerSubscriptions() noexcept;
+
+	template<typename... Args>
+	static int getSignalIndex(void (hive::modelsLibrary::ControllerManager::*signal)(Args...)) noexcept
+	{
+		return QMetaMethod::fromSignal(signal).methodIndex();
+	}
+
+	/** Connects the signal once, dispatching each notification to the handlers subscribed to the descriptor returned by keyExtractor */
+	template<typename... Args, typename KeyExtractor>
+	void route(void (hive::modelsLibrary::ControllerManager::*signal)(Args...), KeyExtractor&& keyExtractor) noexcept;
+
+	void updateStatistics() noexcept;
+
+	std::unordered_map<int, std::unique_ptr<Registry>> _registries{};
+	QTimer _statisticsTimer{};
+	std::uint64_t _lastInvokedCount{ 0u };
+	std::uint64_t _lastAvoidedCount{ 0u };
+};
+
+} // namespace avdecc
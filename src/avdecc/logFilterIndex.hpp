@@ -0,0 +1,357 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace avdecc
+{
+/**
+ * @Brief Incremental index of log entries, to quickly find the entries matching a filter
+ * @Details Entries are identified by a sequence number, incremented for each appended entry. The oldest entries can be evicted.
+ *          Layers and levels are indexed with one bitmap per value, messages with a trigrams signature (a small bloom filter of their lowercase trigrams).
+ *          Signatures only discard entries that cannot contain the searched text, the remaining candidates have to be checked by the caller provided predicate.
+ *          Messages longer than 66 characters (MaxSignedMessageLength) are not signed: their trigrams would saturate the signature, so they
+ *          always pass the signature test and fall back to a linear scan by the predicate. A prefix cannot be signed instead, as the
+ *          searched text may be found after it.
+ */
+template<typename Layer, typename Level>
+class LogFilterIndex final
+{
+public:
+	using Sequence = std::uint64_t;
+
+	struct Filter
+	{
+		std::optional<std::vector<Layer>> layers{}; // Accepted layers (all if not set)
+		std::optional<std::vector<Level>> levels{}; // Accepted levels (all if not set)
+		std::string text{}; // Text the messages must contain (ASCII case insensitive), only used to discard entries using their signature
+	};
+
+	explicit LogFilterIndex(Sequence const firstSequence = 0u) noexcept
+	{
+		reset(firstSequence);
+	}
+
+	/** Sequence of the oldest indexed entry */
+	Sequence firstSequence() const noexcept
+	{
+		return _firstSequence;
+	}
+
+	/** Sequence the next appended entry will get */
+	Sequence endSequence() const noexcept
+	{
+		return _firstSequence + _signatures.size();
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _signatures.size();
+	}
+
+	/** Removes all entries, the next appended entry will get the specified sequence */
+	void reset(Sequence const firstSequence) noexcept
+	{
+		_firstSequence = firstSequence;
+		_wordsBaseSequence = firstSequence - (firstSequence % BitsPerWord);
+		_signatures.clear();
+		_layerValues.clear();
+		_layerBitmaps.clear();
+		_levelValues.clear();
+		_levelBitmaps.clear();
+	}
+
+	void append(Layer const layer, Level const level, std::string_view const message) noexcept
+	{
+		auto const sequence = endSequence();
+
+		// Start a new word in all bitmaps
+		if (sequence % BitsPerWord == 0u && sequence != _wordsBaseSequence)
+		{
+			for (auto& bitmap : _layerBitmaps)
+			{
+				bitmap.push_back(0u);
+			}
+			for (auto& bitmap : _levelBitmaps)
+			{
+				bitmap.push_back(0u);
+			}
+		}
+
+		setBit(bitmapFor(_layerValues, _layerBitmaps, layer), sequence);
+		setBit(bitmapFor(_levelValues, _levelBitmaps, level), sequence);
+		_signatures.push_back(entrySignature(message));
+	}
+
+	/** Evicts the count oldest entries */
+	void evict(std::size_t const count) noexcept
+	{
+		auto const evictions = std::min(count, _signatures.size());
+		_signatures.erase(_signatures.begin(), _signatures.begin() + evictions);
+		_firstSequence += evictions;
+
+		// Release the words no longer used (keeping at least one)
+		auto const wordsCount = wordsCountForBitmaps();
+		auto const unusedWords = std::min(static_cast<std::size_t>((_firstSequence - _wordsBaseSequence) / BitsPerWord), wordsCount > 0u ? wordsCount - 1u : 0u);
+		if (unusedWords > 0u)
+		{
+			for (auto& bitmap : _layerBitmaps)
+			{
+				bitmap.erase(bitmap.begin(), bitmap.begin() + unusedWords);
+			}
+			for (auto& bitmap : _levelBitmaps)
+			{
+				bitmap.erase(bitmap.begin(), bitmap.begin() + unusedWords);
+			}
+			_wordsBaseSequence += unusedWords * BitsPerWord;
+		}
+	}
+
+	/** Returns the sequences in [begin, end) matching the filter and the predicate (only called for entries matching the filter) */
+	template<typename Predicate>
+	std::vector<Sequence> find(Filter const& filter, Sequence const begin, Sequence const end, Predicate const& predicate) const
+	{
+		auto result = std::vector<Sequence>{};
+
+		auto const first = std::max(begin, _firstSequence);
+		auto const last = std::min(end, endSequence());
+		if (first >= last)
+		{
+			return result;
+		}
+
+		auto const layerBitmaps = selectedBitmaps(_layerValues, _layerBitmaps, filter.layers);
+		auto const levelBitmaps = selectedBitmaps(_levelValues, _levelBitmaps, filter.levels);
+		auto const textSignature = signature(filter.text);
+
+		for (auto wordIndex = static_cast<std::size_t>((first - _wordsBaseSequence) / BitsPerWord); wordIndex <= static_cast<std::size_t>((last - 1u - _wordsBaseSequence) / BitsPerWord); ++wordIndex)
+		{
+			auto const wordSequence = _wordsBaseSequence + wordIndex * BitsPerWord;
+			auto word = mergedWord(layerBitmaps, filter.layers.has_value(), wordIndex) & mergedWord(levelBitmaps, filter.levels.has_value(), wordIndex);
+
+			// Mask out sequences outside the range
+			if (wordSequence < first)
+			{
+				word &= ~std::uint64_t{ 0u } << (first - wordSequence);
+			}
+			if (last - wordSequence < BitsPerWord)
+			{
+				word &= ~(~std::uint64_t{ 0u } << (last - wordSequence));
+			}
+
+			while (word != 0u)
+			{
+				auto const sequence = wordSequence + lowestBitIndex(word);
+				word &= word - 1u;
+				if (containsSignature(_signatures[static_cast<std::size_t>(sequence - _firstSequence)], textSignature) && predicate(sequence))
+				{
+					result.push_back(sequence);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	/** Returns the sequences of candidates (ordered, and still indexed) matching the filter and the predicate */
+	template<typename Sequences, typename Predicate>
+	std::vector<Sequence> refine(Filter const& filter, Sequences const& candidates, Predicate const& predicate) const
+	{
+		auto result = std::vector<Sequence>{};
+
+		auto const layerBitmaps = selectedBitmaps(_layerValues, _layerBitmaps, filter.layers);
+		auto const levelBitmaps = selectedBitmaps(_levelValues, _levelBitmaps, filter.levels);
+		auto const textSignature = signature(filter.text);
+
+		for (auto const sequence : candidates)
+		{
+			if (sequence < _firstSequence || sequence >= endSequence())
+			{
+				continue;
+			}
+			auto const wordIndex = static_cast<std::size_t>((sequence - _wordsBaseSequence) / BitsPerWord);
+			auto const bit = std::uint64_t{ 1u } << ((sequence - _wordsBaseSequence) % BitsPerWord);
+			if ((mergedWord(layerBitmaps, filter.layers.has_value(), wordIndex) & mergedWord(levelBitmaps, filter.levels.has_value(), wordIndex) & bit) != 0u && containsSignature(_signatures[static_cast<std::size_t>(sequence - _firstSequence)], textSignature) && predicate(sequence))
+			{
+				result.push_back(sequence);
+			}
+		}
+
+		return result;
+	}
+
+	/** Returns true if haystack contains needle, ignoring ASCII case */
+	static bool containsCaseInsensitive(std::string_view const haystack, std::string_view const needle) noexcept
+	{
+		auto const it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+			[](char const lhs, char const rhs)
+			{
+				return toLower(lhs) == toLower(rhs);
+			});
+		return it != haystack.end() || needle.empty();
+	}
+
+	// Deleted compiler auto-generated methods
+	LogFilterIndex(LogFilterIndex const&) = delete;
+	LogFilterIndex(LogFilterIndex&&) = delete;
+	LogFilterIndex& operator=(LogFilterIndex const&) = delete;
+	LogFilterIndex& operator=(LogFilterIndex&&) = delete;
+
+private:
+	static constexpr auto BitsPerWord = Sequence{ 64u };
+	static constexpr auto MaxSignedMessageLength = std::size_t{ 66u }; // Up to 64 trigrams, filling about 40% of the signature bits (longer messages would saturate it)
+
+	using Bitmap = std::deque<std::uint64_t>;
+	using Signature = std::array<std::uint64_t, 2>;
+
+	static char toLower(char const c) noexcept
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	static Signature entrySignature(std::string_view const message) noexcept
+	{
+		if (message.size() > MaxSignedMessageLength)
+		{
+			// Matches any text signature
+			return Signature{ ~std::uint64_t{ 0u }, ~std::uint64_t{ 0u } };
+		}
+		return signature(message);
+	}
+
+	static Signature signature(std::string_view const text) noexcept
+	{
+		auto result = Signature{};
+		for (auto index = std::size_t{ 2u }; index < text.size(); ++index)
+		{
+			auto const trigram = (static_cast<std::uint32_t>(static_cast<std::uint8_t>(toLower(text[index - 2u]))) << 16) | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(toLower(text[index - 1u]))) << 8) | static_cast<std::uint32_t>(static_cast<std::uint8_t>(toLower(text[index])));
+			// Fibonacci hashing to spread the trigrams over the signature bits
+			auto const bit = static_cast<std::size_t>((trigram * 2654435769u) >> 25); // 7 bits: 0-127
+			result[bit / 64u] |= std::uint64_t{ 1u } << (bit % 64u);
+		}
+		return result;
+	}
+
+	static bool containsSignature(Signature const& entrySignature, Signature const& textSignature) noexcept
+	{
+		return (entrySignature[0] & textSignature[0]) == textSignature[0] && (entrySignature[1] & textSignature[1]) == textSignature[1];
+	}
+
+	static std::size_t lowestBitIndex(std::uint64_t const word) noexcept
+	{
+		auto index = std::size_t{ 0u };
+		auto w = word;
+		while ((w & 0xFFFFFFFFu) == 0u)
+		{
+			w >>= 32;
+			index += 32u;
+		}
+		while ((w & 0xFFu) == 0u)
+		{
+			w >>= 8;
+			index += 8u;
+		}
+		while ((w & 1u) == 0u)
+		{
+			w >>= 1;
+			++index;
+		}
+		return index;
+	}
+
+	std::size_t wordsCountForBitmaps() const noexcept
+	{
+		if (!_layerBitmaps.empty())
+		{
+			return _layerBitmaps.front().size();
+		}
+		return 0u;
+	}
+
+	template<typename Value>
+	Bitmap& bitmapFor(std::vector<Value>& values, std::vector<Bitmap>& bitmaps, Value const value) noexcept
+	{
+		auto const it = std::find(values.begin(), values.end(), value);
+		if (it != values.end())
+		{
+			return bitmaps[static_cast<std::size_t>(std::distance(values.begin(), it))];
+		}
+
+		// New value, its bitmap covers the same words than the others
+		values.push_back(value);
+		auto const wordsCount = static_cast<std::size_t>((endSequence() - _wordsBaseSequence) / BitsPerWord) + 1u;
+		return bitmaps.emplace_back(wordsCount, std::uint64_t{ 0u });
+	}
+
+	void setBit(Bitmap& bitmap, Sequence const sequence) noexcept
+	{
+		auto const offset = sequence - _wordsBaseSequence;
+		bitmap[static_cast<std::size_t>(offset / BitsPerWord)] |= std::uint64_t{ 1u } << (offset % BitsPerWord);
+	}
+
+	template<typename Value>
+	static std::vector<Bitmap const*> selectedBitmaps(std::vector<Value> const& values, std::vector<Bitmap> const& bitmaps, std::optional<std::vector<Value>> const& selection) noexcept
+	{
+		auto result = std::vector<Bitmap const*>{};
+		if (selection)
+		{
+			for (auto index = std::size_t{ 0u }; index < values.size(); ++index)
+			{
+				if (std::find(selection->begin(), selection->end(), values[index]) != selection->end())
+				{
+					result.push_back(&bitmaps[index]);
+				}
+			}
+		}
+		return result;
+	}
+
+	static std::uint64_t mergedWord(std::vector<Bitmap const*> const& bitmaps, bool const isFiltered, std::size_t const wordIndex) noexcept
+	{
+		if (!isFiltered)
+		{
+			return ~std::uint64_t{ 0u };
+		}
+		auto word = std::uint64_t{ 0u };
+		for (auto const* bitmap : bitmaps)
+		{
+			word |= (*bitmap)[wordIndex];
+		}
+		return word;
+	}
+
+	Sequence _firstSequence{ 0u };
+	Sequence _wordsBaseSequence{ 0u }; // Sequence of the first bit of the first word of all bitmaps
+	std::deque<Signature> _signatures{};
+	std::vector<Layer> _layerValues{};
+	std::vector<Bitmap> _layerBitmaps{};
+	std::vector<Level> _levelValues{};
+	std::vector<Bitmap> _levelBitmaps{};
+};
+
+} // namespace avdecc
@@ -0,0 +1,511 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "logJournal.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // !NOMINMAX
+#	include <Windows.h>
+#	include <io.h>
+#else // !_WIN32
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // _WIN32
+
+namespace avdecc
+{
+namespace
+{
+constexpr auto SegmentMagic = std::array<char, 8>{ 'H', 'I', 'V', 'E', 'L', 'O', 'G', 'J' };
+constexpr auto SegmentVersion = std::uint32_t{ 1u };
+constexpr auto SegmentHeaderSize = std::size_t{ 24u }; // Magic, Version, Reserved, FirstSequence
+constexpr auto RecordHeaderSize = std::size_t{ 20u }; // MessageLength, Layer, Level, Timestamp
+
+template<typename T>
+void writeValue(char* const destination, T const value) noexcept
+{
+	std::memcpy(destination, &value, sizeof(T));
+}
+
+template<typename T>
+T readValue(char const* const source) noexcept
+{
+	auto value = T{};
+	std::memcpy(&value, source, sizeof(T));
+	return value;
+}
+} // namespace
+
+/* ************************************************************ */
+/* MappedSegment                                                */
+/* ************************************************************ */
+std::unique_ptr<LogJournal::MappedSegment> LogJournal::MappedSegment::open(std::filesystem::path const& path) noexcept
+{
+	auto segment = std::unique_ptr<MappedSegment>{ new MappedSegment };
+
+#ifdef _WIN32
+	auto const file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	auto fileSize = LARGE_INTEGER{};
+	if (!::GetFileSizeEx(file, &fileSize) || static_cast<std::size_t>(fileSize.QuadPart) < SegmentHeaderSize)
+	{
+		::CloseHandle(file);
+		return nullptr;
+	}
+	auto const mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	::CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return nullptr;
+	}
+	auto const* const view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		::CloseHandle(mapping);
+		return nullptr;
+	}
+	segment->_mappingHandle = mapping;
+	segment->_data = static_cast<char const*>(view);
+	segment->_dataSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else // !_WIN32
+	auto const fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	struct stat fileStat;
+	if (::fstat(fd, &fileStat) != 0 || static_cast<std::size_t>(fileStat.st_size) < SegmentHeaderSize)
+	{
+		::close(fd);
+		return nullptr;
+	}
+	auto* const view = ::mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED)
+	{
+		return nullptr;
+	}
+	segment->_data = static_cast<char const*>(view);
+	segment->_dataSize = static_cast<std::size_t>(fileStat.st_size);
+#endif // _WIN32
+
+	// Check the header
+	if (std::memcmp(segment->_data, SegmentMagic.data(), SegmentMagic.size()) != 0 || readValue<std::uint32_t>(segment->_data + 8) != SegmentVersion)
+	{
+		return nullptr;
+	}
+	segment->_firstSequence = readValue<Sequence>(segment->_data + 16);
+
+	// Index the records, ignoring a truncated last one
+	auto offset = SegmentHeaderSize;
+	while (offset + RecordHeaderSize <= segment->_dataSize)
+	{
+		auto const recordSize = RecordHeaderSize + readValue<std::uint32_t>(segment->_data + offset);
+		if (offset + recordSize > segment->_dataSize)
+		{
+			break;
+		}
+		segment->_offsets.push_back(static_cast<std::uint32_t>(offset));
+		offset += recordSize;
+	}
+
+	return segment;
+}
+
+LogJournal::MappedSegment::~MappedSegment() noexcept
+{
+	if (_data != nullptr)
+	{
+#ifdef _WIN32
+		::UnmapViewOfFile(_data);
+		::CloseHandle(static_cast<HANDLE>(_mappingHandle));
+#else // !_WIN32
+		::munmap(const_cast<char*>(_data), _dataSize);
+#endif // _WIN32
+	}
+}
+
+LogJournal::Sequence LogJournal::MappedSegment::firstSequence() const noexcept
+{
+	return _firstSequence;
+}
+
+std::size_t LogJournal::MappedSegment::size() const noexcept
+{
+	return _offsets.size();
+}
+
+LogJournal::Record LogJournal::MappedSegment::record(std::size_t const index) const noexcept
+{
+	auto const* const data = _data + _offsets[index];
+	auto const length = readValue<std::uint32_t>(data);
+	return Record{ readValue<std::int64_t>(data + 12), readValue<std::uint32_t>(data + 4), readValue<std::uint32_t>(data + 8), std::string_view{ data + RecordHeaderSize, length } };
+}
+
+/* ************************************************************ */
+/* LogJournal                                                   */
+/* ************************************************************ */
+LogJournal::LogJournal(Configuration const& configuration) noexcept
+	: _configuration{ configuration }
+{
+	auto error = std::error_code{};
+	std::filesystem::create_directories(_configuration.directory, error);
+	if (error || !std::filesystem::is_directory(_configuration.directory, error))
+	{
+		return;
+	}
+
+	_isOpen = true;
+	_buffer.reserve(_configuration.maxBufferSize);
+	_lastSyncTime = std::chrono::steady_clock::now();
+	_writerThread = std::thread{ &LogJournal::writerThread, this };
+}
+
+LogJournal::~LogJournal() noexcept
+{
+	if (_writerThread.joinable())
+	{
+		{
+			auto const lg = std::lock_guard{ _lock };
+			_shouldTerminate = true;
+		}
+		_writerCondition.notify_one();
+		_writerThread.join();
+	}
+}
+
+bool LogJournal::isOpen() const noexcept
+{
+	return _isOpen;
+}
+
+bool LogJournal::hasFailed() const noexcept
+{
+	auto const lg = std::lock_guard{ _lock };
+	return _hasFailed;
+}
+
+void LogJournal::append(Record const& record) noexcept
+{
+	if (!_isOpen)
+	{
+		return;
+	}
+
+	auto const recordSize = RecordHeaderSize + record.message.size();
+	auto shouldWakeWriter = false;
+	{
+		auto lock = std::unique_lock{ _lock };
+		++_nextSequence;
+		if (_hasFailed)
+		{
+			return;
+		}
+
+		// Wait for the writer to make room (a record larger than the buffer is accepted in an empty buffer)
+		_appendCondition.wait(lock,
+			[this, recordSize]()
+			{
+				return _buffer.empty() || (_buffer.size() + recordSize) <= _configuration.maxBufferSize || _hasFailed;
+			});
+
+		auto const offset = _buffer.size();
+		_buffer.resize(offset + recordSize);
+		auto* const data = _buffer.data() + offset;
+		writeValue(data, static_cast<std::uint32_t>(record.message.size()));
+		writeValue(data + 4, record.layer);
+		writeValue(data + 8, record.level);
+		writeValue(data + 12, record.timestamp);
+		if (!record.message.empty())
+		{
+			std::memcpy(data + RecordHeaderSize, record.message.data(), record.message.size());
+		}
+
+		shouldWakeWriter = _buffer.size() >= _configuration.maxBufferSize / 2u;
+	}
+
+	if (shouldWakeWriter)
+	{
+		_writerCondition.notify_one();
+	}
+}
+
+LogJournal::Sequence LogJournal::nextSequence() const noexcept
+{
+	auto const lg = std::lock_guard{ _lock };
+	return _nextSequence;
+}
+
+void LogJournal::flush() noexcept
+{
+	if (!_isOpen)
+	{
+		return;
+	}
+
+	auto lock = std::unique_lock{ _lock };
+	auto const sequence = _nextSequence;
+	_flushRequested = true;
+	_writerCondition.notify_one();
+	_appendCondition.wait(lock,
+		[this, sequence]()
+		{
+			return _syncedSequence >= sequence || _hasFailed;
+		});
+}
+
+std::vector<LogJournal::SegmentInfo> LogJournal::segments() const noexcept
+{
+	auto const lg = std::lock_guard{ _lock };
+	return _segments;
+}
+
+void LogJournal::removeOldDirectories(std::filesystem::path const& directory, std::size_t const keepCount, std::uintmax_t const maxSize) noexcept
+{
+	auto error = std::error_code{};
+	auto directories = std::vector<std::filesystem::path>{};
+	for (auto it = std::filesystem::directory_iterator{ directory, error }; !error && it != std::filesystem::directory_iterator{}; it.increment(error))
+	{
+		if (it->is_directory(error))
+		{
+			directories.push_back(it->path());
+		}
+	}
+
+	// Keep the most recent directories, as long as they fit in both limits
+	std::sort(directories.begin(), directories.end());
+	auto keptCount = std::size_t{ 0u };
+	auto keptSize = std::uintmax_t{ 0u };
+	for (auto it = directories.rbegin(); it != directories.rend(); ++it)
+	{
+		auto directorySize = std::uintmax_t{ 0u };
+		for (auto fileIt = std::filesystem::recursive_directory_iterator{ *it, error }; !error && fileIt != std::filesystem::recursive_directory_iterator{}; fileIt.increment(error))
+		{
+			if (fileIt->is_regular_file(error))
+			{
+				auto const fileSize = fileIt->file_size(error);
+				directorySize += error ? 0u : fileSize;
+			}
+		}
+		error.clear();
+
+		if (keptCount < keepCount && directorySize <= maxSize - keptSize)
+		{
+			++keptCount;
+			keptSize += directorySize;
+		}
+		else
+		{
+			// This directory and all the older ones are removed
+			for (auto removeIt = it; removeIt != directories.rend(); ++removeIt)
+			{
+				std::filesystem::remove_all(*removeIt, error);
+			}
+			break;
+		}
+	}
+}
+
+void LogJournal::writerThread() noexcept
+{
+	auto buffer = std::vector<char>{};
+	buffer.reserve(_configuration.maxBufferSize);
+
+	auto lock = std::unique_lock{ _lock };
+	while (true)
+	{
+		_writerCondition.wait_for(lock, _configuration.writeInterval,
+			[this]()
+			{
+				return _shouldTerminate || _flushRequested || _buffer.size() >= _configuration.maxBufferSize / 2u;
+			});
+
+		auto const shouldTerminate = _shouldTerminate;
+		auto const shouldSync = _flushRequested || shouldTerminate;
+		auto const sequence = _nextSequence;
+		_flushRequested = false;
+		buffer.clear();
+		std::swap(buffer, _buffer);
+		lock.unlock();
+
+		// Room has been made in the buffer
+		_appendCondition.notify_all();
+
+		auto success = writeRecords(buffer);
+		auto synced = false;
+		if (success && (shouldSync || (std::chrono::steady_clock::now() - _lastSyncTime) >= _configuration.syncInterval))
+		{
+			success = syncSegment();
+			synced = success;
+		}
+
+		lock.lock();
+		if (!_segments.empty())
+		{
+			_segments.back().entriesCount = static_cast<std::size_t>(_writtenSequence - _segments.back().firstSequence);
+		}
+		if (synced)
+		{
+			_syncedSequence = sequence;
+		}
+		if (!success)
+		{
+			_hasFailed = true;
+			_buffer.clear();
+		}
+		_appendCondition.notify_all();
+
+		if (shouldTerminate || _hasFailed)
+		{
+			break;
+		}
+	}
+	lock.unlock();
+
+	closeSegment();
+}
+
+bool LogJournal::writeRecords(std::vector<char> const& buffer) noexcept
+{
+	auto offset = std::size_t{ 0u };
+	while (offset < buffer.size())
+	{
+		auto const recordSize = RecordHeaderSize + readValue<std::uint32_t>(buffer.data() + offset);
+
+		// Start a new segment if the record doesn't fit in the current one (unless it's empty)
+		if (_segmentFile != nullptr && (_segmentFileSize + recordSize) > _configuration.segmentSize && _segmentFileSize > SegmentHeaderSize)
+		{
+			if (!closeSegment())
+			{
+				return false;
+			}
+		}
+		if (_segmentFile == nullptr && !openSegment(_writtenSequence))
+		{
+			return false;
+		}
+
+		if (std::fwrite(buffer.data() + offset, 1u, recordSize, _segmentFile) != recordSize)
+		{
+			return false;
+		}
+		_segmentFileSize += recordSize;
+		++_writtenSequence;
+		offset += recordSize;
+	}
+	return true;
+}
+
+bool LogJournal::openSegment(Sequence const firstSequence) noexcept
+{
+	auto fileName = std::string(32u, '\0');
+	fileName.resize(static_cast<std::size_t>(std::snprintf(fileName.data(), fileName.size(), "segment-%06zu.hlj", _segmentIndex)));
+	auto const path = _configuration.directory / fileName;
+	++_segmentIndex;
+
+#ifdef _WIN32
+	_segmentFile = ::_wfopen(path.c_str(), L"wb");
+#else // !_WIN32
+	_segmentFile = std::fopen(path.c_str(), "wb");
+#endif // _WIN32
+	if (_segmentFile == nullptr)
+	{
+		return false;
+	}
+
+	auto header = std::array<char, SegmentHeaderSize>{};
+	std::memcpy(header.data(), SegmentMagic.data(), SegmentMagic.size());
+	writeValue(header.data() + 8, SegmentVersion);
+	writeValue(header.data() + 12, std::uint32_t{ 0u });
+	writeValue(header.data() + 16, firstSequence);
+	if (std::fwrite(header.data(), 1u, header.size(), _segmentFile) != header.size())
+	{
+		return false;
+	}
+	_segmentFileSize = header.size();
+
+	// Register the segment, deleting the oldest ones
+	auto removedSegments = std::vector<std::filesystem::path>{};
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_segments.push_back(SegmentInfo{ path, firstSequence, 0u });
+		while (_segments.size() > std::max(std::size_t{ 1u }, _configuration.maxSegments))
+		{
+			removedSegments.push_back(_segments.front().path);
+			_segments.erase(_segments.begin());
+		}
+	}
+	for (auto const& removedPath : removedSegments)
+	{
+		auto error = std::error_code{};
+		std::filesystem::remove(removedPath, error);
+	}
+
+	return true;
+}
+
+bool LogJournal::closeSegment() noexcept
+{
+	if (_segmentFile == nullptr)
+	{
+		return true;
+	}
+
+	auto const synced = syncSegment();
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_segments.back().entriesCount = static_cast<std::size_t>(_writtenSequence - _segments.back().firstSequence);
+	}
+	auto const closed = std::fclose(_segmentFile) == 0;
+	_segmentFile = nullptr;
+	_segmentFileSize = 0u;
+	return synced && closed;
+}
+
+bool LogJournal::syncSegment() noexcept
+{
+	_lastSyncTime = std::chrono::steady_clock::now();
+	if (_segmentFile == nullptr)
+	{
+		return true;
+	}
+	if (std::fflush(_segmentFile) != 0)
+	{
+		return false;
+	}
+#ifdef _WIN32
+	return ::_commit(::_fileno(_segmentFile)) == 0;
+#else // !_WIN32
+	return ::fsync(::fileno(_segmentFile)) == 0;
+#endif // _WIN32
+}
+
+} // namespace avdecc
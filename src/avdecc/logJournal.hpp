@@ -0,0 +1,167 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace avdecc
+{
+/**
+ * @Brief Append-only, segmented binary journal of log entries
+ * @Details Entries are encoded to a bounded memory buffer, written to disk by a background thread.
+ *          The journal is split into segment files of a maximum size, each closed segment is synced to disk, and the current one is synced periodically,
+ *          so a crash loses at most the entries of one segment. The oldest segments are deleted when the maximum number of segments is reached.
+ *          Segment file format (native endianness): a header (magic, version, sequence of the first entry), followed by records
+ *          (message length, layer, level, timestamp in nanoseconds since the system clock epoch, message bytes).
+ */
+class LogJournal final
+{
+public:
+	using Sequence = std::uint64_t;
+
+	struct Configuration
+	{
+		std::filesystem::path directory{};
+		std::size_t segmentSize{ 4u * 1024u * 1024u }; // Maximum size of a segment file
+		std::size_t maxBufferSize{ 1024u * 1024u }; // Maximum size of entries not written yet (appending waits for the writer when reached)
+		std::size_t maxSegments{ 256u }; // Maximum number of segment files, the oldest ones are deleted
+		std::chrono::milliseconds writeInterval{ 200 }; // Maximum time entries are kept in memory
+		std::chrono::milliseconds syncInterval{ 1000 }; // Maximum time written entries are not synced to disk
+	};
+
+	struct Record
+	{
+		std::int64_t timestamp{ 0 }; // Nanoseconds since the system clock epoch
+		std::uint32_t layer{ 0u };
+		std::uint32_t level{ 0u };
+		std::string_view message{};
+	};
+
+	struct SegmentInfo
+	{
+		std::filesystem::path path{};
+		Sequence firstSequence{ 0u };
+		std::size_t entriesCount{ 0u };
+	};
+
+	/** Read only, memory mapped, segment file */
+	class MappedSegment final
+	{
+	public:
+		/** Maps a segment file, returns nullptr if it cannot be mapped or is not a segment file. A truncated last record (after a crash) is ignored. */
+		static std::unique_ptr<MappedSegment> open(std::filesystem::path const& path) noexcept;
+
+		~MappedSegment() noexcept;
+
+		Sequence firstSequence() const noexcept;
+		std::size_t size() const noexcept;
+		/** Returns the record at the specified index, its message is valid as long as the MappedSegment */
+		Record record(std::size_t const index) const noexcept;
+
+		// Deleted compiler auto-generated methods
+		MappedSegment(MappedSegment const&) = delete;
+		MappedSegment(MappedSegment&&) = delete;
+		MappedSegment& operator=(MappedSegment const&) = delete;
+		MappedSegment& operator=(MappedSegment&&) = delete;
+
+	private:
+		MappedSegment() noexcept = default;
+
+		void* _mappingHandle{ nullptr };
+		char const* _data{ nullptr };
+		std::size_t _dataSize{ 0u };
+		Sequence _firstSequence{ 0u };
+		std::vector<std::uint32_t> _offsets{};
+	};
+
+	/** Creates a journal in the configured directory (created if needed). If the directory cannot be used, the journal is not opened and appended entries are ignored. */
+	explicit LogJournal(Configuration const& configuration) noexcept;
+
+	/** Writes and syncs all appended entries */
+	~LogJournal() noexcept;
+
+	bool isOpen() const noexcept;
+
+	/** Returns true if writing to disk has failed, entries appended since then are not journaled */
+	bool hasFailed() const noexcept;
+
+	/** Appends an entry. Waits if the buffer is full. */
+	void append(Record const& record) noexcept;
+
+	/** Returns the sequence the next appended entry will get (which is also the number of appended entries) */
+	Sequence nextSequence() const noexcept;
+
+	/** Waits until all appended entries are written and synced to disk */
+	void flush() noexcept;
+
+	/** Returns the segments on disk (including the one being written), oldest first */
+	std::vector<SegmentInfo> segments() const noexcept;
+
+	/** Deletes the oldest subdirectories of a directory (sorted by name), keeping at most the specified count, and the most recent ones whose files total at most maxSize bytes */
+	static void removeOldDirectories(std::filesystem::path const& directory, std::size_t const keepCount, std::uintmax_t const maxSize = std::numeric_limits<std::uintmax_t>::max()) noexcept;
+
+	// Deleted compiler auto-generated methods
+	LogJournal(LogJournal const&) = delete;
+	LogJournal(LogJournal&&) = delete;
+	LogJournal& operator=(LogJournal const&) = delete;
+	LogJournal& operator=(LogJournal&&) = delete;
+
+private:
+	void writerThread() noexcept;
+	bool writeRecords(std::vector<char> const& buffer) noexcept;
+	bool openSegment(Sequence const firstSequence) noexcept;
+	bool closeSegment() noexcept;
+	bool syncSegment() noexcept;
+
+	Configuration const _configuration{};
+	bool _isOpen{ false };
+
+	// Shared with the writer thread
+	mutable std::mutex _lock{};
+	std::condition_variable _writerCondition{};
+	std::condition_variable _appendCondition{};
+	std::vector<char> _buffer{};
+	Sequence _nextSequence{ 0u };
+	Sequence _syncedSequence{ 0u };
+	bool _flushRequested{ false };
+	bool _shouldTerminate{ false };
+	bool _hasFailed{ false };
+	std::vector<SegmentInfo> _segments{};
+
+	// Writer thread only
+	std::FILE* _segmentFile{ nullptr };
+	std::size_t _segmentFileSize{ 0u };
+	std::size_t _segmentIndex{ 0u };
+	Sequence _writtenSequence{ 0u }; // Sequence of the next record to write
+	std::chrono::steady_clock::time_point _lastSyncTime{};
+	std::thread _writerThread{};
+};
+
+} // namespace avdecc
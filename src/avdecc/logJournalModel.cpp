@@ -0,0 +1,196 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "logJournalModel.hpp"
+#include "helper.hpp"
+
+#include <la/avdecc/logger.hpp>
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace avdecc
+{
+class LogJournalModelPrivate
+{
+public:
+	enum Column
+	{
+		Timestamp,
+		Layer,
+		Level,
+		Message,
+
+		Count
+	};
+
+	LogJournalModelPrivate(std::vector<LogJournal::SegmentInfo> const& segments)
+		: _segments{ segments }
+	{
+		_segmentsFirstRow.reserve(_segments.size());
+		for (auto const& segment : _segments)
+		{
+			_segmentsFirstRow.push_back(_rowCount);
+			_rowCount += segment.entriesCount;
+		}
+	}
+
+	int rowCount() const
+	{
+		return static_cast<int>(_rowCount);
+	}
+
+	QVariant data(QModelIndex const& index, int role) const
+	{
+		if (role != Qt::DisplayRole)
+		{
+			return {};
+		}
+
+		auto const row = static_cast<std::size_t>(index.row());
+		auto const segmentIndex = static_cast<std::size_t>(std::distance(_segmentsFirstRow.begin(), std::upper_bound(_segmentsFirstRow.begin(), _segmentsFirstRow.end(), row)) - 1);
+		auto const* const segment = mappedSegment(segmentIndex);
+		auto const recordIndex = row - _segmentsFirstRow[segmentIndex];
+		// Segment deleted (or truncated) since the model was created
+		if (segment == nullptr || recordIndex >= segment->size())
+		{
+			return {};
+		}
+
+		auto const record = segment->record(recordIndex);
+		switch (index.column())
+		{
+			case Column::Timestamp:
+			{
+				auto const dateTime = QDateTime::fromMSecsSinceEpoch(record.timestamp / 1000000);
+				return QString("%1 - %2").arg(dateTime.date().toString(Qt::ISODate), dateTime.time().toString(Qt::ISODate));
+			}
+			case Column::Layer:
+				return avdecc::helper::loggerLayerToString(static_cast<la::avdecc::logger::Layer>(record.layer));
+			case Column::Level:
+				return avdecc::helper::loggerLevelToString(static_cast<la::avdecc::logger::Level>(record.level));
+			case Column::Message:
+				return QString::fromUtf8(record.message.data(), static_cast<int>(record.message.size()));
+			default:
+				break;
+		}
+
+		return {};
+	}
+
+	QVariant headerData(int section, Qt::Orientation orientation, int role) const
+	{
+		if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+		{
+			switch (section)
+			{
+				case Column::Timestamp:
+					return "Timestamp";
+				case Column::Layer:
+					return "Layer";
+				case Column::Level:
+					return "Level";
+				case Column::Message:
+					return "Message";
+				default:
+					break;
+			}
+		}
+
+		return {};
+	}
+
+private:
+	static constexpr auto MaxMappedSegments = std::size_t{ 8u };
+
+	// Returns the mapped segment, mapping it (and unmapping the least recently used one) if needed
+	LogJournal::MappedSegment const* mappedSegment(std::size_t const segmentIndex) const
+	{
+		auto const it = std::find_if(_mappedSegments.begin(), _mappedSegments.end(),
+			[segmentIndex](auto const& mapped)
+			{
+				return mapped.first == segmentIndex;
+			});
+		if (it != _mappedSegments.end())
+		{
+			_mappedSegments.splice(_mappedSegments.begin(), _mappedSegments, it);
+			return _mappedSegments.front().second.get();
+		}
+
+		_mappedSegments.emplace_front(segmentIndex, LogJournal::MappedSegment::open(_segments[segmentIndex].path));
+		if (_mappedSegments.size() > MaxMappedSegments)
+		{
+			_mappedSegments.pop_back();
+		}
+		return _mappedSegments.front().second.get();
+	}
+
+	std::vector<LogJournal::SegmentInfo> const _segments{};
+	std::vector<std::size_t> _segmentsFirstRow{};
+	std::size_t _rowCount{ 0u };
+	mutable std::list<std::pair<std::size_t, std::unique_ptr<LogJournal::MappedSegment>>> _mappedSegments{}; // Most recently used first
+};
+
+LogJournalModel::LogJournalModel(std::vector<LogJournal::SegmentInfo> const& segments, QObject* parent)
+	: QAbstractTableModel(parent)
+	, d_ptr(new LogJournalModelPrivate(segments))
+{
+}
+
+LogJournalModel::~LogJournalModel()
+{
+	delete d_ptr;
+}
+
+int LogJournalModel::rowCount(QModelIndex const& parent) const
+{
+	Q_D(const LogJournalModel);
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return d->rowCount();
+}
+
+int LogJournalModel::columnCount(QModelIndex const& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return LogJournalModelPrivate::Column::Count;
+}
+
+QVariant LogJournalModel::data(QModelIndex const& index, int role) const
+{
+	Q_D(const LogJournalModel);
+	return d->data(index, role);
+}
+
+QVariant LogJournalModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	Q_D(const LogJournalModel);
+	return d->headerData(section, orientation, role);
+}
+
+} // namespace avdecc
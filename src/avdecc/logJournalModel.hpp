@@ -0,0 +1,48 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "logJournal.hpp"
+
+#include <QAbstractTableModel>
+
+#include <vector>
+
+namespace avdecc
+{
+/** Read only model of the entries of log journal segments, only the recently accessed segments are kept memory mapped */
+class LogJournalModelPrivate;
+class LogJournalModel : public QAbstractTableModel
+{
+	Q_OBJECT
+public:
+	LogJournalModel(std::vector<LogJournal::SegmentInfo> const& segments, QObject* parent = nullptr);
+	~LogJournalModel();
+
+	int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+	int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+	QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+	LogJournalModelPrivate* const d_ptr{ nullptr };
+	Q_DECLARE_PRIVATE(LogJournalModel)
+};
+} // namespace avdecc
@@ -0,0 +1,375 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+/**
+ * @Brief Lock-free multiple producers, single consumer queue
+ * @Details Producers push items from any thread without ever blocking. The consumer takes all pushed items at once, in push order.
+ */
+template<typename Item>
+class LogIngestQueue final
+{
+public:
+	LogIngestQueue() noexcept = default;
+
+	~LogIngestQueue() noexcept
+	{
+		auto* node = _head.exchange(nullptr, std::memory_order_acquire);
+		while (node)
+		{
+			auto* const next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+
+	/** Pushes an item, from any thread. Returns true if the queue was empty (meaning the consumer should be scheduled). */
+	bool push(Item&& item) noexcept
+	{
+		auto* const node = new Node{ std::move(item), nullptr };
+		auto* head = _head.load(std::memory_order_relaxed);
+		do
+		{
+			node->next = head;
+		} while (!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+		return head == nullptr;
+	}
+
+	/** Takes all pushed items, in push order. Must only be called from the consumer thread. */
+	std::vector<Item> takeAll() noexcept
+	{
+		auto* node = _head.exchange(nullptr, std::memory_order_acquire);
+
+		// Nodes are linked from the most recent one
+		auto items = std::vector<Item>{};
+		while (node)
+		{
+			items.push_back(std::move(node->item));
+			auto* const next = node->next;
+			delete node;
+			node = next;
+		}
+		std::reverse(items.begin(), items.end());
+		return items;
+	}
+
+	// Deleted compiler auto-generated methods
+	LogIngestQueue(LogIngestQueue const&) = delete;
+	LogIngestQueue(LogIngestQueue&&) = delete;
+	LogIngestQueue& operator=(LogIngestQueue const&) = delete;
+	LogIngestQueue& operator=(LogIngestQueue&&) = delete;
+
+private:
+	struct Node
+	{
+		Item item;
+		Node* next{ nullptr };
+	};
+
+	std::atomic<Node*> _head{ nullptr };
+};
+
+/**
+ * @Brief Fixed capacity store of log entries
+ * @Details Entries are stored in columns (timestamp, layer, level, message) of a ring buffer: when the maximum number of entries or message bytes is reached, the oldest entries are evicted.
+ *          Timestamps are raw steady clock values, converted to wall clock time only when requested. Layers and levels are interned to a single byte.
+ *          Messages are copied to fixed size chunks of an arena, released when all their messages have been evicted.
+ *          Rows are numbered from the oldest entry (row 0), sequence numbers never change (the sequence of row 0 increases as entries are evicted).
+ */
+template<typename Layer, typename Level>
+class LogStore final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	using Sequence = std::uint64_t;
+
+	static constexpr auto DefaultChunkSize = std::size_t{ 1024u * 1024u };
+
+	struct Entry
+	{
+		Clock::time_point timestamp{};
+		Layer layer{};
+		Level level{};
+		std::string_view message{}; // Valid until the entry is evicted
+	};
+
+	LogStore(std::size_t const maxEntries, std::size_t const maxMessageBytes, std::size_t const chunkSize = DefaultChunkSize) noexcept
+		: _maxEntries{ std::max(std::size_t{ 1u }, maxEntries) }
+		, _maxMessageBytes{ maxMessageBytes }
+		, _chunkSize{ chunkSize }
+		, _timestamps(_maxEntries)
+		, _layers(_maxEntries)
+		, _levels(_maxEntries)
+		, _messages(_maxEntries)
+	{
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	bool empty() const noexcept
+	{
+		return _size == 0u;
+	}
+
+	std::size_t maxEntries() const noexcept
+	{
+		return _maxEntries;
+	}
+
+	/** Returns the total size of the stored messages */
+	std::size_t messageBytes() const noexcept
+	{
+		return _messageBytes;
+	}
+
+	/** Returns the memory allocated for the messages arena */
+	std::size_t arenaBytes() const noexcept
+	{
+		auto bytes = std::size_t{ 0u };
+		for (auto const& chunk : _chunks)
+		{
+			bytes += chunk.capacity;
+		}
+		return bytes;
+	}
+
+	/** Returns the sequence number of the entry at row 0 (which is also the number of evicted entries since the store was created) */
+	Sequence firstSequence() const noexcept
+	{
+		return _firstSequence;
+	}
+
+	/** Returns the number of oldest entries that appending entriesCount entries totaling messageBytes bytes would evict */
+	std::size_t evictionsFor(std::size_t const entriesCount, std::size_t const messageBytes) const noexcept
+	{
+		auto const totalEntries = _size + entriesCount;
+		auto evictions = totalEntries > _maxEntries ? std::min(_size, totalEntries - _maxEntries) : std::size_t{ 0u };
+
+		auto bytes = _messageBytes + messageBytes;
+		for (auto row = std::size_t{ 0u }; row < evictions; ++row)
+		{
+			bytes -= _messages[physicalIndex(row)].length;
+		}
+		while (bytes > _maxMessageBytes && evictions < _size)
+		{
+			bytes -= _messages[physicalIndex(evictions)].length;
+			++evictions;
+		}
+		return evictions;
+	}
+
+	/** Evicts the count oldest entries */
+	void evict(std::size_t const count) noexcept
+	{
+		for (auto i = std::min(count, _size); i > 0u; --i)
+		{
+			auto const& message = _messages[_head];
+			_messageBytes -= message.length;
+			releaseMessage(message.chunkSequence);
+			_head = (_head + 1u) % _maxEntries;
+			--_size;
+			++_firstSequence;
+		}
+	}
+
+	/** Appends an entry, evicting the oldest ones if needed */
+	void append(Clock::time_point const timestamp, Layer const layer, Level const level, std::string_view const message) noexcept
+	{
+		evict(evictionsFor(1u, message.size()));
+
+		auto const index = (_head + _size) % _maxEntries;
+		_timestamps[index] = timestamp.time_since_epoch().count();
+		_layers[index] = intern(_layerValues, layer);
+		_levels[index] = intern(_levelValues, level);
+		_messages[index] = storeMessage(message);
+		_messageBytes += message.size();
+		++_size;
+	}
+
+	/** Returns the entry at the specified row (0 being the oldest entry) */
+	Entry entry(std::size_t const row) const noexcept
+	{
+		auto const index = physicalIndex(row);
+		return Entry{ timestamp(row), _layerValues[_layers[index]], _levelValues[_levels[index]], message(row) };
+	}
+
+	Clock::time_point timestamp(std::size_t const row) const noexcept
+	{
+		return Clock::time_point{ Clock::duration{ _timestamps[physicalIndex(row)] } };
+	}
+
+	Layer layer(std::size_t const row) const noexcept
+	{
+		return _layerValues[_layers[physicalIndex(row)]];
+	}
+
+	Level level(std::size_t const row) const noexcept
+	{
+		return _levelValues[_levels[physicalIndex(row)]];
+	}
+
+	std::string_view message(std::size_t const row) const noexcept
+	{
+		auto const& message = _messages[physicalIndex(row)];
+		auto const& chunk = _chunks[static_cast<std::size_t>(message.chunkSequence - _firstChunkSequence)];
+		return std::string_view{ chunk.data.get() + message.offset, message.length };
+	}
+
+	/** Converts a timestamp of this store to wall clock time */
+	std::chrono::system_clock::time_point toSystemTime(Clock::time_point const timestamp) const noexcept
+	{
+		return _systemReference + std::chrono::duration_cast<std::chrono::system_clock::duration>(timestamp - _steadyReference);
+	}
+
+	/** Removes all entries (sequence numbers are not reset) */
+	void clear() noexcept
+	{
+		_firstSequence += _size;
+		_head = 0u;
+		_size = 0u;
+		_messageBytes = 0u;
+		_firstChunkSequence += _chunks.size();
+		_chunks.clear();
+	}
+
+	// Deleted compiler auto-generated methods
+	LogStore(LogStore const&) = delete;
+	LogStore(LogStore&&) = delete;
+	LogStore& operator=(LogStore const&) = delete;
+	LogStore& operator=(LogStore&&) = delete;
+
+private:
+	using ChunkSequence = std::uint64_t;
+
+	struct Message
+	{
+		ChunkSequence chunkSequence{ 0u };
+		std::uint32_t offset{ 0u };
+		std::uint32_t length{ 0u };
+	};
+
+	struct Chunk
+	{
+		std::unique_ptr<char[]> data{};
+		std::size_t capacity{ 0u };
+		std::size_t used{ 0u };
+		std::size_t messagesCount{ 0u }; // Number of stored messages in this chunk
+	};
+
+	std::size_t physicalIndex(std::size_t const row) const noexcept
+	{
+		return (_head + row) % _maxEntries;
+	}
+
+	template<typename Value>
+	static std::uint8_t intern(std::vector<Value>& values, Value const value) noexcept
+	{
+		auto const it = std::find(values.begin(), values.end(), value);
+		if (it != values.end())
+		{
+			return static_cast<std::uint8_t>(std::distance(values.begin(), it));
+		}
+		// More distinct values than can be interned, should never happen: share the last one
+		if (values.size() > 0xFFu)
+		{
+			return 0xFFu;
+		}
+		values.push_back(value);
+		return static_cast<std::uint8_t>(values.size() - 1u);
+	}
+
+	Message storeMessage(std::string_view const message) noexcept
+	{
+		if (_chunks.empty() || (_chunks.back().capacity - _chunks.back().used) < message.size())
+		{
+			// Messages larger than a chunk get their own chunk
+			auto const capacity = std::max(_chunkSize, message.size());
+			_chunks.push_back(Chunk{ std::unique_ptr<char[]>{ new char[capacity] }, capacity, 0u, 0u });
+		}
+
+		auto& chunk = _chunks.back();
+		auto const offset = chunk.used;
+		if (!message.empty())
+		{
+			std::memcpy(chunk.data.get() + offset, message.data(), message.size());
+		}
+		chunk.used += message.size();
+		++chunk.messagesCount;
+
+		return Message{ _firstChunkSequence + _chunks.size() - 1u, static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(message.size()) };
+	}
+
+	void releaseMessage(ChunkSequence const chunkSequence) noexcept
+	{
+		--_chunks[static_cast<std::size_t>(chunkSequence - _firstChunkSequence)].messagesCount;
+
+		// Release the oldest chunks no longer used (keeping the chunk being filled)
+		while (_chunks.size() > 1u && _chunks.front().messagesCount == 0u)
+		{
+			_chunks.pop_front();
+			++_firstChunkSequence;
+		}
+	}
+
+	std::size_t const _maxEntries{ 1u };
+	std::size_t const _maxMessageBytes{ 0u };
+	std::size_t const _chunkSize{ DefaultChunkSize };
+
+	// Ring buffer columns
+	std::vector<Clock::rep> _timestamps{};
+	std::vector<std::uint8_t> _layers{};
+	std::vector<std::uint8_t> _levels{};
+	std::vector<Message> _messages{};
+	std::size_t _head{ 0u }; // Physical index of row 0
+	std::size_t _size{ 0u };
+	Sequence _firstSequence{ 0u };
+
+	// Interned values
+	std::vector<Layer> _layerValues{};
+	std::vector<Level> _levelValues{};
+
+	// Messages arena
+	std::deque<Chunk> _chunks{};
+	ChunkSequence _firstChunkSequence{ 0u }; // Sequence of the first chunk in _chunks
+	std::size_t _messageBytes{ 0u };
+
+	// Reference points to convert timestamps to wall clock time
+	std::chrono::system_clock::time_point const _systemReference{ std::chrono::system_clock::now() };
+	Clock::time_point const _steadyReference{ Clock::now() };
+};
+
+} // namespace avdecc
@@ -0,0 +1,339 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "loggerFilterModel.hpp"
+#include "logFilterIndex.hpp"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+namespace avdecc
+{
+class LoggerFilterModelPrivate : public QObject
+{
+	Q_OBJECT
+public:
+	using Index = LogFilterIndex<la::avdecc::logger::Layer, la::avdecc::logger::Level>;
+	using Sequence = Index::Sequence;
+
+	LoggerFilterModelPrivate(LoggerFilterModel* model, LoggerModel* sourceModel)
+		: q_ptr(model)
+		, _sourceModel(sourceModel)
+	{
+		connect(_sourceModel, &LoggerModel::rowsInserted, this, &LoggerFilterModelPrivate::handleRowsInserted);
+		connect(_sourceModel, &LoggerModel::rowsAboutToBeRemoved, this, &LoggerFilterModelPrivate::handleRowsAboutToBeRemoved);
+		connect(_sourceModel, &LoggerModel::modelAboutToBeReset, this,
+			[this]()
+			{
+				Q_Q(LoggerFilterModel);
+				q->beginResetModel();
+			});
+		connect(_sourceModel, &LoggerModel::modelReset, this,
+			[this]()
+			{
+				Q_Q(LoggerFilterModel);
+				rebuild();
+				q->endResetModel();
+			});
+
+		rebuild();
+	}
+
+	void setLayers(std::optional<std::vector<la::avdecc::logger::Layer>> const& layers)
+	{
+		_filter.layers = layers;
+		refilter(false);
+	}
+
+	void setLevels(std::optional<std::vector<la::avdecc::logger::Level>> const& levels)
+	{
+		_filter.levels = levels;
+		refilter(false);
+	}
+
+	void setSearchPattern(QString const& pattern)
+	{
+		auto const previousLiteral = _isLiteral ? std::optional<std::string>{ _literal } : std::nullopt;
+
+		_isLiteral = isLiteral(pattern);
+		_literal = _isLiteral ? pattern.toStdString() : std::string{};
+		_regularExpression = QRegularExpression{ pattern, QRegularExpression::CaseInsensitiveOption };
+		// Only literal searches can use the messages signatures
+		_filter.text = _literal;
+
+		// Typing more characters: only the currently accepted entries can match
+		refilter(previousLiteral && _isLiteral && Index::containsCaseInsensitive(_literal, *previousLiteral));
+	}
+
+	int rowCount() const
+	{
+		return static_cast<int>(_rows.size());
+	}
+
+	int sourceRow(int const row) const
+	{
+		return static_cast<int>(_rows[static_cast<std::size_t>(row)] - _sourceModel->firstSequence());
+	}
+
+	int row(int const sourceRow) const
+	{
+		auto const sequence = _sourceModel->firstSequence() + static_cast<Sequence>(sourceRow);
+		auto const it = std::lower_bound(_rows.begin(), _rows.end(), sequence);
+		if (it == _rows.end() || *it != sequence)
+		{
+			return -1;
+		}
+		return static_cast<int>(std::distance(_rows.begin(), it));
+	}
+
+private:
+	static bool isLiteral(QString const& pattern)
+	{
+		// Case insensitive comparison of the index is only valid for ASCII
+		static auto const s_specialCharacters = QString{ "\\^$.|?*+()[]{}" };
+		for (auto const c : pattern)
+		{
+			if (c.unicode() >= 0x80 || s_specialCharacters.contains(c))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool acceptsMessage(Sequence const sequence) const
+	{
+		auto const message = _sourceModel->message(static_cast<int>(sequence - _sourceModel->firstSequence()));
+		if (_isLiteral)
+		{
+			return Index::containsCaseInsensitive(message, _literal);
+		}
+		return _regularExpression.match(QString::fromUtf8(message.data(), static_cast<int>(message.size()))).hasMatch();
+	}
+
+	auto acceptsMessagePredicate() const
+	{
+		return [this](Sequence const sequence)
+		{
+			return acceptsMessage(sequence);
+		};
+	}
+
+	// Re-indexes all the source entries (after a reset)
+	void rebuild()
+	{
+		_index.reset(_sourceModel->firstSequence());
+		for (auto sourceRow = 0; sourceRow < _sourceModel->rowCount(); ++sourceRow)
+		{
+			_index.append(_sourceModel->layer(sourceRow), _sourceModel->level(sourceRow), _sourceModel->message(sourceRow));
+		}
+		auto const rows = _index.find(_filter, _index.firstSequence(), _index.endSequence(), acceptsMessagePredicate());
+		_rows.assign(rows.begin(), rows.end());
+	}
+
+	// Applies the current filter, keeping the persistent indexes (selection) of still accepted entries
+	void refilter(bool const refineOnly)
+	{
+		Q_Q(LoggerFilterModel);
+
+		emit q->layoutAboutToBeChanged();
+
+		auto const persistentIndexes = q->persistentIndexList();
+		auto persistentSequences = std::vector<Sequence>{};
+		persistentSequences.reserve(persistentIndexes.size());
+		for (auto const& index : persistentIndexes)
+		{
+			persistentSequences.push_back(_rows[static_cast<std::size_t>(index.row())]);
+		}
+
+		auto const rows = refineOnly ? _index.refine(_filter, _rows, acceptsMessagePredicate()) : _index.find(_filter, _index.firstSequence(), _index.endSequence(), acceptsMessagePredicate());
+		_rows.assign(rows.begin(), rows.end());
+
+		auto newIndexes = QModelIndexList{};
+		newIndexes.reserve(persistentIndexes.size());
+		for (auto i = 0; i < persistentIndexes.size(); ++i)
+		{
+			auto const it = std::lower_bound(_rows.begin(), _rows.end(), persistentSequences[static_cast<std::size_t>(i)]);
+			if (it != _rows.end() && *it == persistentSequences[static_cast<std::size_t>(i)])
+			{
+				newIndexes.push_back(q->index(static_cast<int>(std::distance(_rows.begin(), it)), persistentIndexes[i].column()));
+			}
+			else
+			{
+				newIndexes.push_back({});
+			}
+		}
+		q->changePersistentIndexList(persistentIndexes, newIndexes);
+
+		emit q->layoutChanged();
+	}
+
+	// New entries are always appended: index them and test them against the current filter, once
+	void handleRowsInserted(QModelIndex const& /*parent*/, int first, int last)
+	{
+		Q_Q(LoggerFilterModel);
+
+		auto const beginSequence = _index.endSequence();
+		for (auto sourceRow = first; sourceRow <= last; ++sourceRow)
+		{
+			_index.append(_sourceModel->layer(sourceRow), _sourceModel->level(sourceRow), _sourceModel->message(sourceRow));
+		}
+
+		auto const accepted = _index.find(_filter, beginSequence, _index.endSequence(), acceptsMessagePredicate());
+		if (!accepted.empty())
+		{
+			auto const count = rowCount();
+			q->beginInsertRows({}, count, count + static_cast<int>(accepted.size()) - 1);
+			_rows.insert(_rows.end(), accepted.begin(), accepted.end());
+			q->endInsertRows();
+		}
+	}
+
+	// Oldest entries are always the ones removed
+	void handleRowsAboutToBeRemoved(QModelIndex const& /*parent*/, int /*first*/, int last)
+	{
+		Q_Q(LoggerFilterModel);
+
+		auto const endSequence = _sourceModel->firstSequence() + static_cast<Sequence>(last) + 1u;
+		auto const count = static_cast<int>(std::distance(_rows.begin(), std::lower_bound(_rows.begin(), _rows.end(), endSequence)));
+		if (count > 0)
+		{
+			q->beginRemoveRows({}, 0, count - 1);
+			_rows.erase(_rows.begin(), _rows.begin() + count);
+			q->endRemoveRows();
+		}
+		_index.evict(static_cast<std::size_t>(last) + 1u);
+	}
+
+	LoggerFilterModel* const q_ptr{ nullptr };
+	Q_DECLARE_PUBLIC(LoggerFilterModel)
+
+	LoggerModel* const _sourceModel{ nullptr };
+	Index _index{};
+	Index::Filter _filter{};
+	bool _isLiteral{ true };
+	std::string _literal{};
+	QRegularExpression _regularExpression{};
+	std::deque<Sequence> _rows{}; // Sequences of the accepted entries, in order
+};
+
+LoggerFilterModel::LoggerFilterModel(LoggerModel* sourceModel, QObject* parent)
+	: QAbstractProxyModel(parent)
+	, d_ptr(new LoggerFilterModelPrivate(this, sourceModel))
+{
+	QAbstractProxyModel::setSourceModel(sourceModel);
+}
+
+LoggerFilterModel::~LoggerFilterModel()
+{
+	delete d_ptr;
+}
+
+void LoggerFilterModel::setLayers(std::optional<std::vector<la::avdecc::logger::Layer>> const& layers)
+{
+	Q_D(LoggerFilterModel);
+	d->setLayers(layers);
+}
+
+void LoggerFilterModel::setLevels(std::optional<std::vector<la::avdecc::logger::Level>> const& levels)
+{
+	Q_D(LoggerFilterModel);
+	d->setLevels(levels);
+}
+
+void LoggerFilterModel::setSearchPattern(QString const& pattern)
+{
+	Q_D(LoggerFilterModel);
+	d->setSearchPattern(pattern);
+}
+
+QModelIndex LoggerFilterModel::mapToSource(QModelIndex const& proxyIndex) const
+{
+	Q_D(const LoggerFilterModel);
+	if (!proxyIndex.isValid())
+	{
+		return {};
+	}
+	return sourceModel()->index(d->sourceRow(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex LoggerFilterModel::mapFromSource(QModelIndex const& sourceIndex) const
+{
+	Q_D(const LoggerFilterModel);
+	if (!sourceIndex.isValid())
+	{
+		return {};
+	}
+	auto const row = d->row(sourceIndex.row());
+	if (row < 0)
+	{
+		return {};
+	}
+	return createIndex(row, sourceIndex.column());
+}
+
+QModelIndex LoggerFilterModel::index(int row, int column, QModelIndex const& parent) const
+{
+	if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+	{
+		return {};
+	}
+	return createIndex(row, column);
+}
+
+QModelIndex LoggerFilterModel::parent(QModelIndex const& /*child*/) const
+{
+	return {};
+}
+
+int LoggerFilterModel::rowCount(QModelIndex const& parent) const
+{
+	Q_D(const LoggerFilterModel);
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return d->rowCount();
+}
+
+int LoggerFilterModel::columnCount(QModelIndex const& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return sourceModel()->columnCount();
+}
+
+QVariant LoggerFilterModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	// Columns are not filtered
+	if (orientation == Qt::Horizontal)
+	{
+		return sourceModel()->headerData(section, orientation, role);
+	}
+	return QAbstractProxyModel::headerData(section, orientation, role);
+}
+
+} // namespace avdecc
+
+#include "loggerFilterModel.moc"
@@ -0,0 +1,62 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "loggerModel.hpp"
+
+#include <la/avdecc/logger.hpp>
+
+#include <QAbstractProxyModel>
+
+#include <optional>
+#include <vector>
+
+namespace avdecc
+{
+/** Filters the entries of a LoggerModel by layer, level and message, using an incremental index (each new entry is only tested once) */
+class LoggerFilterModelPrivate;
+class LoggerFilterModel : public QAbstractProxyModel
+{
+	Q_OBJECT
+public:
+	LoggerFilterModel(LoggerModel* sourceModel, QObject* parent = nullptr);
+	~LoggerFilterModel();
+
+	/** Sets the accepted layers (all if not set) */
+	void setLayers(std::optional<std::vector<la::avdecc::logger::Layer>> const& layers);
+	/** Sets the accepted levels (all if not set) */
+	void setLevels(std::optional<std::vector<la::avdecc::logger::Level>> const& levels);
+	/** Sets the regular expression messages must match (case insensitive), empty to accept all messages */
+	void setSearchPattern(QString const& pattern);
+
+	// QAbstractProxyModel overrides
+	QModelIndex mapToSource(QModelIndex const& proxyIndex) const override;
+	QModelIndex mapFromSource(QModelIndex const& sourceIndex) const override;
+	QModelIndex index(int row, int column, QModelIndex const& parent = QModelIndex()) const override;
+	QModelIndex parent(QModelIndex const& child) const override;
+	int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+	int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+	LoggerFilterModelPrivate* const d_ptr{ nullptr };
+	Q_DECLARE_PRIVATE(LoggerFilterModel)
+};
+} // namespace avdecc
@@ -18,19 +18,29 @@
 */
 
 #include "loggerModel.hpp"
+#include "logStore.hpp"
+#include "logJournal.hpp"
 #include "helper.hpp"
 
 #include <la/avdecc/internals/logItems.hpp>
 #include <la/avdecc/controller/internals/logItems.hpp>
 
-#include <unordered_map>
-#include <QTime>
+#include <QDateTime>
 #include <QFile>
+#include <QStandardPaths>
 #include <QTextStream>
-
-Q_DECLARE_METATYPE(la::avdecc::logger::Layer)
-Q_DECLARE_METATYPE(la::avdecc::logger::Level)
-Q_DECLARE_METATYPE(std::string)
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 enum LoggerModelColumn
 {
@@ -51,17 +61,31 @@ public:
 	LoggerModelPrivate(LoggerModel* model)
 		: q_ptr(model)
 	{
+		_flushTimer.setSingleShot(true);
+		_flushTimer.setInterval(FlushInterval);
+		connect(&_flushTimer, &QTimer::timeout, this, &LoggerModelPrivate::flush);
+
+		_journalThread = std::thread{ &LoggerModelPrivate::journalThread, this };
+
 		la::avdecc::logger::Logger::getInstance().registerObserver(this);
 	}
 
 	~LoggerModelPrivate()
 	{
 		la::avdecc::logger::Logger::getInstance().unregisterObserver(this);
+
+		// Journal the pending items before the journal is destroyed
+		{
+			auto const lg = std::lock_guard{ _journalLock };
+			_journalShouldTerminate = true;
+		}
+		_journalCondition.notify_one();
+		_journalThread.join();
 	}
 
 	int rowCount() const
 	{
-		return static_cast<int>(_entries.size());
+		return static_cast<int>(_store.size());
 	}
 
 	int columnCount() const
@@ -73,18 +97,18 @@ public:
 	{
 		if (role == Qt::DisplayRole)
 		{
-			auto const& entry = _entries.at(index.row());
+			auto const row = static_cast<std::size_t>(index.row());
 
 			switch (index.column())
 			{
 				case LoggerModelColumn::Timestamp:
-					return entry.timestamp;
+					return timestampToString(_store.timestamp(row));
 				case LoggerModelColumn::Layer:
-					return avdecc::helper::loggerLayerToString(entry.layer);
+					return avdecc::helper::loggerLayerToString(_store.layer(row));
 				case LoggerModelColumn::Level:
-					return avdecc::helper::loggerLevelToString(entry.level);
+					return avdecc::helper::loggerLevelToString(_store.level(row));
 				case LoggerModelColumn::Message:
-					return entry.message;
+					return messageToString(_store.message(row));
 				default:
 					break;
 			}
@@ -126,76 +150,380 @@ public:
 	void clear()
 	{
 		Q_Q(LoggerModel);
+		// Pending items were logged before the clear request, only journal them
+		journal(_ingestQueue.takeAll());
+		{
+			auto const lg = std::lock_guard{ _journalLock };
+			_clearSequence = _journalEndSequence;
+		}
 		q->beginResetModel();
-		_entries.clear();
+		_store.clear();
 		q->endResetModel();
 	}
 
-	void save(QString const& filename, LoggerModel::SaveConfiguration const& saveConfiguration) const
+	std::uint64_t firstSequence() const noexcept
+	{
+		return _store.firstSequence();
+	}
+
+	la::avdecc::logger::Layer layer(int const row) const noexcept
+	{
+		return _store.layer(static_cast<std::size_t>(row));
+	}
+
+	la::avdecc::logger::Level level(int const row) const noexcept
+	{
+		return _store.level(static_cast<std::size_t>(row));
+	}
+
+	std::string_view message(int const row) const noexcept
+	{
+		return _store.message(static_cast<std::size_t>(row));
+	}
+
+	bool save(QString const& filename, LoggerModel::SaveConfiguration const& saveConfiguration, LoggerModel::SaveProgressHandler const& onProgress) const
 	{
 		QFile file(filename);
 		file.open(QIODevice::WriteOnly);
 		QTextStream stream(&file);
 
-		for (auto const& entry : _entries)
+		// Export the whole session (since the last clear) from the journal, including the entries no longer in memory (unless writing the journal has failed, in which case it is incomplete)
+		if (!waitForJournal(onProgress))
 		{
-			if (!entry.message.contains(saveConfiguration.search))
+			file.remove();
+			return false;
+		}
+		if (_journal.isOpen() && !_journal.hasFailed())
+		{
+			auto const segments = _journal.segments();
+			auto const clearSequence = [this]()
 			{
-				continue;
-			}
+				auto const lg = std::lock_guard{ _journalLock };
+				return _clearSequence;
+			}();
 
-			auto const level = avdecc::helper::loggerLevelToString(entry.level);
-			if (!level.contains(saveConfiguration.level))
+			auto totalCount = std::size_t{ 0u };
+			for (auto const& info : segments)
 			{
-				continue;
+				auto const skippedCount = static_cast<std::size_t>(std::min<LogJournal::Sequence>(clearSequence - std::min(clearSequence, info.firstSequence), info.entriesCount));
+				totalCount += info.entriesCount - skippedCount;
 			}
 
-			auto const layer = avdecc::helper::loggerLayerToString(entry.layer);
-			if (!layer.contains(saveConfiguration.layer))
+			auto savedCount = std::size_t{ 0u };
+			for (auto const& info : segments)
+			{
+				auto const segment = LogJournal::MappedSegment::open(info.path);
+				if (!segment)
+				{
+					continue;
+				}
+				for (auto index = std::size_t{ 0u }; index < segment->size(); ++index)
+				{
+					if (segment->firstSequence() + index < clearSequence)
+					{
+						continue;
+					}
+					auto const record = segment->record(index);
+					auto const timestamp = std::chrono::system_clock::time_point{ std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ record.timestamp }) };
+					saveEntry(stream, saveConfiguration, timestamp, static_cast<la::avdecc::logger::Layer>(record.layer), static_cast<la::avdecc::logger::Level>(record.level), record.message);
+
+					++savedCount;
+					if (onProgress && (savedCount % SaveProgressInterval) == 0u && !onProgress(savedCount, totalCount))
+					{
+						file.remove();
+						return false;
+					}
+				}
+			}
+		}
+		else
+		{
+			// Not reporting progress here, as processing events may add or evict rows
+			for (auto row = std::size_t{ 0u }; row < _store.size(); ++row)
 			{
-				continue;
+				saveEntry(stream, saveConfiguration, _store.toSystemTime(_store.timestamp(row)), _store.layer(row), _store.level(row), _store.message(row));
 			}
+		}
+		return true;
+	}
 
-			QStringList elements;
+	std::vector<LogJournal::SegmentInfo> journalSegments() const
+	{
+		waitForJournal({});
+		return _journal.segments();
+	}
 
-			elements << entry.timestamp;
-			elements << layer;
-			elements << level;
-			elements << entry.message;
+	std::uint64_t journalDroppedCount() const
+	{
+		auto const lg = std::lock_guard{ _journalLock };
+		return _journalDroppedCount;
+	}
 
-			stream << elements.join("\t") << "\n";
-		}
+	bool hasJournalFailed() const noexcept
+	{
+		return !_journal.isOpen() || _journal.hasFailed();
 	}
 
 	virtual void onLogItem(la::avdecc::logger::Level const level, la::avdecc::logger::LogItem const* const item) noexcept override
 	{
-		QMetaObject::invokeMethod(this,
-			[this, layer = item->getLayer(), level, message = item->getMessage()]()
-			{
-				Q_Q(LoggerModel);
-				auto const count = q->rowCount();
-				q->beginInsertRows({}, count, count);
-				auto const timestamp = QString("%1 - %2").arg(QDate::currentDate().toString(Qt::ISODate), QTime::currentTime().toString(Qt::ISODate));
-				_entries.push_back({ timestamp, layer, level, QString::fromStdString(message) });
-				q->endInsertRows();
-			});
+		// Only schedule a flush for the first pending item, the next ones will be taken by the same flush
+		if (_ingestQueue.push(PendingItem{ Store::Clock::now(), item->getLayer(), level, item->getMessage() }))
+		{
+			QMetaObject::invokeMethod(this,
+				[this]()
+				{
+					if (!_flushTimer.isActive())
+					{
+						_flushTimer.start();
+					}
+				});
+		}
 	}
 
 private:
-	LoggerModel* const q_ptr{ nullptr };
-	Q_DECLARE_PUBLIC(LoggerModel)
-
-	la::avdecc::logger::Logger* _logger{ nullptr };
-
-	struct LogInfo
+	using Store = LogStore<la::avdecc::logger::Layer, la::avdecc::logger::Level>;
+
+	static constexpr auto MaxEntries = std::size_t{ 1000000u };
+	static constexpr auto MaxMessageBytes = std::size_t{ 128u * 1024u * 1024u };
+	static constexpr auto FlushInterval = std::chrono::milliseconds{ 100 };
+	static constexpr auto MaxJournalSessions = std::size_t{ 5u };
+	static constexpr auto MaxJournalSize = std::uintmax_t{ 512u * 1024u * 1024u }; // Size of the journals of all sessions
+	static constexpr auto MaxJournalSessionSize = std::size_t{ 256u * 1024u * 1024u }; // Size of the journal of the current session (the remaining is for the previous sessions)
+	static constexpr auto MaxJournalQueueEntries = MaxEntries; // Entries waiting for the journal thread, the oldest ones are dropped past this count
+	static constexpr auto JournalWaitInterval = std::chrono::milliseconds{ 50 }; // Interval between two progress reports, while waiting for the journal thread
+	static constexpr auto SaveProgressInterval = std::size_t{ 10000u };
+
+	struct PendingItem
 	{
-		QString timestamp{};
+		Store::Clock::time_point timestamp{};
 		la::avdecc::logger::Layer layer{};
 		la::avdecc::logger::Level level{};
-		QString message{};
+		std::string message{};
 	};
 
-	std::vector<LogInfo> _entries;
+	// Journal of the current session, in a new directory (only keeping the most recent sessions)
+	static LogJournal::Configuration journalConfiguration()
+	{
+		auto const logsDirectory = std::filesystem::path{ QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation).toStdWString() } / "logs";
+		LogJournal::removeOldDirectories(logsDirectory, MaxJournalSessions - 1u, MaxJournalSize - MaxJournalSessionSize);
+
+		auto configuration = LogJournal::Configuration{};
+		configuration.directory = logsDirectory / QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz").toStdWString();
+		configuration.maxSegments = MaxJournalSessionSize / configuration.segmentSize;
+		return configuration;
+	}
+
+	static QString timestampToString(std::chrono::system_clock::time_point const timestamp)
+	{
+		auto const dateTime = QDateTime::fromMSecsSinceEpoch(std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count());
+		return QString("%1 - %2").arg(dateTime.date().toString(Qt::ISODate), dateTime.time().toString(Qt::ISODate));
+	}
+
+	QString timestampToString(Store::Clock::time_point const timestamp) const
+	{
+		return timestampToString(_store.toSystemTime(timestamp));
+	}
+
+	static void saveEntry(QTextStream& stream, LoggerModel::SaveConfiguration const& saveConfiguration, std::chrono::system_clock::time_point const timestamp, la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level, std::string_view const message)
+	{
+		auto const messageString = messageToString(message);
+		if (!messageString.contains(saveConfiguration.search))
+		{
+			return;
+		}
+
+		auto const levelString = avdecc::helper::loggerLevelToString(level);
+		if (!levelString.contains(saveConfiguration.level))
+		{
+			return;
+		}
+
+		auto const layerString = avdecc::helper::loggerLayerToString(layer);
+		if (!layerString.contains(saveConfiguration.layer))
+		{
+			return;
+		}
+
+		QStringList elements;
+
+		elements << timestampToString(timestamp);
+		elements << layerString;
+		elements << levelString;
+		elements << messageString;
+
+		stream << elements.join("\t") << "\n";
+	}
+
+	// Queues items to be journaled by the journal thread. When the journal writer is too late, the oldest queued items are dropped (and counted) instead of growing the queue
+	void journal(std::vector<PendingItem>&& items)
+	{
+		if (items.empty())
+		{
+			return;
+		}
+		{
+			auto const lg = std::lock_guard{ _journalLock };
+			_journalEndSequence += items.size();
+			_journalQueue.insert(_journalQueue.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+
+			if (_journalQueue.size() > MaxJournalQueueEntries)
+			{
+				auto const droppedCount = _journalQueue.size() - MaxJournalQueueEntries;
+				auto const firstQueuedSequence = _journalEndSequence - _journalQueue.size();
+				_journalQueue.erase(_journalQueue.begin(), _journalQueue.begin() + droppedCount);
+				_journalDroppedCount += droppedCount;
+
+				// The remaining queued items will get lower journal sequences, and so will the first one after the last clear (if still queued)
+				_journalEndSequence -= droppedCount;
+				if (_clearSequence > firstQueuedSequence)
+				{
+					_clearSequence = std::max(firstQueuedSequence, _clearSequence - droppedCount);
+				}
+			}
+		}
+		_journalCondition.notify_one();
+	}
+
+	// Waits until all the queued items are journaled, written and synced to disk by the journal thread, calling the progress handler (if any) in the meantime. Returns false if cancelled by the handler
+	bool waitForJournal(LoggerModel::SaveProgressHandler const& onProgress) const
+	{
+		auto lock = std::unique_lock{ _journalLock };
+		auto const flushRequest = ++_journalFlushRequest;
+		_journalCondition.notify_one();
+
+		auto const isFlushed = [this, flushRequest]()
+		{
+			return _journalFlushedRequest >= flushRequest;
+		};
+		if (!onProgress)
+		{
+			_journalIdleCondition.wait(lock, isFlushed);
+			return true;
+		}
+		while (!_journalIdleCondition.wait_for(lock, JournalWaitInterval, isFlushed))
+		{
+			lock.unlock();
+			auto const shouldContinue = onProgress(0u, 0u);
+			lock.lock();
+			if (!shouldContinue)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void journalThread()
+	{
+		auto items = std::deque<PendingItem>{};
+
+		auto lock = std::unique_lock{ _journalLock };
+		while (true)
+		{
+			_journalCondition.wait(lock,
+				[this]()
+				{
+					return _journalShouldTerminate || !_journalQueue.empty() || _journalFlushedRequest != _journalFlushRequest;
+				});
+			if (_journalQueue.empty() && _journalFlushedRequest == _journalFlushRequest)
+			{
+				break;
+			}
+
+			// Flush requests made before taking the queued items are completed once these items are appended
+			auto const flushRequest = _journalFlushRequest;
+			auto const shouldFlush = flushRequest != _journalFlushedRequest;
+			std::swap(items, _journalQueue);
+			lock.unlock();
+
+			for (auto const& item : items)
+			{
+				auto const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(_store.toSystemTime(item.timestamp).time_since_epoch()).count();
+				_journal.append(LogJournal::Record{ static_cast<std::int64_t>(timestamp), static_cast<std::uint32_t>(item.layer), static_cast<std::uint32_t>(item.level), item.message });
+			}
+			items.clear();
+			if (shouldFlush)
+			{
+				_journal.flush();
+			}
+
+			lock.lock();
+			if (shouldFlush)
+			{
+				_journalFlushedRequest = flushRequest;
+				_journalIdleCondition.notify_all();
+			}
+		}
+	}
+
+	static QString messageToString(std::string_view const message)
+	{
+		return QString::fromUtf8(message.data(), static_cast<int>(message.size()));
+	}
+
+	// Appends all pending items to the store, with a single rows insertion
+	void flush()
+	{
+		Q_Q(LoggerModel);
+
+		auto items = _ingestQueue.takeAll();
+
+		// Only keep the most recent items that fit in the store
+		auto first = items.size();
+		auto bytes = std::size_t{ 0u };
+		while (first > 0u && (items.size() - first) < MaxEntries && (bytes + items[first - 1u].message.size()) <= MaxMessageBytes)
+		{
+			--first;
+			bytes += items[first].message.size();
+		}
+		if (first == items.size())
+		{
+			journal(std::move(items));
+			return;
+		}
+
+		// Evict the oldest entries first, so appending the batch won't evict any
+		auto const evictions = _store.evictionsFor(items.size() - first, bytes);
+		if (evictions > 0u)
+		{
+			q->beginRemoveRows({}, 0, static_cast<int>(evictions) - 1);
+			_store.evict(evictions);
+			q->endRemoveRows();
+		}
+
+		auto const count = rowCount();
+		q->beginInsertRows({}, count, count + static_cast<int>(items.size() - first) - 1);
+		for (auto index = first; index < items.size(); ++index)
+		{
+			auto const& item = items[index];
+			_store.append(item.timestamp, item.layer, item.level, item.message);
+		}
+		q->endInsertRows();
+
+		// All items are journaled, even the ones not fitting in the store
+		journal(std::move(items));
+	}
+
+	LoggerModel* const q_ptr{ nullptr };
+	Q_DECLARE_PUBLIC(LoggerModel)
+
+	Store _store{ MaxEntries, MaxMessageBytes };
+	LogIngestQueue<PendingItem> _ingestQueue{};
+	QTimer _flushTimer{};
+	mutable LogJournal _journal{ journalConfiguration() };
+
+	// Shared with the journal thread
+	mutable std::mutex _journalLock{};
+	mutable std::condition_variable _journalCondition{};
+	mutable std::condition_variable _journalIdleCondition{};
+	std::deque<PendingItem> _journalQueue{};
+	LogJournal::Sequence _journalEndSequence{ 0u }; // Journal sequence the next queued item will get
+	LogJournal::Sequence _clearSequence{ 0u }; // Journal sequence of the first entry after the last clear
+	std::uint64_t _journalDroppedCount{ 0u }; // Number of items dropped from the queue, never journaled
+	mutable std::uint64_t _journalFlushRequest{ 0u };
+	std::uint64_t _journalFlushedRequest{ 0u };
+	bool _journalShouldTerminate{ false };
+	std::thread _journalThread{};
 };
 
 LoggerModel::LoggerModel(QObject* parent)
@@ -245,10 +573,52 @@ void LoggerModel::clear()
 	return d->clear();
 }
 
-void LoggerModel::save(QString const& filename, SaveConfiguration const& saveConfiguration) const
+std::uint64_t LoggerModel::firstSequence() const noexcept
+{
+	Q_D(const LoggerModel);
+	return d->firstSequence();
+}
+
+la::avdecc::logger::Layer LoggerModel::layer(int const row) const noexcept
+{
+	Q_D(const LoggerModel);
+	return d->layer(row);
+}
+
+la::avdecc::logger::Level LoggerModel::level(int const row) const noexcept
+{
+	Q_D(const LoggerModel);
+	return d->level(row);
+}
+
+std::string_view LoggerModel::message(int const row) const noexcept
+{
+	Q_D(const LoggerModel);
+	return d->message(row);
+}
+
+bool LoggerModel::save(QString const& filename, SaveConfiguration const& saveConfiguration, SaveProgressHandler const& onProgress) const
+{
+	Q_D(const LoggerModel);
+	return d->save(filename, saveConfiguration, onProgress);
+}
+
+std::vector<LogJournal::SegmentInfo> LoggerModel::journalSegments() const
+{
+	Q_D(const LoggerModel);
+	return d->journalSegments();
+}
+
+bool LoggerModel::hasJournalFailed() const noexcept
+{
+	Q_D(const LoggerModel);
+	return d->hasJournalFailed();
+}
+
+std::uint64_t LoggerModel::journalDroppedCount() const
 {
 	Q_D(const LoggerModel);
-	return d->save(filename, saveConfiguration);
+	return d->journalDroppedCount();
 }
 
 } // namespace avdecc
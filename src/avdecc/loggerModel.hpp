@@ -19,11 +19,18 @@
 
 #pragma once
 
+#include "logJournal.hpp"
+
 #include <la/avdecc/logger.hpp>
 
 #include <QAbstractTableModel>
 #include <QRegularExpression>
 
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
 namespace avdecc
 {
 class LoggerModelPrivate;
@@ -42,6 +49,13 @@ public:
 
 	void clear();
 
+	/** Returns the sequence number of the first row (increased each time the oldest entries are discarded) */
+	std::uint64_t firstSequence() const noexcept;
+	la::avdecc::logger::Layer layer(int const row) const noexcept;
+	la::avdecc::logger::Level level(int const row) const noexcept;
+	/** Returns the raw (UTF-8) message of the specified row, valid until the row is removed */
+	std::string_view message(int const row) const noexcept;
+
 	struct SaveConfiguration
 	{
 		QRegularExpression search{};
@@ -49,7 +63,20 @@ public:
 		QRegularExpression layer{};
 	};
 
-	void save(QString const& filename, SaveConfiguration const& saveConfiguration) const;
+	/** Called while saving with the saved and total entries counts (both 0 while waiting for the journal to be written), returns false to cancel */
+	using SaveProgressHandler = std::function<bool(std::size_t const savedCount, std::size_t const totalCount)>;
+
+	/** Saves the entries logged since the last clear (including the ones no longer in memory, unless the journal has failed). Returns false if cancelled (the file is then removed) */
+	bool save(QString const& filename, SaveConfiguration const& saveConfiguration, SaveProgressHandler const& onProgress = {}) const;
+
+	/** Returns the journal segments of the current session, with all entries logged so far written to disk */
+	std::vector<LogJournal::SegmentInfo> journalSegments() const;
+
+	/** Returns true if the session is not (or no longer) journaled to disk */
+	bool hasJournalFailed() const noexcept;
+
+	/** Returns the number of entries never journaled, dropped because writing the journal to disk was too slow */
+	std::uint64_t journalDroppedCount() const;
 
 private:
 	LoggerModelPrivate* const d_ptr{ nullptr };
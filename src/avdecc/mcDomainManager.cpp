@@ -26,7 +26,11 @@
 
 #include <atomic>
 #include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <math.h>
 
 namespace avdecc
@@ -49,9 +53,47 @@ namespace mediaClock
 class MCDomainManagerImpl final : public MCDomainManager
 {
 private:
+	// Private types
+	/** Local clock information of an entity (node of the clock graph), only depending on the entity itself */
+	struct ClockNode
+	{
+		McDeterminationError error{ McDeterminationError::NoError }; // Error preventing to follow the clock of this entity
+		la::avdecc::entity::model::ClockSourceType clockSourceType{ la::avdecc::entity::model::ClockSourceType::Internal };
+		bool hasClockStream{ false }; // Whether the clock stream could be determined (active InputStream one, or first CRF input for an Internal clock source)
+		la::avdecc::UniqueIdentifier clockTalker{}; // Entity connected to the clock stream (edge of the clock graph)
+
+		bool operator==(ClockNode const& other) const noexcept
+		{
+			return error == other.error && clockSourceType == other.clockSourceType && hasClockStream == other.hasClockStream && clockTalker == other.clockTalker;
+		}
+	};
+	/** Media clock master of an entity, resolved from the clock graph */
+	struct ClockResolution
+	{
+		la::avdecc::UniqueIdentifier master{};
+		McDeterminationError error{ McDeterminationError::UnknownEntity };
+		la::avdecc::UniqueIdentifier secondaryMaster{}; // Only set for a mc master with a valid secondary master
+
+		bool operator==(ClockResolution const& other) const noexcept
+		{
+			return master == other.master && error == other.error && secondaryMaster == other.secondaryMaster;
+		}
+	};
+	struct DomainUsage
+	{
+		DomainIndex domainIndex{ 0u };
+		std::size_t useCount{ 0u };
+	};
+	using EntitySet = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>;
+
 	// Private members
 	std::set<la::avdecc::UniqueIdentifier> _entities{}; // No lock required, only read/write in the UI thread
-	MCEntityDomainMapping _currentMCDomainMapping{};
+	MCEntityDomainMapping _currentMCDomainMapping{}; // Incrementally updated from _clockResolutions (domain sampling rates are only computed by createMediaClockDomainModel)
+	std::unordered_map<la::avdecc::UniqueIdentifier, ClockNode, la::avdecc::UniqueIdentifier::hash> _clockNodes{}; // Clock graph nodes of online entities
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntitySet, la::avdecc::UniqueIdentifier::hash> _clockDependents{}; // Reverse edges of the clock graph: entities which clock stream is connected to the key entity (kept while the key entity is offline)
+	std::unordered_map<la::avdecc::UniqueIdentifier, ClockResolution, la::avdecc::UniqueIdentifier::hash> _clockResolutions{};
+	std::unordered_map<la::avdecc::UniqueIdentifier, DomainUsage, la::avdecc::UniqueIdentifier::hash> _domainUsages{}; // Domain of each mc master in _currentMCDomainMapping, with its number of entities
+	DomainIndex _nextDomainIndex{ 0u };
 	commandChain::SequentialAsyncCommandExecuter _sequentialAcmpCommandExecuter{};
 
 public:
@@ -64,8 +106,10 @@ public:
 		connect(&manager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &MCDomainManagerImpl::onControllerOffline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &MCDomainManagerImpl::onEntityOnline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &MCDomainManagerImpl::onEntityOffline);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this, &MCDomainManagerImpl::onEntitiesOnline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::streamInputConnectionChanged, this, &MCDomainManagerImpl::onStreamInputConnectionChanged);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::clockSourceChanged, this, &MCDomainManagerImpl::onClockSourceChanged);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::streamFormatChanged, this, &MCDomainManagerImpl::onStreamFormatChanged);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityNameChanged, this, &MCDomainManagerImpl::onEntityNameChanged);
 
 		qRegisterMetaType<commandChain::CommandExecutionErrors>("CommandExecutionErrors");
@@ -83,6 +127,18 @@ public:
 			{
 				emit applyMediaClockDomainModelProgressUpdate(roundf(((float)completedCommands) / totalCommands * 100));
 			});
+
+		connect(&_sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::chainProgressUpdate, this,
+			[this](la::avdecc::UniqueIdentifier const entityId, size_t const completedCommands, size_t const totalCommands)
+			{
+				emit applyMediaClockDomainModelEntityProgressUpdate(entityId, roundf(((float)completedCommands) / totalCommands * 100));
+			});
+
+		connect(&_sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::chainCompleted, this,
+			[this](la::avdecc::UniqueIdentifier const entityId, commandChain::CommandExecutionErrors const errors)
+			{
+				emit applyMediaClockDomainModelEntityFinished(entityId, errors);
+			});
 	}
 
 	~MCDomainManagerImpl() noexcept {}
@@ -145,7 +201,7 @@ private:
 	}
 
 	/**
-	* Gets the media clock master for an entity. This algortihm might take a while, depending on the chain length.
+	* Gets the media clock master for an entity. The chain is followed using the clock graph (see refreshClockNode), no entity is locked.
 	* For quick access (and outside of this class) getMediaClockMaster can be used instead.
 	*
 	* Detailed algorithm description:
@@ -158,10 +214,9 @@ private:
 	*	- the entity id where the chain ends, because it's clock source is set to external
 	*	- la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), if the mc master cannot be determined (error case).
 	* Errors can occur when:
-	*	- Some entity in the chain cannot be found/accessed using the hive::modelsLibrary::ControllerManager instance.
+	*	- Some entity in the chain is not online.
 	*	- Some entity in the chain does not have the AemSupported flag.
-	*	- An exception occurs while accessing some data.
-	*	- Some dynamic/static model is null.
+	*	- An exception occured while accessing some data.
 	*	- The chain of entities is recursive.
 	*
 	* The searchForAdditionalConnectionsOfMCMaster parameter enables this method to search for secondary mc masters.
@@ -172,127 +227,316 @@ private:
 	* @param searchForAdditionalConnectionsOfMCMaster Should be set to true, if the connected mc master is of interest although the given entity is it's own mc master.
 	* @return A pair of an entity id and an error. Error identifies if an mc master could be determined.
 	*/
-	virtual std::pair<la::avdecc::UniqueIdentifier, McDeterminationError> findMediaClockMaster(la::avdecc::UniqueIdentifier const entityID, bool searchForSecondaryMcMaster = false) noexcept
+	virtual std::pair<la::avdecc::UniqueIdentifier, McDeterminationError> findMediaClockMaster(la::avdecc::UniqueIdentifier const entityID, bool searchForSecondaryMcMaster = false) const noexcept
 	{
-		auto error = McDeterminationError::UnknownEntity;
-		// the map is used to keep track of the entities we already visited, to prevent running in circles
-		std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> searchedEntityIds;
+		// the set is used to keep track of the entities we already visited, to prevent running in circles
+		EntitySet searchedEntityIds;
 		auto currentEntityId = entityID;
 
 		// insert the first entity in to the chain
 		searchedEntityIds.insert(currentEntityId);
-		bool keepSearching = true;
-		while (keepSearching)
+		while (true)
 		{
-			auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
-			auto const& controlledEntity = manager.getControlledEntity(currentEntityId);
-			if (!controlledEntity)
+			auto const nodeIt = _clockNodes.find(currentEntityId);
+			if (nodeIt == _clockNodes.end())
 			{
-				error = McDeterminationError::AnyEntityInChainOffline;
-				keepSearching = false;
-				break;
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::AnyEntityInChainOffline);
 			}
-			if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) || !controlledEntity->hasAnyConfiguration())
+			auto const& node = nodeIt->second;
+			if (node.error != McDeterminationError::NoError)
 			{
-				keepSearching = false;
-				error = McDeterminationError::NotSupportedNoAem;
-				break;
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), node.error);
 			}
 
-			try
+			switch (node.clockSourceType)
 			{
-				auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-				auto const activeConfigIndex = configNode.descriptorIndex;
-
-				// for now, we only support devices that have exactly 1 clock domain.
-				if (configNode.clockDomains.size() > 1)
-				{
-					keepSearching = false;
-					error = McDeterminationError::NotSupportedMultipleClockDomains;
+				case la::avdecc::entity::model::ClockSourceType::Internal:
+					if (!(searchForSecondaryMcMaster && entityID == currentEntityId))
+					{
+						return std::make_pair(currentEntityId, McDeterminationError::NoError);
+					}
 					break;
-				}
-				else if (configNode.clockDomains.empty())
+				case la::avdecc::entity::model::ClockSourceType::External:
+					return std::make_pair(currentEntityId, McDeterminationError::ExternalClockSource);
+				default: // InputStream (unsupported types are stored as a node error)
+					break;
+			}
+
+			if (!node.hasClockStream)
+			{
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity);
+			}
+			if (!node.clockTalker)
+			{
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), searchedEntityIds.size() == 1 ? McDeterminationError::StreamNotConnected : McDeterminationError::ParentStreamNotConnected);
+			}
+			if (!searchedEntityIds.insert(node.clockTalker).second)
+			{
+				// recusion of entity clock stream connections detected
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
+			}
+			// set the next entity to traverse
+			currentEntityId = node.clockTalker;
+		}
+	}
+
+	/**
+	* Reads the local clock information of an entity (active clock source and entity connected to its clock stream), which is a node of the clock graph.
+	* Only the snapshot of this entity is read, the rest of the chain is followed by findMediaClockMaster.
+	* @param entityID The id of the entity.
+	* @return The clock node of the entity.
+	*/
+	ClockNode buildClockNode(la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		auto node = ClockNode{};
+
+		// Read from the snapshot of the entity, so the graph can be refreshed without locking the entity
+		auto const snapshot = hive::modelsLibrary::ControllerManager::getInstance().getEntitySnapshot(entityID);
+		if (!snapshot)
+		{
+			node.error = McDeterminationError::AnyEntityInChainOffline;
+			return node;
+		}
+		if (!snapshot->isAemSupported || !snapshot->hasConfiguration)
+		{
+			node.error = McDeterminationError::NotSupportedNoAem;
+			return node;
+		}
+
+		auto const& clocks = *snapshot->clocks;
+
+		// for now, we only support devices that have exactly 1 clock domain.
+		if (clocks.clockDomains.size() > 1)
+		{
+			node.error = McDeterminationError::NotSupportedMultipleClockDomains;
+			return node;
+		}
+		else if (clocks.clockDomains.empty())
+		{
+			node.error = McDeterminationError::NotSupportedNoClockDomains;
+			return node;
+		}
+
+		auto const activeClockSourceIt = clocks.clockSources.find(clocks.clockDomains.begin()->second.clockSourceIndex);
+		if (activeClockSourceIt == clocks.clockSources.end())
+		{
+			node.error = McDeterminationError::UnknownEntity;
+			return node;
+		}
+		auto const& activeClockSource = activeClockSourceIt->second;
+		node.clockSourceType = activeClockSource.clockSourceType;
+
+		switch (node.clockSourceType)
+		{
+			case la::avdecc::entity::model::ClockSourceType::Internal:
+			case la::avdecc::entity::model::ClockSourceType::InputStream:
+				break;
+			case la::avdecc::entity::model::ClockSourceType::External:
+				// The clock stream is not followed
+				return node;
+			default:
+				node.error = McDeterminationError::NotSupportedClockSourceType;
+				return node;
+		}
+
+		// find the relevant clock stream index
+		std::optional<la::avdecc::entity::model::StreamIndex> clockStreamIndex = std::nullopt;
+		if (activeClockSource.clockSourceLocationType == la::avdecc::entity::model::DescriptorType::StreamInput)
+		{
+			// In the case StreamInput as clockSourceLocationType we can get the relevant index directly from the static model
+			clockStreamIndex = activeClockSource.clockSourceLocationIndex;
+		}
+		else if (node.clockSourceType == la::avdecc::entity::model::ClockSourceType::Internal)
+		{
+			// Used when searching for a secondary master, we have to get the index by checking all streams if they are a CRF stream.
+			for (auto const& [streamIndex, streamInput] : snapshot->streams->inputs)
+			{
+				auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamInput.streamFormat);
+				if (la::avdecc::entity::model::StreamFormatInfo::Type::ClockReference == streamFormatInfo->getType())
 				{
-					keepSearching = false;
-					error = McDeterminationError::NotSupportedNoClockDomains;
+					clockStreamIndex = streamIndex;
 					break;
 				}
+			}
+		}
 
-				// The first clock domain that can be used, will be used. All further clock domains are ignored.
-				for (auto const& clockDomainKV : configNode.clockDomains)
-				{
-					auto const& clockDomain = clockDomainKV.second;
-					auto clockSourceIndex = clockDomain.dynamicModel.clockSourceIndex;
-					auto const& activeClockSourceNode = controlledEntity->getClockSourceNode(activeConfigIndex, clockSourceIndex);
+		if (clockStreamIndex)
+		{
+			// An invalid clock stream cannot be followed (but an Internal clock source is still its own master)
+			if (auto const streamIt = snapshot->streams->inputs.find(*clockStreamIndex); streamIt != snapshot->streams->inputs.end())
+			{
+				node.clockTalker = streamIt->second.connectionInfo.talkerStream.entityID;
+				node.hasClockStream = true;
+			}
+		}
 
-					switch (activeClockSourceNode.staticModel.clockSourceType)
-					{
-						case la::avdecc::entity::model::ClockSourceType::Internal:
-							if (!(searchForSecondaryMcMaster && entityID == currentEntityId))
-							{
-								return std::make_pair(currentEntityId, McDeterminationError::NoError);
-							}
-							break;
-						case la::avdecc::entity::model::ClockSourceType::External:
-							return std::make_pair(currentEntityId, McDeterminationError::ExternalClockSource);
-						case la::avdecc::entity::model::ClockSourceType::InputStream:
-							break;
-						default:
-							error = McDeterminationError::NotSupportedClockSourceType;
-							keepSearching = false;
-							return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-					}
+		return node;
+	}
 
-					// find the relevant clock stream index
-					std::optional<la::avdecc::entity::model::StreamIndex> clockStreamIndex = std::nullopt;
-					if (activeClockSourceNode.staticModel.clockSourceLocationType == la::avdecc::entity::model::DescriptorType::StreamInput)
-					{
-						// In the case StreamInput as clockSourceLocationType we can get the relevant index directly from the static model
-						clockStreamIndex = activeClockSourceNode.staticModel.clockSourceLocationIndex;
-					}
-					else if (activeClockSourceNode.staticModel.clockSourceType == la::avdecc::entity::model::ClockSourceType::Internal)
-					{
-						// In the case we are searching for a secondary master, we have to get the index by checking all streams if they are a CRF stream.
-						auto indexes = findInputClockStreamIndexInConfiguration(configNode);
-						if (!indexes.empty())
-						{
-							clockStreamIndex = indexes.at(0);
-						}
-					}
+	/**
+	* Reads the clock node of an entity and updates the clock graph (node and reverse edge) if it changed.
+	* @param entityID The id of the entity.
+	* @return True if the clock node of the entity changed (or was just created).
+	*/
+	bool refreshClockNode(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto node = buildClockNode(entityID);
 
-					if (clockStreamIndex)
-					{
-						auto& clockStreamDynModel = controlledEntity->getStreamInputNode(activeConfigIndex, *clockStreamIndex).dynamicModel;
-						auto connectedTalker = clockStreamDynModel.connectionInfo.talkerStream.entityID;
-						if (!connectedTalker)
-						{
-							error = searchedEntityIds.size() == 1 ? McDeterminationError::StreamNotConnected : McDeterminationError::ParentStreamNotConnected;
-							keepSearching = false;
-							return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-						}
-						if (searchedEntityIds.count(connectedTalker))
-						{
-							// recusion of entity clock stream connections detected
-							return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
-						}
-						// set the next entity to traverse
-						currentEntityId = connectedTalker;
-						searchedEntityIds.insert(currentEntityId);
-					}
-					else
+		auto const nodeIt = _clockNodes.find(entityID);
+		if (nodeIt != _clockNodes.end())
+		{
+			if (nodeIt->second == node)
+			{
+				return false;
+			}
+			removeClockDependent(nodeIt->second.clockTalker, entityID);
+		}
+		if (node.clockTalker)
+		{
+			_clockDependents[node.clockTalker].insert(entityID);
+		}
+		_clockNodes[entityID] = std::move(node);
+
+		return true;
+	}
+
+	/**
+	* Removes the clock node of an entity from the clock graph. Edges from other entities to this one are kept, so they are resolved again when the entity comes back online.
+	* @param entityID The id of the entity.
+	*/
+	void removeClockNode(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto const nodeIt = _clockNodes.find(entityID);
+		if (nodeIt != _clockNodes.end())
+		{
+			removeClockDependent(nodeIt->second.clockTalker, entityID);
+			_clockNodes.erase(nodeIt);
+		}
+	}
+
+	void removeClockDependent(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto const dependentsIt = _clockDependents.find(talkerEntityID);
+		if (dependentsIt != _clockDependents.end())
+		{
+			dependentsIt->second.erase(entityID);
+			if (dependentsIt->second.empty())
+			{
+				_clockDependents.erase(dependentsIt);
+			}
+		}
+	}
+
+	/**
+	* Gets all entities which media clock resolution depends on the given entity: the entity itself and all entities (transitively) getting their clock from it.
+	* @param entityID The id of the entity.
+	* @return The entity and its dependents.
+	*/
+	std::vector<la::avdecc::UniqueIdentifier> collectClockDependents(la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		auto dependents = std::vector<la::avdecc::UniqueIdentifier>{ entityID };
+		auto visited = EntitySet{ entityID };
+
+		for (auto pos = std::size_t{ 0u }; pos < dependents.size(); ++pos)
+		{
+			auto const dependentsIt = _clockDependents.find(dependents[pos]);
+			if (dependentsIt != _clockDependents.end())
+			{
+				for (auto const& dependentID : dependentsIt->second)
+				{
+					if (visited.insert(dependentID).second)
 					{
-						keepSearching = false;
-						return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
+						dependents.push_back(dependentID);
 					}
 				}
 			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		}
+
+		return dependents;
+	}
+
+	/**
+	* Resolves the media clock master (and secondary master if the entity is a master) of an entity using the clock graph.
+	*/
+	ClockResolution resolveClock(la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		auto resolution = ClockResolution{};
+		std::tie(resolution.master, resolution.error) = findMediaClockMaster(entityID);
+		if (resolution.master == entityID)
+		{
+			auto const [secondaryMasterId, secondaryMasterError] = findMediaClockMaster(entityID, true);
+			if (secondaryMasterId && !secondaryMasterError)
 			{
-				keepSearching = false;
-				break;
+				resolution.secondaryMaster = secondaryMasterId;
+			}
+		}
+		return resolution;
+	}
+
+	/**
+	* Gets the domains of an entity from its clock resolution. The first domain is the one of its mc master, the second one the domain of its secondary master (if any).
+	* @param resolution The clock resolution of the entity.
+	* @param getDomainIndex Function returning the domain index for a mc master id.
+	*/
+	template<typename GetDomainIndex>
+	static std::vector<DomainIndex> getEntityDomains(ClockResolution const& resolution, GetDomainIndex&& getDomainIndex) noexcept
+	{
+		auto associatedDomains = std::vector<DomainIndex>{};
+		// in case the mc is provided via external input on mc master, the entity is part of the mc master domain (in addition to the error)
+		if (!resolution.error || resolution.error == McDeterminationError::ExternalClockSource)
+		{
+			associatedDomains.push_back(getDomainIndex(resolution.master));
+		}
+		if (resolution.secondaryMaster)
+		{
+			associatedDomains.push_back(getDomainIndex(resolution.secondaryMaster));
+		}
+		return associatedDomains;
+	}
+
+	DomainIndex acquireDomain(la::avdecc::UniqueIdentifier const mediaClockMasterId) noexcept
+	{
+		auto& usage = _domainUsages[mediaClockMasterId];
+		if (usage.useCount++ == 0u)
+		{
+			usage.domainIndex = _nextDomainIndex++;
+			_currentMCDomainMapping.getMediaClockDomains().emplace(usage.domainIndex, MCDomain{ usage.domainIndex, mediaClockMasterId });
+		}
+		return usage.domainIndex;
+	}
+
+	void releaseDomain(DomainIndex const domainIndex) noexcept
+	{
+		auto& domains = _currentMCDomainMapping.getMediaClockDomains();
+		auto const domainIt = domains.find(domainIndex);
+		if (domainIt != domains.end())
+		{
+			auto const usageIt = _domainUsages.find(domainIt->second.getMediaClockDomainMaster());
+			if (usageIt != _domainUsages.end() && --usageIt->second.useCount == 0u)
+			{
+				_domainUsages.erase(usageIt);
+				domains.erase(domainIt);
+			}
+		}
+	}
+
+	/**
+	* Removes an entity from the current mapping, releasing its domains.
+	*/
+	void removeFromCurrentMapping(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto& mappings = _currentMCDomainMapping.getEntityMediaClockMasterMappings();
+		auto const mappingIt = mappings.find(entityID);
+		if (mappingIt != mappings.end())
+		{
+			for (auto const domainIndex : mappingIt->second)
+			{
+				releaseDomain(domainIndex);
 			}
+			mappings.erase(mappingIt);
 		}
-		return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
+		_currentMCDomainMapping.getEntityMcErrors().erase(entityID);
+		_clockResolutions.erase(entityID);
 	}
 
 	/**
@@ -301,10 +545,10 @@ private:
 	* clock source from this master.
 	*
 	* Detailed algorithm description:
-	* 1. Get the mc master of every enitity that is known and insert into the the mappings varibale.
+	* 1. Get the mc master of every enitity that is known (from the incrementally maintained clock resolutions) and insert into the the mappings varibale.
 	*	 The method getOrCreateDomainIndexForClockMasterId is used to create Domain objects and inserts
 	*	 them into the domains variable. A domain contains domain specific data. See \link avdecc::mediaClock::MCDomain MCDomain class \endlink
-	* 2. For every entity that is a mc master, a secondary master is tried to be determined.
+	* 2. For every entity that is a mc master, the secondary master (if any) domain is added as well.
 	* 3. For every domain, the sampling rate is determined by getting the sample rates of all entities assigned to that domain.
 	*	 If every entity inside the domain has the same sample rate, the domain sample rate is set to that rate.
 	*	 If there are different sample rates or no sample rate, the domain sample rate is set to la::avdecc::entity::model::getNullSamplingRate().
@@ -316,76 +560,51 @@ private:
 		auto mappings = MCEntityDomainMapping::Mappings{};
 		auto domains = MCEntityDomainMapping::Domains{};
 		auto errors = MCEntityDomainMapping::Errors{};
+		auto domainsSampleRates = std::unordered_map<DomainIndex, std::set<la::avdecc::entity::model::SamplingRate>>{};
 
 		for (auto const& entityId : _entities)
 		{
-			std::vector<avdecc::mediaClock::DomainIndex> associatedDomains;
+			auto const resolutionIt = _clockResolutions.find(entityId);
+			auto const resolution = resolutionIt != _clockResolutions.end() ? resolutionIt->second : resolveClock(entityId);
 
-			// get mc master if there is one.
-			auto mcMasterIdKV = findMediaClockMaster(entityId);
-			auto const& mcMasterId = mcMasterIdKV.first;
-			auto const mcMasterError = mcMasterIdKV.second;
-			if (!mcMasterError)
-			{
-				auto const domainIndex = getOrCreateDomainIndexForClockMasterId(domains, mcMasterId);
-				associatedDomains.push_back(domainIndex);
-			}
-			else if (mcMasterError == McDeterminationError::ExternalClockSource)
-			{
-				// in case the mc is provided via external input on mc master, we need to do both set the error and determine the mc master id /domain idx
-				auto const domainIndex = getOrCreateDomainIndexForClockMasterId(domains, mcMasterId);
-				associatedDomains.push_back(domainIndex);
-				errors.emplace(entityId, mcMasterError);
-			}
-			else
+			auto associatedDomains = getEntityDomains(resolution,
+				[this, &domains](la::avdecc::UniqueIdentifier const mediaClockMasterId)
+				{
+					return getOrCreateDomainIndexForClockMasterId(domains, mediaClockMasterId);
+				});
+			if (resolution.error != McDeterminationError::NoError)
 			{
 				// errors are stored as well for the findMediaClockMaster method
-				errors.emplace(entityId, mcMasterError);
+				errors.emplace(entityId, resolution.error);
 			}
 
-			if (mcMasterId == entityId)
+			// collect the sample rate of the entity for all its domains
+			if (!associatedDomains.empty())
 			{
-				// get secondary mc master if there is one
-				auto secondaryMasterIdKV = findMediaClockMaster(entityId, true);
-				auto const& secondaryMasterId = secondaryMasterIdKV.first;
-				auto const secondaryMasterError = secondaryMasterIdKV.second;
-				if (secondaryMasterId) // check if the id is valid
+				auto const sampleRate = getSampleRateOfEntity(entityId);
+				if (sampleRate)
 				{
-					if (!secondaryMasterError)
+					for (auto const domainIndex : associatedDomains)
 					{
-						auto const domainIndex = getOrCreateDomainIndexForClockMasterId(domains, secondaryMasterId);
-						associatedDomains.push_back(domainIndex);
+						domainsSampleRates[domainIndex].insert(*sampleRate);
 					}
 				}
 			}
-			mappings.emplace(entityId, associatedDomains);
+
+			mappings.emplace(entityId, std::move(associatedDomains));
 		}
 
-		// loop through all domains, then through all entities in that domain to get the domain sample rate.
+		// set the domain sample rate if all entities in that domain share the same one.
 		for (auto& domainKV : domains)
 		{
-			std::set<la::avdecc::entity::model::SamplingRate> sampleRates;
-			for (auto const& entityIdKV : mappings)
-			{
-				for (auto const entityDomainIndex : entityIdKV.second)
-				{
-					if (domainKV.second.getDomainIndex() == entityDomainIndex)
-					{
-						auto sampleRate = getSampleRateOfEntity(entityIdKV.first);
-						if (sampleRate)
-						{
-							sampleRates.insert(*sampleRate);
-						}
-					}
-				}
-			}
-			if (sampleRates.size() > 1 || sampleRates.size() == 0)
+			auto const sampleRatesIt = domainsSampleRates.find(domainKV.first);
+			if (sampleRatesIt == domainsSampleRates.end() || sampleRatesIt->second.size() != 1)
 			{
 				domainKV.second.setDomainSamplingRate(la::avdecc::entity::model::SamplingRate::getNullSamplingRate());
 			}
 			else
 			{
-				domainKV.second.setDomainSamplingRate(*sampleRates.begin());
+				domainKV.second.setDomainSamplingRate(*sampleRatesIt->second.begin());
 			}
 		}
 
@@ -418,6 +637,7 @@ private:
 
 		// apply sample rates
 		// this is done first, because otherwise changes would be overwritten.
+		// commands declare the entities they touch, so the executer runs the changes of unrelated entities concurrently.
 		for (const auto& entityKV : newDomainModel.getEntityMediaClockMasterMappings())
 		{
 			auto const& entityId = entityKV.first;
@@ -434,18 +654,30 @@ private:
 					auto* commandsRemoveAllConnections = new commandChain::AsyncParallelCommandSet;
 					auto outputStreamConnections = getAllStreamOutputConnections(entityId);
 					auto inputStreamConnections = getAllStreamInputConnections(entityId);
+
+					// the entity and all entities it is connected to are touched
+					auto scope = commandChain::AsyncParallelCommandSet::CommandScope{ entityId };
+					for (auto const& [listenerStream, connectionInfo] : outputStreamConnections)
+					{
+						scope.push_back(listenerStream.entityID);
+					}
+					for (auto const& [listenerStream, connectionInfo] : inputStreamConnections)
+					{
+						scope.push_back(connectionInfo.talkerStream.entityID);
+					}
+
 					auto commandsRemoveOutputStreams = removeAllStreamOutputConnections(entityId, outputStreamConnections);
-					commandsRemoveAllConnections->append(commandsRemoveOutputStreams);
+					commandsRemoveAllConnections->append(commandsRemoveOutputStreams, scope);
 					auto commandsRemoveInputStreams = removeAllStreamInputConnections(entityId, inputStreamConnections);
-					commandsRemoveAllConnections->append(commandsRemoveInputStreams);
+					commandsRemoveAllConnections->append(commandsRemoveInputStreams, scope);
 
-					auto* commandsSetSamplingRate = new commandChain::AsyncParallelCommandSet(adjustAudioUnitSampleRates(entityId, targetSampleRate));
+					auto* commandsSetSamplingRate = new commandChain::AsyncParallelCommandSet(adjustAudioUnitSampleRates(entityId, targetSampleRate), { entityId });
 
 					auto* commandsRestoreAllConnections = new commandChain::AsyncParallelCommandSet;
 					auto commandsRestoreOutputStreams = restoreOutputStreamConnections(entityId, outputStreamConnections);
-					commandsRestoreAllConnections->append(commandsRestoreOutputStreams);
+					commandsRestoreAllConnections->append(commandsRestoreOutputStreams, scope);
 					auto commandsRestoreInputStreams = restoreInputStreamConnections(entityId, inputStreamConnections);
-					commandsRestoreAllConnections->append(commandsRestoreInputStreams);
+					commandsRestoreAllConnections->append(commandsRestoreInputStreams, scope);
 
 					commands.push_back(commandsRemoveAllConnections);
 					commands.push_back(commandsSetSamplingRate);
@@ -478,8 +710,9 @@ private:
 						if (entityKV.first != oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster())
 						{
 							// no longer existant, remove mc stream connection
-							auto commandsRemoveClockStreamConnection = removeClockStreamConnection(oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster(), entityKV.first);
-							commandsRemoveOldMappingConnections->append(commandsRemoveClockStreamConnection);
+							auto const oldMasterId = oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster();
+							auto commandsRemoveClockStreamConnection = removeClockStreamConnection(oldMasterId, entityKV.first);
+							commandsRemoveOldMappingConnections->append(commandsRemoveClockStreamConnection, { entityKV.first, oldMasterId });
 						}
 						else
 						{
@@ -488,7 +721,7 @@ private:
 								// the entity is the mc master of the domain
 								// set it's clock source to internal
 								auto command = setEntityClockToCRFInputStream(entityKV.first, 0);
-								commandsRemoveOldMappingConnections->append(command);
+								commandsRemoveOldMappingConnections->append(command, { entityKV.first });
 							}
 						}
 					}
@@ -498,7 +731,7 @@ private:
 				if (newDomainModel.getEntityMediaClockMasterMappings().at(entityKV.first).empty())
 				{
 					auto command = setEntityClockToExternal(entityKV.first, 0);
-					commandsRemoveOldMappingConnections->append(command);
+					commandsRemoveOldMappingConnections->append(command, { entityKV.first });
 				}
 			}
 		}
@@ -528,20 +761,21 @@ private:
 						{
 							// set the clock source to crf input stream for clock domain at index 0
 							auto commandToExternal = setEntityClockToCRFInputStream(entityKV.first, 0);
-							commandsSetupNewMappingConnections->append(commandToExternal);
+							commandsSetupNewMappingConnections->append(commandToExternal, { entityKV.first });
 						}
 
 						// the entity is not the mc master
 						// create a clock channel connection.
-						auto commandsCreateConnection = createClockStreamConnection(newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster(), entityKV.first);
-						commandsSetupNewMappingConnections->append(commandsCreateConnection);
+						auto const newMasterId = newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster();
+						auto commandsCreateConnection = createClockStreamConnection(newMasterId, entityKV.first);
+						commandsSetupNewMappingConnections->append(commandsCreateConnection, { entityKV.first, newMasterId });
 					}
 					else
 					{
 						// the added entity is the mc master of the domain
 						// set it's clock source to internal
 						auto command = setEntityClockToInternal(entityKV.first, 0);
-						commandsSetupNewMappingConnections->append(command);
+						commandsSetupNewMappingConnections->append(command, { entityKV.first });
 					}
 				}
 			}
@@ -1614,34 +1848,35 @@ private:
 	}
 
 	/**
-	* Compares the current mc mapping state with the previous one and
-	* emits the mediaClockConnectionsUpdate to inform the views about changes.
+	* Resolves the clock of the given entities again (using the clock graph), updates the current mc mapping state accordingly and
+	* emits the mediaClockConnectionsUpdate to inform the views about entities which mc master (or error) changed.
+	* Entities no longer known are removed from the mapping (without being notified).
+	* @param entityIds The entities which resolution might have changed (see collectClockDependents).
 	*/
-	void notifyChanges() noexcept
+	void notifyChanges(std::vector<la::avdecc::UniqueIdentifier> const& entityIds) noexcept
 	{
-		// potentially changes every other entity...
 		std::vector<la::avdecc::UniqueIdentifier> changes;
-		auto currentMCDomainMapping = createMediaClockDomainModel();
-		auto& currentMCDomains = currentMCDomainMapping.getMediaClockDomains();
-		auto& previousMCDomainMapping = _currentMCDomainMapping;
-		auto const& previousMCMasterMappings = previousMCDomainMapping.getEntityMediaClockMasterMappings();
-		auto const& previousMCDomains = previousMCDomainMapping.getMediaClockDomains();
-		auto const& previousErrors = previousMCDomainMapping.getEntityMcErrors();
-		auto const& currentErrors = currentMCDomainMapping.getEntityMcErrors();
 
-		for (auto const& entityDomainKV : currentMCDomainMapping.getEntityMediaClockMasterMappings())
+		for (auto const& entityId : entityIds)
 		{
-			auto const entityId = entityDomainKV.first;
-			auto const oldDomainIndexesIterator = previousMCMasterMappings.find(entityId);
-			if (oldDomainIndexesIterator != previousMCMasterMappings.end())
+			if (_entities.count(entityId) == 0)
+			{
+				removeFromCurrentMapping(entityId);
+				continue;
+			}
+
+			auto resolution = resolveClock(entityId);
+			auto const previousResolutionIt = _clockResolutions.find(entityId);
+			if (previousResolutionIt != _clockResolutions.end())
 			{
-				if (checkMcMasterOfEntityChanged(oldDomainIndexesIterator->second, entityDomainKV.second, previousMCDomains, currentMCDomains))
+				auto const& previousResolution = previousResolutionIt->second;
+				if (previousResolution == resolution)
 				{
-					changes.push_back(entityId);
+					continue;
 				}
-				else if ((previousErrors.count(entityId) > 0 && currentErrors.count(entityId) > 0 && previousErrors.at(entityId) != currentErrors.at(entityId)) || previousErrors.count(entityId) != currentErrors.count(entityId))
+				// only the mc master (or error) change is notified, secondary masters are not of relevance here
+				if (previousResolution.master != resolution.master || previousResolution.error != resolution.error)
 				{
-					// if the error type changed add the entity to the changes list as well.
 					changes.push_back(entityId);
 				}
 			}
@@ -1650,10 +1885,21 @@ private:
 				// if it wasn't there before, it changed.
 				changes.push_back(entityId);
 			}
-		}
 
-		// Update the model
-		_currentMCDomainMapping = std::move(currentMCDomainMapping);
+			// Update the model
+			removeFromCurrentMapping(entityId);
+			_currentMCDomainMapping.getEntityMediaClockMasterMappings().emplace(entityId,
+				getEntityDomains(resolution,
+					[this](la::avdecc::UniqueIdentifier const mediaClockMasterId)
+					{
+						return acquireDomain(mediaClockMasterId);
+					}));
+			if (resolution.error != McDeterminationError::NoError)
+			{
+				_currentMCDomainMapping.getEntityMcErrors().emplace(entityId, resolution.error);
+			}
+			_clockResolutions.emplace(entityId, std::move(resolution));
+		}
 
 		// Notify the view
 		if (!changes.empty())
@@ -1662,6 +1908,17 @@ private:
 		}
 	}
 
+	/**
+	* Refreshes the clock node of an entity, and if it changed, updates the entity and all entities depending on it.
+	*/
+	void onClockNodeMightHaveChanged(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		if (_entities.count(entityId) != 0 && refreshClockNode(entityId))
+		{
+			notifyChanges(collectClockDependents(entityId));
+		}
+	}
+
 
 	// Slots
 
@@ -1671,7 +1928,12 @@ private:
 	void onControllerOffline()
 	{
 		_entities.clear();
-		notifyChanges();
+		_clockNodes.clear();
+		_clockDependents.clear();
+		_clockResolutions.clear();
+		_domainUsages.clear();
+		_nextDomainIndex = 0u;
+		_currentMCDomainMapping = MCEntityDomainMapping{};
 	}
 
 	/**
@@ -1681,7 +1943,35 @@ private:
 	{
 		// add entity to the set
 		_entities.insert(entityId);
-		notifyChanges();
+		refreshClockNode(entityId);
+		// entities which clock chain goes through this entity have to be resolved again
+		notifyChanges(collectClockDependents(entityId));
+	}
+
+	/**
+	* Adds a batch of entities to the internal list, resolving the clock of all affected entities only once.
+	*/
+	void onEntitiesOnline(std::vector<la::avdecc::UniqueIdentifier> const& entityIds)
+	{
+		for (auto const& entityId : entityIds)
+		{
+			_entities.insert(entityId);
+			refreshClockNode(entityId);
+		}
+
+		auto changed = std::vector<la::avdecc::UniqueIdentifier>{};
+		auto visited = EntitySet{};
+		for (auto const& entityId : entityIds)
+		{
+			for (auto const& dependentId : collectClockDependents(entityId))
+			{
+				if (visited.insert(dependentId).second)
+				{
+					changed.push_back(dependentId);
+				}
+			}
+		}
+		notifyChanges(changed);
 	}
 
 	/**
@@ -1691,71 +1981,35 @@ private:
 	{
 		// remove entity from the set
 		_entities.erase(entityId);
-		notifyChanges();
+		removeClockNode(entityId);
+		notifyChanges(collectClockDependents(entityId));
 	}
 
 	/**
-	* Handles the change of a clock source on a stream connection. Checks if the stream is a clock stream and if so emits the mediaClockConnectionsUpdate signal.
+	* Handles the change of a stream connection. If the stream is a clock stream, the clock graph is updated and changes are emitted via the mediaClockConnectionsUpdate signal.
 	*/
 	void onStreamInputConnectionChanged(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const& /*info*/)
 	{
-		auto affectsMcMaster = false;
-		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
-		auto const& controlledEntity = manager.getControlledEntity(stream.entityID);
-		if (controlledEntity)
-		{
-			if (controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) && controlledEntity->hasAnyConfiguration())
-			{
-				try
-				{
-					auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-					auto const activeConfigIndex = configNode.descriptorIndex;
-
-					// find out if the stream connection is set as clock source:
-					for (auto const& clockDomainKV : configNode.clockDomains)
-					{
-						auto const& clockDomain = clockDomainKV.second;
-						auto const clockSourceIndex = clockDomain.dynamicModel.clockSourceIndex;
-						auto const& activeClockSourceNode = controlledEntity->getClockSourceNode(activeConfigIndex, clockSourceIndex);
-
-						switch (activeClockSourceNode.staticModel.clockSourceType)
-						{
-							case la::avdecc::entity::model::ClockSourceType::Internal:
-								break;
-							case la::avdecc::entity::model::ClockSourceType::External:
-							case la::avdecc::entity::model::ClockSourceType::InputStream:
-							{
-								if (stream.streamIndex == activeClockSourceNode.staticModel.clockSourceLocationIndex)
-								{
-									affectsMcMaster = true;
-								}
-								break;
-							}
-							default: // Unsupported ClockSourceType, ignore it
-								break;
-						}
-					}
-				}
-				catch (la::avdecc::controller::ControlledEntity::Exception const&)
-				{
-					// ignore
-				}
-			}
-		}
+		onClockNodeMightHaveChanged(stream.entityID);
+	}
 
-		if (affectsMcMaster)
+	/**
+	* Handles the change of a stream format. Changing the format of an input stream might change the CRF stream used to find a secondary master.
+	*/
+	void onStreamFormatChanged(la::avdecc::UniqueIdentifier const entityId, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamFormat const /*streamFormat*/)
+	{
+		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamInput)
 		{
-			// potentially changes every other entity...
-			notifyChanges();
+			onClockNodeMightHaveChanged(entityId);
 		}
 	}
 
 	/**
 	* Handles the change of a clock source on an entity and emits resulting changes via the mediaClockConnectionsUpdate signal.
 	*/
-	void onClockSourceChanged(la::avdecc::UniqueIdentifier const /*entityId*/, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::ClockSourceIndex const /*clockSourceIndex*/)
+	void onClockSourceChanged(la::avdecc::UniqueIdentifier const entityId, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::ClockSourceIndex const /*clockSourceIndex*/)
 	{
-		notifyChanges();
+		onClockNodeMightHaveChanged(entityId);
 	}
 
 	/**
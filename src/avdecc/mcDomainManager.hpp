@@ -159,6 +159,8 @@ public:
 	Q_SIGNAL void mcMasterNameChanged(std::vector<la::avdecc::UniqueIdentifier> const& entityIds);
 
 	Q_SIGNAL void applyMediaClockDomainModelProgressUpdate(float_t progressPercentage);
+	Q_SIGNAL void applyMediaClockDomainModelEntityProgressUpdate(la::avdecc::UniqueIdentifier const entityId, float_t progressPercentage);
+	Q_SIGNAL void applyMediaClockDomainModelEntityFinished(la::avdecc::UniqueIdentifier const entityId, commandChain::CommandExecutionErrors const errors);
 	Q_SIGNAL void applyMediaClockDomainModelFinished(ApplyInfo);
 };
 
@@ -0,0 +1,145 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace avdecc
+{
+template<typename Key, typename Signature, typename KeyHash = std::hash<Key>>
+class SubscriptionRegistry;
+
+/**
+ * @Brief Handlers subscribed to a notification for a specific Key (usually an entity descriptor)
+ * @Details A notification only invokes the handlers subscribed to its key (found in O(1)), instead of broadcasting it to every handler which then checks the key itself.
+ *          Handlers can subscribe and unsubscribe (themselves or others) while a notification is being dispatched, an unsubscribed handler is never invoked afterwards.
+ *          Counts the invoked handlers, and the ones a broadcast would have invoked for nothing (avoided).
+ */
+template<typename Key, typename KeyHash, typename... Args>
+class SubscriptionRegistry<Key, void(Args...), KeyHash> final
+{
+public:
+	using SubscriptionID = std::uint64_t;
+	using Handler = std::function<void(Args...)>;
+
+	SubscriptionRegistry() noexcept = default;
+
+	/** Subscribes a handler to the notifications of a key, returns the ID to unsubscribe it */
+	SubscriptionID subscribe(Key const& key, Handler handler) noexcept
+	{
+		auto const subscriptionID = _nextSubscriptionID++;
+		_subscriptions.emplace(subscriptionID, Subscription{ key, std::move(handler) });
+		_subscriptionsByKey[key].push_back(subscriptionID);
+		return subscriptionID;
+	}
+
+	/** Unsubscribes a handler (ignored if unknown) */
+	void unsubscribe(SubscriptionID const subscriptionID) noexcept
+	{
+		auto const subscriptionIt = _subscriptions.find(subscriptionID);
+		if (subscriptionIt == _subscriptions.end())
+		{
+			return;
+		}
+
+		auto const keyIt = _subscriptionsByKey.find(subscriptionIt->second.key);
+		auto& subscriptionIDs = keyIt->second;
+		subscriptionIDs.erase(std::find(subscriptionIDs.begin(), subscriptionIDs.end(), subscriptionID));
+		if (subscriptionIDs.empty())
+		{
+			_subscriptionsByKey.erase(keyIt);
+		}
+		_subscriptions.erase(subscriptionIt);
+	}
+
+	/** Invokes the handlers subscribed to the key, returns the number of invoked handlers */
+	std::size_t notify(Key const& key, Args... args)
+	{
+		auto const keyIt = _subscriptionsByKey.find(key);
+		auto const subscriptionIDs = keyIt == _subscriptionsByKey.end() ? std::vector<SubscriptionID>{} : keyIt->second;
+		_avoidedCount += _subscriptions.size() - subscriptionIDs.size();
+
+		auto invokedCount = std::size_t{ 0u };
+		for (auto const subscriptionID : subscriptionIDs)
+		{
+			// A previous handler may have unsubscribed this one
+			if (auto const subscriptionIt = _subscriptions.find(subscriptionID); subscriptionIt != _subscriptions.end())
+			{
+				// Copy the handler, it may unsubscribe itself
+				auto const handler = subscriptionIt->second.handler;
+				handler(args...);
+				++invokedCount;
+			}
+		}
+		_invokedCount += invokedCount;
+
+		return invokedCount;
+	}
+
+	/** Removes all the subscriptions */
+	void clear() noexcept
+	{
+		_subscriptions.clear();
+		_subscriptionsByKey.clear();
+	}
+
+	std::size_t subscriptionsCount() const noexcept
+	{
+		return _subscriptions.size();
+	}
+
+	/** Total number of handlers invoked */
+	std::uint64_t invokedCount() const noexcept
+	{
+		return _invokedCount;
+	}
+
+	/** Total number of handlers a broadcast would have invoked, without the notification being for them */
+	std::uint64_t avoidedCount() const noexcept
+	{
+		return _avoidedCount;
+	}
+
+	// Deleted compiler auto-generated methods
+	SubscriptionRegistry(SubscriptionRegistry const&) = delete;
+	SubscriptionRegistry(SubscriptionRegistry&&) = delete;
+	SubscriptionRegistry& operator=(SubscriptionRegistry const&) = delete;
+	SubscriptionRegistry& operator=(SubscriptionRegistry&&) = delete;
+
+private:
+	struct Subscription
+	{
+		Key key{};
+		Handler handler{};
+	};
+
+	std::unordered_map<SubscriptionID, Subscription> _subscriptions{};
+	std::unordered_map<Key, std::vector<SubscriptionID>, KeyHash> _subscriptionsByKey{};
+	SubscriptionID _nextSubscriptionID{ 1u };
+	std::uint64_t _invokedCount{ 0u };
+	std::uint64_t _avoidedCount{ 0u };
+};
+
+} // namespace avdecc
@@ -0,0 +1,411 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "layeredLayout.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+// Number of down and up barycenter sweeps
+constexpr auto SweepsCount = 2;
+
+double normalizedRank(std::size_t const rank, std::size_t const layerSize) noexcept
+{
+	return (static_cast<double>(rank) + 0.5) / static_cast<double>(layerSize);
+}
+
+} // namespace
+
+void LayeredLayout::addNode(Node const node) noexcept
+{
+	if (_nodes.try_emplace(node).second)
+	{
+		_isDirty = true;
+	}
+}
+
+void LayeredLayout::removeNode(Node const node) noexcept
+{
+	auto const nodeIt = _nodes.find(node);
+	if (nodeIt == _nodes.end())
+	{
+		return;
+	}
+
+	auto const& info = nodeIt->second;
+	for (auto const& [predecessor, count] : info.predecessors)
+	{
+		auto& predecessorInfo = _nodes.at(predecessor);
+		predecessorInfo.successors.erase(node);
+		predecessorInfo.isDirty = true;
+		_edgesCount -= count;
+	}
+	for (auto const& [successor, count] : info.successors)
+	{
+		auto& successorInfo = _nodes.at(successor);
+		successorInfo.predecessors.erase(node);
+		successorInfo.isDirty = true;
+		_edgesCount -= count;
+	}
+
+	if (info.position)
+	{
+		auto const layerIndex = info.position->layer;
+		auto& layer = _layers[layerIndex];
+		layer.erase(std::find(layer.begin(), layer.end(), node));
+		_dirtyLayers[layerIndex] = true;
+	}
+
+	_nodes.erase(nodeIt);
+	_isDirty = true;
+}
+
+void LayeredLayout::addEdge(Node const from, Node const to) noexcept
+{
+	auto const fromIt = _nodes.find(from);
+	auto const toIt = _nodes.find(to);
+	if (from == to || fromIt == _nodes.end() || toIt == _nodes.end())
+	{
+		return;
+	}
+
+	++fromIt->second.successors[to];
+	++toIt->second.predecessors[from];
+	fromIt->second.isDirty = true;
+	toIt->second.isDirty = true;
+	++_edgesCount;
+	_isDirty = true;
+}
+
+void LayeredLayout::removeEdge(Node const from, Node const to) noexcept
+{
+	auto const fromIt = _nodes.find(from);
+	auto const toIt = _nodes.find(to);
+	if (fromIt == _nodes.end() || toIt == _nodes.end())
+	{
+		return;
+	}
+
+	auto& successors = fromIt->second.successors;
+	auto const successorIt = successors.find(to);
+	if (successorIt == successors.end())
+	{
+		return;
+	}
+	if (--successorIt->second == 0u)
+	{
+		successors.erase(successorIt);
+	}
+
+	auto& predecessors = toIt->second.predecessors;
+	auto const predecessorIt = predecessors.find(from);
+	if (--predecessorIt->second == 0u)
+	{
+		predecessors.erase(predecessorIt);
+	}
+
+	fromIt->second.isDirty = true;
+	toIt->second.isDirty = true;
+	--_edgesCount;
+	_isDirty = true;
+}
+
+std::vector<LayeredLayout::Node> LayeredLayout::update() noexcept
+{
+	if (!_isDirty)
+	{
+		return {};
+	}
+
+	computeLayers();
+
+	auto layersCount = std::size_t{ 0u };
+	for (auto const& [node, info] : _nodes)
+	{
+		layersCount = std::max(layersCount, info.layer + 1u);
+	}
+
+	// Nodes staying in the same layer keep their order
+	auto layers = std::vector<Layer>(layersCount);
+	auto dirtyLayers = std::vector<bool>(layersCount, false);
+	for (auto layerIndex = std::size_t{ 0u }; layerIndex < _layers.size(); ++layerIndex)
+	{
+		auto isDirty = static_cast<bool>(_dirtyLayers[layerIndex]);
+		for (auto const node : _layers[layerIndex])
+		{
+			auto const& info = _nodes.at(node);
+			if (info.layer == layerIndex)
+			{
+				layers[layerIndex].push_back(node);
+				isDirty |= info.isDirty;
+			}
+			else
+			{
+				// A node left this layer
+				isDirty = true;
+			}
+		}
+		if (isDirty && layerIndex < layersCount)
+		{
+			dirtyLayers[layerIndex] = true;
+		}
+	}
+
+	// Add new nodes, and nodes which layer changed, at the end of their layer (sorted to get a deterministic layout)
+	auto movedNodes = std::vector<Node>{};
+	for (auto const& [node, info] : _nodes)
+	{
+		if (!info.position || info.position->layer != info.layer)
+		{
+			movedNodes.push_back(node);
+		}
+	}
+	std::sort(movedNodes.begin(), movedNodes.end());
+	for (auto const node : movedNodes)
+	{
+		auto const layerIndex = _nodes.at(node).layer;
+		layers[layerIndex].push_back(node);
+		dirtyLayers[layerIndex] = true;
+	}
+
+	_layers = std::move(layers);
+	_dirtyLayers = std::move(dirtyLayers);
+
+	for (auto const& layer : _layers)
+	{
+		for (auto rank = std::size_t{ 0u }; rank < layer.size(); ++rank)
+		{
+			_nodes.at(layer[rank]).rank = rank;
+		}
+	}
+
+	// Crossing reduction, only reordering the changed layers
+	for (auto sweep = 0; sweep < SweepsCount; ++sweep)
+	{
+		for (auto layerIndex = std::size_t{ 1u }; layerIndex < _layers.size(); ++layerIndex)
+		{
+			if (_dirtyLayers[layerIndex])
+			{
+				sortLayer(layerIndex, true);
+			}
+		}
+		for (auto layerIndex = _layers.size(); layerIndex > 0u; --layerIndex)
+		{
+			if (_dirtyLayers[layerIndex - 1u])
+			{
+				sortLayer(layerIndex - 1u, false);
+			}
+		}
+	}
+
+	// Publish the new positions
+	auto changedNodes = std::vector<Node>{};
+	for (auto& [node, info] : _nodes)
+	{
+		auto const position = Position{ info.layer, info.rank };
+		if (!info.position || *info.position != position)
+		{
+			info.position = position;
+			changedNodes.push_back(node);
+		}
+		info.isDirty = false;
+	}
+	std::fill(_dirtyLayers.begin(), _dirtyLayers.end(), false);
+	_isDirty = false;
+
+	return changedNodes;
+}
+
+std::size_t LayeredLayout::nodesCount() const noexcept
+{
+	return _nodes.size();
+}
+
+std::size_t LayeredLayout::edgesCount() const noexcept
+{
+	return _edgesCount;
+}
+
+bool LayeredLayout::isConnected(Node const node) const noexcept
+{
+	auto const nodeIt = _nodes.find(node);
+	return nodeIt != _nodes.end() && (!nodeIt->second.predecessors.empty() || !nodeIt->second.successors.empty());
+}
+
+std::optional<LayeredLayout::Position> LayeredLayout::position(Node const node) const noexcept
+{
+	auto const nodeIt = _nodes.find(node);
+	if (nodeIt == _nodes.end())
+	{
+		return {};
+	}
+	return nodeIt->second.position;
+}
+
+std::vector<LayeredLayout::Layer> const& LayeredLayout::layers() const noexcept
+{
+	return _layers;
+}
+
+std::size_t LayeredLayout::crossingsCount() const noexcept
+{
+	auto crossings = std::size_t{ 0u };
+
+	for (auto layerIndex = std::size_t{ 0u }; layerIndex + 1u < _layers.size(); ++layerIndex)
+	{
+		// Edges to the next layer, sorted by source then destination rank
+		auto edges = std::vector<std::pair<std::size_t, std::size_t>>{};
+		auto const& nextLayer = _layers[layerIndex + 1u];
+		for (auto const node : _layers[layerIndex])
+		{
+			auto const& info = _nodes.at(node);
+			for (auto const& [successor, count] : info.successors)
+			{
+				auto const& successorPosition = _nodes.at(successor).position;
+				if (successorPosition && successorPosition->layer == layerIndex + 1u)
+				{
+					edges.insert(edges.end(), count, std::make_pair(info.position->rank, successorPosition->rank));
+				}
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+
+		// Two edges cross if their destination ranks are inverted, count inversions with a Fenwick tree
+		auto tree = std::vector<std::size_t>(nextLayer.size() + 1u, 0u);
+		auto inserted = std::size_t{ 0u };
+		for (auto const& edge : edges)
+		{
+			// Number of already inserted edges with a destination rank lower or equal
+			auto lowerOrEqual = std::size_t{ 0u };
+			for (auto index = edge.second + 1u; index > 0u; index -= index & (~index + 1u))
+			{
+				lowerOrEqual += tree[index];
+			}
+			crossings += inserted - lowerOrEqual;
+
+			for (auto index = edge.second + 1u; index < tree.size(); index += index & (~index + 1u))
+			{
+				++tree[index];
+			}
+			++inserted;
+		}
+	}
+
+	return crossings;
+}
+
+void LayeredLayout::computeLayers() noexcept
+{
+	// Longest path layering in topological order (Kahn's algorithm)
+	auto ready = std::vector<Node>{};
+	for (auto& [node, info] : _nodes)
+	{
+		info.layer = 0u;
+		info.pendingPredecessors = info.predecessors.size();
+		if (info.pendingPredecessors == 0u)
+		{
+			ready.push_back(node);
+		}
+	}
+
+	while (!ready.empty())
+	{
+		auto const node = ready.back();
+		ready.pop_back();
+
+		auto const& info = _nodes.at(node);
+		for (auto const& [successor, count] : info.successors)
+		{
+			auto& successorInfo = _nodes.at(successor);
+			successorInfo.layer = std::max(successorInfo.layer, info.layer + 1u);
+			if (--successorInfo.pendingPredecessors == 0u)
+			{
+				ready.push_back(successor);
+			}
+		}
+	}
+
+	// Nodes part of a cycle were never ready
+	for (auto& [node, info] : _nodes)
+	{
+		if (info.pendingPredecessors != 0u)
+		{
+			info.layer = 0u;
+		}
+	}
+}
+
+void LayeredLayout::sortLayer(std::size_t const layerIndex, bool const usePredecessors) noexcept
+{
+	auto& layer = _layers[layerIndex];
+
+	// Barycenter of the (normalized) ranks of the neighbors in the adjacent layer, or in the previous (or next) layers if none, or the current rank if none
+	auto const adjacentLayerIndex = usePredecessors ? layerIndex - 1u : layerIndex + 1u;
+	auto barycenters = std::vector<std::pair<double, Node>>{};
+	barycenters.reserve(layer.size());
+	for (auto rank = std::size_t{ 0u }; rank < layer.size(); ++rank)
+	{
+		auto const node = layer[rank];
+		auto const& info = _nodes.at(node);
+		auto adjacentSum = 0.0;
+		auto adjacentCount = std::size_t{ 0u };
+		auto sum = 0.0;
+		auto count = std::size_t{ 0u };
+		for (auto const& [neighbor, edgesCount] : usePredecessors ? info.predecessors : info.successors)
+		{
+			auto const& neighborInfo = _nodes.at(neighbor);
+			auto const weightedRank = static_cast<double>(edgesCount) * normalizedRank(neighborInfo.rank, _layers[neighborInfo.layer].size());
+			if (neighborInfo.layer == adjacentLayerIndex)
+			{
+				adjacentSum += weightedRank;
+				adjacentCount += edgesCount;
+			}
+			else if (usePredecessors ? neighborInfo.layer < layerIndex : neighborInfo.layer > layerIndex)
+			{
+				sum += weightedRank;
+				count += edgesCount;
+			}
+		}
+		auto barycenter = normalizedRank(rank, layer.size());
+		if (adjacentCount != 0u)
+		{
+			barycenter = adjacentSum / static_cast<double>(adjacentCount);
+		}
+		else if (count != 0u)
+		{
+			barycenter = sum / static_cast<double>(count);
+		}
+		barycenters.emplace_back(barycenter, node);
+	}
+
+	std::stable_sort(barycenters.begin(), barycenters.end(),
+		[](auto const& lhs, auto const& rhs)
+		{
+			return lhs.first < rhs.first;
+		});
+
+	for (auto rank = std::size_t{ 0u }; rank < barycenters.size(); ++rank)
+	{
+		auto const node = barycenters[rank].second;
+		layer[rank] = node;
+		_nodes.at(node).rank = rank;
+	}
+}
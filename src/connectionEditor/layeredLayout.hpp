@@ -0,0 +1,110 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @Brief Incremental layered layout of a directed graph
+ * @Details Nodes are assigned to layers by their longest path from a root (a node without incoming edge), computed in topological order in O(V+E).
+ *          The order of the nodes in each layer is then computed using barycenter crossing reduction sweeps.
+ *          The layout is incremental: only the layers affected by the changes since the previous update are reordered,
+ *          the other ones keep their order, so unrelated nodes do not move.
+ *          Nodes part of a cycle (not expected, the graph should be a DAG) are put in the first layer.
+ */
+class LayeredLayout final
+{
+public:
+	using Node = std::uint64_t;
+	using Layer = std::vector<Node>;
+
+	struct Position
+	{
+		std::size_t layer{ 0u };
+		std::size_t rank{ 0u }; // Index of the node in its layer
+
+		bool operator==(Position const& other) const noexcept
+		{
+			return layer == other.layer && rank == other.rank;
+		}
+		bool operator!=(Position const& other) const noexcept
+		{
+			return !operator==(other);
+		}
+	};
+
+	LayeredLayout() noexcept = default;
+
+	/** Adds a node (ignored if it already exists) */
+	void addNode(Node const node) noexcept;
+	/** Removes a node and all its edges */
+	void removeNode(Node const node) noexcept;
+	/** Adds an edge between existing nodes, several edges can be added between the same nodes */
+	void addEdge(Node const from, Node const to) noexcept;
+	/** Removes one of the edges between the nodes */
+	void removeEdge(Node const from, Node const to) noexcept;
+
+	/** Updates the layout, returns the nodes which position changed (including the added ones) */
+	std::vector<Node> update() noexcept;
+
+	std::size_t nodesCount() const noexcept;
+	std::size_t edgesCount() const noexcept;
+	/** Returns true if the node has any edge */
+	bool isConnected(Node const node) const noexcept;
+	/** Returns the position of the node computed by the last update */
+	std::optional<Position> position(Node const node) const noexcept;
+	/** Returns the nodes of each layer, in order, as computed by the last update */
+	std::vector<Layer> const& layers() const noexcept;
+	/** Returns the number of crossings between edges connecting adjacent layers, as computed by the last update */
+	std::size_t crossingsCount() const noexcept;
+
+	// Deleted compiler auto-generated methods
+	LayeredLayout(LayeredLayout const&) = delete;
+	LayeredLayout(LayeredLayout&&) = delete;
+	LayeredLayout& operator=(LayeredLayout const&) = delete;
+	LayeredLayout& operator=(LayeredLayout&&) = delete;
+
+private:
+	using Neighbors = std::unordered_map<Node, std::size_t>; // Neighbor, edges count
+
+	struct NodeInfo
+	{
+		Neighbors predecessors{};
+		Neighbors successors{};
+		std::optional<Position> position{}; // Position computed by the last update
+		std::size_t layer{ 0u }; // Layer being computed
+		std::size_t rank{ 0u }; // Rank being computed
+		std::size_t pendingPredecessors{ 0u }; // Predecessors not layered yet, while computing the layers
+		bool isDirty{ true }; // Added, or one of its edges changed since the last update
+	};
+
+	void computeLayers() noexcept;
+	void sortLayer(std::size_t const layerIndex, bool const usePredecessors) noexcept;
+
+	std::unordered_map<Node, NodeInfo> _nodes{};
+	std::vector<Layer> _layers{};
+	std::vector<bool> _dirtyLayers{}; // Layers which nodes changed since the last update
+	std::size_t _edgesCount{ 0u };
+	bool _isDirty{ false };
+};
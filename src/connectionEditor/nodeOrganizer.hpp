@@ -19,9 +19,13 @@
 
 #pragma once
 
+#include "layeredLayout.hpp"
+
 #include <QObject>
+#include <QPointF>
 #include <QVariantAnimation>
 #include <QPropertyAnimation>
+#include <QTimer>
 
 #include <QtMate/flow/flowDefs.hpp>
 
@@ -32,21 +36,15 @@ public:
 	virtual ~NodeOrganizer() override;
 
 private:
-	void updateNodeData(qtMate::flow::FlowNodeUid const& uid);
 	void doLayout();
 	void animateTo(qtMate::flow::FlowNode* node, float x, float y);
 
 private:
 	qtMate::flow::FlowScene* _scene{};
 	QPropertyAnimation* _sceneRectAnimation{};
+	QTimer _layoutTimer{}; // Coalesces the changes of an event loop iteration into a single layout
+	LayeredLayout _layout{};
 
-	struct NodeData
-	{
-		qtMate::flow::FlowNode* node{};
-		int activeInputCount{};
-		int activeOutputCount{};
-	};
-
-	QHash<qtMate::flow::FlowNodeUid, NodeData> _nodeData{};
+	QHash<qtMate::flow::FlowNodeUid, QPointF> _targetPositions{};
 	QHash<qtMate::flow::FlowNodeUid, QVariantAnimation*> _animations{};
 };
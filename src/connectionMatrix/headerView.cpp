@@ -293,45 +293,7 @@ void HeaderView::handleSectionInserted(QModelIndex const& /*parent*/, int first,
 
 		if (AVDECC_ASSERT_WITH_RET(node, "Node should not be null"))
 		{
-			auto expanded = true;
-			auto visible = true;
-
-			switch (node->type())
-			{
-				case Node::Type::Entity:
-					// Currently don't collapse in Channel mode (Because summary is not supported)
-					if (model->mode() == Model::Mode::Channel)
-					{
-						expanded = true;
-					}
-					else
-					{
-						expanded = !_collapsedByDefault;
-					}
-					break;
-				case Node::Type::RedundantOutput:
-				case Node::Type::RedundantInput:
-					visible = !_collapsedByDefault;
-					expanded = false;
-					break;
-				case Node::Type::RedundantOutputStream:
-				case Node::Type::RedundantInputStream:
-					visible = false;
-					break;
-				case Node::Type::OutputStream:
-				case Node::Type::InputStream:
-					visible = !_collapsedByDefault;
-					break;
-				case Node::Type::OutputChannel:
-				case Node::Type::InputChannel:
-					// Currently don't hide in Channel mode (Because summary is not supported)
-					visible = true;
-					break;
-				default:
-					break;
-			}
-
-			_sectionState[section] = { expanded, visible };
+			_sectionState[section] = defaultSectionState(node);
 			updateSectionVisibility(section);
 		}
 	}
@@ -350,9 +312,84 @@ void HeaderView::handleSectionRemoved(QModelIndex const& /*parent*/, int first,
 #endif
 }
 
+void HeaderView::handleModelAboutToBeReset()
+{
+	// The model is only reset with existing nodes when inserting entities in a batch, remember the state of these nodes
+	auto* model = static_cast<Model*>(this->model());
+	_sectionStateBeforeReset.clear();
+	for (auto section = 0; section < _sectionState.count(); ++section)
+	{
+		if (auto const* const node = model->node(section, orientation()))
+		{
+			_sectionStateBeforeReset[node] = _sectionState[section];
+		}
+	}
+}
+
 void HeaderView::handleModelReset()
 {
+	// Rebuild the state of all sections, keeping the state of the nodes already there before the reset
+	auto* model = static_cast<Model*>(this->model());
+	auto const sectionsCount = orientation() == Qt::Vertical ? model->rowCount() : model->columnCount();
 	_sectionState.clear();
+	_sectionState.resize(sectionsCount);
+	for (auto section = 0; section < sectionsCount; ++section)
+	{
+		if (auto const* const node = model->node(section, orientation()))
+		{
+			auto const it = _sectionStateBeforeReset.find(node);
+			_sectionState[section] = it != _sectionStateBeforeReset.end() ? it->second : defaultSectionState(node);
+			updateSectionVisibility(section);
+		}
+	}
+	_sectionStateBeforeReset.clear();
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+	qDebug() << "handleModelReset" << _sectionState.count();
+#endif
+}
+
+HeaderView::SectionState HeaderView::defaultSectionState(Node const* const node) const
+{
+	auto* model = static_cast<Model*>(this->model());
+	auto state = SectionState{};
+
+	switch (node->type())
+	{
+		case Node::Type::Entity:
+			// Currently don't collapse in Channel mode (Because summary is not supported)
+			if (model->mode() == Model::Mode::Channel)
+			{
+				state.expanded = true;
+			}
+			else
+			{
+				state.expanded = !_collapsedByDefault;
+			}
+			break;
+		case Node::Type::RedundantOutput:
+		case Node::Type::RedundantInput:
+			state.visible = !_collapsedByDefault;
+			state.expanded = false;
+			break;
+		case Node::Type::RedundantOutputStream:
+		case Node::Type::RedundantInputStream:
+			state.visible = false;
+			break;
+		case Node::Type::OutputStream:
+		case Node::Type::InputStream:
+			state.visible = !_collapsedByDefault;
+			break;
+		case Node::Type::OutputChannel:
+		case Node::Type::InputChannel:
+			// Currently don't hide in Channel mode (Because summary is not supported)
+			state.visible = true;
+			break;
+		default:
+			break;
+	}
+
+	return state;
 }
 
 void HeaderView::updateSectionVisibility(int const logicalIndex)
@@ -434,6 +471,7 @@ void HeaderView::setModel(QAbstractItemModel* model)
 			connect(model, &QAbstractItemModel::columnsRemoved, this, &HeaderView::handleSectionRemoved);
 		}
 
+		connect(model, &QAbstractItemModel::modelAboutToBeReset, this, &HeaderView::handleModelAboutToBeReset);
 		connect(model, &QAbstractItemModel::modelReset, this, &HeaderView::handleModelReset);
 	}
 }
@@ -27,8 +27,12 @@
 #include <QVector>
 #include <QRegularExpression>
 
+#include <unordered_map>
+
 namespace connectionMatrix
 {
+class Node;
+
 class HeaderView final : public QHeaderView
 {
 public:
@@ -77,7 +81,9 @@ private:
 	void handleSectionClicked(int logicalIndex);
 	void handleSectionInserted(QModelIndex const& parent, int first, int last);
 	void handleSectionRemoved(QModelIndex const& parent, int first, int last);
+	void handleModelAboutToBeReset();
 	void handleModelReset();
+	SectionState defaultSectionState(Node const* const node) const;
 	void handleEditMappingsClicked(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::DescriptorType const streamPortType, la::avdecc::entity::model::StreamIndex const streamIndex);
 	void updateSectionVisibility(int const logicalIndex);
 	void applyFilterPattern();
@@ -94,6 +100,7 @@ private:
 private:
 	bool const _isListenersHeader{ false };
 	QVector<SectionState> _sectionState;
+	std::unordered_map<Node const*, SectionState> _sectionStateBeforeReset{}; // State of the nodes while the model is reset (entities being inserted in a batch)
 	QRegularExpression _pattern;
 
 	bool _alwaysShowArrowTip{ false };
@@ -0,0 +1,272 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace connectionMatrix
+{
+/**
+ * @Brief Compact 2D storage for the intersections of the connection matrix
+ * @Details Cells are small trivially copyable values stored in a single flat array (row major), addressed through row and column indirection tables.
+ *          Inserting or removing rows/columns only updates the (small) indirection tables and recycles physical slots, existing cells are never moved (except when the physical capacity grows).
+ *          Data only a few cells need (ExtraData) is stored in a side table, keyed by physical position.
+ */
+template<typename Cell, typename ExtraData>
+class IntersectionMatrix final
+{
+	static_assert(std::is_trivially_copyable_v<Cell>, "Cell must be trivially copyable");
+
+public:
+	IntersectionMatrix() noexcept = default;
+
+	int rowCount() const noexcept
+	{
+		return static_cast<int>(_rowSlots.size());
+	}
+
+	int columnCount() const noexcept
+	{
+		return static_cast<int>(_columnSlots.size());
+	}
+
+	Cell const& cell(int const row, int const column) const noexcept
+	{
+		return _cells[cellPosition(_rowSlots[row], _columnSlots[column])];
+	}
+
+	Cell& cell(int const row, int const column) noexcept
+	{
+		return _cells[cellPosition(_rowSlots[row], _columnSlots[column])];
+	}
+
+	/** Returns the ExtraData for the specified cell, or nullptr if it has none */
+	ExtraData const* extraData(int const row, int const column) const noexcept
+	{
+		auto const it = _extraData.find(extraDataKey(_rowSlots[row], _columnSlots[column]));
+		if (it == std::end(_extraData))
+		{
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	/** Returns the ExtraData for the specified cell, creating it if it has none */
+	ExtraData& createExtraData(int const row, int const column) noexcept
+	{
+		return _extraData[extraDataKey(_rowSlots[row], _columnSlots[column])];
+	}
+
+	void removeExtraData(int const row, int const column) noexcept
+	{
+		_extraData.erase(extraDataKey(_rowSlots[row], _columnSlots[column]));
+	}
+
+	/** Inserts count default initialized rows before row first */
+	void insertRows(int const first, int const count) noexcept
+	{
+		auto slots = std::vector<std::uint32_t>{};
+		slots.reserve(count);
+		for (auto i = 0; i < count; ++i)
+		{
+			slots.push_back(allocateRowSlot());
+		}
+		_rowSlots.insert(std::next(std::begin(_rowSlots), first), std::begin(slots), std::end(slots));
+	}
+
+	/** Inserts count default initialized columns before column first */
+	void insertColumns(int const first, int const count) noexcept
+	{
+		auto slots = std::vector<std::uint32_t>{};
+		slots.reserve(count);
+		for (auto i = 0; i < count; ++i)
+		{
+			slots.push_back(allocateColumnSlot());
+		}
+		_columnSlots.insert(std::next(std::begin(_columnSlots), first), std::begin(slots), std::end(slots));
+	}
+
+	/** Removes count rows, starting at row first */
+	void removeRows(int const first, int const count) noexcept
+	{
+		auto const begin = std::next(std::begin(_rowSlots), first);
+		auto const end = std::next(begin, count);
+		releaseSlots(begin, end, _freeRowSlots, true);
+		_rowSlots.erase(begin, end);
+	}
+
+	/** Removes count columns, starting at column first */
+	void removeColumns(int const first, int const count) noexcept
+	{
+		auto const begin = std::next(std::begin(_columnSlots), first);
+		auto const end = std::next(begin, count);
+		releaseSlots(begin, end, _freeColumnSlots, false);
+		_columnSlots.erase(begin, end);
+	}
+
+	void clear() noexcept
+	{
+		_cells = {};
+		_rowCapacity = 0u;
+		_columnCapacity = 0u;
+		_rowSlots = {};
+		_columnSlots = {};
+		_freeRowSlots = {};
+		_freeColumnSlots = {};
+		_extraData = {};
+	}
+
+	/** Returns the number of cells having an ExtraData */
+	std::size_t extraDataCount() const noexcept
+	{
+		return _extraData.size();
+	}
+
+	/** Returns an estimation of the memory used by the matrix, not including the dynamic memory owned by ExtraData values */
+	std::size_t memoryUsage() const noexcept
+	{
+		// Rough estimation of an unordered_map node (value, next pointer and cached hash)
+		constexpr auto ExtraDataNodeSize = sizeof(typename ExtraDataMap::value_type) + 2 * sizeof(void*);
+
+		return _cells.capacity() * sizeof(Cell) + (_rowSlots.capacity() + _columnSlots.capacity() + _freeRowSlots.capacity() + _freeColumnSlots.capacity()) * sizeof(std::uint32_t) + _extraData.bucket_count() * sizeof(void*) + _extraData.size() * ExtraDataNodeSize;
+	}
+
+	// Deleted compiler auto-generated methods
+	IntersectionMatrix(IntersectionMatrix const&) = delete;
+	IntersectionMatrix(IntersectionMatrix&&) = delete;
+	IntersectionMatrix& operator=(IntersectionMatrix const&) = delete;
+	IntersectionMatrix& operator=(IntersectionMatrix&&) = delete;
+
+private:
+	using ExtraDataMap = std::unordered_map<std::uint64_t, ExtraData>;
+
+	std::size_t cellPosition(std::uint32_t const rowSlot, std::uint32_t const columnSlot) const noexcept
+	{
+		return static_cast<std::size_t>(rowSlot) * _columnCapacity + columnSlot;
+	}
+
+	static std::uint64_t extraDataKey(std::uint32_t const rowSlot, std::uint32_t const columnSlot) noexcept
+	{
+		return (static_cast<std::uint64_t>(rowSlot) << 32) | columnSlot;
+	}
+
+	std::uint32_t allocateRowSlot() noexcept
+	{
+		auto slot = std::uint32_t{ 0u };
+		if (!_freeRowSlots.empty())
+		{
+			slot = _freeRowSlots.back();
+			_freeRowSlots.pop_back();
+		}
+		else
+		{
+			slot = _rowCapacity++;
+			// Rows are contiguous, growing only appends at the end of the array
+			_cells.resize(static_cast<std::size_t>(_rowCapacity) * _columnCapacity);
+		}
+
+		// Reset the recycled row
+		auto const begin = std::next(std::begin(_cells), cellPosition(slot, 0u));
+		std::fill(begin, std::next(begin, _columnCapacity), Cell{});
+
+		return slot;
+	}
+
+	std::uint32_t allocateColumnSlot() noexcept
+	{
+		auto slot = std::uint32_t{ 0u };
+		if (!_freeColumnSlots.empty())
+		{
+			slot = _freeColumnSlots.back();
+			_freeColumnSlots.pop_back();
+		}
+		else
+		{
+			slot = _columnCapacity;
+			growColumnCapacity(_columnCapacity + 1u);
+			// All slots between the requested one and the new capacity are available
+			for (auto freeSlot = _columnCapacity - 1u; freeSlot > slot; --freeSlot)
+			{
+				_freeColumnSlots.push_back(freeSlot);
+			}
+		}
+
+		// Reset the recycled column
+		for (auto rowSlot = std::uint32_t{ 0u }; rowSlot < _rowCapacity; ++rowSlot)
+		{
+			_cells[cellPosition(rowSlot, slot)] = Cell{};
+		}
+
+		return slot;
+	}
+
+	void growColumnCapacity(std::uint32_t const minimumCapacity) noexcept
+	{
+		// Changing the row stride requires to move all cells, so grow geometrically
+		auto const newCapacity = std::max({ minimumCapacity, _columnCapacity * 2u, std::uint32_t{ 8u } });
+		auto cells = std::vector<Cell>(static_cast<std::size_t>(_rowCapacity) * newCapacity);
+		for (auto rowSlot = std::uint32_t{ 0u }; rowSlot < _rowCapacity; ++rowSlot)
+		{
+			auto const source = std::next(std::begin(_cells), cellPosition(rowSlot, 0u));
+			std::copy(source, std::next(source, _columnCapacity), std::next(std::begin(cells), static_cast<std::size_t>(rowSlot) * newCapacity));
+		}
+		_cells = std::move(cells);
+		_columnCapacity = newCapacity;
+	}
+
+	template<typename Iterator>
+	void releaseSlots(Iterator const begin, Iterator const end, std::vector<std::uint32_t>& freeSlots, bool const isRow) noexcept
+	{
+		freeSlots.insert(std::end(freeSlots), begin, end);
+
+		// Remove ExtraData of released slots
+		if (!_extraData.empty())
+		{
+			for (auto it = std::begin(_extraData); it != std::end(_extraData);)
+			{
+				auto const slot = isRow ? static_cast<std::uint32_t>(it->first >> 32) : static_cast<std::uint32_t>(it->first & 0xFFFFFFFF);
+				if (std::find(begin, end, slot) != end)
+				{
+					it = _extraData.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+	}
+
+	std::vector<Cell> _cells{}; // Row major, _rowCapacity x _columnCapacity
+	std::uint32_t _rowCapacity{ 0u };
+	std::uint32_t _columnCapacity{ 0u };
+	std::vector<std::uint32_t> _rowSlots{}; // Physical row slot for each row
+	std::vector<std::uint32_t> _columnSlots{}; // Physical column slot for each column
+	std::vector<std::uint32_t> _freeRowSlots{};
+	std::vector<std::uint32_t> _freeColumnSlots{};
+	ExtraDataMap _extraData{};
+};
+
+} // namespace connectionMatrix
@@ -23,6 +23,8 @@
 #include "connectionMatrix/paintHelper.hpp"
 #include <QtMate/material/color.hpp>
 #include <QPainter>
+#include <QGuiApplication>
+#include <QStyleHints>
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 #	include <unordered_map>
@@ -34,16 +36,24 @@ ItemDelegate::ItemDelegate(bool const drawMediaLockedDot, QObject* parent)
 	: QStyledItemDelegate{ parent }
 	, _drawMediaLockedDot{ drawMediaLockedDot }
 {
+	// Glyphs depend on the color scheme
+	connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, this,
+		[this]()
+		{
+			clearGlyphCache();
+		});
 }
 
 void ItemDelegate::setDrawMediaLockedDot(bool const drawMediaLockedDot) noexcept
 {
 	_drawMediaLockedDot = drawMediaLockedDot;
+	clearGlyphCache();
 }
 
 void ItemDelegate::setDrawCRFAudioConnections(bool const drawCRFAudioConnections) noexcept
 {
 	_drawCRFAudioConnections = drawCRFAudioConnections;
+	clearGlyphCache();
 }
 
 bool ItemDelegate::getDrawCRFAudioConnections() const noexcept
@@ -54,6 +64,12 @@ bool ItemDelegate::getDrawCRFAudioConnections() const noexcept
 void ItemDelegate::setDrawEntitySummary(bool const drawSummary) noexcept
 {
 	_drawEntitySummary = drawSummary;
+	clearGlyphCache();
+}
+
+void ItemDelegate::clearGlyphCache() noexcept
+{
+	_glyphAtlas.clear();
 }
 
 void ItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
@@ -84,7 +100,7 @@ void ItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option,
 
 	auto const& intersectionData = static_cast<Model const*>(index.model())->intersectionData(index);
 
-	paintHelper::drawCapabilities(painter, option.rect, intersectionData.type, intersectionData.state, intersectionData.flags, _drawMediaLockedDot, _drawCRFAudioConnections, _drawEntitySummary);
+	_glyphAtlas.draw(painter, option.rect, intersectionData.type, intersectionData.state, intersectionData.flags, _drawMediaLockedDot, _drawCRFAudioConnections, _drawEntitySummary);
 }
 
 } // namespace connectionMatrix
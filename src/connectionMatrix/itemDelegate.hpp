@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "connectionMatrix/paintHelper.hpp"
+
 #include <QStyledItemDelegate>
 
 namespace connectionMatrix
@@ -31,10 +33,13 @@ public:
 	void setDrawCRFAudioConnections(bool const drawCRFAudioConnections) noexcept;
 	bool getDrawCRFAudioConnections() const noexcept;
 	void setDrawEntitySummary(bool const drawSummary) noexcept;
+	void clearGlyphCache() noexcept;
 
 private:
 	virtual void paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const override;
 
+	mutable paintHelper::CapabilitiesGlyphAtlas _glyphAtlas{};
+
 	bool _drawMediaLockedDot{ false };
 	bool _drawCRFAudioConnections{ false };
 	bool _drawEntitySummary{ false };
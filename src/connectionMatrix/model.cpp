@@ -19,6 +19,8 @@
 
 #include "connectionMatrix/model.hpp"
 #include "connectionMatrix/node.hpp"
+#include "connectionMatrix/intersectionMatrix.hpp"
+#include "connectionMatrix/sectionIndex.hpp"
 #include "avdecc/channelConnectionManager.hpp"
 #include "avdecc/helper.hpp"
 #include "avdecc/hiveLogItems.hpp"
@@ -28,6 +30,7 @@
 
 #include <QDebug>
 
+#include <cstdint>
 #include <deque>
 #include <vector>
 
@@ -48,9 +51,6 @@ using Nodes = std::deque<Node*>;
 // Entity node by entity ID
 using NodeMap = std::unordered_map<la::avdecc::UniqueIdentifier, std::unique_ptr<EntityNode>, la::avdecc::UniqueIdentifier::hash>;
 
-// Entity section by entity ID
-using EntitySectionMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
-
 // Unique stream identifier
 using StreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
 
@@ -83,8 +83,31 @@ static auto const InvalidChannelKey = ChannelKey{};
 // ChannelNode by ChannelKey
 using ChannelNodeMap = std::unordered_map<ChannelKey, ChannelNode*, ChannelKeyHash>;
 
-// Section by Node
-using NodeSectionMap = std::unordered_map<Node const*, int>;
+// Section by Node (and by entityID), sorted by entityID
+using NodeSectionIndex = SectionIndex<la::avdecc::UniqueIdentifier, Node const*, la::avdecc::UniqueIdentifier::hash>;
+
+// Compact part of an IntersectionData (talker and listener are deduced from the sections)
+struct IntersectionCell
+{
+	std::uint8_t type{ static_cast<std::uint8_t>(Model::IntersectionData::Type::None) };
+	std::uint8_t state{ static_cast<std::uint8_t>(Model::IntersectionData::State::NotConnected) };
+	std::uint16_t flags{ 0u };
+	std::uint8_t dirtyFlags{ 0u }; // IntersectionDirtyFlags not computed yet
+	bool initialized{ false }; // Type (and everything else) not computed yet
+};
+static_assert(sizeof(IntersectionCell) <= 6, "IntersectionCell should stay compact");
+
+// Part of an IntersectionData only a few intersections have
+struct IntersectionExtraData
+{
+	std::vector<Model::IntersectionData::SmartConnectableStream> smartConnectableStreams{};
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+	QVariantAnimation* animation{ nullptr };
+#endif
+};
+
+// Talker major intersection data matrix
+using IntersectionDataMatrix = IntersectionMatrix<IntersectionCell, IntersectionExtraData>;
 
 #if ENABLE_CONNECTION_MATRIX_TOOLTIP
 
@@ -389,59 +412,31 @@ void removeNodes(Nodes& list, int first, int last)
 }
 
 // Returns the index where entity should be inserted to keep a sorted list by entityID
-int sortedIndexForEntity(Nodes const& list, la::avdecc::UniqueIdentifier const& entityID)
+int sortedIndexForEntity(NodeSectionIndex const& sectionIndex, la::avdecc::UniqueIdentifier const& entityID)
 {
-	auto index = 0;
-	for (auto const* node : list)
-	{
-		if (node->entityID() > entityID)
-		{
-			break;
-		}
-		++index;
-	}
-	return index;
+	return sectionIndex.insertionSection(entityID);
 }
 
-// Build and returns a NodeSectionMap and a EntitySectionMap from nodes (quick access maps)
-std::pair<NodeSectionMap, EntitySectionMap> buildNodeSectionMaps(Nodes const& nodes)
+// Return the index of a node contained in a NodeSectionIndex
+int indexOf(NodeSectionIndex const& sectionIndex, Node const* const node)
 {
-	NodeSectionMap nodeSectionMap;
-	EntitySectionMap entitySectionMap;
-
-	for (auto section = 0u; section < nodes.size(); ++section)
-	{
-		auto* node = nodes[section];
-		if (node->type() == Node::Type::Entity)
-		{
-			entitySectionMap.insert(std::make_pair(node->entityID(), section));
-		}
-		nodeSectionMap.insert(std::make_pair(node, section));
-	}
-
-	return std::make_pair(nodeSectionMap, entitySectionMap);
-}
-
-// Return the index of a node contained in a NodeSectionMap
-int indexOf(NodeSectionMap const& map, Node const* const node)
-{
-	auto const it = map.find(node);
-	if (!AVDECC_ASSERT_WITH_RET(it != std::end(map), "Index not found"))
+	auto const section = sectionIndex.section(node);
+	if (!AVDECC_ASSERT_WITH_RET(section != -1, "Index not found"))
 	{
 		return -1;
 	}
-	return it->second;
+	return section;
 }
 
-// Return the index of an EntityNode contained in a EntitySectionMap
-int indexOf(EntitySectionMap const& map, la::avdecc::UniqueIdentifier const entityID)
+// Return the index of an EntityNode contained in a NodeSectionIndex
+int indexOf(NodeSectionIndex const& sectionIndex, la::avdecc::UniqueIdentifier const entityID)
 {
-	auto const it = map.find(entityID);
-	if (it == std::end(map))
+	auto const section = sectionIndex.section(entityID);
+	if (section == -1 || sectionIndex.item(section)->type() != Node::Type::Entity)
 	{
 		return -1;
 	}
-	return it->second;
+	return section;
 }
 
 // Returns cluster channel name.
@@ -469,6 +464,7 @@ public:
 		// Common signals
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &ModelPrivate::handleControllerOffline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &ModelPrivate::handleEntityOnline);
+		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this, &ModelPrivate::handleEntitiesOnline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &ModelPrivate::handleEntityOffline);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::unsolicitedRegistrationChanged, this, &ModelPrivate::handleUnsolicitedRegistrationChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::compatibilityChanged, this, &ModelPrivate::handleCompatibilityChanged);
@@ -479,8 +475,7 @@ public:
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamRunningChanged, this, &ModelPrivate::handleStreamRunningChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamInputConnectionChanged, this, &ModelPrivate::handleStreamInputConnectionChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamDynamicInfoChanged, this, &ModelPrivate::handleStreamDynamicInfoChanged);
-		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamInputCountersChanged, this, &ModelPrivate::handleStreamInputCountersChanged);
-		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamOutputCountersChanged, this, &ModelPrivate::handleStreamOutputCountersChanged);
+		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::coalescedNotificationsFlushed, this, &ModelPrivate::handleCoalescedNotificationsFlushed);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamPortAudioMappingsChanged, this, &ModelPrivate::handleStreamPortAudioMappingsChanged);
 		connect(&controllerManager, &hive::modelsLibrary::ControllerManager::streamInputLatencyErrorChanged, this, &ModelPrivate::handleStreamInputLatencyErrorChanged);
 
@@ -540,11 +535,94 @@ public:
 		return section >= 0 && section < listenerSectionCount();
 	}
 
+	// Returns the up-to-date IntersectionData for talkerSection and listenerSection, computing it if required
+	// Intersections are computed lazily, only when requested (usually when painted), so adding an entity or receiving a notification only marks them as dirty
+	// This only updates the _intersectionData cache (see its declaration), hence the const qualifier
+	Model::IntersectionData intersectionDataAt(int const talkerSection, int const listenerSection) const
+	{
+		auto& cell = _intersectionData.cell(talkerSection, listenerSection);
+		if (cell.initialized && cell.dirtyFlags == 0u)
+		{
+			return buildIntersectionData(talkerSection, listenerSection);
+		}
+
+		// Clear pending state before computing, computation may require other intersections (children of a summary) to be computed as well
+		auto dirtyFlags = IntersectionDirtyFlags{};
+		dirtyFlags.assign(cell.dirtyFlags);
+		auto const initialized = cell.initialized;
+		cell.dirtyFlags = 0u;
+		cell.initialized = true;
+
+		auto intersectionData = buildIntersectionData(talkerSection, listenerSection);
+		if (!initialized)
+		{
+			initializeIntersectionData(intersectionData.talker, intersectionData.listener, intersectionData);
+		}
+		else
+		{
+			computeIntersectionData(intersectionData, dirtyFlags);
+		}
+		storeIntersectionData(talkerSection, listenerSection, intersectionData);
+
+		return intersectionData;
+	}
+
+	// Builds the IntersectionData for talkerSection and listenerSection from the compact storage, as is
+	Model::IntersectionData buildIntersectionData(int const talkerSection, int const listenerSection) const
+	{
+		auto intersectionData = Model::IntersectionData{};
+
+		auto const& cell = _intersectionData.cell(talkerSection, listenerSection);
+		intersectionData.talker = _talkerNodes[talkerSection];
+		intersectionData.listener = _listenerNodes[listenerSection];
+		intersectionData.type = static_cast<Model::IntersectionData::Type>(cell.type);
+		intersectionData.state = static_cast<Model::IntersectionData::State>(cell.state);
+		intersectionData.flags.assign(cell.flags);
+
+		if (auto const* const extraData = _intersectionData.extraData(talkerSection, listenerSection))
+		{
+			intersectionData.smartConnectableStreams = extraData->smartConnectableStreams;
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+			intersectionData.animation = extraData->animation;
+#endif
+		}
+
+		return intersectionData;
+	}
+
+	// Stores the computed IntersectionData for talkerSection and listenerSection into the compact storage
+	void storeIntersectionData(int const talkerSection, int const listenerSection, Model::IntersectionData const& intersectionData) const
+	{
+		auto& cell = _intersectionData.cell(talkerSection, listenerSection);
+		cell.type = static_cast<std::uint8_t>(intersectionData.type);
+		cell.state = static_cast<std::uint8_t>(intersectionData.state);
+		cell.flags = static_cast<std::uint16_t>(intersectionData.flags.value());
+
+		// Only a few intersections have smart connectable streams, keep them in the side table
+		if (!intersectionData.smartConnectableStreams.empty())
+		{
+			_intersectionData.createExtraData(talkerSection, listenerSection).smartConnectableStreams = intersectionData.smartConnectableStreams;
+		}
+		else if (auto const* const extraData = _intersectionData.extraData(talkerSection, listenerSection))
+		{
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+			if (extraData->animation)
+			{
+				_intersectionData.createExtraData(talkerSection, listenerSection).smartConnectableStreams.clear();
+			}
+			else
+#endif
+			{
+				_intersectionData.removeExtraData(talkerSection, listenerSection);
+			}
+		}
+	}
+
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 	void dump() const
 	{
-		auto const rows = _intersectionData.size();
-		auto const columns = rows > 0 ? _intersectionData[0].size() : 0u;
+		auto const rows = _intersectionData.rowCount();
+		auto const columns = _intersectionData.columnCount();
 
 		qDebug() << "talkers" << _talkerNodes.size();
 		qDebug() << "listeners" << _listenerNodes.size();
@@ -560,7 +638,7 @@ public:
 			return;
 		}
 
-		auto& intersectionData = _intersectionData[talkerSection][listenerSection];
+		auto& intersectionData = _intersectionData.createExtraData(talkerSection, listenerSection);
 
 		if (!intersectionData.animation)
 		{
@@ -588,6 +666,12 @@ public:
 	{
 		Q_Q(Model);
 
+		// Already notified by a model reset
+		if (_batchInsertion)
+		{
+			return;
+		}
+
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		qDebug() << "beginInsertTalkerItems(" << first << "," << last << ")";
 #endif
@@ -606,6 +690,11 @@ public:
 	{
 		Q_Q(Model);
 
+		if (_batchInsertion)
+		{
+			return;
+		}
+
 		if (!_transposed)
 		{
 			emit q->endInsertRows();
@@ -652,6 +741,12 @@ public:
 	{
 		Q_Q(Model);
 
+		// Already notified by a model reset
+		if (_batchInsertion)
+		{
+			return;
+		}
+
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		qDebug() << "beginInsertListenerItems(" << first << "," << last << ")";
 #endif
@@ -670,6 +765,11 @@ public:
 	{
 		Q_Q(Model);
 
+		if (_batchInsertion)
+		{
+			return;
+		}
+
 		if (!_transposed)
 		{
 			emit q->endInsertColumns();
@@ -882,7 +982,7 @@ public:
 	}
 
 	// Initializes intersection data
-	void initializeIntersectionData(Node* talker, Node* listener, Model::IntersectionData& intersectionData)
+	void initializeIntersectionData(Node* talker, Node* listener, Model::IntersectionData& intersectionData) const
 	{
 		AVDECC_ASSERT(talker, "Invalid talker");
 		AVDECC_ASSERT(listener, "Invalid listener");
@@ -1017,7 +1117,7 @@ public:
 	}
 
 	// Updates intersection data for the given dirtyFlags
-	void computeIntersectionData(Model::IntersectionData& intersectionData, IntersectionDirtyFlags const dirtyFlags)
+	void computeIntersectionData(Model::IntersectionData& intersectionData, IntersectionDirtyFlags const dirtyFlags) const
 	{
 		// Helper lambdas
 		auto const setSummaryIntersectionDataFlags = [](auto const dontSetInterfaceDownAndDomain, auto const& nodeIntersectionData, auto& intersectionDataFlags)
@@ -1251,8 +1351,8 @@ public:
 						}
 					};
 
-					auto const entityTalkerSection = priv::indexOf(_talkerNodeSectionMap, intersectionData.talker);
-					auto const entityListenerSection = priv::indexOf(_listenerNodeSectionMap, intersectionData.listener);
+					auto const entityTalkerSection = priv::indexOf(_talkerSectionIndex, intersectionData.talker);
+					auto const entityListenerSection = priv::indexOf(_listenerSectionIndex, intersectionData.listener);
 					if (!AVDECC_ASSERT_WITH_RET(isValidTalkerSection(entityTalkerSection), "Invalid talker section") || !AVDECC_ASSERT_WITH_RET(isValidListenerSection(entityListenerSection), "Invalid listener section"))
 					{
 						break;
@@ -1286,8 +1386,8 @@ public:
 						}
 
 						// Get the IntersectionData source node we'll get the data from
-						auto const talkerSection = priv::indexOf(_talkerNodeSectionMap, talker);
-						auto const& nodeIntersectionData = _intersectionData[talkerSection][entityListenerSection];
+						auto const talkerSection = priv::indexOf(_talkerSectionIndex, talker);
+						auto const nodeIntersectionData = intersectionDataAt(talkerSection, entityListenerSection);
 
 						processIntersection(nodeIntersectionData, atLeastOneConnectedTalker, atLeastOnePartiallyConnectedTalker, allLockedTalker);
 					}
@@ -1320,8 +1420,8 @@ public:
 						}
 
 						// Get the IntersectionData source node we'll get the data from
-						auto const listenerSection = priv::indexOf(_listenerNodeSectionMap, listener);
-						auto const& nodeIntersectionData = _intersectionData[entityTalkerSection][listenerSection];
+						auto const listenerSection = priv::indexOf(_listenerSectionIndex, listener);
+						auto const nodeIntersectionData = intersectionDataAt(entityTalkerSection, listenerSection);
 
 						processIntersection(nodeIntersectionData, atLeastOneConnectedListener, atLeastOnePartiallyConnectedListener, allLockedListener);
 					}
@@ -1371,13 +1471,13 @@ public:
 					{
 						nodeToTraverse = intersectionData.listener;
 						singleNode = intersectionData.talker;
-						singleNodeSection = priv::indexOf(_talkerNodeSectionMap, singleNode);
+						singleNodeSection = priv::indexOf(_talkerSectionIndex, singleNode);
 					}
 					else if (listenerType == Node::Type::Entity)
 					{
 						nodeToTraverse = intersectionData.talker;
 						singleNode = intersectionData.listener;
-						singleNodeSection = priv::indexOf(_listenerNodeSectionMap, singleNode);
+						singleNodeSection = priv::indexOf(_listenerSectionIndex, singleNode);
 					}
 					else
 					{
@@ -1411,11 +1511,11 @@ public:
 						if (talkerType == Node::Type::Entity)
 						{
 							talkerSection = singleNodeSection;
-							listenerSection = priv::indexOf(_listenerNodeSectionMap, node);
+							listenerSection = priv::indexOf(_listenerSectionIndex, node);
 						}
 						else if (listenerType == Node::Type::Entity)
 						{
-							talkerSection = priv::indexOf(_talkerNodeSectionMap, node);
+							talkerSection = priv::indexOf(_talkerSectionIndex, node);
 							listenerSection = singleNodeSection;
 						}
 
@@ -1425,7 +1525,7 @@ public:
 						}
 
 						// Get the IntersectionData source node we'll get the data from
-						auto const& nodeIntersectionData = _intersectionData[talkerSection][listenerSection];
+						auto const nodeIntersectionData = intersectionDataAt(talkerSection, listenerSection);
 
 						AVDECC_ASSERT(nodeIntersectionData.state != Model::IntersectionData::State::PartiallyConnected, "Should not be partially connected");
 						auto const isConnected = nodeIntersectionData.state == Model::IntersectionData::State::Connected;
@@ -1512,13 +1612,13 @@ public:
 					{
 						nodeToTraverse = intersectionData.talker;
 						singleNode = intersectionData.listener;
-						singleNodeSection = priv::indexOf(_listenerNodeSectionMap, singleNode);
+						singleNodeSection = priv::indexOf(_listenerSectionIndex, singleNode);
 					}
 					else if (listenerType == Node::Type::Entity)
 					{
 						nodeToTraverse = intersectionData.listener;
 						singleNode = intersectionData.talker;
-						singleNodeSection = priv::indexOf(_talkerNodeSectionMap, singleNode);
+						singleNodeSection = priv::indexOf(_talkerSectionIndex, singleNode);
 					}
 					else
 					{
@@ -1545,13 +1645,13 @@ public:
 						auto listenerSection = -1;
 						if (talkerType == Node::Type::Entity)
 						{
-							talkerSection = priv::indexOf(_talkerNodeSectionMap, node);
+							talkerSection = priv::indexOf(_talkerSectionIndex, node);
 							listenerSection = singleNodeSection;
 						}
 						else if (listenerType == Node::Type::Entity)
 						{
 							talkerSection = singleNodeSection;
-							listenerSection = priv::indexOf(_listenerNodeSectionMap, node);
+							listenerSection = priv::indexOf(_listenerSectionIndex, node);
 						}
 
 						if (!AVDECC_ASSERT_WITH_RET(isValidTalkerSection(talkerSection), "Invalid talker section") || !AVDECC_ASSERT_WITH_RET(isValidListenerSection(listenerSection), "Invalid listener section"))
@@ -1560,7 +1660,7 @@ public:
 						}
 
 						// Get the IntersectionData source node we'll get the data from
-						auto const& nodeIntersectionData = _intersectionData[talkerSection][listenerSection];
+						auto const nodeIntersectionData = intersectionDataAt(talkerSection, listenerSection);
 
 						// Get connected state
 						auto const isConnected = nodeIntersectionData.state == Model::IntersectionData::State::Connected;
@@ -2028,8 +2128,8 @@ public:
 						auto const* const otherStreamNode = redundantNode->childAt(streamNode->index());
 
 						// Get the indexes for the Intersection Data we'll copy data from (Which is a RedundantStream_RedundantStream node)
-						talkerSection = priv::indexOf(_talkerNodeSectionMap, otherStreamNode);
-						listenerSection = priv::indexOf(_listenerNodeSectionMap, streamNode);
+						talkerSection = priv::indexOf(_talkerSectionIndex, otherStreamNode);
+						listenerSection = priv::indexOf(_listenerSectionIndex, streamNode);
 					}
 					else if (listenerType == Node::Type::RedundantInput)
 					{
@@ -2040,8 +2140,8 @@ public:
 						auto const* const otherStreamNode = redundantNode->childAt(streamNode->index());
 
 						// Get the indexes for the Intersection Data we'll copy data from (Which is a RedundantStream_RedundantStream node)
-						talkerSection = priv::indexOf(_talkerNodeSectionMap, streamNode);
-						listenerSection = priv::indexOf(_listenerNodeSectionMap, otherStreamNode);
+						talkerSection = priv::indexOf(_talkerSectionIndex, streamNode);
+						listenerSection = priv::indexOf(_listenerSectionIndex, otherStreamNode);
 					}
 					else
 					{
@@ -2054,7 +2154,7 @@ public:
 					}
 
 					// Get the IntersectionData source node we'll copy the data from
-					auto const& sourceIntersectionData = _intersectionData[talkerSection][listenerSection];
+					auto const sourceIntersectionData = intersectionDataAt(talkerSection, listenerSection);
 					AVDECC_ASSERT(sourceIntersectionData.type == Model::IntersectionData::Type::RedundantStream_RedundantStream, "Intersection should be RedundantStream_RedundantStream");
 
 					intersectionData.state = sourceIntersectionData.state;
@@ -2331,26 +2431,50 @@ public:
 
 	// Cache update helpers
 
-	void rebuildTalkerSectionCache()
+	// Inserts nodes (the flattened nodes of entityID) in the talker section cache, starting at section first
+	void insertTalkerSectionCache(la::avdecc::UniqueIdentifier const& entityID, priv::Nodes const& nodes, [[maybe_unused]] int const first)
 	{
 		Q_Q(Model);
 		emit q->indexesWillChange();
 
-		auto maps = priv::buildNodeSectionMaps(_talkerNodes);
-		_talkerNodeSectionMap = std::move(maps.first);
-		_talkerEntitySectionMap = std::move(maps.second);
+		[[maybe_unused]] auto const section = _talkerSectionIndex.insert(entityID, nodes);
+		AVDECC_ASSERT(section == first, "Section cache out of sync");
 
 		emit q->indexesHaveChanged();
 	}
 
-	void rebuildListenerSectionCache()
+	// Inserts nodes (the flattened nodes of entityID) in the listener section cache, starting at section first
+	void insertListenerSectionCache(la::avdecc::UniqueIdentifier const& entityID, priv::Nodes const& nodes, [[maybe_unused]] int const first)
 	{
 		Q_Q(Model);
 		emit q->indexesWillChange();
 
-		auto maps = priv::buildNodeSectionMaps(_listenerNodes);
-		_listenerNodeSectionMap = std::move(maps.first);
-		_listenerEntitySectionMap = std::move(maps.second);
+		[[maybe_unused]] auto const section = _listenerSectionIndex.insert(entityID, nodes);
+		AVDECC_ASSERT(section == first, "Section cache out of sync");
+
+		emit q->indexesHaveChanged();
+	}
+
+	// Removes the nodes of entityID from the talker section cache
+	void removeTalkerSectionCache(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		Q_Q(Model);
+		emit q->indexesWillChange();
+
+		[[maybe_unused]] auto const removed = _talkerSectionIndex.remove(entityID);
+		AVDECC_ASSERT(removed, "Section cache out of sync");
+
+		emit q->indexesHaveChanged();
+	}
+
+	// Removes the nodes of entityID from the listener section cache
+	void removeListenerSectionCache(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		Q_Q(Model);
+		emit q->indexesWillChange();
+
+		[[maybe_unused]] auto const removed = _listenerSectionIndex.remove(entityID);
+		AVDECC_ASSERT(removed, "Section cache out of sync");
 
 		emit q->indexesHaveChanged();
 	}
@@ -2738,18 +2862,17 @@ public:
 			}
 		}
 
-		auto const first = priv::sortedIndexForEntity(_talkerNodes, entityID);
+		auto const first = priv::sortedIndexForEntity(_talkerSectionIndex, entityID);
 		auto const last = first + childrenCount;
 
 		beginInsertTalkerItems(first, last);
 
 		priv::insertNodes(_talkerNodes, flattendedNodes, first);
 
-		rebuildTalkerSectionCache();
+		insertTalkerSectionCache(entityID, flattendedNodes, first);
 
-		// Insert new talker rows
-		auto const it = std::next(std::begin(_intersectionData), first);
-		_intersectionData.insert(it, childrenCount + 1, {});
+		// Insert new talker rows (intersections will be computed when first requested)
+		_intersectionData.insertRows(first, childrenCount + 1);
 
 		if constexpr (std::is_same_v<NodeType, EntityNode>)
 		{
@@ -2761,20 +2884,6 @@ public:
 			}
 		}
 
-		// Update intersection matrix (Start from the end so that children are initialized before parents)
-		for (auto talkerSection = last; talkerSection >= first; --talkerSection)
-		{
-			auto& row = _intersectionData[talkerSection];
-			row.resize(_listenerNodes.size());
-
-			auto* talker = _talkerNodes[talkerSection];
-			for (auto listenerSection = _listenerNodes.size(); listenerSection > 0u; --listenerSection)
-			{
-				auto* listener = _listenerNodes[listenerSection - 1];
-				initializeIntersectionData(talker, listener, row[listenerSection - 1]);
-			}
-		}
-
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
 #endif
@@ -2801,14 +2910,14 @@ public:
 		}
 
 		auto const childrenCount = static_cast<int>(nodesCount) - 1;
-		auto const first = priv::sortedIndexForEntity(_listenerNodes, entityID);
+		auto const first = priv::sortedIndexForEntity(_listenerSectionIndex, entityID);
 		auto const last = first + childrenCount;
 
 		beginInsertListenerItems(first, last);
 
 		priv::insertNodes(_listenerNodes, flattendedNodes, first);
 
-		rebuildListenerSectionCache();
+		insertListenerSectionCache(entityID, flattendedNodes, first);
 
 		// Compute everything for initial state (Start from the end so that children are initialized before parents)
 		for (auto listenerSection = last; listenerSection >= first; --listenerSection)
@@ -2817,22 +2926,8 @@ public:
 			computeHeaderData(listener, allHeaderDirtyFlagsListener());
 		}
 
-		// Update intersection matrix (Start from the end so that children are initialized before parents)
-		for (auto talkerSection = _talkerNodes.size(); talkerSection > 0u; --talkerSection)
-		{
-			auto& row = _intersectionData[talkerSection - 1];
-
-			// Insert new listener columns
-			auto const it = std::next(std::begin(row), first);
-			row.insert(it, childrenCount + 1, {});
-
-			auto* talker = _talkerNodes[talkerSection - 1];
-			for (auto listenerSection = last; listenerSection >= first; --listenerSection)
-			{
-				auto* listener = _listenerNodes[listenerSection];
-				initializeIntersectionData(talker, listener, row[listenerSection]);
-			}
-		}
+		// Insert new listener columns (intersections will be computed when first requested)
+		_intersectionData.insertColumns(first, childrenCount + 1);
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
@@ -2852,16 +2947,16 @@ public:
 			return;
 		}
 
-		auto const first = priv::indexOf(_talkerNodeSectionMap, node);
+		auto const first = priv::indexOf(_talkerSectionIndex, node);
 		auto const last = first + childrenCount;
 
 		beginRemoveTalkerItems(first, last);
 
 		priv::removeNodes(_talkerNodes, first, last + 1 /* entity */);
 
-		rebuildTalkerSectionCache();
+		removeTalkerSectionCache(node->entityID());
 
-		_intersectionData.erase(std::next(std::begin(_intersectionData), first), std::next(std::begin(_intersectionData), last + 1));
+		_intersectionData.removeRows(first, childrenCount + 1);
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
@@ -2881,21 +2976,16 @@ public:
 			return;
 		}
 
-		auto const first = priv::indexOf(_listenerNodeSectionMap, node);
+		auto const first = priv::indexOf(_listenerSectionIndex, node);
 		auto const last = first + childrenCount;
 
 		beginRemoveListenerItems(first, last);
 
 		priv::removeNodes(_listenerNodes, first, last + 1 /* entity */);
 
-		rebuildListenerSectionCache();
+		removeListenerSectionCache(node->entityID());
 
-		for (auto talkerSection = 0u; talkerSection < _talkerNodes.size(); ++talkerSection)
-		{
-			auto& row = _intersectionData[talkerSection];
-
-			row.erase(std::next(std::begin(row), first), std::next(std::begin(row), last + 1));
-		}
+		_intersectionData.removeColumns(first, childrenCount + 1);
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
@@ -2934,6 +3024,41 @@ public:
 	}
 
 	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID)
+	{
+		addEntity(entityID);
+
+		// Trigger "special offline streams" intersection update
+		if (_mode == Model::Mode::Stream)
+		{
+			talkerIntersectionDataChanged(_offlineOutputStreamNode.get(), false, true, allIntersectionDirtyFlags());
+		}
+	}
+
+	void handleEntitiesOnline(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+	{
+		Q_Q(Model);
+
+		// Insert all entities in a single model reset, instead of one rows/columns insertion per entity
+		emit q->beginResetModel();
+		_batchInsertion = true;
+
+		for (auto const entityID : entityIDs)
+		{
+			addEntity(entityID);
+		}
+
+		_batchInsertion = false;
+		emit q->endResetModel();
+
+		// Trigger "special offline streams" intersection update
+		if (_mode == Model::Mode::Stream)
+		{
+			talkerIntersectionDataChanged(_offlineOutputStreamNode.get(), false, true, allIntersectionDirtyFlags());
+		}
+	}
+
+	// Builds and inserts the talker and listener nodes of an entity
+	void addEntity(la::avdecc::UniqueIdentifier const entityID)
 	{
 		try
 		{
@@ -2980,12 +3105,6 @@ public:
 					}
 				}
 			}
-
-			// Trigger "special offline streams" intersection update
-			if (_mode == Model::Mode::Stream)
-			{
-				talkerIntersectionDataChanged(_offlineOutputStreamNode.get(), false, true, allIntersectionDirtyFlags());
-			}
 		}
 		catch (la::avdecc::controller::ControlledEntity::Exception const&)
 		{
@@ -3381,6 +3500,19 @@ public:
 		}
 	}
 
+	void handleCoalescedNotificationsFlushed(hive::modelsLibrary::ControllerManager::CoalescedNotifications const& notifications)
+	{
+		// Process all counters of the batch at once (only the latest value for each stream is present)
+		for (auto const& [entityID, streamIndex, counters] : notifications.streamInputCounters)
+		{
+			handleStreamInputCountersChanged(entityID, streamIndex, counters);
+		}
+		for (auto const& [entityID, streamIndex, counters] : notifications.streamOutputCounters)
+		{
+			handleStreamOutputCountersChanged(entityID, streamIndex, counters);
+		}
+	}
+
 	void handleStreamInputCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters)
 	{
 		// Event affecting a single stream node (Input)
@@ -3838,20 +3970,20 @@ private:
 	// Returns talker section for node
 	int talkerNodeSection(Node* const node) const
 	{
-		return priv::indexOf(_talkerNodeSectionMap, node);
+		return priv::indexOf(_talkerSectionIndex, node);
 	}
 
 	// Returns listener section for node
 	int listenerNodeSection(Node* const node) const
 	{
-		return priv::indexOf(_listenerNodeSectionMap, node);
+		return priv::indexOf(_listenerSectionIndex, node);
 	}
 
 	// Returns ModelIndex for given entityID
 	QModelIndex indexOf(la::avdecc::UniqueIdentifier const& entityID) const noexcept
 	{
-		auto const talkerSectionIndex = priv::indexOf(_talkerEntitySectionMap, entityID);
-		auto const listenerSectionIndex = priv::indexOf(_listenerEntitySectionMap, entityID);
+		auto const talkerSectionIndex = priv::indexOf(_talkerSectionIndex, entityID);
+		auto const listenerSectionIndex = priv::indexOf(_listenerSectionIndex, entityID);
 
 		return createIndex(talkerSectionIndex, listenerSectionIndex);
 	}
@@ -3966,14 +4098,13 @@ private:
 		}
 	}
 
-	// Recomputes (according to dirtyFlags) intersection data for talkerSection and listenerSection and notifies that it has changed
+	// Marks (according to dirtyFlags) intersection data for talkerSection and listenerSection as dirty and notifies that it has changed (it will be recomputed when requested)
 	void intersectionDataChanged(int const talkerSection, int const listenerSection, IntersectionDirtyFlags const dirtyFlags)
 	{
 		Q_Q(Model);
 
-		auto& data = _intersectionData[talkerSection][listenerSection];
-
-		computeIntersectionData(data, dirtyFlags);
+		auto& cell = _intersectionData.cell(talkerSection, listenerSection);
+		cell.dirtyFlags |= static_cast<std::uint8_t>(dirtyFlags.value());
 
 		auto const index = createIndex(talkerSection, listenerSection);
 		emit q->dataChanged(index, index);
@@ -4242,8 +4373,8 @@ private:
 
 		_talkerNodes.clear();
 		_listenerNodes.clear();
-		_talkerNodeSectionMap.clear();
-		_listenerNodeSectionMap.clear();
+		_talkerSectionIndex.clear();
+		_listenerSectionIndex.clear();
 		_intersectionData.clear();
 	}
 
@@ -4296,6 +4427,7 @@ private:
 
 	Model::Mode _mode{ Model::Mode::None };
 	bool _transposed{ false };
+	bool _batchInsertion{ false }; // Inserting a batch of entities within a model reset
 
 	// OfflineOutputStream special node
 	std::unique_ptr<OfflineOutputStreamNode> _offlineOutputStreamNode{ OfflineOutputStreamNode::create() };
@@ -4316,14 +4448,16 @@ private:
 	priv::Nodes _talkerNodes;
 	priv::Nodes _listenerNodes;
 
-	// Node section quick access map (cache)
-	priv::NodeSectionMap _talkerNodeSectionMap;
-	priv::EntitySectionMap _talkerEntitySectionMap;
-	priv::NodeSectionMap _listenerNodeSectionMap;
-	priv::EntitySectionMap _listenerEntitySectionMap;
+	// Node and entity section quick access index (cache)
+	priv::NodeSectionIndex _talkerSectionIndex;
+	priv::NodeSectionIndex _listenerSectionIndex;
 
 	// Talker major intersection data matrix (cache)
-	std::deque<std::deque<Model::IntersectionData>> _intersectionData;
+	// Mutable as cells are lazily computed from const accessors (Model::intersectionData, called when painting). Invariants:
+	//  - Rows and columns are only inserted/removed from non-const methods, in sync with _talkerNodes/_listenerNodes, so const accessors never change the shape of the matrix
+	//  - A cell that is initialized with no dirty flag always holds the same data as a fresh computation from the nodes
+	//  - Computing a cell only reads the nodes and the section indexes, and only writes the cell itself and the cells of its children (for summary intersections)
+	mutable priv::IntersectionDataMatrix _intersectionData;
 };
 
 Model::Model(QObject* parent)
@@ -4476,27 +4610,27 @@ int Model::section(Node* node, Qt::Orientation orientation) const
 	{
 		if (orientation == Qt::Vertical)
 		{
-			return priv::indexOf(d->_talkerNodeSectionMap, node);
+			return priv::indexOf(d->_talkerSectionIndex, node);
 		}
 		else
 		{
-			return priv::indexOf(d->_listenerNodeSectionMap, node);
+			return priv::indexOf(d->_listenerSectionIndex, node);
 		}
 	}
 	else
 	{
 		if (orientation == Qt::Vertical)
 		{
-			return priv::indexOf(d->_listenerNodeSectionMap, node);
+			return priv::indexOf(d->_listenerSectionIndex, node);
 		}
 		else
 		{
-			return priv::indexOf(d->_talkerNodeSectionMap, node);
+			return priv::indexOf(d->_talkerSectionIndex, node);
 		}
 	}
 }
 
-Model::IntersectionData const& Model::intersectionData(QModelIndex const& index) const
+Model::IntersectionData Model::intersectionData(QModelIndex const& index) const
 {
 	Q_D(const Model);
 
@@ -4505,11 +4639,11 @@ Model::IntersectionData const& Model::intersectionData(QModelIndex const& index)
 
 	if (!AVDECC_ASSERT_WITH_RET(d->isValidTalkerSection(talkerSection), "invalid talker section") || !AVDECC_ASSERT_WITH_RET(d->isValidListenerSection(listenerSection), "invalid listener section"))
 	{
-		static auto const s_dummyData = Model::IntersectionData{};
-		return s_dummyData;
+		return {};
 	}
 
-	return d->_intersectionData[talkerSection][listenerSection];
+	// Intersection data is computed lazily, the first time it's requested after a change
+	return d->intersectionDataAt(talkerSection, listenerSection);
 }
 
 void Model::setMode(Mode const mode)
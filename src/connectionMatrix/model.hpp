@@ -171,7 +171,7 @@ public:
 	int section(Node* node, Qt::Orientation orientation) const;
 
 	// Returns intersection data for the given index
-	IntersectionData const& intersectionData(QModelIndex const& index) const;
+	IntersectionData intersectionData(QModelIndex const& index) const;
 
 	// Set the model mode
 	void setMode(Mode const mode);
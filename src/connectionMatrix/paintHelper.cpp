@@ -20,6 +20,10 @@
 #include "connectionMatrix/paintHelper.hpp"
 #include <QtMate/material/color.hpp>
 
+#include <QtMath>
+
+#include <algorithm>
+
 namespace color = qtMate::material::color;
 
 namespace connectionMatrix
@@ -56,6 +60,13 @@ static inline void drawCenterDot(QPainter* painter, QRect const& rect, QColor co
 	painter->drawEllipse(insideRect);
 }
 
+static inline void drawInvalidIntersection(QPainter* painter, QRect const& rect)
+{
+	auto brush = qtMate::material::color::brush(qtMate::material::color::Name::Gray, qtMate::material::color::isDarkColorScheme() ? qtMate::material::color::Shade::Shade800 : qtMate::material::color::Shade::Shade300);
+	brush.setStyle(Qt::BrushStyle::BDiagPattern);
+	painter->fillRect(rect, brush);
+}
+
 static inline QColor getMediaLockedBrushColor() noexcept
 {
 	return color::value(color::Name::Gray, color::Shade::ShadeA700);
@@ -297,7 +308,8 @@ QPainterPath buildHeaderArrowPath(QRect const& rect, Qt::Orientation const orien
 	return path;
 }
 
-void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary)
+// Draws the glyph of the intersection, returns false (without drawing anything) if the intersection is invalid
+static bool drawCapabilitiesGlyph(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary)
 {
 	painter->setRenderHint(QPainter::Antialiasing);
 
@@ -308,12 +320,6 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 	auto penWidth = qreal{ 1.5 };
 	auto wrongFormatHasPriorityOverInterfaceDown = false;
 
-	auto const drawInvalidIntersection = [painter, &rect]()
-	{
-		auto brush = qtMate::material::color::brush(qtMate::material::color::Name::Gray, qtMate::material::color::isDarkColorScheme() ? qtMate::material::color::Shade::Shade800 : qtMate::material::color::Shade::Shade300);
-		brush.setStyle(Qt::BrushStyle::BDiagPattern);
-		painter->fillRect(rect, brush);
-	};
 	auto const drawEntitySummaryIntersection = [painter, &rect, state, flags, drawMediaLockedDot](auto const brush, auto const penColor, auto const penWidth)
 	{
 		painter->setBrush(brush);
@@ -372,8 +378,7 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 	// Do not draw incompatible format types if not connected
 	if (!drawCRFAudioConnections && flags.test(Model::IntersectionData::Flag::WrongFormatType) && state == Model::IntersectionData::State::NotConnected)
 	{
-		drawInvalidIntersection();
-		return;
+		return false;
 	}
 
 	switch (type)
@@ -391,7 +396,7 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 			}
 			else
 			{
-				drawInvalidIntersection();
+				return false;
 			}
 			break;
 		}
@@ -412,7 +417,7 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 			}
 			else
 			{
-				drawInvalidIntersection();
+				return false;
 			}
 			break;
 		}
@@ -463,7 +468,7 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 			// Nominal case, not connected (since it's forbidden by Milan)
 			if (state == Model::IntersectionData::State::NotConnected)
 			{
-				drawInvalidIntersection();
+				return false;
 			}
 			else
 			{
@@ -491,9 +496,119 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 		}
 		case Model::IntersectionData::Type::None:
 		default:
-			drawInvalidIntersection();
-			break;
+			return false;
+	}
+
+	return true;
+}
+
+void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary)
+{
+	if (!drawCapabilitiesGlyph(painter, rect, type, state, flags, drawMediaLockedDot, drawCRFAudioConnections, drawEntitySummary))
+	{
+		drawInvalidIntersection(painter, rect);
+	}
+}
+
+void CapabilitiesGlyphAtlas::draw(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary)
+{
+	if (rect.isEmpty())
+	{
+		drawCapabilities(painter, rect, type, state, flags, drawMediaLockedDot, drawCRFAudioConnections, drawEntitySummary);
+		return;
+	}
+
+	// All glyphs of the atlas share the same geometry, start over if it changed
+	auto const devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : qreal{ 1.0 };
+	if (rect.size() != _glyphSize || !qFuzzyCompare(devicePixelRatio, _devicePixelRatio))
+	{
+		clear();
+		_glyphSize = rect.size();
+		_devicePixelRatio = devicePixelRatio;
+		_glyphPixelSize = QSize{ qCeil(_glyphSize.width() * _devicePixelRatio), qCeil(_glyphSize.height() * _devicePixelRatio) };
+	}
+
+	auto const key = glyphKey(type, state, flags, drawMediaLockedDot, drawCRFAudioConnections, drawEntitySummary);
+	auto slot = InvalidSlot;
+	if (auto const it = _slots.find(key); it != std::end(_slots))
+	{
+		slot = it->second;
+	}
+	else
+	{
+		slot = renderGlyph(type, state, flags, drawMediaLockedDot, drawCRFAudioConnections, drawEntitySummary);
+		_slots.emplace(key, slot);
+	}
+
+	// The invalid intersection hatching must stay aligned with the neighbour intersections, always draw it directly
+	if (slot == InvalidSlot)
+	{
+		drawInvalidIntersection(painter, rect);
+		return;
 	}
+
+	painter->drawPixmap(QRectF{ rect }, _atlas, QRectF{ slotRect(slot) });
+}
+
+void CapabilitiesGlyphAtlas::clear() noexcept
+{
+	_slots.clear();
+	_usedSlots = 0;
+	_atlas = {};
+}
+
+int CapabilitiesGlyphAtlas::glyphCount() const noexcept
+{
+	return _usedSlots;
+}
+
+std::uint32_t CapabilitiesGlyphAtlas::glyphKey(Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary) noexcept
+{
+	static_assert(la::avdecc::utils::to_integral(Model::IntersectionData::Flag::NoTalkerSecondaryMappings) < (1 << 13), "Flags do not fit in the glyph key anymore");
+
+	return (static_cast<std::uint32_t>(type) & 0xFF) | ((static_cast<std::uint32_t>(state) & 0x07) << 8) | ((drawMediaLockedDot ? 1u : 0u) << 11) | ((drawCRFAudioConnections ? 1u : 0u) << 12) | ((drawEntitySummary ? 1u : 0u) << 13) | ((static_cast<std::uint32_t>(flags.value()) & 0x3FFF) << 14);
+}
+
+QRect CapabilitiesGlyphAtlas::slotRect(int const slot) const noexcept
+{
+	return QRect{ QPoint{ (slot % SlotsPerRow) * _glyphPixelSize.width(), (slot / SlotsPerRow) * _glyphPixelSize.height() }, _glyphPixelSize };
+}
+
+int CapabilitiesGlyphAtlas::renderGlyph(Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary)
+{
+	auto const slot = _usedSlots;
+
+	// Grow the atlas (by doubling its number of rows) if required
+	auto const rowsCount = _atlas.isNull() ? 0 : _atlas.height() / _glyphPixelSize.height();
+	if (slot >= rowsCount * SlotsPerRow)
+	{
+		auto atlas = QPixmap{ SlotsPerRow * _glyphPixelSize.width(), std::max(1, rowsCount * 2) * _glyphPixelSize.height() };
+		atlas.fill(Qt::transparent);
+		if (!_atlas.isNull())
+		{
+			auto painter = QPainter{ &atlas };
+			painter.setCompositionMode(QPainter::CompositionMode_Source);
+			painter.drawPixmap(0, 0, _atlas);
+		}
+		_atlas = std::move(atlas);
+	}
+
+	// Render the glyph in its slot, in device pixels
+	auto const slotPixelRect = slotRect(slot);
+	auto painter = QPainter{ &_atlas };
+	painter.setClipRect(slotPixelRect);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	painter.fillRect(slotPixelRect, Qt::transparent);
+	painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+	painter.translate(slotPixelRect.topLeft());
+	painter.scale(_devicePixelRatio, _devicePixelRatio);
+	if (!drawCapabilitiesGlyph(&painter, QRect{ QPoint{ 0, 0 }, _glyphSize }, type, state, flags, drawMediaLockedDot, drawCRFAudioConnections, drawEntitySummary))
+	{
+		return InvalidSlot;
+	}
+
+	++_usedSlots;
+	return slot;
 }
 
 } // namespace paintHelper
@@ -24,6 +24,10 @@
 #include <QRect>
 #include <QPainter>
 #include <QPainterPath>
+#include <QPixmap>
+
+#include <cstdint>
+#include <unordered_map>
 
 namespace connectionMatrix
 {
@@ -32,5 +36,38 @@ namespace paintHelper
 QPainterPath buildHeaderArrowPath(QRect const& rect, Qt::Orientation const orientation, bool const isTransposed, bool const alwaysShowArrowTip, bool const alwaysShowArrowEnd, int const arrowOffset, int const arrowSize, int const width);
 void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary);
 
+/** Atlas of pre-rendered drawCapabilities glyphs. All glyphs share the same size and device pixel ratio (the atlas is cleared if they change), it must also be cleared when the color scheme changes. */
+class CapabilitiesGlyphAtlas final
+{
+public:
+	CapabilitiesGlyphAtlas() noexcept = default;
+
+	/** Same result as drawCapabilities, but blits the glyph from the atlas (rendering it first if required) */
+	void draw(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary);
+	void clear() noexcept;
+	int glyphCount() const noexcept;
+
+	// Deleted compiler auto-generated methods
+	CapabilitiesGlyphAtlas(CapabilitiesGlyphAtlas const&) = delete;
+	CapabilitiesGlyphAtlas(CapabilitiesGlyphAtlas&&) = delete;
+	CapabilitiesGlyphAtlas& operator=(CapabilitiesGlyphAtlas const&) = delete;
+	CapabilitiesGlyphAtlas& operator=(CapabilitiesGlyphAtlas&&) = delete;
+
+private:
+	static constexpr auto SlotsPerRow = 16;
+	static constexpr auto InvalidSlot = -1;
+
+	static std::uint32_t glyphKey(Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary) noexcept;
+	QRect slotRect(int const slot) const noexcept;
+	int renderGlyph(Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags, bool const drawMediaLockedDot, bool const drawCRFAudioConnections, bool const drawEntitySummary);
+
+	QSize _glyphSize{};
+	QSize _glyphPixelSize{};
+	qreal _devicePixelRatio{ 1.0 };
+	QPixmap _atlas{};
+	int _usedSlots{ 0 };
+	std::unordered_map<std::uint32_t, int> _slots{}; // Slot by glyph key (InvalidSlot if the intersection has to be drawn as invalid)
+};
+
 } // namespace paintHelper
 } // namespace connectionMatrix
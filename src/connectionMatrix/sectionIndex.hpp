@@ -0,0 +1,323 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace connectionMatrix
+{
+/**
+ * @Brief Order maintenance structure for the sections of the connection matrix
+ * @Details Sections are made of blocks of items (the flattened nodes of an entity), ordered by Key (the entityID).
+ *          Blocks are stored in a rank tree (treap keyed by Key, augmented with the number of items of each subtree), so that:
+ *           - inserting or removing a block is O(log N) and only touches the items of that block
+ *           - the section of an item or a block, and the item at a section, are answered in O(log N)
+ *          Each Key must only be inserted once.
+ */
+template<typename Key, typename Item, typename KeyHash = std::hash<Key>, typename ItemHash = std::hash<Item>>
+class SectionIndex final
+{
+public:
+	SectionIndex() noexcept = default;
+
+	/** Returns the total number of items (sections) */
+	int size() const noexcept
+	{
+		return subtreeSize(_root);
+	}
+
+	/** Returns the number of blocks */
+	int blockCount() const noexcept
+	{
+		return static_cast<int>(_blocks.size());
+	}
+
+	/** Returns the section where a block with the specified key would be inserted (after all blocks with a lower or equal key) */
+	int insertionSection(Key const& key) const noexcept
+	{
+		auto section = 0;
+		auto const* block = _root;
+		while (block)
+		{
+			if (key < block->key)
+			{
+				block = block->left;
+			}
+			else
+			{
+				section += subtreeSize(block->left) + static_cast<int>(block->items.size());
+				block = block->right;
+			}
+		}
+		return section;
+	}
+
+	/** Inserts a block of items for the specified key, returns the section of its first item (or -1 if the key already exists) */
+	template<typename Items>
+	int insert(Key const& key, Items const& items) noexcept
+	{
+		if (_blocks.count(key) != 0)
+		{
+			return -1;
+		}
+
+		auto block = std::make_unique<Block>();
+		block->key = key;
+		block->items.assign(std::begin(items), std::end(items));
+		block->priority = _generator();
+		block->subtreeSize = static_cast<int>(block->items.size());
+
+		for (auto offset = 0u; offset < block->items.size(); ++offset)
+		{
+			_itemLocations[block->items[offset]] = ItemLocation{ block.get(), static_cast<int>(offset) };
+		}
+
+		// Split the tree around the new key, and merge everything back with the new block in the middle
+		auto* const newBlock = block.get();
+		auto [lower, upper] = split(_root, key);
+		_root = merge(merge(lower, newBlock), upper);
+		_root->parent = nullptr;
+
+		_blocks.emplace(key, std::move(block));
+
+		return blockSection(newBlock);
+	}
+
+	/** Removes the block for the specified key, returns false if the key was not found */
+	bool remove(Key const& key) noexcept
+	{
+		auto const it = _blocks.find(key);
+		if (it == std::end(_blocks))
+		{
+			return false;
+		}
+
+		auto* const block = it->second.get();
+		for (auto const& item : block->items)
+		{
+			_itemLocations.erase(item);
+		}
+
+		// Replace the block with the merge of its children, then update the sizes up to the root
+		auto* const parent = block->parent;
+		auto* const replacement = merge(block->left, block->right);
+		if (replacement)
+		{
+			replacement->parent = parent;
+		}
+		if (!parent)
+		{
+			_root = replacement;
+		}
+		else
+		{
+			if (parent->left == block)
+			{
+				parent->left = replacement;
+			}
+			else
+			{
+				parent->right = replacement;
+			}
+			for (auto* ancestor = parent; ancestor; ancestor = ancestor->parent)
+			{
+				updateSubtreeSize(ancestor);
+			}
+		}
+
+		_blocks.erase(it);
+		return true;
+	}
+
+	/** Returns the section of the specified item, or -1 if not found */
+	int section(Item const& item) const noexcept
+	{
+		auto const it = _itemLocations.find(item);
+		if (it == std::end(_itemLocations))
+		{
+			return -1;
+		}
+		return blockSection(it->second.block) + it->second.offset;
+	}
+
+	/** Returns the section of the first item of the block for the specified key, or -1 if not found */
+	int section(Key const& key) const noexcept
+	{
+		auto const it = _blocks.find(key);
+		if (it == std::end(_blocks) || it->second->items.empty())
+		{
+			return -1;
+		}
+		return blockSection(it->second.get());
+	}
+
+	/** Returns the item at the specified section, which must be valid */
+	Item const& item(int section) const noexcept
+	{
+		auto const* block = _root;
+		while (true)
+		{
+			auto const leftSize = subtreeSize(block->left);
+			if (section < leftSize)
+			{
+				block = block->left;
+				continue;
+			}
+			section -= leftSize;
+			auto const itemsCount = static_cast<int>(block->items.size());
+			if (section < itemsCount)
+			{
+				return block->items[section];
+			}
+			section -= itemsCount;
+			block = block->right;
+		}
+	}
+
+	void clear() noexcept
+	{
+		_root = nullptr;
+		_blocks.clear();
+		_itemLocations.clear();
+	}
+
+	// Deleted compiler auto-generated methods
+	SectionIndex(SectionIndex const&) = delete;
+	SectionIndex(SectionIndex&&) = delete;
+	SectionIndex& operator=(SectionIndex const&) = delete;
+	SectionIndex& operator=(SectionIndex&&) = delete;
+
+private:
+	struct Block
+	{
+		Key key{};
+		std::vector<Item> items{};
+		std::uint32_t priority{ 0u };
+		int subtreeSize{ 0 }; // Number of items in this block and all its descendants
+		Block* parent{ nullptr };
+		Block* left{ nullptr };
+		Block* right{ nullptr };
+	};
+	struct ItemLocation
+	{
+		Block* block{ nullptr };
+		int offset{ 0 };
+	};
+
+	static int subtreeSize(Block const* const block) noexcept
+	{
+		return block ? block->subtreeSize : 0;
+	}
+
+	static void updateSubtreeSize(Block* const block) noexcept
+	{
+		block->subtreeSize = subtreeSize(block->left) + static_cast<int>(block->items.size()) + subtreeSize(block->right);
+	}
+
+	static void setChildren(Block* const block, Block* const left, Block* const right) noexcept
+	{
+		block->left = left;
+		block->right = right;
+		if (left)
+		{
+			left->parent = block;
+		}
+		if (right)
+		{
+			right->parent = block;
+		}
+		updateSubtreeSize(block);
+	}
+
+	/** Splits the tree in 2 trees: blocks with a key lower or equal to the specified one, and blocks with a greater key */
+	static std::pair<Block*, Block*> split(Block* const block, Key const& key) noexcept
+	{
+		if (!block)
+		{
+			return { nullptr, nullptr };
+		}
+		if (key < block->key)
+		{
+			auto [lower, upper] = split(block->left, key);
+			setChildren(block, upper, block->right);
+			if (lower)
+			{
+				lower->parent = nullptr;
+			}
+			return { lower, block };
+		}
+		auto [lower, upper] = split(block->right, key);
+		setChildren(block, block->left, lower);
+		if (upper)
+		{
+			upper->parent = nullptr;
+		}
+		return { block, upper };
+	}
+
+	/** Merges 2 trees, all keys of the lower tree being lower than the keys of the upper tree */
+	static Block* merge(Block* const lower, Block* const upper) noexcept
+	{
+		if (!lower)
+		{
+			return upper;
+		}
+		if (!upper)
+		{
+			return lower;
+		}
+		if (lower->priority > upper->priority)
+		{
+			setChildren(lower, lower->left, merge(lower->right, upper));
+			return lower;
+		}
+		setChildren(upper, merge(lower, upper->left), upper->right);
+		return upper;
+	}
+
+	/** Returns the section of the first item of the block, walking up to the root */
+	static int blockSection(Block const* const block) noexcept
+	{
+		auto section = subtreeSize(block->left);
+		for (auto const* node = block; node->parent; node = node->parent)
+		{
+			auto const* const parent = node->parent;
+			if (parent->right == node)
+			{
+				section += subtreeSize(parent->left) + static_cast<int>(parent->items.size());
+			}
+		}
+		return section;
+	}
+
+	Block* _root{ nullptr };
+	std::unordered_map<Key, std::unique_ptr<Block>, KeyHash> _blocks{};
+	std::unordered_map<Item, ItemLocation, ItemHash> _itemLocations{};
+	std::minstd_rand _generator{};
+};
+
+} // namespace connectionMatrix
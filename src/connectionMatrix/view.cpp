@@ -36,6 +36,29 @@
 
 namespace connectionMatrix
 {
+namespace
+{
+/** Lists all channels of the current configuration of an entity, for the specified direction */
+std::vector<avdecc::ChannelIdentification> gatherChannels(hive::modelsLibrary::EntitySnapshot const& snapshot, avdecc::ChannelConnectionDirection const direction) noexcept
+{
+	auto channels = std::vector<avdecc::ChannelIdentification>{};
+	auto const& streamPorts = direction == avdecc::ChannelConnectionDirection::OutputToInput ? snapshot.streamPorts->outputs : snapshot.streamPorts->inputs;
+
+	for (auto const& [streamPortIndex, streamPort] : streamPorts)
+	{
+		for (auto const& [clusterIndex, channelCount] : streamPort.clusterChannelCounts)
+		{
+			for (auto channel = std::uint16_t{ 0u }; channel < channelCount; ++channel)
+			{
+				channels.emplace_back(snapshot.currentConfiguration, clusterIndex, channel, direction, streamPort.audioUnitIndex, streamPortIndex, streamPort.baseCluster);
+			}
+		}
+	}
+
+	return channels;
+}
+} // namespace
+
 View::View(QWidget* parent)
 	: QTableView{ parent }
 	, _model{ std::make_unique<Model>() }
@@ -285,61 +308,28 @@ void View::onIntersectionClicked(QModelIndex const& index)
 				// gather all connections to be made:
 				auto const talkerID = intersectionData.talker->entityID();
 				auto const listenerID = intersectionData.listener->entityID();
-				auto talkerControlledEntity = manager.getControlledEntity(talkerID); // TODO: all getControlledEntity calls should be removed the this method. Any model related information should be gathered and cached from notification thread
-				auto listenerControlledEntity = manager.getControlledEntity(listenerID);
-
-				auto const& talkerConfiguration = talkerControlledEntity->getCurrentConfigurationNode();
-				auto const& listenerConfiguration = listenerControlledEntity->getCurrentConfigurationNode();
-				std::vector<avdecc::ChannelIdentification> talkerChannels;
-				std::vector<avdecc::ChannelIdentification> listenerChannels;
-
-				for (auto const& talkerAudioUnitKV : talkerConfiguration.audioUnits)
+				auto const talkerSnapshot = manager.getEntitySnapshot(talkerID);
+				auto const listenerSnapshot = manager.getEntitySnapshot(listenerID);
+				if (!talkerSnapshot || !listenerSnapshot)
 				{
-					for (auto const& talkerStreamPortOutputKV : talkerAudioUnitKV.second.streamPortOutputs)
-					{
-						for (auto const& talkerAudioClusterKV : talkerStreamPortOutputKV.second.audioClusters)
-						{
-							for (uint16_t channel = 0; channel < talkerAudioClusterKV.second.staticModel.channelCount; channel++)
-							{
-								talkerChannels.emplace_back(avdecc::ChannelIdentification{ talkerConfiguration.descriptorIndex, talkerAudioClusterKV.first, channel, avdecc::ChannelConnectionDirection::OutputToInput, talkerAudioUnitKV.first, talkerStreamPortOutputKV.first, talkerStreamPortOutputKV.second.staticModel.baseCluster });
-							}
-						}
-					}
+					break;
 				}
 
-				for (auto const& listenerAudioUnitKV : listenerConfiguration.audioUnits)
-				{
-					for (auto const& listenerStreamPortOutputKV : listenerAudioUnitKV.second.streamPortInputs)
-					{
-						for (auto const& listenerAudioClusterKV : listenerStreamPortOutputKV.second.audioClusters)
-						{
-							for (uint16_t channel = 0; channel < listenerAudioClusterKV.second.staticModel.channelCount; channel++)
-							{
-								listenerChannels.emplace_back(avdecc::ChannelIdentification{ listenerConfiguration.descriptorIndex, listenerAudioClusterKV.first, channel, avdecc::ChannelConnectionDirection::InputToOutput, listenerAudioUnitKV.first, listenerStreamPortOutputKV.first, listenerStreamPortOutputKV.second.staticModel.baseCluster });
-							}
-						}
-					}
-				}
+				auto const talkerChannels = gatherChannels(*talkerSnapshot, avdecc::ChannelConnectionDirection::OutputToInput);
+				auto const listenerChannels = gatherChannels(*listenerSnapshot, avdecc::ChannelConnectionDirection::InputToOutput);
 
 				auto talkerChannelIt = talkerChannels.begin();
 				auto listenerChannelIt = listenerChannels.begin();
-				std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> connectionsToCreate;
+				std::vector<avdecc::ChannelRoute> routes;
 
 				while (talkerChannelIt != talkerChannels.end() && listenerChannelIt != listenerChannels.end())
 				{
-					connectionsToCreate.push_back(std::make_pair(*talkerChannelIt, *listenerChannelIt));
+					routes.push_back(avdecc::ChannelRoute{ talkerID, *talkerChannelIt, listenerID, *listenerChannelIt });
 					talkerChannelIt++;
 					listenerChannelIt++;
 				}
 
-				auto error = channelConnectionManager.createChannelConnections(talkerID, listenerID, connectionsToCreate, false, true);
-				std::function<void(bool, bool)> elevatedRightsCallback = [&](bool allowTalkerMappingChanges, bool allowListenerMappingRemoval)
-				{
-					auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-					auto errorSecondTry = channelConnectionManager.createChannelConnections(talkerID, listenerID, connectionsToCreate, allowTalkerMappingChanges, allowListenerMappingRemoval);
-					handleChannelCreationResult(errorSecondTry, allowTalkerMappingChanges, allowListenerMappingRemoval, elevatedRightsCallback);
-				};
-				handleChannelCreationResult(error, false, true, elevatedRightsCallback);
+				planAndExecuteChannelRoutes(routes);
 			}
 			else
 			{
@@ -382,44 +372,24 @@ void View::onIntersectionClicked(QModelIndex const& index)
 
 				auto const talkerID = intersectionData.talker->entityID();
 				auto const listenerID = intersectionData.listener->entityID();
-				auto talkerControlledEntity = manager.getControlledEntity(talkerID);
-				auto listenerControlledEntity = manager.getControlledEntity(listenerID);
-
-				auto const& talkerConfiguration = talkerControlledEntity->getCurrentConfigurationNode();
-				auto const& listenerConfiguration = listenerControlledEntity->getCurrentConfigurationNode();
-				std::vector<avdecc::ChannelIdentification> listenerChannels;
-
-				for (auto const& listenerAudioUnitKV : listenerConfiguration.audioUnits)
+				auto const listenerSnapshot = manager.getEntitySnapshot(listenerID);
+				if (!listenerSnapshot)
 				{
-					for (auto const& listenerStreamPortOutputKV : listenerAudioUnitKV.second.streamPortInputs)
-					{
-						for (auto const& listenerAudioClusterKV : listenerStreamPortOutputKV.second.audioClusters)
-						{
-							for (uint16_t channel = 0; channel < listenerAudioClusterKV.second.staticModel.channelCount; channel++)
-							{
-								listenerChannels.emplace_back(avdecc::ChannelIdentification{ listenerConfiguration.descriptorIndex, listenerAudioClusterKV.first, channel, avdecc::ChannelConnectionDirection::InputToOutput, listenerAudioUnitKV.first, listenerStreamPortOutputKV.first, listenerStreamPortOutputKV.second.staticModel.baseCluster });
-							}
-						}
-					}
+					break;
 				}
 
+				auto const listenerChannels = gatherChannels(*listenerSnapshot, avdecc::ChannelConnectionDirection::InputToOutput);
+
 				auto listenerChannelIt = listenerChannels.begin();
-				std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> connectionsToCreate;
+				std::vector<avdecc::ChannelRoute> routes;
 
 				while (listenerChannelIt != listenerChannels.end())
 				{
-					connectionsToCreate.push_back(std::make_pair(talkerChannelIdentification, *listenerChannelIt));
+					routes.push_back(avdecc::ChannelRoute{ talkerID, talkerChannelIdentification, listenerID, *listenerChannelIt });
 					listenerChannelIt++;
 				}
 
-				auto error = channelConnectionManager.createChannelConnections(talkerID, listenerID, connectionsToCreate, false, true);
-				std::function<void(bool, bool)> elevatedRightsCallback = [&](bool allowTalkerMappingChanges, bool allowListenerMappingRemoval)
-				{
-					auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-					auto errorSecondTry = channelConnectionManager.createChannelConnections(talkerID, listenerID, connectionsToCreate, allowTalkerMappingChanges, allowListenerMappingRemoval);
-					handleChannelCreationResult(errorSecondTry, allowTalkerMappingChanges, allowListenerMappingRemoval, elevatedRightsCallback);
-				};
-				handleChannelCreationResult(error, false, true, elevatedRightsCallback);
+				planAndExecuteChannelRoutes(routes);
 			}
 			break;
 		}
@@ -579,6 +549,57 @@ void View::forceFilter()
 	applyFilterPattern(QRegularExpression{ _cornerWidget->filterText() });
 }
 
+void View::planAndExecuteChannelRoutes(std::vector<avdecc::ChannelRoute> const& routes)
+{
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+
+	// Plan all the routes at once (dry-run), and let the user review the plan before any command is sent
+	auto const plan = channelConnectionManager.planChannelRoutes(routes);
+	auto const routesCount = routes.size() - plan.alreadyRoutedCount - plan.impossibleRoutes.size();
+	if (plan.isEmpty())
+	{
+		if (plan.impossibleRoutes.empty())
+		{
+			QMessageBox::information(this, "", "All the channels are already connected.");
+		}
+		else
+		{
+			QMessageBox::information(this, "", "The connections couldn't be created because all compatible streams are already occupied.");
+		}
+		return;
+	}
+
+	auto mappingsCount = std::size_t{ 0u };
+	for (auto const& change : plan.mappingsToAdd)
+	{
+		mappingsCount += change.mappings.size();
+	}
+	for (auto const& change : plan.mappingsToRemove)
+	{
+		mappingsCount += change.mappings.size();
+	}
+
+	auto text = QString("%1 channel(s) will be connected").arg(routesCount);
+	if (plan.alreadyRoutedCount != 0u || !plan.impossibleRoutes.empty())
+	{
+		text += QString(" (%1 already connected, %2 impossible because all compatible streams are occupied)").arg(plan.alreadyRoutedCount).arg(plan.impossibleRoutes.size());
+	}
+	text += QString(".\n\n%1 command(s) will be sent to %2 device(s):\n").arg(plan.commandsCount()).arg(plan.entities().size());
+	text += QString("- %1 stream connection(s)\n").arg(plan.streamsToConnect.size());
+	text += QString("- %1 stream format change(s)\n").arg(plan.streamFormatChanges.size());
+	text += QString("- %1 audio mapping(s) changed in %2 command(s)\n").arg(mappingsCount).arg(plan.mappingsToAdd.size() + plan.mappingsToRemove.size());
+	if (!plan.streamsToReconnect.empty())
+	{
+		text += QString("\n%1 stream connection(s) will be temporarily disconnected, which might lead to audio interruptions!\n").arg(plan.streamsToReconnect.size());
+	}
+	text += "\nContinue?";
+
+	if (QMessageBox::question(this, "Connect Channels", text) == QMessageBox::StandardButton::Yes)
+	{
+		channelConnectionManager.executeChannelRoutingPlan(plan);
+	}
+}
+
 void View::mouseMoveEvent(QMouseEvent* event)
 {
 	auto const index = indexAt(event->pos());
@@ -669,6 +690,7 @@ void View::onSettingChanged(settings::SettingsManager::Setting const& name, QVar
 		_cornerWidget->setColor(colorName);
 		_verticalHeaderView->setColor(colorName);
 		_horizontalHeaderView->setColor(colorName);
+		_itemDelegate->clearGlyphCache();
 
 		// Manually force a model refresh of the headers
 		_model->forceRefreshHeaders();
@@ -689,12 +711,9 @@ void View::handleCreateChannelConnectionsFinished(avdecc::CreateConnectionsInfo
 			continue; // entity already displayed.
 		}
 		auto entityName = hive::modelsLibrary::helper::toHexQString(it->first.getValue()); // by default show the id if the entity is offline
+		if (auto const snapshot = hive::modelsLibrary::ControllerManager::getInstance().getEntitySnapshot(it->first))
 		{
-			auto const controlledEntity = hive::modelsLibrary::ControllerManager::getInstance().getControlledEntity(it->first);
-			if (controlledEntity)
-			{
-				entityName = hive::modelsLibrary::helper::smartEntityName(*controlledEntity);
-			}
+			entityName = hive::modelsLibrary::helper::smartEntityName(*snapshot);
 		}
 		auto errorsForEntity = info.connectionCreationErrors.equal_range(it->first);
 		QString errors;
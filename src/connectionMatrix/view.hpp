@@ -61,6 +61,7 @@ private:
 	void onFilterChanged(QString const& filter);
 	void applyFilterPattern(QRegularExpression const& pattern);
 	void forceFilter();
+	void planAndExecuteChannelRoutes(std::vector<avdecc::ChannelRoute> const& routes);
 
 	// QTableView overrides
 	virtual void mouseMoveEvent(QMouseEvent* event) override;
@@ -0,0 +1,777 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "controlledEntityTreeModel.hpp"
+#include "avdecc/helper.hpp"
+#include "entityInspectorRoles.hpp"
+
+#include <hive/modelsLibrary/helper.hpp>
+#include <hive/modelsLibrary/controllerManager.hpp>
+#include <hive/widgetModelsLibrary/qtUserRoles.hpp>
+
+#include <algorithm>
+#include <type_traits>
+
+void ControlledEntityTreeModel::load(la::avdecc::UniqueIdentifier const entityID, bool const displayFullModel) noexcept
+{
+	beginResetModel();
+
+	_root.children.clear();
+	_identifierToNode.clear();
+	_redundantStreamNodes.clear();
+	_errorBits.clear();
+	_entityID = entityID;
+	_loadedOnlineGeneration = _onlineGeneration;
+	_displayFullModel = displayFullModel;
+
+	if (entityID)
+	{
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		if (auto controlledEntity = manager.getControlledEntity(entityID))
+		{
+			addEntityNode(*controlledEntity);
+		}
+	}
+
+	endResetModel();
+}
+
+void ControlledEntityTreeModel::notifyEntityOnlineChanged(la::avdecc::UniqueIdentifier const entityID) noexcept
+{
+	if (entityID == _entityID)
+	{
+		++_onlineGeneration;
+	}
+}
+
+QModelIndex ControlledEntityTreeModel::indexOf(NodeIdentifier const& identifier) const noexcept
+{
+	if (auto* const node = findNode(identifier))
+	{
+		return indexOf(*node);
+	}
+	return {};
+}
+
+ControlledEntityTreeModel::NodeIdentifier ControlledEntityTreeModel::getIdentifier(QModelIndex const& index) const noexcept
+{
+	if (!index.isValid())
+	{
+		return {};
+	}
+	return nodeFromIndex(index).identifier;
+}
+
+ControlledEntityTreeModel::NodePath ControlledEntityTreeModel::getPath(QModelIndex const& index) const noexcept
+{
+	auto path = NodePath{};
+	if (index.isValid())
+	{
+		for (auto const* node = &nodeFromIndex(index); node != &_root; node = node->parent)
+		{
+			path.push_back(node->identifier);
+		}
+		std::reverse(path.begin(), path.end());
+	}
+	return path;
+}
+
+QModelIndex ControlledEntityTreeModel::fetchIndex(NodePath const& path) noexcept
+{
+	auto index = QModelIndex{};
+	for (auto const& identifier : path)
+	{
+		if (canFetchMore(index))
+		{
+			fetchMore(index);
+		}
+		auto* const node = findNode(identifier);
+		if (!node || node->parent != &nodeFromIndex(index))
+		{
+			return {};
+		}
+		index = indexOf(*node);
+	}
+	return index;
+}
+
+void ControlledEntityTreeModel::setErrorBit(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, ErrorBit const errorBit, bool const isError) noexcept
+{
+	auto const key = makeErrorKey(descriptorType, descriptorIndex);
+	auto const previousErrorBits = getErrorBits(descriptorType, descriptorIndex);
+	auto errorBits = previousErrorBits;
+	if (isError)
+	{
+		errorBits.set(errorBit);
+	}
+	else
+	{
+		errorBits.reset(errorBit);
+	}
+	if (errorBits.value() == previousErrorBits.value())
+	{
+		return;
+	}
+
+	// Only keep the descriptors in error in the table
+	if (errorBits.empty())
+	{
+		_errorBits.erase(key);
+	}
+	else
+	{
+		_errorBits[key] = errorBits;
+	}
+
+	// Use Index 0 as ConfigurationIndex for the Entity Descriptor
+	auto const configurationIndex = descriptorType == la::avdecc::entity::model::DescriptorType::Entity ? la::avdecc::entity::model::ConfigurationIndex{ 0u } : _currentConfigurationIndex;
+	if (auto* const node = findNode({ configurationIndex, descriptorType, descriptorIndex }))
+	{
+		notifyDataChanged(*node, la::avdecc::utils::to_integral(hive::widgetModelsLibrary::QtUserRoles::ErrorRole));
+	}
+	// Also update the redundant stream node, which shows the errors of its streams
+	if (auto const it = _redundantStreamNodes.find(key); it != _redundantStreamNodes.end())
+	{
+		notifyDataChanged(*it->second, la::avdecc::utils::to_integral(hive::widgetModelsLibrary::QtUserRoles::ErrorRole));
+	}
+}
+
+void ControlledEntityTreeModel::setEntityName(QString const& entityName) noexcept
+{
+	if (auto* const node = findNode({ la::avdecc::entity::model::ConfigurationIndex{ 0u }, la::avdecc::entity::model::DescriptorType::Entity, la::avdecc::entity::model::DescriptorIndex{ 0u } }))
+	{
+		node->name = genEntityName(entityName);
+		notifyDataChanged(*node, Qt::DisplayRole);
+	}
+}
+
+void ControlledEntityTreeModel::setDescriptorName(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, QString const& name) noexcept
+{
+	auto* const node = findNode({ configurationIndex, descriptorType, descriptorIndex });
+	if (!node)
+	{
+		// Not created yet, its name will be read from the entity model
+		return;
+	}
+
+	auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+	auto controlledEntity = manager.getControlledEntity(_entityID);
+
+	// Filter configuration, we currently expand nodes only for current configuration (and all ConfigurationDescriptors)
+	if (controlledEntity && (descriptorType == la::avdecc::entity::model::DescriptorType::Configuration || configurationIndex == controlledEntity->getEntityNode().dynamicModel.currentConfiguration))
+	{
+		node->name = genDescriptorName(*controlledEntity, configurationIndex, descriptorType, descriptorIndex, node->localizedDescription, name);
+		notifyDataChanged(*node, Qt::DisplayRole);
+	}
+}
+
+void ControlledEntityTreeModel::setCurrentClockSource(la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept
+{
+	if (auto* const node = findNode({ _currentConfigurationIndex, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex }))
+	{
+		for (auto const& child : node->children)
+		{
+			auto const isCurrentClockSource = child->identifier.index == clockSourceIndex;
+			if (child->isActive != isCurrentClockSource)
+			{
+				child->isActive = isCurrentClockSource;
+				notifyDataChanged(*child, la::avdecc::utils::to_integral(hive::widgetModelsLibrary::QtUserRoles::ActiveRole));
+			}
+		}
+	}
+}
+
+QModelIndex ControlledEntityTreeModel::index(int row, int column, QModelIndex const& parent) const
+{
+	auto const& parentNode = nodeFromIndex(parent);
+	if (column != 0 || row < 0 || row >= static_cast<int>(parentNode.children.size()))
+	{
+		return {};
+	}
+	return createIndex(row, column, parentNode.children[row].get());
+}
+
+QModelIndex ControlledEntityTreeModel::parent(QModelIndex const& index) const
+{
+	if (!index.isValid())
+	{
+		return {};
+	}
+	auto* const parentNode = nodeFromIndex(index).parent;
+	if (!parentNode || parentNode == &_root)
+	{
+		return {};
+	}
+	return indexOf(*parentNode);
+}
+
+int ControlledEntityTreeModel::rowCount(QModelIndex const& parent) const
+{
+	if (parent.column() > 0)
+	{
+		return 0;
+	}
+	return static_cast<int>(nodeFromIndex(parent).children.size());
+}
+
+int ControlledEntityTreeModel::columnCount(QModelIndex const& /*parent*/) const
+{
+	return 1;
+}
+
+bool ControlledEntityTreeModel::hasChildren(QModelIndex const& parent) const
+{
+	auto const& node = nodeFromIndex(parent);
+	return !node.children.empty() || static_cast<bool>(node.fetchChildren);
+}
+
+bool ControlledEntityTreeModel::canFetchMore(QModelIndex const& parent) const
+{
+	return static_cast<bool>(nodeFromIndex(parent).fetchChildren);
+}
+
+void ControlledEntityTreeModel::fetchMore(QModelIndex const& parent)
+{
+	auto& node = nodeFromIndex(parent);
+	if (!node.fetchChildren)
+	{
+		return;
+	}
+
+	// The model nodes are only valid as long as the loaded entity did not go offline (or online again) since the load
+	if (!_entityID || _loadedOnlineGeneration != _onlineGeneration)
+	{
+		return;
+	}
+	auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+	auto controlledEntity = manager.getControlledEntity(_entityID);
+	if (!controlledEntity)
+	{
+		return;
+	}
+
+	auto const fetchChildren = std::move(node.fetchChildren);
+	node.fetchChildren = nullptr;
+
+	// Create the children aside, so they are inserted at once
+	fetchChildren(*controlledEntity, node);
+	auto children = std::move(node.children);
+	node.children.clear();
+	if (children.empty())
+	{
+		return;
+	}
+
+	beginInsertRows(parent, 0, static_cast<int>(children.size()) - 1);
+	node.children = std::move(children);
+	endInsertRows();
+}
+
+QVariant ControlledEntityTreeModel::data(QModelIndex const& index, int role) const
+{
+	if (!index.isValid())
+	{
+		return {};
+	}
+
+	auto const& node = nodeFromIndex(index);
+	if (role == Qt::DisplayRole)
+	{
+		return node.name;
+	}
+	if (role == la::avdecc::utils::to_integral(hive::entityInspector::RoleInfo::NodeType))
+	{
+		return QVariant::fromValue(node.anyNode);
+	}
+	if (role == la::avdecc::utils::to_integral(hive::entityInspector::RoleInfo::IsActiveConfiguration))
+	{
+		return node.isActiveConfiguration;
+	}
+	if (role == la::avdecc::utils::to_integral(hive::entityInspector::RoleInfo::AudioUnitIndex))
+	{
+		if (node.identifier.type == la::avdecc::entity::model::DescriptorType::AudioUnit && !node.identifier.isVirtual)
+		{
+			return QVariant{ node.identifier.index };
+		}
+		return {};
+	}
+	if (role == la::avdecc::utils::to_integral(hive::widgetModelsLibrary::QtUserRoles::ActiveRole))
+	{
+		return node.isActive;
+	}
+	if (role == la::avdecc::utils::to_integral(hive::widgetModelsLibrary::QtUserRoles::ErrorRole))
+	{
+		return !getErrorBits(node).empty();
+	}
+	return {};
+}
+
+std::uint32_t ControlledEntityTreeModel::makeErrorKey(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+{
+	return (static_cast<std::uint32_t>(la::avdecc::utils::to_integral(descriptorType)) << 16) | descriptorIndex;
+}
+
+ControlledEntityTreeModel::Node& ControlledEntityTreeModel::nodeFromIndex(QModelIndex const& index) const noexcept
+{
+	if (!index.isValid())
+	{
+		return const_cast<Node&>(_root);
+	}
+	return *static_cast<Node*>(index.internalPointer());
+}
+
+QModelIndex ControlledEntityTreeModel::indexOf(Node const& node) const noexcept
+{
+	return createIndex(node.row, 0, const_cast<Node*>(&node));
+}
+
+ControlledEntityTreeModel::Node* ControlledEntityTreeModel::findNode(NodeIdentifier const& identifier) const noexcept
+{
+	auto const it = _identifierToNode.find(identifier);
+	return it != _identifierToNode.end() ? it->second : nullptr;
+}
+
+void ControlledEntityTreeModel::notifyDataChanged(Node const& node, int const role) noexcept
+{
+	auto const index = indexOf(node);
+	emit dataChanged(index, index, { role });
+}
+
+ControlledEntityTreeModel::ErrorBits ControlledEntityTreeModel::getErrorBits(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) const noexcept
+{
+	auto const it = _errorBits.find(makeErrorKey(descriptorType, descriptorIndex));
+	return it != _errorBits.end() ? it->second : ErrorBits{};
+}
+
+ControlledEntityTreeModel::ErrorBits ControlledEntityTreeModel::getErrorBits(Node const& node) const noexcept
+{
+	// Errors are only reported for the current configuration (and the Entity)
+	if (!node.isActiveConfiguration)
+	{
+		return {};
+	}
+
+	if (node.identifier.isVirtual)
+	{
+		auto errorBits = ErrorBits{};
+		for (auto const streamIndex : node.redundantStreams)
+		{
+			errorBits |= getErrorBits(node.identifier.type, streamIndex);
+		}
+		return errorBits;
+	}
+
+	return getErrorBits(node.identifier.type, node.identifier.index);
+}
+
+void ControlledEntityTreeModel::initErrorBits(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+{
+	auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+	auto errorBits = ErrorBits{};
+
+	switch (descriptorType)
+	{
+		case la::avdecc::entity::model::DescriptorType::Entity:
+			if (!manager.getStatisticsCounters(_entityID).empty())
+			{
+				errorBits.set(ErrorBit::EntityStatistics);
+			}
+			if (manager.getDiagnostics(_entityID).redundancyWarning)
+			{
+				errorBits.set(ErrorBit::EntityRedundancyWarning);
+			}
+			break;
+		case la::avdecc::entity::model::DescriptorType::StreamInput:
+			if (!manager.getStreamInputErrorCounters(_entityID, descriptorIndex).empty())
+			{
+				errorBits.set(ErrorBit::StreamInputCounter);
+			}
+			if (manager.getStreamInputLatencyError(_entityID, descriptorIndex))
+			{
+				errorBits.set(ErrorBit::StreamInputLatency);
+			}
+			break;
+		case la::avdecc::entity::model::DescriptorType::Control:
+			if (manager.getControlValueOutOfBounds(_entityID, descriptorIndex))
+			{
+				errorBits.set(ErrorBit::ControlValueOutOfBounds);
+			}
+			break;
+		default:
+			return;
+	}
+
+	auto const key = makeErrorKey(descriptorType, descriptorIndex);
+	if (errorBits.empty())
+	{
+		_errorBits.erase(key);
+	}
+	else
+	{
+		_errorBits[key] = errorBits;
+	}
+}
+
+QString ControlledEntityTreeModel::genEntityName(QString const& name) const noexcept
+{
+	return QString("%1: %2").arg(avdecc::helper::descriptorTypeToString(la::avdecc::entity::model::DescriptorType::Entity), name);
+}
+
+QString ControlledEntityTreeModel::genDescriptorName(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::LocalizedStringReference const& localizedDescription, QString const& name) const noexcept
+{
+	auto objName = hive::modelsLibrary::helper::localizedString(controlledEntity, configurationIndex, localizedDescription);
+
+	// Only use name for current configuration (and all ConfigurationDescriptors)
+	if ((descriptorType == la::avdecc::entity::model::DescriptorType::Configuration || configurationIndex == controlledEntity.getEntityNode().dynamicModel.currentConfiguration) && !name.isEmpty())
+	{
+		objName = name;
+	}
+
+	return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(descriptorType), QString::number(descriptorIndex), objName);
+}
+
+QString ControlledEntityTreeModel::genIndexedName(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) const noexcept
+{
+	return QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(descriptorType), QString::number(descriptorIndex));
+}
+
+template<typename NodeType>
+ControlledEntityTreeModel::Node& ControlledEntityTreeModel::addNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& modelNode, QString const& name) noexcept
+{
+	auto node = std::make_unique<Node>();
+	node->parent = &parent;
+	node->row = static_cast<int>(parent.children.size());
+	if constexpr (std::is_base_of_v<la::avdecc::controller::model::VirtualNode, NodeType>)
+	{
+		node->identifier = NodeIdentifier{ configurationIndex, modelNode.descriptorType, modelNode.virtualIndex };
+	}
+	else
+	{
+		node->identifier = NodeIdentifier{ configurationIndex, modelNode.descriptorType, modelNode.descriptorIndex };
+	}
+	// Store the model node inside the node (the exact type is required by the NodeDispatcher)
+	node->anyNode = AnyNode{ &modelNode };
+	node->name = name;
+	node->isActiveConfiguration = configurationIndex == _currentConfigurationIndex;
+
+	_identifierToNode[node->identifier] = node.get();
+	return *parent.children.emplace_back(std::move(node));
+}
+
+template<typename NodeType>
+ControlledEntityTreeModel::Node& ControlledEntityTreeModel::addDescriptorNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& modelNode) noexcept
+{
+	auto const name = genDescriptorName(controlledEntity, configurationIndex, modelNode.descriptorType, modelNode.descriptorIndex, modelNode.staticModel.localizedDescription, QString::fromStdString(modelNode.dynamicModel.objectName));
+	auto& node = addNode(parent, configurationIndex, modelNode, name);
+	node.localizedDescription = modelNode.staticModel.localizedDescription;
+	return node;
+}
+
+void ControlledEntityTreeModel::setChildrenFetcher(Node& node, bool const hasChildren, Node::ChildrenFetcher&& fetchChildren) noexcept
+{
+	if (hasChildren)
+	{
+		node.fetchChildren = std::move(fetchChildren);
+	}
+}
+
+void ControlledEntityTreeModel::addEntityNode(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	auto const& entityNode = controlledEntity.getEntityNode();
+	_currentConfigurationIndex = entityNode.dynamicModel.currentConfiguration;
+
+	// Use Index 0 as ConfigurationIndex for the Entity Descriptor
+	auto& node = addNode(_root, la::avdecc::entity::model::ConfigurationIndex{ 0u }, entityNode, genEntityName(QString::fromStdString(entityNode.dynamicModel.entityName)));
+	// Special case for EntityNode, which always is ActiveConfiguration
+	node.isActiveConfiguration = true;
+	initErrorBits(entityNode.descriptorType, entityNode.descriptorIndex);
+
+	setChildrenFetcher(node, !entityNode.configurations.empty(),
+		[this, &entityNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const& [configurationIndex, configurationNode] : entityNode.configurations)
+			{
+				addConfigurationNode(controlledEntity, node, configurationNode);
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addConfigurationNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationNode.descriptorIndex, configurationNode);
+	node.isActive = configurationNode.dynamicModel.isActiveConfiguration;
+
+	// Only the current configuration is expanded, unless the full static model is displayed
+	setChildrenFetcher(node, configurationNode.dynamicModel.isActiveConfiguration || _displayFullModel,
+		[this, &configurationNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			auto const configurationIndex = configurationNode.descriptorIndex;
+
+			for (auto const& [audioUnitIndex, audioUnitNode] : configurationNode.audioUnits)
+			{
+				addAudioUnitNode(controlledEntity, node, configurationIndex, audioUnitNode);
+			}
+			// Only show non-redundant streams when the parent is Configuration
+			for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+			{
+				if (!streamInputNode.isRedundant)
+				{
+					addStreamInputNode(controlledEntity, node, configurationIndex, streamInputNode);
+				}
+			}
+			for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+			{
+				if (!streamOutputNode.isRedundant)
+				{
+					addDescriptorNode(controlledEntity, node, configurationIndex, streamOutputNode);
+				}
+			}
+			for (auto const& [jackIndex, jackInputNode] : configurationNode.jackInputs)
+			{
+				addJackNode(controlledEntity, node, configurationIndex, jackInputNode);
+			}
+			for (auto const& [jackIndex, jackOutputNode] : configurationNode.jackOutputs)
+			{
+				addJackNode(controlledEntity, node, configurationIndex, jackOutputNode);
+			}
+			for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configurationNode.avbInterfaces)
+			{
+				addDescriptorNode(controlledEntity, node, configurationIndex, avbInterfaceNode);
+			}
+			// ClockSourceNodes are shown in their ClockDomainNode
+			for (auto const& [memoryObjectIndex, memoryObjectNode] : configurationNode.memoryObjects)
+			{
+				addDescriptorNode(controlledEntity, node, configurationIndex, memoryObjectNode);
+			}
+			for (auto const& [localeIndex, localeNode] : configurationNode.locales)
+			{
+				addLocaleNode(node, configurationIndex, localeNode);
+			}
+			for (auto const& [controlIndex, controlNode] : configurationNode.controls)
+			{
+				addControlNode(controlledEntity, node, configurationIndex, controlNode);
+			}
+			for (auto const& [clockDomainIndex, clockDomainNode] : configurationNode.clockDomains)
+			{
+				addClockDomainNode(controlledEntity, node, configurationNode, clockDomainNode);
+			}
+			for (auto const& [timingIndex, timingNode] : configurationNode.timings)
+			{
+				addTimingNode(controlledEntity, node, configurationNode, timingNode);
+			}
+			// PtpInstanceNodes are shown in their TimingNode
+			for (auto const& [virtualIndex, redundantStreamNode] : configurationNode.redundantStreamInputs)
+			{
+				addRedundantStreamNode(node, configurationIndex, redundantStreamNode, "REDUNDANT_INPUT",
+					[this, &configurationNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node, la::avdecc::entity::model::StreamIndex const streamIndex)
+					{
+						if (auto const it = configurationNode.streamInputs.find(streamIndex); it != configurationNode.streamInputs.end())
+						{
+							addStreamInputNode(controlledEntity, node, configurationNode.descriptorIndex, it->second);
+						}
+					});
+			}
+			for (auto const& [virtualIndex, redundantStreamNode] : configurationNode.redundantStreamOutputs)
+			{
+				addRedundantStreamNode(node, configurationIndex, redundantStreamNode, "REDUNDANT_OUTPUT",
+					[this, &configurationNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node, la::avdecc::entity::model::StreamIndex const streamIndex)
+					{
+						if (auto const it = configurationNode.streamOutputs.find(streamIndex); it != configurationNode.streamOutputs.end())
+						{
+							addDescriptorNode(controlledEntity, node, configurationNode.descriptorIndex, it->second);
+						}
+					});
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addAudioUnitNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::AudioUnitNode const& audioUnitNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationIndex, audioUnitNode);
+
+	setChildrenFetcher(node, !audioUnitNode.streamPortInputs.empty() || !audioUnitNode.streamPortOutputs.empty() || !audioUnitNode.controls.empty(),
+		[this, configurationIndex, &audioUnitNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const& [streamPortIndex, streamPortInputNode] : audioUnitNode.streamPortInputs)
+			{
+				addStreamPortNode(controlledEntity, node, configurationIndex, streamPortInputNode);
+			}
+			for (auto const& [streamPortIndex, streamPortOutputNode] : audioUnitNode.streamPortOutputs)
+			{
+				addStreamPortNode(controlledEntity, node, configurationIndex, streamPortOutputNode);
+			}
+			for (auto const& [controlIndex, controlNode] : audioUnitNode.controls)
+			{
+				addControlNode(controlledEntity, node, configurationIndex, controlNode);
+			}
+		});
+}
+
+template<typename NodeType>
+void ControlledEntityTreeModel::addStreamPortNode(la::avdecc::controller::ControlledEntity const& /*controlledEntity*/, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& streamPortNode) noexcept
+{
+	auto& node = addNode(parent, configurationIndex, streamPortNode, genIndexedName(streamPortNode.descriptorType, streamPortNode.descriptorIndex));
+
+	setChildrenFetcher(node, !streamPortNode.audioClusters.empty() || !streamPortNode.audioMaps.empty() || !streamPortNode.controls.empty(),
+		[this, configurationIndex, &streamPortNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const& [clusterIndex, audioClusterNode] : streamPortNode.audioClusters)
+			{
+				addDescriptorNode(controlledEntity, node, configurationIndex, audioClusterNode);
+			}
+			for (auto const& [mapIndex, audioMapNode] : streamPortNode.audioMaps)
+			{
+				addNode(node, configurationIndex, audioMapNode, genIndexedName(audioMapNode.descriptorType, audioMapNode.descriptorIndex));
+			}
+			for (auto const& [controlIndex, controlNode] : streamPortNode.controls)
+			{
+				addControlNode(controlledEntity, node, configurationIndex, controlNode);
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addStreamInputNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::StreamInputNode const& streamInputNode) noexcept
+{
+	addDescriptorNode(controlledEntity, parent, configurationIndex, streamInputNode);
+	if (configurationIndex == _currentConfigurationIndex)
+	{
+		initErrorBits(streamInputNode.descriptorType, streamInputNode.descriptorIndex);
+	}
+}
+
+template<typename NodeType>
+void ControlledEntityTreeModel::addJackNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& jackNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationIndex, jackNode);
+
+	setChildrenFetcher(node, !jackNode.controls.empty(),
+		[this, configurationIndex, &jackNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const& [controlIndex, controlNode] : jackNode.controls)
+			{
+				addControlNode(controlledEntity, node, configurationIndex, controlNode);
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addControlNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::ControlNode const& controlNode) noexcept
+{
+	addDescriptorNode(controlledEntity, parent, configurationIndex, controlNode);
+	if (configurationIndex == _currentConfigurationIndex)
+	{
+		initErrorBits(controlNode.descriptorType, controlNode.descriptorIndex);
+	}
+}
+
+void ControlledEntityTreeModel::addLocaleNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::LocaleNode const& localeNode) noexcept
+{
+	auto const name = QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(localeNode.descriptorType), QString::number(localeNode.descriptorIndex), QString::fromStdString(localeNode.staticModel.localeID));
+	auto& node = addNode(parent, configurationIndex, localeNode, name);
+
+	setChildrenFetcher(node, !localeNode.strings.empty(),
+		[this, configurationIndex, &localeNode](la::avdecc::controller::ControlledEntity const& /*controlledEntity*/, Node& node)
+		{
+			for (auto const& [stringsIndex, stringsNode] : localeNode.strings)
+			{
+				addNode(node, configurationIndex, stringsNode, genIndexedName(stringsNode.descriptorType, stringsNode.descriptorIndex));
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addClockDomainNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode, la::avdecc::controller::model::ClockDomainNode const& clockDomainNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationNode.descriptorIndex, clockDomainNode);
+
+	setChildrenFetcher(node, !clockDomainNode.staticModel.clockSources.empty(),
+		[this, &configurationNode, &clockDomainNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			auto const isCurrentConfiguration = configurationNode.descriptorIndex == _currentConfigurationIndex;
+			for (auto const clockSourceIndex : clockDomainNode.staticModel.clockSources)
+			{
+				if (auto const it = configurationNode.clockSources.find(clockSourceIndex); it != configurationNode.clockSources.end())
+				{
+					auto& clockSourceNode = addDescriptorNode(controlledEntity, node, configurationNode.descriptorIndex, it->second);
+					// Set the ActiveRole
+					clockSourceNode.isActive = isCurrentConfiguration && clockSourceIndex == clockDomainNode.dynamicModel.clockSourceIndex;
+				}
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addTimingNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode, la::avdecc::controller::model::TimingNode const& timingNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationNode.descriptorIndex, timingNode);
+
+	setChildrenFetcher(node, !timingNode.staticModel.ptpInstances.empty(),
+		[this, &configurationNode, &timingNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const ptpInstanceIndex : timingNode.staticModel.ptpInstances)
+			{
+				if (auto const it = configurationNode.ptpInstances.find(ptpInstanceIndex); it != configurationNode.ptpInstances.end())
+				{
+					addPtpInstanceNode(controlledEntity, node, configurationNode.descriptorIndex, it->second);
+				}
+			}
+		});
+}
+
+void ControlledEntityTreeModel::addPtpInstanceNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::PtpInstanceNode const& ptpInstanceNode) noexcept
+{
+	auto& node = addDescriptorNode(controlledEntity, parent, configurationIndex, ptpInstanceNode);
+
+	setChildrenFetcher(node, !ptpInstanceNode.controls.empty() || !ptpInstanceNode.ptpPorts.empty(),
+		[this, configurationIndex, &ptpInstanceNode](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const& [controlIndex, controlNode] : ptpInstanceNode.controls)
+			{
+				addControlNode(controlledEntity, node, configurationIndex, controlNode);
+			}
+			for (auto const& [ptpPortIndex, ptpPortNode] : ptpInstanceNode.ptpPorts)
+			{
+				addDescriptorNode(controlledEntity, node, configurationIndex, ptpPortNode);
+			}
+		});
+}
+
+template<typename NodeType, typename StreamAdder>
+void ControlledEntityTreeModel::addRedundantStreamNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& redundantStreamNode, QString const& prefix, StreamAdder&& addStream) noexcept
+{
+	auto const name = QString("%1.%2: %3").arg(prefix, QString::number(redundantStreamNode.virtualIndex), QString::fromStdString(redundantStreamNode.virtualName));
+	auto& node = addNode(parent, configurationIndex, redundantStreamNode, name);
+
+	// The errors of the streams are shown on the redundant stream node, even when not expanded
+	for (auto const streamIndex : redundantStreamNode.redundantStreams)
+	{
+		node.redundantStreams.push_back(streamIndex);
+		if (configurationIndex == _currentConfigurationIndex)
+		{
+			initErrorBits(redundantStreamNode.descriptorType, streamIndex);
+			_redundantStreamNodes[makeErrorKey(redundantStreamNode.descriptorType, streamIndex)] = &node;
+		}
+	}
+
+	setChildrenFetcher(node, !redundantStreamNode.redundantStreams.empty(),
+		[&redundantStreamNode, addStream = std::forward<StreamAdder>(addStream)](la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)
+		{
+			for (auto const streamIndex : redundantStreamNode.redundantStreams)
+			{
+				addStream(controlledEntity, node, streamIndex);
+			}
+		});
+}
@@ -0,0 +1,208 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "nodeDispatcher.hpp"
+
+#include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
+
+#include <QAbstractItemModel>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Descriptors tree of a ControlledEntity
+// Rows are only created when their parent is expanded (the entity model of some devices has thousands of descriptors), and the error state of the descriptors is kept in a flat table so it can be updated whether the row exists or not
+class ControlledEntityTreeModel final : public QAbstractItemModel
+{
+public:
+	enum class ErrorBit
+	{
+		// Entity Level
+		EntityStatistics = 1u << 0,
+		EntityRedundancyWarning = 1u << 1,
+		// StreamInput Level
+		StreamInputCounter = 1u << 2,
+		StreamInputLatency = 1u << 3,
+		// Control Level
+		ControlValueOutOfBounds = 1u << 4,
+	};
+	using ErrorBits = la::avdecc::utils::EnumBitfield<ErrorBit>;
+
+	struct NodeIdentifier
+	{
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		la::avdecc::entity::model::DescriptorType type{ la::avdecc::entity::model::DescriptorType::Invalid };
+		la::avdecc::entity::model::DescriptorIndex index{ 0u };
+		bool isVirtual{ false };
+		NodeIdentifier() noexcept = default;
+		NodeIdentifier(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const type, la::avdecc::entity::model::DescriptorIndex const index) noexcept
+			: configurationIndex(configurationIndex)
+			, type(type)
+			, index(index)
+			, isVirtual(false)
+		{
+		}
+
+		NodeIdentifier(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const type, la::avdecc::controller::model::VirtualIndex const index) noexcept
+			: configurationIndex(configurationIndex)
+			, type(type)
+			, index(index)
+			, isVirtual(true)
+		{
+		}
+
+		constexpr bool operator==(NodeIdentifier const& other) const noexcept
+		{
+			return configurationIndex == other.configurationIndex && type == other.type && index == other.index && isVirtual == other.isVirtual;
+		}
+
+		/** Hash functor to be used for std::hash */
+		struct hash
+		{
+			std::size_t operator()(NodeIdentifier const& id) const
+			{
+				// Bit 21-31 for ConfigurationIndex (11 bits)
+				// Bit 7-20 for DescriptorIndex (14 bits)
+				// Bit 1-6 for DescriptorType (6 bits)
+				// Bit 0 for Kind (1 bit)
+				return ((static_cast<std::size_t>(id.configurationIndex) & 0x7fff) << 21) | ((static_cast<std::size_t>(id.index) & 0x3fff) << 7) | ((static_cast<std::size_t>(id.type) & 0x3f) << 1) | (static_cast<std::size_t>(id.isVirtual) & 0x1);
+			}
+		};
+	};
+	using NodeIdentifierSet = std::unordered_set<NodeIdentifier, NodeIdentifier::hash>;
+	using NodePath = std::vector<NodeIdentifier>;
+
+	/** Loads the Entity node (its children being created when expanded), all previous rows are removed (load({}) removes all rows) */
+	void load(la::avdecc::UniqueIdentifier const entityID, bool const displayFullModel = false) noexcept;
+
+	/** Notifies an entity went online or offline, the nodes loaded before for this entity are no longer fetched (they point to its previous entity model) */
+	void notifyEntityOnlineChanged(la::avdecc::UniqueIdentifier const entityID) noexcept;
+
+	QModelIndex indexOf(NodeIdentifier const& identifier) const noexcept;
+	NodeIdentifier getIdentifier(QModelIndex const& index) const noexcept;
+
+	/** Returns the identifiers from the Entity node down to the node at index */
+	NodePath getPath(QModelIndex const& index) const noexcept;
+
+	/** Returns the index of the node at the end of the path, creating the nodes along the path if needed */
+	QModelIndex fetchIndex(NodePath const& path) noexcept;
+
+	/** Calls the handler with the identifier and index of all the nodes created so far */
+	template<typename Handler>
+	void forEachNode(Handler&& handler) const noexcept
+	{
+		for (auto const& [identifier, node] : _identifierToNode)
+		{
+			handler(identifier, indexOf(*node));
+		}
+	}
+
+	/** Changes an error bit of a descriptor of the current configuration, the row being updated if it exists */
+	void setErrorBit(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, ErrorBit const errorBit, bool const isError) noexcept;
+
+	void setEntityName(QString const& entityName) noexcept;
+	void setDescriptorName(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, QString const& name) noexcept;
+	void setCurrentClockSource(la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept;
+
+	// QAbstractItemModel overrides
+	virtual QModelIndex index(int row, int column, QModelIndex const& parent = {}) const override;
+	virtual QModelIndex parent(QModelIndex const& index) const override;
+	virtual int rowCount(QModelIndex const& parent = {}) const override;
+	virtual int columnCount(QModelIndex const& /*parent*/ = {}) const override;
+	virtual bool hasChildren(QModelIndex const& parent = {}) const override;
+	virtual bool canFetchMore(QModelIndex const& parent) const override;
+	virtual void fetchMore(QModelIndex const& parent) override;
+	virtual QVariant data(QModelIndex const& index, int role) const override;
+
+private:
+	struct Node
+	{
+		using ChildrenFetcher = std::function<void(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& node)>;
+
+		Node* parent{ nullptr };
+		int row{ 0 };
+		NodeIdentifier identifier{};
+		AnyNode anyNode{};
+		QString name{};
+		la::avdecc::entity::model::LocalizedStringReference localizedDescription{};
+		bool isActiveConfiguration{ false };
+		bool isActive{ false }; // Active configuration, or current clock source
+		std::vector<la::avdecc::entity::model::StreamIndex> redundantStreams{}; // Streams of a redundant stream node, which shows their errors
+		ChildrenFetcher fetchChildren{}; // Only set until the children are created
+		std::vector<std::unique_ptr<Node>> children{};
+	};
+
+	static std::uint32_t makeErrorKey(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept;
+	Node& nodeFromIndex(QModelIndex const& index) const noexcept;
+	QModelIndex indexOf(Node const& node) const noexcept;
+	Node* findNode(NodeIdentifier const& identifier) const noexcept;
+	void notifyDataChanged(Node const& node, int const role) noexcept;
+	ErrorBits getErrorBits(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) const noexcept;
+	ErrorBits getErrorBits(Node const& node) const noexcept;
+
+	// Reads the current error state of a descriptor from the ControllerManager (the table being kept up-to-date by the ControllerManager signals afterwards)
+	void initErrorBits(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept;
+
+	QString genEntityName(QString const& name) const noexcept;
+	QString genDescriptorName(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::LocalizedStringReference const& localizedDescription, QString const& name) const noexcept;
+	QString genIndexedName(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) const noexcept;
+	template<typename NodeType>
+	Node& addNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& modelNode, QString const& name) noexcept;
+
+	// Adds a node named after its descriptor (object name or localized description)
+	template<typename NodeType>
+	Node& addDescriptorNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& modelNode) noexcept;
+
+	void setChildrenFetcher(Node& node, bool const hasChildren, Node::ChildrenFetcher&& fetchChildren) noexcept;
+	void addEntityNode(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+	void addConfigurationNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode) noexcept;
+	void addAudioUnitNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::AudioUnitNode const& audioUnitNode) noexcept;
+	template<typename NodeType>
+	void addStreamPortNode(la::avdecc::controller::ControlledEntity const& /*controlledEntity*/, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& streamPortNode) noexcept;
+	void addStreamInputNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::StreamInputNode const& streamInputNode) noexcept;
+	template<typename NodeType>
+	void addJackNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& jackNode) noexcept;
+	void addControlNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::ControlNode const& controlNode) noexcept;
+	void addLocaleNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::LocaleNode const& localeNode) noexcept;
+	void addClockDomainNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode, la::avdecc::controller::model::ClockDomainNode const& clockDomainNode) noexcept;
+	void addTimingNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::controller::model::ConfigurationNode const& configurationNode, la::avdecc::controller::model::TimingNode const& timingNode) noexcept;
+	void addPtpInstanceNode(la::avdecc::controller::ControlledEntity const& controlledEntity, Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::controller::model::PtpInstanceNode const& ptpInstanceNode) noexcept;
+	template<typename NodeType, typename StreamAdder>
+	void addRedundantStreamNode(Node& parent, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, NodeType const& redundantStreamNode, QString const& prefix, StreamAdder&& addStream) noexcept;
+
+	la::avdecc::UniqueIdentifier _entityID{};
+	std::uint64_t _onlineGeneration{ 0u }; // Incremented each time the loaded entity goes online or offline
+	std::uint64_t _loadedOnlineGeneration{ 0u }; // Online generation of the loaded nodes
+	la::avdecc::entity::model::ConfigurationIndex _currentConfigurationIndex{ 0u };
+	bool _displayFullModel{ false };
+	Node _root{};
+
+	// Quick access to the created nodes
+	std::unordered_map<NodeIdentifier, Node*, NodeIdentifier::hash> _identifierToNode{};
+	std::unordered_map<std::uint32_t, Node*> _redundantStreamNodes{}; // Redundant stream node of the streams of the current configuration, by error key
+
+	// Error bits of the descriptors of the current configuration (and the Entity), by error key (only the descriptors in error are stored)
+	std::unordered_map<std::uint32_t, ErrorBits> _errorBits{};
+};
@@ -19,12 +19,12 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 #include <la/avdecc/internals/uniqueIdentifier.hpp>
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
 
 class ControlledEntityTreeWidgetPrivate;
-class ControlledEntityTreeWidget : public QTreeWidget
+class ControlledEntityTreeWidget : public QTreeView
 {
 	Q_OBJECT
 public:
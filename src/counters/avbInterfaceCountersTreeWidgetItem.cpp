@@ -18,6 +18,7 @@
 */
 
 #include "avbInterfaceCountersTreeWidgetItem.hpp"
+#include "counterHistoryStore.hpp"
 
 #include <QMenu>
 
@@ -61,6 +62,13 @@ AvbInterfaceCountersTreeWidgetItem::AvbInterfaceCountersTreeWidgetItem(la::avdec
 		_counters[flag] = widget;
 	}
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update counters right now
 	updateCounters(counters);
 
@@ -86,6 +94,8 @@ void AvbInterfaceCountersTreeWidgetItem::updateCounters(la::avdecc::entity::mode
 			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
 			widget->setText(1, QString::number(counterKV.second));
 			widget->setHidden(false);
+
+			CounterHistoryStore::getInstance().updateItem(*widget, { _entityID, CounterHistoryStore::CounterKind::AvbInterface, _avbInterfaceIndex, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(counterFlag)) });
 		}
 	}
 }
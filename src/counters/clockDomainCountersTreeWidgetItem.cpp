@@ -18,6 +18,7 @@
 */
 
 #include "clockDomainCountersTreeWidgetItem.hpp"
+#include "counterHistoryStore.hpp"
 
 #include <QMenu>
 
@@ -57,6 +58,13 @@ ClockDomainCountersTreeWidgetItem::ClockDomainCountersTreeWidgetItem(la::avdecc:
 		_counters[flag] = widget;
 	}
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update counters right now
 	updateCounters(counters);
 
@@ -82,6 +90,8 @@ void ClockDomainCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model
 			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
 			widget->setText(1, QString::number(counterKV.second));
 			widget->setHidden(false);
+
+			CounterHistoryStore::getInstance().updateItem(*widget, { _entityID, CounterHistoryStore::CounterKind::ClockDomain, _clockDomainIndex, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(counterFlag)) });
 		}
 	}
 }
@@ -0,0 +1,260 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @Brief Time series of a monotonic counter
+ * @Details The counter is sampled with its absolute value, which is converted to increments (handling 32-bit wraps and counter resets) and accumulated.
+ *          The accumulated value at the end of each time bucket is recorded in fixed size ring buffers, one per resolution tier (1 second, 1 minute and 1 hour),
+ *          so the delta over any duration covered by a tier is the difference of two buckets (constant time), and the increments of a bucket the difference of two consecutive ones.
+ *          Buckets without a sample keep the accumulated value of the previous one (counters are only notified when they change).
+ *          The ring buffers are only allocated when the counter changes for the first time (most counters never do), and always have the same size (StorageSize).
+ */
+class CounterHistory final
+{
+public:
+	enum class Tier : std::uint8_t
+	{
+		Seconds = 0,
+		Minutes = 1,
+		Hours = 2,
+	};
+
+	static constexpr auto TiersCount = std::size_t{ 3u };
+	static constexpr auto Resolutions = std::array<std::chrono::seconds, TiersCount>{ std::chrono::seconds{ 1 }, std::chrono::minutes{ 1 }, std::chrono::hours{ 1 } };
+	static constexpr auto Capacities = std::array<std::size_t, TiersCount>{ 300u, 120u, 48u }; // 5 minutes, 2 hours, 2 days
+	static constexpr auto BucketsCount = Capacities[0] + Capacities[1] + Capacities[2];
+	static constexpr auto StorageSize = BucketsCount * sizeof(std::uint64_t);
+
+	CounterHistory() noexcept = default;
+
+	/** Records the absolute value of the counter at the specified time. The storage is allocated on the first change of the value, if allowed. Returns true if the storage was allocated by this call */
+	bool update(std::chrono::seconds const now, std::uint64_t const value, bool const allowAllocation) noexcept
+	{
+		if (!_lastValue)
+		{
+			_lastValue = value;
+			return false;
+		}
+
+		auto const increment = computeIncrement(*_lastValue, value);
+		_lastValue = value;
+		if (increment == 0u)
+		{
+			return false;
+		}
+
+		auto allocated = false;
+		if (!_buckets)
+		{
+			if (!allowAllocation)
+			{
+				++_droppedIncrements;
+				return false;
+			}
+			allocate(now);
+			allocated = true;
+		}
+
+		// Buckets skipped since the last change keep the previous accumulated value
+		for (auto tier = std::size_t{ 0u }; tier < TiersCount; ++tier)
+		{
+			advance(tier, toBucket(tier, now));
+		}
+		_total += increment;
+		for (auto tier = std::size_t{ 0u }; tier < TiersCount; ++tier)
+		{
+			bucketAt(tier, _lastBuckets[tier]) = _total;
+		}
+		_lastIncrementTime = now;
+
+		return allocated;
+	}
+
+	bool hasStorage() const noexcept
+	{
+		return !!_buckets;
+	}
+
+	/** Total increments recorded since the storage was allocated */
+	std::uint64_t getTotal() const noexcept
+	{
+		return _total;
+	}
+
+	/** Number of increments that could not be recorded (storage not allowed) */
+	std::uint64_t getDroppedIncrements() const noexcept
+	{
+		return _droppedIncrements;
+	}
+
+	std::optional<std::chrono::seconds> getLastIncrementTime() const noexcept
+	{
+		return _lastIncrementTime;
+	}
+
+	/** Increments during the specified duration before now, using the finest tier covering it (the duration is rounded up to its resolution, and clamped to the coarsest tier) */
+	std::uint64_t getDelta(std::chrono::seconds const now, std::chrono::seconds const duration) const noexcept
+	{
+		if (!_buckets)
+		{
+			return 0u;
+		}
+		auto const tier = selectTier(duration);
+		auto const resolution = Resolutions[tier];
+		auto const count = std::min<std::int64_t>((duration.count() + resolution.count() - 1) / resolution.count(), static_cast<std::int64_t>(Capacities[tier]));
+		auto const nowBucket = toBucket(tier, now);
+		return accumulatedAt(tier, nowBucket) - accumulatedAt(tier, nowBucket - count);
+	}
+
+	/** Average increments per second during the specified duration before now */
+	double getRate(std::chrono::seconds const now, std::chrono::seconds const duration) const noexcept
+	{
+		if (duration.count() <= 0)
+		{
+			return 0.0;
+		}
+		return static_cast<double>(getDelta(now, duration)) / static_cast<double>(duration.count());
+	}
+
+	/** Increments of the last count buckets of the tier (oldest first, the last one being the bucket of now) */
+	std::vector<std::uint64_t> getIncrements(Tier const tier, std::chrono::seconds const now, std::size_t const count) const noexcept
+	{
+		auto increments = std::vector<std::uint64_t>(count, std::uint64_t{ 0u });
+		if (!_buckets)
+		{
+			return increments;
+		}
+		auto const tierIndex = static_cast<std::size_t>(tier);
+		auto const nowBucket = toBucket(tierIndex, now);
+		auto previous = accumulatedAt(tierIndex, nowBucket - static_cast<std::int64_t>(count));
+		for (auto i = std::size_t{ 0u }; i < count; ++i)
+		{
+			auto const current = accumulatedAt(tierIndex, nowBucket - static_cast<std::int64_t>(count) + 1 + static_cast<std::int64_t>(i));
+			increments[i] = current - previous;
+			previous = current;
+		}
+		return increments;
+	}
+
+	/** Increment between two absolute values of a counter: a 32-bit counter can wrap, any other decrease is a reset of the counter (it restarted from 0) */
+	static std::uint64_t computeIncrement(std::uint64_t const previous, std::uint64_t const value) noexcept
+	{
+		if (value >= previous)
+		{
+			return value - previous;
+		}
+		static constexpr auto Counter32Range = std::uint64_t{ 1u } << 32;
+		if (previous < Counter32Range && (previous - value) > (Counter32Range / 2u))
+		{
+			return Counter32Range - previous + value;
+		}
+		return value;
+	}
+
+private:
+	static constexpr auto TierOffsets = std::array<std::size_t, TiersCount>{ 0u, Capacities[0], Capacities[0] + Capacities[1] };
+
+	static std::int64_t toBucket(std::size_t const tier, std::chrono::seconds const time) noexcept
+	{
+		return time.count() / Resolutions[tier].count();
+	}
+
+	static std::size_t selectTier(std::chrono::seconds const duration) noexcept
+	{
+		for (auto tier = std::size_t{ 0u }; tier < TiersCount; ++tier)
+		{
+			if (duration <= Resolutions[tier] * static_cast<std::int64_t>(Capacities[tier]))
+			{
+				return tier;
+			}
+		}
+		return TiersCount - 1u;
+	}
+
+	std::uint64_t& bucketAt(std::size_t const tier, std::int64_t const bucket) noexcept
+	{
+		auto const capacity = static_cast<std::int64_t>(Capacities[tier]);
+		return _buckets[TierOffsets[tier] + static_cast<std::size_t>(((bucket % capacity) + capacity) % capacity)];
+	}
+
+	std::uint64_t bucketAt(std::size_t const tier, std::int64_t const bucket) const noexcept
+	{
+		return const_cast<CounterHistory&>(*this).bucketAt(tier, bucket);
+	}
+
+	/** Accumulated value at the end of the bucket, clamped to the oldest recorded bucket */
+	std::uint64_t accumulatedAt(std::size_t const tier, std::int64_t const bucket) const noexcept
+	{
+		auto const lastBucket = _lastBuckets[tier];
+		if (bucket >= lastBucket)
+		{
+			return _total;
+		}
+		auto const oldestBucket = lastBucket - static_cast<std::int64_t>(_filledCounts[tier]) + 1;
+		return bucketAt(tier, std::max(bucket, oldestBucket));
+	}
+
+	void allocate(std::chrono::seconds const now) noexcept
+	{
+		_buckets = std::make_unique<std::uint64_t[]>(BucketsCount);
+		// Start with the bucket before now, so the first increment is accounted in the bucket of now
+		for (auto tier = std::size_t{ 0u }; tier < TiersCount; ++tier)
+		{
+			_lastBuckets[tier] = toBucket(tier, now) - 1;
+			_filledCounts[tier] = 1u;
+			bucketAt(tier, _lastBuckets[tier]) = _total;
+		}
+	}
+
+	void advance(std::size_t const tier, std::int64_t const bucket) noexcept
+	{
+		auto& lastBucket = _lastBuckets[tier];
+		if (bucket <= lastBucket)
+		{
+			return;
+		}
+		auto const capacity = static_cast<std::int64_t>(Capacities[tier]);
+		auto const skipped = std::min(bucket - lastBucket, capacity);
+		for (auto b = bucket - skipped + 1; b <= bucket; ++b)
+		{
+			bucketAt(tier, b) = _total;
+		}
+		_filledCounts[tier] = static_cast<std::size_t>(std::min<std::int64_t>(static_cast<std::int64_t>(_filledCounts[tier]) + (bucket - lastBucket), capacity));
+		lastBucket = bucket;
+	}
+
+	std::unique_ptr<std::uint64_t[]> _buckets{}; // Accumulated value at the end of each bucket, for each tier
+	std::array<std::int64_t, TiersCount> _lastBuckets{};
+	std::array<std::size_t, TiersCount> _filledCounts{};
+	std::optional<std::uint64_t> _lastValue{};
+	std::uint64_t _total{ 0u };
+	std::uint64_t _droppedIncrements{ 0u };
+	std::optional<std::chrono::seconds> _lastIncrementTime{};
+};
@@ -0,0 +1,251 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "counterHistoryStore.hpp"
+
+#include <hive/modelsLibrary/controllerManager.hpp>
+#include <QtMate/material/color.hpp>
+
+#include <QPainter>
+#include <QPixmap>
+#include <QTreeWidget>
+#include <QTreeWidgetItem>
+
+#include <algorithm>
+
+namespace
+{
+using ControllerManager = hive::modelsLibrary::ControllerManager;
+
+static constexpr auto SparklineBucketsCount = std::size_t{ 60u }; // Last hour, in the minutes tier
+static constexpr auto SparklineSize = QSize{ 60, 12 };
+static constexpr auto HistoryKeyRole = Qt::UserRole + 1; // Key of the history displayed on an item (column 1)
+
+QPixmap renderSparkline(std::vector<std::uint64_t> const& increments, QColor const& color) noexcept
+{
+	auto pixmap = QPixmap{ SparklineSize };
+	pixmap.fill(Qt::transparent);
+
+	auto const maxIncrement = *std::max_element(increments.begin(), increments.end());
+	if (maxIncrement == 0u)
+	{
+		return pixmap;
+	}
+
+	auto painter = QPainter{ &pixmap };
+	auto const barWidth = SparklineSize.width() / static_cast<int>(increments.size());
+	for (auto i = std::size_t{ 0u }; i < increments.size(); ++i)
+	{
+		if (increments[i] == 0u)
+		{
+			continue;
+		}
+		// At least 1 pixel high, so a single increment is always visible
+		auto const height = std::max(1, static_cast<int>(increments[i] * static_cast<std::uint64_t>(SparklineSize.height()) / maxIncrement));
+		painter.fillRect(static_cast<int>(i) * barWidth, SparklineSize.height() - height, barWidth, height, color);
+	}
+	return pixmap;
+}
+
+QString durationToString(std::chrono::seconds const duration) noexcept
+{
+	auto const hours = std::chrono::duration_cast<std::chrono::hours>(duration);
+	auto const minutes = std::chrono::duration_cast<std::chrono::minutes>(duration - hours);
+	auto const seconds = duration - hours - minutes;
+	if (hours.count() != 0)
+	{
+		return QString{ "%1h %2m" }.arg(hours.count()).arg(minutes.count());
+	}
+	if (minutes.count() != 0)
+	{
+		return QString{ "%1m %2s" }.arg(minutes.count()).arg(seconds.count());
+	}
+	return QString{ "%1s" }.arg(seconds.count());
+}
+
+} // namespace
+
+template<typename Counters>
+void CounterHistoryStore::updateCounters(la::avdecc::UniqueIdentifier const entityID, CounterKind const kind, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, Counters const& counters) noexcept
+{
+	for (auto const& [flag, value] : counters)
+	{
+		update(Key{ entityID, kind, descriptorIndex, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag)) }, value);
+	}
+}
+
+CounterHistoryStore::CounterHistoryStore() noexcept
+{
+	auto& manager = ControllerManager::getInstance();
+
+	// Descriptor counters
+	connect(&manager, &ControllerManager::entityCountersChanged, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::EntityCounters const& counters)
+		{
+			updateCounters(entityID, CounterKind::Entity, 0u, counters);
+		});
+	connect(&manager, &ControllerManager::avbInterfaceCountersChanged, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters)
+		{
+			updateCounters(entityID, CounterKind::AvbInterface, avbInterfaceIndex, counters);
+		});
+	connect(&manager, &ControllerManager::clockDomainCountersChanged, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters)
+		{
+			updateCounters(entityID, CounterKind::ClockDomain, clockDomainIndex, counters);
+		});
+	connect(&manager, &ControllerManager::streamInputCountersChanged, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters)
+		{
+			updateCounters(entityID, CounterKind::StreamInput, streamIndex, counters);
+		});
+	connect(&manager, &ControllerManager::streamOutputCountersChanged, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters)
+		{
+			switch (counters.getCounterType())
+			{
+				case la::avdecc::entity::model::StreamOutputCounters::CounterType::Milan_12:
+					updateCounters(entityID, CounterKind::StreamOutput, streamIndex, counters.getCounters<la::avdecc::entity::StreamOutputCounterValidFlagsMilan12>());
+					break;
+				case la::avdecc::entity::model::StreamOutputCounters::CounterType::IEEE17221_2021:
+					updateCounters(entityID, CounterKind::StreamOutput, streamIndex, counters.getCounters<la::avdecc::entity::StreamOutputCounterValidFlags17221>());
+					break;
+				case la::avdecc::entity::model::StreamOutputCounters::CounterType::Milan_SignalPresence:
+					updateCounters(entityID, CounterKind::StreamOutput, streamIndex, counters.getCounters<la::avdecc::entity::StreamOutputCounterValidFlagsMilanSignalPresence>());
+					break;
+				default:
+					break;
+			}
+		});
+
+	// AECP statistics
+	auto const statistic = [this](ControllerManager::StatisticsErrorCounterFlag const flag)
+	{
+		return [this, flag](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+		{
+			update(Key{ entityID, CounterKind::Statistics, 0u, la::avdecc::utils::to_integral(flag) }, value);
+		};
+	};
+	connect(&manager, &ControllerManager::aecpRetryCounterChanged, this, statistic(ControllerManager::StatisticsErrorCounterFlag::AecpRetries));
+	connect(&manager, &ControllerManager::aecpTimeoutCounterChanged, this, statistic(ControllerManager::StatisticsErrorCounterFlag::AecpTimeouts));
+	connect(&manager, &ControllerManager::aecpUnexpectedResponseCounterChanged, this, statistic(ControllerManager::StatisticsErrorCounterFlag::AecpUnexpectedResponses));
+	connect(&manager, &ControllerManager::aemAecpUnsolicitedLossCounterChanged, this, statistic(ControllerManager::StatisticsErrorCounterFlag::AemAecpUnsolicitedLosses));
+	connect(&manager, &ControllerManager::mvuAecpUnsolicitedLossCounterChanged, this, statistic(ControllerManager::StatisticsErrorCounterFlag::MvuAecpUnsolicitedLosses));
+
+	// Histories are relative to the controller (counters of a new controller restart from their current value)
+	connect(&manager, &ControllerManager::controllerOffline, this,
+		[this]()
+		{
+			_entities.clear();
+		});
+
+	// Sparklines and durations move with time, even if the counter does not change
+	connect(&_agingTimer, &QTimer::timeout, this, &CounterHistoryStore::historiesAged);
+	_agingTimer.start(AgingInterval);
+}
+
+CounterHistoryStore& CounterHistoryStore::getInstance() noexcept
+{
+	static CounterHistoryStore s_store{};
+
+	return s_store;
+}
+
+std::chrono::seconds CounterHistoryStore::now() const noexcept
+{
+	return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - _startTime);
+}
+
+CounterHistory const* CounterHistoryStore::getHistory(Key const& key) const noexcept
+{
+	auto const entityIt = _entities.find(key.entityID);
+	if (entityIt == _entities.end())
+	{
+		return nullptr;
+	}
+	auto const& counters = entityIt->second.counters;
+	auto const counterIt = counters.find(key);
+	if (counterIt == counters.end())
+	{
+		return nullptr;
+	}
+	return &counterIt->second;
+}
+
+std::size_t CounterHistoryStore::getMemoryUsage(la::avdecc::UniqueIdentifier const entityID) const noexcept
+{
+	if (auto const entityIt = _entities.find(entityID); entityIt != _entities.end())
+	{
+		return entityIt->second.memoryUsage;
+	}
+	return 0u;
+}
+
+void CounterHistoryStore::updateItem(QTreeWidgetItem& item, Key const& key) const noexcept
+{
+	item.setData(1, HistoryKeyRole, QVariant::fromValue(key));
+
+	auto const* const history = getHistory(key);
+	if (!history || !history->hasStorage())
+	{
+		item.setData(1, Qt::DecorationRole, QVariant{});
+		item.setToolTip(1, (history && history->getDroppedIncrements() != 0u) ? "History not recorded (memory budget of the entity reached)" : "No change since the application started");
+		return;
+	}
+
+	auto const now = this->now();
+	auto const foreground = item.foreground(1);
+	auto const color = foreground.style() == Qt::NoBrush ? QColor{ qtMate::material::color::foregroundColor() } : foreground.color();
+	item.setData(1, Qt::DecorationRole, renderSparkline(history->getIncrements(CounterHistory::Tier::Minutes, now, SparklineBucketsCount), color));
+
+	auto toolTip = QString{ "Last minute: +%1 (%2/s)\nLast hour: +%3\nLast 2 days: +%4" }.arg(history->getDelta(now, std::chrono::minutes{ 1 })).arg(history->getRate(now, std::chrono::minutes{ 1 }), 0, 'f', 2).arg(history->getDelta(now, std::chrono::hours{ 1 })).arg(history->getDelta(now, std::chrono::hours{ 48 }));
+	if (auto const lastIncrementTime = history->getLastIncrementTime())
+	{
+		toolTip += QString{ "\nLast increase: %1 ago" }.arg(durationToString(now - *lastIncrementTime));
+	}
+	item.setToolTip(1, toolTip);
+}
+
+void CounterHistoryStore::updateItems(QTreeWidgetItem& parent) const noexcept
+{
+	auto const* const treeWidget = parent.treeWidget();
+	if (!treeWidget || !treeWidget->isVisible() || parent.isHidden())
+	{
+		return;
+	}
+
+	for (auto index = 0; index < parent.childCount(); ++index)
+	{
+		auto* const item = parent.child(index);
+		if (auto const key = item->data(1, HistoryKeyRole); !item->isHidden() && key.canConvert<Key>())
+		{
+			updateItem(*item, key.value<Key>());
+		}
+	}
+}
+
+void CounterHistoryStore::update(Key const& key, std::uint64_t const value) noexcept
+{
+	auto& entity = _entities[key.entityID];
+	auto const allowAllocation = entity.memoryUsage + CounterHistory::StorageSize <= MemoryBudgetPerEntity;
+	if (entity.counters[key].update(now(), value, allowAllocation))
+	{
+		entity.memoryUsage += CounterHistory::StorageSize;
+	}
+}
@@ -0,0 +1,130 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "counters/counterHistory.hpp"
+
+#include <la/avdecc/avdecc.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include <QObject>
+#include <QTimer>
+
+#include <chrono>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+
+class QTreeWidgetItem;
+
+// **************************************************************
+// class CounterHistoryStore
+// **************************************************************
+/**
+	* @brief    History of all the counters of all the entities.
+	* @details  Fed by the ControllerManager counters notifications (descriptor counters and AECP statistics) as soon as the application starts,
+	*			so the history is available when an entity is inspected. The storage allocated for the counters of an entity is bounded by MemoryBudgetPerEntity,
+	*			changes of a counter that cannot be allocated are not recorded.
+	*			Displayed histories of idle counters are aged by historiesAged, emitted every AgingInterval.
+	*/
+class CounterHistoryStore final : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr auto MemoryBudgetPerEntity = std::size_t{ 256u * 1024u };
+	static constexpr auto AgingInterval = std::chrono::seconds{ 5 };
+
+	enum class CounterKind : std::uint8_t
+	{
+		Entity = 0,
+		AvbInterface = 1,
+		ClockDomain = 2,
+		StreamInput = 3,
+		StreamOutput = 4,
+		Statistics = 5, // AECP statistics, the counter being a hive::modelsLibrary::ControllerManager::StatisticsErrorCounterFlag
+	};
+
+	struct Key
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		CounterKind kind{ CounterKind::Entity };
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+		std::uint32_t counter{ 0u }; // Counter flag
+
+		bool operator==(Key const& other) const noexcept
+		{
+			return std::tie(entityID, kind, descriptorIndex, counter) == std::tie(other.entityID, other.kind, other.descriptorIndex, other.counter);
+		}
+
+		struct hash
+		{
+			std::size_t operator()(Key const& key) const noexcept
+			{
+				auto const counter = (std::uint64_t{ la::avdecc::utils::to_integral(key.kind) } << 48) | (std::uint64_t{ key.descriptorIndex } << 32) | key.counter;
+				return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ std::hash<std::uint64_t>{}(counter * 0x9E3779B97F4A7C15ull);
+			}
+		};
+	};
+
+	static CounterHistoryStore& getInstance() noexcept;
+
+	/** Current time of the histories */
+	std::chrono::seconds now() const noexcept;
+
+	/** Returns the history of the counter (without storage if it never changed, or if the memory budget of the entity was reached), or nullptr if no value was received */
+	CounterHistory const* getHistory(Key const& key) const noexcept;
+
+	/** Returns the memory allocated for the histories of the entity */
+	std::size_t getMemoryUsage(la::avdecc::UniqueIdentifier const entityID) const noexcept;
+
+	/** Displays the history of the counter on the item: sparkline of the last hour next to the value, and deltas in the tooltip */
+	void updateItem(QTreeWidgetItem& item, Key const& key) const noexcept;
+
+	/** Displays again the histories of the visible children of the item previously displayed by updateItem (to be called on historiesAged) */
+	void updateItems(QTreeWidgetItem& parent) const noexcept;
+
+	Q_SIGNAL void historiesAged();
+
+	// Deleted compiler auto-generated methods
+	CounterHistoryStore(CounterHistoryStore const&) = delete;
+	CounterHistoryStore(CounterHistoryStore&&) = delete;
+	CounterHistoryStore& operator=(CounterHistoryStore const&) = delete;
+	CounterHistoryStore& operator=(CounterHistoryStore&&) = delete;
+
+private:
+	struct EntityHistories
+	{
+		std::unordered_map<Key, CounterHistory, Key::hash> counters{};
+		std::size_t memoryUsage{ 0u };
+	};
+
+	CounterHistoryStore() noexcept;
+
+	void update(Key const& key, std::uint64_t const value) noexcept;
+
+	template<typename Counters>
+	void updateCounters(la::avdecc::UniqueIdentifier const entityID, CounterKind const kind, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, Counters const& counters) noexcept;
+
+	std::chrono::steady_clock::time_point const _startTime{ std::chrono::steady_clock::now() };
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntityHistories, la::avdecc::UniqueIdentifier::hash> _entities{};
+	QTimer _agingTimer{};
+};
+
+Q_DECLARE_METATYPE(CounterHistoryStore::Key)
@@ -18,6 +18,7 @@
 */
 
 #include "entityCountersTreeWidgetItem.hpp"
+#include "counterHistoryStore.hpp"
 
 #include <QMenu>
 
@@ -54,6 +55,13 @@ EntityCountersTreeWidgetItem::EntityCountersTreeWidgetItem(la::avdecc::UniqueIde
 		_counters[flag] = widget;
 	}
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update counters right now
 	updateCounters(counters);
 
@@ -79,6 +87,8 @@ void EntityCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::Ent
 			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
 			widget->setText(1, QString::number(counterKV.second));
 			widget->setHidden(false);
+
+			CounterHistoryStore::getInstance().updateItem(*widget, { _entityID, CounterHistoryStore::CounterKind::Entity, 0u, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(counterFlag)) });
 		}
 	}
 }
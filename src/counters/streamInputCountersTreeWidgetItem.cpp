@@ -18,6 +18,7 @@
 */
 
 #include "streamInputCountersTreeWidgetItem.hpp"
+#include "counterHistoryStore.hpp"
 
 #include <QtMate/material/color.hpp>
 
@@ -72,6 +73,13 @@ StreamInputCountersTreeWidgetItem::StreamInputCountersTreeWidgetItem(la::avdecc:
 		_counterWidgets[flag] = widget;
 	}
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update counters right now
 	auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
 	_errorCounters = manager.getStreamInputErrorCounters(_entityID, _streamIndex);
@@ -134,6 +142,8 @@ void StreamInputCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model
 
 			widget->setText(1, text);
 			widget->setHidden(false);
+
+			CounterHistoryStore::getInstance().updateItem(*widget, { _entityID, CounterHistoryStore::CounterKind::StreamInput, _streamIndex, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag)) });
 		}
 	}
 
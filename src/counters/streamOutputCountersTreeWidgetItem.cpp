@@ -18,6 +18,7 @@
 */
 
 #include "streamOutputCountersTreeWidgetItem.hpp"
+#include "counterHistoryStore.hpp"
 
 #include <map>
 #include <type_traits>
@@ -56,6 +57,8 @@ void StreamOutputCountersTreeWidgetItem::updateCounters(CountersType const& coun
 			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
 			widget->setText(1, QString::number(value));
 			widget->setHidden(false);
+
+			CounterHistoryStore::getInstance().updateItem(*widget, { _entityID, CounterHistoryStore::CounterKind::StreamOutput, _streamIndex, static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag)) });
 		}
 	}
 }
@@ -145,6 +148,13 @@ StreamOutputCountersTreeWidgetItem::StreamOutputCountersTreeWidgetItem(la::avdec
 		// Exception, don't create anything
 	}
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update counters right now
 	updateCounters(counters);
 
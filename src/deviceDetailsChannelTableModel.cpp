@@ -164,7 +164,7 @@ public:
 	QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 	Qt::ItemFlags flags(QModelIndex const& index) const;
 
-	void addNode(std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation);
+	void addNode(std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation);
 	void removeAllNodes();
 	QMap<la::avdecc::entity::model::DescriptorIndex, QMap<DeviceDetailsChannelTableModelColumn, QVariant>*> getChanges() const;
 	void resetChangedData();
@@ -173,6 +173,7 @@ public:
 
 	void channelConnectionsUpdate(la::avdecc::UniqueIdentifier const& entityId);
 	void channelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> channels);
+	void updateConnectionInformation(int const row, std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation);
 	void updateAudioClusterName(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& audioClusterName);
 
 private:
@@ -207,7 +208,7 @@ DeviceDetailsChannelTableModelPrivate::~DeviceDetailsChannelTableModelPrivate()
 * Adds a node to the table model. Doesn't check for duplicates or correct order.
 * @param audioClusterNode The node to add to this model.
 */
-void DeviceDetailsChannelTableModelPrivate::addNode(std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation)
+void DeviceDetailsChannelTableModelPrivate::addNode(std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation)
 {
 	Q_Q(DeviceDetailsChannelTableModel);
 
@@ -261,46 +262,31 @@ void DeviceDetailsChannelTableModelPrivate::resetChangedData()
 */
 void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(la::avdecc::UniqueIdentifier const& entityId)
 {
-	Q_Q(DeviceDetailsChannelTableModel);
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 	auto row = 0;
-	auto updateModel = false;
 	for (auto& node : _nodes)
 	{
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 		if (node.connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
 		{
-			// update the node connection information (forward)
-			node.connectionInformation = channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-			updateModel = true;
+			// update the node connection information (forward, cached by the manager)
+			updateConnectionInformation(row, channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo));
 		}
 		else
 		{
 			// if either the connectionInfo source or one of the targets is the entity that the call refers to...
 			if (node.connectionInformation->sourceEntityId == entityId
 					|| std::find_if(node.connectionInformation->targets.begin(), node.connectionInformation->targets.end(),
-							 [entityId](std::shared_ptr<avdecc::TargetConnectionInformation>& targetInfo)
+							 [entityId](auto const& targetInfo)
 							 {
 								 return (targetInfo->targetEntityId == entityId);
 							 })
 							 != node.connectionInformation->targets.end())
 			{
 				// ...update the node connection information (reverse)
-				node.connectionInformation = channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-				updateModel = true;
+				updateConnectionInformation(row, channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo));
 			}
 		}
 
-		if (updateModel)
-		{
-			// trigger updating the model
-			auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-			if (indexConnection.isValid())
-				q->dataChanged(indexConnection, indexConnection, { Qt::DisplayRole });
-			auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-			if (indexConnectionStatus.isValid())
-				q->dataChanged(indexConnectionStatus, indexConnectionStatus, { Qt::DisplayRole });
-		}
-
 		row++;
 	}
 }
@@ -310,44 +296,52 @@ void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(la::avdecc:
 */
 void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> channels)
 {
-	Q_Q(DeviceDetailsChannelTableModel);
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 	auto row = 0;
-	auto updateModel = false;
 	for (auto& node : _nodes)
 	{
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 		if (node.connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
 		{
-			// in the case of the talker we can't know which channels have to be updated without getting the changes from the ChannelConnectionManager
-			// therefor all talkers are updated for now. To improve on this talker connections would need to be cached in the ChannelConnectionManager like the listenerChannelConnections are cached.
-			node.connectionInformation = channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-			updateModel = true;
+			// talker connections are cached by the manager, only the changed ones are different objects
+			updateConnectionInformation(row, channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo));
 		}
 		else
 		{
 			if (channels.find(std::make_pair(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo)) != channels.end())
 			{
 				// update the node connection information (reverse)
-				node.connectionInformation = channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-				updateModel = true;
+				updateConnectionInformation(row, channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo));
 			}
 		}
 
-		if (updateModel)
-		{
-			// trigger updating the model
-			auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-			if (indexConnection.isValid())
-				q->dataChanged(indexConnection, indexConnection, { Qt::DisplayRole });
-			auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-			if (indexConnectionStatus.isValid())
-				q->dataChanged(indexConnectionStatus, indexConnectionStatus, { Qt::DisplayRole });
-		}
-
 		row++;
 	}
 }
 
+/**
+* Sets the channel connection data of a row, and updates the view.
+* The connection column is only updated if the connections changed (the manager returns the same object otherwise),
+* the status column is always updated as it also depends on the state of the streams.
+*/
+void DeviceDetailsChannelTableModelPrivate::updateConnectionInformation(int const row, std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation)
+{
+	Q_Q(DeviceDetailsChannelTableModel);
+	auto& node = _nodes.at(row);
+	// compare by value, an invalidated cached result is a new object with possibly the same connections
+	auto const isChanged = !node.connectionInformation || !connectionInformation || !node.connectionInformation->isEqualTo(*connectionInformation);
+	node.connectionInformation = connectionInformation;
+	if (isChanged)
+	{
+		auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
+		if (indexConnection.isValid())
+			q->dataChanged(indexConnection, indexConnection, { Qt::DisplayRole });
+	}
+
+	auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
+	if (indexConnectionStatus.isValid())
+		q->dataChanged(indexConnectionStatus, indexConnectionStatus, { Qt::DisplayRole });
+}
+
 /**
 * Update an audio cluster name.
 */
@@ -795,7 +789,7 @@ Qt::ItemFlags DeviceDetailsChannelTableModel::flags(QModelIndex const& index) co
 * Adds a node to the table.
 * @param audioClusterNode: The audio cluster node to display.
 */
-void DeviceDetailsChannelTableModel::addNode(std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation)
+void DeviceDetailsChannelTableModel::addNode(std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation)
 {
 	Q_D(DeviceDetailsChannelTableModel);
 	return d->addNode(connectionInformation);
@@ -61,12 +61,12 @@ struct TableRowEntry
 	/**
 	* Constructor.
 	*/
-	TableRowEntry(std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation)
+	TableRowEntry(std::shared_ptr<avdecc::TargetConnectionInformations const> connectionInformation)
 	{
 		this->connectionInformation = connectionInformation;
 	}
 
-	std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation;
+	std::shared_ptr<avdecc::TargetConnectionInformations const> connectionInformation;
 };
 
 //**************************************************************
@@ -144,7 +144,7 @@ public:
 	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 	virtual Qt::ItemFlags flags(QModelIndex const& index) const override;
 
-	void addNode(std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation);
+	void addNode(std::shared_ptr<avdecc::TargetConnectionInformations const> const& connectionInformation);
 	QMap<la::avdecc::entity::model::DescriptorIndex, QMap<DeviceDetailsChannelTableModelColumn, QVariant>*> getChanges() const;
 	void resetChangedData();
 	void removeAllNodes();
@@ -156,6 +156,14 @@ public:
 
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &DeviceDetailsDialogImpl::entityOnline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &DeviceDetailsDialogImpl::entityOffline);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+			[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+			{
+				for (auto const& entityID : entityIDs)
+				{
+					entityOnline(entityID, {});
+				}
+			});
 		connect(&manager, &hive::modelsLibrary::ControllerManager::endAecpCommand, this, &DeviceDetailsDialogImpl::onEndAecpCommand);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::gptpChanged, this, &DeviceDetailsDialogImpl::gptpChanged);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::streamRunningChanged, this, &DeviceDetailsDialogImpl::streamRunningChanged);
@@ -334,38 +342,26 @@ public:
 				// get the 'media clock master' entity to be able to access its sampling rate
 				auto& clockConnectionManager = avdecc::mediaClock::MCDomainManager::getInstance();
 				auto const& mediaClockMaster = clockConnectionManager.getMediaClockMaster(_entityID);
-				auto controlledEntity = hive::modelsLibrary::ControllerManager::getInstance().getControlledEntity(mediaClockMaster.first);
+				auto const mediaClockMasterSnapshot = hive::modelsLibrary::ControllerManager::getInstance().getEntitySnapshot(mediaClockMaster.first);
 
-				if (controlledEntity)
+				if (mediaClockMasterSnapshot)
 				{
-					try
-					{
-						// create a streamformatinfo to then derive the samplingrate for comparison purposes
-						auto const& streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormatData.streamFormat);
-						if (la::avdecc::entity::model::StreamFormatInfo::Type::ClockReference == streamFormatInfo->getType())
-							continue;
-
-						auto& audioUnitDynModel = controlledEntity->getAudioUnitNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, 0).dynamicModel;
-						if (streamFormatInfo)
-						{
-							// get the streamformat's corresponding sampling rate by first deriving the pull and base freq vals from streamformatinfo
-							auto const& streamFormatSampleRate = streamFormatInfo->getSamplingRate();
-
-							// get the 'media clock domain' sampling rate from the 'media clock master's entities audioUnit
-							auto const& mediaClockMasterSampleRate = audioUnitDynModel.currentSamplingRate;
-
-							// if the 'media clock master' audioUnit SR and the streamFormat SR do not match, we have found a conflict that the user needs to be warned about
-							hasSampleRateConflict = (mediaClockMasterSampleRate != streamFormatSampleRate);
-						}
-					}
-					catch (la::avdecc::controller::ControlledEntity::Exception const&)
-					{
-						// Ignore exception
-					}
-					catch (...)
+					// create a streamformatinfo to then derive the samplingrate for comparison purposes
+					auto const& streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormatData.streamFormat);
+					if (la::avdecc::entity::model::StreamFormatInfo::Type::ClockReference == streamFormatInfo->getType())
+						continue;
+
+					auto const& samplingRates = mediaClockMasterSnapshot->clocks->samplingRates;
+					if (auto const samplingRateIt = samplingRates.find(la::avdecc::entity::model::AudioUnitIndex{ 0u }); streamFormatInfo && samplingRateIt != samplingRates.end())
 					{
-						// Uncaught exception
-						AVDECC_ASSERT(false, "Uncaught exception");
+						// get the streamformat's corresponding sampling rate by first deriving the pull and base freq vals from streamformatinfo
+						auto const& streamFormatSampleRate = streamFormatInfo->getSamplingRate();
+
+						// get the 'media clock domain' sampling rate from the 'media clock master's entities audioUnit
+						auto const& mediaClockMasterSampleRate = samplingRateIt->second;
+
+						// if the 'media clock master' audioUnit SR and the streamFormat SR do not match, we have found a conflict that the user needs to be warned about
+						hasSampleRateConflict = (mediaClockMasterSampleRate != streamFormatSampleRate);
 					}
 				}
 
@@ -62,6 +62,14 @@ EntityInspector::EntityInspector(QWidget* parent)
 	connect(&controllerManager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &EntityInspector::controllerOffline);
 	connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &EntityInspector::entityOnline);
 	connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &EntityInspector::entityOffline);
+	connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+		[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+		{
+			for (auto const& entityID : entityIDs)
+			{
+				entityOnline(entityID);
+			}
+		});
 	connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityNameChanged, this, &EntityInspector::entityNameChanged);
 	connect(&_settingsSignaler, &SettingsSignaler::themeColorNameChanged, &_itemDelegate, &ControlledEntityTreeWidgetItemDelegate::setThemeColorName);
 
@@ -19,6 +19,7 @@
 
 #include "loggerView.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/logJournalModel.hpp"
 
 #include <QScrollBar>
 #include <QFileDialog>
@@ -26,6 +27,12 @@
 #include <QShortcut>
 #include <QMessageBox>
 #include <QDateTime>
+#include <QCoreApplication>
+#include <QDialog>
+#include <QHeaderView>
+#include <QProgressDialog>
+#include <QTableView>
+#include <QVBoxLayout>
 
 class AutoScrollBar : public QScrollBar
 {
@@ -105,10 +112,7 @@ LoggerView::LoggerView(QWidget* parent)
 	tableView->setColumnWidth(1, 120);
 	tableView->setColumnWidth(2, 90);
 
-	_layerFilterProxyModel.setSourceModel(&_loggerModel);
-	_levelFilterProxyModel.setSourceModel(&_layerFilterProxyModel);
-	_searchFilterProxyModel.setSourceModel(&_levelFilterProxyModel);
-	tableView->setModel(&_searchFilterProxyModel);
+	tableView->setModel(&_filterModel);
 
 	connect(actionClear, &QAction::triggered, this,
 		[this]
@@ -123,8 +127,8 @@ LoggerView::LoggerView(QWidget* parent)
 		[this]()
 		{
 			auto search = QRegularExpression{ searchLineEdit->text() };
-			auto level = _levelFilterProxyModel.filterRegularExpression();
-			auto layer = _layerFilterProxyModel.filterRegularExpression();
+			auto level = levelFilterExpression();
+			auto layer = layerFilterExpression();
 
 			// Check if a filter is applied
 			if (!search.pattern().isEmpty() || !level.pattern().isEmpty() || !layer.pattern().isEmpty())
@@ -140,17 +144,63 @@ LoggerView::LoggerView(QWidget* parent)
 			auto const filename = QFileDialog::getSaveFileName(this, "Save As...", QString("%1/%2_%3.log").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(qAppName()).arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss")), "*.log");
 			if (!filename.isEmpty())
 			{
-				_loggerModel.save(filename, { search, level, layer });
+				// Saved from the session journal (possibly large and still being written), keep the UI responsive and allow the save to be cancelled
+				auto progressDialog = QProgressDialog{ "Saving log...", "Cancel", 0, 0, this };
+				progressDialog.setMinimumWidth(350);
+				progressDialog.setWindowModality(Qt::WindowModal);
+				progressDialog.setMinimumDuration(500);
+				_loggerModel.save(filename, { search, level, layer },
+					[&progressDialog](std::size_t const savedCount, std::size_t const totalCount)
+					{
+						progressDialog.setMaximum(static_cast<int>(totalCount));
+						progressDialog.setValue(static_cast<int>(savedCount));
+						QCoreApplication::processEvents();
+						return !progressDialog.wasCanceled();
+					});
+			}
+		});
+
+	connect(actionHistory, &QAction::triggered, this,
+		[this]()
+		{
+			// Browse all the entries of the session, from the journal (memory mapped segments, not limited to the entries kept in memory)
+			auto* dialog = new QDialog{ this };
+			dialog->setAttribute(Qt::WA_DeleteOnClose);
+			if (_loggerModel.hasJournalFailed())
+			{
+				dialog->setWindowTitle("Session Log History (incomplete, failed to write to disk)");
+			}
+			else if (auto const droppedCount = _loggerModel.journalDroppedCount(); droppedCount != 0u)
+			{
+				dialog->setWindowTitle(QString("Session Log History (incomplete, %1 entries dropped while writing to disk)").arg(droppedCount));
+			}
+			else
+			{
+				dialog->setWindowTitle("Session Log History");
 			}
+			dialog->resize(1000, 600);
+
+			auto* layout = new QVBoxLayout{ dialog };
+			layout->setContentsMargins(0, 0, 0, 0);
+			auto* historyView = new QTableView{ dialog };
+			layout->addWidget(historyView);
+
+			historyView->setModel(new avdecc::LogJournalModel{ _loggerModel.journalSegments(), dialog });
+			historyView->setSelectionBehavior(QAbstractItemView::SelectRows);
+			historyView->setSelectionMode(QAbstractItemView::SingleSelection);
+			historyView->horizontalHeader()->setStretchLastSection(true);
+			historyView->setColumnWidth(0, 160);
+			historyView->setColumnWidth(1, 120);
+			historyView->setColumnWidth(2, 90);
+			historyView->scrollToBottom();
+
+			dialog->show();
 		});
 
 	connect(actionSearch, &QAction::triggered, this,
 		[this]()
 		{
-			auto const pattern = searchLineEdit->text();
-			_searchFilterProxyModel.setFilterKeyColumn(3);
-			_searchFilterProxyModel.setFilterRegularExpression(pattern);
-			_searchFilterProxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
+			_filterModel.setSearchPattern(searchLineEdit->text());
 
 			// Invoke view scroll in main thread (Queued, to be sure the view has been updated before calling scrollTo)
 			QMetaObject::invokeMethod(this,
@@ -187,11 +237,12 @@ qtMate::widgets::DynamicHeaderView* LoggerView::header() const
 
 void LoggerView::createLayerFilterButton()
 {
-	for (auto const& layer : loggerLayers)
+	for (auto index = 0u; index < loggerLayers.size(); ++index)
 	{
-		auto* action = _layerFilterMenu.addAction(avdecc::helper::loggerLayerToString(layer));
+		auto* action = _layerFilterMenu.addAction(avdecc::helper::loggerLayerToString(loggerLayers[index]));
 		action->setCheckable(true);
 		action->setChecked(true);
+		action->setData(index);
 	}
 
 	_layerFilterMenu.addSeparator();
@@ -218,35 +269,36 @@ void LoggerView::createLayerFilterButton()
 				}
 			}
 
-			QStringList layerList;
+			auto layers = std::vector<la::avdecc::logger::Layer>{};
+			auto allChecked = true;
 			for (auto* a : _layerFilterMenu.actions())
 			{
-				if (a->isCheckable() && a->isChecked())
+				if (a->isCheckable())
 				{
-					layerList << a->text();
+					if (a->isChecked())
+					{
+						layers.push_back(loggerLayers[a->data().toUInt()]);
+					}
+					else
+					{
+						allChecked = false;
+					}
 				}
 			}
 
-			if (layerList.empty())
-			{
-				// Invalid filter
-				layerList << "---";
-			}
-
 			// Update the filter
-			_layerFilterProxyModel.setFilterKeyColumn(1);
-			_layerFilterProxyModel.setFilterRegularExpression(layerList.join('|'));
-			_layerFilterProxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
+			_filterModel.setLayers(allChecked ? std::nullopt : std::make_optional(layers));
 		});
 }
 
 void LoggerView::createLevelFilterButton()
 {
-	for (auto const& level : loggerLevels)
+	for (auto index = 0u; index < loggerLevels.size(); ++index)
 	{
-		auto* action = _levelFilterMenu.addAction(avdecc::helper::loggerLevelToString(level));
+		auto* action = _levelFilterMenu.addAction(avdecc::helper::loggerLevelToString(loggerLevels[index]));
 		action->setCheckable(true);
 		action->setChecked(true);
+		action->setData(index);
 	}
 
 	_levelFilterMenu.addSeparator();
@@ -273,24 +325,61 @@ void LoggerView::createLevelFilterButton()
 				}
 			}
 
-			QStringList levelList;
+			auto levels = std::vector<la::avdecc::logger::Level>{};
+			auto allChecked = true;
 			for (auto* a : _levelFilterMenu.actions())
 			{
-				if (a->isCheckable() && a->isChecked())
+				if (a->isCheckable())
 				{
-					levelList << a->text();
+					if (a->isChecked())
+					{
+						levels.push_back(loggerLevels[a->data().toUInt()]);
+					}
+					else
+					{
+						allChecked = false;
+					}
 				}
 			}
 
-			if (levelList.empty())
+			// Update the filter
+			_filterModel.setLevels(allChecked ? std::nullopt : std::make_optional(levels));
+		});
+}
+
+// Returns the expression matching the names of the checked actions of a filter menu (empty if all are checked)
+static QRegularExpression filterMenuExpression(QMenu const& menu)
+{
+	auto names = QStringList{};
+	auto allChecked = true;
+	for (auto* a : menu.actions())
+	{
+		if (a->isCheckable())
+		{
+			if (a->isChecked())
 			{
-				// Invalid filter
-				levelList << "---";
+				names << QRegularExpression::escape(a->text());
 			}
+			else
+			{
+				allChecked = false;
+			}
+		}
+	}
 
-			// Update the filter
-			_levelFilterProxyModel.setFilterKeyColumn(2);
-			_levelFilterProxyModel.setFilterRegularExpression(levelList.join('|'));
-			_levelFilterProxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
-		});
+	if (allChecked)
+	{
+		return {};
+	}
+	return QRegularExpression{ QString{ "^(%1)$" }.arg(names.join('|')) };
+}
+
+QRegularExpression LoggerView::layerFilterExpression() const
+{
+	return filterMenuExpression(_layerFilterMenu);
+}
+
+QRegularExpression LoggerView::levelFilterExpression() const
+{
+	return filterMenuExpression(_levelFilterMenu);
 }
@@ -21,12 +21,11 @@
 
 #include "ui_loggerView.h"
 #include "avdecc/loggerModel.hpp"
+#include "avdecc/loggerFilterModel.hpp"
 
 #include <QtMate/widgets/dynamicHeaderView.hpp>
 #include <QtMate/widgets/tickableMenu.hpp>
 
-#include <QSortFilterProxyModel>
-
 class LoggerView : public QWidget, private Ui::LoggerView
 {
 	Q_OBJECT
@@ -37,12 +36,12 @@ public:
 private:
 	void createLayerFilterButton();
 	void createLevelFilterButton();
+	QRegularExpression layerFilterExpression() const;
+	QRegularExpression levelFilterExpression() const;
 
 private:
 	avdecc::LoggerModel _loggerModel{ this };
-	QSortFilterProxyModel _layerFilterProxyModel{ this };
-	QSortFilterProxyModel _levelFilterProxyModel{ this };
-	QSortFilterProxyModel _searchFilterProxyModel{ this };
+	avdecc::LoggerFilterModel _filterModel{ &_loggerModel, this };
 	qtMate::widgets::DynamicHeaderView _dynamicHeaderView{ Qt::Horizontal, this };
 	qtMate::widgets::TickableMenu _layerFilterMenu{ this };
 	qtMate::widgets::TickableMenu _levelFilterMenu{ this };
@@ -318,6 +318,7 @@ int main(int argc, char* argv[])
 	settings.registerSetting(settings::Controller_FastEnumerationEnabled);
 	settings.registerSetting(settings::Controller_FullStaticModelEnabled);
 	settings.registerSetting(settings::Controller_AdvertisingEnabled);
+	settings.registerSetting(settings::Controller_NotificationsCoalescingInterval);
 	settings.registerSetting(settings::Controller_ControllerSubID);
 
 	// Check settings version
@@ -43,7 +43,9 @@
 #include "avdecc/helper.hpp"
 #include "avdecc/hiveLogItems.hpp"
 #include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "avdecc/mcDomainManager.hpp"
+#include "counters/counterHistoryStore.hpp"
 #include "mediaClock/mediaClockManagementDialog.hpp"
 #include "newsFeed/newsFeed.hpp"
 #include "internals/config.hpp"
@@ -173,6 +175,7 @@ public:
 	qtMate::widgets::FlatIconButton _openMultiFirmwareUpdateDialogButton{ "Hive", "firmware_upload", _parent };
 	qtMate::widgets::FlatIconButton _openSettingsButton{ "Hive", "settings", _parent };
 	QLabel _controllerEntityIDLabel{ _parent };
+	QLabel _notificationsStatisticsLabel{ _parent };
 	std::uint16_t _controllerSubID{ DEFAULT_SUB_ID };
 	std::optional<std::uint32_t> _advertisingDuration{ 10u };
 	bool _shown{ false };
@@ -193,6 +196,9 @@ void MainWindowImpl::setupAdvancedView(hive::VisibilityDefaults const& defaults)
 	// Create toolbars
 	createToolbars();
 
+	// Notifications dispatch statistics
+	statusbar->addPermanentWidget(&_notificationsStatisticsLabel);
+
 	// Setup the ControllerView widget
 	discoveredEntitiesView->setupView(defaults, _mustResetViewSettings);
 
@@ -220,6 +226,9 @@ void MainWindowImpl::setupAdvancedView(hive::VisibilityDefaults const& defaults)
 
 	// Create channel connection manager instance
 	avdecc::ChannelConnectionManager::getInstance();
+
+	// Start recording the counters history, before any entity inspector is opened
+	CounterHistoryStore::getInstance();
 }
 
 void MainWindowImpl::setupMatrixProfile()
@@ -333,12 +342,6 @@ void MainWindowImpl::loadFile(QString const& fileName, bool const silent)
 		return std::make_tuple(error, getErrorString(error, message));
 	};
 
-	auto const loadNetworkState = [&manager, &getErrorString](auto const& filePath, auto const flags)
-	{
-		auto const [error, message] = manager.loadVirtualEntitiesFromJsonNetworkState(filePath, flags);
-		return std::make_tuple(error, getErrorString(error, message));
-	};
-
 	auto const fi = QFileInfo{ fileName };
 	auto const ext = fi.suffix();
 
@@ -389,18 +392,23 @@ void MainWindowImpl::loadFile(QString const& fileName, bool const silent)
 	{
 		auto flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDiagnostics };
 		flags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
-		auto [error, message] = loadNetworkState(fileName, flags);
-		if (!!error)
-		{
-			if (silent)
+		// Network states can be large, load them in the background
+		manager.loadVirtualEntitiesFromJsonNetworkStateAsync(fileName, flags,
+			[this, fileName, silent, getErrorString](la::avdecc::jsonSerializer::DeserializationError const error, std::string const& message)
 			{
-				LOG_HIVE_WARN(QString("[%1] Error loading file: %2").arg(fileName).arg(message));
-			}
-			else
-			{
-				QMessageBox::warning(_parent, "Failed to load Network State", QString("Error loading JSON file '%1':\n%2").arg(fileName).arg(message));
-			}
-		}
+				if (!!error)
+				{
+					auto const errorString = getErrorString(error, message);
+					if (silent)
+					{
+						LOG_HIVE_WARN(QString("[%1] Error loading file: %2").arg(fileName).arg(errorString));
+					}
+					else
+					{
+						QMessageBox::warning(_parent, "Failed to load Network State", QString("Error loading JSON file '%1':\n%2").arg(fileName).arg(errorString));
+					}
+				}
+			});
 	}
 
 	// Any kind of file, we have to autodetect
@@ -431,7 +439,7 @@ void MainWindowImpl::loadFile(QString const& fileName, bool const silent)
 			else
 			{
 				// Then try ANS file type
-				loadNetworkState(fileName, flags);
+				manager.loadVirtualEntitiesFromJsonNetworkStateAsync(fileName, flags, {});
 			}
 		}
 	}
@@ -742,6 +750,7 @@ void MainWindowImpl::loadSettings()
 	settings->registerSettingObserver(settings::Controller_FastEnumerationEnabled.name, this);
 	settings->registerSettingObserver(settings::Controller_FullStaticModelEnabled.name, this);
 	settings->registerSettingObserver(settings::Controller_AdvertisingEnabled.name, this);
+	settings->registerSettingObserver(settings::Controller_NotificationsCoalescingInterval.name, this);
 	settings->registerSettingObserver(settings::Controller_ControllerSubID.name, this);
 	settings->registerSettingObserver(settings::ConnectionMatrix_ChannelMode.name, this);
 	settings->registerSettingObserver(settings::General_ThemeColorIndex.name, this);
@@ -768,6 +777,12 @@ void MainWindowImpl::connectSignals()
 
 	connect(&_openSettingsButton, &QPushButton::clicked, actionSettings, &QAction::trigger);
 
+	connect(&avdecc::ControllerManagerSubscriptions::getInstance(), &avdecc::ControllerManagerSubscriptions::statisticsUpdated, this,
+		[this](std::uint64_t const invokedPerSecond, std::uint64_t const avoidedPerSecond)
+		{
+			_notificationsStatisticsLabel.setText(QString{ "Notifications: %1/s dispatched, %2/s avoided" }.arg(invokedPerSecond).arg(avoidedPerSecond));
+		});
+
 	connect(actionChannelModeRouting, &QAction::toggled, this,
 		[this](bool checked)
 		{
@@ -820,6 +835,7 @@ void MainWindowImpl::connectSignals()
 		});
 
 	connect(discoveredEntitiesView->entitiesTableView(), &discoveredEntities::View::selectedControlledEntityChanged, entityInspector, &EntityInspector::setControlledEntityID);
+	connect(discoveredEntitiesView->entitiesTableView(), &discoveredEntities::View::selectedControlledEntityChanged, &hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::setCountersPollingFocus);
 
 	connect(discoveredEntitiesView, &DiscoveredEntitiesView::filterChanged, routingTableView,
 		[this](QString const& filter)
@@ -917,7 +933,27 @@ void MainWindowImpl::connectSignals()
 			if (!filename.isEmpty())
 			{
 				auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
-				auto [error, message] = manager.serializeAllControlledEntitiesAsJson(filename, flags, avdecc::helper::generateDumpSourceString(hive::internals::applicationShortName, hive::internals::versionString));
+
+				// Entities are serialized in the background, keep the UI responsive and allow the export to be cancelled
+				auto progressDialog = QProgressDialog{ "Exporting network state...", "Cancel", 0, 0, _parent };
+				progressDialog.setMinimumWidth(350);
+				progressDialog.setWindowModality(Qt::WindowModal);
+				progressDialog.setMinimumDuration(500);
+				auto [error, message] = manager.serializeAllControlledEntitiesAsJsonStreamed(filename, flags, avdecc::helper::generateDumpSourceString(hive::internals::applicationShortName, hive::internals::versionString),
+					[&progressDialog](std::size_t const serializedCount, std::size_t const totalCount)
+					{
+						progressDialog.setMaximum(static_cast<int>(totalCount));
+						progressDialog.setValue(static_cast<int>(serializedCount));
+						QCoreApplication::processEvents();
+						return !progressDialog.wasCanceled();
+					});
+				if (progressDialog.wasCanceled())
+				{
+					// Export cancelled by the user, the file has been removed
+					return;
+				}
+				progressDialog.reset();
+
 				if (!error)
 				{
 					QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
@@ -1325,6 +1361,7 @@ void MainWindow::closeEvent(QCloseEvent* event)
 	settings->unregisterSettingObserver(settings::Controller_FastEnumerationEnabled.name, _pImpl);
 	settings->unregisterSettingObserver(settings::Controller_FullStaticModelEnabled.name, _pImpl);
 	settings->unregisterSettingObserver(settings::Controller_AdvertisingEnabled.name, _pImpl);
+	settings->unregisterSettingObserver(settings::Controller_NotificationsCoalescingInterval.name, _pImpl);
 	settings->unregisterSettingObserver(settings::Controller_ControllerSubID.name, _pImpl);
 	settings->unregisterSettingObserver(settings::ConnectionMatrix_ChannelMode.name, _pImpl);
 	settings->unregisterSettingObserver(settings::General_ThemeColorIndex.name, _pImpl);
@@ -1458,6 +1495,12 @@ void MainWindowImpl::onSettingChanged(settings::SettingsManager::Setting const&
 			currentControllerChanged();
 		}
 	}
+	else if (name == settings::Controller_NotificationsCoalescingInterval.name)
+	{
+		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+		auto const interval = std::chrono::milliseconds{ value.toInt() };
+		manager.setNotificationsCoalescingInterval(interval);
+	}
 	else if (name == settings::Controller_AdvertisingEnabled.name)
 	{
 		auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
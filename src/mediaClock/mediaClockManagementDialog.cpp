@@ -36,6 +36,7 @@
 #include <QMessageBox>
 #include <QProgressDialog>
 
+#include <unordered_map>
 #include <unordered_set>
 
 class MediaClockManagementDialogImpl final : private Ui::MediaClockManagementDialog, public QObject
@@ -59,6 +60,8 @@ public:
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::mediaClockConnectionsUpdate, this, &MediaClockManagementDialogImpl::mediaClockConnectionsUpdate);
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelFinished, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelFinished);
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelProgressUpdate, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelProgressUpdate);
+		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelEntityProgressUpdate, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelEntityProgressUpdate);
+		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelEntityFinished, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelEntityFinished);
 
 
 		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
@@ -329,6 +332,7 @@ public:
 		_progressDialog->setMinimumWidth(350);
 		_progressDialog->setWindowModality(Qt::WindowModal);
 		_progressDialog->setMinimumDuration(500);
+		_entitiesApplyState.clear();
 		mediaClockManager.applyMediaClockDomainModel(mediaClockMappings);
 	}
 
@@ -431,6 +435,49 @@ public:
 		_progressDialog->setValue(static_cast<int>(progress));
 	}
 
+	/*
+	* Update the progress of an entity.
+	*/
+	void applyMediaClockDomainModelEntityProgressUpdate(la::avdecc::UniqueIdentifier const entityId, float_t /*progress*/)
+	{
+		// Only register the entity, its state is updated when all its commands completed
+		_entitiesApplyState.try_emplace(entityId, EntityApplyState::InProgress);
+		updateProgressLabel();
+	}
+
+	/*
+	* Update the count of configured entities, as soon as all the commands of an entity completed.
+	*/
+	void applyMediaClockDomainModelEntityFinished(la::avdecc::UniqueIdentifier const entityId, avdecc::commandChain::CommandExecutionErrors const& errors)
+	{
+		_entitiesApplyState[entityId] = errors.empty() ? EntityApplyState::Succeeded : EntityApplyState::Failed;
+		updateProgressLabel();
+	}
+
+	void updateProgressLabel()
+	{
+		auto configuredCount = 0;
+		auto failedCount = 0;
+		for (auto const& [entityId, state] : _entitiesApplyState)
+		{
+			if (state != EntityApplyState::InProgress)
+			{
+				++configuredCount;
+			}
+			if (state == EntityApplyState::Failed)
+			{
+				++failedCount;
+			}
+		}
+
+		auto text = QString("Executing commands... (%1/%2 devices done)").arg(configuredCount).arg(_entitiesApplyState.size());
+		if (failedCount != 0)
+		{
+			text += QString("\n%1 device(s) failed").arg(failedCount);
+		}
+		_progressDialog->setLabelText(text);
+	}
+
 	/*
 	* Display any error that occurs
 	*/
@@ -577,7 +624,15 @@ private:
 	UnassignedListModel _unassignedListModel;
 	bool _hasChanges;
 
+	enum class EntityApplyState
+	{
+		InProgress,
+		Succeeded,
+		Failed,
+	};
+
 	QProgressDialog* _progressDialog;
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntityApplyState, la::avdecc::UniqueIdentifier::hash> _entitiesApplyState{}; // Entities of the apply in progress
 };
 
 /**
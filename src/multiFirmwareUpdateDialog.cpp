@@ -85,6 +85,14 @@ public:
 		connect(&manager, &hive::modelsLibrary::ControllerManager::controllerOffline, this, &ModelPrivate::handleControllerOffline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOnline, this, &ModelPrivate::handleEntityOnline);
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this, &ModelPrivate::handleEntityOffline);
+		connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+			[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+			{
+				for (auto const& entityID : entityIDs)
+				{
+					handleEntityOnline(entityID);
+				}
+			});
 		connect(&manager, &hive::modelsLibrary::ControllerManager::entityNameChanged, this, &ModelPrivate::handleEntityNameChanged);
 	}
 
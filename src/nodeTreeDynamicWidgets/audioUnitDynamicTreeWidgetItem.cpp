@@ -18,6 +18,7 @@
 */
 
 #include "audioUnitDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 
 #include <QMenu>
 
@@ -48,13 +49,10 @@ AudioUnitDynamicTreeWidgetItem::AudioUnitDynamicTreeWidgetItem(la::avdecc::Uniqu
 		});
 
 	// Listen for changes
-	connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::audioUnitSamplingRateChanged, _samplingRate,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate)
+	avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::audioUnitSamplingRateChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::AudioUnit, _audioUnitIndex }, _samplingRate,
+		[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AudioUnitIndex const /*audioUnitIndex*/, la::avdecc::entity::model::SamplingRate const samplingRate)
 		{
-			if (entityID == _entityID && audioUnitIndex == _audioUnitIndex)
-			{
-				updateSamplingRate(samplingRate);
-			}
+			updateSamplingRate(samplingRate);
 		});
 
 	// Update now
@@ -18,6 +18,7 @@
 */
 
 #include "avbInterfaceDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "asPathWidget.hpp"
 #include "nodeTreeWidget.hpp"
 #include "avdecc/helper.hpp"
@@ -75,40 +76,34 @@ AvbInterfaceDynamicTreeWidgetItem::AvbInterfaceDynamicTreeWidgetItem(la::avdecc:
 			_linkStatus->setHidden(true);
 		}
 
-		// Listen for onGptpChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::gptpChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
-			{
-				if (entityID == _entityID && (avbInterfaceIndex == _avbInterfaceIndex || avbInterfaceIndex == la::avdecc::entity::Entity::GlobalAvbInterfaceIndex))
+		// Listen for onGptpChanged (for this interface and for the global interface index)
+		for (auto const interfaceIndex : { _avbInterfaceIndex, la::avdecc::entity::Entity::GlobalAvbInterfaceIndex })
+		{
+			avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::gptpChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, interfaceIndex }, this,
+				[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
 				{
 					updateGptpInfo(grandMasterID, grandMasterDomain);
-				}
-			});
+				});
+		}
 		// Listen for AvbInterfaceInfoChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::avbInterfaceInfoChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceInfo const& info)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::avbInterfaceInfoChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, _avbInterfaceIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, la::avdecc::entity::model::AvbInterfaceInfo const& info)
 			{
-				if (entityID == _entityID && avbInterfaceIndex == _avbInterfaceIndex)
+				if (_propagationDelay->isHidden())
 				{
-					if (_propagationDelay->isHidden())
-					{
-						restoreAvbInterfaceInfoVisibility();
-					}
-					updateAvbInterfaceInfo(info);
+					restoreAvbInterfaceInfoVisibility();
 				}
+				updateAvbInterfaceInfo(info);
 			});
 		// Listen for avbInterfaceLinkStatusChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::avbInterfaceLinkStatusChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const linkStatus)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::avbInterfaceLinkStatusChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, _avbInterfaceIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const linkStatus)
 			{
-				if (entityID == _entityID && avbInterfaceIndex == _avbInterfaceIndex)
+				if (_linkStatus->isHidden())
 				{
-					if (_linkStatus->isHidden())
-					{
-						restoreLinkStatusVisibility();
-					}
-					updateLinkStatus(linkStatus);
+					restoreLinkStatusVisibility();
 				}
+				updateLinkStatus(linkStatus);
 			});
 	}
 
@@ -132,17 +127,14 @@ AvbInterfaceDynamicTreeWidgetItem::AvbInterfaceDynamicTreeWidgetItem(la::avdecc:
 		}
 
 		// Listen for AsPathChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::asPathChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AsPath const& asPath)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::asPathChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, _avbInterfaceIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, la::avdecc::entity::model::AsPath const& asPath)
 			{
-				if (entityID == _entityID && avbInterfaceIndex == _avbInterfaceIndex)
+				if (_asPathItem->isHidden())
 				{
-					if (_asPathItem->isHidden())
-					{
-						restoreAsPathVisibility();
-					}
-					updateAsPath(asPath);
+					restoreAsPathVisibility();
 				}
+				updateAsPath(asPath);
 			});
 	}
 }
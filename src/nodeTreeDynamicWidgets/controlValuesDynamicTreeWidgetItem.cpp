@@ -18,6 +18,7 @@
 */
 
 #include "controlValuesDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 
 #include <QMenu>
 
@@ -29,12 +30,9 @@ ControlValuesDynamicTreeWidgetItem::ControlValuesDynamicTreeWidgetItem(la::avdec
 	, _controlIndex(controlIndex)
 {
 	// Listen for changes
-	connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::controlValuesChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ControlIndex const controlIndex, la::avdecc::entity::model::ControlValues const& controlValues)
+	avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::controlValuesChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::Control, _controlIndex }, this,
+		[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ControlIndex const /*controlIndex*/, la::avdecc::entity::model::ControlValues const& controlValues)
 		{
-			if (entityID == _entityID && controlIndex == _controlIndex)
-			{
-				updateValues(controlValues);
-			}
+			updateValues(controlValues);
 		});
 }
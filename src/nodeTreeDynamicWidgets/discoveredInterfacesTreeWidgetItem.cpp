@@ -18,6 +18,7 @@
 */
 
 #include "discoveredInterfacesTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "asPathWidget.hpp"
 #include "nodeTreeWidget.hpp"
 #include "avdecc/helper.hpp"
@@ -54,13 +55,10 @@ DiscoveredInterfaceTreeWidgetItem::DiscoveredInterfaceTreeWidgetItem(la::avdecc:
 	updateGptpInfo(interfaceInfo.gptpGrandmasterID, interfaceInfo.gptpDomainNumber);
 
 	// Listen for onGptpChanged
-	connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::gptpChanged, this,
-		[this, eid = entityID, interfaceIndex = avbInterfaceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
+	avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::gptpChanged, avdecc::DescriptorKey{ entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex }, this,
+		[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
 		{
-			if (entityID == eid && avbInterfaceIndex == interfaceIndex)
-			{
-				updateGptpInfo(grandMasterID, grandMasterDomain);
-			}
+			updateGptpInfo(grandMasterID, grandMasterDomain);
 		});
 }
 
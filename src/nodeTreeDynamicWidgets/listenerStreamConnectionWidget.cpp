@@ -18,12 +18,15 @@
 */
 
 #include "listenerStreamConnectionWidget.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 
 #include <hive/modelsLibrary/helper.hpp>
 
 #include <QMenu>
 #include <QStyle>
 
+#include <algorithm>
+
 ListenerStreamConnectionWidget::ListenerStreamConnectionWidget(la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const& info, QWidget* parent)
 	: QWidget(parent)
 	, _stream(stream)
@@ -46,16 +49,13 @@ ListenerStreamConnectionWidget::ListenerStreamConnectionWidget(la::avdecc::entit
 	auto const& manager = hive::modelsLibrary::ControllerManager::getInstance();
 
 	// Listen for Connection changed signals
-	connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::streamInputConnectionChanged, this,
-		[this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamInputConnectionInfo const& info)
+	avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamInputConnectionChanged, avdecc::DescriptorKey{ _stream.entityID, la::avdecc::entity::model::DescriptorType::StreamInput, _stream.streamIndex }, this,
+		[this](la::avdecc::entity::model::StreamIdentification const& /*stream*/, la::avdecc::entity::model::StreamInputConnectionInfo const& info)
 		{
-			if (stream == _stream)
-			{
-				// Update state
-				_info = info;
-				// Update data based on the new state
-				updateData();
-			}
+			// Update state
+			_info = info;
+			// Update data based on the new state
+			updateData();
 		});
 
 	// EntityOnline
@@ -65,6 +65,12 @@ ListenerStreamConnectionWidget::ListenerStreamConnectionWidget(la::avdecc::entit
 			if (entityID == _info.talkerStream.entityID)
 				updateData();
 		});
+	connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+		[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+		{
+			if (std::find(entityIDs.begin(), entityIDs.end(), _info.talkerStream.entityID) != entityIDs.end())
+				updateData();
+		});
 
 	// EntityOffline
 	connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this,
@@ -18,6 +18,7 @@
 */
 
 #include "memoryObjectDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 
 #include <hive/modelsLibrary/helper.hpp>
 
@@ -37,10 +38,10 @@ MemoryObjectDynamicTreeWidgetItem::MemoryObjectDynamicTreeWidgetItem(la::avdecc:
 		updateMemoryObjectLength(dynamicModel->length);
 
 		// Listen for MemoryObjectLengthChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::memoryObjectLengthChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::memoryObjectLengthChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::MemoryObject, _memoryObjectIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const /*memoryObjectIndex*/, std::uint64_t const length)
 			{
-				if (entityID == _entityID && configurationIndex == _configurationIndex && memoryObjectIndex == _memoryObjectIndex)
+				if (configurationIndex == _configurationIndex)
 				{
 					updateMemoryObjectLength(length);
 				}
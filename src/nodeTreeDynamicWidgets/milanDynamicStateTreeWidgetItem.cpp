@@ -18,6 +18,7 @@
 */
 
 #include "milanDynamicStateTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "avdecc/euiValidator.hpp"
 #include "avdecc/stringValidator.hpp"
 
@@ -55,13 +56,10 @@ MilanDynamicStateTreeWidgetItem::MilanDynamicStateTreeWidgetItem(la::avdecc::Uni
 		});
 
 	// Listen for changes
-	connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::systemUniqueIDChanged, _systemUniqueID,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::UniqueIdentifier const systemUniqueID, QString const& systemName)
+	avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::systemUniqueIDChanged, avdecc::DescriptorKey{ _entityID }, _systemUniqueID,
+		[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::UniqueIdentifier const systemUniqueID, QString const& systemName)
 		{
-			if (entityID == _entityID)
-			{
-				updateSystemUniqueID(systemUniqueID, systemName);
-			}
+			updateSystemUniqueID(systemUniqueID, systemName);
 		});
 
 	// Update now
@@ -18,6 +18,7 @@
 */
 
 #include "streamDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "streamFormatComboBox.hpp"
 #include "latencyComboBox.hpp"
 #include "talkerStreamConnectionWidget.hpp"
@@ -90,13 +91,10 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 			});
 
 		// Listen for changes
-		connect(&manager, &hive::modelsLibrary::ControllerManager::streamFormatChanged, formatComboBox,
-			[this, formatComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamFormatChanged, avdecc::DescriptorKey{ _entityID, _streamType, _streamIndex }, formatComboBox,
+			[this, formatComboBox](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamFormat const streamFormat)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					formatComboBox->setCurrentStreamFormat(streamFormat);
-				}
+				formatComboBox->setCurrentStreamFormat(streamFormat);
 			});
 
 		// Update now
@@ -135,29 +133,20 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		}
 
 		// Listen for events
-		connect(&manager, &hive::modelsLibrary::ControllerManager::streamFormatChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamFormatChanged, avdecc::DescriptorKey{ _entityID, _streamType, _streamIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamFormat const streamFormat)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamFormat(streamFormat);
-				}
+				updateStreamFormat(streamFormat);
 			});
-		connect(&manager, &hive::modelsLibrary::ControllerManager::streamRunningChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamRunningChanged, avdecc::DescriptorKey{ _entityID, _streamType, _streamIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, bool const isRunning)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamIsRunning(isRunning);
-				}
+				updateStreamIsRunning(isRunning);
 			});
-		connect(&manager, &hive::modelsLibrary::ControllerManager::streamDynamicInfoChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamDynamicInfoChanged, avdecc::DescriptorKey{ _entityID, _streamType, _streamIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamDynamicInfo const& info)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamDynamicInfo(info);
-				}
+				updateStreamDynamicInfo(info);
 			});
 	}
 
@@ -203,39 +192,33 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 				});
 
 			// Listen for changes
-			connect(&manager, &hive::modelsLibrary::ControllerManager::streamFormatChanged, latencyComboBox,
-				[this, latencyComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+			avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamFormatChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, _streamIndex }, latencyComboBox,
+				[this, latencyComboBox](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamFormat const streamFormat)
 				{
-					if (entityID == _entityID && descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput && streamIndex == _streamIndex)
-					{
-						latencyComboBox->updatePossibleLatencyValues(streamFormat);
+					latencyComboBox->updatePossibleLatencyValues(streamFormat);
 
-						auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
-						auto controlledEntity = manager.getControlledEntity(_entityID);
-						if (controlledEntity)
+					auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
+					auto controlledEntity = manager.getControlledEntity(_entityID);
+					if (controlledEntity)
+					{
+						try
 						{
-							try
-							{
-								auto const& entityNode = controlledEntity->getEntityNode();
-								auto const configurationIndex = entityNode.dynamicModel.currentConfiguration;
+							auto const& entityNode = controlledEntity->getEntityNode();
+							auto const configurationIndex = entityNode.dynamicModel.currentConfiguration;
 
-								auto const& streamOutput = controlledEntity->getStreamOutputNode(configurationIndex, _streamIndex);
-								latencyComboBox->setCurrentLatencyData(LatencyComboBox_t{ streamOutput.dynamicModel.presentationTimeOffset, LatencyComboBox::labelFromLatency(streamOutput.dynamicModel.presentationTimeOffset), std::nullopt });
-							}
-							catch (la::avdecc::controller::ControlledEntity::Exception const&)
-							{
-								// Ignore
-							}
+							auto const& streamOutput = controlledEntity->getStreamOutputNode(configurationIndex, _streamIndex);
+							latencyComboBox->setCurrentLatencyData(LatencyComboBox_t{ streamOutput.dynamicModel.presentationTimeOffset, LatencyComboBox::labelFromLatency(streamOutput.dynamicModel.presentationTimeOffset), std::nullopt });
+						}
+						catch (la::avdecc::controller::ControlledEntity::Exception const&)
+						{
+							// Ignore
 						}
 					}
 				});
-			connect(&manager, &hive::modelsLibrary::ControllerManager::maxTransitTimeChanged, latencyComboBox,
-				[this, latencyComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, std::chrono::nanoseconds const& maxTransitTime)
+			avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::maxTransitTimeChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, _streamIndex }, latencyComboBox,
+				[this, latencyComboBox](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, std::chrono::nanoseconds const& maxTransitTime)
 				{
-					if (entityID == _entityID && streamIndex == _streamIndex)
-					{
-						latencyComboBox->setCurrentLatencyData(LatencyComboBox_t{ maxTransitTime, LatencyComboBox::labelFromLatency(maxTransitTime), std::nullopt });
-					}
+					latencyComboBox->setCurrentLatencyData(LatencyComboBox_t{ maxTransitTime, LatencyComboBox::labelFromLatency(maxTransitTime), std::nullopt });
 				});
 
 			// Update now
@@ -254,13 +237,10 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		updateConnections(outputDynamicModel->connections);
 
 		// Listen for Connections changed signal
-		connect(&manager, &hive::modelsLibrary::ControllerManager::streamOutputConnectionsChanged, this,
-			[this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& connections)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamOutputConnectionsChanged, avdecc::DescriptorKey{ _entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, _streamIndex }, this,
+			[this](la::avdecc::entity::model::StreamIdentification const& /*stream*/, la::avdecc::entity::model::StreamConnections const& connections)
 			{
-				if (stream.entityID == _entityID && stream.streamIndex == _streamIndex)
-				{
-					updateConnections(connections);
-				}
+				updateConnections(connections);
 			});
 	}
 }
@@ -22,6 +22,7 @@
 #endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
 
 #include "streamPortDynamicTreeWidgetItem.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "mappingMatrix.hpp"
 #include "avdecc/mappingsHelper.hpp"
 #include <vector>
@@ -69,14 +70,11 @@ StreamPortDynamicTreeWidgetItem::StreamPortDynamicTreeWidgetItem(la::avdecc::Uni
 		parent->setItemWidget(clearMappings, 1, clearMappingsButton);
 
 		// Listen for streamPortAudioMappingsChanged
-		connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::streamPortAudioMappingsChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+		avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamPortAudioMappingsChanged, avdecc::DescriptorKey{ _entityID, _streamPortType, _streamPortIndex }, this,
+			[this](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamPortIndex const /*streamPortIndex*/)
 			{
-				if (entityID == _entityID && descriptorType == _streamPortType && streamPortIndex == _streamPortIndex)
-				{
-					// Update mappings
-					updateMappings();
-				}
+				// Update mappings
+				updateMappings();
 			});
 
 		// TODO: Listen for entity offline events and close the popup window
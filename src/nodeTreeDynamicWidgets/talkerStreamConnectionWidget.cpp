@@ -24,6 +24,8 @@
 #include <QMenu>
 #include <QStyle>
 
+#include <algorithm>
+
 TalkerStreamConnectionWidget::TalkerStreamConnectionWidget(la::avdecc::entity::model::StreamIdentification talkerConnection, la::avdecc::entity::model::StreamIdentification listenerConnection, QWidget* parent)
 	: QWidget(parent)
 	, _talkerConnection(std::move(talkerConnection))
@@ -52,6 +54,12 @@ TalkerStreamConnectionWidget::TalkerStreamConnectionWidget(la::avdecc::entity::m
 			if (entityID == _listenerConnection.entityID)
 				updateData();
 		});
+	connect(&manager, &hive::modelsLibrary::ControllerManager::entitiesOnline, this,
+		[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+		{
+			if (std::find(entityIDs.begin(), entityIDs.end(), _listenerConnection.entityID) != entityIDs.end())
+				updateData();
+		});
 
 	// EntityOffline
 	connect(&manager, &hive::modelsLibrary::ControllerManager::entityOffline, this,
@@ -23,6 +23,7 @@
 #include "avdecc/stringValidator.hpp"
 #include "avdecc/euiValidator.hpp"
 #include "avdecc/numberValidator.hpp"
+#include "avdecc/controllerManagerSubscriptions.hpp"
 #include "nodeTreeDynamicWidgets/milanDynamicStateTreeWidgetItem.hpp"
 #include "nodeTreeDynamicWidgets/audioUnitDynamicTreeWidgetItem.hpp"
 #include "nodeTreeDynamicWidgets/avbInterfaceDynamicTreeWidgetItem.hpp"
@@ -333,8 +334,17 @@ private:
 			addTextItem(descriptorItem, "Firmware Version", QString::fromStdString(dynamicModel.firmwareVersion));
 			addTextItem(descriptorItem, "Serial Number", QString::fromStdString(dynamicModel.serialNumber));
 			addTextItem(descriptorItem, "Unsol Supported", entity.areUnsolicitedNotificationsSupported() ? "Yes" : "No");
+			if (!entity.areUnsolicitedNotificationsSupported() && !entity.isVirtual())
+			{
+				auto const stats = controllerManager.getCountersPollingStatistics();
+				addTextItem(descriptorItem, "Counters Polling", QString{ "%1 polled entities, %2 polls, %3 deferred, %4 timeouts" }.arg(stats.polledEntitiesCount).arg(stats.pollsCount).arg(stats.deferredCount).arg(stats.timeoutsCount));
+			}
 			addTextItem(descriptorItem, "Fast Enum Supported", controllerManager.isFastEnumerationEnabled() ? (entity.isPackedDynamicInfoSupported() ? "Yes" : "No") : "Disabled in options");
 			addTextItem(descriptorItem, "Using Cached AEM", controllerManager.isAemCacheEnabled() ? (entity.isUsingCachedEntityModel() ? "Yes" : "No") : "Disabled in options");
+			{
+				auto const stats = controllerManager.getEntityModelCacheStatistics();
+				addTextItem(descriptorItem, "Persistent AEM Cache", controllerManager.isAemCacheEnabled() ? QString{ "%1 models, %2 hits, %3 misses, %4 invalidated" }.arg(stats.storedCount).arg(stats.hitCount).arg(stats.missCount).arg(stats.invalidatedCount) : QString{ "Disabled in options" });
+			}
 
 			addTextItem(descriptorItem, "Configuration Count", node.configurations.size());
 		}
@@ -371,7 +381,7 @@ private:
 					updateCompatibilityLabel(_controlledEntityID, entity.getCompatibilityFlags(), entity.getMilanCompatibilityVersion());
 
 					// Listen for changes
-					connect(&controllerManager, &hive::modelsLibrary::ControllerManager::compatibilityChanged, compatibilityLabel, updateCompatibilityLabel);
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::compatibilityChanged, avdecc::DescriptorKey{ _controlledEntityID }, compatibilityLabel, updateCompatibilityLabel);
 				}
 
 				auto const milanInfo = *milanInfoOpt;
@@ -429,7 +439,7 @@ private:
 				updateSubscribedLabel(_controlledEntityID, entity.isSubscribedToUnsolicitedNotifications(), false);
 
 				// Listen for changes
-				connect(&controllerManager, &hive::modelsLibrary::ControllerManager::unsolicitedRegistrationChanged, subscribedLabel, updateSubscribedLabel);
+				avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::unsolicitedRegistrationChanged, avdecc::DescriptorKey{ _controlledEntityID }, subscribedLabel, updateSubscribedLabel);
 			}
 
 			auto* currentConfigurationItem = new QTreeWidgetItem(dynamicItem);
@@ -1021,13 +1031,10 @@ private:
 					});
 
 				// Listen for changes
-				connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::clockSourceChanged, sourceComboBox,
-					[this, streamType = node.descriptorType, domainIndex = node.descriptorIndex, sourceComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const sourceIndex)
+				avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::clockSourceChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::ClockDomain, node.descriptorIndex }, sourceComboBox,
+					[sourceComboBox](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::ClockSourceIndex const sourceIndex)
 					{
-						if (entityID == _controlledEntityID && clockDomainIndex == domainIndex)
-						{
-							sourceComboBox->setCurrentData(sourceIndex);
-						}
+						sourceComboBox->setCurrentData(sourceIndex);
 					});
 
 				// Update now
@@ -1220,7 +1227,6 @@ public:
 	QTreeWidgetItem* createAccessItem(la::avdecc::controller::ControlledEntity const* const controlledEntity)
 	{
 		Q_Q(NodeTreeWidget);
-		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
 
 		auto* accessItem = new QTreeWidgetItem(q);
 		accessItem->setText(0, "Exclusive Access");
@@ -1241,7 +1247,7 @@ public:
 			updateAcquireLabel(_controlledEntityID, controlledEntity->getAcquireState(), controlledEntity->getOwningControllerID());
 
 			// Listen for changes
-			connect(&controllerManager, &hive::modelsLibrary::ControllerManager::acquireStateChanged, acquireLabel, updateAcquireLabel);
+			avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::acquireStateChanged, avdecc::DescriptorKey{ _controlledEntityID }, acquireLabel, updateAcquireLabel);
 		}
 
 		// Lock State
@@ -1259,7 +1265,7 @@ public:
 			updateLockLabel(_controlledEntityID, controlledEntity->getLockState(), controlledEntity->getLockingControllerID());
 
 			// Listen for changes
-			connect(&controllerManager, &hive::modelsLibrary::ControllerManager::lockStateChanged, lockLabel, updateLockLabel);
+			avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::lockStateChanged, avdecc::DescriptorKey{ _controlledEntityID }, lockLabel, updateLockLabel);
 		}
 
 		return accessItem;
@@ -1580,29 +1586,26 @@ public:
 			switch (commandType)
 			{
 				case hive::modelsLibrary::ControllerManager::AecpCommandType::SetEntityName:
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::entityNameChanged, textEntry,
-						[this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::entityNameChanged, avdecc::DescriptorKey{ _controlledEntityID }, textEntry,
+						[textEntry](la::avdecc::UniqueIdentifier const /*entityID*/, QString const& entityName)
 						{
-							if (entityID == _controlledEntityID)
-								textEntry->setCurrentData(entityName);
+							textEntry->setCurrentData(entityName);
 						});
 					break;
 				case hive::modelsLibrary::ControllerManager::AecpCommandType::SetEntityGroupName:
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::entityGroupNameChanged, textEntry,
-						[this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::entityGroupNameChanged, avdecc::DescriptorKey{ _controlledEntityID }, textEntry,
+						[textEntry](la::avdecc::UniqueIdentifier const /*entityID*/, QString const& entityGroupName)
 						{
-							if (entityID == _controlledEntityID)
-								textEntry->setCurrentData(entityGroupName);
+							textEntry->setCurrentData(entityGroupName);
 						});
 					break;
 				case hive::modelsLibrary::ControllerManager::AecpCommandType::SetConfigurationName:
 				{
 					auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::configurationNameChanged, textEntry,
-						[this, textEntry, configIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& configurationName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::configurationNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::Configuration, configIndex }, textEntry,
+						[textEntry](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const /*configurationIndex*/, QString const& configurationName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex)
-								textEntry->setCurrentData(configurationName);
+							textEntry->setCurrentData(configurationName);
 						});
 					break;
 				}
@@ -1611,10 +1614,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AudioUnitIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const audioUnitIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::audioUnitNameChanged, textEntry,
-						[this, textEntry, configIndex, auIndex = audioUnitIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& audioUnitName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::audioUnitNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::AudioUnit, audioUnitIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const /*audioUnitIndex*/, QString const& audioUnitName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && audioUnitIndex == auIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(audioUnitName);
 						});
 					break;
@@ -1625,10 +1628,10 @@ public:
 					auto const configIndex = std::get<0>(customTuple);
 					auto const streamType = std::get<1>(customTuple);
 					auto const streamIndex = std::get<2>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::streamNameChanged, textEntry,
-						[this, textEntry, configIndex, streamType, strIndex = streamIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& streamName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::streamNameChanged, avdecc::DescriptorKey{ _controlledEntityID, streamType, streamIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, QString const& streamName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && descriptorType == streamType && streamIndex == strIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(streamName);
 						});
 					break;
@@ -1639,10 +1642,10 @@ public:
 					auto const configIndex = std::get<0>(customTuple);
 					auto const jackType = std::get<1>(customTuple);
 					auto const jackIndex = std::get<2>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::jackNameChanged, textEntry,
-						[this, textEntry, configIndex, jackType, jkIndex = jackIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::JackIndex const jackIndex, QString const& jackName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::jackNameChanged, avdecc::DescriptorKey{ _controlledEntityID, jackType, jackIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::JackIndex const /*jackIndex*/, QString const& jackName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && descriptorType == jackType && jackIndex == jkIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(jackName);
 						});
 					break;
@@ -1652,10 +1655,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AvbInterfaceIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const avbInterfaceIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::avbInterfaceNameChanged, textEntry,
-						[this, textEntry, configIndex, aiIndex = avbInterfaceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& avbInterfaceName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::avbInterfaceNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const /*avbInterfaceIndex*/, QString const& avbInterfaceName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && avbInterfaceIndex == aiIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(avbInterfaceName);
 						});
 					break;
@@ -1665,10 +1668,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockSourceIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const clockSourceIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::clockSourceNameChanged, textEntry,
-						[this, textEntry, configIndex, csIndex = clockSourceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& clockSourceName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::clockSourceNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::ClockSource, clockSourceIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const /*clockSourceIndex*/, QString const& clockSourceName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && clockSourceIndex == csIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(clockSourceName);
 						});
 					break;
@@ -1678,10 +1681,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::MemoryObjectIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const memoryObjectIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::memoryObjectNameChanged, textEntry,
-						[this, textEntry, configIndex, moIndex = memoryObjectIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& memoryObjectName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::memoryObjectNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::MemoryObject, memoryObjectIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const /*memoryObjectIndex*/, QString const& memoryObjectName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && memoryObjectIndex == moIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(memoryObjectName);
 						});
 					break;
@@ -1691,10 +1694,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClusterIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const audioClusterIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::audioClusterNameChanged, textEntry,
-						[this, textEntry, configIndex, acIndex = audioClusterIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& audioClusterName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::audioClusterNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::AudioCluster, audioClusterIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const /*audioClusterIndex*/, QString const& audioClusterName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && audioClusterIndex == acIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(audioClusterName);
 						});
 					break;
@@ -1704,10 +1707,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ControlIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const controlIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::controlNameChanged, textEntry,
-						[this, textEntry, configIndex, cdIndex = controlIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ControlIndex const controlIndex, QString const& controlName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::controlNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::Control, controlIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ControlIndex const /*controlIndex*/, QString const& controlName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && controlIndex == cdIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(controlName);
 						});
 					break;
@@ -1717,10 +1720,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockDomainIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const clockDomainIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::clockDomainNameChanged, textEntry,
-						[this, textEntry, configIndex, cdIndex = clockDomainIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& clockDomainName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::clockDomainNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, QString const& clockDomainName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && clockDomainIndex == cdIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(clockDomainName);
 						});
 					break;
@@ -1730,10 +1733,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::TimingIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const timingIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::timingNameChanged, textEntry,
-						[this, textEntry, configIndex, tIndex = timingIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::TimingIndex const timingIndex, QString const& timingName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::timingNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::Timing, timingIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::TimingIndex const /*timingIndex*/, QString const& timingName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && timingIndex == tIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(timingName);
 						});
 					break;
@@ -1743,10 +1746,10 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::PtpInstanceIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const ptpInstanceIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::ptpInstanceNameChanged, textEntry,
-						[this, textEntry, configIndex, piIndex = ptpInstanceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::PtpInstanceIndex const ptpInstanceIndex, QString const& ptpInstanceName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::ptpInstanceNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::PtpInstance, ptpInstanceIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::PtpInstanceIndex const /*ptpInstanceIndex*/, QString const& ptpInstanceName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && ptpInstanceIndex == piIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(ptpInstanceName);
 						});
 					break;
@@ -1756,23 +1759,20 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::PtpPortIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const ptpPortIndex = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::ptpPortNameChanged, textEntry,
-						[this, textEntry, configIndex, ppIndex = ptpPortIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::PtpPortIndex const ptpPortIndex, QString const& ptpPortName)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::ptpPortNameChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::PtpPort, ptpPortIndex }, textEntry,
+						[textEntry, configIndex](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::PtpPortIndex const /*ptpPortIndex*/, QString const& ptpPortName)
 						{
-							if (entityID == _controlledEntityID && configurationIndex == configIndex && ptpPortIndex == ppIndex)
+							if (configurationIndex == configIndex)
 								textEntry->setCurrentData(ptpPortName);
 						});
 					break;
 				}
 				case hive::modelsLibrary::ControllerManager::AecpCommandType::SetAssociationID:
 				{
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::associationIDChanged, textEntry,
-						[this, textEntry](la::avdecc::UniqueIdentifier const entityID, std::optional<la::avdecc::UniqueIdentifier> const& associationID)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::associationIDChanged, avdecc::DescriptorKey{ _controlledEntityID }, textEntry,
+						[textEntry](la::avdecc::UniqueIdentifier const /*entityID*/, std::optional<la::avdecc::UniqueIdentifier> const& associationID)
 						{
-							if (entityID == _controlledEntityID)
-							{
-								textEntry->setCurrentData(associationID ? hive::modelsLibrary::helper::uniqueIdentifierToString(*associationID) : "");
-							}
+							textEntry->setCurrentData(associationID ? hive::modelsLibrary::helper::uniqueIdentifierToString(*associationID) : "");
 						});
 					break;
 				}
@@ -1842,32 +1842,29 @@ public:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ClockDomainIndex, MediaClockReferenceInfoType>>(customData);
 					auto const clockDomainIndex = std::get<0>(customTuple);
 					auto const infoType = std::get<1>(customTuple);
-					connect(&hive::modelsLibrary::ControllerManager::getInstance(), &hive::modelsLibrary::ControllerManager::mediaClockReferenceInfoChanged, textEntry,
-						[this, textEntry, cdIndex = clockDomainIndex, infoType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::MediaClockReferenceInfo const& mcrInfo)
+					avdecc::ControllerManagerSubscriptions::getInstance().subscribe(&hive::modelsLibrary::ControllerManager::mediaClockReferenceInfoChanged, avdecc::DescriptorKey{ _controlledEntityID, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex }, textEntry,
+						[textEntry, infoType](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::MediaClockReferenceInfo const& mcrInfo)
 						{
-							if (entityID == _controlledEntityID && clockDomainIndex == cdIndex)
+							switch (infoType)
 							{
-								switch (infoType)
+								case MediaClockReferenceInfoType::UserPriority:
 								{
-									case MediaClockReferenceInfoType::UserPriority:
+									if (mcrInfo.userMediaClockPriority)
 									{
-										if (mcrInfo.userMediaClockPriority)
-										{
-											textEntry->setCurrentData(QString::number(*mcrInfo.userMediaClockPriority));
-										}
-										break;
+										textEntry->setCurrentData(QString::number(*mcrInfo.userMediaClockPriority));
 									}
-									case MediaClockReferenceInfoType::DomainName:
+									break;
+								}
+								case MediaClockReferenceInfoType::DomainName:
+								{
+									if (mcrInfo.mediaClockDomainName)
 									{
-										if (mcrInfo.mediaClockDomainName)
-										{
-											textEntry->setCurrentData(QString::fromStdString(static_cast<std::string>(*mcrInfo.mediaClockDomainName)));
-										}
-										break;
+										textEntry->setCurrentData(QString::fromStdString(static_cast<std::string>(*mcrInfo.mediaClockDomainName)));
 									}
-									default:
-										break;
+									break;
 								}
+								default:
+									break;
 							}
 						});
 					break;
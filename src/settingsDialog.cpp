@@ -49,6 +49,7 @@ public:
 			closeButton->setAutoDefault(false);
 		}
 		discoveryDelayLineEdit->setValidator(new QIntValidator{ 0, 999, discoveryDelayLineEdit });
+		notificationsCoalescingIntervalLineEdit->setValidator(new QIntValidator{ 0, 1000, notificationsCoalescingIntervalLineEdit });
 
 		// Initialize settings (blocking signals)
 		loadGeneralSettings();
@@ -194,6 +195,12 @@ private:
 			auto const lock = QSignalBlocker{ controllerIDLineEdit };
 			controllerIDLineEdit->setText(settings->getValue(settings::Controller_ControllerSubID.name).toString());
 		}
+
+		// Notifications Coalescing Interval
+		{
+			auto const lock = QSignalBlocker{ notificationsCoalescingIntervalLineEdit };
+			notificationsCoalescingIntervalLineEdit->setText(settings->getValue(settings::Controller_NotificationsCoalescingInterval.name).toString());
+		}
 	}
 
 	void loadNetworkSettings()
@@ -374,6 +381,12 @@ void SettingsDialog::on_controllerIDLineEdit_returnPressed()
 	settings->setValue(settings::Controller_ControllerSubID.name, _pImpl->controllerIDLineEdit->text());
 }
 
+void SettingsDialog::on_notificationsCoalescingIntervalLineEdit_returnPressed()
+{
+	auto* const settings = qApp->property(settings::SettingsManager::PropertyName).value<settings::SettingsManager*>();
+	settings->setValue(settings::Controller_NotificationsCoalescingInterval.name, _pImpl->notificationsCoalescingIntervalLineEdit->text());
+}
+
 void SettingsDialog::on_protocolComboBox_currentIndexChanged(int /*index*/)
 {
 	auto* const settings = qApp->property(settings::SettingsManager::PropertyName).value<settings::SettingsManager*>();
@@ -59,6 +59,7 @@ private:
 	Q_SLOT void on_fullAEMEnumerationCheckBox_toggled(bool checked);
 	Q_SLOT void on_enableAdvertisingCheckBox_toggled(bool checked);
 	Q_SLOT void on_controllerIDLineEdit_returnPressed();
+	Q_SLOT void on_notificationsCoalescingIntervalLineEdit_returnPressed();
 
 	// Network
 	Q_SLOT void on_protocolComboBox_currentIndexChanged(int index);
@@ -23,6 +23,7 @@
 #include "profiles/profiles.hpp"
 #include "internals/config.hpp"
 
+#include <hive/modelsLibrary/controllerManager.hpp>
 #include <la/avdecc/internals/protocolInterface.hpp>
 #include <la/avdecc/utils.hpp>
 #include <QtMate/material/colorPalette.hpp>
@@ -64,6 +65,7 @@ static SettingsManager::SettingDefault Controller_AemCacheEnabled = { "avdecc/co
 static SettingsManager::SettingDefault Controller_FastEnumerationEnabled = { "avdecc/controller/enableFastEnumeration", false }; // Requires Controller_AemCacheEnabled
 static SettingsManager::SettingDefault Controller_FullStaticModelEnabled = { "avdecc/controller/fullStaticModel", false };
 static SettingsManager::SettingDefault Controller_AdvertisingEnabled = { "avdecc/controller/enableAdvertising", true };
+static SettingsManager::SettingDefault Controller_NotificationsCoalescingInterval = { "avdecc/controller/notificationsCoalescingInterval", static_cast<int>(hive::modelsLibrary::ControllerManager::DefaultNotificationsCoalescingInterval.count()) }; // In milliseconds (0 to dispatch as soon as possible)
 #ifdef DEBUG
 static SettingsManager::SettingDefault Controller_ControllerSubID = { "avdecc/controller/controllerSubID_Debug", (hive::internals::majorVersion * 100) + (hive::internals::minorVersion * 10) + 1 + (hive::internals::marketingDigits > 2u ? 0x8000 : 0) };
 #else // !DEBUG
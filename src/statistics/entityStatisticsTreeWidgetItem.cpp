@@ -18,6 +18,7 @@
 */
 
 #include "entityStatisticsTreeWidgetItem.hpp"
+#include "counters/counterHistoryStore.hpp"
 
 #include <QtMate/material/color.hpp>
 
@@ -38,6 +39,13 @@ EntityStatisticsTreeWidgetItem::EntityStatisticsTreeWidgetItem(la::avdecc::Uniqu
 	_mvuAecpUnsolicitedLossCounterItem.setText(0, "MVU Unsolicited Loss");
 	_enumerationTimeItem.setText(0, "Enumeration Time");
 
+	// Age the histories of idle counters
+	connect(&CounterHistoryStore::getInstance(), &CounterHistoryStore::historiesAged, this,
+		[this]()
+		{
+			CounterHistoryStore::getInstance().updateItems(*this);
+		});
+
 	// Update statistics right now
 	auto& manager = hive::modelsLibrary::ControllerManager::getInstance();
 	_errorCounters = manager.getStatisticsCounters(_entityID);
@@ -148,6 +156,8 @@ void EntityStatisticsTreeWidgetItem::setWidgetTextAndColor(EntityStatisticTreeWi
 
 	widget.setText(1, text);
 	widget.setHidden(false);
+
+	CounterHistoryStore::getInstance().updateItem(widget, { _entityID, CounterHistoryStore::CounterKind::Statistics, 0u, la::avdecc::utils::to_integral(flag) });
 }
 
 void EntityStatisticsTreeWidgetItem::updateAecpRetryCounter(std::uint64_t const value) noexcept
@@ -0,0 +1,396 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file channelConnectionsCache_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/channelConnectionsCache.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using EntityID = int;
+using StreamIndex = int;
+
+struct Channel
+{
+	int clusterChannel{ 0 };
+	std::optional<int> streamPortIndex{ 0 };
+};
+
+bool operator<(Channel const& lhs, Channel const& rhs)
+{
+	return lhs.clusterChannel < rhs.clusterChannel;
+}
+
+struct Target
+{
+	EntityID targetEntityId{ 0 };
+	StreamIndex targetStreamIndex{ 0 };
+	int targetClusterChannel{ 0 };
+};
+
+struct Connections
+{
+	std::vector<std::shared_ptr<Target const>> targets{};
+};
+
+bool operator==(Connections const& lhs, Connections const& rhs)
+{
+	if (lhs.targets.size() != rhs.targets.size())
+	{
+		return false;
+	}
+	for (auto index = 0u; index < lhs.targets.size(); ++index)
+	{
+		auto const& l = *lhs.targets[index];
+		auto const& r = *rhs.targets[index];
+		if (std::tie(l.targetEntityId, l.targetStreamIndex, l.targetClusterChannel) != std::tie(r.targetEntityId, r.targetStreamIndex, r.targetClusterChannel))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+using Cache = avdecc::ChannelConnectionsCache<EntityID, Channel, Connections>;
+
+/** Network of entities with channels (4 per stream port) mapped to streams, notifying the cache of its changes the way the ChannelConnectionManager does */
+class Network
+{
+public:
+	static constexpr auto ChannelsPerStreamPort = 4;
+	static constexpr auto StreamPortsCount = 2;
+
+	explicit Network(Cache& cache)
+		: _cache{ cache }
+	{
+	}
+
+	static Channel channel(int const clusterChannel)
+	{
+		return Channel{ clusterChannel, clusterChannel / ChannelsPerStreamPort };
+	}
+
+	/** Determines the connections of a talker channel, from scratch */
+	std::shared_ptr<Connections> determine(EntityID const talker, Channel const& channel) const
+	{
+		auto connections = std::make_shared<Connections>();
+		if (_online.count(talker) == 0)
+		{
+			return connections;
+		}
+		auto const talkerMappingIt = _talkerMappings.find({ talker, channel.clusterChannel });
+		if (talkerMappingIt == _talkerMappings.end())
+		{
+			return connections;
+		}
+		auto const [talkerStream, streamChannel] = talkerMappingIt->second;
+		for (auto const& [listenerStream, connectedStream] : _connections)
+		{
+			auto const [listener, listenerStreamIndex] = listenerStream;
+			if (_online.count(listener) == 0 || connectedStream != std::make_pair(talker, talkerStream))
+			{
+				continue;
+			}
+			for (auto const& [listenerMapping, listenerChannel] : _listenerMappings)
+			{
+				if (listenerMapping == std::make_tuple(listener, listenerStreamIndex, streamChannel))
+				{
+					connections->targets.push_back(std::make_shared<Target const>(Target{ listener, listenerStreamIndex, listenerChannel }));
+				}
+			}
+		}
+		return connections;
+	}
+
+	/** Gets the connections of a talker channel, from the cache */
+	std::shared_ptr<Connections const> get(EntityID const talker, int const clusterChannel)
+	{
+		return _cache.get(talker, channel(clusterChannel),
+			[this, talker, clusterChannel]()
+			{
+				return determine(talker, channel(clusterChannel));
+			});
+	}
+
+	bool isUpToDate(EntityID const talker, int const clusterChannel)
+	{
+		return *get(talker, clusterChannel) == *determine(talker, channel(clusterChannel));
+	}
+
+	void setOnline(EntityID const entity)
+	{
+		_online.insert(entity);
+		_cache.invalidateEntity(entity, connectedTalkers(entity));
+	}
+
+	void setOffline(EntityID const entity)
+	{
+		_online.erase(entity);
+		_cache.invalidateEntity(entity);
+	}
+
+	void mapTalkerChannel(EntityID const talker, int const clusterChannel, StreamIndex const stream, int const streamChannel)
+	{
+		_talkerMappings[{ talker, clusterChannel }] = { stream, streamChannel };
+		_cache.invalidateTalkerStreamPort(talker, channel(clusterChannel).streamPortIndex);
+	}
+
+	void unmapTalkerChannel(EntityID const talker, int const clusterChannel)
+	{
+		_talkerMappings.erase({ talker, clusterChannel });
+		_cache.invalidateTalkerStreamPort(talker, channel(clusterChannel).streamPortIndex);
+	}
+
+	void mapListenerChannel(EntityID const listener, StreamIndex const stream, int const streamChannel, int const clusterChannel)
+	{
+		_listenerMappings[{ listener, stream, streamChannel }] = clusterChannel;
+		_cache.invalidateListener(listener, connectedTalkers(listener));
+	}
+
+	void unmapListenerChannel(EntityID const listener, StreamIndex const stream, int const streamChannel)
+	{
+		_listenerMappings.erase({ listener, stream, streamChannel });
+		_cache.invalidateListener(listener, connectedTalkers(listener));
+	}
+
+	void connect(EntityID const talker, StreamIndex const talkerStream, EntityID const listener, StreamIndex const listenerStream)
+	{
+		_connections[{ listener, listenerStream }] = { talker, talkerStream };
+		_cache.invalidateListener(listener, connectedTalkers(listener));
+		_cache.invalidateTalker(talker);
+	}
+
+	/** Only the listener side is notified, like a listener disconnected by another controller */
+	void disconnect(EntityID const listener, StreamIndex const listenerStream)
+	{
+		_connections.erase({ listener, listenerStream });
+		_cache.invalidateListener(listener, connectedTalkers(listener));
+	}
+
+private:
+	std::set<EntityID> connectedTalkers(EntityID const listener) const
+	{
+		auto talkers = std::set<EntityID>{};
+		for (auto const& [listenerStream, talkerStream] : _connections)
+		{
+			if (listenerStream.first == listener)
+			{
+				talkers.insert(talkerStream.first);
+			}
+		}
+		return talkers;
+	}
+
+	Cache& _cache;
+	std::set<EntityID> _online{};
+	std::map<std::pair<EntityID, int>, std::pair<StreamIndex, int>> _talkerMappings{}; // (Talker, ClusterChannel) -> (TalkerStream, StreamChannel)
+	std::map<std::tuple<EntityID, StreamIndex, int>, int> _listenerMappings{}; // (Listener, ListenerStream, StreamChannel) -> ClusterChannel
+	std::map<std::pair<EntityID, StreamIndex>, std::pair<EntityID, StreamIndex>> _connections{}; // (Listener, ListenerStream) -> (Talker, TalkerStream)
+};
+
+constexpr auto Talker = EntityID{ 1 };
+constexpr auto Listener = EntityID{ 2 };
+constexpr auto OtherListener = EntityID{ 3 };
+
+/** Talker channels 0 and 4 (one per stream port) to Listener channels 10 and 14, Talker also connected to OtherListener (not mapped) */
+void setupNetwork(Network& network)
+{
+	network.setOnline(Talker);
+	network.setOnline(Listener);
+	network.setOnline(OtherListener);
+	network.mapTalkerChannel(Talker, 0, 0, 0);
+	network.mapTalkerChannel(Talker, 4, 1, 0);
+	network.mapListenerChannel(Listener, 0, 0, 10);
+	network.mapListenerChannel(Listener, 1, 0, 14);
+	network.connect(Talker, 0, Listener, 0);
+	network.connect(Talker, 1, Listener, 1);
+	network.connect(Talker, 0, OtherListener, 0);
+}
+} // namespace
+
+TEST(ChannelConnectionsCache, Cached)
+{
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	setupNetwork(network);
+
+	auto const connections = network.get(Talker, 0);
+	ASSERT_EQ(1u, connections->targets.size());
+	EXPECT_EQ(Listener, connections->targets[0]->targetEntityId);
+	EXPECT_EQ(10, connections->targets[0]->targetClusterChannel);
+
+	// Same result until something changes
+	EXPECT_EQ(connections, network.get(Talker, 0));
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+}
+
+TEST(ChannelConnectionsCache, TalkerMappingChange)
+{
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	setupNetwork(network);
+	network.get(Talker, 0);
+	network.get(Talker, 4);
+
+	// Only the channels of the changed stream port are invalidated
+	network.mapTalkerChannel(Talker, 4, 1, 1);
+	EXPECT_TRUE(cache.isCached(Talker, Network::channel(0)));
+	EXPECT_FALSE(cache.isCached(Talker, Network::channel(4)));
+	EXPECT_TRUE(network.get(Talker, 4)->targets.empty());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+	EXPECT_TRUE(network.isUpToDate(Talker, 4));
+
+	network.unmapTalkerChannel(Talker, 0);
+	EXPECT_TRUE(network.get(Talker, 0)->targets.empty());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+}
+
+TEST(ChannelConnectionsCache, ListenerMappingChange)
+{
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	setupNetwork(network);
+	network.get(Talker, 0);
+
+	// Listener not targeted yet, but connected to the talker
+	network.mapListenerChannel(OtherListener, 0, 0, 20);
+	EXPECT_FALSE(cache.isCached(Talker, Network::channel(0)));
+	EXPECT_EQ(2u, network.get(Talker, 0)->targets.size());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+
+	// Targeted listener
+	network.unmapListenerChannel(Listener, 0, 0);
+	EXPECT_EQ(1u, network.get(Talker, 0)->targets.size());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+}
+
+TEST(ChannelConnectionsCache, StreamDisconnect)
+{
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	setupNetwork(network);
+	network.get(Talker, 0);
+	network.get(Talker, 4);
+
+	network.disconnect(Listener, 0);
+	EXPECT_TRUE(network.get(Talker, 0)->targets.empty());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+	EXPECT_TRUE(network.isUpToDate(Talker, 4));
+
+	network.connect(Talker, 0, Listener, 0);
+	EXPECT_EQ(1u, network.get(Talker, 0)->targets.size());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+}
+
+TEST(ChannelConnectionsCache, EntityOffline)
+{
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	setupNetwork(network);
+	network.get(Talker, 0);
+
+	// Listener
+	network.setOffline(Listener);
+	EXPECT_TRUE(network.get(Talker, 0)->targets.empty());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+	network.setOnline(Listener);
+	EXPECT_EQ(1u, network.get(Talker, 0)->targets.size());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+
+	// Talker (requested while offline)
+	network.setOffline(Talker);
+	EXPECT_TRUE(network.get(Talker, 0)->targets.empty());
+	network.setOnline(Talker);
+	EXPECT_EQ(1u, network.get(Talker, 0)->targets.size());
+	EXPECT_TRUE(network.isUpToDate(Talker, 0));
+}
+
+TEST(ChannelConnectionsCache, RandomChanges)
+{
+	constexpr auto EntitiesCount = 4;
+	constexpr auto StreamsCount = Network::StreamPortsCount;
+	constexpr auto StreamChannelsCount = 2;
+	constexpr auto ClusterChannelsCount = Network::ChannelsPerStreamPort * Network::StreamPortsCount;
+
+	auto cache = Cache{};
+	auto network = Network{ cache };
+	auto generator = std::mt19937{ 42u };
+	auto const random = [&generator](int const count)
+	{
+		return std::uniform_int_distribution<int>{ 0, count - 1 }(generator);
+	};
+
+	for (auto entity = 0; entity < EntitiesCount; ++entity)
+	{
+		network.setOnline(entity);
+	}
+
+	for (auto iteration = 0; iteration < 2000; ++iteration)
+	{
+		auto const entity = random(EntitiesCount);
+		switch (random(8))
+		{
+			case 0:
+				network.mapTalkerChannel(entity, random(ClusterChannelsCount), random(StreamsCount), random(StreamChannelsCount));
+				break;
+			case 1:
+				network.unmapTalkerChannel(entity, random(ClusterChannelsCount));
+				break;
+			case 2:
+				network.mapListenerChannel(entity, random(StreamsCount), random(StreamChannelsCount), random(ClusterChannelsCount));
+				break;
+			case 3:
+				network.unmapListenerChannel(entity, random(StreamsCount), random(StreamChannelsCount));
+				break;
+			case 4:
+				network.connect(random(EntitiesCount), random(StreamsCount), entity, random(StreamsCount));
+				break;
+			case 5:
+				network.disconnect(entity, random(StreamsCount));
+				break;
+			case 6:
+				network.setOffline(entity);
+				break;
+			default:
+				network.setOnline(entity);
+				break;
+		}
+
+		for (auto talker = 0; talker < EntitiesCount; ++talker)
+		{
+			for (auto clusterChannel = 0; clusterChannel < ClusterChannelsCount; ++clusterChannel)
+			{
+				ASSERT_TRUE(network.isUpToDate(talker, clusterChannel)) << "Iteration " << iteration << ", talker " << talker << ", channel " << clusterChannel;
+			}
+		}
+	}
+}
@@ -0,0 +1,395 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file channelRoutingPlanner_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/channelRoutingPlanner.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Planner = avdecc::ChannelRoutingPlanner;
+using EntityID = Planner::EntityID;
+using Channel = Planner::Channel;
+
+/** Entity with streams of 2 channels (up to 8), and a single stream port with one single channel cluster per channel */
+Planner::Entity makeEntity(std::uint16_t const outputStreamsCount, std::uint16_t const inputStreamsCount)
+{
+	auto entity = Planner::Entity{};
+	for (auto streamIndex = Planner::StreamIndex{ 0u }; streamIndex < outputStreamsCount; ++streamIndex)
+	{
+		entity.streamOutputs[streamIndex] = Planner::Stream{ 2u, 8u };
+	}
+	for (auto streamIndex = Planner::StreamIndex{ 0u }; streamIndex < inputStreamsCount; ++streamIndex)
+	{
+		entity.streamInputs[streamIndex] = Planner::StreamInput{ { 2u, 8u } };
+	}
+	return entity;
+}
+
+Planner::ClusterChannel cluster(std::uint16_t const clusterOffset)
+{
+	return Planner::ClusterChannel{ 0u, clusterOffset, 0u };
+}
+
+Planner::Route route(EntityID const talker, std::uint16_t const talkerCluster, EntityID const listener, std::uint16_t const listenerCluster)
+{
+	return Planner::Route{ talker, cluster(talkerCluster), listener, cluster(listenerCluster) };
+}
+
+std::size_t mappingsCount(std::vector<Planner::MappingsChange> const& changes, EntityID const entityID, bool const isInput)
+{
+	auto count = std::size_t{ 0u };
+	for (auto const& change : changes)
+	{
+		if (change.entityID == entityID && change.isInput == isInput)
+		{
+			count += change.mappings.size();
+		}
+	}
+	return count;
+}
+
+} // namespace
+
+TEST(ChannelRoutingPlanner, CreateStreamConnection)
+{
+	auto planner = Planner{};
+	planner.setEntity(1u, makeEntity(2u, 0u));
+	planner.setEntity(2u, makeEntity(0u, 2u));
+
+	auto routes = std::vector<Planner::Route>{};
+	for (auto channel = std::uint16_t{ 0u }; channel < 4u; ++channel)
+	{
+		routes.push_back(route(1u, channel, 2u, channel));
+	}
+	auto const plan = planner.plan(routes);
+
+	// All the channels go through a single stream connection, which format is enlarged to 4 channels
+	EXPECT_TRUE(plan.impossibleRoutes.empty());
+	ASSERT_EQ(1u, plan.streamsToConnect.size());
+	EXPECT_EQ(1u, plan.streamsToConnect[0].talkerStream.entityID);
+	EXPECT_EQ(2u, plan.streamsToConnect[0].listenerStream.entityID);
+	EXPECT_TRUE(plan.streamsToReconnect.empty());
+	EXPECT_TRUE(plan.mappingsToRemove.empty());
+	ASSERT_EQ(2u, plan.mappingsToAdd.size());
+	EXPECT_EQ(4u, mappingsCount(plan.mappingsToAdd, 1u, false));
+	EXPECT_EQ(4u, mappingsCount(plan.mappingsToAdd, 2u, true));
+	ASSERT_EQ(2u, plan.streamFormatChanges.size());
+	for (auto const& change : plan.streamFormatChanges)
+	{
+		EXPECT_EQ(4u, change.channelsCount);
+	}
+	EXPECT_EQ(5u, plan.commandsCount());
+	EXPECT_EQ((std::set<EntityID>{ 1u, 2u }), plan.entities());
+
+	// Planning does not change the snapshot
+	EXPECT_FALSE(planner.isRouted(routes[0]));
+
+	planner.apply(plan);
+	for (auto const& r : routes)
+	{
+		EXPECT_TRUE(planner.isRouted(r));
+	}
+
+	auto const replan = planner.plan(routes);
+	EXPECT_TRUE(replan.isEmpty());
+	EXPECT_EQ(routes.size(), replan.alreadyRoutedCount);
+}
+
+TEST(ChannelRoutingPlanner, ReuseExistingConnection)
+{
+	auto talker = makeEntity(1u, 0u);
+	talker.streamPortOutputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+	auto listener = makeEntity(0u, 1u);
+	listener.streamInputs[0].talkerStream = Planner::StreamIdentification{ 1u, 0u };
+
+	auto planner = Planner{};
+	planner.setEntity(1u, talker);
+	planner.setEntity(2u, listener);
+
+	// Only the listener mapping is missing
+	auto const plan = planner.plan({ route(1u, 0u, 2u, 5u) });
+	EXPECT_TRUE(plan.streamsToConnect.empty());
+	EXPECT_TRUE(plan.streamFormatChanges.empty());
+	ASSERT_EQ(1u, plan.mappingsToAdd.size());
+	EXPECT_EQ(1u, mappingsCount(plan.mappingsToAdd, 2u, true));
+	EXPECT_EQ(1u, plan.commandsCount());
+}
+
+TEST(ChannelRoutingPlanner, ReplaceListenerMapping)
+{
+	auto talker = makeEntity(1u, 0u);
+	talker.streamPortOutputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u }, Planner::Mapping{ 0u, 1u, 1u, 0u } };
+	auto listener = makeEntity(0u, 1u);
+	listener.streamInputs[0].talkerStream = Planner::StreamIdentification{ 1u, 0u };
+	listener.streamPortInputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+
+	auto planner = Planner{};
+	planner.setEntity(1u, talker);
+	planner.setEntity(2u, listener);
+
+	// Listener channel 0 receives talker channel 1 instead of talker channel 0
+	auto const plan = planner.plan({ route(1u, 1u, 2u, 0u) });
+	ASSERT_EQ(1u, plan.mappingsToRemove.size());
+	EXPECT_EQ(Planner::Mapping({ 0u, 0u, 0u, 0u }), plan.mappingsToRemove[0].mappings.at(0));
+	ASSERT_EQ(1u, plan.mappingsToAdd.size());
+	EXPECT_EQ(Planner::Mapping({ 0u, 1u, 0u, 0u }), plan.mappingsToAdd[0].mappings.at(0));
+
+	planner.apply(plan);
+	EXPECT_TRUE(planner.isRouted(route(1u, 1u, 2u, 0u)));
+	EXPECT_FALSE(planner.isRouted(route(1u, 0u, 2u, 0u)));
+}
+
+TEST(ChannelRoutingPlanner, ReconnectRunningStream)
+{
+	auto talker = makeEntity(1u, 0u);
+	talker.streamPortOutputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+	auto listener = makeEntity(0u, 1u);
+	listener.streamInputs[0].talkerStream = Planner::StreamIdentification{ 1u, 0u };
+	listener.streamPortInputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+
+	auto planner = Planner{};
+	planner.setEntity(1u, talker);
+	planner.setEntity(2u, listener);
+
+	// The talker stream is running, adding a talker mapping requires to stop it
+	auto const plan = planner.plan({ route(1u, 1u, 2u, 1u), route(1u, 2u, 2u, 2u) });
+	EXPECT_TRUE(plan.impossibleRoutes.empty());
+	EXPECT_TRUE(plan.streamsToConnect.empty());
+	ASSERT_EQ(1u, plan.streamsToReconnect.size());
+	EXPECT_EQ((Planner::StreamConnection{ { 1u, 0u }, { 2u, 0u } }), plan.streamsToReconnect[0]);
+	EXPECT_EQ(2u, mappingsCount(plan.mappingsToAdd, 1u, false));
+	EXPECT_EQ(2u, mappingsCount(plan.mappingsToAdd, 2u, true));
+	// Both streams enlarged to 3 channels
+	EXPECT_EQ(2u, plan.streamFormatChanges.size());
+}
+
+TEST(ChannelRoutingPlanner, PreferNewConnectionOverReconnection)
+{
+	auto talker = makeEntity(2u, 0u);
+	talker.streamPortOutputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+	auto listener = makeEntity(0u, 2u);
+	listener.streamInputs[0].talkerStream = Planner::StreamIdentification{ 1u, 0u };
+	listener.streamPortInputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u } };
+
+	auto planner = Planner{};
+	planner.setEntity(1u, talker);
+	planner.setEntity(2u, listener);
+
+	auto const plan = planner.plan({ route(1u, 1u, 2u, 1u) });
+	EXPECT_TRUE(plan.streamsToReconnect.empty());
+	ASSERT_EQ(1u, plan.streamsToConnect.size());
+	EXPECT_EQ((Planner::StreamConnection{ { 1u, 1u }, { 2u, 1u } }), plan.streamsToConnect[0]);
+}
+
+TEST(ChannelRoutingPlanner, RemoveUnwantedMappings)
+{
+	auto talker = makeEntity(1u, 0u);
+	talker.streamPortOutputMappings[0] = { Planner::Mapping{ 0u, 0u, 0u, 0u }, Planner::Mapping{ 0u, 1u, 1u, 0u } };
+	auto listener = makeEntity(0u, 1u);
+	// Stale mapping of an unconnected stream, which would receive talker channel 1 once connected
+	listener.streamPortInputMappings[0] = { Planner::Mapping{ 0u, 1u, 7u, 0u } };
+
+	auto planner = Planner{};
+	planner.setEntity(1u, talker);
+	planner.setEntity(2u, listener);
+
+	auto const plan = planner.plan({ route(1u, 0u, 2u, 0u) });
+	ASSERT_EQ(1u, plan.streamsToConnect.size());
+	ASSERT_EQ(1u, plan.mappingsToRemove.size());
+	EXPECT_EQ(Planner::Mapping({ 0u, 1u, 7u, 0u }), plan.mappingsToRemove[0].mappings.at(0));
+
+	planner.apply(plan);
+	EXPECT_TRUE(planner.isRouted(route(1u, 0u, 2u, 0u)));
+	EXPECT_FALSE(planner.isRouted(route(1u, 1u, 2u, 7u)));
+}
+
+TEST(ChannelRoutingPlanner, ImpossibleRoutes)
+{
+	auto planner = Planner{};
+	planner.setEntity(1u, makeEntity(1u, 0u));
+	planner.setEntity(2u, makeEntity(0u, 1u));
+
+	// Unknown entity, and a single stream of 8 channels for 9 channels
+	auto routes = std::vector<Planner::Route>{ route(1u, 0u, 42u, 0u) };
+	for (auto channel = std::uint16_t{ 0u }; channel < 9u; ++channel)
+	{
+		routes.push_back(route(1u, channel, 2u, channel));
+	}
+	auto const plan = planner.plan(routes);
+	ASSERT_EQ(2u, plan.impossibleRoutes.size());
+	EXPECT_EQ(42u, plan.impossibleRoutes[0].listenerEntityID);
+	EXPECT_EQ(8u, plan.impossibleRoutes[1].talkerChannel.clusterOffset);
+	EXPECT_EQ(8u, mappingsCount(plan.mappingsToAdd, 2u, true));
+}
+
+TEST(ChannelRoutingPlanner, RandomRoutesAreAllRouted)
+{
+	static constexpr auto TalkersCount = EntityID{ 6u };
+	static constexpr auto ListenersCount = EntityID{ 10u };
+
+	for (auto const seed : { 1u, 2u, 3u })
+	{
+		auto generator = std::mt19937{ seed };
+		auto planner = Planner{};
+		for (auto talker = EntityID{ 0u }; talker < TalkersCount; ++talker)
+		{
+			planner.setEntity(talker, makeEntity(4u, 0u));
+		}
+		for (auto listener = EntityID{ 0u }; listener < ListenersCount; ++listener)
+		{
+			planner.setEntity(100u + listener, makeEntity(0u, 4u));
+		}
+
+		// Several rounds, each one changing some routes of the previous ones
+		for (auto round = 0; round < 4; ++round)
+		{
+			auto routes = std::map<std::pair<EntityID, std::uint16_t>, Planner::Route>{}; // One route per listener channel
+			for (auto index = 0; index < 40; ++index)
+			{
+				auto const talker = std::uniform_int_distribution<EntityID>{ 0u, TalkersCount - 1u }(generator);
+				auto const listener = 100u + std::uniform_int_distribution<EntityID>{ 0u, ListenersCount - 1u }(generator);
+				auto const talkerCluster = std::uniform_int_distribution<std::uint16_t>{ 0u, 15u }(generator);
+				auto const listenerCluster = std::uniform_int_distribution<std::uint16_t>{ 0u, 7u }(generator);
+				routes[{ listener, listenerCluster }] = route(talker, talkerCluster, listener, listenerCluster);
+			}
+
+			auto routesList = std::vector<Planner::Route>{};
+			for (auto const& [channel, r] : routes)
+			{
+				routesList.push_back(r);
+			}
+
+			auto const plan = planner.plan(routesList);
+			planner.apply(plan);
+			for (auto const& r : routesList)
+			{
+				auto const isImpossible = std::any_of(plan.impossibleRoutes.begin(), plan.impossibleRoutes.end(),
+					[&r](auto const& impossibleRoute)
+					{
+						return impossibleRoute.listenerEntityID == r.listenerEntityID && impossibleRoute.listenerChannel == r.listenerChannel;
+					});
+				EXPECT_NE(isImpossible, planner.isRouted(r)) << "Seed " << seed << " round " << round;
+			}
+
+			auto const replan = planner.plan(routesList);
+			EXPECT_TRUE(replan.isEmpty());
+		}
+	}
+}
+
+TEST(ChannelRoutingPlanner, Benchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	// 10 stage boxes of 64 channels (8 streams), 40 amplifiers of 16 channels (2 streams)
+	static constexpr auto StageBoxesCount = EntityID{ 10u };
+	static constexpr auto AmplifiersCount = EntityID{ 40u };
+	static constexpr auto StagesPerCall = std::size_t{ 6u }; // Stages of a createChannelConnections command chain
+
+	auto const toUs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+
+	auto const makeNetwork = []()
+	{
+		auto planner = Planner{};
+		for (auto stageBox = EntityID{ 0u }; stageBox < StageBoxesCount; ++stageBox)
+		{
+			planner.setEntity(stageBox, makeEntity(8u, 0u));
+		}
+		for (auto amplifier = EntityID{ 0u }; amplifier < AmplifiersCount; ++amplifier)
+		{
+			planner.setEntity(100u + amplifier, makeEntity(0u, 2u));
+		}
+		return planner;
+	};
+
+	// Each amplifier receives 8 channels from 2 stage boxes
+	auto routes = std::vector<Planner::Route>{};
+	auto routesPerPair = std::map<std::pair<EntityID, EntityID>, std::vector<Planner::Route>>{};
+	for (auto amplifier = EntityID{ 0u }; amplifier < AmplifiersCount; ++amplifier)
+	{
+		for (auto source = EntityID{ 0u }; source < 2u; ++source)
+		{
+			auto const stageBox = (amplifier + source) % StageBoxesCount;
+			for (auto channel = std::uint16_t{ 0u }; channel < 8u; ++channel)
+			{
+				auto const r = route(stageBox, static_cast<std::uint16_t>((amplifier / StageBoxesCount) * 8u + channel), 100u + amplifier, static_cast<std::uint16_t>(source * 8u + channel));
+				routes.push_back(r);
+				routesPerPair[{ stageBox, 100u + amplifier }].push_back(r);
+			}
+		}
+	}
+
+	// Whole matrix at once
+	auto batchedPlanner = makeNetwork();
+	auto startTime = Clock::now();
+	auto const plan = batchedPlanner.plan(routes);
+	auto const planDuration = Clock::now() - startTime;
+	EXPECT_TRUE(plan.impossibleRoutes.empty());
+	batchedPlanner.apply(plan);
+	for (auto const& r : routes)
+	{
+		ASSERT_TRUE(batchedPlanner.isRouted(r));
+	}
+
+	// One talker/listener pair at a time, like createChannelConnections
+	auto pairPlanner = makeNetwork();
+	auto pairCommandsCount = std::size_t{ 0u };
+	auto pairReconnectionsCount = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto const& [pair, pairRoutes] : routesPerPair)
+	{
+		auto const pairPlan = pairPlanner.plan(pairRoutes);
+		pairCommandsCount += pairPlan.commandsCount();
+		pairReconnectionsCount += pairPlan.streamsToReconnect.size();
+		pairPlanner.apply(pairPlan);
+	}
+	auto const pairDuration = Clock::now() - startTime;
+	for (auto const& r : routes)
+	{
+		ASSERT_TRUE(pairPlanner.isRouted(r));
+	}
+
+	EXPECT_LT(plan.commandsCount(), pairCommandsCount);
+	EXPECT_TRUE(plan.streamsToReconnect.empty());
+
+	auto mappingsCount = std::size_t{ 0u };
+	for (auto const& change : plan.mappingsToAdd)
+	{
+		mappingsCount += change.mappings.size();
+	}
+
+	std::cout << "Routing " << routes.size() << " channels from " << StageBoxesCount << " stage boxes to " << AmplifiersCount << " amplifiers:" << std::endl;
+	std::cout << "  Whole matrix: " << plan.commandsCount() << " commands (" << plan.streamsToConnect.size() << " connections, " << plan.streamFormatChanges.size() << " format changes, " << mappingsCount << " mappings in " << plan.mappingsToAdd.size() << " commands) to " << plan.entities().size() << " entities, in " << StagesPerCall << " stages, planned in " << toUs(planDuration) << " us" << std::endl;
+	std::cout << "  Per pair: " << pairCommandsCount << " commands (" << pairReconnectionsCount << " reconnections), in " << StagesPerCall * routesPerPair.size() << " sequential stages, planned in " << toUs(pairDuration) << " us" << std::endl;
+}
@@ -0,0 +1,281 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file commandScheduler_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/commandScheduler.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using Scheduler = avdecc::commandChain::CommandScheduler<std::uint64_t>;
+
+/** Runs all commands of the scheduler, each taking the specified duration (virtual time), returns the total time */
+template<typename DurationFunction>
+std::uint64_t simulate(Scheduler& scheduler, DurationFunction&& duration, std::vector<std::uint64_t>* const completionTimes = nullptr, std::vector<std::uint64_t>* const startTimes = nullptr)
+{
+	auto now = std::uint64_t{ 0u };
+	auto inFlight = std::multimap<std::uint64_t, Scheduler::CommandID>{}; // Completion time -> Command
+	if (completionTimes)
+	{
+		completionTimes->assign(scheduler.commandCount(), 0u);
+	}
+	if (startTimes)
+	{
+		startTimes->assign(scheduler.commandCount(), 0u);
+	}
+
+	while (true)
+	{
+		for (auto const commandID : scheduler.takeReady())
+		{
+			inFlight.emplace(now + duration(commandID), commandID);
+			if (startTimes)
+			{
+				(*startTimes)[commandID] = now;
+			}
+		}
+		if (inFlight.empty())
+		{
+			break;
+		}
+		auto const it = inFlight.begin();
+		now = it->first;
+		if (completionTimes)
+		{
+			(*completionTimes)[it->second] = now;
+		}
+		EXPECT_TRUE(scheduler.complete(it->second));
+		inFlight.erase(it);
+	}
+	return now;
+}
+} // namespace
+
+TEST(CommandScheduler, IndependentChains)
+{
+	auto scheduler = Scheduler{};
+
+	// Stage 0 and 1 for entity 1, stage 2 and 3 for entity 2 (like the sample rate changes of 2 unrelated entities)
+	auto const e1s0 = scheduler.add(0u, { 1u });
+	auto const e1s1 = scheduler.add(1u, { 1u });
+	auto const e2s2 = scheduler.add(2u, { 2u });
+	auto const e2s3 = scheduler.add(3u, { 2u });
+
+	auto ready = scheduler.takeReady();
+	std::sort(ready.begin(), ready.end());
+	// First command of each chain can start immediately
+	ASSERT_EQ((std::vector<Scheduler::CommandID>{ e1s0, e2s2 }), ready);
+
+	EXPECT_TRUE(scheduler.complete(e2s2));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ e2s3 }), scheduler.takeReady());
+	EXPECT_FALSE(scheduler.complete(e2s2));
+	EXPECT_TRUE(scheduler.complete(e1s0));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ e1s1 }), scheduler.takeReady());
+	EXPECT_TRUE(scheduler.complete(e1s1));
+	EXPECT_TRUE(scheduler.complete(e2s3));
+	EXPECT_TRUE(scheduler.isFinished());
+	EXPECT_EQ(2u, scheduler.chainProgress(1u).totalCommands);
+	EXPECT_EQ(2u, scheduler.chainProgress(1u).completedCommands);
+}
+
+TEST(CommandScheduler, SharedEntityOrdering)
+{
+	auto scheduler = Scheduler{};
+
+	auto const e1 = scheduler.add(0u, { 1u });
+	auto const e2 = scheduler.add(0u, { 2u });
+	// Connection between 3 and 1 must wait for 1's previous stage
+	auto const e3e1 = scheduler.add(1u, { 3u, 1u });
+	auto const e3 = scheduler.add(2u, { 3u });
+
+	auto ready = scheduler.takeReady();
+	std::sort(ready.begin(), ready.end());
+	ASSERT_EQ((std::vector<Scheduler::CommandID>{ e1, e2 }), ready);
+	EXPECT_TRUE(scheduler.complete(e2));
+	EXPECT_TRUE(scheduler.takeReady().empty());
+	EXPECT_TRUE(scheduler.complete(e1));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ e3e1 }), scheduler.takeReady());
+	EXPECT_TRUE(scheduler.complete(e3e1));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ e3 }), scheduler.takeReady());
+}
+
+TEST(CommandScheduler, Barrier)
+{
+	auto scheduler = Scheduler{};
+
+	auto const e1 = scheduler.add(0u, { 1u });
+	auto const e2 = scheduler.add(1u, { 2u });
+	// Command without scope waits for everything before it
+	auto const barrier = scheduler.add(2u, {});
+	// Everything after it waits for the barrier
+	auto const e3 = scheduler.add(3u, { 3u });
+
+	auto ready = scheduler.takeReady();
+	std::sort(ready.begin(), ready.end());
+	ASSERT_EQ((std::vector<Scheduler::CommandID>{ e1, e2 }), ready);
+	EXPECT_TRUE(scheduler.complete(e1));
+	EXPECT_TRUE(scheduler.takeReady().empty());
+	EXPECT_TRUE(scheduler.complete(e2));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ barrier }), scheduler.takeReady());
+	EXPECT_TRUE(scheduler.complete(barrier));
+	EXPECT_EQ((std::vector<Scheduler::CommandID>{ e3 }), scheduler.takeReady());
+}
+
+TEST(CommandScheduler, InFlightWindow)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setMaxInFlightPerChain(2u);
+
+	for (auto i = 0u; i < 10u; ++i)
+	{
+		scheduler.add(0u, { 1u });
+		scheduler.add(0u, { 2u });
+	}
+
+	auto inFlightPerEntity = std::unordered_map<std::uint64_t, std::size_t>{};
+	auto maxInFlightPerEntity = std::size_t{ 0u };
+	auto pending = std::vector<Scheduler::CommandID>{};
+	while (!scheduler.isFinished())
+	{
+		for (auto const commandID : scheduler.takeReady())
+		{
+			auto& count = inFlightPerEntity[scheduler.scope(commandID).front()];
+			++count;
+			maxInFlightPerEntity = std::max(maxInFlightPerEntity, count);
+			pending.push_back(commandID);
+		}
+		ASSERT_FALSE(pending.empty());
+		auto const commandID = pending.front();
+		pending.erase(pending.begin());
+		--inFlightPerEntity[scheduler.scope(commandID).front()];
+		EXPECT_TRUE(scheduler.complete(commandID));
+	}
+	EXPECT_EQ(2u, maxInFlightPerEntity);
+}
+
+/** Simulates a media clock domain change of 64 devices (sample rate change: disconnect, set rate, reconnect, then clock connection to the master), with random device latencies */
+TEST(CommandScheduler, DomainChangeBenchmark)
+{
+	static constexpr auto DevicesCount = std::uint64_t{ 64u };
+	static constexpr auto StreamsPerDevice = 4u;
+	static constexpr auto MasterID = std::uint64_t{ 1000u };
+
+	auto generator = std::mt19937{ 42u };
+	auto latencyDistribution = std::uniform_int_distribution<std::uint64_t>{ 5u, 50u }; // Milliseconds
+	auto deviceLatencies = std::unordered_map<std::uint64_t, std::uint64_t>{};
+	for (auto device = std::uint64_t{ 0u }; device < DevicesCount; ++device)
+	{
+		deviceLatencies[device] = latencyDistribution(generator);
+	}
+	deviceLatencies[MasterID] = 10u;
+	// One slow device
+	deviceLatencies[DevicesCount / 2u] = 200u;
+
+	struct CommandInfo
+	{
+		std::uint64_t device{ 0u };
+		std::size_t stage{ 0u };
+	};
+	auto commandInfos = std::vector<CommandInfo>{};
+	auto const buildChain = [&commandInfos](Scheduler& scheduler, bool const withScopes)
+	{
+		commandInfos.clear();
+		auto const add = [&scheduler, &commandInfos, withScopes](std::size_t const stage, std::vector<std::uint64_t> const& entities)
+		{
+			scheduler.add(stage, withScopes ? entities : std::vector<std::uint64_t>{});
+			commandInfos.push_back(CommandInfo{ entities.front(), stage });
+		};
+		auto stage = std::size_t{ 0u };
+		for (auto device = std::uint64_t{ 0u }; device < DevicesCount; ++device)
+		{
+			// Disconnect all streams, change the sample rate, reconnect all streams
+			for (auto stream = 0u; stream < StreamsPerDevice; ++stream)
+			{
+				add(stage, { device });
+			}
+			++stage;
+			add(stage, { device });
+			++stage;
+			for (auto stream = 0u; stream < StreamsPerDevice; ++stream)
+			{
+				add(stage, { device });
+			}
+			++stage;
+		}
+		// Connect the clock stream of all devices to the master
+		for (auto device = std::uint64_t{ 0u }; device < DevicesCount; ++device)
+		{
+			add(stage, { device, MasterID });
+		}
+	};
+	auto const duration = [&deviceLatencies, &commandInfos](Scheduler::CommandID const commandID)
+	{
+		return deviceLatencies.at(commandInfos[commandID].device);
+	};
+
+	// Sequential execution (commands without scope)
+	auto sequential = Scheduler{};
+	buildChain(sequential, false);
+	auto const sequentialTime = simulate(sequential, duration);
+
+	// Pipelined execution
+	auto pipelined = Scheduler{};
+	pipelined.setMaxInFlightPerChain(4u);
+	buildChain(pipelined, true);
+	auto completionTimes = std::vector<std::uint64_t>{};
+	auto startTimes = std::vector<std::uint64_t>{};
+	auto const pipelinedTime = simulate(pipelined, duration, &completionTimes, &startTimes);
+
+	// Stage order is kept within each device chain
+	for (auto commandID = Scheduler::CommandID{ 0u }; commandID < pipelined.commandCount(); ++commandID)
+	{
+		for (auto nextID = commandID + 1u; nextID < pipelined.commandCount(); ++nextID)
+		{
+			if (commandInfos[nextID].device == commandInfos[commandID].device && commandInfos[nextID].stage > commandInfos[commandID].stage)
+			{
+				EXPECT_LE(completionTimes[commandID], startTimes[nextID]);
+			}
+		}
+	}
+
+	// Sequential time is the sum of all device chains, pipelined time is the slowest device chain (3 stages, then its clock connection)
+	auto expectedSequentialTime = std::uint64_t{ 0u };
+	for (auto device = std::uint64_t{ 0u }; device < DevicesCount; ++device)
+	{
+		expectedSequentialTime += 3u * deviceLatencies.at(device);
+	}
+	expectedSequentialTime += deviceLatencies.at(DevicesCount / 2u);
+	EXPECT_EQ(expectedSequentialTime, sequentialTime);
+	EXPECT_EQ(4u * deviceLatencies.at(DevicesCount / 2u), pipelinedTime);
+	EXPECT_LT(pipelinedTime * 5u, sequentialTime);
+
+	std::cout << "Domain change of " << DevicesCount << " devices: sequential " << sequentialTime << " ms, pipelined " << pipelinedTime << " ms" << std::endl;
+}
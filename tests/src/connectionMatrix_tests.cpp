@@ -25,9 +25,14 @@
 #include <gtest/gtest.h>
 #include <hive/modelsLibrary/controllerManager.hpp>
 #include <connectionMatrix/model.hpp>
+#include <connectionMatrix/intersectionMatrix.hpp>
+#include <connectionMatrix/sectionIndex.hpp>
+#include <connectionMatrix/paintHelper.hpp>
 
 #include <QString>
 #include <QModelIndex>
+#include <QImage>
+#include <QPainter>
 #ifdef _WIN32
 #	pragma warning(push)
 #	pragma warning(disable : 4127) // Disable conditional expression is constant
@@ -36,6 +41,18 @@
 #ifdef _WIN32
 #	pragma warning(pop)
 #endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
 namespace
 {
 class ConnectionMatrix_F : public ::testing::Test
@@ -2095,3 +2112,704 @@ TEST_F(ConnectionMatrix_F, EntityEntitySummary_NormalRedundant_ConnectedNoError_
 	}
 	validateIntersectionData(1, 4, connectionMatrix::Model::IntersectionData::Type::Entity_Entity, connectionMatrix::Model::IntersectionData::State::Connected, connectionMatrix::Model::IntersectionData::Flags{ connectionMatrix::Model::IntersectionData::Flag::MediaLocked });
 }
+
+/* *********************************
+   Intersection Matrix storage
+*/
+namespace
+{
+struct TestCell
+{
+	std::uint8_t type{ 0u };
+	std::uint8_t state{ 0u };
+	std::uint16_t flags{ 0u };
+};
+struct TestExtraData
+{
+	std::vector<connectionMatrix::Model::IntersectionData::SmartConnectableStream> smartConnectableStreams{};
+};
+using TestMatrix = connectionMatrix::IntersectionMatrix<TestCell, TestExtraData>;
+using LegacyMatrix = std::deque<std::deque<connectionMatrix::Model::IntersectionData>>;
+
+// Encodes the original (row, column) of a cell so it can be checked after other rows/columns have been inserted or removed
+void setCellTag(TestMatrix& matrix, int const row, int const column, std::uint16_t const rowTag, std::uint8_t const columnTag)
+{
+	auto& cell = matrix.cell(row, column);
+	cell.flags = rowTag;
+	cell.type = columnTag;
+	cell.state = 1u;
+}
+} // namespace
+
+TEST(IntersectionMatrix, InsertRemove)
+{
+	auto matrix = TestMatrix{};
+
+	matrix.insertRows(0, 3);
+	matrix.insertColumns(0, 4);
+	ASSERT_EQ(3, matrix.rowCount());
+	ASSERT_EQ(4, matrix.columnCount());
+
+	for (auto row = 0; row < 3; ++row)
+	{
+		for (auto column = 0; column < 4; ++column)
+		{
+			setCellTag(matrix, row, column, static_cast<std::uint16_t>(row), static_cast<std::uint8_t>(column));
+		}
+	}
+	matrix.createExtraData(2, 3).smartConnectableStreams.resize(2);
+	matrix.createExtraData(0, 1).smartConnectableStreams.resize(1);
+
+	// Insert in the middle, existing cells must follow and new ones must be default initialized
+	matrix.insertRows(1, 2);
+	matrix.insertColumns(2, 1);
+	ASSERT_EQ(5, matrix.rowCount());
+	ASSERT_EQ(5, matrix.columnCount());
+	for (auto const& [row, originalRow] : { std::pair{ 0, 0 }, std::pair{ 3, 1 }, std::pair{ 4, 2 } })
+	{
+		for (auto const& [column, originalColumn] : { std::pair{ 0, 0 }, std::pair{ 1, 1 }, std::pair{ 3, 2 }, std::pair{ 4, 3 } })
+		{
+			auto const& cell = matrix.cell(row, column);
+			EXPECT_EQ(originalRow, cell.flags);
+			EXPECT_EQ(originalColumn, cell.type);
+			EXPECT_EQ(1u, cell.state);
+		}
+		EXPECT_EQ(0u, matrix.cell(row, 2).state);
+	}
+	for (auto column = 0; column < 5; ++column)
+	{
+		EXPECT_EQ(0u, matrix.cell(1, column).state);
+		EXPECT_EQ(0u, matrix.cell(2, column).state);
+	}
+	ASSERT_NE(nullptr, matrix.extraData(4, 4));
+	EXPECT_EQ(2u, matrix.extraData(4, 4)->smartConnectableStreams.size());
+	ASSERT_NE(nullptr, matrix.extraData(0, 1));
+	EXPECT_EQ(nullptr, matrix.extraData(0, 2));
+
+	// Remove, extra data of removed cells must go away
+	matrix.removeColumns(4, 1);
+	EXPECT_EQ(1u, matrix.extraDataCount());
+	matrix.removeRows(0, 1);
+	EXPECT_EQ(0u, matrix.extraDataCount());
+	ASSERT_EQ(4, matrix.rowCount());
+	ASSERT_EQ(4, matrix.columnCount());
+	EXPECT_EQ(1u, matrix.cell(2, 0).flags);
+	EXPECT_EQ(2u, matrix.cell(3, 3).flags);
+	EXPECT_EQ(2u, matrix.cell(3, 3).type);
+
+	// Recycled slots must be default initialized
+	matrix.insertRows(0, 1);
+	matrix.insertColumns(0, 1);
+	for (auto column = 0; column < matrix.columnCount(); ++column)
+	{
+		EXPECT_EQ(0u, matrix.cell(0, column).state);
+	}
+	for (auto row = 0; row < matrix.rowCount(); ++row)
+	{
+		EXPECT_EQ(0u, matrix.cell(row, 0).state);
+	}
+	EXPECT_EQ(nullptr, matrix.extraData(0, 0));
+}
+
+/** Applies random insertions and removals of rows and columns (growing the column capacity and recycling slots), checking every cell and ExtraData against a reference nested vector after each operation */
+TEST(IntersectionMatrix, RandomInsertRemoveRemapping)
+{
+	struct ReferenceCell
+	{
+		std::uint16_t rowTag{ 0u };
+		std::uint8_t columnTag{ 0u };
+		bool isSet{ false };
+		std::size_t extraDataSize{ 0u }; // 0 for no ExtraData
+	};
+	using ReferenceMatrix = std::vector<std::vector<ReferenceCell>>;
+
+	auto matrix = TestMatrix{};
+	auto reference = ReferenceMatrix{};
+	auto referenceColumnCount = 0;
+	auto generator = std::mt19937{ 42u };
+	auto nextTag = std::uint16_t{ 1u };
+
+	auto const randomInt = [&generator](int const min, int const max)
+	{
+		return std::uniform_int_distribution<int>{ min, max }(generator);
+	};
+
+	auto const check = [&matrix, &reference, &referenceColumnCount]()
+	{
+		ASSERT_EQ(static_cast<int>(reference.size()), matrix.rowCount());
+		ASSERT_EQ(referenceColumnCount, matrix.columnCount());
+		auto extraDataCount = std::size_t{ 0u };
+		for (auto row = 0; row < matrix.rowCount(); ++row)
+		{
+			for (auto column = 0; column < matrix.columnCount(); ++column)
+			{
+				auto const& expected = reference[row][column];
+				auto const& cell = matrix.cell(row, column);
+				if (expected.isSet)
+				{
+					ASSERT_EQ(1u, cell.state);
+					ASSERT_EQ(expected.rowTag, cell.flags);
+					ASSERT_EQ(expected.columnTag, cell.type);
+				}
+				else
+				{
+					ASSERT_EQ(0u, cell.state);
+					ASSERT_EQ(0u, cell.flags);
+					ASSERT_EQ(0u, cell.type);
+				}
+				auto const* const extraData = matrix.extraData(row, column);
+				if (expected.extraDataSize != 0u)
+				{
+					ASSERT_NE(nullptr, extraData);
+					ASSERT_EQ(expected.extraDataSize, extraData->smartConnectableStreams.size());
+					++extraDataCount;
+				}
+				else
+				{
+					ASSERT_EQ(nullptr, extraData);
+				}
+			}
+		}
+		ASSERT_EQ(extraDataCount, matrix.extraDataCount());
+	};
+
+	for (auto operation = 0; operation < 400; ++operation)
+	{
+		switch (randomInt(0, 4))
+		{
+			case 0: // Insert rows
+			{
+				auto const first = randomInt(0, static_cast<int>(reference.size()));
+				auto const count = randomInt(1, 3);
+				matrix.insertRows(first, count);
+				reference.insert(std::next(std::begin(reference), first), count, std::vector<ReferenceCell>(referenceColumnCount));
+				break;
+			}
+			case 1: // Insert columns
+			{
+				auto const first = randomInt(0, referenceColumnCount);
+				auto const count = randomInt(1, 5);
+				matrix.insertColumns(first, count);
+				for (auto& row : reference)
+				{
+					row.insert(std::next(std::begin(row), first), count, ReferenceCell{});
+				}
+				referenceColumnCount += count;
+				break;
+			}
+			case 2: // Remove rows
+			{
+				if (reference.empty())
+				{
+					break;
+				}
+				auto const first = randomInt(0, static_cast<int>(reference.size()) - 1);
+				auto const count = randomInt(1, static_cast<int>(reference.size()) - first);
+				matrix.removeRows(first, count);
+				reference.erase(std::next(std::begin(reference), first), std::next(std::begin(reference), first + count));
+				break;
+			}
+			case 3: // Remove columns
+			{
+				if (referenceColumnCount == 0)
+				{
+					break;
+				}
+				auto const first = randomInt(0, referenceColumnCount - 1);
+				auto const count = randomInt(1, std::min(3, referenceColumnCount - first));
+				matrix.removeColumns(first, count);
+				for (auto& row : reference)
+				{
+					row.erase(std::next(std::begin(row), first), std::next(std::begin(row), first + count));
+				}
+				referenceColumnCount -= count;
+				break;
+			}
+			default: // Change some cells
+			{
+				if (reference.empty() || referenceColumnCount == 0)
+				{
+					break;
+				}
+				for (auto i = 0; i < 5; ++i)
+				{
+					auto const row = randomInt(0, static_cast<int>(reference.size()) - 1);
+					auto const column = randomInt(0, referenceColumnCount - 1);
+					auto& expected = reference[row][column];
+					auto const tag = nextTag++;
+					setCellTag(matrix, row, column, tag, static_cast<std::uint8_t>(tag));
+					expected = ReferenceCell{ tag, static_cast<std::uint8_t>(tag), true, expected.extraDataSize };
+					if (randomInt(0, 2) == 0)
+					{
+						expected.extraDataSize = static_cast<std::size_t>(randomInt(0, 2));
+						if (expected.extraDataSize != 0u)
+						{
+							matrix.createExtraData(row, column).smartConnectableStreams.resize(expected.extraDataSize);
+						}
+						else
+						{
+							matrix.removeExtraData(row, column);
+						}
+					}
+				}
+				break;
+			}
+		}
+		check();
+		if (::testing::Test::HasFatalFailure())
+		{
+			FAIL() << "Mismatch after operation " << operation;
+		}
+	}
+}
+
+/** Compares the memory used and the time spent inserting entities (in the middle of the matrix, as the model does) between the previous deque-of-deques layout and IntersectionMatrix, for a Channel mode matrix */
+TEST(IntersectionMatrix, MemoryAndInsertTime)
+{
+	static constexpr auto EntitiesCount = 96;
+	static constexpr auto SectionsPerEntity = 9; // Entity node + 8 channels
+	static constexpr auto SmartConnectableRatio = 64; // One intersection out of N has smart connectable streams
+
+	// Entities are inserted alternatively at the front and at the end of the matrix, always touching the middle of the existing data
+	auto const insertPosition = [](int const entityIndex, int const currentCount)
+	{
+		return (entityIndex % 2) ? currentCount / 2 : 0;
+	};
+
+	// Legacy layout
+	auto legacy = LegacyMatrix{};
+	auto const legacyStart = std::chrono::steady_clock::now();
+	for (auto entity = 0; entity < EntitiesCount; ++entity)
+	{
+		// Rows
+		auto const rowPosition = insertPosition(entity, static_cast<int>(legacy.size()));
+		auto const columnsCount = legacy.empty() ? std::size_t{ 0u } : legacy.front().size();
+		legacy.insert(std::next(std::begin(legacy), rowPosition), SectionsPerEntity, {});
+		for (auto row = rowPosition; row < rowPosition + SectionsPerEntity; ++row)
+		{
+			legacy[row].resize(columnsCount);
+		}
+		// Columns
+		auto const columnPosition = insertPosition(entity, static_cast<int>(columnsCount));
+		for (auto& row : legacy)
+		{
+			row.insert(std::next(std::begin(row), columnPosition), SectionsPerEntity, {});
+		}
+	}
+	auto cellIndex = std::size_t{ 0u };
+	auto smartConnectableMemory = std::size_t{ 0u };
+	for (auto& row : legacy)
+	{
+		for (auto& data : row)
+		{
+			data.state = connectionMatrix::Model::IntersectionData::State::Connected;
+			if ((cellIndex++ % SmartConnectableRatio) == 0)
+			{
+				data.smartConnectableStreams.resize(2);
+				smartConnectableMemory += data.smartConnectableStreams.capacity() * sizeof(connectionMatrix::Model::IntersectionData::SmartConnectableStream);
+			}
+		}
+	}
+	auto const legacyDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - legacyStart);
+	// Rough estimation of a deque memory usage (elements, plus its map of blocks)
+	auto legacyMemory = sizeof(LegacyMatrix) + legacy.size() * sizeof(LegacyMatrix::value_type) + smartConnectableMemory;
+	for (auto const& row : legacy)
+	{
+		legacyMemory += row.size() * sizeof(connectionMatrix::Model::IntersectionData) + row.size() * sizeof(void*) / 8;
+	}
+
+	// Compact layout
+	auto matrix = TestMatrix{};
+	auto const compactStart = std::chrono::steady_clock::now();
+	for (auto entity = 0; entity < EntitiesCount; ++entity)
+	{
+		matrix.insertRows(insertPosition(entity, matrix.rowCount()), SectionsPerEntity);
+		matrix.insertColumns(insertPosition(entity, matrix.columnCount()), SectionsPerEntity);
+	}
+	cellIndex = 0u;
+	smartConnectableMemory = 0u;
+	for (auto row = 0; row < matrix.rowCount(); ++row)
+	{
+		for (auto column = 0; column < matrix.columnCount(); ++column)
+		{
+			matrix.cell(row, column).state = 1u;
+			if ((cellIndex++ % SmartConnectableRatio) == 0)
+			{
+				auto& extraData = matrix.createExtraData(row, column);
+				extraData.smartConnectableStreams.resize(2);
+				smartConnectableMemory += extraData.smartConnectableStreams.capacity() * sizeof(connectionMatrix::Model::IntersectionData::SmartConnectableStream);
+			}
+		}
+	}
+	auto const compactDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - compactStart);
+	auto const compactMemory = matrix.memoryUsage() + smartConnectableMemory;
+
+	ASSERT_EQ(static_cast<int>(legacy.size()), matrix.rowCount());
+	ASSERT_EQ(static_cast<int>(legacy.front().size()), matrix.columnCount());
+	EXPECT_LT(compactMemory, legacyMemory);
+
+	std::cout << "Intersection matrix " << matrix.rowCount() << "x" << matrix.columnCount() << " (" << cellIndex << " intersections)" << std::endl;
+	std::cout << "  deque<deque<IntersectionData>>: " << (legacyMemory / 1024u) << " KiB, inserted in " << legacyDuration.count() << " us" << std::endl;
+	std::cout << "  IntersectionMatrix: " << (compactMemory / 1024u) << " KiB, inserted in " << compactDuration.count() << " us" << std::endl;
+}
+
+/* *********************************
+   Section Index
+*/
+namespace
+{
+struct TestNode
+{
+	std::uint64_t entityID{ 0u };
+	bool isEntity{ false };
+};
+using TestNodes = std::deque<TestNode const*>;
+using TestSectionIndex = connectionMatrix::SectionIndex<std::uint64_t, TestNode const*>;
+
+// Creates the flattened nodes of an entity (entity node followed by its children)
+std::vector<std::unique_ptr<TestNode>> createTestEntityNodes(std::uint64_t const entityID, std::size_t const childrenCount)
+{
+	auto nodes = std::vector<std::unique_ptr<TestNode>>{};
+	nodes.push_back(std::make_unique<TestNode>(TestNode{ entityID, true }));
+	for (auto child = 0u; child < childrenCount; ++child)
+	{
+		nodes.push_back(std::make_unique<TestNode>(TestNode{ entityID, false }));
+	}
+	return nodes;
+}
+
+TestNodes toTestNodes(std::vector<std::unique_ptr<TestNode>> const& nodes)
+{
+	auto testNodes = TestNodes{};
+	for (auto const& node : nodes)
+	{
+		testNodes.push_back(node.get());
+	}
+	return testNodes;
+}
+
+// Checks the index against the flattened list of nodes
+void validateSectionIndex(TestSectionIndex const& sectionIndex, TestNodes const& nodes)
+{
+	ASSERT_EQ(static_cast<int>(nodes.size()), sectionIndex.size());
+	for (auto section = 0; section < static_cast<int>(nodes.size()); ++section)
+	{
+		auto const* const node = nodes[section];
+		ASSERT_EQ(node, sectionIndex.item(section));
+		ASSERT_EQ(section, sectionIndex.section(node));
+		if (node->isEntity)
+		{
+			ASSERT_EQ(section, sectionIndex.section(node->entityID));
+		}
+	}
+}
+} // namespace
+
+TEST(SectionIndex, InsertRemove)
+{
+	auto sectionIndex = TestSectionIndex{};
+	auto nodes = TestNodes{};
+	auto entities = std::unordered_map<std::uint64_t, std::vector<std::unique_ptr<TestNode>>>{};
+	auto generator = std::mt19937{ 42u };
+
+	// Randomly insert and remove entities, comparing with the flattened list
+	for (auto iteration = 0u; iteration < 2000u; ++iteration)
+	{
+		auto const entityID = std::uint64_t{ generator() % 200u };
+		if (auto const it = entities.find(entityID); it == std::end(entities))
+		{
+			auto entityNodes = createTestEntityNodes(entityID, generator() % 6u);
+			auto const testNodes = toTestNodes(entityNodes);
+
+			// Reference insertion index (sorted by entityID)
+			auto first = 0;
+			while (first < static_cast<int>(nodes.size()) && nodes[first]->entityID <= entityID)
+			{
+				++first;
+			}
+			ASSERT_EQ(first, sectionIndex.insertionSection(entityID));
+			ASSERT_EQ(first, sectionIndex.insert(entityID, testNodes));
+			ASSERT_EQ(-1, sectionIndex.insert(entityID, testNodes));
+			nodes.insert(std::next(std::begin(nodes), first), std::begin(testNodes), std::end(testNodes));
+			entities.emplace(entityID, std::move(entityNodes));
+		}
+		else
+		{
+			auto const first = sectionIndex.section(entityID);
+			ASSERT_NE(-1, first);
+			nodes.erase(std::next(std::begin(nodes), first), std::next(std::begin(nodes), first + static_cast<int>(it->second.size())));
+			ASSERT_TRUE(sectionIndex.remove(entityID));
+			ASSERT_EQ(-1, sectionIndex.section(it->second.front().get()));
+			entities.erase(it);
+		}
+
+		if ((iteration % 50u) == 0u)
+		{
+			validateSectionIndex(sectionIndex, nodes);
+			if (HasFatalFailure())
+			{
+				return;
+			}
+		}
+	}
+	validateSectionIndex(sectionIndex, nodes);
+	EXPECT_EQ(static_cast<int>(entities.size()), sectionIndex.blockCount());
+	EXPECT_FALSE(sectionIndex.remove(1000u));
+	EXPECT_EQ(-1, sectionIndex.section(std::uint64_t{ 1000u }));
+}
+
+/** Brings entities online one at a time (in random entityID order), and compares the time spent maintaining the section caches between the previous full rebuild and the SectionIndex */
+TEST(SectionIndex, EntitiesOnlineBenchmark)
+{
+	static constexpr auto EntitiesCount = 1000u;
+	static constexpr auto ChildrenPerEntity = 8u;
+
+	auto generator = std::mt19937{ 42u };
+	auto entityIDs = std::vector<std::uint64_t>{};
+	auto entities = std::vector<std::vector<std::unique_ptr<TestNode>>>{};
+	for (auto entity = 0u; entity < EntitiesCount; ++entity)
+	{
+		entityIDs.push_back(0x001B92FFFE000000 + entity);
+	}
+	std::shuffle(std::begin(entityIDs), std::end(entityIDs), generator);
+	for (auto const entityID : entityIDs)
+	{
+		entities.push_back(createTestEntityNodes(entityID, ChildrenPerEntity));
+	}
+
+	// Previous implementation: linear search of the insertion index, then full rebuild of the NodeSection and EntitySection maps
+	auto legacyNodes = TestNodes{};
+	auto legacyNodeSectionMap = std::unordered_map<TestNode const*, int>{};
+	auto legacyEntitySectionMap = std::unordered_map<std::uint64_t, int>{};
+	auto const legacyStart = std::chrono::steady_clock::now();
+	for (auto const& entityNodes : entities)
+	{
+		auto const entityID = entityNodes.front()->entityID;
+		auto first = 0;
+		for (auto const* node : legacyNodes)
+		{
+			if (node->entityID > entityID)
+			{
+				break;
+			}
+			++first;
+		}
+		auto const testNodes = toTestNodes(entityNodes);
+		legacyNodes.insert(std::next(std::begin(legacyNodes), first), std::begin(testNodes), std::end(testNodes));
+
+		legacyNodeSectionMap = {};
+		legacyEntitySectionMap = {};
+		for (auto section = 0u; section < legacyNodes.size(); ++section)
+		{
+			auto const* const node = legacyNodes[section];
+			if (node->isEntity)
+			{
+				legacyEntitySectionMap.insert(std::make_pair(node->entityID, section));
+			}
+			legacyNodeSectionMap.insert(std::make_pair(node, section));
+		}
+	}
+	auto const legacyDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - legacyStart);
+
+	// SectionIndex
+	auto nodes = TestNodes{};
+	auto sectionIndex = TestSectionIndex{};
+	auto const start = std::chrono::steady_clock::now();
+	for (auto const& entityNodes : entities)
+	{
+		auto const entityID = entityNodes.front()->entityID;
+		auto const first = sectionIndex.insertionSection(entityID);
+		auto const testNodes = toTestNodes(entityNodes);
+		nodes.insert(std::next(std::begin(nodes), first), std::begin(testNodes), std::end(testNodes));
+		sectionIndex.insert(entityID, testNodes);
+	}
+	auto const duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	ASSERT_EQ(legacyNodes, nodes);
+	validateSectionIndex(sectionIndex, nodes);
+	for (auto const& [node, section] : legacyNodeSectionMap)
+	{
+		ASSERT_EQ(section, sectionIndex.section(node));
+	}
+	for (auto const& [entityID, section] : legacyEntitySectionMap)
+	{
+		ASSERT_EQ(section, sectionIndex.section(entityID));
+	}
+
+	std::cout << "Bringing " << EntitiesCount << " entities online (" << nodes.size() << " sections)" << std::endl;
+	std::cout << "  Full section maps rebuild: " << legacyDuration.count() << " us" << std::endl;
+	std::cout << "  SectionIndex: " << duration.count() << " us" << std::endl;
+}
+
+/* *********************************
+   Capabilities Glyph Atlas
+*/
+namespace
+{
+struct TestIntersection
+{
+	connectionMatrix::Model::IntersectionData::Type type{ connectionMatrix::Model::IntersectionData::Type::None };
+	connectionMatrix::Model::IntersectionData::State state{ connectionMatrix::Model::IntersectionData::State::NotConnected };
+	connectionMatrix::Model::IntersectionData::Flags flags{};
+};
+
+// Builds a synthetic (Channel mode like) matrix: mostly not connected channels, a few connected ones, some with errors, entity summaries every 9 sections
+std::vector<TestIntersection> buildSyntheticIntersections(int const talkersCount, int const listenersCount)
+{
+	using IntersectionData = connectionMatrix::Model::IntersectionData;
+
+	auto generator = std::mt19937{ 42u };
+	auto intersections = std::vector<TestIntersection>(static_cast<std::size_t>(talkersCount) * listenersCount);
+	for (auto talker = 0; talker < talkersCount; ++talker)
+	{
+		for (auto listener = 0; listener < listenersCount; ++listener)
+		{
+			auto& intersection = intersections[static_cast<std::size_t>(talker) * listenersCount + listener];
+			auto const random = generator() % 100u;
+			if ((talker % 9) == 0 || (listener % 9) == 0)
+			{
+				intersection.type = ((talker % 9) == 0 && (listener % 9) == 0) ? IntersectionData::Type::Entity_Entity : IntersectionData::Type::Entity_SingleChannel;
+			}
+			else if (talker / 9 == listener / 9)
+			{
+				intersection.type = IntersectionData::Type::None;
+			}
+			else
+			{
+				intersection.type = IntersectionData::Type::SingleChannel_SingleChannel;
+			}
+			if (random < 5u)
+			{
+				intersection.state = IntersectionData::State::Connected;
+				intersection.flags.set(IntersectionData::Flag::MediaLocked);
+			}
+			else if (random < 7u)
+			{
+				intersection.state = IntersectionData::State::PartiallyConnected;
+			}
+			if (random % 10u == 1u)
+			{
+				intersection.flags.set(IntersectionData::Flag::WrongDomain);
+			}
+			else if (random % 10u == 2u)
+			{
+				intersection.flags.set(IntersectionData::Flag::WrongFormatPossible);
+			}
+		}
+	}
+	return intersections;
+}
+} // namespace
+
+TEST(CapabilitiesGlyphAtlas, SameResultAsDirectDrawing)
+{
+	using IntersectionData = connectionMatrix::Model::IntersectionData;
+
+	auto argc = 0;
+	auto app = QApplication{ argc, nullptr };
+
+	static constexpr auto CellSize = 20;
+	auto const intersections = buildSyntheticIntersections(36, 36);
+
+	auto directImage = QImage{ 36 * CellSize, 36 * CellSize, QImage::Format_ARGB32_Premultiplied };
+	auto atlasImage = QImage{ directImage.size(), QImage::Format_ARGB32_Premultiplied };
+	directImage.fill(Qt::white);
+	atlasImage.fill(Qt::white);
+
+	auto atlas = connectionMatrix::paintHelper::CapabilitiesGlyphAtlas{};
+	{
+		auto directPainter = QPainter{ &directImage };
+		auto atlasPainter = QPainter{ &atlasImage };
+		for (auto talker = 0; talker < 36; ++talker)
+		{
+			for (auto listener = 0; listener < 36; ++listener)
+			{
+				auto const& intersection = intersections[talker * 36 + listener];
+				auto const rect = QRect{ listener * CellSize, talker * CellSize, CellSize, CellSize };
+				connectionMatrix::paintHelper::drawCapabilities(&directPainter, rect, intersection.type, intersection.state, intersection.flags, true, false, true);
+				atlas.draw(&atlasPainter, rect, intersection.type, intersection.state, intersection.flags, true, false, true);
+			}
+		}
+	}
+	EXPECT_GT(atlas.glyphCount(), 0);
+
+	// Glyphs are blended from the atlas instead of drawn directly, allow small rounding differences on antialiased pixels
+	auto maxDifference = 0;
+	for (auto y = 0; y < directImage.height(); ++y)
+	{
+		for (auto x = 0; x < directImage.width(); ++x)
+		{
+			auto const direct = directImage.pixelColor(x, y);
+			auto const cached = atlasImage.pixelColor(x, y);
+			maxDifference = std::max({ maxDifference, std::abs(direct.red() - cached.red()), std::abs(direct.green() - cached.green()), std::abs(direct.blue() - cached.blue()) });
+		}
+	}
+	EXPECT_LE(maxDifference, 8);
+
+	// Changing a drawing option must not reuse the same glyphs
+	auto const glyphCount = atlas.glyphCount();
+	{
+		auto atlasPainter = QPainter{ &atlasImage };
+		atlas.draw(&atlasPainter, QRect{ 0, 0, CellSize, CellSize }, IntersectionData::Type::Entity_Entity, IntersectionData::State::Connected, IntersectionData::Flags{ IntersectionData::Flag::MediaLocked }, false, false, true);
+	}
+	EXPECT_EQ(glyphCount + 1, atlas.glyphCount());
+	atlas.clear();
+	EXPECT_EQ(0, atlas.glyphCount());
+}
+
+/** Paints a 4K viewport scrolling over a synthetic 2000x2000 matrix, comparing direct drawing with the glyph atlas */
+TEST(CapabilitiesGlyphAtlas, PaintBenchmark)
+{
+	auto argc = 0;
+	auto app = QApplication{ argc, nullptr };
+
+	static constexpr auto MatrixSize = 2000;
+	static constexpr auto CellSize = 20;
+	static constexpr auto ViewportWidth = 3840;
+	static constexpr auto ViewportHeight = 2160;
+	static constexpr auto FramesCount = 10;
+
+	auto const intersections = buildSyntheticIntersections(MatrixSize, MatrixSize);
+	auto viewport = QImage{ ViewportWidth, ViewportHeight, QImage::Format_ARGB32_Premultiplied };
+	auto const columns = ViewportWidth / CellSize;
+	auto const rows = ViewportHeight / CellSize;
+
+	auto const paintFrames = [&](auto const& drawIntersection)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		for (auto frame = 0; frame < FramesCount; ++frame)
+		{
+			// Scroll diagonally through the matrix
+			auto const firstTalker = frame * (MatrixSize - rows) / FramesCount;
+			auto const firstListener = frame * (MatrixSize - columns) / FramesCount;
+			viewport.fill(Qt::white);
+			auto painter = QPainter{ &viewport };
+			for (auto row = 0; row < rows; ++row)
+			{
+				for (auto column = 0; column < columns; ++column)
+				{
+					auto const& intersection = intersections[static_cast<std::size_t>(firstTalker + row) * MatrixSize + firstListener + column];
+					drawIntersection(&painter, QRect{ column * CellSize, row * CellSize, CellSize, CellSize }, intersection);
+				}
+			}
+		}
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	};
+
+	auto const directDuration = paintFrames(
+		[](QPainter* painter, QRect const& rect, TestIntersection const& intersection)
+		{
+			connectionMatrix::paintHelper::drawCapabilities(painter, rect, intersection.type, intersection.state, intersection.flags, true, false, true);
+		});
+
+	auto atlas = connectionMatrix::paintHelper::CapabilitiesGlyphAtlas{};
+	auto const atlasDuration = paintFrames(
+		[&atlas](QPainter* painter, QRect const& rect, TestIntersection const& intersection)
+		{
+			atlas.draw(painter, rect, intersection.type, intersection.state, intersection.flags, true, false, true);
+		});
+
+	std::cout << "Painting " << FramesCount << " frames of " << (rows * columns) << " intersections (" << MatrixSize << "x" << MatrixSize << " matrix)" << std::endl;
+	std::cout << "  drawCapabilities: " << directDuration.count() << " ms" << std::endl;
+	std::cout << "  CapabilitiesGlyphAtlas: " << atlasDuration.count() << " ms (" << atlas.glyphCount() << " glyphs)" << std::endl;
+}
@@ -0,0 +1,236 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file controlledEntityTreeModel_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/controllerManager.hpp>
+#include <controlledEntityTreeModel.hpp>
+
+#include <QApplication>
+#include <QAbstractItemModelTester>
+#ifdef _WIN32
+#	pragma warning(push)
+#	pragma warning(disable : 4127) // Disable conditional expression is constant
+#endif
+#include <QTest>
+#ifdef _WIN32
+#	pragma warning(pop)
+#endif
+
+#include <cstddef>
+
+namespace
+{
+static constexpr auto TalkerEntityID = la::avdecc::UniqueIdentifier{ 0x001B92FFFE0222BF };
+
+/** Creates the children of all the nodes below parent, returns the number of nodes below parent */
+std::size_t fetchAll(ControlledEntityTreeModel& model, QModelIndex const& parent)
+{
+	if (model.canFetchMore(parent))
+	{
+		model.fetchMore(parent);
+	}
+
+	auto count = std::size_t{ 0u };
+	for (auto row = 0; row < model.rowCount(parent); ++row)
+	{
+		count += 1u + fetchAll(model, model.index(row, 0, parent));
+	}
+	return count;
+}
+
+class ControlledEntityTreeModel_F : public ::testing::Test
+{
+public:
+	virtual void SetUp() override
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		QObject::connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOnline, &_app,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				if (entityID == TalkerEntityID)
+				{
+					_isOnline = true;
+				}
+			});
+		QObject::connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOffline, &_app,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				if (entityID == TalkerEntityID)
+				{
+					_isOnline = false;
+				}
+			});
+		QObject::connect(&_model, &QAbstractItemModel::modelReset, &_app,
+			[this]()
+			{
+				++_modelResetsCount;
+			});
+
+		createController();
+		loadEntities();
+	}
+
+	virtual void TearDown() override
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		controllerManager.destroyController();
+		QTest::qWait(10); // Flush Qt EventLoop
+	}
+
+	void createController()
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		try
+		{
+			controllerManager.createController(la::avdecc::protocol::ProtocolInterface::Type::Virtual, "Unit Tests", 0x0001, la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), "en", nullptr);
+		}
+		catch (la::avdecc::controller::Controller::Exception const&)
+		{
+			ASSERT_FALSE(true);
+		}
+	}
+
+	void loadEntities()
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		auto const flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
+		auto const [error, message] = controllerManager.loadVirtualEntitiesFromJsonNetworkState("data/connectionMatrix/1-Normal_Normal-ConnectedNoError_WrongFormat.json", flags);
+		ASSERT_EQ(la::avdecc::jsonSerializer::DeserializationError::NoError, error) << message;
+		ASSERT_TRUE(QTest::qWaitFor(
+			[this]()
+			{
+				return _isOnline;
+			}));
+	}
+
+protected:
+	int x{ 0 };
+	QApplication _app{ x, nullptr };
+	ControlledEntityTreeModel _model{};
+	// Checks the model consistency each time it changes (aborts on failure)
+	QAbstractItemModelTester _tester{ &_model, QAbstractItemModelTester::FailureReportingMode::Fatal };
+	bool _isOnline{ false };
+	std::size_t _modelResetsCount{ 0u };
+};
+} // namespace
+
+/** Only the Entity node is created on load, the other nodes when their parent is fetched */
+TEST_F(ControlledEntityTreeModel_F, FetchMore)
+{
+	_model.load(TalkerEntityID);
+	ASSERT_EQ(1, _model.rowCount());
+
+	auto const entityIndex = _model.index(0, 0);
+	EXPECT_EQ(la::avdecc::entity::model::DescriptorType::Entity, _model.getIdentifier(entityIndex).type);
+	EXPECT_TRUE(_model.hasChildren(entityIndex));
+	EXPECT_TRUE(_model.canFetchMore(entityIndex));
+	EXPECT_EQ(0, _model.rowCount(entityIndex));
+
+	// Children of the Entity only
+	_model.fetchMore(entityIndex);
+	EXPECT_FALSE(_model.canFetchMore(entityIndex));
+	auto const entityRowCount = _model.rowCount(entityIndex);
+	ASSERT_LT(0, entityRowCount);
+	for (auto row = 0; row < entityRowCount; ++row)
+	{
+		EXPECT_EQ(0, _model.rowCount(_model.index(row, 0, entityIndex)));
+	}
+
+	// Fetched only once
+	_model.fetchMore(entityIndex);
+	EXPECT_EQ(entityRowCount, _model.rowCount(entityIndex));
+
+	// Whole tree
+	EXPECT_LT(static_cast<std::size_t>(entityRowCount), fetchAll(_model, entityIndex));
+
+	// Nodes can be found back from their path
+	auto const lastIndex = _model.index(entityRowCount - 1, 0, entityIndex);
+	EXPECT_EQ(lastIndex, _model.fetchIndex(_model.getPath(lastIndex)));
+}
+
+/** Reloading removes the fetched nodes, and creates the same ones when fetched again */
+TEST_F(ControlledEntityTreeModel_F, Reload)
+{
+	_model.load(TalkerEntityID);
+	auto const nodesCount = fetchAll(_model, {});
+	ASSERT_LT(1u, nodesCount);
+
+	_modelResetsCount = 0u;
+	_model.load(TalkerEntityID);
+	EXPECT_EQ(1u, _modelResetsCount);
+	ASSERT_EQ(1, _model.rowCount());
+	EXPECT_TRUE(_model.canFetchMore(_model.index(0, 0)));
+	EXPECT_EQ(0, _model.rowCount(_model.index(0, 0)));
+
+	EXPECT_EQ(nodesCount, fetchAll(_model, {}));
+}
+
+/** Nodes loaded before the entity went offline are never fetched, not even once it is back online */
+TEST_F(ControlledEntityTreeModel_F, Offline)
+{
+	auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+
+	_model.load(TalkerEntityID);
+	auto const entityIndex = _model.index(0, 0);
+	ASSERT_TRUE(_model.canFetchMore(entityIndex));
+
+	// Offline
+	ASSERT_TRUE(controllerManager.unloadVirtualEntity(TalkerEntityID));
+	ASSERT_TRUE(QTest::qWaitFor(
+		[this]()
+		{
+			return !_isOnline;
+		}));
+	_model.notifyEntityOnlineChanged(TalkerEntityID);
+	_model.fetchMore(entityIndex);
+	EXPECT_EQ(0, _model.rowCount(entityIndex));
+
+	// Back online (with a new entity model), the model not being reloaded yet
+	controllerManager.destroyController();
+	createController();
+	loadEntities();
+	_model.notifyEntityOnlineChanged(TalkerEntityID);
+	_model.fetchMore(entityIndex);
+	EXPECT_EQ(0, _model.rowCount(entityIndex));
+
+	// Reloaded
+	_model.load(TalkerEntityID);
+	EXPECT_LT(1u, fetchAll(_model, {}));
+	auto const entityPath = _model.getPath(_model.index(0, 0));
+
+	// Offline again, the model being reset
+	ASSERT_TRUE(controllerManager.unloadVirtualEntity(TalkerEntityID));
+	ASSERT_TRUE(QTest::qWaitFor(
+		[this]()
+		{
+			return !_isOnline;
+		}));
+	_model.notifyEntityOnlineChanged(TalkerEntityID);
+	_modelResetsCount = 0u;
+	_model.load({});
+	EXPECT_EQ(1u, _modelResetsCount);
+	EXPECT_EQ(0, _model.rowCount());
+	EXPECT_FALSE(_model.hasChildren());
+	EXPECT_FALSE(_model.fetchIndex(entityPath).isValid());
+}
@@ -0,0 +1,146 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file counterHistory_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <counters/counterHistory.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using namespace std::chrono_literals;
+
+} // namespace
+
+TEST(CounterHistory, NoStorageUntilFirstChange)
+{
+	auto history = CounterHistory{};
+	EXPECT_FALSE(history.update(10s, 5u, true)); // First sample is the reference value
+	EXPECT_FALSE(history.update(11s, 5u, true));
+	EXPECT_FALSE(history.hasStorage());
+	EXPECT_EQ(0u, history.getDelta(11s, 10s));
+
+	EXPECT_TRUE(history.update(12s, 7u, true));
+	EXPECT_TRUE(history.hasStorage());
+	EXPECT_FALSE(history.update(13s, 9u, true)); // Already allocated
+	EXPECT_EQ(4u, history.getTotal());
+	EXPECT_EQ(13s, history.getLastIncrementTime());
+}
+
+TEST(CounterHistory, AllocationNotAllowed)
+{
+	auto history = CounterHistory{};
+	history.update(0s, 0u, false);
+	EXPECT_FALSE(history.update(1s, 3u, false));
+	EXPECT_FALSE(history.update(2s, 4u, false));
+	EXPECT_FALSE(history.hasStorage());
+	EXPECT_EQ(2u, history.getDroppedIncrements());
+	EXPECT_EQ(0u, history.getDelta(2s, 10s));
+}
+
+TEST(CounterHistory, DeltaAndRate)
+{
+	auto history = CounterHistory{};
+	history.update(1000s, 100u, true);
+	// +1 every second during 100 seconds
+	for (auto i = 1; i <= 100; ++i)
+	{
+		history.update(1000s + std::chrono::seconds{ i }, 100u + i, true);
+	}
+	auto const now = 1100s;
+	EXPECT_EQ(10u, history.getDelta(now, 10s));
+	EXPECT_EQ(100u, history.getDelta(now, 100s));
+	EXPECT_EQ(100u, history.getDelta(now, 200s)); // Nothing before
+	EXPECT_DOUBLE_EQ(1.0, history.getRate(now, 60s));
+
+	// Nothing during 30 seconds: buckets since the last change are empty
+	EXPECT_EQ(0u, history.getDelta(now + 30s, 30s));
+	EXPECT_EQ(10u, history.getDelta(now + 30s, 40s));
+}
+
+TEST(CounterHistory, CoarserTiers)
+{
+	auto history = CounterHistory{};
+	history.update(0s, 0u, true);
+	// +60 every minute during 3 hours (beyond the seconds and minutes tiers)
+	auto value = std::uint64_t{ 0u };
+	for (auto minute = 1; minute <= 180; ++minute)
+	{
+		value += 60u;
+		history.update(std::chrono::minutes{ minute }, value, true);
+	}
+	auto const now = std::chrono::seconds{ std::chrono::minutes{ 180 } };
+	EXPECT_EQ(60u, history.getDelta(now, 1min)); // Seconds tier
+	EXPECT_EQ(600u, history.getDelta(now, 10min)); // Minutes tier
+	EXPECT_EQ(3600u, history.getDelta(now, 1h)); // Minutes tier
+	EXPECT_EQ(7260u, history.getDelta(now, 3h)); // Hours tier: the current (partial) hour and the 2 previous ones (since 60min)
+	EXPECT_EQ(10800u, history.getDelta(now, 4h));
+	EXPECT_EQ(10800u, history.getDelta(now, 48h));
+	EXPECT_EQ(10800u, history.getDelta(now, 1000h)); // Clamped to the hours tier
+}
+
+TEST(CounterHistory, LongGapWrapsTheRings)
+{
+	auto history = CounterHistory{};
+	history.update(0s, 0u, true);
+	history.update(1s, 5u, true);
+	// Next change after more than the capacity of every tier
+	history.update(100h, 8u, true);
+	EXPECT_EQ(3u, history.getDelta(100h, 1s));
+	EXPECT_EQ(3u, history.getDelta(100h, 48h));
+	EXPECT_EQ(8u, history.getTotal());
+}
+
+TEST(CounterHistory, Increments)
+{
+	auto history = CounterHistory{};
+	history.update(0s, 0u, true);
+	history.update(10s, 2u, true);
+	history.update(12s, 3u, true);
+	history.update(12s, 7u, true); // Same bucket
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u, 0u, 5u, 0u }), history.getIncrements(CounterHistory::Tier::Seconds, 13s, 4u));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 7u }), history.getIncrements(CounterHistory::Tier::Minutes, 13s, 1u));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 0u, 0u }), CounterHistory{}.getIncrements(CounterHistory::Tier::Hours, 13s, 2u));
+}
+
+TEST(CounterHistory, WrapAndReset)
+{
+	EXPECT_EQ(5u, CounterHistory::computeIncrement(10u, 15u));
+	EXPECT_EQ(0x12u, CounterHistory::computeIncrement(0xFFFFFFF0u, 0x2u)); // 32-bit wrap
+	EXPECT_EQ(3u, CounterHistory::computeIncrement(1000u, 3u)); // Reset
+	EXPECT_EQ(3u, CounterHistory::computeIncrement(0x100000000ull, 3u)); // 64-bit counters never wrap
+
+	auto history = CounterHistory{};
+	history.update(0s, 0xFFFFFFFEu, true);
+	history.update(1s, 1u, true);
+	EXPECT_EQ(3u, history.getTotal());
+}
+
+TEST(CounterHistory, StorageSize)
+{
+	// Hard memory bound of a changing counter
+	EXPECT_EQ(468u * sizeof(std::uint64_t), CounterHistory::StorageSize);
+}
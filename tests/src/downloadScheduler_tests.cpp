@@ -0,0 +1,196 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file downloadScheduler_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/widgetModelsLibrary/downloadScheduler.hpp>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+// Downloads identified by a model name, requested by logos, from entities
+using Scheduler = hive::widgetModelsLibrary::DownloadScheduler<std::string, std::string, int>;
+using Started = std::tuple<std::string, int, std::string>;
+
+/** Starts the downloads, recording them (all sources are usable, except the specified ones) */
+std::vector<Started> startDownloads(Scheduler& scheduler, std::vector<int> const& unusableSources = {})
+{
+	auto started = std::vector<Started>{};
+	scheduler.startDownloads(
+		[&started, &unusableSources](std::string const& downloadKey, int const source, std::string const& requestKey)
+		{
+			if (std::find(unusableSources.begin(), unusableSources.end(), source) != unusableSources.end())
+			{
+				return false;
+			}
+			started.emplace_back(downloadKey, source, requestKey);
+			return true;
+		});
+	return started;
+}
+} // namespace
+
+TEST(DownloadScheduler, PriorityOrder)
+{
+	auto scheduler = Scheduler{ 1u };
+	scheduler.request("L", 5, "logo5", Scheduler::Priority::Low);
+	scheduler.request("A", 1, "logo1", Scheduler::Priority::Normal);
+	scheduler.request("B", 2, "logo2", Scheduler::Priority::Normal);
+	scheduler.request("C", 3, "logo3", Scheduler::Priority::High);
+
+	// High priority first
+	EXPECT_EQ((std::vector<Started>{ Started{ "C", 3, "logo3" } }), startDownloads(scheduler));
+
+	// Promoted while queued
+	scheduler.promote("logo2");
+	EXPECT_EQ(1u, scheduler.complete("C", 3, true).size());
+	EXPECT_EQ((std::vector<Started>{ Started{ "B", 2, "logo2" } }), startDownloads(scheduler));
+
+	// Then in request order
+	scheduler.request("D", 4, "logo4", Scheduler::Priority::Normal);
+	scheduler.complete("B", 2, true);
+	EXPECT_EQ((std::vector<Started>{ Started{ "A", 1, "logo1" } }), startDownloads(scheduler));
+	scheduler.complete("A", 1, true);
+	EXPECT_EQ((std::vector<Started>{ Started{ "D", 4, "logo4" } }), startDownloads(scheduler));
+	scheduler.complete("D", 4, true);
+
+	// Low priority last
+	EXPECT_EQ((std::vector<Started>{ Started{ "L", 5, "logo5" } }), startDownloads(scheduler));
+	scheduler.complete("L", 5, true);
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+}
+
+TEST(DownloadScheduler, InFlightLimit)
+{
+	auto scheduler = Scheduler{ 2u };
+	for (auto source = 0; source < 5; ++source)
+	{
+		scheduler.request("Model" + std::to_string(source), source, "logo" + std::to_string(source), Scheduler::Priority::Normal);
+	}
+
+	EXPECT_EQ(2u, startDownloads(scheduler).size());
+	EXPECT_EQ(2u, scheduler.inFlightCount());
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+
+	scheduler.complete("Model0", 0, true);
+	EXPECT_EQ(1u, scheduler.inFlightCount());
+	EXPECT_EQ((std::vector<Started>{ Started{ "Model2", 2, "logo2" } }), startDownloads(scheduler));
+	EXPECT_EQ(2u, scheduler.inFlightCount());
+}
+
+TEST(DownloadScheduler, OneDownloadPerSource)
+{
+	auto scheduler = Scheduler{ 4u };
+	scheduler.request("Entity", 1, "entityLogo1", Scheduler::Priority::Normal);
+	scheduler.request("Manufacturer", 1, "manufacturerLogo1", Scheduler::Priority::Normal);
+
+	// Same source, only one at a time
+	EXPECT_EQ((std::vector<Started>{ Started{ "Entity", 1, "entityLogo1" } }), startDownloads(scheduler));
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+
+	scheduler.complete("Entity", 1, true);
+	EXPECT_EQ((std::vector<Started>{ Started{ "Manufacturer", 1, "manufacturerLogo1" } }), startDownloads(scheduler));
+}
+
+TEST(DownloadScheduler, SharedDownload)
+{
+	auto scheduler = Scheduler{ 4u };
+	scheduler.request("Model", 1, "logo1", Scheduler::Priority::Normal);
+	scheduler.request("Model", 2, "logo2", Scheduler::Priority::Normal);
+	scheduler.request("Model", 2, "logo2", Scheduler::Priority::Normal); // Already requested
+	EXPECT_TRUE(scheduler.isRequested("logo1"));
+	EXPECT_TRUE(scheduler.isRequested("logo2"));
+
+	// Downloaded once
+	EXPECT_EQ((std::vector<Started>{ Started{ "Model", 1, "logo1" } }), startDownloads(scheduler));
+
+	// Failed, retried from the other source
+	EXPECT_TRUE(scheduler.complete("Model", 1, false).empty());
+	EXPECT_FALSE(scheduler.isRequested("logo1"));
+	EXPECT_EQ((std::vector<Started>{ Started{ "Model", 2, "logo2" } }), startDownloads(scheduler));
+
+	// Joining a download in flight
+	scheduler.request("Model", 3, "logo3", Scheduler::Priority::Normal);
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+	auto const requesters = scheduler.complete("Model", 2, true);
+	EXPECT_EQ((std::vector<Scheduler::Requester>{ { 2, "logo2" }, { 3, "logo3" } }), requesters);
+	EXPECT_FALSE(scheduler.isRequested("logo2"));
+	EXPECT_FALSE(scheduler.isRequested("logo3"));
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+}
+
+TEST(DownloadScheduler, UnusableSource)
+{
+	auto scheduler = Scheduler{ 4u };
+	scheduler.request("Model", 1, "logo1", Scheduler::Priority::Normal);
+	scheduler.request("Model", 2, "logo2", Scheduler::Priority::Normal);
+
+	// First source is gone, its request is dropped
+	EXPECT_EQ((std::vector<Started>{ Started{ "Model", 2, "logo2" } }), startDownloads(scheduler, { 1 }));
+	EXPECT_FALSE(scheduler.isRequested("logo1"));
+
+	// All sources gone
+	scheduler.request("Other", 3, "logo3", Scheduler::Priority::Normal);
+	EXPECT_TRUE(startDownloads(scheduler, { 3 }).empty());
+	EXPECT_FALSE(scheduler.isRequested("logo3"));
+	EXPECT_EQ(1u, scheduler.inFlightCount());
+}
+
+TEST(DownloadScheduler, Cancellation)
+{
+	auto scheduler = Scheduler{ 1u };
+	scheduler.request("A", 1, "logo1", Scheduler::Priority::Normal);
+	scheduler.request("B", 2, "logo2", Scheduler::Priority::Normal);
+	scheduler.request("B", 3, "logo3", Scheduler::Priority::Normal);
+	scheduler.request("C", 3, "logo3bis", Scheduler::Priority::Normal);
+
+	// Cancel a queued request
+	scheduler.cancel("logo1");
+	EXPECT_FALSE(scheduler.isRequested("logo1"));
+	EXPECT_EQ((std::vector<Started>{ Started{ "B", 2, "logo2" } }), startDownloads(scheduler));
+
+	// Cancel a source, in flight downloads still count until completed, and are no longer served
+	scheduler.cancelSource(2);
+	scheduler.cancelSource(3);
+	EXPECT_FALSE(scheduler.isRequested("logo2"));
+	EXPECT_FALSE(scheduler.isRequested("logo3"));
+	EXPECT_FALSE(scheduler.isRequested("logo3bis"));
+	EXPECT_EQ(1u, scheduler.inFlightCount());
+	EXPECT_TRUE(scheduler.complete("B", 2, true).empty());
+	EXPECT_EQ(0u, scheduler.inFlightCount());
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+
+	// Cancel everything
+	scheduler.request("D", 4, "logo4", Scheduler::Priority::Normal);
+	scheduler.request("E", 5, "logo5", Scheduler::Priority::Normal);
+	EXPECT_EQ(1u, startDownloads(scheduler).size());
+	scheduler.cancelAll();
+	EXPECT_FALSE(scheduler.isRequested("logo4"));
+	EXPECT_FALSE(scheduler.isRequested("logo5"));
+	EXPECT_TRUE(scheduler.complete("D", 4, true).empty());
+	EXPECT_TRUE(startDownloads(scheduler).empty());
+}
@@ -0,0 +1,157 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file entityModelCacheIndex_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/entityModelCacheIndex.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Index = hive::modelsLibrary::EntityModelCacheIndex;
+
+std::vector<std::uint8_t> makeFile(std::size_t const size, std::uint8_t const seed)
+{
+	auto file = std::vector<std::uint8_t>(size);
+	for (auto i = std::size_t{ 0u }; i < size; ++i)
+	{
+		file[i] = static_cast<std::uint8_t>(seed + i * 7u);
+	}
+	return file;
+}
+
+Index::Record makeRecord(std::uint64_t const entityModelID, std::vector<std::uint8_t> const& file, std::string const& checksum)
+{
+	return Index::Record{ entityModelID, 5u, checksum, file.size(), Index::computeHash(file.data(), file.size()) };
+}
+
+} // namespace
+
+TEST(EntityModelCacheIndex, EmptyRoundTrip)
+{
+	auto const data = Index{}.serialize();
+	auto const index = Index::parse(data.data(), data.size());
+	ASSERT_TRUE(index.has_value());
+	EXPECT_TRUE(index->getRecords().empty());
+}
+
+TEST(EntityModelCacheIndex, RoundTrip)
+{
+	auto index = Index{};
+	auto const file1 = makeFile(1000u, 1u);
+	auto const file2 = makeFile(50000u, 2u);
+	EXPECT_TRUE(index.setRecord(makeRecord(0x001B92FFFE000001ull, file1, std::string(64u, 'A'))));
+	EXPECT_TRUE(index.setRecord(makeRecord(0x001B92FFFE000002ull, file2, "1234ABCD")));
+
+	auto const data = index.serialize();
+	auto const parsed = Index::parse(data.data(), data.size());
+	ASSERT_TRUE(parsed.has_value());
+	EXPECT_EQ(index.getRecords(), parsed->getRecords());
+
+	auto const* const record = parsed->getRecord(0x001B92FFFE000002ull);
+	ASSERT_NE(nullptr, record);
+	EXPECT_EQ("1234ABCD", record->checksum);
+	EXPECT_EQ(5u, record->checksumVersion);
+	EXPECT_TRUE(Index::isValidFile(*record, file2.data(), file2.size()));
+	EXPECT_EQ(nullptr, parsed->getRecord(0x001B92FFFE000003ull));
+}
+
+TEST(EntityModelCacheIndex, ReplaceAndRemove)
+{
+	auto index = Index{};
+	auto const file = makeFile(100u, 3u);
+	index.setRecord(makeRecord(1u, file, "OLD"));
+	index.setRecord(makeRecord(1u, file, "NEW"));
+	ASSERT_EQ(1u, index.getRecords().size());
+	EXPECT_EQ("NEW", index.getRecord(1u)->checksum);
+
+	EXPECT_TRUE(index.removeRecord(1u));
+	EXPECT_FALSE(index.removeRecord(1u));
+	EXPECT_TRUE(index.getRecords().empty());
+}
+
+TEST(EntityModelCacheIndex, ChecksumTooLong)
+{
+	auto index = Index{};
+	EXPECT_FALSE(index.setRecord(makeRecord(1u, {}, std::string(Index::MaxChecksumLength + 1u, 'A'))));
+	EXPECT_TRUE(index.getRecords().empty());
+}
+
+TEST(EntityModelCacheIndex, CorruptedIndexIsRejected)
+{
+	auto index = Index{};
+	auto const file = makeFile(100u, 4u);
+	index.setRecord(makeRecord(1u, file, "CHECKSUM"));
+	auto const data = index.serialize();
+
+	// Any flipped byte
+	for (auto i = std::size_t{ 0u }; i < data.size(); ++i)
+	{
+		auto corrupted = data;
+		corrupted[i] ^= 0x40u;
+		EXPECT_FALSE(Index::parse(corrupted.data(), corrupted.size()).has_value()) << "Byte " << i;
+	}
+
+	// Truncated or extended
+	EXPECT_FALSE(Index::parse(data.data(), data.size() - 1u).has_value());
+	auto extended = data;
+	extended.push_back(0u);
+	EXPECT_FALSE(Index::parse(extended.data(), extended.size()).has_value());
+	EXPECT_FALSE(Index::parse(nullptr, 0u).has_value());
+	EXPECT_FALSE(Index::parse(data.data(), 4u).has_value());
+}
+
+TEST(EntityModelCacheIndex, OtherFormatVersionIsRejected)
+{
+	auto data = Index{}.serialize();
+	data[4] = static_cast<std::uint8_t>(Index::FormatVersion + 1u);
+	// Fix the content hash so only the version differs
+	auto const contentSize = data.size() - 8u;
+	auto const hash = Index::computeHash(data.data(), contentSize);
+	for (auto i = std::size_t{ 0u }; i < 8u; ++i)
+	{
+		data[contentSize + i] = static_cast<std::uint8_t>(hash >> (8u * i));
+	}
+	EXPECT_FALSE(Index::parse(data.data(), data.size()).has_value());
+}
+
+TEST(EntityModelCacheIndex, InvalidFile)
+{
+	auto const file = makeFile(1000u, 5u);
+	auto const record = makeRecord(1u, file, "CHECKSUM");
+	EXPECT_TRUE(Index::isValidFile(record, file.data(), file.size()));
+
+	// Truncated
+	EXPECT_FALSE(Index::isValidFile(record, file.data(), file.size() - 1u));
+
+	// Modified
+	auto modified = file;
+	modified[500] ^= 0x01u;
+	EXPECT_FALSE(Index::isValidFile(record, modified.data(), modified.size()));
+
+	// Missing
+	EXPECT_FALSE(Index::isValidFile(record, nullptr, 0u));
+}
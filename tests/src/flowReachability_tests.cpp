@@ -0,0 +1,353 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file flowReachability_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <QtMate/flow/flowReachability.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Reachability = qtMate::flow::FlowReachability;
+using Node = Reachability::Node;
+
+/** Reference graph, answering reachability queries with a traversal */
+class Graph final
+{
+public:
+	void addNode(Node const node)
+	{
+		_successors.try_emplace(node);
+	}
+
+	void removeNode(Node const node)
+	{
+		_successors.erase(node);
+		for (auto& [from, successors] : _successors)
+		{
+			successors.erase(node);
+		}
+	}
+
+	void addEdge(Node const from, Node const to)
+	{
+		++_successors.at(from)[to];
+	}
+
+	void removeEdge(Node const from, Node const to)
+	{
+		auto& successors = _successors.at(from);
+		if (auto const it = successors.find(to); it != successors.end() && --it->second == 0u)
+		{
+			successors.erase(it);
+		}
+	}
+
+	bool reaches(Node const from, Node const to) const
+	{
+		if (_successors.count(from) == 0u || _successors.count(to) == 0u)
+		{
+			return false;
+		}
+		auto visited = std::set<Node>{};
+		auto pending = std::vector<Node>{ from };
+		while (!pending.empty())
+		{
+			auto const node = pending.back();
+			pending.pop_back();
+			for (auto const& [successor, count] : _successors.at(node))
+			{
+				if (successor == to)
+				{
+					return true;
+				}
+				if (visited.insert(successor).second)
+				{
+					pending.push_back(successor);
+				}
+			}
+		}
+		return false;
+	}
+
+	std::vector<Node> nodes() const
+	{
+		auto nodes = std::vector<Node>{};
+		for (auto const& [node, successors] : _successors)
+		{
+			nodes.push_back(node);
+		}
+		return nodes;
+	}
+
+private:
+	std::map<Node, std::map<Node, std::size_t>> _successors{};
+};
+
+void checkReachability(Reachability const& reachability, Graph const& graph)
+{
+	auto const nodes = graph.nodes();
+	ASSERT_EQ(nodes.size(), reachability.nodesCount());
+	for (auto const from : nodes)
+	{
+		for (auto const to : nodes)
+		{
+			ASSERT_EQ(graph.reaches(from, to), reachability.reaches(from, to)) << from << " -> " << to;
+		}
+	}
+}
+
+} // namespace
+
+TEST(FlowReachability, Paths)
+{
+	auto reachability = Reachability{};
+	for (auto node = Node{ 0u }; node < 4u; ++node)
+	{
+		reachability.addNode(node);
+	}
+
+	// 0 -> 1 -> 2, 3 alone
+	EXPECT_TRUE(reachability.addEdge(0u, 1u));
+	EXPECT_TRUE(reachability.addEdge(1u, 2u));
+	EXPECT_TRUE(reachability.reaches(0u, 2u));
+	EXPECT_FALSE(reachability.reaches(2u, 0u));
+	EXPECT_FALSE(reachability.reaches(0u, 0u));
+	EXPECT_FALSE(reachability.reaches(0u, 3u));
+	EXPECT_TRUE(reachability.wouldCreateCycle(2u, 0u));
+	EXPECT_TRUE(reachability.wouldCreateCycle(3u, 3u));
+	EXPECT_FALSE(reachability.wouldCreateCycle(2u, 3u));
+
+	// Cycles are refused
+	EXPECT_FALSE(reachability.addEdge(2u, 0u));
+	EXPECT_FALSE(reachability.addEdge(1u, 1u));
+	EXPECT_EQ(2u, reachability.edgesCount());
+
+	// Unknown nodes
+	EXPECT_FALSE(reachability.addEdge(0u, 42u));
+	EXPECT_FALSE(reachability.reaches(0u, 42u));
+
+	reachability.removeEdge(1u, 2u);
+	EXPECT_TRUE(reachability.reaches(0u, 1u));
+	EXPECT_FALSE(reachability.reaches(0u, 2u));
+	EXPECT_TRUE(reachability.addEdge(2u, 0u));
+	EXPECT_TRUE(reachability.reaches(2u, 1u));
+}
+
+TEST(FlowReachability, MultipleEdges)
+{
+	auto reachability = Reachability{};
+	reachability.addNode(0u);
+	reachability.addNode(1u);
+	reachability.addEdge(0u, 1u);
+	reachability.addEdge(0u, 1u);
+	EXPECT_EQ(2u, reachability.edgesCount());
+
+	// Still connected by the other edge
+	reachability.removeEdge(0u, 1u);
+	EXPECT_TRUE(reachability.reaches(0u, 1u));
+
+	reachability.removeEdge(0u, 1u);
+	EXPECT_FALSE(reachability.reaches(0u, 1u));
+	EXPECT_EQ(0u, reachability.edgesCount());
+}
+
+TEST(FlowReachability, RemoveNode)
+{
+	auto reachability = Reachability{};
+	for (auto node = Node{ 0u }; node < 3u; ++node)
+	{
+		reachability.addNode(node);
+	}
+	reachability.addEdge(0u, 1u);
+	reachability.addEdge(1u, 2u);
+
+	reachability.removeNode(1u);
+	EXPECT_EQ(2u, reachability.nodesCount());
+	EXPECT_EQ(0u, reachability.edgesCount());
+	EXPECT_FALSE(reachability.reaches(0u, 2u));
+
+	// The index of the removed node is reused, without any stale path
+	reachability.addNode(3u);
+	EXPECT_FALSE(reachability.reaches(0u, 3u));
+	EXPECT_TRUE(reachability.addEdge(3u, 0u));
+	EXPECT_TRUE(reachability.reaches(3u, 0u));
+}
+
+TEST(FlowReachability, RandomEditsMatchTraversal)
+{
+	static constexpr auto NodesCount = Node{ 150u };
+
+	for (auto const seed : { 1u, 2u, 3u })
+	{
+		auto generator = std::mt19937{ seed };
+		auto nodeDistribution = std::uniform_int_distribution<Node>{ 0u, NodesCount - 1u };
+		auto actionDistribution = std::uniform_int_distribution<int>{ 0, 99 };
+
+		auto reachability = Reachability{};
+		auto graph = Graph{};
+		auto edges = std::vector<std::pair<Node, Node>>{};
+
+		for (auto step = 0; step < 3000; ++step)
+		{
+			auto const action = actionDistribution(generator);
+			auto const from = nodeDistribution(generator);
+			auto const to = nodeDistribution(generator);
+			if (action < 10)
+			{
+				reachability.addNode(from);
+				graph.addNode(from);
+			}
+			else if (action < 12)
+			{
+				reachability.removeNode(from);
+				graph.removeNode(from);
+				edges.erase(std::remove_if(edges.begin(), edges.end(),
+											[from](auto const& edge)
+											{
+												return edge.first == from || edge.second == from;
+											}),
+					edges.end());
+			}
+			else if (action < 70)
+			{
+				auto const wouldCreateCycle = from == to || graph.reaches(to, from);
+				auto const added = reachability.addEdge(from, to);
+				auto const nodes = graph.nodes();
+				auto const exists = std::binary_search(nodes.begin(), nodes.end(), from) && std::binary_search(nodes.begin(), nodes.end(), to);
+				ASSERT_EQ(exists && !wouldCreateCycle, added);
+				if (added)
+				{
+					graph.addEdge(from, to);
+					edges.emplace_back(from, to);
+				}
+			}
+			else if (!edges.empty())
+			{
+				auto const edgeIndex = std::uniform_int_distribution<std::size_t>{ 0u, edges.size() - 1u }(generator);
+				auto const [edgeFrom, edgeTo] = edges[edgeIndex];
+				edges.erase(edges.begin() + edgeIndex);
+				reachability.removeEdge(edgeFrom, edgeTo);
+				graph.removeEdge(edgeFrom, edgeTo);
+			}
+
+			ASSERT_EQ(edges.size(), reachability.edgesCount());
+			if (step % 100 == 0)
+			{
+				checkReachability(reachability, graph);
+			}
+		}
+		checkReachability(reachability, graph);
+	}
+}
+
+TEST(FlowReachability, Benchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto NodesCount = Node{ 500u };
+	static constexpr auto EdgesCount = std::size_t{ 2000u };
+	static constexpr auto QueriesCount = std::size_t{ 5000u };
+
+	auto const toUs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+
+	auto generator = std::mt19937{ 42u };
+	auto nodeDistribution = std::uniform_int_distribution<Node>{ 0u, NodesCount - 1u };
+
+	auto reachability = Reachability{};
+	auto graph = Graph{};
+	for (auto node = Node{ 0u }; node < NodesCount; ++node)
+	{
+		reachability.addNode(node);
+		graph.addNode(node);
+	}
+
+	// Build a DAG only adding the edges which do not create a cycle
+	auto edges = std::vector<std::pair<Node, Node>>{};
+	auto startTime = Clock::now();
+	while (edges.size() < EdgesCount)
+	{
+		auto const from = nodeDistribution(generator);
+		auto const to = nodeDistribution(generator);
+		if (reachability.addEdge(from, to))
+		{
+			edges.emplace_back(from, to);
+		}
+	}
+	auto const buildDuration = Clock::now() - startTime;
+	for (auto const& [from, to] : edges)
+	{
+		graph.addEdge(from, to);
+	}
+
+	auto queries = std::vector<std::pair<Node, Node>>{};
+	for (auto query = std::size_t{ 0u }; query < QueriesCount; ++query)
+	{
+		queries.emplace_back(nodeDistribution(generator), nodeDistribution(generator));
+	}
+
+	// Cycle checks using the index
+	auto indexCycles = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto const& [from, to] : queries)
+	{
+		indexCycles += reachability.wouldCreateCycle(from, to);
+	}
+	auto const indexDuration = Clock::now() - startTime;
+
+	// Cycle checks using a traversal
+	auto traversalCycles = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto const& [from, to] : queries)
+	{
+		traversalCycles += from == to || graph.reaches(to, from);
+	}
+	auto const traversalDuration = Clock::now() - startTime;
+	EXPECT_EQ(traversalCycles, indexCycles);
+
+	// Remove and add back edges
+	startTime = Clock::now();
+	for (auto change = std::size_t{ 0u }; change < 200u; ++change)
+	{
+		auto const& [from, to] = edges[(change * 7919u) % edges.size()];
+		reachability.removeEdge(from, to);
+		EXPECT_TRUE(reachability.addEdge(from, to));
+	}
+	auto const updateDuration = Clock::now() - startTime;
+
+	std::cout << "Reachability of " << NodesCount << " nodes and " << EdgesCount << " edges:" << std::endl;
+	std::cout << "  Build: " << toUs(buildDuration) << " us" << std::endl;
+	std::cout << "  " << QueriesCount << " cycle checks: " << toUs(indexDuration) << " us with the index, " << toUs(traversalDuration) << " us with a traversal (" << indexCycles << " cycles)" << std::endl;
+	std::cout << "  Remove and add back an edge: " << toUs(updateDuration) / 200 << " us average" << std::endl;
+}
@@ -0,0 +1,344 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file layeredLayout_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <connectionEditor/layeredLayout.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Edges = std::vector<std::pair<LayeredLayout::Node, LayeredLayout::Node>>;
+
+/** Random DAG: edges always go from a lower to a higher node */
+Edges makeRandomDag(std::size_t const nodesCount, std::size_t const edgesCount, std::uint32_t const seed)
+{
+	auto generator = std::mt19937{ seed };
+	auto distribution = std::uniform_int_distribution<LayeredLayout::Node>{ 0u, nodesCount - 1u };
+	auto edges = Edges{};
+	while (edges.size() < edgesCount)
+	{
+		auto from = distribution(generator);
+		auto to = distribution(generator);
+		if (from == to)
+		{
+			continue;
+		}
+		edges.emplace_back(std::min(from, to), std::max(from, to));
+	}
+	return edges;
+}
+
+void fill(LayeredLayout& layout, std::size_t const nodesCount, Edges const& edges)
+{
+	for (auto node = LayeredLayout::Node{ 0u }; node < nodesCount; ++node)
+	{
+		layout.addNode(node);
+	}
+	for (auto const& [from, to] : edges)
+	{
+		layout.addEdge(from, to);
+	}
+}
+
+/** Longest path from a root computed by exploring all paths (reference) */
+std::vector<std::size_t> referenceLayers(std::size_t const nodesCount, Edges const& edges)
+{
+	auto layers = std::vector<std::size_t>(nodesCount, 0u);
+	// Nodes are in topological order
+	auto sortedEdges = edges;
+	std::sort(sortedEdges.begin(), sortedEdges.end());
+	for (auto const& [from, to] : sortedEdges)
+	{
+		layers[to] = std::max(layers[to], layers[from] + 1u);
+	}
+	return layers;
+}
+
+void checkLayout(LayeredLayout const& layout, std::size_t const nodesCount, Edges const& edges)
+{
+	auto const expectedLayers = referenceLayers(nodesCount, edges);
+	for (auto node = LayeredLayout::Node{ 0u }; node < nodesCount; ++node)
+	{
+		auto const position = layout.position(node);
+		ASSERT_TRUE(!!position);
+		EXPECT_EQ(expectedLayers[node], position->layer);
+		EXPECT_EQ(node, layout.layers()[position->layer][position->rank]);
+	}
+	auto count = std::size_t{ 0u };
+	for (auto const& layer : layout.layers())
+	{
+		EXPECT_FALSE(layer.empty());
+		count += layer.size();
+	}
+	EXPECT_EQ(nodesCount, count);
+}
+} // namespace
+
+TEST(LayeredLayout, LongestPathLayers)
+{
+	auto layout = LayeredLayout{};
+	// 0 -> 1 -> 2 -> 3, 0 -> 3, 4 -> 2
+	auto const edges = Edges{ { 0u, 1u }, { 1u, 2u }, { 2u, 3u }, { 0u, 3u }, { 4u, 2u } };
+	fill(layout, 5u, edges);
+
+	auto const changed = layout.update();
+	EXPECT_EQ(5u, changed.size());
+	EXPECT_EQ(4u, layout.layers().size());
+	checkLayout(layout, 5u, edges);
+	EXPECT_EQ(5u, layout.edgesCount());
+
+	// Nothing changed
+	EXPECT_TRUE(layout.update().empty());
+}
+
+TEST(LayeredLayout, CrossingReduction)
+{
+	auto layout = LayeredLayout{};
+	// Two sources, each connected to the sink on the opposite side
+	// 0 -> 3, 1 -> 2, added in an order which crosses
+	layout.addNode(0u);
+	layout.addNode(1u);
+	layout.addNode(2u);
+	layout.addNode(3u);
+	layout.addEdge(0u, 3u);
+	layout.addEdge(1u, 2u);
+	layout.update();
+
+	EXPECT_EQ(0u, layout.crossingsCount());
+	auto const position0 = layout.position(0u);
+	auto const position3 = layout.position(3u);
+	EXPECT_EQ(position0->rank, position3->rank);
+}
+
+TEST(LayeredLayout, IncrementalUpdate)
+{
+	auto layout = LayeredLayout{};
+	// Two independent chains: 0 -> 1 -> 2 and 10 -> 11 -> 12
+	auto edges = Edges{ { 0u, 1u }, { 1u, 2u }, { 10u, 11u }, { 11u, 12u } };
+	for (auto const node : { 0u, 1u, 2u, 10u, 11u, 12u })
+	{
+		layout.addNode(node);
+	}
+	for (auto const& [from, to] : edges)
+	{
+		layout.addEdge(from, to);
+	}
+	layout.update();
+
+	// Connecting 2 -> 11 pushes 11 and 12 to the next layers, the first chain doesn't move
+	layout.addEdge(2u, 11u);
+	auto changed = layout.update();
+	std::sort(changed.begin(), changed.end());
+	EXPECT_EQ((std::vector<LayeredLayout::Node>{ 11u, 12u }), changed);
+	EXPECT_EQ(3u, layout.position(11u)->layer);
+	EXPECT_EQ(4u, layout.position(12u)->layer);
+
+	// Removing it moves them back
+	layout.removeEdge(2u, 11u);
+	changed = layout.update();
+	std::sort(changed.begin(), changed.end());
+	EXPECT_EQ((std::vector<LayeredLayout::Node>{ 11u, 12u }), changed);
+	EXPECT_EQ(1u, layout.position(11u)->layer);
+
+	// Removing a node removes its edges
+	layout.removeNode(1u);
+	EXPECT_EQ(2u, layout.edgesCount());
+	layout.update();
+	EXPECT_FALSE(layout.isConnected(0u));
+	EXPECT_EQ(0u, layout.position(2u)->layer);
+	EXPECT_FALSE(!!layout.position(1u));
+}
+
+TEST(LayeredLayout, MultipleEdges)
+{
+	auto layout = LayeredLayout{};
+	layout.addNode(0u);
+	layout.addNode(1u);
+	layout.addEdge(0u, 1u);
+	layout.addEdge(0u, 1u);
+	layout.update();
+	EXPECT_EQ(1u, layout.position(1u)->layer);
+
+	// Still connected by the other edge
+	layout.removeEdge(0u, 1u);
+	EXPECT_TRUE(layout.update().empty());
+	EXPECT_TRUE(layout.isConnected(1u));
+
+	layout.removeEdge(0u, 1u);
+	layout.update();
+	EXPECT_EQ(0u, layout.position(1u)->layer);
+	EXPECT_FALSE(layout.isConnected(1u));
+}
+
+TEST(LayeredLayout, Cycle)
+{
+	auto layout = LayeredLayout{};
+	// 0 -> 1 -> 2 -> 1
+	fill(layout, 3u, Edges{ { 0u, 1u }, { 1u, 2u }, { 2u, 1u } });
+	layout.update();
+	EXPECT_EQ(0u, layout.position(0u)->layer);
+	EXPECT_EQ(0u, layout.position(1u)->layer);
+	EXPECT_EQ(0u, layout.position(2u)->layer);
+}
+
+TEST(LayeredLayout, RandomGraphs)
+{
+	for (auto seed = std::uint32_t{ 1u }; seed <= 20u; ++seed)
+	{
+		auto const edges = makeRandomDag(60u, 150u, seed);
+		auto layout = LayeredLayout{};
+		fill(layout, 60u, edges);
+		layout.update();
+		checkLayout(layout, 60u, edges);
+
+		// Incrementally remove half of the edges, the layout is the same as a new one
+		auto remainingEdges = Edges{ edges.begin(), edges.begin() + 75 };
+		for (auto index = std::size_t{ 75u }; index < edges.size(); ++index)
+		{
+			layout.removeEdge(edges[index].first, edges[index].second);
+			if (index % 10u == 0u)
+			{
+				layout.update();
+			}
+		}
+		layout.update();
+		checkLayout(layout, 60u, remainingEdges);
+	}
+}
+
+/** Layout of a 500 nodes, 5000 edges graph, compared to the previous algorithm (which explored every path from each root) */
+TEST(LayeredLayout, Benchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto NodesCount = std::size_t{ 500u };
+	static constexpr auto EdgesCount = std::size_t{ 5000u };
+	static constexpr auto IncrementalChanges = std::size_t{ 200u };
+
+	auto const toUs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+
+	auto const edges = makeRandomDag(NodesCount, EdgesCount, 42u);
+
+	// Full layout
+	auto layout = LayeredLayout{};
+	fill(layout, NodesCount, edges);
+	auto startTime = Clock::now();
+	layout.update();
+	auto const fullDuration = Clock::now() - startTime;
+	checkLayout(layout, NodesCount, edges);
+
+	// Crossings without reordering (nodes in id order in each layer)
+	auto unorderedCrossings = std::size_t{ 0u };
+	{
+		auto positions = std::vector<std::pair<std::size_t, std::size_t>>(NodesCount);
+		auto layerSizes = std::vector<std::size_t>(layout.layers().size(), 0u);
+		for (auto node = std::size_t{ 0u }; node < NodesCount; ++node)
+		{
+			auto const layer = layout.position(node)->layer;
+			positions[node] = { layer, layerSizes[layer]++ };
+		}
+		for (auto lhs = std::size_t{ 0u }; lhs < edges.size(); ++lhs)
+		{
+			auto const& [lhsFrom, lhsTo] = edges[lhs];
+			if (positions[lhsTo].first != positions[lhsFrom].first + 1u)
+			{
+				continue;
+			}
+			for (auto rhs = lhs + 1u; rhs < edges.size(); ++rhs)
+			{
+				auto const& [rhsFrom, rhsTo] = edges[rhs];
+				if (positions[rhsFrom].first != positions[lhsFrom].first || positions[rhsTo].first != positions[lhsTo].first)
+				{
+					continue;
+				}
+				auto const fromOrder = static_cast<int>(positions[lhsFrom].second) - static_cast<int>(positions[rhsFrom].second);
+				auto const toOrder = static_cast<int>(positions[lhsTo].second) - static_cast<int>(positions[rhsTo].second);
+				unorderedCrossings += (fromOrder < 0 && toOrder > 0) || (fromOrder > 0 && toOrder < 0);
+			}
+		}
+	}
+	auto const crossings = layout.crossingsCount();
+	EXPECT_LT(crossings, unorderedCrossings);
+
+	// Incremental updates: remove and add back an edge
+	auto movedNodes = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto change = std::size_t{ 0u }; change < IncrementalChanges; ++change)
+	{
+		auto const& [from, to] = edges[(change * 7919u) % edges.size()];
+		layout.removeEdge(from, to);
+		movedNodes += layout.update().size();
+		layout.addEdge(from, to);
+		movedNodes += layout.update().size();
+	}
+	auto const incrementalDuration = Clock::now() - startTime;
+
+	// Previous algorithm: recursive traversal from each root, recording a depth candidate for each path (stopped after a visits budget)
+	static constexpr auto MaxVisits = std::size_t{ 20000000u };
+	auto successors = std::vector<std::set<LayeredLayout::Node>>(NodesCount);
+	auto hasPredecessor = std::vector<bool>(NodesCount, false);
+	for (auto const& [from, to] : edges)
+	{
+		successors[from].insert(to);
+		hasPredecessor[to] = true;
+	}
+	auto visits = std::size_t{ 0u };
+	auto traverse = std::function<void(LayeredLayout::Node)>{};
+	traverse = [&](LayeredLayout::Node const node)
+	{
+		if (++visits >= MaxVisits)
+		{
+			return;
+		}
+		for (auto const successor : successors[node])
+		{
+			traverse(successor);
+		}
+	};
+	startTime = Clock::now();
+	for (auto node = LayeredLayout::Node{ 0u }; node < NodesCount && visits < MaxVisits; ++node)
+	{
+		if (!hasPredecessor[node])
+		{
+			traverse(node);
+		}
+	}
+	auto const traverseDuration = Clock::now() - startTime;
+
+	std::cout << "Layered layout of " << NodesCount << " nodes and " << EdgesCount << " edges (" << layout.layers().size() << " layers):" << std::endl;
+	std::cout << "  Full layout: " << toUs(fullDuration) << " us, " << crossings << " crossings (" << unorderedCrossings << " without reordering)" << std::endl;
+	std::cout << "  Incremental update: " << toUs(incrementalDuration) / static_cast<long long>(2u * IncrementalChanges) << " us average, " << movedNodes / (2u * IncrementalChanges) << " moved nodes average" << std::endl;
+	std::cout << "  Path traversal: " << (visits >= MaxVisits ? "stopped after " : "") << visits << " visits in " << toUs(traverseDuration) << " us" << std::endl;
+}
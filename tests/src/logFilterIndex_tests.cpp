@@ -0,0 +1,329 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file logFilterIndex_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/logFilterIndex.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+enum class Layer
+{
+	Generic,
+	Protocol,
+	Controller,
+};
+
+enum class Level
+{
+	Trace,
+	Debug,
+	Info,
+	Warn,
+	Error,
+};
+
+using Index = avdecc::LogFilterIndex<Layer, Level>;
+using Sequence = Index::Sequence;
+
+Layer layerFor(Sequence const sequence)
+{
+	return static_cast<Layer>(sequence % 3u);
+}
+
+Level levelFor(Sequence const sequence)
+{
+	return static_cast<Level>((sequence / 3u) % 5u);
+}
+
+/** Deterministic message for a sequence (messages repeat after 512000 entries, so huge logs don't have to be stored) */
+std::string_view messageFor(Sequence const sequence)
+{
+	static constexpr auto DistinctMessages = std::size_t{ 512000u };
+	static auto const s_messages = []()
+	{
+		auto const templates = std::vector<std::string>{ "Received AECP response from", "Sending ACMP command to", "Entity went online:", "Stream input counters changed for", "Timeout waiting for response of", "GET_STREAM_INFO failed for", "Media clock master changed for" };
+		auto messages = std::vector<std::string>{};
+		messages.reserve(DistinctMessages);
+		for (auto index = std::size_t{ 0u }; index < DistinctMessages; ++index)
+		{
+			messages.push_back(templates[index % templates.size()] + " entity 0x001B92FFFE" + std::to_string(index % 4096u) + " index " + std::to_string(index % 1000u));
+		}
+		return messages;
+	}();
+	return s_messages[static_cast<std::size_t>(sequence % DistinctMessages)];
+}
+
+/** Reference implementation, testing each entry */
+std::vector<Sequence> naiveFind(Index::Filter const& filter, Sequence const begin, Sequence const end, std::string const& text)
+{
+	auto result = std::vector<Sequence>{};
+	for (auto sequence = begin; sequence < end; ++sequence)
+	{
+		if (filter.layers && std::find(filter.layers->begin(), filter.layers->end(), layerFor(sequence)) == filter.layers->end())
+		{
+			continue;
+		}
+		if (filter.levels && std::find(filter.levels->begin(), filter.levels->end(), levelFor(sequence)) == filter.levels->end())
+		{
+			continue;
+		}
+		if (Index::containsCaseInsensitive(messageFor(sequence), text))
+		{
+			result.push_back(sequence);
+		}
+	}
+	return result;
+}
+
+void fill(Index& index, Sequence const count)
+{
+	for (auto sequence = index.endSequence(); sequence < count; ++sequence)
+	{
+		index.append(layerFor(sequence), levelFor(sequence), messageFor(sequence));
+	}
+}
+
+auto textPredicate(std::string const& text)
+{
+	return [&text](Sequence const sequence)
+	{
+		return Index::containsCaseInsensitive(messageFor(sequence), text);
+	};
+}
+} // namespace
+
+TEST(LogFilterIndex, CaseInsensitiveContains)
+{
+	EXPECT_TRUE(Index::containsCaseInsensitive("Entity went online", ""));
+	EXPECT_TRUE(Index::containsCaseInsensitive("Entity went online", "WENT"));
+	EXPECT_TRUE(Index::containsCaseInsensitive("Entity went online", "entity went online"));
+	EXPECT_FALSE(Index::containsCaseInsensitive("Entity went online", "offline"));
+	EXPECT_FALSE(Index::containsCaseInsensitive("", "a"));
+}
+
+TEST(LogFilterIndex, MatchesNaiveFilter)
+{
+	auto index = Index{};
+	fill(index, 5000u);
+
+	auto const filters = std::vector<std::pair<Index::Filter, std::string>>{
+		{ Index::Filter{}, "" },
+		{ Index::Filter{ std::vector<Layer>{ Layer::Protocol }, std::nullopt, "" }, "" },
+		{ Index::Filter{ std::nullopt, std::vector<Level>{ Level::Warn, Level::Error }, "" }, "" },
+		{ Index::Filter{ std::vector<Layer>{}, std::nullopt, "" }, "" },
+		{ Index::Filter{ std::nullopt, std::nullopt, "ACMP" }, "ACMP" },
+		{ Index::Filter{ std::vector<Layer>{ Layer::Generic, Layer::Controller }, std::vector<Level>{ Level::Info }, "index 99" }, "index 99" },
+		{ Index::Filter{ std::nullopt, std::nullopt, "not in any message" }, "not in any message" },
+	};
+
+	for (auto const& [filter, text] : filters)
+	{
+		EXPECT_EQ(naiveFind(filter, 0u, 5000u, text), index.find(filter, 0u, 5000u, textPredicate(text)));
+		// Unaligned ranges
+		EXPECT_EQ(naiveFind(filter, 37u, 4011u, text), index.find(filter, 37u, 4011u, textPredicate(text)));
+		EXPECT_EQ(naiveFind(filter, 100u, 101u, text), index.find(filter, 100u, 101u, textPredicate(text)));
+	}
+}
+
+TEST(LogFilterIndex, Eviction)
+{
+	auto const acceptAll = [](Sequence const)
+	{
+		return true;
+	};
+
+	auto index = Index{};
+	fill(index, 1000u);
+
+	index.evict(130u);
+	EXPECT_EQ(130u, index.firstSequence());
+	EXPECT_EQ(1000u, index.endSequence());
+
+	// Keep appending after eviction, including values not seen yet
+	fill(index, 1500u);
+	index.append(Layer::Generic, Level::Error, "Late entry");
+
+	auto const filter = Index::Filter{ std::vector<Layer>{ Layer::Generic }, std::vector<Level>{ Level::Error }, "" };
+	auto const result = index.find(filter, 0u, index.endSequence(), acceptAll);
+	ASSERT_FALSE(result.empty());
+	EXPECT_LE(130u, result.front());
+	EXPECT_EQ(1500u, result.back());
+	auto expected = naiveFind(filter, 130u, 1500u, "");
+	expected.push_back(1500u);
+	EXPECT_EQ(expected, result);
+
+	// Evict everything
+	index.evict(5000u);
+	EXPECT_EQ(0u, index.size());
+	EXPECT_EQ(1501u, index.firstSequence());
+	EXPECT_TRUE(index.find(Index::Filter{}, 0u, 2000u, acceptAll).empty());
+
+	index.reset(42u);
+	index.append(Layer::Controller, Level::Info, "After reset");
+	EXPECT_EQ(std::vector<Sequence>{ 42u }, index.find(Index::Filter{}, 0u, 100u, acceptAll));
+}
+
+TEST(LogFilterIndex, Refine)
+{
+	auto index = Index{};
+	fill(index, 3000u);
+
+	auto const text = std::string{ "index 1" };
+	auto const refinedText = std::string{ "index 12" };
+	auto const candidates = index.find(Index::Filter{ std::nullopt, std::nullopt, text }, 0u, 3000u, textPredicate(text));
+	auto const refined = index.refine(Index::Filter{ std::nullopt, std::nullopt, refinedText }, candidates, textPredicate(refinedText));
+	EXPECT_EQ(naiveFind(Index::Filter{}, 0u, 3000u, refinedText), refined);
+}
+
+/** Long messages are always checked by the predicate, short ones are still discarded by their signature */
+TEST(LogFilterIndex, LongMessages)
+{
+	auto const longMessage = std::string(200u, 'x') + " Timeout waiting for response";
+	auto const shortMessage = std::string{ "Entity went online" };
+
+	auto index = Index{};
+	for (auto sequence = Sequence{ 0u }; sequence < 1000u; ++sequence)
+	{
+		index.append(layerFor(sequence), levelFor(sequence), sequence % 10u == 0u ? std::string_view{ longMessage } : std::string_view{ shortMessage });
+	}
+	auto const messageAt = [&longMessage, &shortMessage](Sequence const sequence) -> std::string const&
+	{
+		return sequence % 10u == 0u ? longMessage : shortMessage;
+	};
+
+	for (auto const& text : { std::string{ "TIMEOUT" }, std::string{ "went online" }, std::string{ "xxxxx Timeout" }, std::string{ "offline" } })
+	{
+		auto predicateCalls = std::size_t{ 0u };
+		auto const result = index.find(Index::Filter{ std::nullopt, std::nullopt, text }, 0u, 1000u,
+			[&messageAt, &text, &predicateCalls](Sequence const sequence)
+			{
+				++predicateCalls;
+				return Index::containsCaseInsensitive(messageAt(sequence), text);
+			});
+
+		auto expected = std::vector<Sequence>{};
+		for (auto sequence = Sequence{ 0u }; sequence < 1000u; ++sequence)
+		{
+			if (Index::containsCaseInsensitive(messageAt(sequence), text))
+			{
+				expected.push_back(sequence);
+			}
+		}
+		EXPECT_EQ(expected, result);
+
+		// Short messages not containing the text are discarded without calling the predicate
+		if (text == "offline")
+		{
+			EXPECT_EQ(100u, predicateCalls);
+		}
+	}
+}
+
+/** Typing a search one keystroke at a time (each one refining the previous result) gives the same result than searching at once */
+TEST(LogFilterIndex, TypingSearch)
+{
+	static constexpr auto EntriesCount = Sequence{ 20000u };
+
+	auto index = Index{};
+	fill(index, EntriesCount);
+
+	auto const search = std::string{ "Timeout waiting for response of entity 0x001B92FFFE1234" };
+	auto const levels = std::vector<Level>{ Level::Info, Level::Warn, Level::Error };
+	auto result = std::vector<Sequence>{};
+	for (auto length = std::size_t{ 1u }; length <= search.size(); ++length)
+	{
+		auto const text = search.substr(0u, length);
+		auto const filter = Index::Filter{ std::nullopt, levels, text };
+		result = length == 1u ? index.find(filter, 0u, EntriesCount, textPredicate(text)) : index.refine(filter, result, textPredicate(text));
+		EXPECT_EQ(naiveFind(filter, 0u, EntriesCount, text), result);
+	}
+	EXPECT_FALSE(result.empty());
+}
+
+/** Compares the filter latency at 1M and 10M entries with testing each entry (run with --gtest_also_run_disabled_tests) */
+TEST(LogFilterIndex, DISABLED_FilterBenchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	auto const toMs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+	};
+
+	for (auto const entriesCount : { Sequence{ 1000000u }, Sequence{ 10000000u } })
+	{
+		auto index = Index{};
+		auto const indexStartTime = Clock::now();
+		fill(index, entriesCount);
+		auto const indexDuration = Clock::now() - indexStartTime;
+
+		// Typing a search, one keystroke at a time (each one refining the previous result)
+		auto const search = std::string{ "Timeout waiting for response of entity 0x001B92FFFE1234" };
+		auto const levels = std::vector<Level>{ Level::Info, Level::Warn, Level::Error };
+		auto firstKeystrokeDuration = Clock::duration{};
+		auto maxKeystrokeDuration = Clock::duration{};
+		auto result = std::vector<Sequence>{};
+		for (auto length = std::size_t{ 1u }; length <= search.size(); ++length)
+		{
+			auto const text = search.substr(0u, length);
+			auto const filter = Index::Filter{ std::nullopt, levels, text };
+			auto const startTime = Clock::now();
+			result = length == 1u ? index.find(filter, 0u, entriesCount, textPredicate(text)) : index.refine(filter, result, textPredicate(text));
+			auto const duration = Clock::now() - startTime;
+			if (length == 1u)
+			{
+				firstKeystrokeDuration = duration;
+			}
+			else
+			{
+				maxKeystrokeDuration = std::max(maxKeystrokeDuration, duration);
+			}
+		}
+
+		// Full search at once
+		auto const filter = Index::Filter{ std::nullopt, levels, search };
+		auto const findStartTime = Clock::now();
+		auto const found = index.find(filter, 0u, entriesCount, textPredicate(search));
+		auto const findDuration = Clock::now() - findStartTime;
+		EXPECT_EQ(result, found);
+
+		// Reference: testing each entry
+		auto const naiveStartTime = Clock::now();
+		auto const expected = naiveFind(filter, 0u, entriesCount, search);
+		auto const naiveDuration = Clock::now() - naiveStartTime;
+		EXPECT_EQ(expected, found);
+
+		std::cout << entriesCount << " entries (indexed in " << toMs(indexDuration) << " ms), " << found.size() << " matches:" << std::endl;
+		std::cout << "  Indexed search: " << toMs(findDuration) << " ms" << std::endl;
+		std::cout << "  Typing the search: first keystroke " << toMs(firstKeystrokeDuration) << " ms, slowest next keystroke " << toMs(maxKeystrokeDuration) << " ms" << std::endl;
+		std::cout << "  Testing each entry: " << toMs(naiveDuration) << " ms" << std::endl;
+	}
+}
@@ -0,0 +1,289 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file logJournal_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/logJournal.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+class LogJournal_F : public ::testing::Test
+{
+public:
+	virtual void SetUp() override
+	{
+		_directory = std::filesystem::temp_directory_path() / "hive_tests_journal";
+		std::filesystem::remove_all(_directory);
+	}
+
+	virtual void TearDown() override
+	{
+		std::filesystem::remove_all(_directory);
+	}
+
+	avdecc::LogJournal::Configuration configuration(std::size_t const segmentSize) const
+	{
+		auto config = avdecc::LogJournal::Configuration{};
+		config.directory = _directory / "session";
+		config.segmentSize = segmentSize;
+		config.maxBufferSize = segmentSize / 4u;
+		return config;
+	}
+
+	static std::string messageFor(std::uint64_t const sequence)
+	{
+		return "Entry #" + std::to_string(sequence);
+	}
+
+	static avdecc::LogJournal::Record recordFor(std::uint64_t const sequence, std::string const& message)
+	{
+		return avdecc::LogJournal::Record{ static_cast<std::int64_t>(sequence * 1000u), static_cast<std::uint32_t>(sequence % 10u), static_cast<std::uint32_t>(sequence % 5u), message };
+	}
+
+	/** Reads all the entries of the journal segments, checking they are consecutive */
+	static std::uint64_t checkSegments(std::vector<avdecc::LogJournal::SegmentInfo> const& segments)
+	{
+		auto expectedSequence = segments.empty() ? std::uint64_t{ 0u } : segments.front().firstSequence;
+		for (auto const& info : segments)
+		{
+			auto const segment = avdecc::LogJournal::MappedSegment::open(info.path);
+			EXPECT_TRUE(!!segment);
+			if (!segment)
+			{
+				return expectedSequence;
+			}
+			EXPECT_EQ(info.firstSequence, segment->firstSequence());
+			EXPECT_EQ(info.entriesCount, segment->size());
+			EXPECT_EQ(expectedSequence, segment->firstSequence());
+			for (auto index = std::size_t{ 0u }; index < segment->size(); ++index)
+			{
+				auto const record = segment->record(index);
+				auto const sequence = segment->firstSequence() + index;
+				EXPECT_EQ(messageFor(sequence), record.message);
+				EXPECT_EQ(static_cast<std::int64_t>(sequence * 1000u), record.timestamp);
+				EXPECT_EQ(sequence % 10u, record.layer);
+				EXPECT_EQ(sequence % 5u, record.level);
+			}
+			expectedSequence += segment->size();
+		}
+		return expectedSequence;
+	}
+
+protected:
+	std::filesystem::path _directory{};
+};
+} // namespace
+
+TEST_F(LogJournal_F, AppendAndRead)
+{
+	auto journal = avdecc::LogJournal{ configuration(64u * 1024u) };
+	ASSERT_TRUE(journal.isOpen());
+
+	static constexpr auto EntriesCount = std::uint64_t{ 20000u };
+	for (auto sequence = std::uint64_t{ 0u }; sequence < EntriesCount; ++sequence)
+	{
+		journal.append(recordFor(sequence, messageFor(sequence)));
+	}
+	journal.flush();
+
+	EXPECT_EQ(EntriesCount, journal.nextSequence());
+	auto const segments = journal.segments();
+	EXPECT_LT(1u, segments.size());
+	for (auto const& info : segments)
+	{
+		EXPECT_GE(64u * 1024u, std::filesystem::file_size(info.path));
+	}
+	EXPECT_EQ(EntriesCount, checkSegments(segments));
+}
+
+TEST_F(LogJournal_F, WrittenOnDestruction)
+{
+	auto const config = configuration(16u * 1024u);
+	{
+		auto journal = avdecc::LogJournal{ config };
+		for (auto sequence = std::uint64_t{ 0u }; sequence < 1000u; ++sequence)
+		{
+			journal.append(recordFor(sequence, messageFor(sequence)));
+		}
+		// Destroying the journal writes all pending entries
+	}
+
+	// Read back the segment files
+	auto paths = std::vector<std::filesystem::path>{};
+	for (auto const& entry : std::filesystem::directory_iterator{ config.directory })
+	{
+		paths.push_back(entry.path());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	auto segments = std::vector<avdecc::LogJournal::SegmentInfo>{};
+	for (auto const& path : paths)
+	{
+		auto const segment = avdecc::LogJournal::MappedSegment::open(path);
+		ASSERT_TRUE(!!segment);
+		segments.push_back(avdecc::LogJournal::SegmentInfo{ path, segment->firstSequence(), segment->size() });
+	}
+	EXPECT_LT(1u, segments.size());
+	EXPECT_EQ(1000u, checkSegments(segments));
+}
+
+TEST_F(LogJournal_F, MaxSegments)
+{
+	auto config = configuration(4u * 1024u);
+	config.maxSegments = 3u;
+	auto journal = avdecc::LogJournal{ config };
+
+	for (auto sequence = std::uint64_t{ 0u }; sequence < 5000u; ++sequence)
+	{
+		journal.append(recordFor(sequence, messageFor(sequence)));
+	}
+	journal.flush();
+
+	auto const segments = journal.segments();
+	ASSERT_EQ(3u, segments.size());
+	EXPECT_EQ(3u, static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator{ config.directory }, std::filesystem::directory_iterator{})));
+	// Most recent entries are kept
+	EXPECT_EQ(5000u, checkSegments(segments));
+}
+
+TEST_F(LogJournal_F, TruncatedSegment)
+{
+	auto segments = std::vector<avdecc::LogJournal::SegmentInfo>{};
+	{
+		auto journal = avdecc::LogJournal{ configuration(1024u * 1024u) };
+		for (auto sequence = std::uint64_t{ 0u }; sequence < 100u; ++sequence)
+		{
+			journal.append(recordFor(sequence, messageFor(sequence)));
+		}
+		journal.flush();
+		segments = journal.segments();
+	}
+	ASSERT_EQ(1u, segments.size());
+
+	// Simulate a crash while writing the last record
+	auto const& path = segments.front().path;
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3u);
+
+	auto const segment = avdecc::LogJournal::MappedSegment::open(path);
+	ASSERT_TRUE(!!segment);
+	EXPECT_EQ(99u, segment->size());
+	EXPECT_EQ(messageFor(98u), segment->record(98u).message);
+
+	// Not a segment file
+	std::filesystem::resize_file(path, 10u);
+	EXPECT_FALSE(!!avdecc::LogJournal::MappedSegment::open(path));
+	EXPECT_FALSE(!!avdecc::LogJournal::MappedSegment::open(_directory / "doesNotExist.hlj"));
+}
+
+TEST_F(LogJournal_F, RemoveOldDirectories)
+{
+	for (auto const* const name : { "20260101-100000", "20260102-100000", "20260103-100000", "20260104-100000" })
+	{
+		std::filesystem::create_directories(_directory / name);
+	}
+	avdecc::LogJournal::removeOldDirectories(_directory, 2u);
+
+	EXPECT_FALSE(std::filesystem::exists(_directory / "20260101-100000"));
+	EXPECT_FALSE(std::filesystem::exists(_directory / "20260102-100000"));
+	EXPECT_TRUE(std::filesystem::exists(_directory / "20260103-100000"));
+	EXPECT_TRUE(std::filesystem::exists(_directory / "20260104-100000"));
+}
+
+TEST_F(LogJournal_F, RemoveOldDirectoriesBySize)
+{
+	auto const names = std::vector<std::string>{ "20260101-100000", "20260102-100000", "20260103-100000", "20260104-100000" };
+	for (auto const& name : names)
+	{
+		std::filesystem::create_directories(_directory / name);
+		auto output = std::ofstream{ _directory / name / "segment-000000.hlj", std::ios::binary };
+		output << std::string(1000u, 'x');
+	}
+
+	// Only the 2 most recent directories fit in 2500 bytes, even though 3 are allowed
+	avdecc::LogJournal::removeOldDirectories(_directory, 3u, 2500u);
+
+	EXPECT_FALSE(std::filesystem::exists(_directory / names[0]));
+	EXPECT_FALSE(std::filesystem::exists(_directory / names[1]));
+	EXPECT_TRUE(std::filesystem::exists(_directory / names[2]));
+	EXPECT_TRUE(std::filesystem::exists(_directory / names[3]));
+}
+
+TEST_F(LogJournal_F, FailedJournal)
+{
+	// Directory cannot be created (a file exists with that name)
+	std::filesystem::create_directories(_directory);
+	{
+		auto output = std::ofstream{ _directory / "session" };
+	}
+
+	auto journal = avdecc::LogJournal{ configuration(4096u) };
+	EXPECT_FALSE(journal.isOpen());
+	EXPECT_FALSE(journal.hasFailed());
+	journal.append(recordFor(0u, messageFor(0u)));
+	journal.flush();
+	EXPECT_TRUE(journal.segments().empty());
+}
+
+/** Journals 1M entries through a 1 MiB buffer */
+TEST_F(LogJournal_F, AppendBenchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto EntriesCount = std::uint64_t{ 1000000u };
+
+	auto config = configuration(4u * 1024u * 1024u);
+	config.maxBufferSize = 1024u * 1024u;
+	auto journal = avdecc::LogJournal{ config };
+
+	auto const startTime = Clock::now();
+	for (auto sequence = std::uint64_t{ 0u }; sequence < EntriesCount; ++sequence)
+	{
+		journal.append(recordFor(sequence, messageFor(sequence)));
+	}
+	auto const appendDuration = Clock::now() - startTime;
+	journal.flush();
+	auto const totalDuration = Clock::now() - startTime;
+
+	auto const segments = journal.segments();
+	auto bytes = std::uintmax_t{ 0u };
+	for (auto const& info : segments)
+	{
+		bytes += std::filesystem::file_size(info.path);
+	}
+	EXPECT_EQ(EntriesCount, checkSegments(segments));
+
+	auto const toMs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+	};
+	std::cout << "Journaled " << EntriesCount << " entries: appended in " << toMs(appendDuration) << " ms, written and synced after " << toMs(totalDuration) << " ms" << std::endl;
+	std::cout << "  " << segments.size() << " segments, " << (bytes / EntriesCount) << " bytes per entry" << std::endl;
+}
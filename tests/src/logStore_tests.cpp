@@ -0,0 +1,260 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file logStore_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/logStore.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+enum class Layer
+{
+	Generic,
+	Protocol,
+	Controller,
+};
+
+enum class Level
+{
+	Trace,
+	Debug,
+	Info,
+	Warn,
+	Error,
+};
+
+using Store = avdecc::LogStore<Layer, Level>;
+
+std::string makeMessage(std::size_t const index)
+{
+	return "Message #" + std::to_string(index);
+}
+} // namespace
+
+TEST(LogStore, AppendAndRead)
+{
+	auto store = Store{ 10u, 1024u };
+	auto const now = Store::Clock::now();
+
+	store.append(now, Layer::Protocol, Level::Info, "first");
+	store.append(now + std::chrono::milliseconds{ 5 }, Layer::Controller, Level::Error, "second");
+	store.append(now + std::chrono::milliseconds{ 10 }, Layer::Protocol, Level::Info, "");
+
+	ASSERT_EQ(3u, store.size());
+	EXPECT_EQ(0u, store.firstSequence());
+
+	auto const e0 = store.entry(0u);
+	EXPECT_EQ(now, e0.timestamp);
+	EXPECT_EQ(Layer::Protocol, e0.layer);
+	EXPECT_EQ(Level::Info, e0.level);
+	EXPECT_EQ("first", e0.message);
+
+	EXPECT_EQ(now + std::chrono::milliseconds{ 5 }, store.timestamp(1u));
+	EXPECT_EQ(Layer::Controller, store.layer(1u));
+	EXPECT_EQ(Level::Error, store.level(1u));
+	EXPECT_EQ("second", store.message(1u));
+
+	EXPECT_EQ("", store.message(2u));
+	EXPECT_EQ(11u, store.messageBytes());
+
+	// Wall clock conversion keeps the relative times
+	EXPECT_EQ(std::chrono::milliseconds{ 5 }, std::chrono::duration_cast<std::chrono::milliseconds>(store.toSystemTime(store.timestamp(1u)) - store.toSystemTime(store.timestamp(0u))));
+}
+
+TEST(LogStore, EntriesEviction)
+{
+	auto store = Store{ 4u, 1024u };
+	auto const now = Store::Clock::now();
+
+	for (auto index = std::size_t{ 0u }; index < 10u; ++index)
+	{
+		store.append(now, Layer::Generic, Level::Debug, makeMessage(index));
+	}
+
+	ASSERT_EQ(4u, store.size());
+	EXPECT_EQ(6u, store.firstSequence());
+	for (auto row = std::size_t{ 0u }; row < store.size(); ++row)
+	{
+		EXPECT_EQ(makeMessage(6u + row), store.message(row));
+	}
+
+	// Batch eviction count, without modifying the store
+	EXPECT_EQ(0u, (Store{ 4u, 1024u }.evictionsFor(4u, 0u)));
+	EXPECT_EQ(2u, store.evictionsFor(2u, 0u));
+	EXPECT_EQ(4u, store.evictionsFor(10u, 0u));
+	EXPECT_EQ(4u, store.size());
+}
+
+TEST(LogStore, BytesEviction)
+{
+	auto store = Store{ 100u, 20u };
+	auto const now = Store::Clock::now();
+
+	store.append(now, Layer::Generic, Level::Debug, "0123456789"); // 10 bytes
+	store.append(now, Layer::Generic, Level::Debug, "01234"); // 15 bytes
+	EXPECT_EQ(0u, store.evictionsFor(1u, 5u));
+	EXPECT_EQ(1u, store.evictionsFor(1u, 6u));
+	EXPECT_EQ(2u, store.evictionsFor(1u, 20u));
+
+	store.append(now, Layer::Generic, Level::Debug, "0123456789"); // Evicts the first one
+	ASSERT_EQ(2u, store.size());
+	EXPECT_EQ(1u, store.firstSequence());
+	EXPECT_EQ("01234", store.message(0u));
+	EXPECT_EQ(15u, store.messageBytes());
+}
+
+TEST(LogStore, ArenaChunksRelease)
+{
+	// 16 bytes chunks, 8 bytes messages: 2 messages per chunk
+	auto store = Store{ 6u, 1024u, 16u };
+	auto const now = Store::Clock::now();
+
+	for (auto index = std::size_t{ 0u }; index < 6u; ++index)
+	{
+		store.append(now, Layer::Generic, Level::Debug, "01234567");
+	}
+	EXPECT_EQ(48u, store.arenaBytes());
+
+	// Evicting a single message keeps its chunk, evicting both releases it
+	store.evict(1u);
+	EXPECT_EQ(48u, store.arenaBytes());
+	store.evict(1u);
+	EXPECT_EQ(32u, store.arenaBytes());
+
+	// Oversized messages get their own chunk
+	store.append(now, Layer::Generic, Level::Debug, std::string(40u, 'x'));
+	EXPECT_EQ(72u, store.arenaBytes());
+	EXPECT_EQ(std::string(40u, 'x'), store.message(store.size() - 1u));
+
+	// Messages are still valid after their neighbors are released
+	store.evict(3u);
+	EXPECT_EQ("01234567", store.message(0u));
+
+	store.clear();
+	EXPECT_TRUE(store.empty());
+	EXPECT_EQ(0u, store.arenaBytes());
+	EXPECT_EQ(7u, store.firstSequence());
+
+	store.append(now, Layer::Generic, Level::Warn, "after clear");
+	EXPECT_EQ("after clear", store.message(0u));
+	EXPECT_EQ(Level::Warn, store.level(0u));
+}
+
+TEST(LogIngestQueue, ConcurrentProducers)
+{
+	static constexpr auto ProducersCount = std::size_t{ 4u };
+	static constexpr auto ItemsPerProducer = std::size_t{ 50000u };
+
+	auto queue = avdecc::LogIngestQueue<std::pair<std::size_t, std::size_t>>{};
+	auto producers = std::vector<std::thread>{};
+	for (auto producer = std::size_t{ 0u }; producer < ProducersCount; ++producer)
+	{
+		producers.emplace_back(
+			[&queue, producer]()
+			{
+				for (auto index = std::size_t{ 0u }; index < ItemsPerProducer; ++index)
+				{
+					queue.push({ producer, index });
+				}
+			});
+	}
+
+	// Consume while producing, items of each producer must come in order
+	auto nextIndexes = std::vector<std::size_t>(ProducersCount, 0u);
+	auto consumed = std::size_t{ 0u };
+	while (consumed < ProducersCount * ItemsPerProducer)
+	{
+		for (auto const& [producer, index] : queue.takeAll())
+		{
+			ASSERT_EQ(nextIndexes[producer], index);
+			++nextIndexes[producer];
+			++consumed;
+		}
+	}
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+
+	EXPECT_TRUE(queue.takeAll().empty());
+	EXPECT_TRUE(queue.push({ 0u, 0u }));
+	EXPECT_FALSE(queue.push({ 0u, 1u }));
+}
+
+/** Ingests 2M entries in a 1M entries store, by batches as the LoggerModel does */
+TEST(LogStore, IngestionBenchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto Capacity = std::size_t{ 1000000u };
+	static constexpr auto EntriesCount = 2u * Capacity;
+	static constexpr auto BatchSize = std::size_t{ 1000u };
+
+	struct Item
+	{
+		Store::Clock::time_point timestamp{};
+		Layer layer{};
+		Level level{};
+		std::string message{};
+	};
+
+	auto store = Store{ Capacity, 128u * 1024u * 1024u };
+	auto queue = avdecc::LogIngestQueue<Item>{};
+
+	auto const startTime = Clock::now();
+	for (auto batch = std::size_t{ 0u }; batch < EntriesCount / BatchSize; ++batch)
+	{
+		for (auto index = std::size_t{ 0u }; index < BatchSize; ++index)
+		{
+			queue.push(Item{ Store::Clock::now(), Layer::Protocol, Level::Info, "Received AECP response from entity 0x001B92FFFE000001: " + std::to_string(batch * BatchSize + index) });
+		}
+		auto const items = queue.takeAll();
+		auto bytes = std::size_t{ 0u };
+		for (auto const& item : items)
+		{
+			bytes += item.message.size();
+		}
+		store.evict(store.evictionsFor(items.size(), bytes));
+		for (auto const& item : items)
+		{
+			store.append(item.timestamp, item.layer, item.level, item.message);
+		}
+	}
+	auto const duration = Clock::now() - startTime;
+
+	ASSERT_EQ(Capacity, store.size());
+	EXPECT_EQ(EntriesCount - Capacity, store.firstSequence());
+	EXPECT_NE(std::string::npos, store.message(store.size() - 1u).find(std::to_string(EntriesCount - 1u)));
+
+	// Per entry: 8 bytes timestamp, 2 bytes layer/level, 16 bytes message reference
+	auto const columnsBytes = Capacity * (sizeof(Store::Clock::rep) + 2u + 16u);
+	auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+	std::cout << "Ingested " << EntriesCount << " entries in " << ms << " ms (" << (ms ? (EntriesCount / static_cast<std::size_t>(ms)) : EntriesCount) << " entries/ms)" << std::endl;
+	std::cout << "  Memory: " << (columnsBytes / 1024u / 1024u) << " MiB columns + " << (store.arenaBytes() / 1024u / 1024u) << " MiB messages arena (" << (store.messageBytes() / 1024u / 1024u) << " MiB of messages)" << std::endl;
+}
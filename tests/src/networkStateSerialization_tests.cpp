@@ -0,0 +1,273 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file networkStateSerialization_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/orderedParallelProcessor.hpp>
+#include <hive/modelsLibrary/networkStateJsonWriter.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using json = nlohmann::json;
+using Writer = hive::modelsLibrary::NetworkStateJsonWriter;
+
+/** Creates an entity object looking like a serialized ControlledEntity */
+json makeEntity(std::size_t const index, std::size_t const streamsCount)
+{
+	auto entity = json{};
+	entity["dump_version"] = 2;
+	entity["entity_id"] = "0x001B92FFFE0" + std::to_string(10000 + index);
+	entity["entity_name"] = "Entity \"" + std::to_string(index) + "\"\nWith a new line";
+	auto& streams = entity["stream_inputs"];
+	for (auto stream = std::size_t{ 0u }; stream < streamsCount; ++stream)
+	{
+		streams.push_back(json{ { "index", stream }, { "name", "Stream " + std::to_string(stream) }, { "format", "0x00A0020840000800" }, { "formats", json::array({ 1, 2, 3, 4 }) }, { "running", stream % 2 == 0 }, { "latency", 2.5 } });
+	}
+	entity["empty_object"] = json::object();
+	entity["empty_array"] = json::array();
+	return entity;
+}
+
+/** Serializes the whole network state object at once, the way the avdecc controller does */
+std::string serializeNetworkState(std::vector<json> const& entities, std::string const& dumpSource, bool const binary)
+{
+	auto object = json{};
+	object[Writer::DumpVersionKey] = Writer::DumpVersion;
+	object[Writer::DumpSourceKey] = dumpSource;
+	auto entitiesObject = json{};
+	for (auto const& entity : entities)
+	{
+		entitiesObject.push_back(entity);
+	}
+	object[Writer::EntitiesKey] = entitiesObject;
+
+	if (binary)
+	{
+		auto const bytes = json::to_msgpack(object);
+		return std::string{ reinterpret_cast<char const*>(bytes.data()), bytes.size() };
+	}
+	auto stream = std::ostringstream{};
+	stream << std::setw(4) << object << std::endl;
+	return stream.str();
+}
+
+std::string readFile(std::filesystem::path const& path)
+{
+	auto stream = std::ifstream{ path, std::ios::binary | std::ios::in };
+	return std::string{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+}
+
+std::filesystem::path tempFilePath(std::string const& name)
+{
+	return std::filesystem::temp_directory_path() / ("hive_tests_" + name);
+}
+} // namespace
+
+TEST(OrderedParallelProcessor, OrderAndBound)
+{
+	auto processor = hive::modelsLibrary::OrderedParallelProcessor<std::size_t>{ 4u, 6u };
+	auto consumed = std::vector<std::size_t>{};
+
+	auto const completed = processor.run(
+		200u,
+		[](std::size_t const index)
+		{
+			// Make later items faster, so they complete out of order
+			std::this_thread::sleep_for(std::chrono::microseconds{ (200u - index) * 10u });
+			return index * 2u;
+		},
+		[&consumed](std::size_t const index, std::size_t&& result)
+		{
+			EXPECT_EQ(consumed.size(), index);
+			EXPECT_EQ(index * 2u, result);
+			consumed.push_back(index);
+		});
+
+	EXPECT_TRUE(completed);
+	EXPECT_EQ(200u, consumed.size());
+	EXPECT_LE(processor.maxPendingResultsObserved(), 6u);
+}
+
+TEST(OrderedParallelProcessor, Cancel)
+{
+	auto processor = hive::modelsLibrary::OrderedParallelProcessor<std::size_t>{ 2u, 4u };
+	auto consumedCount = std::size_t{ 0u };
+
+	auto const completed = processor.run(
+		1000u,
+		[](std::size_t const index)
+		{
+			return index;
+		},
+		[&consumedCount](std::size_t const, std::size_t&&)
+		{
+			++consumedCount;
+		},
+		[](std::size_t const consumed, std::size_t const total)
+		{
+			EXPECT_EQ(1000u, total);
+			return consumed < 10u;
+		});
+
+	EXPECT_FALSE(completed);
+	EXPECT_EQ(10u, consumedCount);
+}
+
+TEST(NetworkStateJsonWriter, ByteCompatible)
+{
+	auto const dumpSource = std::string{ "Hive v1.5.0 (null)" };
+	auto const path = tempFilePath("networkState.ans");
+
+	for (auto const binary : { false, true })
+	{
+		for (auto const entitiesCount : { std::size_t{ 0u }, std::size_t{ 1u }, std::size_t{ 20u } })
+		{
+			auto entities = std::vector<json>{};
+			for (auto index = std::size_t{ 0u }; index < entitiesCount; ++index)
+			{
+				entities.push_back(makeEntity(index, index % 5u));
+			}
+
+			{
+				auto writer = Writer{ path, binary, dumpSource };
+				ASSERT_TRUE(writer.isGood());
+				for (auto const& entity : entities)
+				{
+					EXPECT_TRUE(writer.writeEntity(Writer::serializeEntity(entity, binary)));
+				}
+				EXPECT_TRUE(writer.finish());
+			}
+
+			auto const content = readFile(path);
+			EXPECT_EQ(serializeNetworkState(entities, dumpSource, binary), content) << "binary=" << binary << " entities=" << entitiesCount;
+
+			// Read it back
+			auto const object = binary ? json::from_msgpack(content) : json::parse(content);
+			EXPECT_EQ(Writer::DumpVersion, object.at(Writer::DumpVersionKey).get<std::uint32_t>());
+			EXPECT_EQ(entitiesCount, object.at(Writer::EntitiesKey).size());
+		}
+	}
+	std::filesystem::remove(path);
+}
+
+/** Streams the entities of a network state saved by the avdecc controller, which must be reproduced exactly */
+TEST(NetworkStateJsonWriter, NetworkStateFile)
+{
+	auto const original = readFile("data/connectionMatrix/1-Normal_Normal-ConnectedNoError_WrongFormat.json");
+	ASSERT_FALSE(original.empty());
+	auto const networkState = json::parse(original);
+	auto const path = tempFilePath("networkStateFile.json");
+
+	{
+		auto writer = Writer{ path, false, networkState.at(Writer::DumpSourceKey).get<std::string>() };
+		for (auto const& entity : networkState.at(Writer::EntitiesKey))
+		{
+			writer.writeEntity(Writer::serializeEntity(entity, false));
+		}
+		EXPECT_TRUE(writer.finish());
+	}
+
+	EXPECT_EQ(original, readFile(path));
+	std::filesystem::remove(path);
+}
+
+TEST(NetworkStateJsonWriter, Abort)
+{
+	auto const path = tempFilePath("aborted.ans");
+	for (auto const binary : { false, true })
+	{
+		{
+			auto writer = Writer{ path, binary, "Hive" };
+			writer.writeEntity(Writer::serializeEntity(makeEntity(0u, 1u), binary));
+			writer.abort();
+		}
+		EXPECT_FALSE(std::filesystem::exists(path));
+		auto spillPath = path;
+		spillPath += ".entities";
+		EXPECT_FALSE(std::filesystem::exists(spillPath));
+	}
+}
+
+/** Dumps a network of 400 entities, all at once on the calling thread, then streamed from a worker pool */
+TEST(NetworkStateJsonWriter, SerializationBenchmark)
+{
+	static constexpr auto EntitiesCount = std::size_t{ 400u };
+	static constexpr auto StreamsPerEntity = std::size_t{ 64u };
+
+	auto entities = std::vector<json>{};
+	for (auto index = std::size_t{ 0u }; index < EntitiesCount; ++index)
+	{
+		entities.push_back(makeEntity(index, StreamsPerEntity));
+	}
+	auto const path = tempFilePath("benchmark.json");
+
+	// Whole document
+	auto const wholeStartTime = std::chrono::steady_clock::now();
+	auto const whole = serializeNetworkState(entities, "Hive", false);
+	{
+		auto stream = std::ofstream{ path, std::ios::binary | std::ios::out };
+		stream.write(whole.data(), whole.size());
+	}
+	auto const wholeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wholeStartTime);
+
+	// Streamed
+	auto processor = hive::modelsLibrary::OrderedParallelProcessor<std::string>{};
+	auto const streamedStartTime = std::chrono::steady_clock::now();
+	auto largestEntity = std::size_t{ 0u };
+	{
+		auto writer = Writer{ path, false, "Hive" };
+		processor.run(
+			EntitiesCount,
+			[&entities](std::size_t const index)
+			{
+				return Writer::serializeEntity(entities[index], false);
+			},
+			[&writer, &largestEntity](std::size_t const, std::string&& serializedEntity)
+			{
+				largestEntity = std::max(largestEntity, serializedEntity.size());
+				writer.writeEntity(serializedEntity);
+			});
+		EXPECT_TRUE(writer.finish());
+	}
+	auto const streamedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - streamedStartTime);
+
+	EXPECT_EQ(whole, readFile(path));
+	EXPECT_LE(processor.maxPendingResultsObserved(), processor.maxPendingResults());
+	EXPECT_LT(processor.maxPendingResultsObserved() * largestEntity, whole.size());
+	std::filesystem::remove(path);
+
+	std::cout << "Network state of " << EntitiesCount << " entities (" << whole.size() / 1024u << " KiB): whole document " << wholeTime.count() << " ms, streamed " << streamedTime.count() << " ms with " << processor.workersCount() << " workers" << std::endl;
+	std::cout << "  Serialized data in memory: whole document " << whole.size() / 1024u << " KiB, streamed at most " << (processor.maxPendingResultsObserved() * largestEntity) / 1024u << " KiB" << std::endl;
+}
@@ -0,0 +1,220 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file notificationCoalescer_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/notificationCoalescer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct Key
+{
+	std::uint64_t entityID{ 0u };
+	std::uint16_t descriptorIndex{ 0u };
+
+	bool operator==(Key const& other) const noexcept
+	{
+		return entityID == other.entityID && descriptorIndex == other.descriptorIndex;
+	}
+};
+struct KeyHash
+{
+	std::size_t operator()(Key const& key) const noexcept
+	{
+		return std::hash<std::uint64_t>()(key.entityID) ^ (std::hash<std::uint16_t>()(key.descriptorIndex) << 8);
+	}
+};
+using Coalescer = hive::modelsLibrary::NotificationCoalescer<Key, std::uint64_t, KeyHash>;
+} // namespace
+
+TEST(NotificationCoalescer, KeepsLatestValue)
+{
+	auto coalescer = Coalescer{};
+
+	EXPECT_TRUE(coalescer.push(Key{ 1u, 0u }, 1u));
+	EXPECT_FALSE(coalescer.push(Key{ 2u, 0u }, 10u));
+	EXPECT_FALSE(coalescer.push(Key{ 1u, 0u }, 2u));
+	EXPECT_FALSE(coalescer.push(Key{ 1u, 1u }, 100u));
+	EXPECT_FALSE(coalescer.push(Key{ 1u, 0u }, 3u));
+	EXPECT_EQ(3u, coalescer.pendingCount());
+
+	auto const entries = coalescer.drain();
+	ASSERT_EQ(3u, entries.size());
+	// Entries are returned in first push order
+	EXPECT_EQ((Key{ 1u, 0u }), entries[0].key);
+	EXPECT_EQ(3u, entries[0].value);
+	EXPECT_EQ(2u, entries[0].coalescedCount);
+	EXPECT_EQ((Key{ 2u, 0u }), entries[1].key);
+	EXPECT_EQ(10u, entries[1].value);
+	EXPECT_EQ((Key{ 1u, 1u }), entries[2].key);
+	EXPECT_EQ(100u, entries[2].value);
+
+	EXPECT_EQ(0u, coalescer.pendingCount());
+	EXPECT_TRUE(coalescer.drain().empty());
+
+	// Store is empty again, next push should request a new drain
+	EXPECT_TRUE(coalescer.push(Key{ 1u, 0u }, 4u));
+
+	auto const stats = coalescer.getStatistics();
+	EXPECT_EQ(6u, stats.pushedCount);
+	EXPECT_EQ(3u, stats.drainedCount);
+	EXPECT_EQ(1u, stats.drainCount);
+	EXPECT_EQ(3u, stats.maxPendingCount);
+}
+
+TEST(NotificationCoalescer, Discard)
+{
+	auto coalescer = Coalescer{};
+
+	coalescer.push(Key{ 1u, 0u }, 1u);
+	coalescer.push(Key{ 2u, 0u }, 2u);
+	coalescer.push(Key{ 1u, 1u }, 3u);
+	coalescer.push(Key{ 3u, 0u }, 4u);
+
+	coalescer.discard(
+		[](Key const& key)
+		{
+			return key.entityID == 1u;
+		});
+	EXPECT_EQ(2u, coalescer.pendingCount());
+
+	// Positions must still be valid after a discard
+	coalescer.push(Key{ 3u, 0u }, 5u);
+	auto const entries = coalescer.drain();
+	ASSERT_EQ(2u, entries.size());
+	EXPECT_EQ(2u, entries[0].value);
+	EXPECT_EQ(5u, entries[1].value);
+}
+
+TEST(NotificationCoalescer, MergesPendingValue)
+{
+	auto coalescer = Coalescer{};
+	auto const mergeFlags = [](std::uint64_t& pendingValue, std::uint64_t&& value)
+	{
+		pendingValue |= value;
+	};
+
+	// A flag raised by an early notification must survive the following ones
+	EXPECT_TRUE(coalescer.push(Key{ 1u, 0u }, 0x1u, mergeFlags));
+	EXPECT_FALSE(coalescer.push(Key{ 1u, 0u }, 0x0u, mergeFlags));
+	EXPECT_FALSE(coalescer.push(Key{ 1u, 0u }, 0x4u, mergeFlags));
+	EXPECT_FALSE(coalescer.push(Key{ 2u, 0u }, 0x2u, mergeFlags));
+
+	auto const entries = coalescer.drain();
+	ASSERT_EQ(2u, entries.size());
+	EXPECT_EQ(0x5u, entries[0].value);
+	EXPECT_EQ(2u, entries[0].coalescedCount);
+	EXPECT_EQ(0x2u, entries[1].value);
+
+	// Nothing is merged across drains
+	EXPECT_TRUE(coalescer.push(Key{ 1u, 0u }, 0x0u, mergeFlags));
+	auto const nextEntries = coalescer.drain();
+	ASSERT_EQ(1u, nextEntries.size());
+	EXPECT_EQ(0x0u, nextEntries[0].value);
+}
+
+/** Replays a synthetic storm of unsolicited counter notifications (300 entities, 4 streams each, from multiple threads), draining on a UI-like tick, and reports queue depth and latency */
+TEST(NotificationCoalescer, NotificationStorm)
+{
+	static constexpr auto EntitiesCount = std::uint64_t{ 300u };
+	static constexpr auto StreamsPerEntity = std::uint16_t{ 4u };
+	static constexpr auto ProducersCount = 4u;
+	static constexpr auto NotificationsPerProducer = 250000u;
+	static constexpr auto Tick = std::chrono::milliseconds{ 16 };
+
+	auto coalescer = Coalescer{};
+	auto producersDone = std::atomic_uint{ 0u };
+	auto lastValues = std::unordered_map<Key, std::uint64_t, KeyHash>{};
+	auto drainedTotal = std::size_t{ 0u };
+	auto drainsCount = std::size_t{ 0u };
+
+	auto const startTime = std::chrono::steady_clock::now();
+
+	auto producers = std::vector<std::thread>{};
+	for (auto producer = 0u; producer < ProducersCount; ++producer)
+	{
+		producers.emplace_back(
+			[&coalescer, &producersDone, producer]()
+			{
+				// Each producer owns a distinct set of entities (as the controller does, notifications for an entity are serialized), counter values always increase
+				for (auto i = 0u; i < NotificationsPerProducer; ++i)
+				{
+					auto const entityID = (static_cast<std::uint64_t>(i) % (EntitiesCount / ProducersCount)) * ProducersCount + producer;
+					auto const streamIndex = static_cast<std::uint16_t>((i / EntitiesCount) % StreamsPerEntity);
+					coalescer.push(Key{ entityID, streamIndex }, i);
+				}
+				++producersDone;
+			});
+	}
+
+	// Consumer (UI thread)
+	auto const consume = [&]()
+	{
+		auto const entries = coalescer.drain();
+		if (!entries.empty())
+		{
+			++drainsCount;
+			drainedTotal += entries.size();
+			for (auto const& entry : entries)
+			{
+				auto& last = lastValues[entry.key];
+				// Only the latest value is kept, so it must always be newer than the previously drained one
+				EXPECT_TRUE(last == 0u || entry.value > last);
+				last = entry.value;
+			}
+		}
+	};
+	while (producersDone < ProducersCount)
+	{
+		std::this_thread::sleep_for(Tick);
+		consume();
+	}
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+	consume();
+
+	auto const totalTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	auto const stats = coalescer.getStatistics();
+
+	EXPECT_EQ(ProducersCount * NotificationsPerProducer, stats.pushedCount);
+	EXPECT_EQ(drainedTotal, stats.drainedCount);
+	EXPECT_EQ(EntitiesCount * StreamsPerEntity, lastValues.size());
+	// Queue depth is bounded by the number of distinct keys, whatever the notification rate
+	EXPECT_LE(stats.maxPendingCount, EntitiesCount * StreamsPerEntity);
+	EXPECT_EQ(0u, coalescer.pendingCount());
+
+	std::cout << "Notification storm: " << stats.pushedCount << " notifications in " << totalTime.count() << " ms" << std::endl;
+	std::cout << "  Dispatched: " << stats.drainedCount << " in " << drainsCount << " ticks (" << (100.0 * static_cast<double>(stats.drainedCount) / static_cast<double>(stats.pushedCount)) << "%)" << std::endl;
+	std::cout << "  Max queue depth: " << stats.maxPendingCount << std::endl;
+	std::cout << "  Max latency: " << stats.maxLatency.count() << " us, last latency: " << stats.lastLatency.count() << " us" << std::endl;
+}
@@ -0,0 +1,175 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file ouiTable_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/ouiTable.hpp>
+#include <hive/modelsLibrary/ouiData.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using json = nlohmann::json;
+
+// Previous implementation: parse the OUI json file into a hash map
+std::unordered_map<std::uint32_t, std::string> parseOuiJson(std::string const& content)
+{
+	auto oui24ToName = std::unordered_map<std::uint32_t, std::string>{};
+	auto const jsonContent = json::parse(content);
+	if (auto it = jsonContent.find("oui_24"); it != jsonContent.end())
+	{
+		for (auto const& [key, value] : it->items())
+		{
+			oui24ToName.emplace(static_cast<std::uint32_t>(std::stoul(key, nullptr, 16)), value.get<std::string>());
+		}
+	}
+	return oui24ToName;
+}
+
+std::string readOuiJson()
+{
+	auto file = std::ifstream{ RESOURCES_ROOT_DIR "/oui.json" };
+	return std::string{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+}
+
+} // namespace
+
+TEST(OuiTable, Lookup)
+{
+	static constexpr auto Table = hive::modelsLibrary::OuiTable<std::uint32_t, 5>{ { 0x000010u, 0x000020u, 0x000030u, 0x000040u, 0x000050u }, { 4u, 3u, 2u, 1u, 0u } };
+	static_assert(Table.isSorted());
+	static_assert(Table.find(0x000030u) == std::uint8_t{ 2u });
+
+	auto index = std::uint8_t{ 5u };
+	for (auto const oui : Table.ouis)
+	{
+		--index;
+		EXPECT_EQ(index, Table.find(oui));
+	}
+	EXPECT_FALSE(Table.find(0x000000u));
+	EXPECT_FALSE(Table.find(0x000015u));
+	EXPECT_FALSE(Table.find(0x000051u));
+	EXPECT_FALSE(Table.find(0xFFFFFFu));
+}
+
+TEST(OuiTable, EmptyAndSingle)
+{
+	static constexpr auto Empty = hive::modelsLibrary::OuiTable<std::uint64_t, 0>{};
+	EXPECT_TRUE(Empty.isSorted());
+	EXPECT_FALSE(Empty.find(0x001B92FFFu));
+
+	static constexpr auto Single = hive::modelsLibrary::OuiTable<std::uint64_t, 1>{ { 0x70B3D5F2Au }, { 7u } };
+	EXPECT_EQ(std::uint8_t{ 7u }, Single.find(0x70B3D5F2Au));
+	EXPECT_FALSE(Single.find(0x70B3D5F2Bu));
+}
+
+TEST(OuiTable, IsSorted)
+{
+	EXPECT_FALSE((hive::modelsLibrary::OuiTable<std::uint32_t, 3>{ { 1u, 3u, 2u }, {} }.isSorted()));
+	EXPECT_FALSE((hive::modelsLibrary::OuiTable<std::uint32_t, 2>{ { 1u, 1u }, {} }.isSorted()));
+}
+
+TEST(OuiTable, WideNameIndex)
+{
+	// More than 256 vendor names
+	static constexpr auto Table = hive::modelsLibrary::OuiTable<std::uint32_t, 3, std::uint16_t>{ { 0x000010u, 0x000020u, 0x000030u }, { 0u, 255u, 1000u } };
+	static_assert(Table.find(0x000030u) == std::uint16_t{ 1000u });
+	EXPECT_EQ(std::uint16_t{ 255u }, Table.find(0x000020u));
+	EXPECT_FALSE(Table.find(0x000040u));
+}
+
+TEST(OuiTable, MatchesJsonFile)
+{
+	namespace oui = hive::modelsLibrary::oui;
+
+	auto const oui24ToName = parseOuiJson(readOuiJson());
+	ASSERT_FALSE(oui24ToName.empty());
+	ASSERT_EQ(oui24ToName.size(), oui::Oui24.ouis.size());
+
+	for (auto const& [oui24, name] : oui24ToName)
+	{
+		auto const nameIndex = oui::Oui24.find(oui24);
+		ASSERT_TRUE(nameIndex.has_value()) << std::hex << oui24;
+		EXPECT_EQ(name, oui::VendorNames[*nameIndex]);
+	}
+
+	// Unknown OUIs
+	for (auto oui24 = std::uint32_t{ 0u }; oui24 < 0x1000000u; oui24 += 0x1001u)
+	{
+		EXPECT_EQ(oui24ToName.count(oui24) != 0u, oui::Oui24.find(oui24).has_value()) << std::hex << oui24;
+	}
+}
+
+TEST(OuiTable, Benchmark)
+{
+	namespace oui = hive::modelsLibrary::oui;
+	using Clock = std::chrono::steady_clock;
+	static constexpr auto LookupsCount = std::size_t{ 1000000u };
+
+	auto const content = readOuiJson();
+	auto lookups = std::vector<std::uint32_t>{};
+	lookups.reserve(LookupsCount);
+	for (auto i = std::size_t{ 0u }; i < LookupsCount; ++i)
+	{
+		// Half known OUIs, half unknown ones
+		lookups.push_back((i % 2u) ? oui::Oui24.ouis[(i * 7919u) % oui::Oui24.ouis.size()] : static_cast<std::uint32_t>((i * 2654435761u) & 0xFFFFFFu));
+	}
+
+	auto startTime = Clock::now();
+	auto const oui24ToName = parseOuiJson(content);
+	auto const parseDuration = Clock::now() - startTime;
+
+	auto foundJson = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto const oui24 : lookups)
+	{
+		foundJson += oui24ToName.count(oui24);
+	}
+	auto const jsonLookupDuration = Clock::now() - startTime;
+
+	auto foundTable = std::size_t{ 0u };
+	startTime = Clock::now();
+	for (auto const oui24 : lookups)
+	{
+		foundTable += oui::Oui24.find(oui24).has_value() ? 1u : 0u;
+	}
+	auto const tableLookupDuration = Clock::now() - startTime;
+
+	EXPECT_EQ(foundJson, foundTable);
+
+	auto const toUs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+	std::cout << "Json: parsed in " << toUs(parseDuration) << " us, " << LookupsCount << " lookups in " << toUs(jsonLookupDuration) << " us" << std::endl;
+	std::cout << "Table: no parsing (" << sizeof(oui::Oui24) << " bytes of read-only data), " << LookupsCount << " lookups in " << toUs(tableLookupDuration) << " us" << std::endl;
+}
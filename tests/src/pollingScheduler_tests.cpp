@@ -0,0 +1,203 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file pollingScheduler_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/pollingScheduler.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace
+{
+using namespace std::chrono_literals;
+using Scheduler = hive::modelsLibrary::PollingScheduler<std::uint64_t>;
+using Duration = Scheduler::Duration;
+
+Scheduler::Configuration makeConfiguration() noexcept
+{
+	auto configuration = Scheduler::Configuration{};
+	configuration.pollsPerSecond = 1.0;
+	configuration.burstSize = 2.0;
+	configuration.idleInterval = 10s;
+	configuration.errorInterval = 4s;
+	configuration.selectedInterval = 2s;
+	configuration.errorHoldTime = 30s;
+	configuration.backoffFactor = 2.0;
+	configuration.maxBackoff = 8.0;
+	configuration.backoffRecoveryTime = 20s;
+	return configuration;
+}
+
+} // namespace
+
+TEST(PollingScheduler, IdleInterval)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(makeConfiguration());
+	scheduler.addEntity(1u, 0s);
+	EXPECT_TRUE(scheduler.takeDue(0s).empty()); // Just enumerated
+	EXPECT_EQ(Duration{ 10s }, scheduler.getNextPollDelay(0s));
+	EXPECT_TRUE(scheduler.takeDue(9s).empty());
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(10s));
+	EXPECT_EQ(Duration{ 10s }, scheduler.getNextPollDelay(10s));
+
+	// Adding again keeps the state
+	scheduler.addEntity(1u, 15s);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(20s));
+
+	scheduler.removeEntity(1u);
+	EXPECT_TRUE(scheduler.takeDue(100s).empty());
+	EXPECT_FALSE(scheduler.getNextPollDelay(100s));
+	EXPECT_EQ(2u, scheduler.getStatistics().pollsCount);
+}
+
+TEST(PollingScheduler, SelectedAndErrors)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(makeConfiguration());
+	scheduler.addEntity(1u, 0s);
+	scheduler.addEntity(2u, 0s);
+
+	// Selection: polled right away (not polled recently), then at the selected interval
+	scheduler.setSelected(1u, true, 5s);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(5s));
+	EXPECT_EQ(Duration{ 2s }, scheduler.getNextPollDelay(5s));
+	scheduler.setSelected(1u, false, 6s);
+	EXPECT_EQ(Duration{ 4s }, scheduler.getNextPollDelay(6s)); // Entity 2 at 10s, entity 1 back to the idle interval since its last poll (15s)
+
+	// Selected again right after a poll: waits for the selected interval
+	scheduler.setSelected(1u, true, 6s);
+	EXPECT_TRUE(scheduler.takeDue(6s).empty());
+	EXPECT_EQ(Duration{ 1s }, scheduler.getNextPollDelay(6s));
+	scheduler.setSelected(1u, false, 6s);
+
+	// Errors: the next poll is brought closer, during the hold time only
+	scheduler.notifyErrors(2u, 6s);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(6s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(10s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(14s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(15s));
+	scheduler.removeEntity(1u);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(31s)); // Late poll, still in the hold time (since 6s): error interval
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(35s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(39s)); // Hold time over: idle interval
+	EXPECT_TRUE(scheduler.takeDue(48s).empty());
+	EXPECT_EQ((std::vector<std::uint64_t>{ 2u }), scheduler.takeDue(49s));
+}
+
+TEST(PollingScheduler, TokenBucket)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(makeConfiguration());
+	for (auto key = std::uint64_t{ 1u }; key <= 5u; ++key)
+	{
+		scheduler.addEntity(key, Duration{ static_cast<Duration::rep>(key) }); // Due in order of key
+	}
+
+	// Burst of 2 polls, then 1 per second, oldest due first
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u, 2u }), scheduler.takeDue(20s));
+	EXPECT_EQ(Duration{ 1001ms }, scheduler.getNextPollDelay(20s));
+	EXPECT_TRUE(scheduler.takeDue(20500ms).empty());
+	EXPECT_EQ((std::vector<std::uint64_t>{ 3u }), scheduler.takeDue(21s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 4u }), scheduler.takeDue(22s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 5u }), scheduler.takeDue(23s));
+	EXPECT_EQ(5u, scheduler.getStatistics().pollsCount);
+	EXPECT_EQ(3u, scheduler.getStatistics().deferredCount); // Entities 3, 4 and 5 waited for a token
+}
+
+TEST(PollingScheduler, BoundedRate)
+{
+	// Whatever the number of entities, the polls never exceed the budget
+	auto configuration = makeConfiguration();
+	configuration.idleInterval = 1s;
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(configuration);
+	for (auto key = std::uint64_t{ 0u }; key < 1000u; ++key)
+	{
+		scheduler.addEntity(key, 0s);
+	}
+
+	auto polls = std::map<std::uint64_t, std::size_t>{};
+	auto pollsCount = std::size_t{ 0u };
+	for (auto now = Duration{ 0 }; now <= Duration{ 600s }; now += 100ms)
+	{
+		for (auto const key : scheduler.takeDue(now))
+		{
+			++polls[key];
+			++pollsCount;
+		}
+	}
+	EXPECT_LE(pollsCount, 600u + 2u); // 1 per second, plus the burst
+	EXPECT_GE(pollsCount, 595u);
+	EXPECT_EQ(pollsCount, polls.size()); // No entity polled twice before all others were polled once
+}
+
+TEST(PollingScheduler, Backoff)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(makeConfiguration());
+	scheduler.addEntity(1u, 0s);
+
+	scheduler.notifyTimeout(1u, 5s);
+	EXPECT_DOUBLE_EQ(2.0, scheduler.getBackoff(1u));
+	EXPECT_TRUE(scheduler.takeDue(10s).empty()); // Pushed back
+	EXPECT_EQ(Duration{ 15s }, scheduler.getNextPollDelay(10s));
+	scheduler.notifyTimeout(1u, 6s);
+	scheduler.notifyTimeout(1u, 7s);
+	scheduler.notifyTimeout(1u, 8s);
+	EXPECT_DOUBLE_EQ(8.0, scheduler.getBackoff(1u)); // Clamped
+	EXPECT_EQ(4u, scheduler.getStatistics().timeoutsCount);
+
+	// Polled 80s after the last timeout (backoff of 8): recovered, the backoff is decreased
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(88s));
+	EXPECT_DOUBLE_EQ(4.0, scheduler.getBackoff(1u));
+	EXPECT_EQ(Duration{ 40s }, scheduler.getNextPollDelay(88s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(128s));
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), scheduler.takeDue(148s));
+	EXPECT_DOUBLE_EQ(1.0, scheduler.getBackoff(1u));
+
+	EXPECT_DOUBLE_EQ(1.0, scheduler.getBackoff(42u)); // Unknown
+}
+
+TEST(PollingScheduler, Clear)
+{
+	auto scheduler = Scheduler{};
+	scheduler.setConfiguration(makeConfiguration());
+	scheduler.addEntity(1u, 0s);
+	scheduler.addEntity(2u, 0s);
+	scheduler.takeDue(10s);
+	EXPECT_EQ(2u, scheduler.getEntitiesCount());
+
+	scheduler.clear();
+	EXPECT_EQ(0u, scheduler.getEntitiesCount());
+	EXPECT_FALSE(scheduler.hasEntity(1u));
+	EXPECT_FALSE(scheduler.getNextPollDelay(10s));
+
+	// Token bucket is full again
+	scheduler.addEntity(3u, 10s);
+	scheduler.addEntity(4u, 10s);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 3u, 4u }), scheduler.takeDue(20s));
+}
@@ -0,0 +1,128 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file sizeBoundedLruCache_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/widgetModelsLibrary/sizeBoundedLruCache.hpp>
+
+#include <string>
+
+namespace
+{
+using Cache = hive::widgetModelsLibrary::SizeBoundedLruCache<int, std::string>;
+} // namespace
+
+TEST(SizeBoundedLruCache, InsertFind)
+{
+	auto cache = Cache{ 100u };
+	EXPECT_TRUE(cache.empty());
+	EXPECT_EQ(nullptr, cache.find(1));
+
+	EXPECT_TRUE(cache.insert(1, "one", 10u));
+	EXPECT_TRUE(cache.insert(2, "two", 20u));
+	EXPECT_EQ(2u, cache.size());
+	EXPECT_EQ(30u, cache.cost());
+
+	auto const* const value = cache.find(1);
+	ASSERT_NE(nullptr, value);
+	EXPECT_EQ("one", *value);
+
+	// Replacing a value updates the cost
+	EXPECT_TRUE(cache.insert(1, "ONE", 5u));
+	EXPECT_EQ(2u, cache.size());
+	EXPECT_EQ(25u, cache.cost());
+	EXPECT_EQ("ONE", *cache.find(1));
+}
+
+TEST(SizeBoundedLruCache, EvictLeastRecentlyUsed)
+{
+	auto cache = Cache{ 100u };
+	cache.insert(1, "one", 40u);
+	cache.insert(2, "two", 40u);
+
+	// Use the first one, so the second one is the least recently used
+	EXPECT_NE(nullptr, cache.find(1));
+	cache.insert(3, "three", 40u);
+
+	EXPECT_TRUE(cache.contains(1));
+	EXPECT_FALSE(cache.contains(2));
+	EXPECT_TRUE(cache.contains(3));
+	EXPECT_EQ(80u, cache.cost());
+
+	// Several values evicted for a big one
+	cache.insert(4, "four", 90u);
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_TRUE(cache.contains(4));
+	EXPECT_EQ(90u, cache.cost());
+}
+
+TEST(SizeBoundedLruCache, TooCostly)
+{
+	auto cache = Cache{ 100u };
+	cache.insert(1, "one", 10u);
+
+	EXPECT_FALSE(cache.insert(2, "two", 101u));
+	EXPECT_FALSE(cache.contains(2));
+	// Other values are kept
+	EXPECT_TRUE(cache.contains(1));
+
+	// Replacing a value by a too costly one removes it
+	EXPECT_FALSE(cache.insert(1, "ONE", 101u));
+	EXPECT_TRUE(cache.empty());
+	EXPECT_EQ(0u, cache.cost());
+}
+
+TEST(SizeBoundedLruCache, Remove)
+{
+	auto cache = Cache{ 100u };
+	for (auto key = 0; key < 10; ++key)
+	{
+		cache.insert(key, std::to_string(key), 10u);
+	}
+	EXPECT_EQ(100u, cache.cost());
+
+	EXPECT_TRUE(cache.remove(3));
+	EXPECT_FALSE(cache.remove(3));
+	EXPECT_EQ(90u, cache.cost());
+
+	cache.removeIf(
+		[](int const key)
+		{
+			return key % 2 == 0;
+		});
+	EXPECT_EQ(4u, cache.size());
+	EXPECT_EQ(40u, cache.cost());
+	for (auto const key : { 1, 5, 7, 9 })
+	{
+		EXPECT_TRUE(cache.contains(key));
+	}
+
+	cache.setMaxCost(20u);
+	EXPECT_EQ(2u, cache.size());
+	EXPECT_TRUE(cache.contains(7));
+	EXPECT_TRUE(cache.contains(9));
+
+	cache.clear();
+	EXPECT_TRUE(cache.empty());
+	EXPECT_EQ(0u, cache.cost());
+}
@@ -0,0 +1,197 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file snapshotStore_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/snapshotStore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Value
+{
+	std::uint64_t version{ 0u };
+	std::uint64_t first{ 0u };
+	std::uint64_t second{ 0u }; // Always equal to first, so a torn read would be detected
+	std::shared_ptr<std::vector<std::uint64_t> const> shared{ std::make_shared<std::vector<std::uint64_t> const>() };
+};
+using Store = hive::modelsLibrary::SnapshotStore<std::uint64_t, Value>;
+
+int const OwnerA{ 0 };
+int const OwnerB{ 0 };
+} // namespace
+
+TEST(SnapshotStore, PublishUpdateRemove)
+{
+	auto store = Store{};
+
+	EXPECT_EQ(nullptr, store.get(1u));
+	// Nothing to update
+	auto const unchanged = [](Value&)
+	{
+	};
+	EXPECT_EQ(nullptr, store.update(1u, &OwnerA, unchanged));
+
+	auto const published = store.publish(1u, &OwnerA, Value{ 0u, 10u, 10u });
+	ASSERT_NE(nullptr, published);
+	EXPECT_EQ(1u, published->version);
+
+	auto const snapshot = store.get(1u);
+	EXPECT_EQ(published, snapshot);
+
+	auto const updated = store.update(1u, &OwnerA,
+		[](Value& value)
+		{
+			value.first = 20u;
+			value.second = 20u;
+		});
+	ASSERT_NE(nullptr, updated);
+	EXPECT_EQ(2u, updated->version);
+	EXPECT_EQ(20u, store.get(1u)->first);
+	// Parts not modified by the update are shared
+	EXPECT_EQ(snapshot->shared, updated->shared);
+	// Previous snapshot is immutable and still valid
+	EXPECT_EQ(10u, snapshot->first);
+
+	EXPECT_EQ((std::vector<std::uint64_t>{ 1u }), store.keys());
+
+	EXPECT_TRUE(store.remove(1u, &OwnerA));
+	EXPECT_EQ(nullptr, store.get(1u));
+	EXPECT_FALSE(store.remove(1u, &OwnerA));
+	EXPECT_EQ(10u, snapshot->first);
+	EXPECT_EQ(2u, store.version());
+}
+
+TEST(SnapshotStore, Owner)
+{
+	auto store = Store{};
+
+	store.publish(1u, &OwnerA, Value{ 0u, 1u, 1u });
+	// A new owner takes the key over (entity going online again while its previous instance is going offline)
+	store.publish(1u, &OwnerB, Value{ 0u, 2u, 2u });
+
+	// Late update and removal from the previous owner are ignored
+	auto const lateUpdate = [](Value& value)
+	{
+		value.first = 3u;
+		value.second = 3u;
+	};
+	EXPECT_EQ(nullptr, store.update(1u, &OwnerA, lateUpdate));
+	EXPECT_FALSE(store.remove(1u, &OwnerA));
+	ASSERT_NE(nullptr, store.get(1u));
+	EXPECT_EQ(2u, store.get(1u)->first);
+
+	EXPECT_TRUE(store.remove(1u, &OwnerB));
+	EXPECT_EQ(nullptr, store.get(1u));
+}
+
+/** Readers on multiple threads while a writer publishes, updates and removes values: readers must always see consistent values, and versions must never go backward */
+TEST(SnapshotStore, ConcurrentReaders)
+{
+	static constexpr auto KeysCount = std::uint64_t{ 64u };
+	static constexpr auto ReadersCount = 4u;
+	static constexpr auto WritesCount = 200000u;
+
+	auto store = Store{};
+	for (auto key = std::uint64_t{ 0u }; key < KeysCount; ++key)
+	{
+		store.publish(key, &OwnerA, Value{ 0u, key, key });
+	}
+
+	auto writerDone = std::atomic_bool{ false };
+	auto tornReads = std::atomic_uint64_t{ 0u };
+	auto backwardVersions = std::atomic_uint64_t{ 0u };
+	auto totalReads = std::atomic_uint64_t{ 0u };
+
+	auto readers = std::vector<std::thread>{};
+	for (auto reader = 0u; reader < ReadersCount; ++reader)
+	{
+		readers.emplace_back(
+			[&]()
+			{
+				auto lastVersions = std::vector<std::uint64_t>(KeysCount, 0u);
+				auto reads = std::uint64_t{ 0u };
+				while (!writerDone)
+				{
+					for (auto key = std::uint64_t{ 0u }; key < KeysCount; ++key)
+					{
+						if (auto const value = store.get(key))
+						{
+							if (value->first != value->second)
+							{
+								++tornReads;
+							}
+							if (value->version < lastVersions[key])
+							{
+								++backwardVersions;
+							}
+							lastVersions[key] = value->version;
+						}
+						++reads;
+					}
+				}
+				totalReads += reads;
+			});
+	}
+
+	auto const startTime = std::chrono::steady_clock::now();
+	for (auto i = 0u; i < WritesCount; ++i)
+	{
+		auto const key = static_cast<std::uint64_t>(i) % KeysCount;
+		if (i % 1000u == 999u)
+		{
+			// Entity going offline then online again
+			store.remove(key, &OwnerA);
+			store.publish(key, &OwnerA, Value{ 0u, i, i });
+		}
+		else
+		{
+			store.update(key, &OwnerA,
+				[i](Value& value)
+				{
+					value.first = i;
+					value.second = i;
+				});
+		}
+	}
+	auto const writeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	writerDone = true;
+
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	EXPECT_EQ(0u, tornReads);
+	EXPECT_EQ(0u, backwardVersions);
+	EXPECT_EQ(KeysCount, store.keys().size());
+
+	std::cout << "Snapshot store: " << WritesCount << " writes in " << writeTime.count() << " ms, " << totalReads << " concurrent reads" << std::endl;
+}
@@ -0,0 +1,232 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file subscriptionRegistry_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <avdecc/subscriptionRegistry.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+struct Key
+{
+	std::uint64_t entityID{ 0u };
+	std::uint16_t descriptorIndex{ 0u };
+
+	bool operator==(Key const& other) const noexcept
+	{
+		return std::tie(entityID, descriptorIndex) == std::tie(other.entityID, other.descriptorIndex);
+	}
+};
+
+struct KeyHash
+{
+	std::size_t operator()(Key const& key) const noexcept
+	{
+		return std::hash<std::uint64_t>{}(key.entityID ^ (std::uint64_t{ key.descriptorIndex } << 48));
+	}
+};
+
+using Registry = avdecc::SubscriptionRegistry<Key, void(std::uint64_t, std::string const&), KeyHash>;
+
+} // namespace
+
+TEST(SubscriptionRegistry, OnlyMatchingKeyIsInvoked)
+{
+	auto registry = Registry{};
+	auto received = std::vector<std::string>{};
+	registry.subscribe(Key{ 1u, 0u }, [&received](std::uint64_t const, std::string const& name)
+		{
+			received.push_back("1/0:" + name);
+		});
+	registry.subscribe(Key{ 1u, 1u }, [&received](std::uint64_t const, std::string const& name)
+		{
+			received.push_back("1/1:" + name);
+		});
+	registry.subscribe(Key{ 2u, 0u }, [&received](std::uint64_t const, std::string const& name)
+		{
+			received.push_back("2/0:" + name);
+		});
+
+	EXPECT_EQ(1u, registry.notify(Key{ 1u, 1u }, 1u, "A"));
+	EXPECT_EQ(0u, registry.notify(Key{ 3u, 0u }, 3u, "B"));
+	EXPECT_EQ((std::vector<std::string>{ "1/1:A" }), received);
+
+	EXPECT_EQ(1u, registry.invokedCount());
+	EXPECT_EQ(5u, registry.avoidedCount()); // 2 for the first notification, 3 for the second one
+}
+
+TEST(SubscriptionRegistry, SeveralSubscribersInOrder)
+{
+	auto registry = Registry{};
+	auto order = std::vector<int>{};
+	for (auto i = 0; i < 3; ++i)
+	{
+		registry.subscribe(Key{ 5u, 2u }, [&order, i](std::uint64_t const, std::string const&)
+			{
+				order.push_back(i);
+			});
+	}
+
+	EXPECT_EQ(3u, registry.notify(Key{ 5u, 2u }, 5u, ""));
+	EXPECT_EQ((std::vector<int>{ 0, 1, 2 }), order);
+}
+
+TEST(SubscriptionRegistry, Unsubscribe)
+{
+	auto registry = Registry{};
+	auto count = 0;
+	auto const id = registry.subscribe(Key{ 1u, 0u }, [&count](std::uint64_t const, std::string const&)
+		{
+			++count;
+		});
+	EXPECT_EQ(1u, registry.subscriptionsCount());
+
+	registry.unsubscribe(id);
+	registry.unsubscribe(id); // Unknown ID is ignored
+	EXPECT_EQ(0u, registry.subscriptionsCount());
+	EXPECT_EQ(0u, registry.notify(Key{ 1u, 0u }, 1u, ""));
+	EXPECT_EQ(0, count);
+}
+
+TEST(SubscriptionRegistry, UnsubscribeDuringNotify)
+{
+	auto registry = Registry{};
+	auto invoked = std::vector<int>{};
+	auto secondID = Registry::SubscriptionID{ 0u };
+	auto firstID = Registry::SubscriptionID{ 0u };
+
+	// First handler unsubscribes itself and the second one
+	firstID = registry.subscribe(Key{ 1u, 0u }, [&](std::uint64_t const, std::string const&)
+		{
+			invoked.push_back(1);
+			registry.unsubscribe(firstID);
+			registry.unsubscribe(secondID);
+		});
+	secondID = registry.subscribe(Key{ 1u, 0u }, [&](std::uint64_t const, std::string const&)
+		{
+			invoked.push_back(2);
+		});
+
+	EXPECT_EQ(1u, registry.notify(Key{ 1u, 0u }, 1u, ""));
+	EXPECT_EQ((std::vector<int>{ 1 }), invoked);
+	EXPECT_EQ(0u, registry.subscriptionsCount());
+}
+
+TEST(SubscriptionRegistry, SubscribeDuringNotify)
+{
+	auto registry = Registry{};
+	auto count = 0;
+	registry.subscribe(Key{ 1u, 0u }, [&](std::uint64_t const, std::string const&)
+		{
+			++count;
+			registry.subscribe(Key{ 1u, 0u }, [&count](std::uint64_t const, std::string const&)
+				{
+					count += 10;
+				});
+		});
+
+	// The new subscription only receives the next notifications
+	EXPECT_EQ(1u, registry.notify(Key{ 1u, 0u }, 1u, ""));
+	EXPECT_EQ(1, count);
+	EXPECT_EQ(2u, registry.subscriptionsCount());
+}
+
+TEST(SubscriptionRegistry, Benchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	// 4 inspectors opened on different entities, each with 200 dynamic widgets, and 20 entities on the network
+	static constexpr auto EntitiesCount = std::uint64_t{ 20u };
+	static constexpr auto InspectorsCount = std::uint64_t{ 4u };
+	static constexpr auto WidgetsPerInspector = std::uint16_t{ 200u };
+	static constexpr auto NotificationsCount = std::size_t{ 100000u };
+
+	auto invokedKeyed = std::uint64_t{ 0u };
+	auto registry = Registry{};
+	auto broadcast = std::vector<std::function<void(Key const&, std::string const&)>>{};
+	auto invokedBroadcast = std::uint64_t{ 0u };
+	auto matchedBroadcast = std::uint64_t{ 0u };
+	for (auto inspector = std::uint64_t{ 0u }; inspector < InspectorsCount; ++inspector)
+	{
+		for (auto widget = std::uint16_t{ 0u }; widget < WidgetsPerInspector; ++widget)
+		{
+			auto const key = Key{ inspector, widget };
+			registry.subscribe(key, [&invokedKeyed](std::uint64_t const, std::string const&)
+				{
+					++invokedKeyed;
+				});
+			// Previous behavior: every widget is connected to the global signal and checks the key itself
+			broadcast.push_back(
+				[key, &invokedBroadcast, &matchedBroadcast](Key const& notified, std::string const&)
+				{
+					++invokedBroadcast;
+					if (notified == key)
+					{
+						++matchedBroadcast;
+					}
+				});
+		}
+	}
+
+	auto notifications = std::vector<Key>{};
+	notifications.reserve(NotificationsCount);
+	for (auto i = std::size_t{ 0u }; i < NotificationsCount; ++i)
+	{
+		notifications.push_back(Key{ (i * 7u) % EntitiesCount, static_cast<std::uint16_t>(i % WidgetsPerInspector) });
+	}
+	auto const name = std::string{ "Name" };
+
+	auto startTime = Clock::now();
+	for (auto const& key : notifications)
+	{
+		for (auto const& handler : broadcast)
+		{
+			handler(key, name);
+		}
+	}
+	auto const broadcastDuration = Clock::now() - startTime;
+
+	startTime = Clock::now();
+	for (auto const& key : notifications)
+	{
+		registry.notify(key, key.entityID, name);
+	}
+	auto const keyedDuration = Clock::now() - startTime;
+
+	EXPECT_EQ(matchedBroadcast, invokedKeyed);
+	EXPECT_EQ(invokedBroadcast, registry.invokedCount() + registry.avoidedCount());
+
+	auto const toUs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+	std::cout << "Broadcast: " << invokedBroadcast << " invocations in " << toUs(broadcastDuration) << " us" << std::endl;
+	std::cout << "Keyed: " << registry.invokedCount() << " invocations (" << registry.avoidedCount() << " avoided) in " << toUs(keyedDuration) << " us" << std::endl;
+}
@@ -0,0 +1,285 @@
+/*
+* Copyright (C) 2017-2026, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+* @file virtualEntitiesLoading_tests.cpp
+* @author Christophe Calmejane
+*/
+
+#include <gtest/gtest.h>
+#include <hive/modelsLibrary/controllerManager.hpp>
+#include <connectionMatrix/model.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <QString>
+#include <QApplication>
+#ifdef _WIN32
+#	pragma warning(push)
+#	pragma warning(disable : 4127) // Disable conditional expression is constant
+#endif
+#include <QTest>
+#ifdef _WIN32
+#	pragma warning(pop)
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using json = nlohmann::json;
+
+static constexpr auto EntitiesCount = std::size_t{ 500u };
+
+/** Replaces all occurrences of a string value in a json object */
+void replaceStringValue(json& object, std::string const& from, std::string const& to)
+{
+	if (object.is_string())
+	{
+		if (object.get<std::string>() == from)
+		{
+			object = to;
+		}
+	}
+	else if (object.is_structured())
+	{
+		for (auto& child : object)
+		{
+			replaceStringValue(child, from, to);
+		}
+	}
+}
+
+/** Creates a network state file with EntitiesCount copies of the first entity of a saved network state, each with its own EntityID */
+std::filesystem::path createSyntheticNetworkState()
+{
+	auto networkState = json{};
+	{
+		auto input = std::ifstream{ "data/connectionMatrix/1-Normal_Normal-ConnectedNoError_WrongFormat.json" };
+		input >> networkState;
+	}
+
+	auto const model = networkState.at("entities").at(0);
+	auto const modelEntityID = model.at("adp_information").at("common").at("entity_id").get<std::string>();
+
+	auto entities = json::array();
+	for (auto index = std::size_t{ 0u }; index < EntitiesCount; ++index)
+	{
+		auto entity = model;
+		auto entityID = std::ostringstream{};
+		entityID << "0x001B92FFFE" << std::uppercase << std::hex << std::setw(6) << std::setfill('0') << (0x100000u + index);
+		replaceStringValue(entity, modelEntityID, entityID.str());
+		entities.push_back(std::move(entity));
+	}
+	networkState["entities"] = std::move(entities);
+
+	auto const filePath = std::filesystem::temp_directory_path() / "hive_tests_synthetic.json";
+	auto output = std::ofstream{ filePath };
+	output << std::setw(4) << networkState << std::endl;
+	return filePath;
+}
+
+class VirtualEntitiesLoading_F : public ::testing::Test
+{
+public:
+	virtual void SetUp() override
+	{
+		createController();
+
+		// Configure the model
+		_model.setMode(connectionMatrix::Model::Mode::Stream);
+		_model.setTransposed(false);
+
+		// Count notifications
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		QObject::connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entityOnline, &_model,
+			[this]()
+			{
+				++_entityOnlineCount;
+			});
+		QObject::connect(&controllerManager, &hive::modelsLibrary::ControllerManager::entitiesOnline, &_model,
+			[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIDs)
+			{
+				++_entitiesOnlineCount;
+				_entitiesOnlineEntitiesCount += entityIDs.size();
+			});
+		QObject::connect(&_model, &QAbstractItemModel::rowsInserted, &_model,
+			[this]()
+			{
+				++_modelInsertionsCount;
+			});
+		QObject::connect(&_model, &QAbstractItemModel::columnsInserted, &_model,
+			[this]()
+			{
+				++_modelInsertionsCount;
+			});
+		QObject::connect(&_model, &QAbstractItemModel::modelReset, &_model,
+			[this]()
+			{
+				++_modelResetsCount;
+			});
+	}
+
+	virtual void TearDown() override
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		controllerManager.destroyController();
+	}
+
+	void createController()
+	{
+		auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+		try
+		{
+			controllerManager.createController(la::avdecc::protocol::ProtocolInterface::Type::Virtual, "Unit Tests", 0x0001, la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), "en", nullptr);
+		}
+		catch (la::avdecc::controller::Controller::Exception const&)
+		{
+			ASSERT_FALSE(true);
+		}
+	}
+
+	void resetCounters() noexcept
+	{
+		_entityOnlineCount = 0u;
+		_entitiesOnlineCount = 0u;
+		_entitiesOnlineEntitiesCount = 0u;
+		_modelInsertionsCount = 0u;
+		_modelResetsCount = 0u;
+	}
+
+	static la::avdecc::entity::model::jsonSerializer::Flags flags() noexcept
+	{
+		return la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
+	}
+
+protected:
+	int x{ 0 };
+	QApplication _app{ x, nullptr };
+	connectionMatrix::Model _model{ nullptr };
+	std::size_t _entityOnlineCount{ 0u };
+	std::size_t _entitiesOnlineCount{ 0u };
+	std::size_t _entitiesOnlineEntitiesCount{ 0u };
+	std::size_t _modelInsertionsCount{ 0u };
+	std::size_t _modelResetsCount{ 0u };
+};
+} // namespace
+
+/** Loads a synthetic network state of 500 entities, one entity at a time then in bulk */
+TEST_F(VirtualEntitiesLoading_F, BulkLoadBenchmark)
+{
+	using Clock = std::chrono::steady_clock;
+	auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+	auto const filePath = createSyntheticNetworkState();
+	auto const filePathString = QString::fromStdString(filePath.string());
+
+	// One entity at a time
+	auto const syncStartTime = Clock::now();
+	auto const [syncError, syncMessage] = controllerManager.loadVirtualEntitiesFromJsonNetworkState(filePathString, flags());
+	auto const syncBlockedTime = Clock::now() - syncStartTime;
+	ASSERT_EQ(la::avdecc::jsonSerializer::DeserializationError::NoError, syncError) << syncMessage;
+	EXPECT_TRUE(QTest::qWaitFor(
+		[this]()
+		{
+			return _entityOnlineCount == EntitiesCount;
+		}));
+	auto const syncTotalTime = Clock::now() - syncStartTime;
+	auto const syncModelInsertions = _modelInsertionsCount;
+	auto const syncRowCount = _model.rowCount();
+	auto const syncColumnCount = _model.columnCount();
+
+	// Start again with a new controller
+	controllerManager.destroyController();
+	createController();
+	QTest::qWait(10); // Flush Qt EventLoop
+	resetCounters();
+
+	// Bulk
+	auto loaded = false;
+	auto bulkError = la::avdecc::jsonSerializer::DeserializationError::InternalError;
+	auto const bulkStartTime = Clock::now();
+	controllerManager.loadVirtualEntitiesFromJsonNetworkStateAsync(filePathString, flags(),
+		[&loaded, &bulkError](la::avdecc::jsonSerializer::DeserializationError const error, std::string const& /*message*/)
+		{
+			bulkError = error;
+			loaded = true;
+		});
+	auto const bulkBlockedTime = Clock::now() - bulkStartTime;
+	EXPECT_TRUE(QTest::qWaitFor(
+		[&loaded]()
+		{
+			return loaded;
+		},
+		60000));
+	auto const bulkTotalTime = Clock::now() - bulkStartTime;
+	std::filesystem::remove(filePath);
+
+	EXPECT_EQ(la::avdecc::jsonSerializer::DeserializationError::NoError, bulkError);
+	// A single batch notification, handled by the model with a single reset
+	EXPECT_EQ(0u, _entityOnlineCount);
+	EXPECT_EQ(1u, _entitiesOnlineCount);
+	EXPECT_EQ(EntitiesCount, _entitiesOnlineEntitiesCount);
+	EXPECT_EQ(1u, _modelResetsCount);
+	EXPECT_EQ(0u, _modelInsertionsCount);
+	// Same content
+	EXPECT_EQ(syncRowCount, _model.rowCount());
+	EXPECT_EQ(syncColumnCount, _model.columnCount());
+
+	auto const toMs = [](auto const duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+	};
+	std::cout << "Loading " << EntitiesCount << " virtual entities:" << std::endl;
+	std::cout << "  One at a time: UI blocked " << toMs(syncBlockedTime) << " ms, all entities online after " << toMs(syncTotalTime) << " ms, " << syncModelInsertions << " model insertions" << std::endl;
+	std::cout << "  Bulk: UI blocked " << toMs(bulkBlockedTime) << " ms, all entities online after " << toMs(bulkTotalTime) << " ms, " << _modelResetsCount << " model reset" << std::endl;
+}
+
+TEST_F(VirtualEntitiesLoading_F, BulkLoadError)
+{
+	auto& controllerManager = hive::modelsLibrary::ControllerManager::getInstance();
+
+	auto loadedCount = 0u;
+	auto lastError = la::avdecc::jsonSerializer::DeserializationError::NoError;
+	auto const handler = [&loadedCount, &lastError](la::avdecc::jsonSerializer::DeserializationError const error, std::string const& /*message*/)
+	{
+		lastError = error;
+		++loadedCount;
+	};
+
+	// Queued loads, both failing
+	controllerManager.loadVirtualEntitiesFromJsonNetworkStateAsync("data/doesNotExist.json", flags(), handler);
+	controllerManager.loadVirtualEntitiesFromJsonNetworkStateAsync("data/doesNotExist.json", flags(), handler);
+	EXPECT_TRUE(QTest::qWaitFor(
+		[&loadedCount]()
+		{
+			return loadedCount == 2u;
+		}));
+
+	EXPECT_NE(la::avdecc::jsonSerializer::DeserializationError::NoError, lastError);
+	EXPECT_EQ(0u, _entitiesOnlineCount);
+}
@@ -2,18 +2,19 @@
 import sys
 import csv
 import json
+import os
 import re
-import requests # pip install requests
 from io import StringIO
 
 def download_csv(url):
+	import requests # pip install requests
 	response = requests.get(url)
 	if response.status_code == 200:
 		return response.text
 	else:
 		raise Exception(f"Failed to download CSV from {url}")
 
-def main(output_file, csv_data):
+def main(output_file, csv_datas):
 	# Dictionary of filter lines and corresponding output names
 	filter_dict = {
 		"NETGEAR": "Netgear",
@@ -37,26 +38,29 @@ def main(output_file, csv_data):
 	# Initialize the result dictionary
 	result_dict = {}
 
-	# Create the "oui_24" entry
-	result_dict["oui_24"] = {}
+	# Create the "oui_24" (MA-L) and "oui_36" (MA-S) entries
+	registries = { "MA-L": "oui_24", "MA-S": "oui_36" }
+	for key in registries.values():
+		result_dict[key] = {}
 
 	# Read and process the CSV data
-	csv_reader = csv.reader(StringIO(csv_data))
 	matched_vendors = set()
 
-	for row in csv_reader:
-		if len(row) >= 3:  # Ensure at least three columns are present
-			registry, mac_prefix, vendor_name = row[0], row[1], row[2]
+	for csv_data in csv_datas:
+		csv_reader = csv.reader(StringIO(csv_data))
+		for row in csv_reader:
+			if len(row) >= 3:  # Ensure at least three columns are present
+				registry, mac_prefix, vendor_name = row[0], row[1], row[2]
 
-			# Ignore non-MA-L entries
-			if registry != "MA-L":
-				continue
+				# Ignore other registries (MA-M, CID, ...)
+				if registry not in registries:
+					continue
 
-			# Check if vendor name is in the filter dictionary (case-insensitive)
-			for filter_item, output_name in filter_dict.items():
-				if re.search(re.escape(filter_item), vendor_name, re.IGNORECASE):
-					result_dict["oui_24"]["0x" + mac_prefix] = output_name
-					matched_vendors.add(output_name)
+				# Check if vendor name is in the filter dictionary (case-insensitive)
+				for filter_item, output_name in filter_dict.items():
+					if re.search(re.escape(filter_item), vendor_name, re.IGNORECASE):
+						result_dict[registries[registry]]["0x" + mac_prefix] = output_name
+						matched_vendors.add(output_name)
 
 	# Print warning for each filter_dict entry without a match
 	for filter_item, output_name in filter_dict.items():
@@ -67,15 +71,97 @@ def main(output_file, csv_data):
 	with open(output_file, 'w', encoding='utf-8') as json_output_file:
 		json.dump(result_dict, json_output_file, indent=2)
 
+def name_index_type(names_count):
+	# Smallest unsigned type able to index the pool of vendor names
+	for bits in (8, 16, 32):
+		if names_count <= (1 << bits):
+			return f"std::uint{bits}_t"
+	raise Exception("Too many vendor names for a 32-bit index")
+
+def format_table(name, key_type, digits, entries, names_index):
+	lines = [f"inline constexpr auto {name} = OuiTable<{key_type}, {len(entries)}, VendorNameIndex>{{"]
+	lines.append("\t{")
+	for i in range(0, len(entries), 8):
+		lines.append("\t\t" + " ".join(f"0x{oui:0{digits}X}u," for oui, _ in entries[i:i + 8]))
+	lines.append("\t},")
+	lines.append("\t{")
+	for i in range(0, len(entries), 24):
+		lines.append("\t\t" + " ".join(f"{names_index[vendor]}u," for _, vendor in entries[i:i + 24]))
+	lines.append("\t},")
+	lines.append("};")
+	lines.append(f"static_assert({name}.isSorted(), \"{name} must be sorted\");")
+	return lines
+
+def generate_header(input_file, output_file):
+	with open(input_file, 'r', encoding='utf-8') as json_input_file:
+		oui_dict = json.load(json_input_file)
+
+	tables = [("Oui24", "std::uint32_t", 6, "oui_24"), ("Oui36", "std::uint64_t", 9, "oui_36")]
+	entries = {}
+	for name, _, _, key in tables:
+		entries[name] = sorted((int(oui, 16), vendor) for oui, vendor in oui_dict.get(key, {}).items())
+
+	# Pool of vendor names, each stored only once
+	vendor_names = sorted({ vendor for table in entries.values() for _, vendor in table })
+	names_index = { vendor: index for index, vendor in enumerate(vendor_names) }
+
+	lines = [
+		f"// Generated by tools/generate_oui.py from {os.path.basename(input_file)}, do not edit",
+		"",
+		"#pragma once",
+		"",
+		"#include <hive/modelsLibrary/ouiTable.hpp>",
+		"",
+		"#include <array>",
+		"#include <cstdint>",
+		"#include <string_view>",
+		"",
+		"namespace hive",
+		"{",
+		"namespace modelsLibrary",
+		"{",
+		"namespace oui",
+		"{",
+		f"using VendorNameIndex = {name_index_type(len(vendor_names))};",
+		f"inline constexpr auto VendorNames = std::array<std::string_view, {len(vendor_names)}>{{",
+	]
+	lines += [f"\t{json.dumps(vendor)}," for vendor in vendor_names]
+	lines.append("};")
+	lines.append("")
+	for name, key_type, digits, _ in tables:
+		lines += format_table(name, key_type, digits, entries[name], names_index)
+		lines.append("")
+	lines += [
+		"} // namespace oui",
+		"} // namespace modelsLibrary",
+		"} // namespace hive",
+		"",
+	]
+	content = "\n".join(lines)
+
+	# Only write the file if it changed, so dependent files are not needlessly rebuilt
+	if os.path.exists(output_file):
+		with open(output_file, 'r', encoding='utf-8') as header_file:
+			if header_file.read() == content:
+				return
+	with open(output_file, 'w', encoding='utf-8', newline='\n') as header_file:
+		header_file.write(content)
+
 if __name__ == "__main__":
-	if len(sys.argv) < 2 or len(sys.argv) > 3:
-		print("Usage: python generate_oui.py <output_file.json> [oui.csv]")
+	if len(sys.argv) == 4 and sys.argv[1] == "--header":
+		generate_header(sys.argv[2], sys.argv[3])
+		sys.exit(0)
+	if len(sys.argv) < 2 or len(sys.argv) > 4 or sys.argv[1].startswith("--"):
+		print("Usage: python generate_oui.py <output_file.json> [oui.csv [oui36.csv]]")
+		print("       python generate_oui.py --header <input_file.json> <output_file.hpp>")
 		sys.exit(1)
-	# Download CSV from the given URL or use the provided file
-	if len(sys.argv) == 3:
-		with open(sys.argv[2], 'r', encoding='utf-8') as csv_file:
-			csv_data = csv_file.read()
+	# Download CSVs from the given URLs or use the provided files
+	if len(sys.argv) >= 3:
+		csv_datas = []
+		for csv_file_name in sys.argv[2:]:
+			with open(csv_file_name, 'r', encoding='utf-8') as csv_file:
+				csv_datas.append(csv_file.read())
 	else:
-		csv_data = download_csv("https://standards.ieee.org/develop/regauth/oui/oui.csv")
+		csv_datas = [download_csv("https://standards.ieee.org/develop/regauth/oui/oui.csv"), download_csv("https://standards-oui.ieee.org/oui36/oui36.csv")]
 
-	main(sys.argv[1], csv_data)
+	main(sys.argv[1], csv_datas)